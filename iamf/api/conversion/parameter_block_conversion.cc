@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/api/conversion/parameter_block_conversion.h"
+
+#include <cstdint>
+#include <utility>
+#include <variant>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "iamf/cli/parameter_block_metadata.h"
+#include "iamf/include/iamf_tools/iamf_tools_encoder_api_types.h"
+#include "iamf/obu/demixing_info_parameter_data.h"
+#include "iamf/obu/mix_gain_parameter_data.h"
+#include "iamf/obu/recon_gain_info_parameter_data.h"
+
+namespace iamf_tools {
+namespace {
+
+// All recon gain flags which are defined in the IAMF spec.
+constexpr uint32_t kValidReconGainFlags = (1 << 12) - 1;
+
+absl::StatusOr<MixGainParameterData> ApiToInternalParamData(
+    const api::IamfMixGainParameterData& api_param_data) {
+  switch (api_param_data.animation_type) {
+    using enum api::IamfAnimationType;
+    case kStep:
+      return MixGainParameterData(
+          MixGainParameterData::kAnimateStep,
+          AnimationStepInt16{.start_point_value =
+                                 api_param_data.start_point_value});
+    case kLinear:
+      return MixGainParameterData(
+          MixGainParameterData::kAnimateLinear,
+          AnimationLinearInt16{
+              .start_point_value = api_param_data.start_point_value,
+              .end_point_value = api_param_data.end_point_value});
+    case kBezier:
+      return MixGainParameterData(
+          MixGainParameterData::kAnimateBezier,
+          AnimationBezierInt16{
+              .start_point_value = api_param_data.start_point_value,
+              .end_point_value = api_param_data.end_point_value,
+              .control_point_value = api_param_data.control_point_value,
+              .control_point_relative_time =
+                  api_param_data.control_point_relative_time});
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrCat("Invalid animation type: ",
+                       static_cast<int>(api_param_data.animation_type)));
+  }
+}
+
+absl::StatusOr<DemixingInfoParameterData> ApiToInternalParamData(
+    const api::IamfDemixingInfoParameterData& api_param_data) {
+  switch (api_param_data.dmixp_mode) {
+    using enum api::IamfDMixPMode;
+    case kDMixPMode1:
+      return DemixingInfoParameterData(DemixingInfoParameterData::kDMixPMode1,
+                                       0);
+    case kDMixPMode2:
+      return DemixingInfoParameterData(DemixingInfoParameterData::kDMixPMode2,
+                                       0);
+    case kDMixPMode3:
+      return DemixingInfoParameterData(DemixingInfoParameterData::kDMixPMode3,
+                                       0);
+    case kDMixPMode1_n:
+      return DemixingInfoParameterData(
+          DemixingInfoParameterData::kDMixPMode1_n, 0);
+    case kDMixPMode2_n:
+      return DemixingInfoParameterData(
+          DemixingInfoParameterData::kDMixPMode2_n, 0);
+    case kDMixPMode3_n:
+      return DemixingInfoParameterData(
+          DemixingInfoParameterData::kDMixPMode3_n, 0);
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrCat("Invalid demixing mode: ",
+                       static_cast<int>(api_param_data.dmixp_mode)));
+  }
+}
+
+absl::StatusOr<ParameterBlockMetadata::UserReconGains> ApiToInternalParamData(
+    const api::IamfReconGainInfoParameterData& api_param_data) {
+  ParameterBlockMetadata::UserReconGains user_recon_gains;
+  user_recon_gains.reserve(api_param_data.recon_gains_for_layer.size());
+  for (const auto& api_recon_gains : api_param_data.recon_gains_for_layer) {
+    if ((api_recon_gains.recon_gain_flag & ~kValidReconGainFlags) != 0) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Invalid recon gain flag: ", api_recon_gains.recon_gain_flag));
+    }
+    user_recon_gains.push_back(
+        ReconGainElement{.recon_gain_flag = api_recon_gains.recon_gain_flag,
+                         .recon_gain = api_recon_gains.recon_gain});
+  }
+  return user_recon_gains;
+}
+
+}  // namespace
+
+absl::StatusOr<ParameterBlockMetadata> ApiToInternalType(
+    const api::IamfParameterBlockMetadata& api_metadata) {
+  ParameterBlockMetadata metadata{
+      .parameter_id = api_metadata.parameter_id,
+      .start_timestamp = api_metadata.start_timestamp,
+      .duration = api_metadata.duration,
+      .constant_subblock_duration = api_metadata.constant_subblock_duration};
+  metadata.subblocks.resize(api_metadata.subblocks.size());
+  for (int i = 0; i < api_metadata.subblocks.size(); ++i) {
+    const auto& api_subblock = api_metadata.subblocks[i];
+    auto& subblock = metadata.subblocks[i];
+    subblock.subblock_duration = api_subblock.subblock_duration;
+    absl::Status status = absl::OkStatus();
+    std::visit(
+        [&](const auto& api_param_data) {
+          auto param_data = ApiToInternalParamData(api_param_data);
+          if (!param_data.ok()) {
+            status = param_data.status();
+            return;
+          }
+          subblock.param_data = *std::move(param_data);
+        },
+        api_subblock.param_data);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+
+  return metadata;
+}
+
+}  // namespace iamf_tools
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+
+#ifndef API_CONVERSION_PARAMETER_BLOCK_CONVERSION_H_
+#define API_CONVERSION_PARAMETER_BLOCK_CONVERSION_H_
+
+#include "absl/status/statusor.h"
+#include "iamf/cli/parameter_block_metadata.h"
+#include "iamf/include/iamf_tools/iamf_tools_encoder_api_types.h"
+
+namespace iamf_tools {
+
+/*!\brief Converts API parameter block metadata to the internal type.
+ *
+ * \param api_metadata API parameter block metadata.
+ * \return Internal parameter block metadata, or an error if any field is
+ *         invalid.
+ */
+absl::StatusOr<ParameterBlockMetadata> ApiToInternalType(
+    const api::IamfParameterBlockMetadata& api_metadata);
+
+}  // namespace iamf_tools
+
+#endif  // API_CONVERSION_PARAMETER_BLOCK_CONVERSION_H_
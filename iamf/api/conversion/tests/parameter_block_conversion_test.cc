@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/api/conversion/parameter_block_conversion.h"
+
+#include <array>
+#include <cstdint>
+#include <variant>
+
+#include "absl/status/status_matchers.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "iamf/cli/parameter_block_metadata.h"
+#include "iamf/include/iamf_tools/iamf_tools_encoder_api_types.h"
+#include "iamf/obu/demixing_info_parameter_data.h"
+#include "iamf/obu/mix_gain_parameter_data.h"
+
+namespace iamf_tools {
+namespace {
+
+using ::absl_testing::IsOk;
+using ::testing::Not;
+
+constexpr uint32_t kParameterId = 100;
+constexpr int64_t kStartTimestamp = 960;
+constexpr uint32_t kDuration = 480;
+
+api::IamfParameterBlockMetadata MakeApiMetadata(
+    const api::IamfParameterSubblock& subblock) {
+  return {.parameter_id = kParameterId,
+          .start_timestamp = kStartTimestamp,
+          .duration = kDuration,
+          .constant_subblock_duration = kDuration,
+          .subblocks = {subblock}};
+}
+
+TEST(ApiToInternalType, CopiesCommonFields) {
+  const auto metadata = ApiToInternalType(MakeApiMetadata(
+      {.subblock_duration = kDuration,
+       .param_data = api::IamfMixGainParameterData{}}));
+  ASSERT_THAT(metadata, IsOk());
+
+  EXPECT_EQ(metadata->parameter_id, kParameterId);
+  EXPECT_EQ(metadata->start_timestamp, kStartTimestamp);
+  EXPECT_EQ(metadata->duration, kDuration);
+  EXPECT_EQ(metadata->constant_subblock_duration, kDuration);
+  ASSERT_EQ(metadata->subblocks.size(), 1);
+  EXPECT_EQ(metadata->subblocks[0].subblock_duration, kDuration);
+}
+
+TEST(ApiToInternalType, ConvertsStepMixGain) {
+  const auto metadata = ApiToInternalType(MakeApiMetadata(
+      {.param_data = api::IamfMixGainParameterData{
+           .animation_type = api::IamfAnimationType::kStep,
+           .start_point_value = -256}}));
+  ASSERT_THAT(metadata, IsOk());
+
+  const auto* mix_gain =
+      std::get_if<MixGainParameterData>(&metadata->subblocks[0].param_data);
+  ASSERT_NE(mix_gain, nullptr);
+  EXPECT_EQ(mix_gain->animation_type, MixGainParameterData::kAnimateStep);
+  EXPECT_EQ(std::get<AnimationStepInt16>(mix_gain->param_data),
+            AnimationStepInt16{.start_point_value = -256});
+}
+
+TEST(ApiToInternalType, ConvertsBezierMixGain) {
+  const auto metadata = ApiToInternalType(MakeApiMetadata(
+      {.param_data = api::IamfMixGainParameterData{
+           .animation_type = api::IamfAnimationType::kBezier,
+           .start_point_value = 0,
+           .end_point_value = -512,
+           .control_point_value = -128,
+           .control_point_relative_time = 64}}));
+  ASSERT_THAT(metadata, IsOk());
+
+  const auto* mix_gain =
+      std::get_if<MixGainParameterData>(&metadata->subblocks[0].param_data);
+  ASSERT_NE(mix_gain, nullptr);
+  EXPECT_EQ(mix_gain->animation_type, MixGainParameterData::kAnimateBezier);
+  EXPECT_EQ(std::get<AnimationBezierInt16>(mix_gain->param_data),
+            (AnimationBezierInt16{.start_point_value = 0,
+                                  .end_point_value = -512,
+                                  .control_point_value = -128,
+                                  .control_point_relative_time = 64}));
+}
+
+TEST(ApiToInternalType, InvalidForUnknownAnimationType) {
+  EXPECT_THAT(ApiToInternalType(MakeApiMetadata(
+                  {.param_data = api::IamfMixGainParameterData{
+                       .animation_type =
+                           static_cast<api::IamfAnimationType>(3)}})),
+              Not(IsOk()));
+}
+
+TEST(ApiToInternalType, ConvertsDemixingMode) {
+  const auto metadata = ApiToInternalType(MakeApiMetadata(
+      {.param_data = api::IamfDemixingInfoParameterData{
+           .dmixp_mode = api::IamfDMixPMode::kDMixPMode3_n}}));
+  ASSERT_THAT(metadata, IsOk());
+
+  const auto* demixing_info = std::get_if<DemixingInfoParameterData>(
+      &metadata->subblocks[0].param_data);
+  ASSERT_NE(demixing_info, nullptr);
+  EXPECT_EQ(demixing_info->dmixp_mode,
+            DemixingInfoParameterData::kDMixPMode3_n);
+  EXPECT_EQ(demixing_info->reserved, 0);
+}
+
+TEST(ApiToInternalType, ConvertsReconGainsForEachLayer) {
+  std::array<uint8_t, 12> recon_gain = {};
+  recon_gain[0] = 255;
+  recon_gain[2] = 128;
+  const auto metadata = ApiToInternalType(MakeApiMetadata(
+      {.param_data = api::IamfReconGainInfoParameterData{
+           .recon_gains_for_layer = {
+               {}, {.recon_gain_flag = 0b101, .recon_gain = recon_gain}}}}));
+  ASSERT_THAT(metadata, IsOk());
+
+  const auto* user_recon_gains =
+      std::get_if<ParameterBlockMetadata::UserReconGains>(
+          &metadata->subblocks[0].param_data);
+  ASSERT_NE(user_recon_gains, nullptr);
+  ASSERT_EQ(user_recon_gains->size(), 2);
+  EXPECT_EQ((*user_recon_gains)[0].recon_gain_flag, 0);
+  EXPECT_EQ((*user_recon_gains)[1].recon_gain_flag, 0b101);
+  EXPECT_EQ((*user_recon_gains)[1].recon_gain, recon_gain);
+}
+
+TEST(ApiToInternalType, InvalidForUndefinedReconGainFlags) {
+  EXPECT_THAT(
+      ApiToInternalType(MakeApiMetadata(
+          {.param_data = api::IamfReconGainInfoParameterData{
+               .recon_gains_for_layer = {{.recon_gain_flag = 1 << 12}}}})),
+      Not(IsOk()));
+}
+
+TEST(ApiToInternalType, ConvertsEachSubblock) {
+  auto api_metadata = MakeApiMetadata(
+      {.subblock_duration = 160,
+       .param_data = api::IamfMixGainParameterData{.start_point_value = 1}});
+  api_metadata.subblocks.push_back(
+      {.subblock_duration = 320,
+       .param_data = api::IamfMixGainParameterData{.start_point_value = 2}});
+
+  const auto metadata = ApiToInternalType(api_metadata);
+  ASSERT_THAT(metadata, IsOk());
+
+  ASSERT_EQ(metadata->subblocks.size(), 2);
+  EXPECT_EQ(metadata->subblocks[0].subblock_duration, 160);
+  EXPECT_EQ(metadata->subblocks[1].subblock_duration, 320);
+  EXPECT_EQ(
+      std::get<AnimationStepInt16>(
+          std::get<MixGainParameterData>(metadata->subblocks[1].param_data)
+              .param_data),
+      AnimationStepInt16{.start_point_value = 2});
+}
+
+}  // namespace
+}  // namespace iamf_tools
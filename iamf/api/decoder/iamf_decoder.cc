@@ -33,6 +33,7 @@
 #include "iamf/common/read_bit_buffer.h"
 #include "iamf/common/utils/macros.h"
 #include "iamf/common/utils/numeric_utils.h"
+#include "iamf/common/utils/polyphase_resampler.h"
 #include "iamf/common/utils/sample_processing_utils.h"
 #include "iamf/include/iamf_tools/iamf_tools_api_types.h"
 #include "iamf/obu/ia_sequence_header.h"
@@ -93,6 +94,16 @@ struct IamfDecoder::DecoderState {
   // Defaulting to int32 for now.
   OutputSampleType output_sample_type = OutputSampleType::kInt32LittleEndian;
 
+  // The optionally requested sample rate of the output.
+  std::optional<uint32_t> requested_output_sample_rate;
+
+  // Created after DescriptorObus are processed, only when the requested output
+  // sample rate differs from the sample rate of the bitstream.
+  std::unique_ptr<PolyphaseResampler> resampler;
+
+  // Backing storage for `rendered_samples` when they are resampled.
+  std::vector<std::vector<InternalSampleType>> resampled_samples;
+
   // True iff the decoder was created via CreateFromDescriptors().
   bool created_from_descriptors = false;
 
@@ -157,8 +168,25 @@ absl::Status IamfDecoder::DecoderState::CreateObuProcessor() {
   }
   actual_layout = *new_layout;
 
+  // Trivial IA Sequences have no sample rate, so there is nothing to resample.
+  std::unique_ptr<PolyphaseResampler> new_resampler;
+  const auto sample_rate = temp_obu_processor->GetOutputSampleRate();
+  if (requested_output_sample_rate.has_value() && sample_rate.ok() &&
+      *sample_rate != *requested_output_sample_rate) {
+    int num_channels;
+    RETURN_IF_NOT_OK(MixPresentationObu::GetNumChannelsFromLayout(
+        actual_layout, num_channels));
+    auto created_resampler = PolyphaseResampler::Create(
+        *sample_rate, *requested_output_sample_rate, num_channels);
+    if (!created_resampler.ok()) {
+      return created_resampler.status();
+    }
+    new_resampler = *std::move(created_resampler);
+  }
+
   // Copy over fields at the end, now that everything is successful.
   obu_processor = std::move(temp_obu_processor);
+  resampler = std::move(new_resampler);
 
   return absl::OkStatus();
 }
@@ -190,7 +218,9 @@ IamfStatus DecodeOneTemporalUnit(
     StreamBasedReadBitBuffer* read_bit_buffer, ObuProcessor* obu_processor,
     bool eos_is_end_of_sequence,
     std::vector<absl::Span<const InternalSampleType>>& rendered_samples,
-    std::optional<ChannelReorderer> channel_reorderer) {
+    std::optional<ChannelReorderer> channel_reorderer,
+    PolyphaseResampler* resampler,
+    std::vector<std::vector<InternalSampleType>>& resampled_samples) {
   if (read_bit_buffer == nullptr) {
     return IamfStatus::ErrorStatus("Internal Error: Read bit buffer is null.");
   }
@@ -221,6 +251,14 @@ IamfStatus DecodeOneTemporalUnit(
     if (channel_reorderer.has_value()) {
       channel_reorderer->Reorder(rendered_samples);
     }
+    if (resampler != nullptr) {
+      absl_status = resampler->Process(rendered_samples, resampled_samples);
+      if (!absl_status.ok()) {
+        return AbslToIamfStatus(absl_status);
+      }
+      rendered_samples.assign(resampled_samples.begin(),
+                              resampled_samples.end());
+    }
   }
   // Empty the buffer of the data that was processed thus far.
   const auto num_bits_read = read_bit_buffer->Tell() - start_position_bits;
@@ -231,6 +269,26 @@ IamfStatus DecodeOneTemporalUnit(
   return IamfStatus::OkStatus();
 }
 
+// Outputs the samples held back by the resampler once the last temporal unit
+// of the stream has been output.
+IamfStatus FlushResampler(
+    PolyphaseResampler* resampler,
+    std::vector<absl::Span<const InternalSampleType>>& rendered_samples,
+    std::vector<std::vector<InternalSampleType>>& resampled_samples) {
+  if (resampler == nullptr || !rendered_samples.empty()) {
+    return IamfStatus::OkStatus();
+  }
+  absl::Status absl_status = resampler->Flush(resampled_samples);
+  if (!absl_status.ok()) {
+    return AbslToIamfStatus(absl_status);
+  }
+  if (!resampled_samples.empty() && !resampled_samples.front().empty()) {
+    rendered_samples.assign(resampled_samples.begin(),
+                            resampled_samples.end());
+  }
+  return IamfStatus::OkStatus();
+}
+
 size_t BytesPerSample(OutputSampleType sample_type) {
   switch (sample_type) {
     case OutputSampleType::kInt16LittleEndian:
@@ -315,6 +373,7 @@ IamfStatus IamfDecoder::Create(const Settings& settings,
   state->channel_rearrangement_scheme =
       ChannelOrderingApiToInternalType(settings.channel_ordering);
   state->output_sample_type = settings.requested_output_sample_type;
+  state->requested_output_sample_rate = settings.requested_output_sample_rate;
   output_decoder = absl::WrapUnique(new IamfDecoder(std::move(state)));
   return IamfStatus::OkStatus();
 }
@@ -386,7 +445,8 @@ IamfStatus IamfDecoder::Decode(const uint8_t* input_buffer,
     return DecodeOneTemporalUnit(
         state_->read_bit_buffer.get(), state_->obu_processor.get(),
         state_->created_from_descriptors, state_->rendered_samples,
-        state_->channel_reorderer);
+        state_->channel_reorderer, state_->resampler.get(),
+        state_->resampled_samples);
   }
   return IamfStatus::OkStatus();
 }
@@ -412,10 +472,19 @@ IamfStatus IamfDecoder::GetOutputTemporalUnit(uint8_t* output_buffer,
       state_->read_bit_buffer.get(), state_->obu_processor.get(),
       state_->created_from_descriptors ||
           state_->status == DecoderStatus::kEndOfStream,
-      state_->rendered_samples, state_->channel_reorderer);
+      state_->rendered_samples, state_->channel_reorderer,
+      state_->resampler.get(), state_->resampled_samples);
   if (!decode_status.ok()) {
     return decode_status;
   }
+  if (state_->status == DecoderStatus::kEndOfStream) {
+    auto flush_status =
+        FlushResampler(state_->resampler.get(), state_->rendered_samples,
+                       state_->resampled_samples);
+    if (!flush_status.ok()) {
+      return flush_status;
+    }
+  }
   return status;
 }
 
@@ -464,6 +533,10 @@ IamfStatus IamfDecoder::GetSampleRate(uint32_t& output_sample_rate) const {
         "Failed Precondition: GetSampleRate() cannot be called before "
         "descriptor processing is complete.");
   }
+  if (state_->resampler != nullptr) {
+    output_sample_rate = *state_->requested_output_sample_rate;
+    return IamfStatus::OkStatus();
+  }
   absl::StatusOr<uint32_t> sample_rate =
       state_->obu_processor->GetOutputSampleRate();
   if (sample_rate.ok()) {
@@ -483,7 +556,10 @@ IamfStatus IamfDecoder::GetFrameSize(uint32_t& output_frame_size) const {
   absl::StatusOr<uint32_t> frame_size =
       state_->obu_processor->GetOutputFrameSize();
   if (frame_size.ok()) {
-    output_frame_size = *frame_size;
+    output_frame_size =
+        state_->resampler == nullptr
+            ? *frame_size
+            : state_->resampler->GetMaxOutputTicks(*frame_size);
     return IamfStatus::OkStatus();
   }
   return AbslToIamfStatus(frame_size.status());
@@ -550,12 +626,16 @@ IamfStatus IamfDecoder::SignalEndOfDecoding() {
     auto decode_status = DecodeOneTemporalUnit(
         state_->read_bit_buffer.get(), state_->obu_processor.get(),
         /*eos_is_end_of_sequence=*/true, state_->rendered_samples,
-        state_->channel_reorderer);
+        state_->channel_reorderer, state_->resampler.get(),
+        state_->resampled_samples);
     if (!decode_status.ok()) {
       return decode_status;
     }
   }
-  return IamfStatus::OkStatus();
+  // When every temporal unit has already been output, the samples held back
+  // by the resampler form the final temporal unit.
+  return FlushResampler(state_->resampler.get(), state_->rendered_samples,
+                        state_->resampled_samples);
 }
 
 }  // namespace api
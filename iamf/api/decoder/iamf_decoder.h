@@ -16,6 +16,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 
 #include "iamf/include/iamf_tools/iamf_decoder_interface.h"
@@ -62,6 +63,15 @@ class IamfDecoder : public api::IamfDecoderInterface {
     // Specifies the desired bit depth for the output samples.
     OutputSampleType requested_output_sample_type =
         OutputSampleType::kInt32LittleEndian;
+
+    // Specifies the desired sample rate of the output. When unset, or when it
+    // matches the sample rate of the bitstream, samples are output at the
+    // sample rate of the bitstream. Otherwise the rendered samples are
+    // converted to the requested sample rate before being output. The output
+    // is time-aligned with the input, so the first temporal units are shorter
+    // while the resampler fills its look-ahead; the samples it holds back are
+    // output as a final temporal unit after `SignalEndOfDecoding()`.
+    std::optional<uint32_t> requested_output_sample_rate;
   };
 
   // Dtor cannot be inline (so it must be declared and defined in the source
@@ -200,6 +210,9 @@ class IamfDecoder : public api::IamfDecoderInterface {
    * This function can only be used after all Descriptor OBUs have been parsed,
    * i.e. IsDescriptorProcessingComplete() returns true.
    *
+   * When a different output sample rate was requested, this is the requested
+   * sample rate.
+   *
    * \param output_sample_rate Output param for the sample rate upon success.
    * \return Ok status upon success. Other specific statuses on failure.
    */
@@ -214,6 +227,10 @@ class IamfDecoder : public api::IamfDecoderInterface {
    * The total number of samples in a frame is the number of channels times
    * this number, the frame size.
    *
+   * When a different output sample rate was requested, the number of samples
+   * varies slightly between temporal units, and this is the maximum number of
+   * samples per frame.
+   *
    * \param output_frame_size Output param for the frame size upon success.
    * \return Ok status upon success. Other specific statuses on failure.
    */
@@ -28,6 +28,8 @@
 #include "iamf/cli/parameter_block_with_data.h"
 #include "iamf/cli/tests/cli_test_utils.h"
 #include "iamf/cli/user_metadata_builder/iamf_input_layout.h"
+#include "iamf/common/utils/numeric_utils.h"
+#include "iamf/common/utils/polyphase_resampler.h"
 #include "iamf/include/iamf_tools/iamf_tools_api_types.h"
 #include "iamf/obu/audio_frame.h"
 #include "iamf/obu/codec_config.h"
@@ -1111,6 +1113,166 @@ TEST(GetFrameSize, ReturnsFrameSizeBasedOnCodecConfigObu) {
   EXPECT_EQ(frame_size, kNumSamplesPerFrame);
 }
 
+TEST(GetSampleRate, ReturnsRequestedOutputSampleRate) {
+  std::vector<uint8_t> source_data = GenerateBasicDescriptorObus();
+  auto decoder_settings = GetStereoDecoderSettings();
+  decoder_settings.requested_output_sample_rate = 44100;
+  std::unique_ptr<api::IamfDecoder> decoder;
+  ASSERT_TRUE(api::IamfDecoder::CreateFromDescriptors(
+                  decoder_settings, source_data.data(), source_data.size(),
+                  decoder)
+                  .ok());
+
+  uint32_t sample_rate;
+  ASSERT_TRUE(decoder->GetSampleRate(sample_rate).ok());
+  EXPECT_EQ(sample_rate, 44100);
+}
+
+TEST(GetFrameSize, ReturnsMaximumFrameSizeAtRequestedOutputSampleRate) {
+  std::vector<uint8_t> source_data = GenerateBasicDescriptorObus();
+  auto decoder_settings = GetStereoDecoderSettings();
+  decoder_settings.requested_output_sample_rate = 2 * kSampleRate;
+  std::unique_ptr<api::IamfDecoder> decoder;
+  ASSERT_TRUE(api::IamfDecoder::CreateFromDescriptors(
+                  decoder_settings, source_data.data(), source_data.size(),
+                  decoder)
+                  .ok());
+
+  uint32_t frame_size;
+  ASSERT_TRUE(decoder->GetFrameSize(frame_size).ok());
+  EXPECT_EQ(frame_size, 2 * kNumSamplesPerFrame);
+}
+
+// Decodes `num_temporal_units` alternating LPCM frames through the end of the
+// stream. Returns the output samples arranged in (channel, time) axes.
+std::vector<std::vector<int32_t>> DecodeStereoUntilEndOfStream(
+    const api::IamfDecoder::Settings& decoder_settings,
+    int num_temporal_units) {
+  std::unique_ptr<api::IamfDecoder> decoder;
+  EXPECT_TRUE(api::IamfDecoder::Create(decoder_settings, decoder).ok());
+  std::vector<uint8_t> source_data = GenerateBasicDescriptorObus();
+  AudioFrameObu audio_frame(ObuHeader(), kFirstSubstreamId,
+                            kEightSampleAudioFrame);
+  AudioFrameObu audio_frame2(ObuHeader(), kFirstSubstreamId,
+                             kEightSampleAudioFrame2);
+  for (int i = 0; i < num_temporal_units; ++i) {
+    auto temporal_unit =
+        SerializeObusExpectOk({i % 2 == 0 ? &audio_frame : &audio_frame2});
+    source_data.insert(source_data.end(), temporal_unit.begin(),
+                       temporal_unit.end());
+  }
+  EXPECT_TRUE(decoder->Decode(source_data.data(), source_data.size()).ok());
+  EXPECT_TRUE(decoder->SignalEndOfDecoding().ok());
+
+  constexpr int kNumChannels = 2;
+  constexpr size_t kBytesPerSample = 4;
+  std::vector<std::vector<int32_t>> output_samples(kNumChannels);
+  std::vector<uint8_t> output_data(1024);
+  while (decoder->IsTemporalUnitAvailable()) {
+    size_t bytes_written;
+    EXPECT_TRUE(decoder
+                    ->GetOutputTemporalUnit(output_data.data(),
+                                            output_data.size(), bytes_written)
+                    .ok());
+    for (size_t i = 0; i < bytes_written; i += kBytesPerSample) {
+      const uint32_t sample =
+          static_cast<uint32_t>(output_data[i]) |
+          static_cast<uint32_t>(output_data[i + 1]) << 8 |
+          static_cast<uint32_t>(output_data[i + 2]) << 16 |
+          static_cast<uint32_t>(output_data[i + 3]) << 24;
+      output_samples[(i / kBytesPerSample) % kNumChannels].push_back(
+          static_cast<int32_t>(sample));
+    }
+  }
+  return output_samples;
+}
+
+TEST(GetOutputTemporalUnit, ResamplesToRequestedOutputSampleRate) {
+  constexpr int kNumTemporalUnits = 2;
+  auto decoder_settings = GetStereoDecoderSettings();
+  decoder_settings.requested_output_sample_rate = 2 * kSampleRate;
+
+  const auto output_samples =
+      DecodeStereoUntilEndOfStream(decoder_settings, kNumTemporalUnits);
+
+  // Every channel has twice the number of input samples, including the ones
+  // held back by the resampler until the end of the stream.
+  ASSERT_EQ(output_samples.size(), 2);
+  for (const auto& channel : output_samples) {
+    EXPECT_EQ(channel.size(), 2 * kNumTemporalUnits * kNumSamplesPerFrame);
+  }
+}
+
+TEST(GetOutputTemporalUnit, ResampledOutputIsAlignedWithTheInput) {
+  constexpr int kNumTemporalUnits = 20;
+  constexpr uint32_t kOutputSampleRate = 44100;
+  const auto original_samples = DecodeStereoUntilEndOfStream(
+      GetStereoDecoderSettings(), kNumTemporalUnits);
+  auto decoder_settings = GetStereoDecoderSettings();
+  decoder_settings.requested_output_sample_rate = kOutputSampleRate;
+  const auto resampled_samples =
+      DecodeStereoUntilEndOfStream(decoder_settings, kNumTemporalUnits);
+
+  // Resample the original output of the decoder as one stream.
+  auto resampler = PolyphaseResampler::Create(
+      kSampleRate, kOutputSampleRate, original_samples.size());
+  ASSERT_TRUE(resampler.ok());
+  std::vector<std::vector<double>> original_channels;
+  for (const auto& channel : original_samples) {
+    auto& original_channel = original_channels.emplace_back();
+    for (const int32_t sample : channel) {
+      original_channel.push_back(
+          Int32ToNormalizedFloatingPoint<double>(sample));
+    }
+  }
+  const std::vector<absl::Span<const double>> original_spans(
+      original_channels.begin(), original_channels.end());
+  std::vector<std::vector<double>> expected_channels;
+  std::vector<std::vector<double>> flushed_channels;
+  ASSERT_TRUE((*resampler)->Process(original_spans, expected_channels).ok());
+  ASSERT_TRUE((*resampler)->Flush(flushed_channels).ok());
+
+  ASSERT_EQ(resampled_samples.size(), expected_channels.size());
+  for (int c = 0; c < expected_channels.size(); ++c) {
+    expected_channels[c].insert(expected_channels[c].end(),
+                                flushed_channels[c].begin(),
+                                flushed_channels[c].end());
+    // The length scales with the ratio of the sample rates, rounded up.
+    EXPECT_EQ(resampled_samples[c].size(),
+              (kNumTemporalUnits * kNumSamplesPerFrame * kOutputSampleRate +
+               kSampleRate - 1) /
+                  kSampleRate);
+    ASSERT_EQ(resampled_samples[c].size(), expected_channels[c].size());
+    for (int t = 0; t < expected_channels[c].size(); ++t) {
+      int32_t expected_sample;
+      ASSERT_TRUE(NormalizedFloatingPointToInt32(expected_channels[c][t],
+                                                 expected_sample)
+                      .ok());
+      // Allow for the rounding of the rendered samples to `int32_t`.
+      constexpr int32_t kTolerance = 16;
+      EXPECT_NEAR(resampled_samples[c][t], expected_sample, kTolerance);
+    }
+  }
+}
+
+TEST(GetSampleRate, IgnoresRequestedOutputSampleRateMatchingTheBitstream) {
+  std::vector<uint8_t> source_data = GenerateBasicDescriptorObus();
+  auto decoder_settings = GetStereoDecoderSettings();
+  decoder_settings.requested_output_sample_rate = kSampleRate;
+  std::unique_ptr<api::IamfDecoder> decoder;
+  ASSERT_TRUE(api::IamfDecoder::CreateFromDescriptors(
+                  decoder_settings, source_data.data(), source_data.size(),
+                  decoder)
+                  .ok());
+
+  uint32_t sample_rate;
+  ASSERT_TRUE(decoder->GetSampleRate(sample_rate).ok());
+  EXPECT_EQ(sample_rate, kSampleRate);
+  uint32_t frame_size;
+  ASSERT_TRUE(decoder->GetFrameSize(frame_size).ok());
+  EXPECT_EQ(frame_size, kNumSamplesPerFrame);
+}
+
 TEST(Reset, DecodingAfterResetSucceedsAfterCreateFromDescriptors) {
   // Create a decoder from descriptors.
   std::vector<uint8_t> source_data = GenerateBasicDescriptorObus();
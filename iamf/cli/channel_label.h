@@ -143,6 +143,9 @@ class ChannelLabel {
     kA24,
   };
 
+  // Number of labels. `kA24` must remain the last label of `Label`.
+  static constexpr int kNumLabels = kA24 + 1;
+
   template <typename Sink>
   friend void AbslStringify(Sink& sink, Label e) {
     sink.Append(LabelToStringForDebugging(e));
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+
+#include "iamf/cli/codec/chunked_encoder.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/btree_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "iamf/cli/audio_frame_with_data.h"
+#include "iamf/cli/codec/encoder_base.h"
+#include "iamf/common/utils/macros.h"
+#include "iamf/common/utils/thread_pool.h"
+#include "iamf/obu/codec_config.h"
+
+namespace iamf_tools {
+
+namespace {
+
+// Frames of a chunk, waiting to be encoded.
+struct Chunk {
+  size_t chunk_index;
+  uint32_t first_frame_index;
+  std::vector<std::vector<std::vector<int32_t>>> samples;
+  std::vector<std::unique_ptr<AudioFrameWithData>> audio_frames;
+};
+
+absl::StatusOr<std::list<AudioFrameWithData>> EncodeChunk(
+    const ChunkedEncoder::EncoderFactory& encoder_factory,
+    const ChunkedEncoder::StitchFrameFunction& stitch_frame, Chunk& chunk) {
+  auto encoder = encoder_factory();
+  if (!encoder.ok()) {
+    return encoder.status();
+  }
+  for (size_t i = 0; i < chunk.samples.size(); ++i) {
+    RETURN_IF_NOT_OK((*encoder)->EncodeAudioFrame(
+        chunk.samples[i], std::move(chunk.audio_frames[i])));
+  }
+  RETURN_IF_NOT_OK((*encoder)->Finalize());
+
+  std::list<AudioFrameWithData> encoded_frames;
+  while ((*encoder)->FramesAvailable()) {
+    RETURN_IF_NOT_OK((*encoder)->Pop(encoded_frames));
+  }
+  if (encoded_frames.size() != chunk.samples.size()) {
+    return absl::InternalError(absl::StrCat(
+        "Expected ", chunk.samples.size(), " encoded frames in the chunk. Got ",
+        encoded_frames.size(), "."));
+  }
+
+  if (stitch_frame) {
+    uint32_t frame_index = chunk.first_frame_index;
+    for (auto& encoded_frame : encoded_frames) {
+      RETURN_IF_NOT_OK(
+          stitch_frame(frame_index++, encoded_frame.obu.audio_frame_));
+    }
+  }
+  return encoded_frames;
+}
+
+}  // namespace
+
+struct ChunkedEncoder::SharedState {
+  SharedState(EncoderFactory encoder_factory, StitchFrameFunction stitch_frame)
+      : encoder_factory(std::move(encoder_factory)),
+        stitch_frame(std::move(stitch_frame)) {}
+
+  const EncoderFactory encoder_factory;
+  const StitchFrameFunction stitch_frame;
+
+  absl::Mutex mutex;
+
+  // Chunks which are scheduled, but not yet being encoded.
+  std::deque<Chunk> chunks_to_encode ABSL_GUARDED_BY(mutex);
+
+  // Chunks which are scheduled or being encoded.
+  size_t num_chunks_in_flight ABSL_GUARDED_BY(mutex) = 0;
+
+  // Encoded frames (or the error which occurred), keyed by the chunk index.
+  absl::btree_map<size_t, absl::StatusOr<std::list<AudioFrameWithData>>>
+      encoded_chunks ABSL_GUARDED_BY(mutex);
+};
+
+ChunkedEncoder::ChunkedEncoder(EncoderFactory encoder_factory,
+                               StitchFrameFunction stitch_frame,
+                               uint32_t num_frames_per_chunk,
+                               const CodecConfigObu& codec_config,
+                               int num_channels)
+    : EncoderBase(codec_config, num_channels),
+      num_frames_per_chunk_(std::max(num_frames_per_chunk, uint32_t{1})),
+      max_num_chunks_in_flight_(ThreadPool::GetShared().NumThreads() + 1),
+      shared_state_(std::make_shared<SharedState>(std::move(encoder_factory),
+                                                  std::move(stitch_frame))) {}
+
+ChunkedEncoder::~ChunkedEncoder() {
+  // Scheduled tasks hold on to the shared state, but the frames of the chunks
+  // must not outlive the encoder.
+  WaitForChunks(0);
+}
+
+absl::Status ChunkedEncoder::EncodeAudioFrame(
+    const std::vector<std::vector<int32_t>>& samples,
+    std::unique_ptr<AudioFrameWithData> partial_audio_frame_with_data) {
+  RETURN_IF_NOT_OK(ValidateNotFinalized());
+  RETURN_IF_NOT_OK(ValidateInputSamples(samples));
+
+  chunk_samples_.push_back(samples);
+  chunk_audio_frames_.push_back(std::move(partial_audio_frame_with_data));
+  if (chunk_samples_.size() == num_frames_per_chunk_) {
+    ScheduleCurrentChunk();
+  }
+  return MoveEncodedChunks();
+}
+
+absl::Status ChunkedEncoder::Finalize() {
+  if (!chunk_samples_.empty()) {
+    ScheduleCurrentChunk();
+  }
+  WaitForChunks(0);
+  RETURN_IF_NOT_OK(MoveEncodedChunks());
+  return EncoderBase::Finalize();
+}
+
+void ChunkedEncoder::EncodeNextChunk(SharedState& shared_state) {
+  Chunk chunk;
+  {
+    absl::MutexLock lock(&shared_state.mutex);
+    if (shared_state.chunks_to_encode.empty()) {
+      // Another thread helped to encode the chunk.
+      return;
+    }
+    chunk = std::move(shared_state.chunks_to_encode.front());
+    shared_state.chunks_to_encode.pop_front();
+  }
+
+  auto encoded_frames = EncodeChunk(shared_state.encoder_factory,
+                                    shared_state.stitch_frame, chunk);
+
+  absl::MutexLock lock(&shared_state.mutex);
+  shared_state.encoded_chunks.emplace(chunk.chunk_index,
+                                      std::move(encoded_frames));
+  --shared_state.num_chunks_in_flight;
+}
+
+absl::Status ChunkedEncoder::InitializeEncoder() {
+  // Validates the encoder settings once, up front.
+  auto encoder = shared_state_->encoder_factory();
+  if (!encoder.ok()) {
+    return encoder.status();
+  }
+  required_samples_to_delay_at_start_ =
+      (*encoder)->GetNumberOfSamplesToDelayAtStart();
+  return absl::OkStatus();
+}
+
+void ChunkedEncoder::ScheduleCurrentChunk() {
+  const auto num_frames = static_cast<uint32_t>(chunk_samples_.size());
+  {
+    absl::MutexLock lock(&shared_state_->mutex);
+    shared_state_->chunks_to_encode.push_back(
+        {.chunk_index = next_chunk_index_++,
+         .first_frame_index = next_frame_index_,
+         .samples = std::move(chunk_samples_),
+         .audio_frames = std::move(chunk_audio_frames_)});
+    ++shared_state_->num_chunks_in_flight;
+  }
+  next_frame_index_ += num_frames;
+  chunk_samples_.clear();
+  chunk_audio_frames_.clear();
+
+  ThreadPool::GetShared().Schedule(
+      [shared_state = shared_state_] { EncodeNextChunk(*shared_state); });
+  WaitForChunks(max_num_chunks_in_flight_);
+}
+
+void ChunkedEncoder::WaitForChunks(size_t max_num_chunks_in_flight) {
+  while (true) {
+    {
+      absl::MutexLock lock(&shared_state_->mutex);
+      if (shared_state_->num_chunks_in_flight <= max_num_chunks_in_flight) {
+        return;
+      }
+      if (shared_state_->chunks_to_encode.empty()) {
+        // The chunks in flight are being encoded on other threads. Only this
+        // thread schedules chunks, so just wait for them.
+        const auto few_enough_chunks_in_flight =
+            [&]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(shared_state_->mutex) {
+              return shared_state_->num_chunks_in_flight <=
+                     max_num_chunks_in_flight;
+            };
+        shared_state_->mutex.Await(
+            absl::Condition(&few_enough_chunks_in_flight));
+        return;
+      }
+    }
+    EncodeNextChunk(*shared_state_);
+  }
+}
+
+absl::Status ChunkedEncoder::MoveEncodedChunks() {
+  std::list<AudioFrameWithData> encoded_frames;
+  absl::Status status = absl::OkStatus();
+  {
+    absl::MutexLock lock(&shared_state_->mutex);
+    auto& encoded_chunks = shared_state_->encoded_chunks;
+    while (!encoded_chunks.empty() &&
+           encoded_chunks.begin()->first == next_chunk_index_to_output_) {
+      auto& encoded_chunk = encoded_chunks.begin()->second;
+      if (!encoded_chunk.ok()) {
+        // Keep the failed chunk, to report it again on any later call.
+        status = encoded_chunk.status();
+        break;
+      }
+      encoded_frames.splice(encoded_frames.end(), *encoded_chunk);
+      encoded_chunks.erase(encoded_chunks.begin());
+      ++next_chunk_index_to_output_;
+    }
+  }
+
+  absl::MutexLock lock(&mutex_);
+  finalized_audio_frames_.splice(finalized_audio_frames_.end(),
+                                 encoded_frames);
+  return status;
+}
+
+}  // namespace iamf_tools
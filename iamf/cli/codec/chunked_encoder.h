@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+
+#ifndef CLI_CODEC_CHUNKED_ENCODER_H_
+#define CLI_CODEC_CHUNKED_ENCODER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "iamf/cli/audio_frame_with_data.h"
+#include "iamf/cli/codec/encoder_base.h"
+#include "iamf/obu/codec_config.h"
+
+namespace iamf_tools {
+
+/*!\brief Encodes chunks of consecutive frames of a substream in parallel.
+ *
+ * For offline encoding of codecs whose frames do not depend on each other
+ * (e.g. LPCM or FLAC). Every `num_frames_per_chunk` frames passed to
+ * `EncodeAudioFrame()` are encoded as one chunk, by a fresh encoder, on the
+ * shared thread pool. Encoded chunks are stitched back together in order, so
+ * the frames are popped in the order they were received, with their
+ * timestamps and trimming information. Each frame may be adapted to its
+ * position in the substream, for example to renumber it.
+ *
+ * Frames only become available when their whole chunk has been encoded, so
+ * they lag the input by up to a few chunks. At most a few more chunks than
+ * there are threads in the pool are kept in flight; beyond that
+ * `EncodeAudioFrame()` helps to encode the chunks, then waits for them.
+ */
+class ChunkedEncoder : public EncoderBase {
+ public:
+  /*!\brief Creates and initializes an encoder for one chunk. */
+  using EncoderFactory = absl::AnyInvocable<
+      absl::StatusOr<std::unique_ptr<EncoderBase>>() const>;
+
+  /*!\brief Adapts an encoded frame to its index in the substream. */
+  using StitchFrameFunction = absl::AnyInvocable<absl::Status(
+      uint32_t frame_index, std::vector<uint8_t>& audio_frame) const>;
+
+  /*!\brief Constructor.
+   *
+   * \param encoder_factory Factory to create the encoder of each chunk.
+   * \param stitch_frame Function to adapt each encoded frame to its index in
+   *        the substream, or `nullptr` when frames need no adaptation.
+   * \param num_frames_per_chunk Number of frames in each chunk.
+   * \param codec_config Codec Config OBU for the encoder.
+   * \param num_channels Number of channels for the encoder.
+   */
+  ChunkedEncoder(EncoderFactory encoder_factory,
+                 StitchFrameFunction stitch_frame,
+                 uint32_t num_frames_per_chunk,
+                 const CodecConfigObu& codec_config, int num_channels);
+
+  /*!\brief Destructor. Waits for any chunks still being encoded. */
+  ~ChunkedEncoder() override;
+
+  /*!\brief Adds an audio frame to the current chunk.
+   *
+   * The chunk is scheduled to be encoded once it is full.
+   *
+   * \param samples Samples arranged in (channel, time) axes. The samples are
+   *        left-justified and stored in the upper `input_pcm_bit_depth_` bits.
+   * \param partial_audio_frame_with_data Unique pointer to take ownership of.
+   *        The underlying `audio_frame_` is modified. All other fields are
+   *        blindly passed along.
+   * \return `absl::OkStatus()` on success. Success does not necessarily mean
+   *         the frame was finished. A specific status on failure, including
+   *         the failure to encode an earlier chunk.
+   */
+  absl::Status EncodeAudioFrame(
+      const std::vector<std::vector<int32_t>>& samples,
+      std::unique_ptr<AudioFrameWithData> partial_audio_frame_with_data)
+      override;
+
+  /*!\brief Finalizes the encoder.
+   *
+   * Encodes the last, possibly partial, chunk and waits for all chunks to be
+   * encoded.
+   *
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status Finalize() override;
+
+ private:
+  // State shared with the chunks being encoded on the thread pool.
+  struct SharedState;
+
+  /*!\brief Encodes the next scheduled chunk, if any.
+   *
+   * \param shared_state State holding the scheduled chunks.
+   */
+  static void EncodeNextChunk(SharedState& shared_state);
+
+  /*!\brief Initializes the encoder by creating the encoder of a chunk.
+   *
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status InitializeEncoder() override;
+
+  /*!\brief Keeps the delay copied from the encoder of a chunk.
+   *
+   * The encoders of the chunks already validate the codec delay.
+   *
+   * \return `absl::OkStatus()`.
+   */
+  absl::Status SetNumberOfSamplesToDelayAtStart(
+      bool /*validate_codec_delay*/) override {
+    return absl::OkStatus();
+  }
+
+  /*!\brief Schedules the current chunk to be encoded.
+   *
+   * Helps to encode, then waits for, earlier chunks when too many are in
+   * flight.
+   */
+  void ScheduleCurrentChunk();
+
+  /*!\brief Helps to encode, then waits for, the chunks in flight.
+   *
+   * \param max_num_chunks_in_flight Number of chunks which may remain in
+   *        flight.
+   */
+  void WaitForChunks(size_t max_num_chunks_in_flight);
+
+  /*!\brief Moves the frames of the next encoded chunks to the output.
+   *
+   * \return `absl::OkStatus()` on success. The status of the first chunk
+   *         which failed to be encoded otherwise.
+   */
+  absl::Status MoveEncodedChunks();
+
+  const uint32_t num_frames_per_chunk_;
+  const size_t max_num_chunks_in_flight_;
+  std::shared_ptr<SharedState> shared_state_;
+
+  // Frames of the chunk which is being filled.
+  std::vector<std::vector<std::vector<int32_t>>> chunk_samples_;
+  std::vector<std::unique_ptr<AudioFrameWithData>> chunk_audio_frames_;
+
+  uint32_t next_frame_index_ = 0;
+  size_t next_chunk_index_ = 0;
+  size_t next_chunk_index_to_output_ = 0;
+};
+
+}  // namespace iamf_tools
+
+#endif  // CLI_CODEC_CHUNKED_ENCODER_H_
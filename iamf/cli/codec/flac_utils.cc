@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+
+#include "iamf/cli/codec/flac_utils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+
+namespace iamf_tools {
+
+namespace {
+
+// The frame number of fixed-blocksize frames is coded in at most 31 bits.
+constexpr uint32_t kMaxFrameNumber = (uint32_t{1} << 31) - 1;
+
+// Size of the fields before the coded number: the sync code, blocking
+// strategy, block size, sample rate, channel assignment and sample size.
+constexpr size_t kCodedNumberOffset = 4;
+
+// CRC-8 of the frame header, with the polynomial x^8 + x^2 + x + 1.
+uint8_t Crc8(absl::Span<const uint8_t> data) {
+  uint8_t crc = 0;
+  for (const uint8_t byte : data) {
+    crc ^= byte;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc =
+          static_cast<uint8_t>((crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1);
+    }
+  }
+  return crc;
+}
+
+// CRC-16 of the frame, with the polynomial x^16 + x^15 + x^2 + 1.
+uint16_t Crc16(absl::Span<const uint8_t> data) {
+  uint16_t crc = 0;
+  for (const uint8_t byte : data) {
+    crc ^= static_cast<uint16_t>(byte) << 8;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x8005
+                                                 : crc << 1);
+    }
+  }
+  return crc;
+}
+
+// Gets the size of a coded number from its first byte, or 0 if it is invalid.
+size_t GetCodedNumberSize(uint8_t first_byte) {
+  if ((first_byte & 0x80) == 0) {
+    return 1;
+  }
+  size_t size = 0;
+  while (size < 8 && (first_byte & (0x80 >> size)) != 0) {
+    ++size;
+  }
+  // A leading `10` marks a continuation byte, not the start of a number.
+  return (size >= 2 && size <= 6) ? size : 0;
+}
+
+// Codes a number like UTF-8, as used for the frame number of FLAC frames.
+std::vector<uint8_t> CodeNumber(uint32_t number) {
+  if (number < 0x80) {
+    return {static_cast<uint8_t>(number)};
+  }
+  size_t size = 2;
+  while (size < 6 && number >= (uint32_t{1} << (5 * size + 1))) {
+    ++size;
+  }
+  std::vector<uint8_t> coded_number(size);
+  for (size_t i = size - 1; i > 0; --i) {
+    coded_number[i] = 0x80 | (number & 0x3f);
+    number >>= 6;
+  }
+  coded_number[0] = static_cast<uint8_t>((0xff00 >> size) | number);
+  return coded_number;
+}
+
+}  // namespace
+
+absl::Status SetFlacFrameNumber(uint32_t frame_number,
+                                std::vector<uint8_t>& flac_frame) {
+  if (frame_number > kMaxFrameNumber) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Frame number ", frame_number, " is too large."));
+  }
+  if (flac_frame.size() <= kCodedNumberOffset || flac_frame[0] != 0xff ||
+      (flac_frame[1] & 0xfe) != 0xf8) {
+    return absl::InvalidArgumentError("Expected a FLAC frame.");
+  }
+  if ((flac_frame[1] & 0x01) != 0) {
+    return absl::InvalidArgumentError(
+        "Expected a FLAC frame with a fixed block size.");
+  }
+
+  // Optional block size and sample rate fields follow the coded number.
+  const uint8_t block_size_code = flac_frame[2] >> 4;
+  const uint8_t sample_rate_code = flac_frame[2] & 0x0f;
+  const size_t block_size_field_size =
+      block_size_code == 6 ? 1 : (block_size_code == 7 ? 2 : 0);
+  const size_t sample_rate_field_size =
+      sample_rate_code == 12
+          ? 1
+          : (sample_rate_code == 13 || sample_rate_code == 14 ? 2 : 0);
+
+  const size_t old_coded_number_size =
+      GetCodedNumberSize(flac_frame[kCodedNumberOffset]);
+  if (old_coded_number_size == 0) {
+    return absl::InvalidArgumentError("Invalid coded FLAC frame number.");
+  }
+  const size_t old_crc8_offset = kCodedNumberOffset + old_coded_number_size +
+                                 block_size_field_size +
+                                 sample_rate_field_size;
+  // The frame ends with the CRC-16, after the CRC-8 of the header.
+  if (flac_frame.size() < old_crc8_offset + 3) {
+    return absl::InvalidArgumentError("FLAC frame is too small.");
+  }
+
+  // Rebuild the header around the new coded number, then reuse the subframes.
+  std::vector<uint8_t> renumbered_frame(
+      flac_frame.begin(), flac_frame.begin() + kCodedNumberOffset);
+  const auto coded_number = CodeNumber(frame_number);
+  renumbered_frame.insert(renumbered_frame.end(), coded_number.begin(),
+                          coded_number.end());
+  renumbered_frame.insert(
+      renumbered_frame.end(),
+      flac_frame.begin() + kCodedNumberOffset + old_coded_number_size,
+      flac_frame.begin() + old_crc8_offset);
+  renumbered_frame.push_back(Crc8(renumbered_frame));
+  renumbered_frame.insert(renumbered_frame.end(),
+                          flac_frame.begin() + old_crc8_offset + 1,
+                          flac_frame.end() - 2);
+  const uint16_t crc16 = Crc16(renumbered_frame);
+  renumbered_frame.push_back(static_cast<uint8_t>(crc16 >> 8));
+  renumbered_frame.push_back(static_cast<uint8_t>(crc16 & 0xff));
+
+  flac_frame = std::move(renumbered_frame);
+  return absl::OkStatus();
+}
+
+}  // namespace iamf_tools
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+
+#ifndef CLI_CODEC_FLAC_UTILS_H_
+#define CLI_CODEC_FLAC_UTILS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/status/status.h"
+
+namespace iamf_tools {
+
+/*!\brief Sets the frame number of a fixed-blocksize FLAC frame.
+ *
+ * Rewrites the coded frame number and updates the CRC-8 of the frame header
+ * and the CRC-16 of the frame. Useful to place a frame which was encoded by a
+ * fresh encoder later in the stream.
+ *
+ * \param frame_number Frame number to set.
+ * \param flac_frame FLAC frame to modify.
+ * \return `absl::OkStatus()` on success. A specific status on failure.
+ */
+absl::Status SetFlacFrameNumber(uint32_t frame_number,
+                                std::vector<uint8_t>& flac_frame);
+
+}  // namespace iamf_tools
+
+#endif  // CLI_CODEC_FLAC_UTILS_H_
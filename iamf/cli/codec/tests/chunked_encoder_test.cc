@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/cli/codec/chunked_encoder.h"
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/status_matchers.h"
+#include "absl/status/statusor.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "iamf/cli/audio_frame_with_data.h"
+#include "iamf/cli/codec/encoder_base.h"
+#include "iamf/cli/codec/lpcm_encoder.h"
+#include "iamf/cli/codec/tests/encoder_test_base.h"
+#include "iamf/common/utils/macros.h"
+#include "iamf/obu/audio_frame.h"
+#include "iamf/obu/codec_config.h"
+#include "iamf/obu/decoder_config/lpcm_decoder_config.h"
+#include "iamf/obu/obu_header.h"
+
+namespace iamf_tools {
+namespace {
+
+using ::absl_testing::IsOk;
+using ::testing::Not;
+
+constexpr bool kOverrideAudioRollDistance = true;
+constexpr int kNumFrames = 100;
+
+CodecConfigObu CreateLpcmCodecConfig(uint32_t num_samples_per_frame) {
+  const CodecConfig codec_config = {
+      .codec_id = CodecConfig::kCodecIdLpcm,
+      .num_samples_per_frame = num_samples_per_frame,
+      .decoder_config = LpcmDecoderConfig{
+          .sample_format_flags_bitmask_ = LpcmDecoderConfig::kLpcmLittleEndian,
+          .sample_size_ = 16,
+          .sample_rate_ = 48000}};
+  auto codec_config_obu = CodecConfigObu::Create(
+      ObuHeader(), 0, codec_config, kOverrideAudioRollDistance);
+  EXPECT_THAT(codec_config_obu, IsOk());
+  return *codec_config_obu;
+}
+
+ChunkedEncoder::EncoderFactory CreateLpcmEncoderFactory(
+    const CodecConfigObu& codec_config, int num_channels) {
+  return [codec_config, num_channels]()
+             -> absl::StatusOr<std::unique_ptr<EncoderBase>> {
+    auto encoder = std::make_unique<LpcmEncoder>(codec_config, num_channels);
+    RETURN_IF_NOT_OK(encoder->Initialize(kValidateCodecDelay));
+    return encoder;
+  };
+}
+
+std::vector<std::vector<int32_t>> GetFrame(int num_channels,
+                                           uint32_t num_samples_per_frame,
+                                           int frame_index) {
+  std::vector<std::vector<int32_t>> frame(num_channels);
+  for (int c = 0; c < num_channels; ++c) {
+    for (uint32_t t = 0; t < num_samples_per_frame; ++t) {
+      frame[c].push_back((frame_index * 1000 + c * 100 + t) << 16);
+    }
+  }
+  return frame;
+}
+
+class ChunkedEncoderTest : public EncoderTestBase, public testing::Test {
+ public:
+  ChunkedEncoderTest() {
+    num_channels_ = 2;
+    num_samples_per_frame_ = 4;
+  }
+
+  ~ChunkedEncoderTest() = default;
+
+ protected:
+  void ConstructEncoder() override {
+    const auto codec_config = CreateLpcmCodecConfig(num_samples_per_frame_);
+    encoder_ = std::make_unique<ChunkedEncoder>(
+        CreateLpcmEncoderFactory(codec_config, num_channels_),
+        std::move(stitch_frame_), num_frames_per_chunk_, codec_config,
+        num_channels_);
+  }
+
+  // Encodes the frames with a single `LpcmEncoder` to get the expected frames.
+  void EncodeFramesAndExpectSameAsOneEncoder() {
+    auto lpcm_encoder = CreateLpcmEncoderFactory(
+        CreateLpcmCodecConfig(num_samples_per_frame_), num_channels_)();
+    ASSERT_THAT(lpcm_encoder, IsOk());
+    for (int i = 0; i < kNumFrames; ++i) {
+      const auto frame = GetFrame(num_channels_, num_samples_per_frame_, i);
+      EncodeAudioFrame(frame);
+      ASSERT_THAT(
+          (*lpcm_encoder)->EncodeAudioFrame(
+              frame, std::make_unique<AudioFrameWithData>(AudioFrameWithData{
+                         .obu = AudioFrameObu(ObuHeader(), 0, {})})),
+          IsOk());
+    }
+    ASSERT_THAT((*lpcm_encoder)->Finalize(), IsOk());
+    std::list<AudioFrameWithData> lpcm_audio_frames;
+    while ((*lpcm_encoder)->FramesAvailable()) {
+      ASSERT_THAT((*lpcm_encoder)->Pop(lpcm_audio_frames), IsOk());
+    }
+    for (const auto& lpcm_audio_frame : lpcm_audio_frames) {
+      expected_audio_frames_.push_back(lpcm_audio_frame.obu.audio_frame_);
+    }
+  }
+
+  uint32_t num_frames_per_chunk_ = 8;
+  ChunkedEncoder::StitchFrameFunction stitch_frame_ = nullptr;
+};
+
+TEST_F(ChunkedEncoderTest, OutputIsTheSameAsOneEncoder) {
+  InitExpectOk();
+
+  EncodeFramesAndExpectSameAsOneEncoder();
+
+  FinalizeAndValidate();
+}
+
+TEST_F(ChunkedEncoderTest, OutputIsTheSameAsOneEncoderWithOneFramePerChunk) {
+  num_frames_per_chunk_ = 1;
+  InitExpectOk();
+
+  EncodeFramesAndExpectSameAsOneEncoder();
+
+  FinalizeAndValidate();
+}
+
+TEST_F(ChunkedEncoderTest, OutputIsTheSameAsOneEncoderWithOneChunk) {
+  num_frames_per_chunk_ = kNumFrames + 1;
+  InitExpectOk();
+
+  EncodeFramesAndExpectSameAsOneEncoder();
+
+  FinalizeAndValidate();
+}
+
+TEST_F(ChunkedEncoderTest, StitchesFramesWithTheirIndexInTheSubstream) {
+  stitch_frame_ = [](uint32_t frame_index, std::vector<uint8_t>& audio_frame) {
+    audio_frame = {static_cast<uint8_t>(frame_index)};
+    return absl::OkStatus();
+  };
+  InitExpectOk();
+
+  for (int i = 0; i < kNumFrames; ++i) {
+    EncodeAudioFrame(GetFrame(num_channels_, num_samples_per_frame_, i));
+    expected_audio_frames_.push_back({static_cast<uint8_t>(i)});
+  }
+
+  FinalizeAndValidate();
+}
+
+TEST_F(ChunkedEncoderTest, FinalizeFailsWhenStitchingTheLastChunkFails) {
+  // The last chunk is partial, so it is only encoded by `Finalize()`.
+  ASSERT_NE(kNumFrames % num_frames_per_chunk_, 0);
+  stitch_frame_ = [](uint32_t frame_index, std::vector<uint8_t>&) {
+    return frame_index == kNumFrames - 1 ? absl::UnknownError("")
+                                         : absl::OkStatus();
+  };
+  InitExpectOk();
+
+  for (int i = 0; i < kNumFrames; ++i) {
+    EncodeAudioFrame(GetFrame(num_channels_, num_samples_per_frame_, i));
+  }
+
+  EXPECT_THAT(encoder_->Finalize(), Not(IsOk()));
+}
+
+TEST(ChunkedEncoder, InitializeFailsWhenTheEncoderFactoryFails) {
+  const auto codec_config = CreateLpcmCodecConfig(4);
+  ChunkedEncoder encoder(
+      []() -> absl::StatusOr<std::unique_ptr<EncoderBase>> {
+        return absl::UnknownError("");
+      },
+      nullptr, 8, codec_config, 1);
+
+  EXPECT_THAT(encoder.Initialize(kValidateCodecDelay), Not(IsOk()));
+}
+
+TEST(ChunkedEncoder, FinalizeFailsWhenTheEncoderOfAChunkCannotBeCreated) {
+  const auto codec_config = CreateLpcmCodecConfig(4);
+  auto num_encoders = std::make_shared<std::atomic<int>>(0);
+  ChunkedEncoder encoder(
+      [num_encoders, lpcm_encoder_factory = CreateLpcmEncoderFactory(
+                         codec_config, 1)]()
+          -> absl::StatusOr<std::unique_ptr<EncoderBase>> {
+        // Allow the encoder created by `Initialize()` only.
+        if ((*num_encoders)++ > 0) {
+          return absl::UnknownError("");
+        }
+        return lpcm_encoder_factory();
+      },
+      nullptr, 8, codec_config, 1);
+  ASSERT_THAT(encoder.Initialize(kValidateCodecDelay), IsOk());
+
+  ASSERT_THAT(encoder.EncodeAudioFrame(
+                  GetFrame(1, 4, 0),
+                  std::make_unique<AudioFrameWithData>(AudioFrameWithData{
+                      .obu = AudioFrameObu(ObuHeader(), 0, {})})),
+              IsOk());
+
+  EXPECT_THAT(encoder.Finalize(), Not(IsOk()));
+  EXPECT_FALSE(encoder.FramesAvailable());
+}
+
+}  // namespace
+}  // namespace iamf_tools
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/cli/codec/flac_utils.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/status/status_matchers.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace iamf_tools {
+namespace {
+
+using ::absl_testing::IsOk;
+using ::testing::ElementsAreArray;
+using ::testing::Not;
+
+// A stereo frame with a single 16-bit sample, with frame number 0. From the
+// examples of RFC 9639.
+const std::vector<uint8_t> kFrameNumberZero = {
+    0xff, 0xf8, 0x69, 0x18, 0x00, 0x00, 0xbf, 0x03,
+    0x58, 0xfd, 0x03, 0x12, 0x8b, 0xaa, 0x9a};
+
+TEST(SetFlacFrameNumber, KeepsFrameNumberZero) {
+  auto flac_frame = kFrameNumberZero;
+
+  EXPECT_THAT(SetFlacFrameNumber(0, flac_frame), IsOk());
+
+  EXPECT_EQ(flac_frame, kFrameNumberZero);
+}
+
+TEST(SetFlacFrameNumber, UpdatesOneByteFrameNumberAndCrcs) {
+  auto flac_frame = kFrameNumberZero;
+
+  EXPECT_THAT(SetFlacFrameNumber(1, flac_frame), IsOk());
+
+  EXPECT_THAT(flac_frame,
+              ElementsAreArray({0xff, 0xf8, 0x69, 0x18, 0x01, 0x00, 0xaa, 0x03,
+                                0x58, 0xfd, 0x03, 0x12, 0x8b, 0xb8, 0xaa}));
+}
+
+TEST(SetFlacFrameNumber, GrowsFrameForLongerCodedFrameNumber) {
+  auto flac_frame = kFrameNumberZero;
+
+  EXPECT_THAT(SetFlacFrameNumber(1000, flac_frame), IsOk());
+
+  EXPECT_THAT(flac_frame, ElementsAreArray({0xff, 0xf8, 0x69, 0x18, 0xcf, 0xa8,
+                                            0x00, 0x4e, 0x03, 0x58, 0xfd, 0x03,
+                                            0x12, 0x8b, 0x75, 0x26}));
+}
+
+TEST(SetFlacFrameNumber, IsReversible) {
+  auto flac_frame = kFrameNumberZero;
+
+  EXPECT_THAT(SetFlacFrameNumber(123456789, flac_frame), IsOk());
+  EXPECT_THAT(SetFlacFrameNumber(0, flac_frame), IsOk());
+
+  EXPECT_EQ(flac_frame, kFrameNumberZero);
+}
+
+TEST(SetFlacFrameNumber, InvalidForTooLargeFrameNumber) {
+  auto flac_frame = kFrameNumberZero;
+
+  EXPECT_THAT(SetFlacFrameNumber(uint32_t{1} << 31, flac_frame), Not(IsOk()));
+}
+
+TEST(SetFlacFrameNumber, InvalidWithoutSyncCode) {
+  auto flac_frame = kFrameNumberZero;
+  flac_frame[0] = 0x00;
+
+  EXPECT_THAT(SetFlacFrameNumber(1, flac_frame), Not(IsOk()));
+}
+
+TEST(SetFlacFrameNumber, InvalidForVariableBlockSize) {
+  auto flac_frame = kFrameNumberZero;
+  flac_frame[1] = 0xf9;
+
+  EXPECT_THAT(SetFlacFrameNumber(1, flac_frame), Not(IsOk()));
+}
+
+TEST(SetFlacFrameNumber, InvalidForTruncatedFrame) {
+  std::vector<uint8_t> flac_frame(kFrameNumberZero.begin(),
+                                  kFrameNumberZero.begin() + 8);
+
+  EXPECT_THAT(SetFlacFrameNumber(1, flac_frame), Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace iamf_tools
@@ -11,17 +11,28 @@
  */
 #include "iamf/cli/codec/opus_encoder.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <list>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
 #include "absl/status/status_matchers.h"
+#include "absl/status/statusor.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "iamf/cli/audio_frame_with_data.h"
+#include "iamf/cli/codec/encoder_base.h"
 #include "iamf/cli/codec/tests/encoder_test_base.h"
 #include "iamf/cli/tests/cli_test_utils.h"
+#include "iamf/common/utils/macros.h"
+#include "iamf/common/utils/thread_pool.h"
+#include "iamf/obu/audio_frame.h"
 #include "iamf/obu/codec_config.h"
 #include "iamf/obu/decoder_config/opus_decoder_config.h"
 #include "iamf/obu/obu_header.h"
@@ -40,6 +51,8 @@ constexpr bool kDontValidateCodecDelay = false;
 constexpr uint16_t kIncorrectPreSkip = 999;
 constexpr DecodedUleb128 kCodecConfigId = 57;
 constexpr int kOneChannel = 1;
+constexpr uint32_t kNumSamplesPerFrame = 960;
+constexpr uint32_t kSampleRate = 48000;
 
 TEST(Initialize, SucceedsWithDefaultSettings) {
   absl::flat_hash_map<DecodedUleb128, CodecConfigObu> codec_config_obus;
@@ -121,6 +134,76 @@ INSTANTIATE_TEST_SUITE_P(
         {std::numeric_limits<int32_t>::min(), 1, false},
     }));
 
+// Encodes a ramp scaled by `scale` with a new encoder. Returns the encoded
+// payloads in order.
+absl::StatusOr<std::vector<std::vector<uint8_t>>> EncodeRampWithNewEncoder(
+    const CodecConfigObu& codec_config, int num_frames, int32_t scale) {
+  OpusEncoder opus_encoder(OpusEncoder::Settings(), codec_config,
+                           kOneChannel);
+  EncoderBase& encoder = opus_encoder;
+  RETURN_IF_NOT_OK(encoder.Initialize(kValidateCodecDelay));
+
+  for (int i = 0; i < num_frames; i++) {
+    std::vector<std::vector<int32_t>> samples(
+        kOneChannel, std::vector<int32_t>(kNumSamplesPerFrame));
+    for (uint32_t t = 0; t < kNumSamplesPerFrame; t++) {
+      samples[0][t] =
+          (static_cast<int32_t>((i * kNumSamplesPerFrame + t) % 256) - 128) *
+          scale * (1 << 20);
+    }
+    const InternalTimestamp start_timestamp = i * kNumSamplesPerFrame;
+    RETURN_IF_NOT_OK(encoder.EncodeAudioFrame(
+        samples, absl::WrapUnique(new AudioFrameWithData{
+                     .obu = AudioFrameObu(ObuHeader(), 0, {}),
+                     .start_timestamp = start_timestamp,
+                     .end_timestamp = start_timestamp + kNumSamplesPerFrame,
+                 })));
+  }
+  RETURN_IF_NOT_OK(encoder.Finalize());
+
+  std::list<AudioFrameWithData> audio_frames;
+  while (encoder.FramesAvailable()) {
+    RETURN_IF_NOT_OK(encoder.Pop(audio_frames));
+  }
+  std::vector<std::vector<uint8_t>> payloads;
+  for (const auto& audio_frame : audio_frames) {
+    payloads.push_back(audio_frame.obu.audio_frame_);
+  }
+  return payloads;
+}
+
+TEST(EncodeAudioFrame, ConcurrentEncodersMatchSerialEncoders) {
+  absl::flat_hash_map<DecodedUleb128, CodecConfigObu> codec_config_obus;
+  AddOpusCodecConfig(kCodecConfigId, kNumSamplesPerFrame, kSampleRate,
+                     codec_config_obus);
+  const auto& codec_config = codec_config_obus.at(kCodecConfigId);
+  constexpr int kNumEncoders = 4;
+  constexpr int kNumFrames = 20;
+  std::vector<std::vector<std::vector<uint8_t>>> serial_payloads;
+  for (int i = 0; i < kNumEncoders; i++) {
+    auto payloads = EncodeRampWithNewEncoder(codec_config, kNumFrames, i + 1);
+    ASSERT_THAT(payloads, IsOk());
+    ASSERT_EQ(payloads->size(), kNumFrames);
+    serial_payloads.push_back(*std::move(payloads));
+  }
+
+  // Encode the same signals again, with each encoder on its own thread.
+  ThreadPool pool(kNumEncoders);
+  std::vector<std::vector<std::vector<uint8_t>>> concurrent_payloads(
+      kNumEncoders);
+  const auto encode_ramp = [&](size_t i) -> absl::Status {
+    auto payloads = EncodeRampWithNewEncoder(codec_config, kNumFrames, i + 1);
+    if (!payloads.ok()) {
+      return payloads.status();
+    }
+    concurrent_payloads[i] = *std::move(payloads);
+    return absl::OkStatus();
+  };
+  EXPECT_THAT(pool.ParallelFor(kNumEncoders, encode_ramp), IsOk());
+
+  EXPECT_EQ(concurrent_payloads, serial_payloads);
+}
+
 class OpusEncoderTest : public EncoderTestBase, public testing::Test {
  public:
   OpusEncoderTest() { num_samples_per_frame_ = 120; }
@@ -12,10 +12,12 @@
 #include "iamf/cli/demixing_module.h"
 
 #include <algorithm>
+#include <array>
 #include <climits>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <list>
 #include <utility>
 #include <variant>
@@ -35,6 +37,7 @@
 #include "iamf/cli/channel_label.h"
 #include "iamf/cli/cli_util.h"
 #include "iamf/common/utils/macros.h"
+#include "iamf/common/utils/mixing_utils.h"
 #include "iamf/common/utils/numeric_utils.h"
 #include "iamf/common/utils/validation_utils.h"
 #include "iamf/obu/audio_element.h"
@@ -122,8 +125,8 @@ absl::Status S5ToS7Demixer(const DownMixingParams& down_mixing_params,
   auto& rrs7_samples = label_to_samples[kDemixedRrs7];
 
   // Directly copy L5/R5 to L7/R7, because they are the same.
-  l7_samples = {l5_samples.begin(), l5_samples.end()};
-  r7_samples = {r5_samples.begin(), r5_samples.end()};
+  l7_samples.assign(l5_samples.begin(), l5_samples.end());
+  r7_samples.assign(r5_samples.begin(), r5_samples.end());
 
   // Handle Lrs7 and Rrs7.
   const size_t num_ticks = l5_samples.size();
@@ -433,6 +436,145 @@ absl::Status Tf2ToT2Demixer(const DownMixingParams& down_mixing_params,
   return absl::OkStatus();
 }
 
+// Bounds on the shapes of the linear demixers, which allow the gains and the
+// channels of a frame to be held on the stack.
+constexpr size_t kMaxLinearDemixerInputs = 6;
+constexpr size_t kMaxLinearDemixerOutputs = 4;
+constexpr size_t kMaxLinearDemixers = 6;
+
+// Number of ticks processed by every demixer before moving on to the next
+// tile, so the channels written by one demixer are still in cache when the
+// next demixer reads them.
+constexpr size_t kDemixingTicksPerTile = 256;
+
+// Bound on the number of demixed channels which recon gain is applied to.
+constexpr size_t kMaxReconGainChannels = 16;
+
+// Linear recon gain to apply to a demixed channel. The gain ramps linearly
+// from `start_gain` to `end_gain` over the frame.
+struct ReconGainToApply {
+  ChannelLabel::Label label;
+  double start_gain;
+  double end_gain;
+};
+
+// Inputs: Mono, L2. Outputs: R2.
+void FillS1ToS2Gains(const DownMixingParams& /*down_mixing_params*/,
+                     absl::Span<double> gains) {
+  // R2 = 2 * Mono - L2.
+  const double matrix[] = {
+      2.0,   // Mono
+      -1.0,  // L2
+  };
+  std::copy(std::begin(matrix), std::end(matrix), gains.begin());
+}
+
+// Inputs: L2, R2, C. Outputs: L3, R3.
+void FillS2ToS3Gains(const DownMixingParams& /*down_mixing_params*/,
+                     absl::Span<double> gains) {
+  // L3 = L2 - 0.707 * C.
+  // R3 = R2 - 0.707 * C.
+  const double matrix[] = {
+      1.0,    0.0,     // L2
+      0.0,    1.0,     // R2
+      -0.707, -0.707,  // C
+  };
+  std::copy(std::begin(matrix), std::end(matrix), gains.begin());
+}
+
+// Inputs: L3, L5, R3, R5. Outputs: Ls5, Rs5.
+void FillS3ToS5Gains(const DownMixingParams& down_mixing_params,
+                     absl::Span<double> gains) {
+  // Ls5 = (1 / delta) * (L3 - L5).
+  // Rs5 = (1 / delta) * (R3 - R5).
+  const double inverse_delta = 1.0 / down_mixing_params.delta;
+  const double matrix[] = {
+      inverse_delta,  0.0,            // L3
+      -inverse_delta, 0.0,            // L5
+      0.0,            inverse_delta,  // R3
+      0.0,            -inverse_delta,  // R5
+  };
+  std::copy(std::begin(matrix), std::end(matrix), gains.begin());
+}
+
+// Inputs: L5, Ls5, Lss7, R5, Rs5, Rss7. Outputs: L7, R7, Lrs7, Rrs7.
+void FillS5ToS7Gains(const DownMixingParams& down_mixing_params,
+                     absl::Span<double> gains) {
+  // L7 = L5.
+  // R7 = R5.
+  // Lrs7 = (1 / beta) * (Ls5 - alpha * Lss7).
+  // Rrs7 = (1 / beta) * (Rs5 - alpha * Rss7).
+  const double inverse_beta = 1.0 / down_mixing_params.beta;
+  const double alpha_over_beta = down_mixing_params.alpha * inverse_beta;
+  const double matrix[] = {
+      1.0, 0.0, 0.0,              0.0,               // L5
+      0.0, 0.0, inverse_beta,     0.0,               // Ls5
+      0.0, 0.0, -alpha_over_beta, 0.0,               // Lss7
+      0.0, 1.0, 0.0,              0.0,               // R5
+      0.0, 0.0, 0.0,              inverse_beta,      // Rs5
+      0.0, 0.0, 0.0,              -alpha_over_beta,  // Rss7
+  };
+  std::copy(std::begin(matrix), std::end(matrix), gains.begin());
+}
+
+// Inputs: Ltf2, Ltf4, Rtf2, Rtf4. Outputs: Ltb4, Rtb4.
+void FillT2ToT4Gains(const DownMixingParams& down_mixing_params,
+                     absl::Span<double> gains) {
+  // Ltb4 = (1 / gamma) * (Ltf2 - Ltf4).
+  // Rtb4 = (1 / gamma) * (Rtf2 - Rtf4).
+  const double inverse_gamma = 1.0 / down_mixing_params.gamma;
+  const double matrix[] = {
+      inverse_gamma,  0.0,            // Ltf2
+      -inverse_gamma, 0.0,            // Ltf4
+      0.0,            inverse_gamma,  // Rtf2
+      0.0,            -inverse_gamma,  // Rtf4
+  };
+  std::copy(std::begin(matrix), std::end(matrix), gains.begin());
+}
+
+// Inputs: Ltf3, L3, L5, Rtf3, R3, R5. Outputs: Ltf2, Rtf2.
+void FillTf2ToT2Gains(const DownMixingParams& down_mixing_params,
+                      absl::Span<double> gains) {
+  // Ltf2 = Ltf3 - w * (L3 - L5).
+  // Rtf2 = Rtf3 - w * (R3 - R5).
+  const double w = down_mixing_params.w;
+  const double matrix[] = {
+      1.0, 0.0,  // Ltf3
+      -w,  0.0,  // L3
+      w,   0.0,  // L5
+      0.0, 1.0,  // Rtf3
+      0.0, -w,   // R3
+      0.0, w,    // R5
+  };
+  std::copy(std::begin(matrix), std::end(matrix), gains.begin());
+}
+
+absl::StatusOr<LinearDemixer> GetLinearDemixer(Demixer demixer) {
+  if (demixer == S1ToS2Demixer) {
+    return LinearDemixer{{kMono, kL2}, {kDemixedR2}, FillS1ToS2Gains};
+  } else if (demixer == S2ToS3Demixer) {
+    return LinearDemixer{
+        {kL2, kR2, kCentre}, {kDemixedL3, kDemixedR3}, FillS2ToS3Gains};
+  } else if (demixer == S3ToS5Demixer) {
+    return LinearDemixer{
+        {kL3, kL5, kR3, kR5}, {kDemixedLs5, kDemixedRs5}, FillS3ToS5Gains};
+  } else if (demixer == S5ToS7Demixer) {
+    return LinearDemixer{
+        {kL5, kLs5, kLss7, kR5, kRs5, kRss7},
+        {kDemixedL7, kDemixedR7, kDemixedLrs7, kDemixedRrs7},
+        FillS5ToS7Gains};
+  } else if (demixer == T2ToT4Demixer) {
+    return LinearDemixer{{kLtf2, kLtf4, kRtf2, kRtf4},
+                         {kDemixedLtb4, kDemixedRtb4},
+                         FillT2ToT4Gains};
+  } else if (demixer == Tf2ToT2Demixer) {
+    return LinearDemixer{{kLtf3, kL3, kL5, kRtf3, kR3, kR5},
+                         {kDemixedLtf2, kDemixedRtf2},
+                         FillTf2ToT2Gains};
+  }
+  return absl::InvalidArgumentError("Demixer has no linear equivalent.");
+}
+
 // Helper to fill in the fields of `DemixingMetadataForAudioElementId`.
 absl::Status FillRequiredDemixingMetadata(
     const absl::flat_hash_set<ChannelLabel::Label>& labels_to_demix,
@@ -566,6 +708,20 @@ absl::Status FillRequiredDemixingMetadata(
   }
   demixers.splice(demixers.end(), height_demixers);
 
+  if (demixers.size() > kMaxLinearDemixers) {
+    return absl::InternalError(
+        absl::StrCat("Too many demixers: ", demixers.size()));
+  }
+  auto& linear_demixers = demixing_metadata.linear_demixers;
+  linear_demixers.reserve(demixers.size());
+  for (const auto& demixer : demixers) {
+    auto linear_demixer = GetLinearDemixer(demixer);
+    if (!linear_demixer.ok()) {
+      return linear_demixer.status();
+    }
+    linear_demixers.push_back(*std::move(linear_demixer));
+  }
+
   return absl::OkStatus();
 }
 
@@ -675,15 +831,222 @@ absl::Status StoreSamplesForAudioElementId(
   return absl::OkStatus();
 }
 
-absl::Status ApplyDemixers(const std::list<Demixer>& demixers,
-                           LabeledFrame& labeled_frame) {
-  for (const auto& demixer : demixers) {
-    RETURN_IF_NOT_OK(
-        demixer(labeled_frame.demixing_params, labeled_frame.label_to_samples));
+// Applies the recon gain to one tile of a demixed channel of `num_ticks`. The
+// gain is evaluated in double precision at each tick, without buffering it.
+void ApplyReconGainToTile(const ReconGainToApply& recon_gain,
+                          size_t num_ticks, size_t tile_start,
+                          absl::Span<InternalSampleType> tile) {
+  if (recon_gain.start_gain == recon_gain.end_gain) {
+    const double gain = recon_gain.end_gain;
+    for (auto& sample : tile) {
+      sample *= gain;
+    }
+    return;
+  }
+  // Ramp such that the final tick of the frame reaches the `end_gain`. Each
+  // gain is computed from the start of the frame, so it does not depend on
+  // the tiling and the loop has no carried dependency.
+  const double step =
+      (recon_gain.end_gain - recon_gain.start_gain) / num_ticks;
+  for (size_t t = 0; t < tile.size(); ++t) {
+    tile[t] *= recon_gain.start_gain +
+               step * static_cast<double>(tile_start + t + 1);
+  }
+}
+
+// Finds the recon gains to apply to the demixed channels of this frame, and
+// updates the last recon gains for the next frame. Demixed channels which
+// stay at unity gain are omitted.
+absl::Status GetReconGainsToApply(
+    const std::vector<LinearDemixer>& linear_demixers,
+    LabeledFrame& labeled_frame,
+    std::array<ReconGainToApply, kMaxReconGainChannels>& recon_gains,
+    size_t& num_recon_gains) {
+  num_recon_gains = 0;
+  std::array<float, ChannelLabel::kNumLabels> end_gains;
+  end_gains.fill(1.0f);
+  const auto& recon_gain_elements =
+      labeled_frame.recon_gain_info_parameter_data.recon_gain_elements;
+  const auto& loudspeaker_layout_per_layer =
+      labeled_frame.loudspeaker_layout_per_layer;
+  for (int layer = 0; layer < recon_gain_elements.size(); ++layer) {
+    const auto& recon_gain_element = recon_gain_elements[layer];
+    if (!recon_gain_element.has_value()) {
+      continue;
+    }
+    if (layer >= loudspeaker_layout_per_layer.size()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Recon gain present for layer ", layer, " of only ",
+                       loudspeaker_layout_per_layer.size(), " layers."));
+    }
+    for (int bit = 0; bit < recon_gain_element->recon_gain.size(); ++bit) {
+      const auto flag =
+          static_cast<ReconGainElement::ReconGainFlagBitmask>(1 << bit);
+      if ((recon_gain_element->recon_gain_flag & flag) == 0) {
+        continue;
+      }
+      const auto label = ChannelLabel::GetDemixedChannelLabelForReconGain(
+          loudspeaker_layout_per_layer[layer], flag);
+      if (!label.ok()) {
+        // The flag does not correspond to a demixed channel of this layer;
+        // there is nothing to apply it to.
+        continue;
+      }
+      end_gains[*label] =
+          static_cast<float>(recon_gain_element->recon_gain[bit]) / 255.0f;
+    }
+  }
+
+  auto& label_to_last_recon_gain = labeled_frame.label_to_last_recon_gain;
+  for (const auto& linear_demixer : linear_demixers) {
+    for (const auto label : linear_demixer.output_labels) {
+      const auto last_gain_iter = label_to_last_recon_gain.find(label);
+      const float start_gain = last_gain_iter == label_to_last_recon_gain.end()
+                                   ? 1.0f
+                                   : last_gain_iter->second;
+      const float end_gain = end_gains[label];
+      if (end_gain == 1.0f) {
+        if (last_gain_iter != label_to_last_recon_gain.end()) {
+          label_to_last_recon_gain.erase(last_gain_iter);
+        }
+      } else {
+        label_to_last_recon_gain[label] = end_gain;
+      }
+      if (start_gain == 1.0f && end_gain == 1.0f) {
+        continue;
+      }
+      if (num_recon_gains == kMaxReconGainChannels) {
+        return absl::InternalError("Too many channels with recon gain.");
+      }
+      recon_gains[num_recon_gains++] = {label, start_gain, end_gain};
+    }
   }
   return absl::OkStatus();
 }
 
+absl::Status ApplyLinearDemixers(
+    const std::vector<LinearDemixer>& linear_demixers,
+    absl::Span<const ReconGainToApply> recon_gains,
+    LabeledFrame& labeled_frame) {
+  if (linear_demixers.empty()) {
+    return absl::OkStatus();
+  }
+  auto& label_to_samples = labeled_frame.label_to_samples;
+  const size_t num_ticks = label_to_samples.begin()->second.size();
+
+  // The gains are fixed for the whole frame. Compute them once, and create all
+  // output channels before looking up any inputs, because later demixers read
+  // the outputs of earlier ones.
+  std::array<std::array<double, kMaxLinearDemixerInputs *
+                                    kMaxLinearDemixerOutputs>,
+             kMaxLinearDemixers>
+      gains;
+  for (int i = 0; i < linear_demixers.size(); ++i) {
+    const auto& linear_demixer = linear_demixers[i];
+    linear_demixer.fill_gains(
+        labeled_frame.demixing_params,
+        absl::MakeSpan(gains[i]).first(linear_demixer.input_labels.size() *
+                                       linear_demixer.output_labels.size()));
+    for (const auto output_label : linear_demixer.output_labels) {
+      label_to_samples[output_label].resize(num_ticks);
+    }
+  }
+
+  std::array<std::array<absl::Span<const InternalSampleType>,
+                        kMaxLinearDemixerInputs>,
+             kMaxLinearDemixers>
+      inputs;
+  std::array<std::array<absl::Span<InternalSampleType>,
+                        kMaxLinearDemixerOutputs>,
+             kMaxLinearDemixers>
+      outputs;
+  for (int i = 0; i < linear_demixers.size(); ++i) {
+    const auto& linear_demixer = linear_demixers[i];
+    for (int j = 0; j < linear_demixer.input_labels.size(); ++j) {
+      RETURN_IF_NOT_OK(DemixingModule::FindSamplesOrDemixedSamples(
+          linear_demixer.input_labels[j], label_to_samples, inputs[i][j]));
+      RETURN_IF_NOT_OK(ValidateEqual(inputs[i][j].size(), num_ticks,
+                                     "Number of ticks in demixer input"));
+    }
+    for (int j = 0; j < linear_demixer.output_labels.size(); ++j) {
+      outputs[i][j] =
+          absl::MakeSpan(label_to_samples.at(linear_demixer.output_labels[j]));
+    }
+  }
+  std::array<absl::Span<InternalSampleType>, kMaxReconGainChannels>
+      recon_gain_outputs;
+  for (int i = 0; i < recon_gains.size(); ++i) {
+    recon_gain_outputs[i] =
+        absl::MakeSpan(label_to_samples.at(recon_gains[i].label));
+  }
+
+  // Run the whole chain of demixers, then the recon gain, on one tile at a
+  // time.
+  std::array<absl::Span<const InternalSampleType>, kMaxLinearDemixerInputs>
+      tile_inputs;
+  std::array<absl::Span<InternalSampleType>, kMaxLinearDemixerOutputs>
+      tile_outputs;
+  for (size_t tile_start = 0; tile_start < num_ticks;
+       tile_start += kDemixingTicksPerTile) {
+    const size_t tile_size =
+        std::min(kDemixingTicksPerTile, num_ticks - tile_start);
+    for (int i = 0; i < linear_demixers.size(); ++i) {
+      const size_t num_inputs = linear_demixers[i].input_labels.size();
+      const size_t num_outputs = linear_demixers[i].output_labels.size();
+      for (int j = 0; j < num_inputs; ++j) {
+        tile_inputs[j] = inputs[i][j].subspan(tile_start, tile_size);
+      }
+      for (int j = 0; j < num_outputs; ++j) {
+        tile_outputs[j] = outputs[i][j].subspan(tile_start, tile_size);
+      }
+      RETURN_IF_NOT_OK(MixSamplesWithGainMatrix(
+          absl::MakeConstSpan(tile_inputs).first(num_inputs),
+          absl::MakeConstSpan(gains[i]).first(num_inputs * num_outputs),
+          absl::MakeConstSpan(tile_outputs).first(num_outputs)));
+    }
+    // Apply the recon gain while the tile of the demixed channels is still in
+    // cache. The demixers above read the channels before the gain is applied.
+    for (int i = 0; i < recon_gains.size(); ++i) {
+      ApplyReconGainToTile(
+          recon_gains[i], num_ticks, tile_start,
+          recon_gain_outputs[i].subspan(tile_start, tile_size));
+    }
+  }
+  return absl::OkStatus();
+}
+
+// Stores and demixes the samples of one audio element into its entry of the
+// output map, optionally applying the recon gain. The entry is reused when
+// present, so the channels keep their buffers from the previous call. The
+// entry is removed when there are no samples for the audio element.
+absl::Status StoreAndDemixSamplesForAudioElementId(
+    bool use_decoded_samples, bool apply_recon_gain,
+    const std::list<AudioFrameWithData>& audio_frames_or_decoded_audio_frames,
+    DecodedUleb128 audio_element_id,
+    const DemixingMetadataForAudioElementId& demixing_metadata,
+    IdLabeledFrameMap& id_to_labeled_frame) {
+  auto& labeled_frame = id_to_labeled_frame[audio_element_id];
+  labeled_frame.label_to_samples.clear();
+  RETURN_IF_NOT_OK(StoreSamplesForAudioElementId(
+      use_decoded_samples, audio_frames_or_decoded_audio_frames,
+      demixing_metadata.substream_id_to_labels, labeled_frame));
+  if (labeled_frame.label_to_samples.empty()) {
+    id_to_labeled_frame.erase(audio_element_id);
+    return absl::OkStatus();
+  }
+
+  std::array<ReconGainToApply, kMaxReconGainChannels> recon_gains;
+  size_t num_recon_gains = 0;
+  if (apply_recon_gain) {
+    RETURN_IF_NOT_OK(GetReconGainsToApply(demixing_metadata.linear_demixers,
+                                          labeled_frame, recon_gains,
+                                          num_recon_gains));
+  }
+  return ApplyLinearDemixers(
+      demixing_metadata.linear_demixers,
+      absl::MakeConstSpan(recon_gains).first(num_recon_gains), labeled_frame);
+}
+
 absl::Status GetDemixerMetadata(
     const DecodedUleb128 audio_element_id,
     const absl::flat_hash_map<DecodedUleb128,
@@ -896,53 +1259,59 @@ absl::Status DemixingModule::DownMixSamplesToSubstreams(
 // TODO(b/288240600): Down-mix audio samples in a standalone function too.
 absl::StatusOr<IdLabeledFrameMap> DemixingModule::DemixOriginalAudioSamples(
     const std::list<AudioFrameWithData>& audio_frames) const {
+  IdLabeledFrameMap id_to_labeled_frame;
+  RETURN_IF_NOT_OK(
+      DemixOriginalAudioSamples(audio_frames, id_to_labeled_frame));
+  return id_to_labeled_frame;
+}
+
+absl::Status DemixingModule::DemixOriginalAudioSamples(
+    const std::list<AudioFrameWithData>& audio_frames,
+    IdLabeledFrameMap& id_to_labeled_frame) const {
   if (demixing_mode_ == DemixingMode::kReconstruction) {
     return absl::FailedPreconditionError(
         "Demixing original audio samples is not available in reconstruction "
         "mode.");
   }
-  IdLabeledFrameMap id_to_labeled_frame;
   for (const auto& [audio_element_id, demixing_metadata] :
        audio_element_id_to_demixing_metadata_) {
     // Process the original audio frames.
-    LabeledFrame labeled_frame;
-    RETURN_IF_NOT_OK(StoreSamplesForAudioElementId(
-        /*use_decoded_samples=*/false, audio_frames,
-        demixing_metadata.substream_id_to_labels, labeled_frame));
-    if (!labeled_frame.label_to_samples.empty()) {
-      RETURN_IF_NOT_OK(
-          ApplyDemixers(demixing_metadata.demixers, labeled_frame));
-      id_to_labeled_frame[audio_element_id] = std::move(labeled_frame);
-    }
+    RETURN_IF_NOT_OK(StoreAndDemixSamplesForAudioElementId(
+        /*use_decoded_samples=*/false, /*apply_recon_gain=*/false,
+        audio_frames, audio_element_id,
+        demixing_metadata, id_to_labeled_frame));
 
     LogForAudioElementId("Original", audio_element_id, id_to_labeled_frame);
   }
 
-  return id_to_labeled_frame;
+  return absl::OkStatus();
 }
 
 absl::StatusOr<IdLabeledFrameMap> DemixingModule::DemixDecodedAudioSamples(
     const std::list<AudioFrameWithData>& decoded_audio_frames) const {
   IdLabeledFrameMap id_to_labeled_decoded_frame;
+  RETURN_IF_NOT_OK(DemixDecodedAudioSamples(decoded_audio_frames,
+                                            id_to_labeled_decoded_frame));
+  return id_to_labeled_decoded_frame;
+}
+
+absl::Status DemixingModule::DemixDecodedAudioSamples(
+    const std::list<AudioFrameWithData>& decoded_audio_frames,
+    IdLabeledFrameMap& id_to_labeled_decoded_frame) const {
   for (const auto& [audio_element_id, demixing_metadata] :
        audio_element_id_to_demixing_metadata_) {
     // Process the decoded audio frames.
-    LabeledFrame labeled_decoded_frame;
-    RETURN_IF_NOT_OK(StoreSamplesForAudioElementId(
-        /*use_decoded_samples=*/true, decoded_audio_frames,
-        demixing_metadata.substream_id_to_labels, labeled_decoded_frame));
-    if (!labeled_decoded_frame.label_to_samples.empty()) {
-      RETURN_IF_NOT_OK(
-          ApplyDemixers(demixing_metadata.demixers, labeled_decoded_frame));
-      id_to_labeled_decoded_frame[audio_element_id] =
-          std::move(labeled_decoded_frame);
-    }
+    RETURN_IF_NOT_OK(StoreAndDemixSamplesForAudioElementId(
+        /*use_decoded_samples=*/true,
+        /*apply_recon_gain=*/demixing_mode_ == DemixingMode::kReconstruction,
+        decoded_audio_frames, audio_element_id, demixing_metadata,
+        id_to_labeled_decoded_frame));
 
     LogForAudioElementId("Decoded", audio_element_id,
                          id_to_labeled_decoded_frame);
   }
 
-  return id_to_labeled_decoded_frame;
+  return absl::OkStatus();
 }
 
 absl::StatusOr<const std::list<Demixer>*> DemixingModule::GetDownMixers(
@@ -21,13 +21,13 @@
 #include "absl/base/nullability.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
-#include "absl/container/node_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "iamf/cli/audio_element_with_data.h"
 #include "iamf/cli/audio_frame_with_data.h"
 #include "iamf/cli/channel_label.h"
+#include "iamf/cli/label_samples_map.h"
 #include "iamf/cli/substream_frames.h"
 #include "iamf/obu/audio_element.h"
 #include "iamf/obu/demixing_info_parameter_data.h"
@@ -54,11 +54,6 @@ struct SubstreamData {
   uint32_t num_samples_to_trim_at_start;
 };
 
-// Mapping from channel label to a frame of samples.
-typedef absl::node_hash_map<ChannelLabel::Label,
-                            std::vector<InternalSampleType>>
-    LabelSamplesMap;
-
 struct LabeledFrame {
   uint32_t samples_to_trim_at_end;
   uint32_t samples_to_trim_at_start;
@@ -68,6 +63,10 @@ struct LabeledFrame {
   // Vector of length `num_layers`. Only populated for scalable channel audio.
   std::vector<ChannelAudioLayerConfig::LoudspeakerLayout>
       loudspeaker_layout_per_layer;
+  // Linear recon gain applied to the end of the previous frame of each
+  // demixed channel. Channels without an entry ended with unity gain. Used to
+  // smooth the recon gain across frame boundaries when decoding.
+  absl::flat_hash_map<ChannelLabel::Label, float> label_to_last_recon_gain;
 };
 
 // Mapping from audio element ids to `LabeledFrame`s.
@@ -75,6 +74,23 @@ typedef absl::flat_hash_map<DecodedUleb128, LabeledFrame> IdLabeledFrameMap;
 
 typedef absl::Status (*Demixer)(const DownMixingParams&, LabelSamplesMap&);
 
+/*!\brief A demixer expressed as a gain matrix.
+ *
+ * Every demixer computes its output channels as a linear combination of its
+ * input channels. The gains only depend on the `DownMixingParams`, so they are
+ * computed once per frame.
+ */
+struct LinearDemixer {
+  // Labels of the input channels. When a label is absent, its demixed version
+  // is used instead.
+  std::vector<ChannelLabel::Label> input_labels;
+  // Labels of the output channels.
+  std::vector<ChannelLabel::Label> output_labels;
+  // Fills the gain matrix of shape (# input labels, # output labels), stored
+  // in row-major order.
+  void (*fill_gains)(const DownMixingParams&, absl::Span<double> gains);
+};
+
 /*!\brief Manages data and processing to down-mix and demix audio elements.
  *
  * This class relates to the "Element Reconstructor" as used in the IAMF
@@ -96,6 +112,9 @@ class DemixingModule {
  public:
   struct DemixingMetadataForAudioElementId {
     std::list<Demixer> demixers;
+    // The same demixers as above, in the same order, as gain matrices which
+    // are applied in a single cache-blocked pass over the frame.
+    std::vector<LinearDemixer> linear_demixers;
     std::list<Demixer> down_mixers;
     SubstreamIdLabelsMap substream_id_to_labels;
     LabelGainMap label_to_output_gain;
@@ -204,18 +223,52 @@ class DemixingModule {
   absl::StatusOr<IdLabeledFrameMap> DemixOriginalAudioSamples(
       const std::list<AudioFrameWithData>& audio_frames) const;
 
+  /*!\brief Demix original audio samples into an existing output.
+   *
+   * Same as above, but reuses the frames already in the output. Passing the
+   * same output for every temporal unit avoids reallocating the channels.
+   *
+   * \param audio_frames Audio Frames.
+   * \param id_to_labeled_frame Output data structure for samples. Entries for
+   *        audio elements without any samples in `audio_frames` are removed.
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status DemixOriginalAudioSamples(
+      const std::list<AudioFrameWithData>& audio_frames,
+      IdLabeledFrameMap& id_to_labeled_frame) const;
+
   /*!\brief Demix decoded audio samples.
    *
    * This is most useful when the decoded (after lossy codec) samples are
    * known, such as when decoding an IA Sequence, or when analyzing the effect
    * of a lossy codec to determine appropriate recon gain values.
    *
+   * When created for reconstruction, the recon gain of each frame is applied
+   * to the demixed channels. The gain ramps linearly over the frame from the
+   * gain at the end of the previous frame, which is only known when the
+   * output is reused between frames.
+   *
    * \param decoded_audio_frames Decoded Audio Frames.
    * \return Output data structure for samples, or a specific status on failure.
    */
   absl::StatusOr<IdLabeledFrameMap> DemixDecodedAudioSamples(
       const std::list<AudioFrameWithData>& decoded_audio_frames) const;
 
+  /*!\brief Demix decoded audio samples into an existing output.
+   *
+   * Same as above, but reuses the frames already in the output. Passing the
+   * same output for every temporal unit avoids reallocating the channels.
+   *
+   * \param decoded_audio_frames Decoded Audio Frames.
+   * \param id_to_labeled_decoded_frame Output data structure for samples.
+   *        Entries for audio elements without any samples in
+   *        `decoded_audio_frames` are removed.
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status DemixDecodedAudioSamples(
+      const std::list<AudioFrameWithData>& decoded_audio_frames,
+      IdLabeledFrameMap& id_to_labeled_decoded_frame) const;
+
   /*!\brief Gets the down-mixers associated with an Audio Element ID.
    *
    * \param audio_element_id Audio Element ID
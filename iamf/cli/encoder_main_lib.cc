@@ -11,6 +11,7 @@
  */
 #include "iamf/cli/encoder_main_lib.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
@@ -18,15 +19,19 @@
 #include <memory>
 #include <string>
 #include <system_error>
+#include <thread>  // NOLINT(build/c++11)
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
 #include "iamf/cli/audio_element_with_data.h"
+#include "iamf/cli/channel_label.h"
 #include "iamf/cli/demixing_module.h"
 #include "iamf/cli/iamf_components.h"
 #include "iamf/cli/iamf_encoder.h"
@@ -39,8 +44,10 @@
 #include "iamf/cli/proto_conversion/output_audio_format_utils.h"
 #include "iamf/cli/rendering_mix_presentation_finalizer.h"
 #include "iamf/cli/sample_processor_base.h"
+#include "iamf/cli/true_peak_limiter.h"
 #include "iamf/cli/wav_sample_provider.h"
 #include "iamf/cli/wav_writer.h"
+#include "iamf/common/utils/bounded_queue.h"
 #include "iamf/common/utils/macros.h"
 #include "iamf/include/iamf_tools/iamf_tools_encoder_api_types.h"
 #include "iamf/obu/mix_presentation.h"
@@ -129,28 +136,52 @@ absl::Status CreateOutputDirectory(const std::string& output_directory) {
   return absl::OkStatus();
 }
 
-absl::Status LabeledSamplesToAudioElementData(
-    const LabelSamplesMap& labeled_samples,
-    api::IamfAudioElementData& audio_element_data) {
+absl::StatusOr<std::string> SerializeChannelLabel(ChannelLabel::Label label) {
+  auto proto_label = ChannelLabelUtils::LabelToProto(label);
+  if (!proto_label.ok()) {
+    return proto_label.status();
+  }
+  ChannelLabelMessage channel_label_message;
+  channel_label_message.set_channel_label(*proto_label);
+  std::string serialized_channel_label_message;
+  if (!channel_label_message.SerializeToString(
+          &serialized_channel_label_message)) {
+    return absl::InternalError(
+        "Failed to serialize a `ChannelLabelMessage` protocol buffer.");
+  }
+  return serialized_channel_label_message;
+}
+
+absl::Status LabeledSamplesToChannels(
+    const absl::flat_hash_map<DecodedUleb128, LabelSamplesMap>&
+        id_to_labeled_samples,
+    IamfEncoder& iamf_encoder,
+    absl::flat_hash_map<std::pair<DecodedUleb128, ChannelLabel::Label>,
+                        api::IamfChannelHandle>& channel_to_handle,
+    std::vector<absl::Span<const double>>& channels) {
   // Here, we lazily assume the samples are stored as doubles. So we can work on
   // a Span instead of copying the underlying data.
   static_assert(std::is_same_v<InternalSampleType, double>);
-  for (const auto& [channel_label, samples] : labeled_samples) {
-    auto proto_label = ChannelLabelUtils::LabelToProto(channel_label);
-    if (!proto_label.ok()) {
-      return proto_label.status();
-    }
-    ChannelLabelMessage channel_label_message;
-    channel_label_message.set_channel_label(*proto_label);
-    std::string serialized_channel_label_message;
-    if (!channel_label_message.SerializeToString(
-            &serialized_channel_label_message)) {
-      return absl::InternalError(
-          "Failed to serialize a `ChannelLabelMessage` protocol buffer.");
+  std::fill(channels.begin(), channels.end(), absl::Span<const double>());
+  for (const auto& [audio_element_id, labeled_samples] :
+       id_to_labeled_samples) {
+    for (const auto& [channel_label, samples] : labeled_samples) {
+      // Resolve each channel to a handle the first time it is seen.
+      auto [iter, inserted] = channel_to_handle.try_emplace(
+          std::make_pair(audio_element_id, channel_label), 0);
+      if (inserted) {
+        const auto serialized_label = SerializeChannelLabel(channel_label);
+        if (!serialized_label.ok()) {
+          return serialized_label.status();
+        }
+        RETURN_IF_NOT_OK(iamf_encoder.GetChannelHandle(
+            audio_element_id, *serialized_label, iter->second));
+      }
+      if (iter->second >= channels.size()) {
+        channels.resize(iter->second + 1);
+      }
+      channels[iter->second] = absl::Span<const double>(samples);
     }
-
-    audio_element_data[serialized_channel_label_message] =
-        absl::Span<const double>(samples);
   }
   return absl::OkStatus();
 }
@@ -176,6 +207,112 @@ iamf_tools_cli_proto::OutputAudioFormat GetOutputAudioFormat(
   return output_audio_format;
 }
 
+// State to add the samples and parameter block metadata of each temporal unit.
+struct EncoderInput {
+  const absl::flat_hash_map<DecodedUleb128, AudioElementWithData>&
+      audio_elements;
+  WavSampleProvider& wav_sample_provider;
+  TimeParameterBlockMetadataMap& time_parameter_block_metadata;
+
+  // Hold a single temporal unit data. Channels are resolved to handles once,
+  // then every temporal unit fills the same slots; we can reuse them.
+  absl::flat_hash_map<std::pair<DecodedUleb128, ChannelLabel::Label>,
+                      api::IamfChannelHandle>
+      channel_to_handle;
+  std::vector<absl::Span<const double>> channels;
+  api::IamfTemporalUnitChannelData temporal_unit_data;
+
+  int temporal_unit_iteration = 0;  // Just for logging purposes.
+};
+
+// Number of temporal units which may be generated ahead of their output.
+constexpr size_t kMaxNumTemporalUnitsInFlight = 4;
+
+absl::Status EncodeNextTemporalUnit(EncoderInput& input,
+                                    IamfEncoder& iamf_encoder) {
+  ABSL_LOG_EVERY_N_SEC(INFO, 5)
+      << "\n\n============================= Generating Temporal Units Iter #"
+      << input.temporal_unit_iteration++
+      << " =============================\n";
+
+  InternalTimestamp input_timestamp = 0;
+  RETURN_IF_NOT_OK(iamf_encoder.GetInputTimestamp(input_timestamp));
+
+  // Get the audio samples.
+  absl::flat_hash_map<DecodedUleb128, LabelSamplesMap> id_to_labeled_samples;
+  bool no_more_real_samples = false;
+  RETURN_IF_NOT_OK(CollectLabeledSamplesForAudioElements(
+      input.audio_elements, input.wav_sample_provider, id_to_labeled_samples,
+      no_more_real_samples));
+
+  // Adapt the audio samples into the expected format for the encoder.
+  RETURN_IF_NOT_OK(LabeledSamplesToChannels(id_to_labeled_samples,
+                                            iamf_encoder,
+                                            input.channel_to_handle,
+                                            input.channels));
+  input.temporal_unit_data.channels = absl::MakeConstSpan(input.channels);
+  // Fill in this temporal unit's parameter block metadata.
+  for (const auto& metadata :
+       input.time_parameter_block_metadata[input_timestamp]) {
+    std::string serialized_metadata;
+    if (!metadata.SerializeToString(&serialized_metadata)) {
+      return absl::InternalError(
+          "Failed to serialize parameter block metadata.");
+    }
+    input.temporal_unit_data
+        .parameter_block_id_to_metadata[metadata.parameter_id()] =
+        serialized_metadata;
+  }
+
+  RETURN_IF_NOT_OK(iamf_encoder.Encode(input.temporal_unit_data));
+
+  // In this program we always use up all samples from a WAV file, so we
+  // call `IamfEncoder::FinalizeEncode()` only when there is no more
+  // real samples. In other applications, the user may decide to stop adding
+  // audio samples based on other criteria.
+  if (no_more_real_samples) {
+    // TODO(b/430027640): Avoid clearing the parameter block metadata, once
+    //                    there is a better way to determine the parameter
+    //                    block start timestamps.
+    input.temporal_unit_data.parameter_block_id_to_metadata.clear();
+    RETURN_IF_NOT_OK(iamf_encoder.FinalizeEncode());
+  }
+  return absl::OkStatus();
+}
+
+absl::Status GenerateAllTemporalUnits(
+    EncoderInput& input, IamfEncoder& iamf_encoder,
+    BoundedQueue<IamfEncoder::GeneratedTemporalUnit>&
+        generated_temporal_units) {
+  // Safe to check before the first push; nothing has been emitted yet.
+  bool generating_frames = iamf_encoder.GeneratingTemporalUnits();
+  while (generating_frames) {
+    RETURN_IF_NOT_OK(EncodeNextTemporalUnit(input, iamf_encoder));
+    IamfEncoder::GeneratedTemporalUnit generated_temporal_unit;
+    RETURN_IF_NOT_OK(
+        iamf_encoder.GenerateTemporalUnit(generated_temporal_unit));
+    generating_frames = generated_temporal_unit.generating_frames;
+    if (!generated_temporal_units.Push(std::move(generated_temporal_unit))) {
+      return absl::AbortedError("Stopped emitting temporal units early.");
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status EmitAllTemporalUnits(
+    BoundedQueue<IamfEncoder::GeneratedTemporalUnit>& generated_temporal_units,
+    IamfEncoder& iamf_encoder) {
+  while (auto generated_temporal_unit = generated_temporal_units.Pop()) {
+    // In a streaming based application these serialized OBUs would be useful.
+    // Here we throw them away and rely on the `ObuSequencer`s to handle output
+    // (such as to a .iamf file).
+    std::vector<uint8_t> unused_temporal_unit_obus;
+    RETURN_IF_NOT_OK(iamf_encoder.EmitTemporalUnit(
+        *std::move(generated_temporal_unit), unused_temporal_unit_obus));
+  }
+  return absl::OkStatus();
+}
+
 absl::Status GenerateTemporalUnitObus(const UserMetadata& user_metadata,
                                       const std::string& input_wav_directory,
                                       IamfEncoder& iamf_encoder) {
@@ -191,69 +328,40 @@ absl::Status GenerateTemporalUnitObus(const UserMetadata& user_metadata,
   RETURN_IF_NOT_OK(OrganizeParameterBlockMetadata(
       user_metadata.parameter_block_metadata(), time_parameter_block_metadata));
 
-  // TODO(b/329375123): Make two while loops that run on two threads: one for
-  //                    adding samples and parameter block metadata, and one for
-  //                    outputing OBUs.
-  int temporal_unit_iteration = 0;  // Just for logging purposes.
-  // Hold a single temporal unit data. Every temporal unit will fill the same
-  // slots in the inner maps; we can reuse them.
-  api::IamfTemporalUnitData temporal_unit_data;
+  EncoderInput input{
+      .audio_elements = iamf_encoder.GetAudioElements(),
+      .wav_sample_provider = *wav_sample_provider,
+      .time_parameter_block_metadata = time_parameter_block_metadata};
+
+  // One thread reads the WAV files, then down-mixes and encodes the audio
+  // frames and generates the demixing and mix gain parameter blocks. This
+  // thread decodes the frames, generates the recon gain parameter blocks,
+  // measures loudness and writes the OBUs.
+  BoundedQueue<IamfEncoder::GeneratedTemporalUnit> generated_temporal_units(
+      kMaxNumTemporalUnitsInFlight);
+  absl::Status generate_status = absl::OkStatus();
+  std::thread generator([&] {
+    generate_status = GenerateAllTemporalUnits(input, iamf_encoder,
+                                               generated_temporal_units);
+    generated_temporal_units.Close();
+  });
+  const absl::Status emit_status =
+      EmitAllTemporalUnits(generated_temporal_units, iamf_encoder);
+  // Unblock the generator, in case emitting stopped early.
+  generated_temporal_units.Close();
+  generator.join();
+  RETURN_IF_NOT_OK(emit_status);
+  RETURN_IF_NOT_OK(generate_status);
+
+  // All audio frames are out. Any remaining temporal units only hold
+  // extraneous arbitrary OBUs.
   while (iamf_encoder.GeneratingTemporalUnits()) {
-    ABSL_LOG_EVERY_N_SEC(INFO, 5)
-        << "\n\n============================= Generating Temporal Units Iter #"
-        << temporal_unit_iteration++ << " =============================\n";
-
-    InternalTimestamp input_timestamp = 0;
-    RETURN_IF_NOT_OK(iamf_encoder.GetInputTimestamp(input_timestamp));
-
-    // Get the audio samples.
-    absl::flat_hash_map<DecodedUleb128, LabelSamplesMap> id_to_labeled_samples;
-    bool no_more_real_samples = false;
-    RETURN_IF_NOT_OK(CollectLabeledSamplesForAudioElements(
-        iamf_encoder.GetAudioElements(), *wav_sample_provider,
-        id_to_labeled_samples, no_more_real_samples));
-
-    // Adapt the audio samples into the expected format for the encoder.
-    for (const auto& [audio_element_id, labeled_samples] :
-         id_to_labeled_samples) {
-      RETURN_IF_NOT_OK(LabeledSamplesToAudioElementData(
-          labeled_samples,
-          temporal_unit_data.audio_element_id_to_data[audio_element_id]));
-    }
-    // Fill in this temporal unit's parameter block metadata.
-    for (const auto& metadata :
-         time_parameter_block_metadata[input_timestamp]) {
-      std::string serialized_metadata;
-      if (!metadata.SerializeToString(&serialized_metadata)) {
-        return absl::InternalError(
-            "Failed to serialize parameter block metadata.");
-      }
-      temporal_unit_data
-          .parameter_block_id_to_metadata[metadata.parameter_id()] =
-          serialized_metadata;
-    }
-
-    RETURN_IF_NOT_OK(iamf_encoder.Encode(temporal_unit_data));
-
-    // In this program we always use up all samples from a WAV file, so we
-    // call `IamfEncoder::FinalizeEncode()` only when there is no more
-    // real samples. In other applications, the user may decide to stop adding
-    // audio samples based on other criteria.
-    if (no_more_real_samples) {
-      // TODO(b/430027640): Avoid clearing the parameter block metadata, once
-      //                    there is a better way to determine the parameter
-      //                    block start timestamps.
-      temporal_unit_data.parameter_block_id_to_metadata.clear();
-      RETURN_IF_NOT_OK(iamf_encoder.FinalizeEncode());
-    }
-
-    // In a streaming based application these serialized OBUs would be useful.
-    // Here we throw them away and rely on the `ObuSequencer`s to handle output
-    // (such as to a .iamf file).
+    RETURN_IF_NOT_OK(EncodeNextTemporalUnit(input, iamf_encoder));
     std::vector<uint8_t> unused_temporal_unit_obus;
     RETURN_IF_NOT_OK(
         iamf_encoder.OutputTemporalUnit(unused_temporal_unit_obus));
   }
+
   ABSL_LOG(INFO)
       << "\n============================= END of Generating Data OBUs"
       << " =============================\n\n";
@@ -308,6 +416,11 @@ absl::Status TestMain(const UserMetadata& input_user_metadata,
       user_metadata.test_vector_metadata());
   ApplyOutputAudioFormatToSampleProcessorFactory(output_audio_format,
                                                  sample_processor_factory);
+  if (user_metadata.encoder_control_metadata()
+          .limit_true_peak_of_rendered_files()) {
+    ApplyTruePeakLimiterToSampleProcessorFactory(TruePeakLimiter::Settings(),
+                                                 sample_processor_factory);
+  }
 
   // Adapt the "IAMF Components" sequencer to match the `IamfEncoder`. This
   // helps automatically create the output file(s).
@@ -317,9 +430,15 @@ absl::Status TestMain(const UserMetadata& input_user_metadata,
                                    .enable_temporal_delimiters());
   };
 
+  const auto loudness_calculator_factory = CreateLoudnessCalculatorFactory(
+      user_metadata.encoder_control_metadata());
+  if (loudness_calculator_factory == nullptr) {
+    return absl::InvalidArgumentError(
+        "Invalid loudness settings in the encoder control metadata.");
+  }
   auto iamf_encoder =
       IamfEncoder::Create(user_metadata, CreateRendererFactory().get(),
-                          CreateLoudnessCalculatorFactory().get(),
+                          loudness_calculator_factory.get(),
                           sample_processor_factory, obu_sequencer_factory);
   if (!iamf_encoder.ok()) {
     return iamf_encoder.status();
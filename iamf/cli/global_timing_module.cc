@@ -29,6 +29,7 @@
 #include "iamf/common/utils/validation_utils.h"
 #include "iamf/obu/audio_element.h"
 #include "iamf/obu/codec_config.h"
+#include "iamf/obu/param_definitions/mix_gain_param_definition.h"
 #include "iamf/obu/param_definitions/param_definition_variant.h"
 #include "iamf/obu/types.h"
 
@@ -41,9 +42,10 @@ absl::Status InitializeInternal(
         audio_elements,
     const absl::flat_hash_map<DecodedUleb128, ParamDefinitionVariant>&
         param_definition_variants,
-    auto& audio_frame_timing_data, auto& parameter_block_timing_data) {
-  // TODO(b/283281856): Handle cases where `parameter_rate` and `sample_rate`
-  //                    differ.
+    auto& audio_frame_timing_data, auto& parameter_block_timing_data,
+    std::optional<uint32_t>& common_sample_rate,
+    absl::flat_hash_set<DecodedUleb128>& mix_gain_parameter_ids) {
+  bool sample_rates_are_common = true;
   for (const auto& [unused_id, audio_element] : audio_elements) {
     // Initialize all substream IDs to start at 0 even if the substreams do not
     // actually appear in the bitstream.
@@ -54,6 +56,11 @@ absl::Status InitializeInternal(
       RETURN_IF_NOT_OK(
           ValidateNotEqual(sample_rate, uint32_t{0}, "sample rate"));
 
+      if (!common_sample_rate.has_value()) {
+        common_sample_rate = sample_rate;
+      }
+      sample_rates_are_common &= *common_sample_rate == sample_rate;
+
       const auto [unused_iter, inserted] = audio_frame_timing_data.insert(
           {audio_substream_id, {.rate = sample_rate, .timestamp = 0}});
 
@@ -65,6 +72,11 @@ absl::Status InitializeInternal(
     }
   }
 
+  if (!sample_rates_are_common) {
+    // There is no single tick grid to align parameter blocks to.
+    common_sample_rate = std::nullopt;
+  }
+
   // Initialize all parameter IDs to start with a timestamp 0.
   for (const auto& [parameter_id, param_definition_variant] :
        param_definition_variants) {
@@ -83,6 +95,12 @@ absl::Status InitializeInternal(
           absl::StrCat("Parameter ID: ", parameter_id,
                        " already exists in the Global Timing Module"));
     }
+    // Demixing and recon gain parameters are tied to the duration of an Audio
+    // Frame, but mix gain parameters may use any `parameter_rate`.
+    if (std::holds_alternative<MixGainParamDefinition>(
+            param_definition_variant)) {
+      mix_gain_parameter_ids.insert(parameter_id);
+    }
   }
 
   return absl::OkStatus();
@@ -97,17 +115,20 @@ std::unique_ptr<GlobalTimingModule> GlobalTimingModule::Create(
         param_definition_variants) {
   absl::flat_hash_map<DecodedUleb128, TimingData> audio_frame_timing_data;
   absl::flat_hash_map<DecodedUleb128, TimingData> parameter_block_timing_data;
-  const auto status =
-      InitializeInternal(audio_elements, param_definition_variants,
-                         audio_frame_timing_data, parameter_block_timing_data);
+  std::optional<uint32_t> common_sample_rate;
+  absl::flat_hash_set<DecodedUleb128> mix_gain_parameter_ids;
+  const auto status = InitializeInternal(
+      audio_elements, param_definition_variants, audio_frame_timing_data,
+      parameter_block_timing_data, common_sample_rate, mix_gain_parameter_ids);
   if (!status.ok()) {
     ABSL_LOG(ERROR) << status;
     return nullptr;
   }
 
-  return absl::WrapUnique(
-      new GlobalTimingModule(std::move(audio_frame_timing_data),
-                             std::move(parameter_block_timing_data)));
+  return absl::WrapUnique(new GlobalTimingModule(
+      std::move(audio_frame_timing_data),
+      std::move(parameter_block_timing_data), common_sample_rate,
+      std::move(mix_gain_parameter_ids)));
 }
 
 absl::Status GlobalTimingModule::GetNextAudioFrameTimestamps(
@@ -125,10 +146,33 @@ absl::Status GlobalTimingModule::GetNextParameterBlockTimestamps(
   RETURN_IF_NOT_OK(GetTimestampsForId(parameter_id, duration,
                                       parameter_block_timing_data_,
                                       start_timestamp, end_timestamp));
+
+  // Express the timestamps of mix gains on the tick grid of the audio, so they
+  // line up with the Audio Frames. A boundary maps to the first audio tick at
+  // or after it. `input_start_timestamp` is already measured in audio ticks.
+  const uint32_t parameter_rate =
+      parameter_block_timing_data_.at(parameter_id).rate;
+  const bool measured_in_audio_ticks =
+      common_sample_rate_.has_value() &&
+      *common_sample_rate_ != parameter_rate &&
+      mix_gain_parameter_ids_.contains(parameter_id);
+  if (measured_in_audio_ticks) {
+    const auto to_audio_ticks = [&](InternalTimestamp parameter_ticks) {
+      return (parameter_ticks * *common_sample_rate_ + parameter_rate - 1) /
+             parameter_rate;
+    };
+    start_timestamp = to_audio_ticks(start_timestamp);
+    end_timestamp = to_audio_ticks(end_timestamp);
+  }
   return CompareTimestamps(
       input_start_timestamp, start_timestamp,
       absl::StrCat("In GetNextParameterBlockTimestamps() for param ID= ",
-                   parameter_id, ": "));
+                   parameter_id,
+                   measured_in_audio_ticks
+                       ? absl::StrCat(" (in ticks of the sample rate= ",
+                                      *common_sample_rate_, ")")
+                       : "",
+                   ": "));
 }
 
 absl::Status GlobalTimingModule::GetGlobalAudioFrameTimestamp(
@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "iamf/cli/audio_element_with_data.h"
 #include "iamf/obu/param_definitions/param_definition_variant.h"
@@ -56,11 +57,19 @@ class GlobalTimingModule {
                                            InternalTimestamp& end_timestamp);
 
   /*!\brief Gets the start and end timestamps of the next Parameter Block.
+   *
+   * When all Audio Elements share a sample rate, the timestamps of mix gain
+   * Parameter Blocks are measured in ticks of that sample rate, even if the
+   * parameter rate differs. This lets them be compared directly with the
+   * timestamps of Audio Frames.
    *
    * \param parameter_id ID of the Parameter Block.
    * \param input_start_timestamp Start timestamp specified by the user. Will be
-   *        used to check if there are gaps.
-   * \param duration Duration of this Parameter Block measured in ticks.
+   *        used to check if there are gaps. Measured in the same ticks as the
+   *        output timestamps; i.e. ticks of the sample rate for mix gain
+   *        Parameter Blocks whose parameter rate differs.
+   * \param duration Duration of this Parameter Block measured in ticks of the
+   *        parameter rate.
    * \param start_timestamp Output start timestamp.
    * \param end_timestamp Output end timestamp.
    * \return `absl::OkStatus()` on success. A specific status on failure.
@@ -101,13 +110,20 @@ class GlobalTimingModule {
    *        substream ID.
    * \param parameter_block_timing_data Timing data for Parameter Blocks keyed
    *        by parameter ID.
+   * \param common_sample_rate Sample rate shared by all Audio Elements, if
+   *        any.
+   * \param mix_gain_parameter_ids IDs of the mix gain parameters.
    */
   GlobalTimingModule(
       absl::flat_hash_map<DecodedUleb128, TimingData>&& audio_frame_timing_data,
       absl::flat_hash_map<DecodedUleb128, TimingData>&&
-          parameter_block_timing_data)
+          parameter_block_timing_data,
+      std::optional<uint32_t> common_sample_rate,
+      absl::flat_hash_set<DecodedUleb128>&& mix_gain_parameter_ids)
       : audio_frame_timing_data_(std::move(audio_frame_timing_data)),
-        parameter_block_timing_data_(std::move(parameter_block_timing_data)) {}
+        parameter_block_timing_data_(std::move(parameter_block_timing_data)),
+        common_sample_rate_(common_sample_rate),
+        mix_gain_parameter_ids_(std::move(mix_gain_parameter_ids)) {}
 
   absl::Status GetTimestampsForId(
       DecodedUleb128 id, uint32_t duration,
@@ -116,6 +132,10 @@ class GlobalTimingModule {
 
   absl::flat_hash_map<DecodedUleb128, TimingData> audio_frame_timing_data_;
   absl::flat_hash_map<DecodedUleb128, TimingData> parameter_block_timing_data_;
+
+  // Mix gain Parameter Block timestamps are converted to ticks of this rate.
+  const std::optional<uint32_t> common_sample_rate_;
+  const absl::flat_hash_set<DecodedUleb128> mix_gain_parameter_ids_;
 };
 
 }  // namespace iamf_tools
@@ -20,9 +20,11 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "iamf/cli/itu_1770_4/loudness_calculator_factory_itu_1770_4.h"
+#include "iamf/cli/itu_1770_4/loudness_calculator_itu_1770_4.h"
 #include "iamf/cli/loudness_calculator_factory_base.h"
 #include "iamf/cli/obu_sequencer_base.h"
 #include "iamf/cli/obu_sequencer_iamf.h"
+#include "iamf/cli/proto/encoder_control_metadata.pb.h"
 #include "iamf/cli/proto/test_vector_metadata.pb.h"
 #include "iamf/cli/proto/user_metadata.pb.h"
 #include "iamf/cli/proto_conversion/proto_utils.h"
@@ -36,7 +38,7 @@ constexpr absl::string_view kOmitIamfFile = "";
 }
 
 std::unique_ptr<RendererFactoryBase> CreateRendererFactory() {
-  return std::make_unique<RendererFactory>();
+  return std::make_unique<RendererFactory>(/*render_asynchronously=*/true);
 }
 
 std::unique_ptr<LoudnessCalculatorFactoryBase>
@@ -44,6 +46,23 @@ CreateLoudnessCalculatorFactory() {
   return std::make_unique<LoudnessCalculatorFactoryItu1770_4>();
 }
 
+std::unique_ptr<LoudnessCalculatorFactoryBase> CreateLoudnessCalculatorFactory(
+    const iamf_tools_cli_proto::EncoderControlMetadata&
+        encoder_control_metadata) {
+  using enum LoudnessCalculatorItu1770_4::GatingMode;
+  switch (encoder_control_metadata.loudness_gating_mode()) {
+    using enum iamf_tools_cli_proto::LoudnessGatingMode;
+    case LOUDNESS_GATING_MODE_EXACT:
+      return std::make_unique<LoudnessCalculatorFactoryItu1770_4>(kExact);
+    case LOUDNESS_GATING_MODE_HISTOGRAM:
+      return std::make_unique<LoudnessCalculatorFactoryItu1770_4>(kHistogram);
+    default:
+      ABSL_LOG(ERROR) << "Invalid loudness gating mode: "
+                      << encoder_control_metadata.loudness_gating_mode();
+      return nullptr;
+  }
+}
+
 std::vector<std::unique_ptr<ObuSequencerBase>> CreateObuSequencers(
     const iamf_tools_cli_proto::UserMetadata& user_metadata,
     const std::string& output_iamf_directory,
@@ -19,6 +19,7 @@
 
 #include "iamf/cli/loudness_calculator_factory_base.h"
 #include "iamf/cli/obu_sequencer_base.h"
+#include "iamf/cli/proto/encoder_control_metadata.pb.h"
 #include "iamf/cli/proto/mix_presentation.pb.h"
 #include "iamf/cli/proto/user_metadata.pb.h"
 #include "iamf/cli/renderer_factory.h"
@@ -44,6 +45,17 @@ std::unique_ptr<RendererFactoryBase> CreateRendererFactory();
 std::unique_ptr<LoudnessCalculatorFactoryBase>
 CreateLoudnessCalculatorFactory();
 
+/*!\brief Creates an instance of `LoudnessCalculatorFactoryBase` for encoding.
+ *
+ * \param encoder_control_metadata Controls of the encoder, which select how
+ *        the calculators gate the integrated loudness.
+ * \return Unique pointer to the created loudness calculator factory or
+ *         `nullptr` if the controls are invalid.
+ */
+std::unique_ptr<LoudnessCalculatorFactoryBase> CreateLoudnessCalculatorFactory(
+    const iamf_tools_cli_proto::EncoderControlMetadata&
+        encoder_control_metadata);
+
 /*!\brief Creates instances of `ObuSequencerBase`.
  *
  * This is useful for binding different kinds of sequencers in an IAMF Encoder.
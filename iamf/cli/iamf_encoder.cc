@@ -12,16 +12,20 @@
 #include "iamf/cli/iamf_encoder.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <list>
 #include <memory>
 #include <optional>
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "absl/base/nullability.h"
 #include "absl/container/btree_map.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_map.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/memory/memory.h"
@@ -30,9 +34,11 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
+#include "iamf/api/conversion/parameter_block_conversion.h"
 #include "iamf/cli/audio_element_with_data.h"
 #include "iamf/cli/audio_frame_decoder.h"
 #include "iamf/cli/audio_frame_with_data.h"
+#include "iamf/cli/channel_label.h"
 #include "iamf/cli/cli_util.h"
 #include "iamf/cli/demixing_module.h"
 #include "iamf/cli/global_timing_module.h"
@@ -142,8 +148,18 @@ void PrintAudioFrames(const std::list<AudioFrameWithData>& audio_frames) {
   }
 }
 
+absl::StatusOr<ChannelLabel::Label> ParseChannelLabel(
+    const std::string& serialized_channel_label) {
+  ChannelLabelMessage channel_label_message;
+  if (!channel_label_message.ParseFromString(serialized_channel_label)) {
+    return absl::InvalidArgumentError(
+        "Failed to deserialize `ChannelLabelMessage` protocol buffer.");
+  }
+  return ChannelLabelUtils::ProtoToLabel(channel_label_message.channel_label());
+}
+
 void ClearSamples(
-    absl::flat_hash_map<DecodedUleb128, LabelSamplesMap>& samples) {
+    absl::node_hash_map<DecodedUleb128, LabelSamplesMap>& samples) {
   // Clear cached samples for this iteration of data OBU generation.
   for (auto& [unused_audio_element_id, labeled_samples] : samples) {
     for (auto& [unused_label, samples] : labeled_samples) {
@@ -171,11 +187,9 @@ absl::Status PushTemporalUnitToObuSequencers(
   }
   RETURN_IF_NOT_OK(
       streaming_obu_sequencer.PushTemporalUnit(*temporal_unit_view));
-  // Fill the output with the final view.
-  const auto previous_temporal_unit_obus =
-      streaming_obu_sequencer.GetPreviousSerializedTemporalUnit();
-  temporal_unit_obus = {previous_temporal_unit_obus.begin(),
-                        previous_temporal_unit_obus.end()};
+  // Fill the output with the final view. Swap buffers instead of copying.
+  streaming_obu_sequencer.TakePreviousSerializedTemporalUnit(
+      temporal_unit_obus);
   return absl::OkStatus();
 }
 
@@ -340,11 +354,17 @@ absl::StatusOr<std::unique_ptr<IamfEncoder>> IamfEncoder::Create(
         "Failed to initialize the global timing module");
   }
 
-  // Initialize the parameter block generator.
+  // Initialize the parameter block generators. Recon gain parameter blocks are
+  // generated by a separate one, when emitting temporal units.
   ParameterBlockGenerator parameter_block_generator(
       user_metadata.test_vector_metadata().override_computed_recon_gains(),
       *param_definition_variants);
   RETURN_IF_NOT_OK(parameter_block_generator.Initialize(*audio_elements));
+  ParameterBlockGenerator recon_gain_parameter_block_generator(
+      user_metadata.test_vector_metadata().override_computed_recon_gains(),
+      *param_definition_variants);
+  RETURN_IF_NOT_OK(
+      recon_gain_parameter_block_generator.Initialize(*audio_elements));
 
   // Put generated parameter blocks in a manager that supports easier queries.
   auto parameters_manager = ParametersManager::Create(*audio_elements);
@@ -373,7 +393,8 @@ absl::StatusOr<std::unique_ptr<IamfEncoder>> IamfEncoder::Create(
   auto audio_frame_generator = AudioFrameGenerator::Create(
       user_metadata.audio_frame_metadata(),
       user_metadata.codec_config_metadata(), *audio_elements, *demixing_module,
-      **parameters_manager, *global_timing_module);
+      **parameters_manager, *global_timing_module,
+      user_metadata.encoder_control_metadata().num_frames_per_encoding_chunk());
   if (!audio_frame_generator.ok()) {
     return audio_frame_generator.status();
   }
@@ -393,7 +414,9 @@ absl::StatusOr<std::unique_ptr<IamfEncoder>> IamfEncoder::Create(
   }
   ObuSequencerStreamingIamf streaming_obu_sequencer(
       user_metadata.temporal_delimiter_metadata().enable_temporal_delimiters(),
-      *leb_generator);
+      *leb_generator,
+      user_metadata.encoder_control_metadata()
+          .redundant_descriptor_obu_interval());
 
   // Create auxiliary `ObuSequencer`s, and feed the initial descriptor OBUs to
   // them.
@@ -418,7 +441,9 @@ absl::StatusOr<std::unique_ptr<IamfEncoder>> IamfEncoder::Create(
       std::move(mix_presentation_obus), std::move(descriptor_arbitrary_obus),
       std::move(timestamp_to_arbitrary_obus),
       std::move(param_definition_variants),
-      std::move(parameter_block_generator), std::move(*parameters_manager),
+      std::move(parameter_block_generator),
+      std::move(recon_gain_parameter_block_generator),
+      std::move(*parameters_manager),
       *demixing_module, *std::move(audio_frame_generator),
       std::move(audio_frame_decoder), std::move(global_timing_module),
       std::move(*mix_presentation_finalizer), std::move(obu_sequencers),
@@ -428,15 +453,24 @@ absl::StatusOr<std::unique_ptr<IamfEncoder>> IamfEncoder::Create(
 absl::Status IamfEncoder::GetDescriptorObus(
     bool redundant_copy, std::vector<uint8_t>& descriptor_obus,
     bool& output_obus_are_finalized) const {
-  if (redundant_copy) {
-    // TODO(b/424474611): Implement this path, to facilitate streaming.
-    return absl::UnimplementedError(
-        "Redundant copy requested, but not implemented by this encoder.");
-  }
-  // Grab the latest from the streaming sequencer.
-  const auto& descriptor_obus_span =
-      streaming_obu_sequencer_.GetSerializedDescriptorObus();
-  descriptor_obus = {descriptor_obus_span.begin(), descriptor_obus_span.end()};
+  absl::Span<const uint8_t> descriptor_obus_span;
+  RETURN_IF_NOT_OK(GetDescriptorObus(redundant_copy, descriptor_obus_span,
+                                     output_obus_are_finalized));
+  // Reuse the capacity of the output.
+  descriptor_obus.assign(descriptor_obus_span.begin(),
+                         descriptor_obus_span.end());
+  return absl::OkStatus();
+}
+
+absl::Status IamfEncoder::GetDescriptorObus(
+    bool redundant_copy, absl::Span<const uint8_t>& descriptor_obus,
+    bool& output_obus_are_finalized) const {
+  // Grab the latest from the streaming sequencer. It caches both flavors, so
+  // neither requires serializing the OBUs again.
+  descriptor_obus =
+      redundant_copy
+          ? streaming_obu_sequencer_.GetSerializedRedundantDescriptorObus()
+          : streaming_obu_sequencer_.GetSerializedDescriptorObus();
   output_obus_are_finalized = sequencers_finalized_;
   return absl::OkStatus();
 }
@@ -462,12 +496,11 @@ absl::Status IamfEncoder::GetInputTimestamp(
   return absl::OkStatus();
 }
 
-absl::Status IamfEncoder::Encode(
-    const api::IamfTemporalUnitData& temporal_unit_data) {
-  // Parameter blocks need to cover any delayed or trimmed frames. They may be
-  // needed even if `finalize_encode_called_` is true.
+absl::Status IamfEncoder::AddParameterBlockMetadata(
+    const absl::flat_hash_map<uint32_t, std::string>&
+        parameter_block_id_to_metadata) {
   for (const auto& [parameter_block_id, raw_parameter_block_metadata] :
-       temporal_unit_data.parameter_block_id_to_metadata) {
+       parameter_block_id_to_metadata) {
     ParameterBlockObuMetadata parameter_block_metadata;
     if (!parameter_block_metadata.ParseFromString(
             raw_parameter_block_metadata)) {
@@ -478,6 +511,15 @@ absl::Status IamfEncoder::Encode(
     RETURN_IF_NOT_OK(
         parameter_block_generator_.AddMetadata(parameter_block_metadata));
   }
+  return absl::OkStatus();
+}
+
+absl::Status IamfEncoder::Encode(
+    const api::IamfTemporalUnitData& temporal_unit_data) {
+  // Parameter blocks need to cover any delayed or trimmed frames. They may be
+  // needed even if `finalize_encode_called_` is true.
+  RETURN_IF_NOT_OK(AddParameterBlockMetadata(
+      temporal_unit_data.parameter_block_id_to_metadata));
 
   if (finalize_encode_called_) {
     // Avoid adding any samples after they are finalized.
@@ -495,13 +537,7 @@ absl::Status IamfEncoder::Encode(
   for (const auto& [audio_element_id, labeled_samples] :
        temporal_unit_data.audio_element_id_to_data) {
     for (const auto& [label, samples] : labeled_samples) {
-      ChannelLabelMessage channel_label_message;
-      if (!channel_label_message.ParseFromString(label)) {
-        return absl::InvalidArgumentError(absl::StrCat(
-            "Failed to deserialize `ChannelLabelMessage` protocol buffer."));
-      }
-      auto internal_label = ChannelLabelUtils::ProtoToLabel(
-          channel_label_message.channel_label());
+      const auto internal_label = ParseChannelLabel(label);
       if (!internal_label.ok()) {
         return internal_label.status();
       }
@@ -525,21 +561,98 @@ absl::Status IamfEncoder::Encode(
   return absl::OkStatus();
 }
 
+absl::Status IamfEncoder::GetChannelHandle(
+    uint32_t audio_element_id, const std::string& channel_label,
+    api::IamfChannelHandle& channel_handle) {
+  if (!audio_elements_->contains(audio_element_id)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Unknown audio element ID= ", audio_element_id));
+  }
+  const auto internal_label = ParseChannelLabel(channel_label);
+  if (!internal_label.ok()) {
+    return internal_label.status();
+  }
+
+  const auto [iter, inserted] = channel_to_handle_.try_emplace(
+      std::make_pair(audio_element_id, *internal_label),
+      channel_handle_to_samples_.size());
+  if (inserted) {
+    channel_handle_to_samples_.push_back(
+        &id_to_labeled_samples_[audio_element_id][*internal_label]);
+  }
+  channel_handle = iter->second;
+  return absl::OkStatus();
+}
+
+absl::Status IamfEncoder::Encode(
+    const api::IamfTemporalUnitChannelData& temporal_unit_data) {
+  RETURN_IF_NOT_OK(AddParameterBlockMetadata(
+      temporal_unit_data.parameter_block_id_to_metadata));
+  for (const auto& api_metadata : temporal_unit_data.parameter_blocks) {
+    auto parameter_block_metadata = ApiToInternalType(api_metadata);
+    if (!parameter_block_metadata.ok()) {
+      return parameter_block_metadata.status();
+    }
+    RETURN_IF_NOT_OK(parameter_block_generator_.AddMetadata(
+        *std::move(parameter_block_metadata)));
+  }
+
+  if (finalize_encode_called_) {
+    if (std::any_of(temporal_unit_data.channels.begin(),
+                    temporal_unit_data.channels.end(),
+                    [](const auto& samples) { return !samples.empty(); })) {
+      ABSL_LOG_FIRST_N(WARNING, 3)
+          << "Calling `Encode()` with samples after "
+             "`FinalizeEncode()` drops the audio samples.";
+    }
+    return absl::OkStatus();
+  }
+
+  if (temporal_unit_data.channels.size() > channel_handle_to_samples_.size()) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Expected at most ", channel_handle_to_samples_.size(),
+        " channels, one per handle, got ", temporal_unit_data.channels.size(),
+        "."));
+  }
+  static_assert(std::is_same_v<InternalSampleType, double>);
+  for (size_t handle = 0; handle < temporal_unit_data.channels.size();
+       ++handle) {
+    const auto& samples = temporal_unit_data.channels[handle];
+    if (samples.empty()) {
+      continue;
+    }
+    channel_handle_to_samples_[handle]->assign(samples.begin(), samples.end());
+  }
+
+  return absl::OkStatus();
+}
+
 absl::Status IamfEncoder::OutputTemporalUnit(
     std::vector<uint8_t>& temporal_unit_obus) {
-  std::list<AudioFrameWithData> audio_frames;
-  std::list<ParameterBlockWithData> parameter_blocks;
-  std::list<ArbitraryObu> temporal_unit_arbitrary_obus;
+  GeneratedTemporalUnit generated_temporal_unit;
+  RETURN_IF_NOT_OK(GenerateTemporalUnit(generated_temporal_unit));
+  return EmitTemporalUnit(std::move(generated_temporal_unit),
+                          temporal_unit_obus);
+}
+
+absl::Status IamfEncoder::GenerateTemporalUnit(
+    GeneratedTemporalUnit& generated_temporal_unit) {
+  generated_temporal_unit = {};
 
   // Generate mix gain and demixing parameter blocks.
   RETURN_IF_NOT_OK(parameter_block_generator_.GenerateDemixing(
-      *global_timing_module_, temp_demixing_parameter_blocks_));
+      *global_timing_module_,
+      generated_temporal_unit.demixing_parameter_blocks));
   RETURN_IF_NOT_OK(parameter_block_generator_.GenerateMixGain(
-      *global_timing_module_, temp_mix_gain_parameter_blocks_));
+      *global_timing_module_,
+      generated_temporal_unit.mix_gain_parameter_blocks));
+  generated_temporal_unit.recon_gain_metadata =
+      parameter_block_generator_.TakeReconGainMetadata();
 
   // Add the newly generated demixing parameter blocks to the parameters
   // manager so they can be easily queried by the audio frame generator.
-  for (const auto& demixing_parameter_block : temp_demixing_parameter_blocks_) {
+  for (const auto& demixing_parameter_block :
+       generated_temporal_unit.demixing_parameter_blocks) {
     parameters_manager_->AddDemixingParameterBlock(&demixing_parameter_block);
   }
 
@@ -560,14 +673,51 @@ absl::Status IamfEncoder::OutputTemporalUnit(
     RETURN_IF_NOT_OK(audio_frame_generator_->Finalize());
   }
 
-  RETURN_IF_NOT_OK(audio_frame_generator_->OutputFrames(audio_frames));
+  RETURN_IF_NOT_OK(audio_frame_generator_->OutputFrames(
+      generated_temporal_unit.audio_frames));
+  generated_temporal_unit.finalize_encode_called = finalize_encode_called_;
+  generated_temporal_unit.generating_frames =
+      audio_frame_generator_->TakingSamples() ||
+      audio_frame_generator_->GeneratingFrames();
+  return absl::OkStatus();
+}
+
+absl::Status IamfEncoder::EmitTemporalUnit(
+    GeneratedTemporalUnit generated_temporal_unit,
+    std::vector<uint8_t>& temporal_unit_obus) {
+  std::list<AudioFrameWithData>& audio_frames =
+      generated_temporal_unit.audio_frames;
+  std::list<ParameterBlockWithData> parameter_blocks;
+  std::list<ArbitraryObu> temporal_unit_arbitrary_obus;
+
+  // Hold the parameter blocks until their temporal unit is emitted. Splicing
+  // keeps the demixing parameter blocks at the same address.
+  temp_demixing_parameter_blocks_.splice(
+      temp_demixing_parameter_blocks_.end(),
+      generated_temporal_unit.demixing_parameter_blocks);
+  temp_mix_gain_parameter_blocks_.splice(
+      temp_mix_gain_parameter_blocks_.end(),
+      generated_temporal_unit.mix_gain_parameter_blocks);
+  for (auto& recon_gain_metadata :
+       generated_temporal_unit.recon_gain_metadata) {
+    RETURN_IF_NOT_OK(recon_gain_parameter_block_generator_.AddMetadata(
+        std::move(recon_gain_metadata)));
+  }
+
+  // The same as `GeneratingTemporalUnits()`, but based on the state of the
+  // audio frame generator when this temporal unit was generated.
+  const auto generating_temporal_units = [&generated_temporal_unit, this]() {
+    return generated_temporal_unit.generating_frames ||
+           !timestamp_to_arbitrary_obus_.empty();
+  };
+
   if (audio_frames.empty()) {
     // Some audio codec will only output an encoded frame after the next
     // frame "pushes" the old one out. So we wait until the next iteration to
     // retrieve it.
     ABSL_VLOG(1) << "No audio frames generated for this temporal unit.";
 
-    if (finalize_encode_called_) {
+    if (generated_temporal_unit.finalize_encode_called) {
       // At the end of the sequence, there could be some extraneous arbitrary
       // OBUs that are not associated with any audio frames. Pop the next set.
       SpliceArbitraryObus(timestamp_to_arbitrary_obus_.begin(),
@@ -577,7 +727,7 @@ absl::Status IamfEncoder::OutputTemporalUnit(
       // There will be no further audio frames. Descriptors can be closed.
       // Carefully close them before writing out Arbitrary OBUs, which may
       // marked as erronous.
-      if (!GeneratingTemporalUnits()) {
+      if (!generating_temporal_units()) {
         RETURN_IF_NOT_OK(FinalizeDescriptors(
             validate_user_loudness_, mix_presentation_finalizer_,
             mix_presentation_obus_, mix_presentation_obus_finalized_));
@@ -589,7 +739,7 @@ absl::Status IamfEncoder::OutputTemporalUnit(
             obu_sequencers_, streaming_obu_sequencer_, temporal_unit_obus));
       }
 
-      if (!GeneratingTemporalUnits()) {
+      if (!generating_temporal_units()) {
         // The final extraneous OBUs have been pushed out. Take this opportunity
         // to finalize the sequencers.
         return FinalizeObuSequencers(
@@ -618,21 +768,15 @@ absl::Status IamfEncoder::OutputTemporalUnit(
 
   // Demix the original and decoded audio frames, differences between them are
   // useful to compute the recon gain parameters.
-  const auto id_to_labeled_frame =
-      demixing_module_.DemixOriginalAudioSamples(audio_frames);
-  if (!id_to_labeled_frame.ok()) {
-    return id_to_labeled_frame.status();
-  }
-  const auto id_to_labeled_decoded_frame =
-      demixing_module_.DemixDecodedAudioSamples(audio_frames);
-  if (!id_to_labeled_decoded_frame.ok()) {
-    return id_to_labeled_decoded_frame.status();
-  }
+  RETURN_IF_NOT_OK(demixing_module_.DemixOriginalAudioSamples(
+      audio_frames, id_to_labeled_frame_));
+  RETURN_IF_NOT_OK(demixing_module_.DemixDecodedAudioSamples(
+      audio_frames, id_to_labeled_decoded_frame_));
 
   // Recon gain parameter blocks are generated based on the original and
   // demixed audio frames.
-  RETURN_IF_NOT_OK(parameter_block_generator_.GenerateReconGain(
-      *id_to_labeled_frame, *id_to_labeled_decoded_frame,
+  RETURN_IF_NOT_OK(recon_gain_parameter_block_generator_.GenerateReconGain(
+      id_to_labeled_frame_, id_to_labeled_decoded_frame_,
       *global_timing_module_, temp_recon_gain_parameter_blocks_));
 
   // Move all generated parameter blocks belonging to this temporal unit to
@@ -655,19 +799,19 @@ absl::Status IamfEncoder::OutputTemporalUnit(
                       timestamp_to_arbitrary_obus_,
                       temporal_unit_arbitrary_obus);
   // Print the first and last temporal units.
-  if (!first_temporal_unit_for_debugging_ || !GeneratingTemporalUnits()) {
+  if (!first_temporal_unit_for_debugging_ || !generating_temporal_units()) {
     PrintAudioFrames(audio_frames);
     first_temporal_unit_for_debugging_ = true;
   }
 
   RETURN_IF_NOT_OK(mix_presentation_finalizer_.PushTemporalUnit(
-      *id_to_labeled_frame, output_start_timestamp, output_end_timestamp,
+      id_to_labeled_frame_, output_start_timestamp, output_end_timestamp,
       parameter_blocks));
   RETURN_IF_NOT_OK(PushTemporalUnitToObuSequencers(
       parameter_blocks, audio_frames, temporal_unit_arbitrary_obus,
       obu_sequencers_, streaming_obu_sequencer_, temporal_unit_obus));
 
-  if (GeneratingTemporalUnits()) {
+  if (generating_temporal_units()) {
     return absl::OkStatus();
   }
   // The final data OBUs have been pushed out. Take this opportunity to
@@ -681,6 +825,17 @@ absl::Status IamfEncoder::OutputTemporalUnit(
       obu_sequencers_, streaming_obu_sequencer_, sequencers_finalized_);
 }
 
+absl::Status IamfEncoder::OutputTemporalUnit(
+    absl::Span<const uint8_t>& temporal_unit_obus) {
+  // Temporal units are swapped into the member buffer, so nothing is copied.
+  // Clear it first, because some calls output nothing.
+  temporal_unit_obus = {};
+  output_temporal_unit_obus_.clear();
+  RETURN_IF_NOT_OK(OutputTemporalUnit(output_temporal_unit_obus_));
+  temporal_unit_obus = absl::MakeConstSpan(output_temporal_unit_obus_);
+  return absl::OkStatus();
+}
+
 absl::Status IamfEncoder::FinalizeEncode() {
   if (finalize_encode_called_) {
     ABSL_LOG_FIRST_N(WARNING, 3)
@@ -15,22 +15,28 @@
 #include <cstdint>
 #include <list>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/base/nullability.h"
 #include "absl/container/btree_map.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_map.h"
 #include "absl/functional/any_invocable.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "iamf/cli/audio_element_with_data.h"
 #include "iamf/cli/audio_frame_decoder.h"
+#include "iamf/cli/audio_frame_with_data.h"
+#include "iamf/cli/channel_label.h"
 #include "iamf/cli/demixing_module.h"
 #include "iamf/cli/global_timing_module.h"
 #include "iamf/cli/loudness_calculator_factory_base.h"
 #include "iamf/cli/obu_sequencer_base.h"
 #include "iamf/cli/obu_sequencer_streaming_iamf.h"
+#include "iamf/cli/parameter_block_metadata.h"
 #include "iamf/cli/parameter_block_with_data.h"
 #include "iamf/cli/parameters_manager.h"
 #include "iamf/cli/proto/test_vector_metadata.pb.h"
@@ -80,6 +86,9 @@ namespace iamf_tools {
  * all of the parameter blocks beforehand, so they would not need this
  * additional function to help arrange them.
  *
+ * `OutputTemporalUnit()` may also be split into `GenerateTemporalUnit()` and
+ * `EmitTemporalUnit()`, to encode and output temporal units on two threads.
+ *
  * Note the timestamps corresponding to parameter blocks and audio frames
  * in `Encode()` might be different from that of the output OBUs obtained in
  * `OutputTemporalUnit()`, because some codecs introduce a frame of delay. We
@@ -88,6 +97,28 @@ namespace iamf_tools {
  */
 class IamfEncoder : public api::IamfEncoderInterface {
  public:
+  /*!\brief Data of one temporal unit, between generating and emitting it.
+   *
+   * Move it rather than copying it; the encoder refers to the demixing
+   * parameter blocks until the corresponding audio frames are encoded.
+   */
+  struct GeneratedTemporalUnit {
+    // Encoded audio frames. Empty if none are ready yet.
+    std::list<AudioFrameWithData> audio_frames;
+
+    // Parameter blocks generated in the same iteration.
+    std::list<ParameterBlockWithData> demixing_parameter_blocks;
+    std::list<ParameterBlockWithData> mix_gain_parameter_blocks;
+
+    // Recon gain parameter blocks depend on the decoded audio frames, so they
+    // are generated when emitting.
+    std::list<ParameterBlockMetadata> recon_gain_metadata;
+
+    // State of the encoder after generating this temporal unit.
+    bool finalize_encode_called = false;
+    bool generating_frames = false;
+  };
+
   /*!\brief Factory to create `ObuSequencerBases`. */
   typedef absl::AnyInvocable<
       std::vector<std::unique_ptr<ObuSequencerBase> absl_nonnull>() const>
@@ -129,7 +160,9 @@ class IamfEncoder : public api::IamfEncoderInterface {
    *
    * When streaming IAMF, it is important to regularly provide
    * "redundant copies" which help downstream clients sync. The exact
-   * cadence is not mandated and depends on use case.
+   * cadence is not mandated and depends on use case. The encoder inserts them
+   * into the temporal units itself, when
+   * `EncoderControlMetadata::redundant_descriptor_obu_interval` is set.
    *
    * Mix Presentation OBUs contain loudness information, which is only
    * possible to know after all data OBUs are generated. Other OBUs with
@@ -138,7 +171,8 @@ class IamfEncoder : public api::IamfEncoderInterface {
    * non-redundant OBUs with accurate loudness information is encouraged.
    * Auxiliary fields in other descriptor OBUs may also change.
    *
-   * \param redundant_copy True to request a "redundant" copy.
+   * \param redundant_copy True to request a "redundant" copy, i.e. with
+   *        `obu_redundant_copy` set on each OBU.
    * \param descriptor_obus Finalized OBUs.
    * \param output_obus_are_finalized `true` when the output OBUs are
    *        finalized. `false` otherwise.
@@ -148,7 +182,26 @@ class IamfEncoder : public api::IamfEncoderInterface {
       bool redundant_copy, std::vector<uint8_t>& descriptor_obus,
       bool& output_obus_are_finalized) const override;
 
+  /*!\brief Gets a view of the latest descriptor OBUs.
+   *
+   * Equivalent to the other overload, but the OBUs are not copied.
+   *
+   * \param redundant_copy True to request a "redundant" copy, i.e. with
+   *        `obu_redundant_copy` set on each OBU.
+   * \param descriptor_obus View of the OBUs. Valid until the next call to a
+   *        non-const function of this encoder.
+   * \param output_obus_are_finalized `true` when the output OBUs are
+   *        finalized. `false` otherwise.
+   * \return `absl::OkStatus()` if successful. A specific status on failure.
+   */
+  absl::Status GetDescriptorObus(
+      bool redundant_copy, absl::Span<const uint8_t>& descriptor_obus,
+      bool& output_obus_are_finalized) const override;
+
   /*!\brief Returns whether this encoder is generating data OBUs.
+   *
+   * Must not be called while `GenerateTemporalUnit()` and
+   * `EmitTemporalUnit()` are running on different threads.
    *
    * \return True if still generating data OBUs.
    */
@@ -176,6 +229,30 @@ class IamfEncoder : public api::IamfEncoderInterface {
   absl::Status Encode(
       const api::IamfTemporalUnitData& temporal_unit_data) override;
 
+  /*!\brief Gets a handle to one channel of an audio element.
+   *
+   * \param audio_element_id ID of the audio element.
+   * \param channel_label Serialized `ChannelLabelMessage` protocol buffer.
+   * \param channel_handle Handle to the channel.
+   * \return `absl::OkStatus()` if successful. `absl::InvalidArgumentError()`
+   *         if the audio element is unknown or the label cannot be parsed.
+   */
+  absl::Status GetChannelHandle(
+      uint32_t audio_element_id, const std::string& channel_label,
+      api::IamfChannelHandle& channel_handle) override;
+
+  /*!\brief Adds audio data and parameter block metadata for one temporal unit.
+   *
+   * Equivalent to the other overload, but the channels are indexed by the
+   * handles from `GetChannelHandle()`. No labels are parsed or looked up.
+   *
+   * \param temporal_unit_data Temporal unit to add.
+   * \return `absl::OkStatus()` if successful. `absl::InvalidArgumentError()`
+   *         if there are more channels than handles.
+   */
+  absl::Status Encode(
+      const api::IamfTemporalUnitChannelData& temporal_unit_data) override;
+
   /*!\brief Outputs data OBUs corresponding to one temporal unit.
    *
    * \param temporal_unit_obus Output OBUs corresponding to this temporal unit.
@@ -184,6 +261,48 @@ class IamfEncoder : public api::IamfEncoderInterface {
   absl::Status OutputTemporalUnit(
       std::vector<uint8_t>& temporal_unit_obus) override;
 
+  /*!\brief Outputs a view of the data OBUs of one temporal unit.
+   *
+   * Equivalent to the other overload, but the OBUs are not copied.
+   *
+   * \param temporal_unit_obus View of the OBUs corresponding to this temporal
+   *        unit, or empty if no temporal unit was ready. Valid until the next
+   *        call to a non-const function of this encoder.
+   * \return `absl::OkStatus()` if successful. A specific status on failure.
+   */
+  absl::Status OutputTemporalUnit(
+      absl::Span<const uint8_t>& temporal_unit_obus) override;
+
+  /*!\brief Encodes the audio frames and parameter blocks of a temporal unit.
+   *
+   * Equivalent to the first half of `OutputTemporalUnit()`. Down-mixes and
+   * encodes the added samples, and generates the demixing and mix gain
+   * parameter blocks.
+   *
+   * This function, `Encode()`, `FinalizeEncode()` and `GetInputTimestamp()`
+   * may run on one thread while `EmitTemporalUnit()` runs on another. Each
+   * temporal unit must be emitted once, in the order it was generated. The
+   * output OBUs are then the same as those of `OutputTemporalUnit()`.
+   *
+   * \param generated_temporal_unit Output data of this temporal unit.
+   * \return `absl::OkStatus()` if successful. A specific status on failure.
+   */
+  absl::Status GenerateTemporalUnit(
+      GeneratedTemporalUnit& generated_temporal_unit);
+
+  /*!\brief Outputs data OBUs of a generated temporal unit.
+   *
+   * Equivalent to the second half of `OutputTemporalUnit()`. Decodes and
+   * demixes the audio frames, generates the recon gain parameter blocks and
+   * measures loudness. See `GenerateTemporalUnit()` for the threading rules.
+   *
+   * \param generated_temporal_unit Temporal unit to output.
+   * \param temporal_unit_obus Output OBUs corresponding to this temporal unit.
+   * \return `absl::OkStatus()` if successful. A specific status on failure.
+   */
+  absl::Status EmitTemporalUnit(GeneratedTemporalUnit generated_temporal_unit,
+                                std::vector<uint8_t>& temporal_unit_obus);
+
   /*!\brief Finalizes the process of encoding.
    *
    * This will signal the underlying codecs to flush all remaining samples,
@@ -230,6 +349,16 @@ class IamfEncoder : public api::IamfEncoderInterface {
   const std::list<ArbitraryObu>& GetDescriptorArbitraryObus() const;
 
  private:
+  /*!\brief Adds parameter block metadata for one temporal unit.
+   *
+   * \param parameter_block_id_to_metadata Serialized parameter block metadata
+   *        to add.
+   * \return `absl::OkStatus()` if successful. A specific status on failure.
+   */
+  absl::Status AddParameterBlockMetadata(
+      const absl::flat_hash_map<uint32_t, std::string>&
+          parameter_block_id_to_metadata);
+
   /*!\brief Private constructor.
    *
    * Moves from the input arguments Some arguments are wrapped in unique
@@ -248,6 +377,8 @@ class IamfEncoder : public api::IamfEncoderInterface {
    * \param parameter_id_to_metadata Mapping from parameter IDs to per-ID
    *        parameter metadata.
    * \param param_definition_variants Parameter definitions for the IA Sequence.
+   * \param recon_gain_parameter_block_generator Generator of the recon gain
+   *        parameter blocks, used when emitting temporal units.
    * \param parameters_manager Manager to support internal querying
    *        of parameters.
    * \param demixing_module Module to demix audio elements.
@@ -272,6 +403,7 @@ class IamfEncoder : public api::IamfEncoderInterface {
           absl::flat_hash_map<DecodedUleb128, ParamDefinitionVariant>>
           param_definition_variants,
       ParameterBlockGenerator&& parameter_block_generator,
+      ParameterBlockGenerator&& recon_gain_parameter_block_generator,
       std::unique_ptr<ParametersManager> parameters_manager,
       const DemixingModule& demixing_module,
       std::unique_ptr<AudioFrameGenerator> audio_frame_generator,
@@ -290,6 +422,8 @@ class IamfEncoder : public api::IamfEncoderInterface {
         timestamp_to_arbitrary_obus_(std::move(timestamp_to_arbitrary_obus)),
         param_definition_variants_(std::move(param_definition_variants)),
         parameter_block_generator_(std::move(parameter_block_generator)),
+        recon_gain_parameter_block_generator_(
+            std::move(recon_gain_parameter_block_generator)),
         parameters_manager_(std::move(parameters_manager)),
         demixing_module_(demixing_module),
         audio_frame_generator_(std::move(audio_frame_generator)),
@@ -325,20 +459,33 @@ class IamfEncoder : public api::IamfEncoderInterface {
   bool first_temporal_unit_for_debugging_ = false;
 
   // Mapping from parameter IDs to parameter definitions.
-  // Parameter block generator owns a reference to this map. Wrapped in
+  // Parameter block generators own a reference to this map. Wrapped in
   // `std::unique_ptr` for reference stability after move.
   absl_nonnull std::unique_ptr<
       const absl::flat_hash_map<DecodedUleb128, ParamDefinitionVariant>>
       param_definition_variants_;
 
-  // Saved parameter blocks generated in one iteration.
+  // Saved parameter blocks, until their temporal unit is emitted.
   std::list<ParameterBlockWithData> temp_mix_gain_parameter_blocks_;
   std::list<ParameterBlockWithData> temp_demixing_parameter_blocks_;
   std::list<ParameterBlockWithData> temp_recon_gain_parameter_blocks_;
 
+  // Demixed original and decoded frames of the latest temporal unit. Held
+  // across iterations, so the channels are not reallocated every time.
+  IdLabeledFrameMap id_to_labeled_frame_;
+  IdLabeledFrameMap id_to_labeled_decoded_frame_;
+
   // Cached mapping from Audio Element ID to labeled samples added in the same
-  // iteration.
-  absl::flat_hash_map<DecodedUleb128, LabelSamplesMap> id_to_labeled_samples_;
+  // iteration. A node map, so the samples stay at the same address as other
+  // audio elements are added, or when the encoder is moved.
+  absl::node_hash_map<DecodedUleb128, LabelSamplesMap> id_to_labeled_samples_;
+
+  // Cached samples of each channel handle, and the handle of each resolved
+  // (audio element, label) pair.
+  std::vector<std::vector<InternalSampleType>*> channel_handle_to_samples_;
+  absl::flat_hash_map<std::pair<DecodedUleb128, ChannelLabel::Label>,
+                      api::IamfChannelHandle>
+      channel_to_handle_;
 
   // Whether the `FinalizeEncode()` has been called.
   bool finalize_encode_called_ = false;
@@ -346,6 +493,7 @@ class IamfEncoder : public api::IamfEncoderInterface {
   // Various generators and modules used when generating data OBUs iteratively.
   // Some are held in `unique_ptr` for reference stability after move.
   ParameterBlockGenerator parameter_block_generator_;
+  ParameterBlockGenerator recon_gain_parameter_block_generator_;
   absl_nonnull std::unique_ptr<ParametersManager> parameters_manager_;
   const DemixingModule demixing_module_;
   absl_nonnull std::unique_ptr<AudioFrameGenerator> audio_frame_generator_;
@@ -364,6 +512,8 @@ class IamfEncoder : public api::IamfEncoderInterface {
   ObuSequencerStreamingIamf streaming_obu_sequencer_;
   // True after the sequencers have been finalized.
   bool sequencers_finalized_ = false;
+  // Backs the view output by `OutputTemporalUnit()`.
+  std::vector<uint8_t> output_temporal_unit_obus_;
 };
 
 }  // namespace iamf_tools
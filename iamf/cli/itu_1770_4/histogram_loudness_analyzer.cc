@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/cli/itu_1770_4/histogram_loudness_analyzer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numbers>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_log.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "iamf/common/utils/macros.h"
+#include "iamf/common/utils/polyphase_resampler.h"
+#include "iamf/obu/types.h"
+
+// The lanes of the K-weighting filters must round like the scalar recursion.
+// Keep compilers from fusing its products and sums into FMAs.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace iamf_tools {
+
+namespace {
+
+// Offset of the loudness of a mean square, as in ITU-1770-4.
+constexpr double kLoudnessOffset = -0.691;
+
+// Gating blocks are 400 ms long and overlap by 75%.
+constexpr int32_t kNumStepsPerSecond = 10;
+constexpr size_t kNumStepsPerBlock = 4;
+
+constexpr size_t kOversamplingFactor = 4;
+
+// Number of channels which are K-weighted together. Each channel takes one
+// lane of a 128-bit vector of doubles.
+constexpr size_t kNumLanes = 2;
+
+std::vector<size_t> GetChannelsWithNonZeroWeight(
+    const std::vector<float>& weights) {
+  std::vector<size_t> channels;
+  for (size_t c = 0; c < weights.size(); ++c) {
+    if (weights[c] != 0.0f) {
+      channels.push_back(c);
+    }
+  }
+  return channels;
+}
+
+double MeanSquareToLoudness(double mean_square) {
+  return kLoudnessOffset + 10.0 * std::log10(mean_square);
+}
+
+float AmplitudeToDb(double amplitude) {
+  return static_cast<float>(20.0 * std::log10(amplitude));
+}
+
+}  // namespace
+
+void LoudnessHistogram::AddBlock(double mean_square) {
+  const double loudness = MeanSquareToLoudness(mean_square);
+  if (!(loudness > kAbsoluteGateLkfs)) {
+    return;
+  }
+  const auto bin = std::min(
+      kNumBins - 1,
+      static_cast<size_t>((loudness - kAbsoluteGateLkfs) / kBinWidthLu));
+  counts_[bin]++;
+  energies_[bin] += mean_square;
+}
+
+std::optional<double> LoudnessHistogram::GetRelativeGatedLoudness() const {
+  int64_t total_count = 0;
+  double total_energy = 0.0;
+  for (size_t bin = 0; bin < kNumBins; ++bin) {
+    total_count += counts_[bin];
+    total_energy += energies_[bin];
+  }
+  if (total_count == 0) {
+    return std::nullopt;
+  }
+
+  // Keep the bins whose mean loudness is above the relative gate. Blocks in
+  // the bin which straddles the gate are kept or discarded together.
+  const double relative_gate =
+      MeanSquareToLoudness(total_energy / total_count) + kRelativeGateLu;
+  int64_t gated_count = 0;
+  double gated_energy = 0.0;
+  for (size_t bin = 0; bin < kNumBins; ++bin) {
+    if (counts_[bin] > 0 &&
+        MeanSquareToLoudness(energies_[bin] / counts_[bin]) > relative_gate) {
+      gated_count += counts_[bin];
+      gated_energy += energies_[bin];
+    }
+  }
+  if (gated_count == 0) {
+    return std::nullopt;
+  }
+  return MeanSquareToLoudness(gated_energy / gated_count);
+}
+
+std::unique_ptr<HistogramLoudnessAnalyzer> HistogramLoudnessAnalyzer::Create(
+    const std::vector<float>& weights, int32_t sample_rate,
+    bool enable_true_peak_measurement) {
+  if (weights.empty() || sample_rate < kNumStepsPerSecond) {
+    ABSL_LOG(ERROR) << "Invalid arguments for the loudness analyzer: "
+                    << "num_channels= " << weights.size()
+                    << ", sample_rate= " << sample_rate;
+    return nullptr;
+  }
+
+  std::unique_ptr<PolyphaseResampler> true_peak_resampler;
+  if (enable_true_peak_measurement) {
+    auto resampler = PolyphaseResampler::Create(
+        sample_rate, sample_rate * kOversamplingFactor, weights.size());
+    if (!resampler.ok()) {
+      ABSL_LOG(ERROR) << "Failed to create the true peak resampler: "
+                      << resampler.status();
+      return nullptr;
+    }
+    true_peak_resampler = *std::move(resampler);
+  }
+
+  return absl::WrapUnique(new HistogramLoudnessAnalyzer(
+      weights, sample_rate, std::move(true_peak_resampler)));
+}
+
+HistogramLoudnessAnalyzer::HistogramLoudnessAnalyzer(
+    const std::vector<float>& weights, int32_t sample_rate,
+    std::unique_ptr<PolyphaseResampler> true_peak_resampler)
+    : weights_(weights.begin(), weights.end()),
+      filtered_channels_(GetChannelsWithNonZeroWeight(weights)),
+      num_ticks_per_step_(
+          static_cast<size_t>(std::lround(static_cast<double>(sample_rate) /
+                                          kNumStepsPerSecond))),
+      // The K-weighting filters of ITU-1770-4, redesigned for `sample_rate`
+      // from their analog prototypes. A high shelf models the acoustic effect
+      // of the head, then a high pass applies the revised low-frequency
+      // B-curve.
+      pre_filter_([sample_rate] {
+        constexpr double kCenterHz = 1681.974450955533;
+        constexpr double kGainDb = 3.999843853973347;
+        constexpr double kQ = 0.7071752369554196;
+        const double k = std::tan(std::numbers::pi * kCenterHz / sample_rate);
+        const double vh = std::pow(10.0, kGainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / kQ + k * k;
+        return Biquad{.b0 = (vh + vb * k / kQ + k * k) / a0,
+                      .b1 = 2.0 * (k * k - vh) / a0,
+                      .b2 = (vh - vb * k / kQ + k * k) / a0,
+                      .a1 = 2.0 * (k * k - 1.0) / a0,
+                      .a2 = (1.0 - k / kQ + k * k) / a0};
+      }()),
+      rlb_filter_([sample_rate] {
+        constexpr double kCenterHz = 38.13547087602444;
+        constexpr double kQ = 0.5003270373238773;
+        const double k = std::tan(std::numbers::pi * kCenterHz / sample_rate);
+        const double a0 = 1.0 + k / kQ + k * k;
+        return Biquad{.b0 = 1.0,
+                      .b1 = -2.0,
+                      .b2 = 1.0,
+                      .a1 = 2.0 * (k * k - 1.0) / a0,
+                      .a2 = (1.0 - k / kQ + k * k) / a0};
+      }()),
+      filter_states_(weights.size()),
+      true_peak_resampler_(std::move(true_peak_resampler)) {}
+
+void HistogramLoudnessAnalyzer::AccumulateEnergy(
+    absl::Span<const absl::Span<const InternalSampleType>>
+        channel_time_samples,
+    size_t start, size_t num_ticks) {
+  // Filter the channels in groups, one channel per lane. Lanes past the last
+  // channel repeat it and are discarded.
+  for (size_t first = 0; first < filtered_channels_.size();
+       first += kNumLanes) {
+    const size_t num_lanes =
+        std::min(kNumLanes, filtered_channels_.size() - first);
+    std::array<const InternalSampleType*, kNumLanes> inputs;
+    // Copy the states to locals, so they stay in registers.
+    std::array<double, kNumLanes> x1, x2, y1, y2, z1, z2;
+    for (size_t lane = 0; lane < kNumLanes; ++lane) {
+      const size_t c =
+          filtered_channels_[first + std::min(lane, num_lanes - 1)];
+      inputs[lane] = channel_time_samples[c].data() + start;
+      const FilterState& state = filter_states_[c];
+      x1[lane] = state.x1;
+      x2[lane] = state.x2;
+      y1[lane] = state.y1;
+      y2[lane] = state.y2;
+      z1[lane] = state.z1;
+      z2[lane] = state.z2;
+    }
+
+    std::array<double, kNumLanes> sums_of_squares{};
+    for (size_t t = 0; t < num_ticks; ++t) {
+      for (size_t lane = 0; lane < kNumLanes; ++lane) {
+        const double x = inputs[lane][t];
+        const double y = pre_filter_.b0 * x + pre_filter_.b1 * x1[lane] +
+                         pre_filter_.b2 * x2[lane] -
+                         pre_filter_.a1 * y1[lane] - pre_filter_.a2 * y2[lane];
+        const double z = rlb_filter_.b0 * y + rlb_filter_.b1 * y1[lane] +
+                         rlb_filter_.b2 * y2[lane] -
+                         rlb_filter_.a1 * z1[lane] - rlb_filter_.a2 * z2[lane];
+        x2[lane] = x1[lane];
+        x1[lane] = x;
+        y2[lane] = y1[lane];
+        y1[lane] = y;
+        z2[lane] = z1[lane];
+        z1[lane] = z;
+        sums_of_squares[lane] += z * z;
+      }
+    }
+
+    // Write back the states and accumulate the energies in channel order.
+    for (size_t lane = 0; lane < num_lanes; ++lane) {
+      const size_t c = filtered_channels_[first + lane];
+      filter_states_[c] = {.x1 = x1[lane],
+                           .x2 = x2[lane],
+                           .y1 = y1[lane],
+                           .y2 = y2[lane],
+                           .z1 = z1[lane],
+                           .z2 = z2[lane]};
+      step_energy_ += weights_[c] * sums_of_squares[lane];
+    }
+  }
+  num_ticks_in_step_ += num_ticks;
+}
+
+absl::Status HistogramLoudnessAnalyzer::Process(
+    absl::Span<const absl::Span<const InternalSampleType>>
+        channel_time_samples) {
+  if (channel_time_samples.size() != weights_.size()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Expected ", weights_.size(), " channels, got ",
+                     channel_time_samples.size(), "."));
+  }
+  const size_t num_ticks = channel_time_samples[0].size();
+  for (const auto& channel : channel_time_samples) {
+    if (channel.size() != num_ticks) {
+      return absl::InvalidArgumentError(
+          "All channels must have the same number of ticks.");
+    }
+    for (const auto sample : channel) {
+      digital_peak_ = std::max(digital_peak_, std::abs(sample));
+    }
+  }
+
+  if (true_peak_resampler_ != nullptr) {
+    RETURN_IF_NOT_OK(true_peak_resampler_->Process(channel_time_samples,
+                                                   oversampled_samples_));
+    for (const auto& channel : oversampled_samples_) {
+      for (const auto sample : channel) {
+        oversampled_peak_ = std::max(oversampled_peak_, std::abs(sample));
+      }
+    }
+  }
+
+  // Split the samples at the step boundaries. Each completed step closes a
+  // gating block, once there are enough steps.
+  size_t start = 0;
+  while (start < num_ticks) {
+    const size_t num_ticks_to_accumulate = std::min(
+        num_ticks - start, num_ticks_per_step_ - num_ticks_in_step_);
+    AccumulateEnergy(channel_time_samples, start, num_ticks_to_accumulate);
+    start += num_ticks_to_accumulate;
+    if (num_ticks_in_step_ < num_ticks_per_step_) {
+      break;
+    }
+
+    num_completed_steps_++;
+    if (num_completed_steps_ >= kNumStepsPerBlock) {
+      double block_energy = step_energy_;
+      for (const double energy : previous_step_energies_) {
+        block_energy += energy;
+      }
+      histogram_.AddBlock(block_energy /
+                          (kNumStepsPerBlock * num_ticks_per_step_));
+    }
+    std::rotate(previous_step_energies_.begin(),
+                previous_step_energies_.begin() + 1,
+                previous_step_energies_.end());
+    previous_step_energies_.back() = step_energy_;
+    step_energy_ = 0.0;
+    num_ticks_in_step_ = 0;
+  }
+
+  return absl::OkStatus();
+}
+
+std::optional<float>
+HistogramLoudnessAnalyzer::GetRelativeGatedIntegratedLoudness() const {
+  const auto loudness = histogram_.GetRelativeGatedLoudness();
+  if (!loudness.has_value()) {
+    return std::nullopt;
+  }
+  return static_cast<float>(*loudness);
+}
+
+float HistogramLoudnessAnalyzer::digital_peak_dbfs() const {
+  return AmplitudeToDb(digital_peak_);
+}
+
+float HistogramLoudnessAnalyzer::true_peak_dbfs() const {
+  // The last few samples are still in the resampler, but the digital peak
+  // covers them.
+  return AmplitudeToDb(std::max(digital_peak_, oversampled_peak_));
+}
+
+}  // namespace iamf_tools
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#ifndef CLI_ITU_1770_4_HISTOGRAM_LOUDNESS_ANALYZER_H_
+#define CLI_ITU_1770_4_HISTOGRAM_LOUDNESS_ANALYZER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "iamf/common/utils/polyphase_resampler.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+
+/*!\brief Histogram of gating block loudnesses for ITU-1770-4 gating.
+ *
+ * Blocks are sorted into bins of `kBinWidthLu` between the absolute gate and
+ * `kMaxLoudnessLkfs`; louder blocks are kept in the last bin. Each bin keeps
+ * the count and the total energy of its blocks, so only the bin which
+ * straddles the relative gate is approximated. The memory used is constant,
+ * regardless of the number of blocks.
+ */
+class LoudnessHistogram {
+ public:
+  /*!\brief Blocks at or below this loudness are discarded. */
+  static constexpr double kAbsoluteGateLkfs = -70.0;
+
+  /*!\brief Blocks above this loudness are kept in the last bin. */
+  static constexpr double kMaxLoudnessLkfs = 30.0;
+
+  /*!\brief Width of each bin in LU. */
+  static constexpr double kBinWidthLu = 0.1;
+
+  /*!\brief Relative gate, in LU below the absolute-gated loudness. */
+  static constexpr double kRelativeGateLu = -10.0;
+
+  /*!\brief Adds a gating block.
+   *
+   * \param mean_square Weighted sum of the mean squares of the K-weighted
+   *        channels in the block.
+   */
+  void AddBlock(double mean_square);
+
+  /*!\brief Gets the loudness after the absolute and relative gates.
+   *
+   * \return Integrated loudness in LKFS, or `std::nullopt` if no block passed
+   *         the gates.
+   */
+  std::optional<double> GetRelativeGatedLoudness() const;
+
+ private:
+  static constexpr size_t kNumBins =
+      static_cast<size_t>((kMaxLoudnessLkfs - kAbsoluteGateLkfs) / kBinWidthLu +
+                          0.5);
+
+  std::array<int64_t, kNumBins> counts_{};
+  std::array<double, kNumBins> energies_{};
+};
+
+/*!\brief Measures ITU-1770-4 loudness and peaks in bounded memory.
+ *
+ * Samples are K-weighted and accumulated in 100 ms steps; each gating block is
+ * the last four steps. Blocks are gated with a `LoudnessHistogram`, so the
+ * state does not grow with the duration of the programme. The integrated
+ * loudness is within 0.1 LU of exact gating.
+ *
+ * The true peak is measured on a 4x oversampled copy of each channel, and is
+ * never lower than the digital peak.
+ */
+class HistogramLoudnessAnalyzer {
+ public:
+  /*!\brief Factory function.
+   *
+   * \param weights Per-channel weights, as in ITU-1770-4.
+   * \param sample_rate Sample rate of the input.
+   * \param enable_true_peak_measurement Whether to measure the true peak.
+   * \return Unique pointer to the analyzer on success. `nullptr` if the
+   *         arguments are invalid.
+   */
+  static std::unique_ptr<HistogramLoudnessAnalyzer> Create(
+      const std::vector<float>& weights, int32_t sample_rate,
+      bool enable_true_peak_measurement);
+
+  /*!\brief Analyzes a block of samples.
+   *
+   * \param channel_time_samples Samples arranged in (channel, time). All
+   *        channels must have the same number of ticks.
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status Process(absl::Span<const absl::Span<const InternalSampleType>>
+                           channel_time_samples);
+
+  /*!\brief Gets the integrated loudness.
+   *
+   * \return Integrated loudness in LKFS, or `std::nullopt` if no gating block
+   *         passed the gates.
+   */
+  std::optional<float> GetRelativeGatedIntegratedLoudness() const;
+
+  /*!\brief Gets the digital peak.
+   *
+   * \return Digital peak in dBFS.
+   */
+  float digital_peak_dbfs() const;
+
+  /*!\brief Gets the true peak.
+   *
+   * \return True peak in dBTP. Equal to the digital peak if the true peak is
+   *         not measured.
+   */
+  float true_peak_dbfs() const;
+
+ private:
+  // Coefficients of a biquad, normalized so that `a0` is one.
+  struct Biquad {
+    double b0, b1, b2, a1, a2;
+  };
+
+  // State of the cascaded K-weighting filters of one channel.
+  struct FilterState {
+    double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+    double z1 = 0.0, z2 = 0.0;
+  };
+
+  /*!\brief Private constructor. Used only by the factory function.
+   *
+   * \param weights Per-channel weights.
+   * \param sample_rate Sample rate of the input.
+   * \param true_peak_resampler Resampler to oversample the input, or `nullptr`
+   *        to skip measuring the true peak.
+   */
+  HistogramLoudnessAnalyzer(
+      const std::vector<float>& weights, int32_t sample_rate,
+      std::unique_ptr<PolyphaseResampler> true_peak_resampler);
+
+  /*!\brief Filters and accumulates part of a step.
+   *
+   * Channels are filtered several at a time, but each channel is filtered and
+   * accumulated as if it were alone.
+   *
+   * \param channel_time_samples Samples arranged in (channel, time).
+   * \param start Index of the first tick to accumulate.
+   * \param num_ticks Number of ticks to accumulate, not crossing a step.
+   */
+  void AccumulateEnergy(
+      absl::Span<const absl::Span<const InternalSampleType>>
+          channel_time_samples,
+      size_t start, size_t num_ticks);
+
+  const std::vector<double> weights_;
+  // Indices of the channels with a non-zero weight, in ascending order.
+  const std::vector<size_t> filtered_channels_;
+  const size_t num_ticks_per_step_;
+  const Biquad pre_filter_;
+  const Biquad rlb_filter_;
+  std::vector<FilterState> filter_states_;
+
+  // Weighted energy of the step in progress, and the number of its ticks.
+  double step_energy_ = 0.0;
+  size_t num_ticks_in_step_ = 0;
+  // Energies of the last steps which form the next gating block.
+  std::array<double, 3> previous_step_energies_{};
+  size_t num_completed_steps_ = 0;
+  LoudnessHistogram histogram_;
+
+  double digital_peak_ = 0.0;
+  double oversampled_peak_ = 0.0;
+  std::unique_ptr<PolyphaseResampler> true_peak_resampler_;
+  std::vector<std::vector<double>> oversampled_samples_;
+};
+
+}  // namespace iamf_tools
+
+#endif  // CLI_ITU_1770_4_HISTOGRAM_LOUDNESS_ANALYZER_H_
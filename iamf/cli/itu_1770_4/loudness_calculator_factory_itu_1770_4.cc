@@ -25,7 +25,7 @@ LoudnessCalculatorFactoryItu1770_4::CreateLoudnessCalculator(
     const MixPresentationLayout& layout, uint32_t num_samples_per_frame,
     int32_t rendered_sample_rate) const {
   return LoudnessCalculatorItu1770_4::CreateForLayout(
-      layout, num_samples_per_frame, rendered_sample_rate);
+      layout, num_samples_per_frame, rendered_sample_rate, gating_mode_);
 }
 
 }  // namespace iamf_tools
@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <memory>
 
+#include "iamf/cli/itu_1770_4/loudness_calculator_itu_1770_4.h"
 #include "iamf/cli/loudness_calculator_base.h"
 #include "iamf/cli/loudness_calculator_factory_base.h"
 #include "iamf/obu/mix_presentation.h"
@@ -35,6 +36,17 @@ namespace iamf_tools {
 class LoudnessCalculatorFactoryItu1770_4
     : public LoudnessCalculatorFactoryBase {
  public:
+  /*!\brief Constructor.
+   *
+   * \param gating_mode How the created calculators gate the integrated
+   *        loudness. Histogram gating bounds the memory used for long
+   *        programmes.
+   */
+  explicit LoudnessCalculatorFactoryItu1770_4(
+      LoudnessCalculatorItu1770_4::GatingMode gating_mode =
+          LoudnessCalculatorItu1770_4::GatingMode::kExact)
+      : gating_mode_(gating_mode) {}
+
   /*!\brief Creates an ITU 1770-4 loudness calculator.
    *
    * \param layout Layout to measure loudness on.
@@ -50,6 +62,9 @@ class LoudnessCalculatorFactoryItu1770_4
 
   /*!\brief Destructor. */
   ~LoudnessCalculatorFactoryItu1770_4() override = default;
+
+ private:
+  const LoudnessCalculatorItu1770_4::GatingMode gating_mode_;
 };
 
 }  // namespace iamf_tools
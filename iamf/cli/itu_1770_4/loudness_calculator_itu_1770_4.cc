@@ -16,7 +16,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "absl/base/no_destructor.h"
@@ -28,6 +30,7 @@
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
+#include "iamf/cli/itu_1770_4/histogram_loudness_analyzer.h"
 #include "iamf/cli/proto/mix_presentation.pb.h"
 #include "iamf/cli/proto/test_vector_metadata.pb.h"
 #include "iamf/common/utils/macros.h"
@@ -182,7 +185,7 @@ absl::Status GetDataPointersAndNumberOfValidSamples(
 std::unique_ptr<LoudnessCalculatorItu1770_4>
 LoudnessCalculatorItu1770_4::CreateForLayout(
     const MixPresentationLayout& layout, uint32_t num_samples_per_frame,
-    int32_t rendered_sample_rate) {
+    int32_t rendered_sample_rate, GatingMode gating_mode) {
   const auto weights = GetItu1770_4ChannelWeights(layout.loudness_layout);
   if (!weights.ok()) {
     ABSL_LOG(ERROR) << "Failed to get channel weights: " << weights.status();
@@ -200,10 +203,38 @@ LoudnessCalculatorItu1770_4::CreateForLayout(
   ABSL_VLOG(1) << "  enable_true_peak_measurement= "
                << enable_true_peak_measurement;
   ABSL_VLOG(1) << "  weights= " << absl::StrJoin(*weights, ", ");
+  ABSL_VLOG(1) << "  histogram_gating= "
+               << (gating_mode == GatingMode::kHistogram);
+
+  std::unique_ptr<HistogramLoudnessAnalyzer> histogram_analyzer;
+  if (gating_mode == GatingMode::kHistogram) {
+    histogram_analyzer = HistogramLoudnessAnalyzer::Create(
+        *weights, rendered_sample_rate, enable_true_peak_measurement);
+    if (histogram_analyzer == nullptr) {
+      return nullptr;
+    }
+  }
 
   return absl::WrapUnique(new LoudnessCalculatorItu1770_4(
       num_samples_per_frame, num_channels, *weights, rendered_sample_rate,
-      layout.loudness, enable_true_peak_measurement));
+      layout.loudness, enable_true_peak_measurement,
+      std::move(histogram_analyzer)));
+}
+
+LoudnessCalculatorItu1770_4::LoudnessCalculatorItu1770_4(
+    uint32_t num_samples_per_frame, int32_t num_channels,
+    const std::vector<float>& weights, int32_t rendered_sample_rate,
+    const LoudnessInfo& loudness_info, bool enable_true_peak_measurement,
+    std::unique_ptr<HistogramLoudnessAnalyzer> histogram_analyzer)
+    : num_samples_per_frame_(num_samples_per_frame),
+      num_channels_(num_channels),
+      user_provided_loudness_info_(loudness_info),
+      planar_non_contiguous_pointers_(num_channels, nullptr),
+      histogram_analyzer_(std::move(histogram_analyzer)) {
+  if (histogram_analyzer_ == nullptr) {
+    ebu_r128_analyzer_.emplace(num_channels, weights, rendered_sample_rate,
+                               enable_true_peak_measurement);
+  }
 }
 
 absl::Status LoudnessCalculatorItu1770_4::AccumulateLoudnessForSamples(
@@ -214,7 +245,10 @@ absl::Status LoudnessCalculatorItu1770_4::AccumulateLoudnessForSamples(
       channel_time_samples, num_samples_per_frame_, num_channels_,
       num_valid_samples_per_channel, planar_non_contiguous_pointers_));
 
-  ebu_r128_analyzer_.Process(
+  if (histogram_analyzer_ != nullptr) {
+    return histogram_analyzer_->Process(channel_time_samples);
+  }
+  ebu_r128_analyzer_->Process(
       static_cast<const void*>(planar_non_contiguous_pointers_.data()),
       num_valid_samples_per_channel, kSampleFormat, kPlanarNonContiguous);
 
@@ -230,21 +264,30 @@ absl::StatusOr<LoudnessInfo> LoudnessCalculatorItu1770_4::QueryLoudness()
   float calculated_digital_peak = kMinQ7_8;
   float calculated_true_peak = kMinQ7_8;
 
-  if (const auto& integrated_loudness =
-          ebu_r128_analyzer_.GetRelativeGatedIntegratedLoudness();
-      !integrated_loudness.has_value()) {
+  // Both analyzers have the same interface for the measured values.
+  const auto query_analyzer = [&](const auto& analyzer) {
+    const auto integrated_loudness =
+        analyzer.GetRelativeGatedIntegratedLoudness();
+    if (!integrated_loudness.has_value()) {
+      return false;
+    }
+    calculated_integrated_loudness =
+        std::clamp(*integrated_loudness, kMinQ7_8, kMaxQ7_8);
+    calculated_digital_peak =
+        std::clamp(analyzer.digital_peak_dbfs(), kMinQ7_8, kMaxQ7_8);
+    calculated_true_peak =
+        std::clamp(analyzer.true_peak_dbfs(), kMinQ7_8, kMaxQ7_8);
+    return true;
+  };
+  const bool has_integrated_loudness =
+      histogram_analyzer_ != nullptr ? query_analyzer(*histogram_analyzer_)
+                                     : query_analyzer(*ebu_r128_analyzer_);
+  if (!has_integrated_loudness) {
     // TODO(b/274740345): Figure out if there is a better solution for short
     //                    audio sequences.
     ABSL_LOG(WARNING) << "Loudness cannot be computed or is too low; "
                       << "using minimal value representable by Q7.8.";
     // OK. Fallback to the default values.
-  } else {
-    calculated_integrated_loudness =
-        std::clamp(*integrated_loudness, kMinQ7_8, kMaxQ7_8);
-    calculated_digital_peak =
-        std::clamp(ebu_r128_analyzer_.digital_peak_dbfs(), kMinQ7_8, kMaxQ7_8);
-    calculated_true_peak =
-        std::clamp(ebu_r128_analyzer_.true_peak_dbfs(), kMinQ7_8, kMaxQ7_8);
   }
 
   // Initialize the output based on the user-provided loudness info. This allows
@@ -14,11 +14,13 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
+#include "iamf/cli/itu_1770_4/histogram_loudness_analyzer.h"
 #include "iamf/cli/loudness_calculator_base.h"
 #include "iamf/obu/mix_presentation.h"
 #include "iamf/obu/types.h"
@@ -33,9 +35,21 @@ namespace iamf_tools {
  * samples to measure loudness on.
  * - Call `QueryLoudness()` to query the current loudness. The types to be
  * measured are determined from the constructor argument.
+ *
+ * By default the gating blocks of the whole programme are kept, and gated
+ * exactly. `GatingMode::kHistogram` gates with a fixed-resolution histogram
+ * instead, so the memory used does not grow with the duration of the
+ * programme.
  */
 class LoudnessCalculatorItu1770_4 : public LoudnessCalculatorBase {
  public:
+  enum class GatingMode {
+    // Keep every gating block and gate them exactly.
+    kExact,
+    // Gate a histogram of the blocks, within 0.1 LU of exact gating.
+    kHistogram,
+  };
+
   /*!\brief Creates an ITU 1770-4 loudness calculator.
    *
    * \param layout Layout to measure loudness on.
@@ -43,10 +57,12 @@ class LoudnessCalculatorItu1770_4 : public LoudnessCalculatorBase {
    *        to process. Subsequent calls to `AccumulateLoudnessForSamples()`
    *        must not have more sample than this.
    * \param rendered_sample_rate Sample rate of the rendered audio.
+   * \param gating_mode How to gate the integrated loudness.
    */
   static std::unique_ptr<LoudnessCalculatorItu1770_4> CreateForLayout(
       const MixPresentationLayout& layout, uint32_t num_samples_per_frame,
-      int32_t rendered_sample_rate);
+      int32_t rendered_sample_rate,
+      GatingMode gating_mode = GatingMode::kExact);
 
   /*!\brief Destructor. */
   ~LoudnessCalculatorItu1770_4() override = default;
@@ -82,19 +98,14 @@ class LoudnessCalculatorItu1770_4 : public LoudnessCalculatorBase {
    * \param loudness_info User-provided loudness information.
    * \param enable_true_peak_measurement Whether to enable true peak
    *        measurement.
+   * \param histogram_analyzer Analyzer to use in histogram gating mode, or
+   *        `nullptr` to gate exactly.
    */
-  LoudnessCalculatorItu1770_4(uint32_t num_samples_per_frame,
-                              int32_t num_channels,
-                              const std::vector<float>& weights,
-                              int32_t rendered_sample_rate,
-                              const LoudnessInfo& loudness_info,
-                              bool enable_true_peak_measurement)
-      : num_samples_per_frame_(num_samples_per_frame),
-        num_channels_(num_channels),
-        user_provided_loudness_info_(loudness_info),
-        planar_non_contiguous_pointers_(num_channels, nullptr),
-        ebu_r128_analyzer_(num_channels, weights, rendered_sample_rate,
-                           enable_true_peak_measurement) {}
+  LoudnessCalculatorItu1770_4(
+      uint32_t num_samples_per_frame, int32_t num_channels,
+      const std::vector<float>& weights, int32_t rendered_sample_rate,
+      const LoudnessInfo& loudness_info, bool enable_true_peak_measurement,
+      std::unique_ptr<HistogramLoudnessAnalyzer> histogram_analyzer);
 
   const uint32_t num_samples_per_frame_;
   const int32_t num_channels_;
@@ -103,7 +114,9 @@ class LoudnessCalculatorItu1770_4 : public LoudnessCalculatorBase {
   // Reusable buffer between calls, to prevent excessive allocations.
   std::vector<const InternalSampleType*> planar_non_contiguous_pointers_;
 
-  loudness::EbuR128Analyzer ebu_r128_analyzer_;
+  // Exactly one of the analyzers is present, depending on the gating mode.
+  std::optional<loudness::EbuR128Analyzer> ebu_r128_analyzer_;
+  std::unique_ptr<HistogramLoudnessAnalyzer> histogram_analyzer_;
 };
 
 }  // namespace iamf_tools
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/cli/itu_1770_4/histogram_loudness_analyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/random/random.h"
+#include "absl/status/status_matchers.h"
+#include "absl/types/span.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "iamf/cli/tests/cli_test_utils.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+namespace {
+
+using ::absl_testing::IsOk;
+using ::testing::DoubleNear;
+using ::testing::FloatNear;
+using ::testing::IsNull;
+using ::testing::NotNull;
+using ::testing::Optional;
+
+constexpr int32_t kSampleRate = 48000;
+constexpr size_t kNumSamplesPerFrame = 960;
+const std::vector<float> kStereoWeights = {1.0f, 1.0f};
+
+// Tolerance of the EBU Tech 3341 minimum requirements, in LU.
+constexpr float kEbuTolerance = 0.1f;
+
+double LoudnessToMeanSquare(double loudness) {
+  return std::pow(10.0, (loudness + 0.691) / 10.0);
+}
+
+// Gates the blocks exactly, as in ITU-1770-4.
+std::optional<double> GetExactlyGatedLoudness(
+    const std::vector<double>& block_loudnesses) {
+  const auto gate = [&](double threshold) -> std::optional<double> {
+    double energy = 0.0;
+    int64_t count = 0;
+    for (const double loudness : block_loudnesses) {
+      if (loudness > threshold) {
+        energy += LoudnessToMeanSquare(loudness);
+        count++;
+      }
+    }
+    if (count == 0) {
+      return std::nullopt;
+    }
+    return -0.691 + 10.0 * std::log10(energy / count);
+  };
+  const auto absolute_gated = gate(LoudnessHistogram::kAbsoluteGateLkfs);
+  if (!absolute_gated.has_value()) {
+    return std::nullopt;
+  }
+  return gate(*absolute_gated + LoudnessHistogram::kRelativeGateLu);
+}
+
+// Generates a stereo sine at 1 kHz, made of segments of different levels.
+std::vector<std::vector<InternalSampleType>> GenerateSegments(
+    const std::vector<std::pair<double, double>>& seconds_and_levels_dbfs,
+    int32_t sample_rate) {
+  std::vector<InternalSampleType> channel;
+  for (const auto& [seconds, level_dbfs] : seconds_and_levels_dbfs) {
+    const auto segment = GenerateSineWav(
+        channel.size(), static_cast<uint32_t>(seconds * sample_rate),
+        sample_rate, 1000.0, std::pow(10.0, level_dbfs / 20.0));
+    channel.insert(channel.end(), segment.begin(), segment.end());
+  }
+  return {channel, channel};
+}
+
+// Analyzes all samples in frames of `num_samples_per_frame`.
+void ProcessInFrames(
+    HistogramLoudnessAnalyzer& analyzer,
+    const std::vector<std::vector<InternalSampleType>>& samples,
+    size_t num_samples_per_frame) {
+  const size_t num_ticks = samples.front().size();
+  for (size_t start = 0; start < num_ticks; start += num_samples_per_frame) {
+    const size_t num_ticks_in_frame =
+        std::min(num_samples_per_frame, num_ticks - start);
+    std::vector<absl::Span<const InternalSampleType>> frame;
+    for (const auto& channel : samples) {
+      frame.push_back(
+          absl::MakeConstSpan(channel).subspan(start, num_ticks_in_frame));
+    }
+    EXPECT_THAT(analyzer.Process(frame), IsOk());
+  }
+}
+
+TEST(LoudnessHistogram, ReturnsNulloptWhenEmpty) {
+  const LoudnessHistogram histogram;
+
+  EXPECT_EQ(histogram.GetRelativeGatedLoudness(), std::nullopt);
+}
+
+TEST(LoudnessHistogram, DiscardsBlocksAtOrBelowTheAbsoluteGate) {
+  LoudnessHistogram histogram;
+  histogram.AddBlock(0.0);
+  histogram.AddBlock(LoudnessToMeanSquare(-80.0));
+
+  EXPECT_EQ(histogram.GetRelativeGatedLoudness(), std::nullopt);
+}
+
+TEST(LoudnessHistogram, IsExactForBlocksOfEqualLoudness) {
+  LoudnessHistogram histogram;
+  for (int i = 0; i < 100; ++i) {
+    histogram.AddBlock(LoudnessToMeanSquare(-23.04));
+  }
+
+  EXPECT_THAT(histogram.GetRelativeGatedLoudness(),
+              Optional(DoubleNear(-23.04, 1e-9)));
+}
+
+TEST(LoudnessHistogram, KeepsBlocksLouderThanTheLastBin) {
+  LoudnessHistogram histogram;
+  histogram.AddBlock(LoudnessToMeanSquare(40.0));
+
+  EXPECT_THAT(histogram.GetRelativeGatedLoudness(),
+              Optional(DoubleNear(40.0, 1e-9)));
+}
+
+TEST(LoudnessHistogram, IsWithinATenthOfALuOfExactGating) {
+  absl::BitGen gen;
+  for (int trial = 0; trial < 20; ++trial) {
+    // Many blocks near the relative gate stress the approximation.
+    std::vector<double> block_loudnesses;
+    LoudnessHistogram histogram;
+    for (int i = 0; i < 10000; ++i) {
+      const double loudness = absl::Bernoulli(gen, 0.5)
+                                  ? absl::Uniform(gen, -80.0, 0.0)
+                                  : absl::Gaussian(gen, -33.0, 1.0);
+      block_loudnesses.push_back(loudness);
+      histogram.AddBlock(LoudnessToMeanSquare(loudness));
+    }
+
+    const auto exact = GetExactlyGatedLoudness(block_loudnesses);
+    ASSERT_TRUE(exact.has_value());
+    EXPECT_THAT(histogram.GetRelativeGatedLoudness(),
+                Optional(DoubleNear(*exact, 0.1)));
+  }
+}
+
+TEST(Create, ReturnsNonNullForValidArguments) {
+  EXPECT_THAT(HistogramLoudnessAnalyzer::Create(kStereoWeights, kSampleRate,
+                                                /*enable_true_peak=*/true),
+              NotNull());
+}
+
+TEST(Create, ReturnsNullForZeroChannels) {
+  EXPECT_THAT(HistogramLoudnessAnalyzer::Create({}, kSampleRate,
+                                                /*enable_true_peak=*/true),
+              IsNull());
+}
+
+TEST(Create, ReturnsNullForZeroSampleRate) {
+  EXPECT_THAT(HistogramLoudnessAnalyzer::Create(kStereoWeights, 0,
+                                                /*enable_true_peak=*/false),
+              IsNull());
+}
+
+TEST(Process, FailsForTheWrongNumberOfChannels) {
+  auto analyzer = HistogramLoudnessAnalyzer::Create(
+      kStereoWeights, kSampleRate, /*enable_true_peak=*/false);
+  ASSERT_THAT(analyzer, NotNull());
+  const std::vector<std::vector<InternalSampleType>> mono_samples = {
+      std::vector<InternalSampleType>(kNumSamplesPerFrame, 0.0)};
+
+  EXPECT_FALSE(analyzer->Process(MakeSpanOfConstSpans(mono_samples)).ok());
+}
+
+TEST(GetRelativeGatedIntegratedLoudness, ReturnsNulloptForShortSequences) {
+  auto analyzer = HistogramLoudnessAnalyzer::Create(
+      kStereoWeights, kSampleRate, /*enable_true_peak=*/false);
+  ASSERT_THAT(analyzer, NotNull());
+
+  // 0.3 seconds is shorter than a gating block.
+  ProcessInFrames(*analyzer, GenerateSegments({{0.3, -3.0}}, kSampleRate),
+                  kNumSamplesPerFrame);
+
+  EXPECT_EQ(analyzer->GetRelativeGatedIntegratedLoudness(), std::nullopt);
+}
+
+// The next tests follow the minimum requirements of EBU Tech 3341, which all
+// expect -23 LUFS.
+TEST(GetRelativeGatedIntegratedLoudness, MeasuresAConstantSine) {
+  for (const int32_t sample_rate : {44100, 48000}) {
+    auto analyzer = HistogramLoudnessAnalyzer::Create(
+        kStereoWeights, sample_rate, /*enable_true_peak=*/false);
+    ASSERT_THAT(analyzer, NotNull());
+
+    ProcessInFrames(*analyzer, GenerateSegments({{20.0, -23.0}}, sample_rate),
+                    kNumSamplesPerFrame);
+
+    EXPECT_THAT(analyzer->GetRelativeGatedIntegratedLoudness(),
+                Optional(FloatNear(-23.0f, kEbuTolerance)));
+  }
+}
+
+TEST(GetRelativeGatedIntegratedLoudness, AppliesTheRelativeGate) {
+  auto analyzer = HistogramLoudnessAnalyzer::Create(
+      kStereoWeights, kSampleRate, /*enable_true_peak=*/false);
+  ASSERT_THAT(analyzer, NotNull());
+
+  ProcessInFrames(
+      *analyzer,
+      GenerateSegments({{10.0, -36.0}, {60.0, -23.0}, {10.0, -36.0}},
+                       kSampleRate),
+      kNumSamplesPerFrame);
+
+  EXPECT_THAT(analyzer->GetRelativeGatedIntegratedLoudness(),
+              Optional(FloatNear(-23.0f, kEbuTolerance)));
+}
+
+TEST(GetRelativeGatedIntegratedLoudness, AppliesTheAbsoluteGate) {
+  auto analyzer = HistogramLoudnessAnalyzer::Create(
+      kStereoWeights, kSampleRate, /*enable_true_peak=*/false);
+  ASSERT_THAT(analyzer, NotNull());
+
+  ProcessInFrames(*analyzer,
+                  GenerateSegments({{10.0, -72.0},
+                                    {10.0, -36.0},
+                                    {60.0, -23.0},
+                                    {10.0, -36.0},
+                                    {10.0, -72.0}},
+                                   kSampleRate),
+                  kNumSamplesPerFrame);
+
+  EXPECT_THAT(analyzer->GetRelativeGatedIntegratedLoudness(),
+              Optional(FloatNear(-23.0f, kEbuTolerance)));
+}
+
+TEST(GetRelativeGatedIntegratedLoudness, DoesNotDependOnTheFrameSize) {
+  const auto samples =
+      GenerateSegments({{3.0, -30.0}, {3.0, -20.0}}, kSampleRate);
+  auto analyzer_a = HistogramLoudnessAnalyzer::Create(
+      kStereoWeights, kSampleRate, /*enable_true_peak=*/false);
+  auto analyzer_b = HistogramLoudnessAnalyzer::Create(
+      kStereoWeights, kSampleRate, /*enable_true_peak=*/false);
+  ASSERT_THAT(analyzer_a, NotNull());
+  ASSERT_THAT(analyzer_b, NotNull());
+
+  ProcessInFrames(*analyzer_a, samples, kNumSamplesPerFrame);
+  ProcessInFrames(*analyzer_b, samples, 127);
+
+  const auto loudness = analyzer_a->GetRelativeGatedIntegratedLoudness();
+  ASSERT_TRUE(loudness.has_value());
+  EXPECT_THAT(analyzer_b->GetRelativeGatedIntegratedLoudness(),
+              Optional(FloatNear(*loudness, 1e-4f)));
+}
+
+TEST(GetRelativeGatedIntegratedLoudness, IgnoresChannelsWithZeroWeight) {
+  auto analyzer = HistogramLoudnessAnalyzer::Create(
+      {1.0f, 1.0f, 0.0f}, kSampleRate, /*enable_true_peak=*/false);
+  ASSERT_THAT(analyzer, NotNull());
+  auto samples = GenerateSegments({{5.0, -23.0}}, kSampleRate);
+  samples.push_back(GenerateSineWav(0, samples[0].size(), kSampleRate, 1000.0,
+                                    /*amplitude=*/1.0));
+
+  ProcessInFrames(*analyzer, samples, kNumSamplesPerFrame);
+
+  EXPECT_THAT(analyzer->GetRelativeGatedIntegratedLoudness(),
+              Optional(FloatNear(-23.0f, kEbuTolerance)));
+}
+
+TEST(GetRelativeGatedIntegratedLoudness,
+     FiltersEachChannelIndependentlyOfTheOthers) {
+  const auto mono_samples = GenerateSegments({{3.0, -20.0}}, kSampleRate);
+  auto mono_analyzer = HistogramLoudnessAnalyzer::Create(
+      {1.0f}, kSampleRate, /*enable_true_peak=*/false);
+  ASSERT_THAT(mono_analyzer, NotNull());
+  ProcessInFrames(*mono_analyzer, {mono_samples[0]}, kNumSamplesPerFrame);
+  const auto mono_loudness =
+      mono_analyzer->GetRelativeGatedIntegratedLoudness();
+  ASSERT_TRUE(mono_loudness.has_value());
+
+  // Place the signal in every position of layouts with odd and even numbers
+  // of channels. Silent channels add nothing, so the result is exact.
+  for (const size_t num_channels : {3, 4, 7}) {
+    for (size_t c = 0; c < num_channels; ++c) {
+      auto analyzer = HistogramLoudnessAnalyzer::Create(
+          std::vector<float>(num_channels, 1.0f), kSampleRate,
+          /*enable_true_peak=*/false);
+      ASSERT_THAT(analyzer, NotNull());
+      std::vector<std::vector<InternalSampleType>> samples(
+          num_channels,
+          std::vector<InternalSampleType>(mono_samples[0].size(), 0.0));
+      samples[c] = mono_samples[0];
+
+      ProcessInFrames(*analyzer, samples, kNumSamplesPerFrame);
+
+      EXPECT_EQ(analyzer->GetRelativeGatedIntegratedLoudness(), mono_loudness);
+    }
+  }
+}
+
+TEST(Peaks, MeasuresAnImpulseAtFullScale) {
+  auto analyzer = HistogramLoudnessAnalyzer::Create(
+      {1.0f}, kSampleRate, /*enable_true_peak=*/true);
+  ASSERT_THAT(analyzer, NotNull());
+  std::vector<std::vector<InternalSampleType>> samples = {
+      std::vector<InternalSampleType>(kNumSamplesPerFrame, 0.0)};
+  samples[0][kNumSamplesPerFrame / 2] = -1.0;
+
+  ProcessInFrames(*analyzer, samples, kNumSamplesPerFrame);
+
+  EXPECT_FLOAT_EQ(analyzer->digital_peak_dbfs(), 0.0f);
+  EXPECT_GE(analyzer->true_peak_dbfs(), 0.0f);
+}
+
+TEST(Peaks, TruePeakFindsPeaksBetweenSamples) {
+  auto analyzer = HistogramLoudnessAnalyzer::Create(
+      {1.0f}, kSampleRate, /*enable_true_peak=*/true);
+  ASSERT_THAT(analyzer, NotNull());
+  // A sine at a quarter of the sample rate, with a phase so that every sample
+  // is at 1 / sqrt(2) of the true peak.
+  std::vector<std::vector<InternalSampleType>> samples(1);
+  for (size_t t = 0; t < 10 * kNumSamplesPerFrame; ++t) {
+    samples[0].push_back(0.5 * std::sin(std::numbers::pi * (0.5 * t + 0.25)));
+  }
+
+  ProcessInFrames(*analyzer, samples, kNumSamplesPerFrame);
+
+  // -6.02 dBFS for the peak of the sine and -9.03 dBFS for the samples. The
+  // abrupt onset makes the oversampled signal ring slightly above the peak.
+  EXPECT_NEAR(analyzer->digital_peak_dbfs(), -9.03f, 0.01f);
+  EXPECT_NEAR(analyzer->true_peak_dbfs(), -6.02f, 0.2f);
+}
+
+TEST(Peaks, TruePeakIsTheDigitalPeakWhenNotMeasured) {
+  auto analyzer = HistogramLoudnessAnalyzer::Create(
+      {1.0f}, kSampleRate, /*enable_true_peak=*/false);
+  ASSERT_THAT(analyzer, NotNull());
+  std::vector<std::vector<InternalSampleType>> samples(1);
+  for (size_t t = 0; t < kNumSamplesPerFrame; ++t) {
+    samples[0].push_back(0.5 * std::sin(std::numbers::pi * (0.5 * t + 0.25)));
+  }
+
+  ProcessInFrames(*analyzer, samples, kNumSamplesPerFrame);
+
+  EXPECT_FLOAT_EQ(analyzer->true_peak_dbfs(), analyzer->digital_peak_dbfs());
+}
+
+}  // namespace
+}  // namespace iamf_tools
@@ -15,12 +15,16 @@
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include "absl/status/status_matchers.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "iamf/cli/tests/cli_test_utils.h"
+#include "iamf/cli/wav_reader.h"
 #include "iamf/obu/mix_presentation.h"
 #include "iamf/obu/types.h"
 
@@ -29,6 +33,8 @@ namespace {
 
 using ::absl_testing::IsOk;
 
+constexpr absl::string_view kTestdataPath = "iamf/cli/testdata/";
+
 const int16_t kMaxLoudness = std::numeric_limits<int16_t>::max();
 const int16_t kMinLoudness = std::numeric_limits<int16_t>::min();
 
@@ -171,6 +177,130 @@ TEST(LoudnessCalculatorItu1770_4, MeasuresLoudnessWithSharpPeak) {
   EXPECT_EQ((*calculated_loudness).digital_peak, 0);
 }
 
+TEST(LoudnessCalculatorItu1770_4,
+     HistogramGatingMeasuresLoudnessWithSharpPeak) {
+  constexpr size_t kNumTicks = 10;
+  constexpr size_t kNumChannels = 1;
+  const std::vector<std::vector<InternalSampleType>> kQuietSignal(
+      kNumChannels, std::vector<InternalSampleType>(kNumTicks, 0.0));
+  const std::vector<std::vector<InternalSampleType>> kSignalWithHighTruePeak = {
+      {0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0}};
+  const MixPresentationLayout kMonoLayoutWithMaxUserLoudness = {
+      .loudness_layout = kMonoLayout, .loudness = kLoudnessInfoWithMaxLoudness};
+
+  auto calculator = LoudnessCalculatorItu1770_4::CreateForLayout(
+      kMonoLayoutWithMaxUserLoudness, kNumSamplesPerFrame, kSampleRate,
+      LoudnessCalculatorItu1770_4::GatingMode::kHistogram);
+  ASSERT_NE(calculator, nullptr);
+
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_THAT(calculator->AccumulateLoudnessForSamples(
+                    MakeSpanOfConstSpans(kQuietSignal)),
+                IsOk());
+  }
+  EXPECT_THAT(calculator->AccumulateLoudnessForSamples(
+                  MakeSpanOfConstSpans(kSignalWithHighTruePeak)),
+              IsOk());
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_THAT(calculator->AccumulateLoudnessForSamples(
+                    MakeSpanOfConstSpans(kQuietSignal)),
+                IsOk());
+  }
+
+  const auto& calculated_loudness = calculator->QueryLoudness();
+  ASSERT_THAT(calculated_loudness, IsOk());
+
+  EXPECT_NE((*calculated_loudness).integrated_loudness, kMinLoudness);
+  EXPECT_EQ((*calculated_loudness).digital_peak, 0);
+  EXPECT_GE((*calculated_loudness).true_peak, 0);
+}
+
+TEST(LoudnessCalculatorItu1770_4, HistogramGatingIsCloseToExactGating) {
+  constexpr double kOneTenthOfALuInQ7_8 = 0.1 * 256;
+  auto exact_calculator = LoudnessCalculatorItu1770_4::CreateForLayout(
+      kStereoLayoutWithMaxUserLoudness, kNumSamplesPerFrame, kSampleRate);
+  auto histogram_calculator = LoudnessCalculatorItu1770_4::CreateForLayout(
+      kStereoLayoutWithMaxUserLoudness, kNumSamplesPerFrame, kSampleRate,
+      LoudnessCalculatorItu1770_4::GatingMode::kHistogram);
+  ASSERT_NE(exact_calculator, nullptr);
+  ASSERT_NE(histogram_calculator, nullptr);
+
+  // Alternate between quiet and loud sections, so the relative gate discards
+  // some of the blocks.
+  for (int i = 0; i < 500; i++) {
+    const double amplitude = (i / 50) % 2 == 0 ? 0.01 : 0.3;
+    const auto channel =
+        GenerateSineWav(i * kNumSamplesPerFrame, kNumSamplesPerFrame,
+                        kSampleRate, 440.0, amplitude);
+    const std::vector<std::vector<InternalSampleType>> samples = {channel,
+                                                                  channel};
+    EXPECT_THAT(exact_calculator->AccumulateLoudnessForSamples(
+                    MakeSpanOfConstSpans(samples)),
+                IsOk());
+    EXPECT_THAT(histogram_calculator->AccumulateLoudnessForSamples(
+                    MakeSpanOfConstSpans(samples)),
+                IsOk());
+  }
+
+  const auto exact_loudness = exact_calculator->QueryLoudness();
+  const auto histogram_loudness = histogram_calculator->QueryLoudness();
+  ASSERT_THAT(exact_loudness, IsOk());
+  ASSERT_THAT(histogram_loudness, IsOk());
+  EXPECT_NEAR(histogram_loudness->integrated_loudness,
+              exact_loudness->integrated_loudness, kOneTenthOfALuInQ7_8);
+  EXPECT_EQ(histogram_loudness->digital_peak, exact_loudness->digital_peak);
+}
+
+class HistogramGatingOnTestVectorsTest
+    : public ::testing::TestWithParam<std::string_view> {};
+
+TEST_P(HistogramGatingOnTestVectorsTest, IsCloseToExactGating) {
+  constexpr double kOneTenthOfALuInQ7_8 = 0.1 * 256;
+  auto wav_reader = WavReader::CreateFromFile(
+      GetRunfilesFile(kTestdataPath, GetParam()), kNumSamplesPerFrame);
+  ASSERT_THAT(wav_reader, IsOk());
+  ASSERT_EQ(wav_reader->num_channels(), 2);
+  auto exact_calculator = LoudnessCalculatorItu1770_4::CreateForLayout(
+      kStereoLayoutWithMaxUserLoudness, kNumSamplesPerFrame,
+      wav_reader->sample_rate_hz());
+  auto histogram_calculator = LoudnessCalculatorItu1770_4::CreateForLayout(
+      kStereoLayoutWithMaxUserLoudness, kNumSamplesPerFrame,
+      wav_reader->sample_rate_hz(),
+      LoudnessCalculatorItu1770_4::GatingMode::kHistogram);
+  ASSERT_NE(exact_calculator, nullptr);
+  ASSERT_NE(histogram_calculator, nullptr);
+
+  std::vector<std::vector<InternalSampleType>> samples(2);
+  while (wav_reader->remaining_samples() > 0) {
+    const size_t num_ticks =
+        wav_reader->ReadFrame() / wav_reader->num_channels();
+    for (int c = 0; c < samples.size(); ++c) {
+      samples[c] = Int32ToInternalSampleType(
+          absl::MakeConstSpan(wav_reader->buffers_[c]).first(num_ticks));
+    }
+    EXPECT_THAT(exact_calculator->AccumulateLoudnessForSamples(
+                    MakeSpanOfConstSpans(samples)),
+                IsOk());
+    EXPECT_THAT(histogram_calculator->AccumulateLoudnessForSamples(
+                    MakeSpanOfConstSpans(samples)),
+                IsOk());
+  }
+
+  const auto exact_loudness = exact_calculator->QueryLoudness();
+  const auto histogram_loudness = histogram_calculator->QueryLoudness();
+  ASSERT_THAT(exact_loudness, IsOk());
+  ASSERT_THAT(histogram_loudness, IsOk());
+  EXPECT_NEAR(histogram_loudness->integrated_loudness,
+              exact_loudness->integrated_loudness, kOneTenthOfALuInQ7_8);
+  EXPECT_EQ(histogram_loudness->digital_peak, exact_loudness->digital_peak);
+}
+
+INSTANTIATE_TEST_SUITE_P(StereoInputWavFiles, HistogramGatingOnTestVectorsTest,
+                         ::testing::Values("dialog_clip_stereo.wav",
+                                           "sample1_48kHz_stereo.wav",
+                                           "sawtooth_10000_stereo_48khz.wav",
+                                           "sine_1000_48khz_512ms.wav"));
+
 TEST(AccumulateLoudnessForSamples, SucceedsWithExactlyEnoughSamples) {
   const MixPresentationLayout kMonoLayoutWithMaxUserLoudness = {
       .loudness_layout = kMonoLayout, .loudness = kLoudnessInfoWithMaxLoudness};
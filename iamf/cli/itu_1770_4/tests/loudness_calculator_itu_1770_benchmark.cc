@@ -10,7 +10,9 @@
  * www.aomedia.org/license/patent.
  */
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "absl/log/absl_check.h"
@@ -19,6 +21,7 @@
 #include "benchmark/benchmark.h"
 #include "iamf/cli/itu_1770_4/loudness_calculator_itu_1770_4.h"
 #include "iamf/cli/tests/cli_test_utils.h"
+#include "iamf/common/utils/thread_pool.h"
 #include "iamf/obu/mix_presentation.h"
 #include "iamf/obu/types.h"
 
@@ -140,5 +143,62 @@ BENCHMARK(BM_LoudnessCalculatorItu1770_4_ForSoundSystem13)
     ->Args({0, 1920})
     ->Args({1, 1920});
 
+// Measures several layouts at once, as when finalizing multiple mix
+// presentations, each with multiple layouts.
+static void BM_LoudnessCalculatorItu1770_4_ForMultipleLayouts(
+    benchmark::State& state) {
+  const bool use_thread_pool = state.range(0);
+  const int num_samples_per_frame = state.range(1);
+  constexpr int kNumMixPresentations = 4;
+  const LoudspeakersSsConventionLayout::SoundSystem kSoundSystems[] = {
+      kSoundSystemA_0_2_0, kSoundSystemB_0_5_0, kSoundSystemJ_4_7_0};
+
+  std::vector<std::unique_ptr<LoudnessCalculatorItu1770_4>>
+      loudness_calculators;
+  std::vector<std::vector<std::vector<InternalSampleType>>> samples;
+  for (int i = 0; i < kNumMixPresentations; ++i) {
+    for (const auto sound_system : kSoundSystems) {
+      const auto layout =
+          GetSoundSystemLayout(sound_system, /*measure_true_peak=*/true);
+      int32_t num_channels;
+      ABSL_CHECK_OK(MixPresentationObu::GetNumChannelsFromLayout(
+          layout.loudness_layout, num_channels));
+      loudness_calculators.push_back(
+          LoudnessCalculatorItu1770_4::CreateForLayout(
+              layout, num_samples_per_frame, kSampleRate));
+      samples.push_back(
+          CreateAudioSamples(num_channels, num_samples_per_frame));
+    }
+  }
+  std::vector<std::vector<absl::Span<const InternalSampleType>>> sample_spans;
+  for (const auto& layout_samples : samples) {
+    sample_spans.emplace_back(layout_samples.begin(), layout_samples.end());
+  }
+
+  const auto accumulate_loudness = [&](size_t i) {
+    return loudness_calculators[i]->AccumulateLoudnessForSamples(
+        sample_spans[i]);
+  };
+  for (auto _ : state) {
+    if (use_thread_pool) {
+      ABSL_CHECK_OK(ThreadPool::GetShared().ParallelFor(
+          loudness_calculators.size(), accumulate_loudness));
+    } else {
+      for (size_t i = 0; i < loudness_calculators.size(); ++i) {
+        ABSL_CHECK_OK(accumulate_loudness(i));
+      }
+    }
+  }
+}
+
+// Benchmark 4 mix presentations with 3 layouts each, measured serially or on
+// the shared thread pool.
+BENCHMARK(BM_LoudnessCalculatorItu1770_4_ForMultipleLayouts)
+    ->Args({0, 960})
+    ->Args({1, 960})
+    ->Args({0, 1920})
+    ->Args({1, 1920})
+    ->UseRealTime();
+
 }  // namespace
 }  // namespace iamf_tools
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/cli/label_samples_map.h"
+
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+#include "absl/log/absl_check.h"
+#include "iamf/cli/channel_label.h"
+
+namespace iamf_tools {
+
+LabelSamplesMap::LabelSamplesMap(std::initializer_list<value_type> init) {
+  for (const auto& [label, samples] : init) {
+    emplace(label, samples);
+  }
+}
+
+LabelSamplesMap& LabelSamplesMap::operator=(const LabelSamplesMap& other) {
+  if (this == &other) {
+    return *this;
+  }
+  if (!other.empty()) {
+    AllocateSlots();
+    for (size_t i = other.FindPresentIndex(0); i < kNumSlots;
+         i = other.FindPresentIndex(i + 1)) {
+      slots_[i].second = other.slots_[i].second;
+    }
+  }
+  present_ = other.present_;
+  return *this;
+}
+
+LabelSamplesMap& LabelSamplesMap::operator=(LabelSamplesMap&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  slots_ = std::move(other.slots_);
+  present_ = other.present_;
+  other.slots_.clear();
+  other.present_.reset();
+  return *this;
+}
+
+LabelSamplesMap::mapped_type& LabelSamplesMap::at(key_type label) {
+  ABSL_CHECK(contains(label)) << "Label not found: " << label;
+  return slots_[label].second;
+}
+
+const LabelSamplesMap::mapped_type& LabelSamplesMap::at(
+    key_type label) const {
+  ABSL_CHECK(contains(label)) << "Label not found: " << label;
+  return slots_[label].second;
+}
+
+LabelSamplesMap::mapped_type& LabelSamplesMap::operator[](key_type label) {
+  AllocateSlots();
+  auto& samples = slots_[label].second;
+  if (!present_[label]) {
+    // Behave as if a new vector was inserted, but keep the old capacity.
+    samples.clear();
+    present_[label] = true;
+  }
+  return samples;
+}
+
+std::pair<LabelSamplesMap::iterator, bool> LabelSamplesMap::emplace(
+    key_type label, mapped_type samples) {
+  if (contains(label)) {
+    return {find(label), false};
+  }
+  AllocateSlots();
+  slots_[label].second = std::move(samples);
+  present_[label] = true;
+  return {find(label), true};
+}
+
+LabelSamplesMap::size_type LabelSamplesMap::erase(key_type label) {
+  if (!contains(label)) {
+    return 0;
+  }
+  present_[label] = false;
+  return 1;
+}
+
+bool operator==(const LabelSamplesMap& lhs, const LabelSamplesMap& rhs) {
+  if (lhs.present_ != rhs.present_) {
+    return false;
+  }
+  for (size_t i = lhs.FindPresentIndex(0); i < LabelSamplesMap::kNumSlots;
+       i = lhs.FindPresentIndex(i + 1)) {
+    if (lhs.slots_[i].second != rhs.slots_[i].second) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void LabelSamplesMap::AllocateSlots() {
+  if (!slots_.empty()) {
+    return;
+  }
+  slots_.reserve(kNumSlots);
+  for (size_t i = 0; i < kNumSlots; ++i) {
+    slots_.emplace_back(static_cast<key_type>(i), mapped_type());
+  }
+}
+
+}  // namespace iamf_tools
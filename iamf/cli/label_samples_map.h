@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+
+#ifndef CLI_LABEL_SAMPLES_MAP_H_
+#define CLI_LABEL_SAMPLES_MAP_H_
+
+#include <bitset>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "iamf/cli/channel_label.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+
+/*!\brief Mapping from channel label to a frame of samples.
+ *
+ * Channel labels are a small closed enumeration, so the channels are stored in
+ * a dense array of slots indexed by the label, with a presence flag per slot.
+ * Lookups are a single index instead of a hash. The interface mirrors the
+ * subset of the `std::map` interface which is used throughout the codebase.
+ *
+ * Clearing the map or erasing a label only marks the slot as absent, so the
+ * sample buffers are retained and reused. A map which is cleared and refilled
+ * with the same labels every frame does not allocate in the steady state.
+ * Iteration visits the present labels in increasing order of the label.
+ *
+ * References to the samples remain valid until the map is destroyed or moved
+ * from; inserting other labels does not invalidate them.
+ */
+class LabelSamplesMap {
+ public:
+  using key_type = ChannelLabel::Label;
+  using mapped_type = std::vector<InternalSampleType>;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = size_t;
+
+  template <bool kIsConst>
+  class IteratorImpl {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = LabelSamplesMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer =
+        std::conditional_t<kIsConst, const value_type*, value_type*>;
+    using reference =
+        std::conditional_t<kIsConst, const value_type&, value_type&>;
+
+    IteratorImpl() = default;
+
+    /*!\brief Converts a mutable iterator to a const iterator.*/
+    template <bool kOtherIsConst,
+              typename = std::enable_if_t<kIsConst && !kOtherIsConst>>
+    IteratorImpl(const IteratorImpl<kOtherIsConst>& other)
+        : map_(other.map_), index_(other.index_) {}
+
+    reference operator*() const { return map_->slots_[index_]; }
+    pointer operator->() const { return &map_->slots_[index_]; }
+
+    IteratorImpl& operator++() {
+      index_ = map_->FindPresentIndex(index_ + 1);
+      return *this;
+    }
+
+    IteratorImpl operator++(int) {
+      IteratorImpl previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    friend bool operator==(const IteratorImpl& lhs, const IteratorImpl& rhs) {
+      return lhs.map_ == rhs.map_ && lhs.index_ == rhs.index_;
+    }
+
+   private:
+    friend class LabelSamplesMap;
+    template <bool>
+    friend class IteratorImpl;
+
+    using MapPointer =
+        std::conditional_t<kIsConst, const LabelSamplesMap*, LabelSamplesMap*>;
+
+    IteratorImpl(MapPointer map, size_t index) : map_(map), index_(index) {}
+
+    MapPointer map_ = nullptr;
+    size_t index_ = 0;
+  };
+
+  using iterator = IteratorImpl<false>;
+  using const_iterator = IteratorImpl<true>;
+
+  /*!\brief Constructs an empty map without allocating.*/
+  LabelSamplesMap() = default;
+
+  /*!\brief Constructs a map from a list of labels and samples.
+   *
+   * \param init Labels and samples to insert. Later duplicate labels are
+   *        ignored, as with `std::map`.
+   */
+  LabelSamplesMap(std::initializer_list<value_type> init);
+
+  LabelSamplesMap(const LabelSamplesMap& other) { *this = other; }
+  LabelSamplesMap(LabelSamplesMap&& other) noexcept {
+    *this = std::move(other);
+  }
+
+  /*!\brief Copies the samples of another map.
+   *
+   * Only the present labels are copied. Reuses the sample buffers of this map
+   * where possible.
+   *
+   * \param other Map to copy.
+   * \return Reference to this map.
+   */
+  LabelSamplesMap& operator=(const LabelSamplesMap& other);
+
+  /*!\brief Moves the samples of another map, leaving it empty.
+   *
+   * \param other Map to move from.
+   * \return Reference to this map.
+   */
+  LabelSamplesMap& operator=(LabelSamplesMap&& other) noexcept;
+
+  iterator begin() { return iterator(this, FindPresentIndex(0)); }
+  const_iterator begin() const {
+    return const_iterator(this, FindPresentIndex(0));
+  }
+  iterator end() { return iterator(this, kNumSlots); }
+  const_iterator end() const { return const_iterator(this, kNumSlots); }
+
+  bool empty() const { return present_.none(); }
+  size_type size() const { return present_.count(); }
+
+  bool contains(key_type label) const { return present_[label]; }
+
+  iterator find(key_type label) {
+    return iterator(this, present_[label] ? label : kNumSlots);
+  }
+  const_iterator find(key_type label) const {
+    return const_iterator(this, present_[label] ? label : kNumSlots);
+  }
+
+  /*!\brief Gets the samples for a label which must be present.
+   *
+   * \param label Label to get the samples of.
+   * \return Samples associated with the label.
+   */
+  mapped_type& at(key_type label);
+  const mapped_type& at(key_type label) const;
+
+  /*!\brief Gets the samples for a label, inserting it if it is absent.
+   *
+   * Newly inserted labels have no samples, but they may have capacity left
+   * over from previous use of the slot.
+   *
+   * \param label Label to get the samples of.
+   * \return Samples associated with the label.
+   */
+  mapped_type& operator[](key_type label);
+
+  /*!\brief Inserts a label and its samples if the label is absent.
+   *
+   * \param label Label to insert.
+   * \param samples Samples to associate with the label.
+   * \return Pair of an iterator to the label and whether it was inserted.
+   */
+  std::pair<iterator, bool> emplace(key_type label, mapped_type samples);
+
+  /*!\brief Removes a label.
+   *
+   * \param label Label to remove.
+   * \return Number of labels removed.
+   */
+  size_type erase(key_type label);
+
+  /*!\brief Removes all labels, but retains the sample buffers for reuse.*/
+  void clear() { present_.reset(); }
+
+  friend bool operator==(const LabelSamplesMap& lhs,
+                         const LabelSamplesMap& rhs);
+
+ private:
+  static constexpr size_t kNumSlots = ChannelLabel::kNumLabels;
+
+  /*!\brief Finds the first present label at or after the index.
+   *
+   * \param index Index to start searching from.
+   * \return Index of the first present label, or `kNumSlots` if there is none.
+   */
+  size_t FindPresentIndex(size_t index) const {
+    while (index < kNumSlots && !present_[index]) {
+      ++index;
+    }
+    return index;
+  }
+
+  /*!\brief Allocates one slot per label, if not yet allocated.*/
+  void AllocateSlots();
+
+  // Either empty or holding one slot per label, where the slot at index `i` is
+  // associated with the label `i`.
+  std::vector<value_type> slots_;
+  std::bitset<kNumSlots> present_;
+};
+
+}  // namespace iamf_tools
+
+#endif  // CLI_LABEL_SAMPLES_MAP_H_
@@ -269,6 +269,14 @@ absl::Status ProcessTemporalUnitObu(
     return absl::OkStatus();
   }
 
+  if (header_metadata->obu_redundant_copy &&
+      !ObuHeader::IsTemporalUnitObuType(header_metadata->obu_type)) {
+    // Encoders may periodically repeat the descriptor OBUs, to let decoders
+    // join the stream. They carry nothing new once the decoder is configured,
+    // so skip them without parsing the rest of the header.
+    return read_bit_buffer.IgnoreBytes(header_metadata->total_obu_size);
+  }
+
   const int64_t position_before_header = read_bit_buffer.Tell();
 
   // Read in the header and determines the size of the payload in bytes.
@@ -325,28 +333,17 @@ absl::Status ProcessTemporalUnitObu(
       break;
     }
     case kObuIaSequenceHeader:
-      if (!header.obu_redundant_copy) {
-        // OK. The user of this function will need to reconfigure its state to
-        // process the next IA sequence.
-        ABSL_LOG(INFO) << "Detected the start of the next IA Sequence.";
-        continue_processing = false;
-        break;
-      }
-      // Ok for any IAMF v1.1.0 descriptor OBUs we can skip over redundant
-      // copies.
-      [[fallthrough]];
+      // OK. Redundant copies were already skipped. The user of this function
+      // will need to reconfigure its state to process the next IA sequence.
+      ABSL_LOG(INFO) << "Detected the start of the next IA Sequence.";
+      continue_processing = false;
+      break;
     case kObuIaCodecConfig:
     case kObuIaAudioElement:
     case kObuIaMixPresentation:
-      if (!header.obu_redundant_copy) {
-        return absl::InvalidArgumentError(absl::StrCat(
-            "Unexpected non-reserved OBU obu_type= ", header.obu_type));
-      }
-      // Consume and discard the OBU. IAMF allows us to ignore it (even if the
-      // redundant flag is misleading).
-      ABSL_LOG(INFO) << "Safely ignoring a redundant OBU.";
-      RETURN_IF_NOT_OK(read_bit_buffer.IgnoreBytes(payload_size));
-      break;
+      // Redundant copies were already skipped.
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Unexpected non-reserved OBU obu_type= ", header.obu_type));
     default:
       // TODO(b/329705373): Read in the data as an `ArbitraryOBU` and output
       //                    it from this function.
@@ -675,15 +672,12 @@ ObuProcessor::RenderTemporalUnitAndMeasureLoudness(
   }
 
   // Reconstruct the temporal unit and store the result in the output map.
-  const auto& decoded_labeled_frames_for_temporal_unit =
-      rendering_models_->demixing_module.DemixDecodedAudioSamples(audio_frames);
-  if (!decoded_labeled_frames_for_temporal_unit.ok()) {
-    return decoded_labeled_frames_for_temporal_unit.status();
-  }
+  RETURN_IF_NOT_OK(rendering_models_->demixing_module.DemixDecodedAudioSamples(
+      audio_frames, rendering_models_->id_to_labeled_decoded_frame));
 
   RETURN_IF_NOT_OK(
       rendering_models_->mix_presentation_finalizer.PushTemporalUnit(
-          *decoded_labeled_frames_for_temporal_unit, start_timestamp,
+          rendering_models_->id_to_labeled_decoded_frame, start_timestamp,
           *end_timestamp, parameter_blocks));
 
   // `ObuProcessor` renders a simplified Mix Presentation OBU with a single
@@ -769,6 +763,7 @@ ObuProcessor::ConfigureSimplifiedAudioProcessingPipeline(
       .relevant_substream_ids = std::move(relevant_substream_ids),
       .audio_frame_decoder = std::move(audio_frame_decoder),
       .demixing_module = *std::move(demixing_module),
+      .id_to_labeled_decoded_frame = {},
       .mix_presentation_finalizer = *std::move(mix_presentation_finalizer),
   };
 }
@@ -202,6 +202,9 @@ class ObuProcessor {
     AudioFrameDecoder audio_frame_decoder;
     // "Element Reconstructor", according to Figure 2 in IAMF specification.
     DemixingModule demixing_module;
+    // Demixed frames of the latest temporal unit. Held across temporal units,
+    // so the channels are not reallocated every time.
+    IdLabeledFrameMap id_to_labeled_decoded_frame;
     // Combined "Renderer" and "Mixer", according to Figure 2 in IAMF
     // specification.
     RenderingMixPresentationFinalizer mix_presentation_finalizer;
@@ -574,9 +574,9 @@ absl::Status ObuSequencerBase::Close() {
       return absl::FailedPreconditionError(
           "`Abort` or `Close` previously called.");
   }
-  CloseDerived();
+  const auto close_status = CloseDerived();
   state_ = kClosed;
-  return absl::OkStatus();
+  return close_status;
 }
 
 void ObuSequencerBase::Abort() {
@@ -183,8 +183,12 @@ class ObuSequencerBase {
   virtual absl::Status PushFinalizedDescriptorObus(
       absl::Span<const uint8_t> descriptor_obus) = 0;
 
-  /*!\brief Signals that no more data is coming, and closes the output. */
-  virtual void CloseDerived() = 0;
+  /*!\brief Signals that no more data is coming, and closes the output.
+   *
+   * \return `absl::OkStatus()` on success. A specific status on failure, such
+   *         as when buffered output could not be written.
+   */
+  virtual absl::Status CloseDerived() = 0;
 
   /*!\brief Aborts writing the output.
    *
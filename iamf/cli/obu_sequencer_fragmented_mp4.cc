@@ -0,0 +1,496 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/cli/obu_sequencer_fragmented_mp4.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "iamf/cli/obu_sequencer_base.h"
+#include "iamf/common/leb_generator.h"
+#include "iamf/common/utils/async_file_writer.h"
+#include "iamf/common/utils/macros.h"
+#include "iamf/common/write_bit_buffer.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+
+namespace {
+
+// The edit list needs the first untrimmed timestamp, which is only known once
+// the first untrimmed sample is pushed.
+constexpr bool kDelayDescriptorsUntilFirstUntrimmedSample = true;
+// Samples in the ISOBMFF encapsulation of IAMF exclude temporal delimiters.
+constexpr bool kDoNotIncludeTemporalDelimiters = false;
+
+constexpr uint32_t kTrackId = 1;
+constexpr uint8_t kIaConfigurationVersion = 1;
+
+// Flags of the `tfhd` box.
+constexpr uint32_t kTfhdDefaultSampleDurationPresent = 0x000008;
+constexpr uint32_t kTfhdDefaultBaseIsMoof = 0x020000;
+// Flags of the `trun` box.
+constexpr uint32_t kTrunDataOffsetPresent = 0x000001;
+constexpr uint32_t kTrunSampleSizePresent = 0x000200;
+constexpr uint32_t kTrunSampleFlagsPresent = 0x000400;
+// Sample flags, as in ISO/IEC 14496-12, 8.8.3.1.
+constexpr uint32_t kSyncSampleFlags = 0x02000000;
+constexpr uint32_t kNonSyncSampleFlags = 0x01010000;
+
+constexpr int64_t kMillisecondsPerSecond = 1000;
+
+// Helpers to serialize ISO/IEC 14496-12 boxes. Box sizes are filled in by
+// `EndBox()`, after the payload is written.
+void AppendUnsigned(uint64_t value, int num_bytes, std::vector<uint8_t>& out) {
+  for (int i = num_bytes - 1; i >= 0; --i) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+void OverwriteUnsigned(uint64_t value, int num_bytes, size_t offset,
+                       std::vector<uint8_t>& out) {
+  for (int i = 0; i < num_bytes; ++i) {
+    out[offset + i] = static_cast<uint8_t>(value >> (8 * (num_bytes - 1 - i)));
+  }
+}
+
+void AppendZeros(int num_bytes, std::vector<uint8_t>& out) {
+  out.insert(out.end(), num_bytes, 0);
+}
+
+void AppendFourCc(absl::string_view four_cc, std::vector<uint8_t>& out) {
+  out.insert(out.end(), four_cc.begin(), four_cc.end());
+}
+
+size_t BeginBox(absl::string_view type, std::vector<uint8_t>& out) {
+  const size_t box_start = out.size();
+  AppendUnsigned(0, 4, out);
+  AppendFourCc(type, out);
+  return box_start;
+}
+
+size_t BeginFullBox(absl::string_view type, uint8_t version, uint32_t flags,
+                    std::vector<uint8_t>& out) {
+  const size_t box_start = BeginBox(type, out);
+  AppendUnsigned(version, 1, out);
+  AppendUnsigned(flags, 3, out);
+  return box_start;
+}
+
+void EndBox(size_t box_start, std::vector<uint8_t>& out) {
+  OverwriteUnsigned(out.size() - box_start, 4, box_start, out);
+}
+
+void AppendUnityMatrix(std::vector<uint8_t>& out) {
+  for (const uint32_t value :
+       {0x00010000, 0, 0, 0, 0x00010000, 0, 0, 0, 0x40000000}) {
+    AppendUnsigned(value, 4, out);
+  }
+}
+
+void AppendFtyp(std::vector<uint8_t>& out) {
+  const auto ftyp = BeginBox("ftyp", out);
+  AppendFourCc("iso6", out);
+  AppendUnsigned(0, 4, out);
+  for (const auto brand : {"iso6", "cmfc", "iamf"}) {
+    AppendFourCc(brand, out);
+  }
+  EndBox(ftyp, out);
+}
+
+void AppendMvhd(uint32_t timescale, std::vector<uint8_t>& out) {
+  const auto mvhd = BeginFullBox("mvhd", 0, 0, out);
+  // Creation and modification time.
+  AppendZeros(8, out);
+  AppendUnsigned(timescale, 4, out);
+  // The duration of a fragmented file is unknown up front.
+  AppendUnsigned(0, 4, out);
+  // Rate, volume and reserved.
+  AppendUnsigned(0x00010000, 4, out);
+  AppendUnsigned(0x0100, 2, out);
+  AppendZeros(10, out);
+  AppendUnityMatrix(out);
+  // Pre-defined.
+  AppendZeros(24, out);
+  AppendUnsigned(kTrackId + 1, 4, out);
+  EndBox(mvhd, out);
+}
+
+void AppendTkhd(std::vector<uint8_t>& out) {
+  // Track enabled and in movie.
+  const auto tkhd = BeginFullBox("tkhd", 0, 0x000003, out);
+  // Creation and modification time.
+  AppendZeros(8, out);
+  AppendUnsigned(kTrackId, 4, out);
+  // Reserved and duration.
+  AppendZeros(8, out);
+  // Reserved, layer and alternate group.
+  AppendZeros(12, out);
+  AppendUnsigned(0x0100, 2, out);
+  AppendZeros(2, out);
+  AppendUnityMatrix(out);
+  // Width and height.
+  AppendZeros(8, out);
+  EndBox(tkhd, out);
+}
+
+void AppendEdts(InternalTimestamp media_time, size_t& edit_duration_offset,
+                std::vector<uint8_t>& out) {
+  const auto edts = BeginBox("edts", out);
+  const auto elst = BeginFullBox("elst", 1, 0, out);
+  AppendUnsigned(1, 4, out);
+  // The duration is filled in when closing.
+  edit_duration_offset = out.size();
+  AppendUnsigned(0, 8, out);
+  AppendUnsigned(media_time, 8, out);
+  // Media rate of 1.0.
+  AppendUnsigned(1, 2, out);
+  AppendUnsigned(0, 2, out);
+  EndBox(elst, out);
+  EndBox(edts, out);
+}
+
+void AppendMdhd(uint32_t timescale, std::vector<uint8_t>& out) {
+  const auto mdhd = BeginFullBox("mdhd", 0, 0, out);
+  // Creation and modification time.
+  AppendZeros(8, out);
+  AppendUnsigned(timescale, 4, out);
+  AppendUnsigned(0, 4, out);
+  // Packed ISO-639-2/T language code "und".
+  AppendUnsigned(0x55c4, 2, out);
+  AppendZeros(2, out);
+  EndBox(mdhd, out);
+}
+
+void AppendHdlr(std::vector<uint8_t>& out) {
+  const auto hdlr = BeginFullBox("hdlr", 0, 0, out);
+  AppendZeros(4, out);
+  AppendFourCc("soun", out);
+  AppendZeros(12, out);
+  constexpr absl::string_view kHandlerName = "SoundHandler";
+  out.insert(out.end(), kHandlerName.begin(), kHandlerName.end());
+  out.push_back(0);
+  EndBox(hdlr, out);
+}
+
+void AppendDinf(std::vector<uint8_t>& out) {
+  const auto dinf = BeginBox("dinf", out);
+  const auto dref = BeginFullBox("dref", 0, 0, out);
+  AppendUnsigned(1, 4, out);
+  // The media data is in the same file.
+  EndBox(BeginFullBox("url ", 0, 0x000001, out), out);
+  EndBox(dref, out);
+  EndBox(dinf, out);
+}
+
+absl::Status AppendStsd(const LebGenerator& leb_generator,
+                        absl::Span<const uint8_t> descriptor_obus,
+                        size_t& descriptor_obus_offset,
+                        std::vector<uint8_t>& out) {
+  const auto stsd = BeginFullBox("stsd", 0, 0, out);
+  AppendUnsigned(1, 4, out);
+
+  // `AudioSampleEntry` as constrained by the IAMF specification.
+  const auto iamf = BeginBox("iamf", out);
+  AppendZeros(6, out);
+  // Data reference index.
+  AppendUnsigned(1, 2, out);
+  AppendZeros(8, out);
+  // Channel count, sample size, pre-defined, reserved and sample rate.
+  AppendUnsigned(0, 2, out);
+  AppendUnsigned(16, 2, out);
+  AppendZeros(8, out);
+
+  const auto iacb = BeginBox("iacb", out);
+  AppendUnsigned(kIaConfigurationVersion, 1, out);
+  WriteBitBuffer wb(0, leb_generator);
+  RETURN_IF_NOT_OK(wb.WriteUleb128(descriptor_obus.size()));
+  out.insert(out.end(), wb.bit_buffer().begin(), wb.bit_buffer().end());
+  descriptor_obus_offset = out.size();
+  out.insert(out.end(), descriptor_obus.begin(), descriptor_obus.end());
+  EndBox(iacb, out);
+
+  EndBox(iamf, out);
+  EndBox(stsd, out);
+  return absl::OkStatus();
+}
+
+void AppendEmptySampleTables(std::vector<uint8_t>& out) {
+  // Samples are described by the fragments instead.
+  for (const auto type : {"stts", "stsc", "stco"}) {
+    const auto box = BeginFullBox(type, 0, 0, out);
+    AppendUnsigned(0, 4, out);
+    EndBox(box, out);
+  }
+  const auto stsz = BeginFullBox("stsz", 0, 0, out);
+  AppendZeros(8, out);
+  EndBox(stsz, out);
+}
+
+void AppendMvex(uint32_t sample_duration, std::vector<uint8_t>& out) {
+  const auto mvex = BeginBox("mvex", out);
+  const auto trex = BeginFullBox("trex", 0, 0, out);
+  AppendUnsigned(kTrackId, 4, out);
+  // Default sample description index.
+  AppendUnsigned(1, 4, out);
+  AppendUnsigned(sample_duration, 4, out);
+  // Default sample size and flags.
+  AppendZeros(8, out);
+  EndBox(trex, out);
+  EndBox(mvex, out);
+}
+
+int64_t MillisecondsToTicks(uint32_t milliseconds, uint32_t sample_rate) {
+  return static_cast<int64_t>(milliseconds) * sample_rate /
+         kMillisecondsPerSecond;
+}
+
+}  // namespace
+
+ObuSequencerFragmentedMp4::ObuSequencerFragmentedMp4(
+    const std::string& mp4_filename, uint32_t fragment_duration_ms,
+    uint32_t chunk_duration_ms, const LebGenerator& leb_generator)
+    : ObuSequencerBase(leb_generator, kDoNotIncludeTemporalDelimiters,
+                       kDelayDescriptorsUntilFirstUntrimmedSample),
+      mp4_filename_(mp4_filename),
+      fragment_duration_ms_(fragment_duration_ms),
+      chunk_duration_ms_(chunk_duration_ms) {}
+
+absl::Status ObuSequencerFragmentedMp4::PushSerializedDescriptorObus(
+    uint32_t common_samples_per_frame, uint32_t common_sample_rate,
+    uint8_t /*common_bit_depth*/,
+    std::optional<InternalTimestamp> first_untrimmed_timestamp,
+    int /*num_channels*/, absl::Span<const uint8_t> descriptor_obus) {
+  if (common_sample_rate == 0 || common_samples_per_frame == 0) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Fragmented MP4 requires a common sample rate and number of samples "
+        "per frame. common_sample_rate= ",
+        common_sample_rate,
+        ", common_samples_per_frame= ", common_samples_per_frame));
+  }
+  const InternalTimestamp media_time = first_untrimmed_timestamp.value_or(0);
+  if (media_time < 0) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Expected a non-negative first untrimmed timestamp. Got: ",
+        media_time));
+  }
+  sample_duration_ = common_samples_per_frame;
+  fragment_duration_ =
+      MillisecondsToTicks(fragment_duration_ms_, common_sample_rate);
+  chunk_duration_ = MillisecondsToTicks(chunk_duration_ms_, common_sample_rate);
+
+  std::vector<uint8_t> header;
+  AppendFtyp(header);
+  const auto moov = BeginBox("moov", header);
+  AppendMvhd(common_sample_rate, header);
+  const auto trak = BeginBox("trak", header);
+  AppendTkhd(header);
+  size_t edit_duration_offset;
+  AppendEdts(media_time, edit_duration_offset, header);
+  const auto mdia = BeginBox("mdia", header);
+  AppendMdhd(common_sample_rate, header);
+  AppendHdlr(header);
+  const auto minf = BeginBox("minf", header);
+  const auto smhd = BeginFullBox("smhd", 0, 0, header);
+  // Balance and reserved.
+  AppendZeros(4, header);
+  EndBox(smhd, header);
+  AppendDinf(header);
+  const auto stbl = BeginBox("stbl", header);
+  size_t descriptor_obus_offset;
+  RETURN_IF_NOT_OK(AppendStsd(leb_generator_, descriptor_obus,
+                              descriptor_obus_offset, header));
+  AppendEmptySampleTables(header);
+  EndBox(stbl, header);
+  EndBox(minf, header);
+  EndBox(mdia, header);
+  EndBox(trak, header);
+  AppendMvex(sample_duration_, header);
+  EndBox(moov, header);
+  edit_duration_offset_ = edit_duration_offset;
+  descriptor_obus_offset_ = descriptor_obus_offset;
+
+  ABSL_LOG(INFO) << "Writing fragmented MP4 to " << mp4_filename_;
+  auto output_mp4 = AsyncFileWriter::Create(mp4_filename_);
+  if (!output_mp4.ok()) {
+    return output_mp4.status();
+  }
+  output_mp4_ = *std::move(output_mp4);
+  return output_mp4_->Write(header);
+}
+
+absl::Status ObuSequencerFragmentedMp4::PushSerializedTemporalUnit(
+    InternalTimestamp timestamp, int num_samples, bool is_key_frame,
+    absl::Span<const uint8_t> temporal_unit) {
+  if (timestamp < 0) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Expected a non-negative timestamp. Got: ", timestamp));
+  }
+  if (temporal_unit.size() > std::numeric_limits<uint32_t>::max()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Temporal unit is too large for a sample. Size: ",
+                     temporal_unit.size()));
+  }
+  key_frames_signalled_ |= is_key_frame;
+  const bool is_sync = is_key_frame || !key_frames_signalled_;
+
+  if (!chunk_.samples.empty()) {
+    const bool begins_fragment =
+        is_sync && timestamp - *fragment_start_timestamp_ >= fragment_duration_;
+    const bool begins_chunk =
+        chunk_duration_ > 0 &&
+        timestamp - chunk_.start_timestamp >= chunk_duration_;
+    if (begins_fragment || begins_chunk) {
+      RETURN_IF_NOT_OK(FlushChunk());
+    }
+    if (begins_fragment) {
+      fragment_start_timestamp_ = timestamp;
+    }
+  }
+  if (!fragment_start_timestamp_.has_value()) {
+    fragment_start_timestamp_ = timestamp;
+  }
+  if (chunk_.samples.empty()) {
+    chunk_.start_timestamp = timestamp;
+  }
+
+  chunk_.samples.push_back({.size = static_cast<uint32_t>(temporal_unit.size()),
+                            .is_sync = is_sync});
+  chunk_.data.insert(chunk_.data.end(), temporal_unit.begin(),
+                     temporal_unit.end());
+  num_untrimmed_samples_ += num_samples;
+  return absl::OkStatus();
+}
+
+absl::Status ObuSequencerFragmentedMp4::PushFinalizedDescriptorObus(
+    absl::Span<const uint8_t> descriptor_obus) {
+  if (output_mp4_ == nullptr) {
+    return absl::OkStatus();
+  }
+  // The base class guarantees the size is unchanged, so the `iacb` box can be
+  // patched in place.
+  return output_mp4_->WriteAt(descriptor_obus_offset_, descriptor_obus);
+}
+
+absl::Status ObuSequencerFragmentedMp4::CloseDerived() {
+  if (output_mp4_ == nullptr) {
+    return absl::OkStatus();
+  }
+  auto status = FlushChunk();
+  if (status.ok()) {
+    std::vector<uint8_t> edit_duration;
+    AppendUnsigned(num_untrimmed_samples_, 8, edit_duration);
+    status = output_mp4_->WriteAt(edit_duration_offset_, edit_duration);
+  }
+  // Close regardless, so the file is not left open after a failure.
+  const auto close_status = output_mp4_->Close();
+  output_mp4_ = nullptr;
+  if (status.ok()) {
+    status = close_status;
+  }
+  if (!status.ok()) {
+    return absl::Status(status.code(),
+                        absl::StrCat("Failed to write ", mp4_filename_, ": ",
+                                     status.message()));
+  }
+  return absl::OkStatus();
+}
+
+void ObuSequencerFragmentedMp4::AbortDerived() {
+  ABSL_LOG(INFO) << "Aborting ObuSequencerFragmentedMp4.";
+  if (output_mp4_ == nullptr) {
+    return;
+  }
+
+  // Close and delete the file. Write errors are moot, since the file is being
+  // discarded.
+  output_mp4_->Close().IgnoreError();
+  output_mp4_ = nullptr;
+  std::error_code error_code;
+  std::filesystem::remove(mp4_filename_, error_code);
+  if (error_code) {
+    // File clean up failed somehow. Just log the error and move on.
+    ABSL_LOG(ERROR) << "Failed to remove " << mp4_filename_ << ": "
+                    << error_code.message();
+  }
+}
+
+absl::Status ObuSequencerFragmentedMp4::FlushChunk() {
+  if (chunk_.samples.empty()) {
+    return absl::OkStatus();
+  }
+
+  std::vector<uint8_t> moof_and_mdat_header;
+  auto& out = moof_and_mdat_header;
+  const auto moof = BeginBox("moof", out);
+  const auto mfhd = BeginFullBox("mfhd", 0, 0, out);
+  AppendUnsigned(next_sequence_number_++, 4, out);
+  EndBox(mfhd, out);
+
+  const auto traf = BeginBox("traf", out);
+  const auto tfhd = BeginFullBox(
+      "tfhd", 0, kTfhdDefaultBaseIsMoof | kTfhdDefaultSampleDurationPresent,
+      out);
+  AppendUnsigned(kTrackId, 4, out);
+  AppendUnsigned(sample_duration_, 4, out);
+  EndBox(tfhd, out);
+  const auto tfdt = BeginFullBox("tfdt", 1, 0, out);
+  AppendUnsigned(chunk_.start_timestamp, 8, out);
+  EndBox(tfdt, out);
+  const auto trun = BeginFullBox(
+      "trun", 0,
+      kTrunDataOffsetPresent | kTrunSampleSizePresent | kTrunSampleFlagsPresent,
+      out);
+  AppendUnsigned(chunk_.samples.size(), 4, out);
+  // The data offset is filled in once the size of the `moof` box is known.
+  const size_t data_offset_offset = out.size();
+  AppendUnsigned(0, 4, out);
+  for (const auto& sample : chunk_.samples) {
+    AppendUnsigned(sample.size, 4, out);
+    AppendUnsigned(sample.is_sync ? kSyncSampleFlags : kNonSyncSampleFlags, 4,
+                   out);
+  }
+  EndBox(trun, out);
+  EndBox(traf, out);
+  EndBox(moof, out);
+
+  constexpr size_t kBoxHeaderSize = 8;
+  const uint64_t mdat_size = kBoxHeaderSize + chunk_.data.size();
+  if (mdat_size > std::numeric_limits<uint32_t>::max()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Chunk is too large for an `mdat` box. Size: ",
+                     mdat_size));
+  }
+  // Samples start right after the `mdat` header.
+  OverwriteUnsigned(out.size() + kBoxHeaderSize, 4, data_offset_offset, out);
+  AppendUnsigned(mdat_size, 4, out);
+  AppendFourCc("mdat", out);
+
+  RETURN_IF_NOT_OK(output_mp4_->Write(moof_and_mdat_header));
+  RETURN_IF_NOT_OK(output_mp4_->Write(chunk_.data));
+  chunk_.samples.clear();
+  chunk_.data.clear();
+  return absl::OkStatus();
+}
+
+}  // namespace iamf_tools
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#ifndef CLI_OBU_SEQUENCER_FRAGMENTED_MP4_H_
+#define CLI_OBU_SEQUENCER_FRAGMENTED_MP4_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "iamf/cli/obu_sequencer_base.h"
+#include "iamf/common/leb_generator.h"
+#include "iamf/common/utils/async_file_writer.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+
+/*!\brief OBU sequencer for fragmented MP4 files.
+ *
+ * Writes a single track with an `iamf` sample entry. The descriptor OBUs are
+ * stored in the `iacb` box of the `moov` box, and each temporal unit is one
+ * sample. Temporal delimiters are never included in the samples.
+ *
+ * Samples are grouped into fragments of (at least) the configured duration.
+ * Fragments may be further split into chunks, i.e. `moof`/`mdat` pairs, which
+ * are written as soon as they are complete. This is suitable for low-latency
+ * CMAF packaging.
+ *
+ * The initial trimmed samples are signalled with an edit list. The duration of
+ * the edit is filled in when closing the file.
+ */
+class ObuSequencerFragmentedMp4 : public ObuSequencerBase {
+ public:
+  /*!\brief Constructor.
+   *
+   * \param mp4_filename Name of the output fragmented MP4 file.
+   * \param fragment_duration_ms Minimum duration of each fragment in
+   *        milliseconds. Fragments only start on key frames. Zero places each
+   *        temporal unit in its own fragment.
+   * \param chunk_duration_ms Duration of each chunk in milliseconds, or zero
+   *        to write each fragment as a single chunk.
+   * \param leb_generator Leb generator to use when writing OBUs.
+   */
+  ObuSequencerFragmentedMp4(const std::string& mp4_filename,
+                            uint32_t fragment_duration_ms,
+                            uint32_t chunk_duration_ms,
+                            const LebGenerator& leb_generator);
+
+  ~ObuSequencerFragmentedMp4() override = default;
+
+ private:
+  /*!\brief Writes the `ftyp` and `moov` boxes.
+   *
+   * \param common_samples_per_frame Duration of each sample.
+   * \param common_sample_rate Timescale of the track.
+   * \param common_bit_depth Ignored.
+   * \param first_untrimmed_timestamp Start of the edit list, or `std::nullopt`
+   *        to start at zero.
+   * \param num_channels Ignored.
+   * \param descriptor_obus Serialized descriptor OBUs to write.
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status PushSerializedDescriptorObus(
+      uint32_t common_samples_per_frame, uint32_t common_sample_rate,
+      uint8_t /*common_bit_depth*/,
+      std::optional<InternalTimestamp> first_untrimmed_timestamp,
+      int /*num_channels*/, absl::Span<const uint8_t> descriptor_obus) override;
+
+  /*!\brief Adds a single temporal unit to the current chunk.
+   *
+   * The current chunk is written out first, when the temporal unit begins a
+   * new fragment or chunk.
+   *
+   * \param timestamp Decode time of the sample.
+   * \param num_samples Number of untrimmed samples in the temporal unit.
+   * \param is_key_frame Whether the temporal unit is a key frame.
+   * \param temporal_unit Temporal unit to push.
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status PushSerializedTemporalUnit(
+      InternalTimestamp timestamp, int num_samples, bool is_key_frame,
+      absl::Span<const uint8_t> temporal_unit) override;
+
+  /*!\brief Overwrites the descriptor OBUs in the `iacb` box.
+   *
+   * \param descriptor_obus Serialized finalized descriptor OBUs to push.
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status PushFinalizedDescriptorObus(
+      absl::Span<const uint8_t> descriptor_obus) override;
+
+  /*!\brief Writes the final chunk, then closes the file.
+   *
+   * \return `absl::OkStatus()` on success. The first error encountered while
+   *         writing the final chunk, patching the duration, or writing the
+   *         file on failure.
+   */
+  absl::Status CloseDerived() override;
+
+  /*!\brief Aborts writing the output.
+   *
+   * Cleans up the output file if it exists.
+   */
+  void AbortDerived() override;
+
+  /*!\brief Writes the current chunk as a `moof` and `mdat` box.
+   *
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status FlushChunk();
+
+  const std::string mp4_filename_;
+  const uint32_t fragment_duration_ms_;
+  const uint32_t chunk_duration_ms_;
+
+  std::unique_ptr<AsyncFileWriter> output_mp4_;
+
+  // Properties of the track, in ticks of the sample rate.
+  uint32_t sample_duration_ = 0;
+  int64_t fragment_duration_ = 0;
+  int64_t chunk_duration_ = 0;
+
+  // Offsets in the file of fields which are filled in later.
+  int64_t descriptor_obus_offset_ = 0;
+  int64_t edit_duration_offset_ = 0;
+
+  // Whether any temporal unit was marked as a key frame. Otherwise every
+  // temporal unit may begin a fragment.
+  bool key_frames_signalled_ = false;
+  std::optional<InternalTimestamp> fragment_start_timestamp_;
+  int64_t num_untrimmed_samples_ = 0;
+  uint32_t next_sequence_number_ = 1;
+
+  // Samples which have not been written yet.
+  struct Sample {
+    uint32_t size;
+    bool is_sync;
+  };
+  struct Chunk {
+    InternalTimestamp start_timestamp = 0;
+    std::vector<Sample> samples;
+    std::vector<uint8_t> data;
+  };
+  Chunk chunk_;
+};
+
+}  // namespace iamf_tools
+
+#endif  // CLI_OBU_SEQUENCER_FRAGMENTED_MP4_H_
@@ -13,43 +13,41 @@
 
 #include <cstdint>
 #include <filesystem>
-#include <fstream>
-#include <ios>
+#include <memory>
 #include <optional>
 #include <string>
 #include <system_error>
 
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
 #include "iamf/cli/obu_sequencer_base.h"
 #include "iamf/common/leb_generator.h"
-#include "iamf/common/utils/macros.h"
-#include "iamf/common/write_bit_buffer.h"
+#include "iamf/common/utils/async_file_writer.h"
 #include "iamf/obu/types.h"
 
 namespace iamf_tools {
 
 namespace {
 
-constexpr int64_t kBufferStartSize = 65536;
-
 // This sequencer does not care about the delay or timing information. It would
 // be pointless to delay the descriptor OBUs.
 constexpr bool kDoNotDelayDescriptorsUntilFirstUntrimmedSample = false;
 
 void MaybeRemoveFile(const std::string& filename,
-                     std::optional<std::fstream>& file_to_remove) {
-  if (filename.empty() || !file_to_remove.has_value()) {
+                     std::unique_ptr<AsyncFileWriter>& file_to_remove) {
+  if (filename.empty() || file_to_remove == nullptr) {
     return;
   }
 
-  // Close and delete the file.
-  file_to_remove->close();
-  file_to_remove = std::nullopt;
+  // Close and delete the file. Write errors are moot, since the file is being
+  // discarded.
+  file_to_remove->Close().IgnoreError();
+  file_to_remove = nullptr;
   std::error_code error_code;
   std::filesystem::remove(filename, error_code);
-  if (!error_code) {
+  if (error_code) {
     // File clean up failed somehow. Just log the error and move on.
     ABSL_LOG(ERROR).WithPerror() << "Failed to remove " << filename;
   }
@@ -59,11 +57,12 @@ void MaybeRemoveFile(const std::string& filename,
 
 ObuSequencerIamf::ObuSequencerIamf(const std::string& iamf_filename,
                                    bool include_temporal_delimiters,
-                                   const LebGenerator& leb_generator)
+                                   const LebGenerator& leb_generator,
+                                   AsyncFileWriter::WritePolicy write_policy)
     : ObuSequencerBase(leb_generator, include_temporal_delimiters,
                        kDoNotDelayDescriptorsUntilFirstUntrimmedSample),
       iamf_filename_(iamf_filename),
-      wb_(kBufferStartSize, leb_generator) {}
+      write_policy_(write_policy) {}
 
 absl::Status ObuSequencerIamf::PushSerializedDescriptorObus(
     uint32_t /*common_samples_per_frame*/, uint32_t /*common_sample_rate*/,
@@ -73,42 +72,55 @@ absl::Status ObuSequencerIamf::PushSerializedDescriptorObus(
   if (!iamf_filename_.empty()) {
     ABSL_LOG(INFO) << "Writing descriptor OBUs to " << iamf_filename_;
 
-    output_iamf_.emplace(iamf_filename_, std::fstream::out | std::ios::binary);
+    auto output_iamf = AsyncFileWriter::Create(
+        iamf_filename_, AsyncFileWriter::kDefaultStagingBufferSize,
+        write_policy_);
+    if (!output_iamf.ok()) {
+      return output_iamf.status();
+    }
+    output_iamf_ = *std::move(output_iamf);
   }
 
-  RETURN_IF_NOT_OK(wb_.WriteUint8Span(descriptor_obus));
-  return wb_.FlushAndWriteToFile(output_iamf_);
+  if (output_iamf_ == nullptr) {
+    return absl::OkStatus();
+  }
+  return output_iamf_->Write(descriptor_obus);
 }
 
 absl::Status ObuSequencerIamf::PushSerializedTemporalUnit(
     InternalTimestamp /*timestamp*/, int /*num_samples*/, bool /*is_key_frame*/,
     absl::Span<const uint8_t> temporal_unit) {
-  RETURN_IF_NOT_OK(wb_.WriteUint8Span(temporal_unit));
-  return wb_.FlushAndWriteToFile(output_iamf_);
+  if (output_iamf_ == nullptr) {
+    return absl::OkStatus();
+  }
+  return output_iamf_->Write(temporal_unit);
 }
 
 absl::Status ObuSequencerIamf::PushFinalizedDescriptorObus(
     absl::Span<const uint8_t> descriptor_obus) {
-  if (output_iamf_.has_value()) {
-    // For good practice, restore the previous position in the file after we
-    // rewrite. But in reality this function usually will be called right before
-    // closing the file.
-    const auto previous_position = output_iamf_->tellg();
-    output_iamf_->seekg(0, std::ios::beg);
-    RETURN_IF_NOT_OK(wb_.WriteUint8Span(descriptor_obus));
-    RETURN_IF_NOT_OK(wb_.FlushAndWriteToFile(output_iamf_));
-
-    output_iamf_->seekg(previous_position);
+  if (output_iamf_ == nullptr) {
+    return absl::OkStatus();
   }
-
-  return absl::OkStatus();
+  // Overwrite the original descriptors at the start of the file. This happens
+  // after all pending writes, and the writer returns to the end of the file.
+  // The POSIX write policies use `pwrite()`, which leaves the end in place.
+  return output_iamf_->WriteAt(0, descriptor_obus);
 }
 
-void ObuSequencerIamf::CloseDerived() {
-  if (output_iamf_.has_value() && output_iamf_->is_open()) {
-    output_iamf_->close();
-    output_iamf_ = std::nullopt;
+absl::Status ObuSequencerIamf::CloseDerived() {
+  if (output_iamf_ == nullptr) {
+    return absl::OkStatus();
+  }
+  // Closing waits for the pending writes, including the finalized descriptors,
+  // and reports the first write error.
+  const auto status = output_iamf_->Close();
+  output_iamf_ = nullptr;
+  if (!status.ok()) {
+    return absl::Status(status.code(),
+                        absl::StrCat("Failed to write ", iamf_filename_, ": ",
+                                     status.message()));
   }
+  return absl::OkStatus();
 }
 
 void ObuSequencerIamf::AbortDerived() {
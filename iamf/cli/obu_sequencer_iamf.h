@@ -13,7 +13,7 @@
 #define CLI_OBU_SEQUENCER_IAMF_H_
 
 #include <cstdint>
-#include <fstream>
+#include <memory>
 #include <optional>
 #include <string>
 
@@ -21,14 +21,15 @@
 #include "absl/types/span.h"
 #include "iamf/cli/obu_sequencer_base.h"
 #include "iamf/common/leb_generator.h"
-#include "iamf/common/write_bit_buffer.h"
+#include "iamf/common/utils/async_file_writer.h"
 #include "iamf/obu/types.h"
 
 namespace iamf_tools {
 
 /*!\brief OBU sequencer for standalone .iamf files.
  *
- * Used via the abstract `ObuSequencerBase` interface.
+ * Used via the abstract `ObuSequencerBase` interface. The file is written on a
+ * separate thread, so pushing OBUs rarely waits for storage.
  */
 class ObuSequencerIamf : public ObuSequencerBase {
  public:
@@ -38,10 +39,13 @@ class ObuSequencerIamf : public ObuSequencerBase {
    * \param include_temporal_delimiters Whether the serialized data should
    *        include a temporal delimiter.
    * \param leb_generator Leb generator to use when writing OBUs.
+   * \param write_policy How to write the file.
    */
   ObuSequencerIamf(const std::string& iamf_filename,
                    bool include_temporal_delimiters,
-                   const LebGenerator& leb_generator);
+                   const LebGenerator& leb_generator,
+                   AsyncFileWriter::WritePolicy write_policy =
+                       AsyncFileWriter::WritePolicy::kBuffered);
 
   ~ObuSequencerIamf() override = default;
 
@@ -82,8 +86,12 @@ class ObuSequencerIamf : public ObuSequencerBase {
   absl::Status PushFinalizedDescriptorObus(
       absl::Span<const uint8_t> descriptor_obus) override;
 
-  /*!\brief Signals that no more data is coming. */
-  void CloseDerived() override;
+  /*!\brief Signals that no more data is coming, and closes the file.
+   *
+   * \return `absl::OkStatus()` on success. The first error encountered while
+   *         writing the file on failure.
+   */
+  absl::Status CloseDerived() override;
 
   /*!\brief Aborts writing the output.
    *
@@ -92,9 +100,8 @@ class ObuSequencerIamf : public ObuSequencerBase {
   void AbortDerived() override;
 
   const std::string iamf_filename_;
-  std::optional<std::fstream> output_iamf_;
-  // Reusable write buffer between calls.
-  WriteBitBuffer wb_;
+  const AsyncFileWriter::WritePolicy write_policy_;
+  std::unique_ptr<AsyncFileWriter> output_iamf_;
 };
 
 }  // namespace iamf_tools
@@ -22,6 +22,9 @@
 #include "absl/types/span.h"
 #include "iamf/cli/obu_sequencer_base.h"
 #include "iamf/common/leb_generator.h"
+#include "iamf/common/read_bit_buffer.h"
+#include "iamf/common/utils/macros.h"
+#include "iamf/obu/obu_header.h"
 #include "iamf/obu/types.h"
 
 namespace iamf_tools {
@@ -38,55 +41,129 @@ void CopySpanToVector(absl::Span<const uint8_t> span,
   std::copy(span.begin(), span.end(), std::back_inserter(vector));
 }
 
+// Mask of `obu_redundant_copy` in the first byte of an OBU, after the 5-bit
+// `obu_type`.
+constexpr uint8_t kObuRedundantCopyBitMask = 0x04;
+
+// Sets `obu_redundant_copy` on each of the serialized OBUs.
+absl::Status MarkObusAsRedundant(std::vector<uint8_t>& serialized_obus) {
+  auto rb =
+      MemoryBasedReadBitBuffer::CreateFromSpan(absl::MakeSpan(serialized_obus));
+  while (rb->IsDataAvailable()) {
+    const auto header_metadata = ObuHeader::PeekObuTypeAndTotalObuSize(*rb);
+    if (!header_metadata.ok()) {
+      return header_metadata.status();
+    }
+    serialized_obus[rb->Tell() / 8] |= kObuRedundantCopyBitMask;
+    RETURN_IF_NOT_OK(rb->IgnoreBytes(header_metadata->total_obu_size));
+  }
+  return absl::OkStatus();
+}
+
+// Returns the size of the temporal delimiter at the start of the temporal
+// unit, or zero if there is none.
+int64_t GetTemporalDelimiterSize(absl::Span<const uint8_t> temporal_unit) {
+  auto rb = MemoryBasedReadBitBuffer::CreateFromSpan(temporal_unit);
+  const auto header_metadata = ObuHeader::PeekObuTypeAndTotalObuSize(*rb);
+  if (!header_metadata.ok() ||
+      header_metadata->obu_type != kObuIaTemporalDelimiter) {
+    return 0;
+  }
+  return header_metadata->total_obu_size;
+}
+
 }  // namespace
 
 ObuSequencerStreamingIamf::ObuSequencerStreamingIamf(
-    bool include_temporal_delimiters, const LebGenerator& leb_generator)
+    bool include_temporal_delimiters, const LebGenerator& leb_generator,
+    uint32_t redundant_descriptor_obu_interval)
     : ObuSequencerBase(leb_generator, include_temporal_delimiters,
-                       kDoNotDelayDescriptorsUntilFirstUntrimmedSample) {}
+                       kDoNotDelayDescriptorsUntilFirstUntrimmedSample),
+      redundant_descriptor_obu_interval_(redundant_descriptor_obu_interval) {}
 
 absl::Span<const uint8_t>
 ObuSequencerStreamingIamf::GetSerializedDescriptorObus() const {
   return absl::MakeConstSpan(serialized_descriptor_obus_);
 }
 
+absl::Span<const uint8_t>
+ObuSequencerStreamingIamf::GetSerializedRedundantDescriptorObus() const {
+  return absl::MakeConstSpan(serialized_redundant_descriptor_obus_);
+}
+
 absl::Span<const uint8_t>
 ObuSequencerStreamingIamf::GetPreviousSerializedTemporalUnit() const {
   return absl::MakeConstSpan(previous_serialized_temporal_unit_);
 }
 
+void ObuSequencerStreamingIamf::TakePreviousSerializedTemporalUnit(
+    std::vector<uint8_t>& temporal_unit) {
+  temporal_unit.swap(previous_serialized_temporal_unit_);
+  // Keep the capacity, to reuse for the next temporal unit.
+  previous_serialized_temporal_unit_.clear();
+}
+
 absl::Status ObuSequencerStreamingIamf::PushSerializedDescriptorObus(
     uint32_t /*common_samples_per_frame*/, uint32_t /*common_sample_rate*/,
     uint8_t /*common_bit_depth*/,
     std::optional<InternalTimestamp> /*first_untrimmed_timestamp*/,
     int /*num_channels*/, absl::Span<const uint8_t> descriptor_obus) {
-  CopySpanToVector(descriptor_obus, serialized_descriptor_obus_);
-  return absl::OkStatus();
+  return CacheDescriptorObus(descriptor_obus);
 }
 
 absl::Status ObuSequencerStreamingIamf::PushSerializedTemporalUnit(
     InternalTimestamp /*timestamp*/, int /*num_samples*/, bool /*is_key_frame*/,
     absl::Span<const uint8_t> temporal_unit) {
-  CopySpanToVector(temporal_unit, previous_serialized_temporal_unit_);
+  // The first temporal unit directly follows the original descriptor OBUs.
+  const bool insert_redundant_descriptor_obus =
+      redundant_descriptor_obu_interval_ > 0 && num_temporal_units_ > 0 &&
+      num_temporal_units_ % redundant_descriptor_obu_interval_ == 0;
+  ++num_temporal_units_;
+  if (!insert_redundant_descriptor_obus) {
+    CopySpanToVector(temporal_unit, previous_serialized_temporal_unit_);
+    return absl::OkStatus();
+  }
+
+  // Insert the cached copies after the temporal delimiter, if present.
+  const auto temporal_delimiter_end =
+      temporal_unit.begin() + GetTemporalDelimiterSize(temporal_unit);
+  auto& output = previous_serialized_temporal_unit_;
+  output.clear();
+  output.reserve(temporal_unit.size() +
+                 serialized_redundant_descriptor_obus_.size());
+  output.insert(output.end(), temporal_unit.begin(), temporal_delimiter_end);
+  output.insert(output.end(), serialized_redundant_descriptor_obus_.begin(),
+                serialized_redundant_descriptor_obus_.end());
+  output.insert(output.end(), temporal_delimiter_end, temporal_unit.end());
   return absl::OkStatus();
 }
 
 absl::Status ObuSequencerStreamingIamf::PushFinalizedDescriptorObus(
     absl::Span<const uint8_t> descriptor_obus) {
-  CopySpanToVector(descriptor_obus, serialized_descriptor_obus_);
-  return absl::OkStatus();
+  return CacheDescriptorObus(descriptor_obus);
 }
 
-void ObuSequencerStreamingIamf::CloseDerived() {
+absl::Status ObuSequencerStreamingIamf::CloseDerived() {
   // Leave the descriptor OBUs in place, so the user can retrieve the updated
   // descriptors if available.
   previous_serialized_temporal_unit_.clear();
+  return absl::OkStatus();
 }
 
 void ObuSequencerStreamingIamf::AbortDerived() {
   ABSL_LOG(INFO) << "Aborting ObuSequencerStreamingIamf.";
   serialized_descriptor_obus_.clear();
+  serialized_redundant_descriptor_obus_.clear();
   previous_serialized_temporal_unit_.clear();
 }
 
+absl::Status ObuSequencerStreamingIamf::CacheDescriptorObus(
+    absl::Span<const uint8_t> descriptor_obus) {
+  CopySpanToVector(descriptor_obus, serialized_descriptor_obus_);
+  // Flip the flag in a copy of the serialized OBUs, rather than serializing
+  // them again.
+  CopySpanToVector(descriptor_obus, serialized_redundant_descriptor_obus_);
+  return MarkObusAsRedundant(serialized_redundant_descriptor_obus_);
+}
+
 }  // namespace iamf_tools
@@ -34,6 +34,10 @@ namespace iamf_tools {
  * this class should retrieve the serialized OBUs using
  * `GetSerializedDescriptorObus` and `GetPreviousSerializedTemporalUnit` and do
  * something with them.
+ *
+ * Optionally, redundant copies of the descriptor OBUs are periodically inserted
+ * into the temporal units. This allows decoders to join the stream part-way
+ * through, e.g. when tuning in to a live broadcast.
  */
 class ObuSequencerStreamingIamf : public ObuSequencerBase {
  public:
@@ -42,9 +46,14 @@ class ObuSequencerStreamingIamf : public ObuSequencerBase {
    * \param include_temporal_delimiters Whether the serialized data should
    *        include a temporal delimiter.
    * \param leb_generator Leb generator to use when writing OBUs.
+   * \param redundant_descriptor_obu_interval Number of temporal units between
+   *        redundant copies of the descriptor OBUs, or zero to never insert
+   *        them. The copies are placed at the start of the temporal unit,
+   *        after any temporal delimiter.
    */
   ObuSequencerStreamingIamf(bool include_temporal_delimiters,
-                            const LebGenerator& leb_generator);
+                            const LebGenerator& leb_generator,
+                            uint32_t redundant_descriptor_obu_interval = 0);
 
   ~ObuSequencerStreamingIamf() override = default;
 
@@ -55,6 +64,16 @@ class ObuSequencerStreamingIamf : public ObuSequencerBase {
    */
   absl::Span<const uint8_t> GetSerializedDescriptorObus() const;
 
+  /*!\brief Returns the serialized descriptor OBUs marked as redundant copies.
+   *
+   * The copies are cached whenever descriptor OBUs are pushed, by setting the
+   * `obu_redundant_copy` flag of each OBU in place.
+   *
+   * \return Serialized redundant descriptor OBUs, or an empty span if
+   *         descriptor OBUs are not available
+   */
+  absl::Span<const uint8_t> GetSerializedRedundantDescriptorObus() const;
+
   /*!\brief Returns the previous serialized temporal unit OBUs.
    *
    * \return Serialized OBUS from the previous temporal unit, or an empty span
@@ -62,6 +81,17 @@ class ObuSequencerStreamingIamf : public ObuSequencerBase {
    */
   absl::Span<const uint8_t> GetPreviousSerializedTemporalUnit() const;
 
+  /*!\brief Moves out the previous serialized temporal unit.
+   *
+   * The buffers are swapped rather than copied. The storage of
+   * `temporal_unit` is kept to serialize later temporal units, so repeated
+   * calls with the same vector do not allocate.
+   *
+   * \param temporal_unit Serialized OBUs from the previous temporal unit, or
+   *        empty if a temporal unit is not available.
+   */
+  void TakePreviousSerializedTemporalUnit(std::vector<uint8_t>& temporal_unit);
+
  private:
   /*!\brief Pushes the descriptor OBUs to some output.
    *
@@ -84,7 +114,8 @@ class ObuSequencerStreamingIamf : public ObuSequencerBase {
    * \param timestamp Ignored.
    * \param num_samples Ignored.
    * \param is_key_frame Ignored.
-   * \param temporal_unit Temporal unit to push.
+   * \param temporal_unit Temporal unit to push. Redundant descriptor OBUs are
+   *        inserted when the interval has elapsed.
    * \return `absl::OkStatus()` on success. A specific status on failure.
    */
   absl::Status PushSerializedTemporalUnit(
@@ -99,8 +130,11 @@ class ObuSequencerStreamingIamf : public ObuSequencerBase {
   absl::Status PushFinalizedDescriptorObus(
       absl::Span<const uint8_t> descriptor_obus) override;
 
-  /*!\brief Signals that no more data is coming. */
-  void CloseDerived() override;
+  /*!\brief Signals that no more data is coming.
+   *
+   * \return `absl::OkStatus()`.
+   */
+  absl::Status CloseDerived() override;
 
   /*!\brief Aborts writing the output.
    *
@@ -108,8 +142,19 @@ class ObuSequencerStreamingIamf : public ObuSequencerBase {
    */
   void AbortDerived() override;
 
+  /*!\brief Caches the descriptor OBUs and their redundant copies.
+   *
+   * \param descriptor_obus Serialized descriptor OBUs.
+   * \return `absl::OkStatus()` on success. A specific status if the OBUs
+   *         cannot be parsed.
+   */
+  absl::Status CacheDescriptorObus(absl::Span<const uint8_t> descriptor_obus);
+
+  const uint32_t redundant_descriptor_obu_interval_;
   std::vector<uint8_t> serialized_descriptor_obus_;
+  std::vector<uint8_t> serialized_redundant_descriptor_obus_;
   std::vector<uint8_t> previous_serialized_temporal_unit_;
+  int64_t num_temporal_units_ = 0;
 };
 
 }  // namespace iamf_tools
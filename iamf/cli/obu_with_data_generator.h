@@ -70,6 +70,8 @@ class ObuWithDataGenerator {
    *
    * \param input_start_timestamp Expected start timestamp of this parameter
    *        block to check that there is no gap in the parameter substream.
+   *        Measured in ticks of the audio sample rate, as described by
+   *        `GlobalTimingModule::GetNextParameterBlockTimestamps()`.
    * \param global_timing_module Module to keep track of frame-by-frame
    *        timestamps.
    * \param parameter_block_obu Unique pointer to a parameter block OBU.
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#ifndef CLI_PARAMETER_BLOCK_METADATA_H_
+#define CLI_PARAMETER_BLOCK_METADATA_H_
+
+#include <variant>
+#include <vector>
+
+#include "iamf/obu/demixing_info_parameter_data.h"
+#include "iamf/obu/mix_gain_parameter_data.h"
+#include "iamf/obu/obu_header.h"
+#include "iamf/obu/recon_gain_info_parameter_data.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+
+/*!\brief User metadata to generate one parameter block.
+ *
+ * Holds the same information as a `ParameterBlockObuMetadata` protocol buffer,
+ * already validated and converted to the types of the OBUs, so it can be
+ * generated without any protocol buffers in the loop.
+ */
+struct ParameterBlockMetadata {
+  // User supplied recon gains for each layer. Recon gains are only present
+  // for the bits set in `ReconGainElement::recon_gain_flag`.
+  using UserReconGains = std::vector<ReconGainElement>;
+
+  struct Subblock {
+    // Ignored unless the parameter block includes subblock durations.
+    DecodedUleb128 subblock_duration = 0;
+
+    // The active field must match the type of the parameter definition.
+    std::variant<MixGainParameterData, DemixingInfoParameterData,
+                 UserReconGains>
+        param_data;
+  };
+
+  ObuHeader obu_header;
+  DecodedUleb128 parameter_id = 0;
+  InternalTimestamp start_timestamp = 0;
+
+  // Ignored unless `param_definition_mode == 1` in the parameter definition.
+  DecodedUleb128 duration = 0;
+  DecodedUleb128 constant_subblock_duration = 0;
+  std::vector<Subblock> subblocks;
+};
+
+}  // namespace iamf_tools
+
+#endif  // CLI_PARAMETER_BLOCK_METADATA_H_
@@ -20,6 +20,7 @@
 #include "iamf/cli/proto/output_audio_format.pb.h"
 #include "iamf/cli/rendering_mix_presentation_finalizer.h"
 #include "iamf/cli/sample_processor_base.h"
+#include "iamf/cli/true_peak_limiter.h"
 #include "iamf/obu/mix_presentation.h"
 #include "iamf/obu/types.h"
 
@@ -79,4 +80,33 @@ void ApplyOutputAudioFormatToSampleProcessorFactory(
   };
 }
 
+void ApplyTruePeakLimiterToSampleProcessorFactory(
+    const TruePeakLimiter::Settings& settings,
+    SampleProcessorFactory& sample_processor_factory) {
+  sample_processor_factory =
+      [original_factory = std::move(sample_processor_factory), settings](
+          DecodedUleb128 mix_presentation_id, int sub_mix_index,
+          int layout_index, const Layout& layout, int num_channels,
+          int sample_rate, int bit_depth, size_t max_input_samples_per_frame)
+      -> std::unique_ptr<SampleProcessorBase> {
+    auto sample_processor = original_factory(
+        mix_presentation_id, sub_mix_index, layout_index, layout, num_channels,
+        sample_rate, bit_depth, max_input_samples_per_frame);
+    if (sample_processor == nullptr) {
+      // Nothing would consume the limited samples.
+      return nullptr;
+    }
+    auto limiter = TruePeakLimiter::Create(
+        max_input_samples_per_frame, num_channels, sample_rate, settings,
+        std::move(sample_processor));
+    if (limiter == nullptr) {
+      ABSL_LOG(WARNING) << "Failed to create a true-peak limiter for mix "
+                           "presentation ID= "
+                        << mix_presentation_id
+                        << ". Disabling output audio for this layout.";
+    }
+    return limiter;
+  };
+}
+
 }  // namespace iamf_tools
@@ -16,6 +16,7 @@
 #include "iamf/cli/proto/obu_header.pb.h"
 #include "iamf/cli/proto/output_audio_format.pb.h"
 #include "iamf/cli/rendering_mix_presentation_finalizer.h"
+#include "iamf/cli/true_peak_limiter.h"
 
 namespace iamf_tools {
 
@@ -29,6 +30,20 @@ void ApplyOutputAudioFormatToSampleProcessorFactory(
     RenderingMixPresentationFinalizer::SampleProcessorFactory&
         sample_processor_factory);
 
+/*!\brief Modifies a factory to limit the true peak of the processed samples.
+ *
+ * Each sample processor created by the original factory receives its samples
+ * through a `TruePeakLimiter`. The limiter compensates for its own latency, so
+ * the processed samples stay aligned with the rendered samples.
+ *
+ * \param settings Settings of the limiter.
+ * \param sample_processor_factory Factory function to modify in place.
+ */
+void ApplyTruePeakLimiterToSampleProcessorFactory(
+    const TruePeakLimiter::Settings& settings,
+    RenderingMixPresentationFinalizer::SampleProcessorFactory&
+        sample_processor_factory);
+
 }  // namespace iamf_tools
 
 #endif  // CLI_PROTO_CONVERSION_OUTPUT_AUDIO_FORMAT_UTILS_H_
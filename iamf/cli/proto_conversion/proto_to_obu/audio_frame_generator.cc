@@ -41,8 +41,10 @@
 #include "iamf/cli/audio_frame_with_data.h"
 #include "iamf/cli/channel_label.h"
 #include "iamf/cli/codec/aac_encoder.h"
+#include "iamf/cli/codec/chunked_encoder.h"
 #include "iamf/cli/codec/encoder_base.h"
 #include "iamf/cli/codec/flac_encoder.h"
+#include "iamf/cli/codec/flac_utils.h"
 #include "iamf/cli/codec/lpcm_encoder.h"
 #include "iamf/cli/codec/opus_encoder.h"
 #include "iamf/cli/demixing_module.h"
@@ -55,6 +57,7 @@
 #include "iamf/cli/proto_conversion/codec_config_utils.h"
 #include "iamf/cli/substream_frames.h"
 #include "iamf/common/utils/macros.h"
+#include "iamf/common/utils/thread_pool.h"
 #include "iamf/obu/audio_frame.h"
 #include "iamf/obu/codec_config.h"
 #include "iamf/obu/demixing_info_parameter_data.h"
@@ -107,12 +110,55 @@ absl::Status InitializeEncoder(
   return absl::OkStatus();
 }
 
+// Initializes an encoder for a substream. When requested, and when the frames
+// of the codec are independent, the encoder encodes chunks of the substream in
+// parallel.
+absl::Status InitializeSubstreamEncoder(
+    const iamf_tools_cli_proto::CodecConfig& codec_config_metadata,
+    const CodecConfigObu& codec_config, int num_channels,
+    uint32_t num_frames_per_encoding_chunk, int substream_id,
+    std::unique_ptr<EncoderBase>& encoder) {
+  const auto codec_id = codec_config.GetCodecConfig().codec_id;
+  const bool frames_are_independent = codec_id == CodecConfig::kCodecIdLpcm ||
+                                      codec_id == CodecConfig::kCodecIdFlac;
+  if (num_frames_per_encoding_chunk == 0 || !frames_are_independent) {
+    if (num_frames_per_encoding_chunk != 0) {
+      ABSL_LOG_FIRST_N(WARNING, 1)
+          << "Encoding chunks in parallel is not supported for codec_id= "
+          << codec_id << ". Encoding frames one after another.";
+    }
+    return InitializeEncoder(codec_config_metadata, codec_config, num_channels,
+                             encoder, kValidateCodecDelay, substream_id);
+  }
+
+  ChunkedEncoder::StitchFrameFunction stitch_frame = nullptr;
+  if (codec_id == CodecConfig::kCodecIdFlac) {
+    // Each chunk is a new FLAC stream; number the frames as if in one stream.
+    stitch_frame = [](uint32_t frame_index, std::vector<uint8_t>& audio_frame) {
+      return SetFlacFrameNumber(frame_index, audio_frame);
+    };
+  }
+  encoder = std::make_unique<ChunkedEncoder>(
+      [codec_config_metadata, &codec_config, num_channels, substream_id]()
+          -> absl::StatusOr<std::unique_ptr<EncoderBase>> {
+        std::unique_ptr<EncoderBase> chunk_encoder;
+        RETURN_IF_NOT_OK(InitializeEncoder(codec_config_metadata, codec_config,
+                                           num_channels, chunk_encoder,
+                                           kValidateCodecDelay, substream_id));
+        return chunk_encoder;
+      },
+      std::move(stitch_frame), num_frames_per_encoding_chunk, codec_config,
+      num_channels);
+  return encoder->Initialize(kValidateCodecDelay);
+}
+
 // Gets data relevant to encoding (Codec Config OBU and AudioElementWithData)
 // and initializes encoders.
 absl::Status GetEncodingDataAndInitializeEncoders(
     const absl::flat_hash_map<DecodedUleb128, iamf_tools_cli_proto::CodecConfig>
         codec_config_metadata,
     const AudioElementWithData& audio_element_with_data,
+    uint32_t num_frames_per_encoding_chunk,
     absl::flat_hash_map<uint32_t, std::unique_ptr<EncoderBase>>&
         substream_id_to_encoder) {
   for (const auto& [substream_id, labels] :
@@ -128,10 +174,10 @@ absl::Status GetEncodingDataAndInitializeEncoders(
           codec_config_obu.GetCodecConfigId()));
     }
 
-    RETURN_IF_NOT_OK(InitializeEncoder(codec_config_metadata_iter->second,
-                                       codec_config_obu, num_channels,
-                                       substream_id_to_encoder[substream_id],
-                                       kValidateCodecDelay, substream_id));
+    RETURN_IF_NOT_OK(InitializeSubstreamEncoder(
+        codec_config_metadata_iter->second, codec_config_obu, num_channels,
+        num_frames_per_encoding_chunk, substream_id,
+        substream_id_to_encoder[substream_id]));
   }
 
   return absl::OkStatus();
@@ -430,6 +476,17 @@ absl::Status MaybeEncodeFramesForAudioElement(
     label_to_empty_samples[label] = {};
   }
 
+  // Frames of one temporal unit are encoded in parallel; each substream has
+  // its own encoder, so the output does not depend on the scheduling. Chunked
+  // encoders (see `ChunkedEncoder`) additionally encode chunks of the timeline
+  // of their substream in parallel.
+  struct FrameToEncode {
+    EncoderBase* encoder;
+    SubstreamData* substream_data;
+    std::unique_ptr<AudioFrameWithData> partial_audio_frame_with_data;
+  };
+  std::vector<FrameToEncode> frames_to_encode;
+
   std::optional<InternalTimestamp> encoded_timestamp;
   bool more_samples_to_encode = false;
   do {
@@ -515,15 +572,27 @@ absl::Status MaybeEncodeFramesForAudioElement(
               .recon_gain_info_parameter_data = ReconGainInfoParameterData(),
               .audio_element_with_data = &audio_element_with_data});
 
-      RETURN_IF_NOT_OK(
-          substream_id_to_encoder.at(substream_id)
-              ->EncodeAudioFrame(frame_to_encode,
-                                 std::move(partial_audio_frame_with_data)));
-      substream_data.frames_in_obu.PopFront();
-      substream_data.frames_to_encode.PopFront();
+      frames_to_encode.push_back(
+          {.encoder = substream_id_to_encoder.at(substream_id).get(),
+           .substream_data = &substream_data,
+           .partial_audio_frame_with_data =
+               std::move(partial_audio_frame_with_data)});
       encoded_timestamp = start_timestamp;
     }
 
+    RETURN_IF_NOT_OK(ThreadPool::GetShared().ParallelFor(
+        frames_to_encode.size(), [&frames_to_encode](size_t i) {
+          auto& frame = frames_to_encode[i];
+          return frame.encoder->EncodeAudioFrame(
+              frame.substream_data->frames_to_encode.Front(),
+              std::move(frame.partial_audio_frame_with_data));
+        }));
+    for (auto& frame : frames_to_encode) {
+      frame.substream_data->frames_in_obu.PopFront();
+      frame.substream_data->frames_to_encode.PopFront();
+    }
+    frames_to_encode.clear();
+
     // Clears the samples for the next iteration.
     label_to_samples = label_to_empty_samples;
   } while (!encoded_timestamp.has_value() && more_samples_to_encode);
@@ -643,7 +712,8 @@ AudioFrameGenerator::Create(
         audio_elements,
     const DemixingModule& demixing_module,
     ParametersManager& parameters_manager,
-    GlobalTimingModule& global_timing_module) {
+    GlobalTimingModule& global_timing_module,
+    uint32_t num_frames_per_encoding_chunk) {
   if (audio_frame_metadatas.empty()) {
     // Ok, nothing will be generated. This state helps clients handle trivial IA
     // Sequences.
@@ -676,7 +746,7 @@ AudioFrameGenerator::Create(
     // Create an encoder for each substream.
     RETURN_IF_NOT_OK(GetEncodingDataAndInitializeEncoders(
         codec_config_metadata, audio_elements_iter->second,
-        substream_id_to_encoder));
+        num_frames_per_encoding_chunk, substream_id_to_encoder));
   }
 
   // Get the global maximum delay among all encoders. IAMF requires that all
@@ -93,6 +93,10 @@ class AudioFrameGenerator {
    * \param demixing_module Demixng module.
    * \param parameters_manager Manager of parameters.
    * \param global_timing_module Global Timing Module.
+   * \param num_frames_per_encoding_chunk Number of frames in each chunk of a
+   *        substream, to encode chunks of the substreams of LPCM and FLAC in
+   *        parallel. 0 to encode the frames of each substream one after
+   *        another.
    */
   static absl::StatusOr<std::unique_ptr<AudioFrameGenerator> absl_nonnull>
   Create(
@@ -104,7 +108,8 @@ class AudioFrameGenerator {
           audio_elements,
       const DemixingModule& demixing_module,
       ParametersManager& parameters_manager,
-      GlobalTimingModule& global_timing_module);
+      GlobalTimingModule& global_timing_module,
+      uint32_t num_frames_per_encoding_chunk);
 
   /*!\brief Deleted move constructor. */
   AudioFrameGenerator(AudioFrameGenerator&&) = delete;
@@ -24,12 +24,14 @@
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "iamf/cli/audio_element_with_data.h"
 #include "iamf/cli/channel_label.h"
 #include "iamf/cli/cli_util.h"
 #include "iamf/cli/demixing_module.h"
 #include "iamf/cli/global_timing_module.h"
+#include "iamf/cli/parameter_block_metadata.h"
 #include "iamf/cli/parameter_block_with_data.h"
 #include "iamf/cli/proto/parameter_block.pb.h"
 #include "iamf/cli/proto/parameter_data.pb.h"
@@ -62,6 +64,15 @@ GetParameterDefinitionType(
       parameter_definition_variant);
 }
 
+// Metadata of other types is accepted, but not yet generated by this class.
+bool IsGeneratedType(
+    ParamDefinition::ParameterDefinitionType param_definition_type) {
+  using enum ParamDefinition::ParameterDefinitionType;
+  return param_definition_type == kParameterDefinitionMixGain ||
+         param_definition_type == kParameterDefinitionDemixing ||
+         param_definition_type == kParameterDefinitionReconGain;
+}
+
 uint8_t GetParameterDefinitionMode(
     const ParamDefinitionVariant& parameter_definition_variant) {
   return std::visit(
@@ -71,33 +82,29 @@ uint8_t GetParameterDefinitionMode(
       parameter_definition_variant);
 }
 
-absl::Status GenerateMixGainSubblock(
+absl::Status CopyMixGainParameterData(
     const iamf_tools_cli_proto::MixGainParameterData&
         metadata_mix_gain_parameter_data,
-    const MixGainParamDefinition* param_definition,
-    std::unique_ptr<ParameterData>& parameter_data) {
-  parameter_data = param_definition->CreateParameterData();
-  auto* mix_gain_parameter_data =
-      static_cast<MixGainParameterData*>(parameter_data.get());
+    MixGainParameterData& mix_gain_parameter_data) {
   switch (metadata_mix_gain_parameter_data.animation_type()) {
     using enum iamf_tools_cli_proto::AnimationType;
     case ANIMATE_STEP: {
       const auto& metadata_animation =
           metadata_mix_gain_parameter_data.param_data().step();
-      mix_gain_parameter_data->animation_type =
+      mix_gain_parameter_data.animation_type =
           MixGainParameterData::kAnimateStep;
       AnimationStepInt16 obu_animation;
       RETURN_IF_NOT_OK(StaticCastIfInRange<int32_t, int16_t>(
           "AnimationStepInt16.start_point_value",
           metadata_animation.start_point_value(),
           obu_animation.start_point_value));
-      mix_gain_parameter_data->param_data = obu_animation;
+      mix_gain_parameter_data.param_data = obu_animation;
       break;
     }
     case ANIMATE_LINEAR: {
       const auto& metadata_animation =
           metadata_mix_gain_parameter_data.param_data().linear();
-      mix_gain_parameter_data->animation_type =
+      mix_gain_parameter_data.animation_type =
           MixGainParameterData::kAnimateLinear;
 
       AnimationLinearInt16 obu_animation;
@@ -108,13 +115,13 @@ absl::Status GenerateMixGainSubblock(
       RETURN_IF_NOT_OK(StaticCastIfInRange<int32_t, int16_t>(
           "AnimationLinearInt16.end_point_value",
           metadata_animation.end_point_value(), obu_animation.end_point_value));
-      mix_gain_parameter_data->param_data = obu_animation;
+      mix_gain_parameter_data.param_data = obu_animation;
       break;
     }
     case ANIMATE_BEZIER: {
       const auto& metadata_animation =
           metadata_mix_gain_parameter_data.param_data().bezier();
-      mix_gain_parameter_data->animation_type =
+      mix_gain_parameter_data.animation_type =
           MixGainParameterData::kAnimateBezier;
       AnimationBezierInt16 obu_animation;
       RETURN_IF_NOT_OK(StaticCastIfInRange<int32_t, int16_t>(
@@ -132,7 +139,7 @@ absl::Status GenerateMixGainSubblock(
           "AnimationBezierInt16.control_point_relative_time",
           metadata_animation.control_point_relative_time(),
           obu_animation.control_point_relative_time));
-      mix_gain_parameter_data->param_data = obu_animation;
+      mix_gain_parameter_data.param_data = obu_animation;
       break;
     }
     default:
@@ -144,6 +151,82 @@ absl::Status GenerateMixGainSubblock(
   return absl::OkStatus();
 }
 
+absl::Status CopyUserReconGains(
+    const iamf_tools_cli_proto::ReconGainInfoParameterData&
+        metadata_recon_gain_info_parameter_data,
+    ParameterBlockMetadata::UserReconGains& user_recon_gains) {
+  user_recon_gains.clear();
+  for (const auto& metadata_recon_gains :
+       metadata_recon_gain_info_parameter_data.recon_gains_for_layer()) {
+    ReconGainElement user_recon_gain_element{.recon_gain_flag = 0,
+                                             .recon_gain = {}};
+    for (const auto& [bit_position, user_recon_gain] :
+         metadata_recon_gains.recon_gain()) {
+      if (bit_position >= user_recon_gain_element.recon_gain.size()) {
+        return absl::InvalidArgumentError(
+            absl::StrCat("Invalid recon gain bit position= ", bit_position));
+      }
+      user_recon_gain_element.recon_gain_flag |= 1 << bit_position;
+      RETURN_IF_NOT_OK(StaticCastIfInRange<uint32_t, uint8_t>(
+          "ReconGains.recon_gain", user_recon_gain,
+          user_recon_gain_element.recon_gain[bit_position]));
+    }
+    user_recon_gains.push_back(user_recon_gain_element);
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CopyParameterBlockMetadata(
+    const iamf_tools_cli_proto::ParameterBlockObuMetadata&
+        parameter_block_metadata,
+    ParamDefinition::ParameterDefinitionType param_definition_type,
+    ParameterBlockMetadata& output_metadata) {
+  if (parameter_block_metadata.has_num_subblocks()) {
+    ABSL_LOG(WARNING)
+        << "Ignoring deprecated `num_subblocks` field in Parameter "
+           "Block OBU. Please remove it.";
+  }
+
+  output_metadata.obu_header =
+      GetHeaderFromMetadata(parameter_block_metadata.obu_header());
+  output_metadata.parameter_id = parameter_block_metadata.parameter_id();
+  output_metadata.start_timestamp = parameter_block_metadata.start_timestamp();
+  output_metadata.duration = parameter_block_metadata.duration();
+  output_metadata.constant_subblock_duration =
+      parameter_block_metadata.constant_subblock_duration();
+  output_metadata.subblocks.resize(parameter_block_metadata.subblocks_size());
+  for (int i = 0; i < parameter_block_metadata.subblocks_size(); ++i) {
+    const auto& metadata_subblock = parameter_block_metadata.subblocks(i);
+    auto& output_subblock = output_metadata.subblocks[i];
+    output_subblock.subblock_duration = metadata_subblock.subblock_duration();
+    switch (param_definition_type) {
+      using enum ParamDefinition::ParameterDefinitionType;
+      case kParameterDefinitionMixGain:
+        RETURN_IF_NOT_OK(CopyMixGainParameterData(
+            metadata_subblock.mix_gain_parameter_data(),
+            output_subblock.param_data.emplace<MixGainParameterData>()));
+        break;
+      case kParameterDefinitionDemixing:
+        RETURN_IF_NOT_OK(CopyDemixingInfoParameterData(
+            metadata_subblock.demixing_info_parameter_data(),
+            output_subblock.param_data.emplace<DemixingInfoParameterData>()));
+        break;
+      case kParameterDefinitionReconGain:
+        RETURN_IF_NOT_OK(CopyUserReconGains(
+            metadata_subblock.recon_gain_info_parameter_data(),
+            output_subblock.param_data
+                .emplace<ParameterBlockMetadata::UserReconGains>()));
+        break;
+      default:
+        // TODO(b/289080630): Support the extension fields here.
+        return absl::InvalidArgumentError(absl::StrCat(
+            "Unsupported param definition type= ", param_definition_type));
+    }
+  }
+
+  return absl::OkStatus();
+}
+
 absl::Status FindDemixedChannels(
     const ChannelNumbers& accumulated_channels,
     const ChannelNumbers& layer_channels,
@@ -306,16 +389,13 @@ absl::Status GenerateReconGainSubblock(
     const bool additional_recon_gains_logging,
     const IdLabeledFrameMap& id_to_labeled_frame,
     const IdLabeledFrameMap& id_to_labeled_decoded_frame,
-    const iamf_tools_cli_proto::ReconGainInfoParameterData&
-        metadata_recon_gain_info_parameter_data,
+    const ParameterBlockMetadata::UserReconGains& user_recon_gains_layers,
     const ReconGainParamDefinition* param_definition,
     std::unique_ptr<ParameterData>& parameter_data) {
   parameter_data = param_definition->CreateParameterData();
   auto* recon_gain_info_parameter_data =
       static_cast<ReconGainInfoParameterData*>(parameter_data.get());
   const auto num_layers = param_definition->aux_data_.size();
-  const auto& user_recon_gains_layers =
-      metadata_recon_gain_info_parameter_data.recon_gains_for_layer();
   if (num_layers > 1 && num_layers != user_recon_gains_layers.size()) {
     return absl::InvalidArgumentError(
         absl::StrCat("There are ", num_layers, " layers of scalable  ",
@@ -338,20 +418,22 @@ absl::Status GenerateReconGainSubblock(
       continue;
     }
     output_recon_gain_element.emplace(ReconGainElement{});
+    if (layer_index >= user_recon_gains_layers.size()) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Missing user specified recon gains for layer ", layer_index));
+    }
 
-    // Construct the bitmask indicating the channels where recon gains are
-    // present.
+    // Keep only the recon gains which are flagged as present.
+    const DecodedUleb128 user_recon_gain_flag =
+        user_recon_gains_layers[layer_index].recon_gain_flag;
     std::vector<uint8_t> user_recon_gains(12, 0);
-    DecodedUleb128 user_recon_gain_flag = 0;
-    for (const auto& [bit_position, user_recon_gain] :
-         user_recon_gains_layers[layer_index].recon_gain()) {
-      user_recon_gain_flag |= 1 << bit_position;
-      user_recon_gains[bit_position] = user_recon_gain;
-    }
-    for (const auto& [bit_position, user_recon_gain] :
-         user_recon_gains_layers[layer_index].recon_gain()) {
-      output_recon_gain_element->recon_gain[bit_position] =
-          user_recon_gains[bit_position];
+    for (int bit_position = 0; bit_position < 12; ++bit_position) {
+      if (user_recon_gain_flag & (1 << bit_position)) {
+        user_recon_gains[bit_position] =
+            user_recon_gains_layers[layer_index].recon_gain[bit_position];
+        output_recon_gain_element->recon_gain[bit_position] =
+            user_recon_gains[bit_position];
+      }
     }
     output_recon_gain_element->recon_gain_flag = user_recon_gain_flag;
 
@@ -419,11 +501,11 @@ absl::Status GenerateParameterBlockSubblock(
     const IdLabeledFrameMap* id_to_labeled_decoded_frame,
     const ParamDefinitionVariant& param_definition_variant,
     const bool include_subblock_duration, const int subblock_index,
-    const iamf_tools_cli_proto::ParameterSubblock& metadata_subblock,
+    const ParameterBlockMetadata::Subblock& metadata_subblock,
     ParameterBlockObu& obu) {
   if (include_subblock_duration) {
     RETURN_IF_NOT_OK(obu.SetSubblockDuration(
-        subblock_index, metadata_subblock.subblock_duration()));
+        subblock_index, metadata_subblock.subblock_duration));
   }
 
   auto& obu_subblock_param_data = obu.subblocks_[subblock_index].param_data;
@@ -439,9 +521,17 @@ absl::Status GenerateParameterBlockSubblock(
           std::get_if<MixGainParamDefinition>(&param_definition_variant);
       RETURN_IF_NOT_OK(
           ValidateNotNull(mix_gain_param_definition, "MixGainParamDefinition"));
-      RETURN_IF_NOT_OK(
-          GenerateMixGainSubblock(metadata_subblock.mix_gain_parameter_data(),
-                                  mix_gain_param_definition, parameter_data));
+      const auto* metadata_mix_gain_parameter_data =
+          std::get_if<MixGainParameterData>(&metadata_subblock.param_data);
+      RETURN_IF_NOT_OK(ValidateNotNull(metadata_mix_gain_parameter_data,
+                                       "Metadata `MixGainParameterData`"));
+      parameter_data = mix_gain_param_definition->CreateParameterData();
+      auto* mix_gain_parameter_data =
+          static_cast<MixGainParameterData*>(parameter_data.get());
+      mix_gain_parameter_data->animation_type =
+          metadata_mix_gain_parameter_data->animation_type;
+      mix_gain_parameter_data->param_data =
+          metadata_mix_gain_parameter_data->param_data;
       break;
     }
     case kParameterDefinitionDemixing: {
@@ -453,10 +543,17 @@ absl::Status GenerateParameterBlockSubblock(
           std::get_if<DemixingParamDefinition>(&param_definition_variant);
       RETURN_IF_NOT_OK(ValidateNotNull(demixing_param_definition,
                                        "DemixingParamDefinition"));
+      const auto* metadata_demixing_info_parameter_data =
+          std::get_if<DemixingInfoParameterData>(&metadata_subblock.param_data);
+      RETURN_IF_NOT_OK(ValidateNotNull(metadata_demixing_info_parameter_data,
+                                       "Metadata `DemixingInfoParameterData`"));
       parameter_data = demixing_param_definition->CreateParameterData();
-      RETURN_IF_NOT_OK(CopyDemixingInfoParameterData(
-          metadata_subblock.demixing_info_parameter_data(),
-          *static_cast<DemixingInfoParameterData*>(parameter_data.get())));
+      auto* demixing_info_parameter_data =
+          static_cast<DemixingInfoParameterData*>(parameter_data.get());
+      demixing_info_parameter_data->dmixp_mode =
+          metadata_demixing_info_parameter_data->dmixp_mode;
+      demixing_info_parameter_data->reserved =
+          metadata_demixing_info_parameter_data->reserved;
       break;
     }
     case kParameterDefinitionReconGain: {
@@ -468,11 +565,15 @@ absl::Status GenerateParameterBlockSubblock(
           std::get_if<ReconGainParamDefinition>(&param_definition_variant);
       RETURN_IF_NOT_OK(ValidateNotNull(recon_gain_param_definition,
                                        "ReconGainParamDefinition"));
+      const auto* user_recon_gains =
+          std::get_if<ParameterBlockMetadata::UserReconGains>(
+              &metadata_subblock.param_data);
+      RETURN_IF_NOT_OK(
+          ValidateNotNull(user_recon_gains, "Metadata user recon gains"));
       RETURN_IF_NOT_OK(GenerateReconGainSubblock(
           override_computed_recon_gains, additional_recon_gains_logging,
           *id_to_labeled_frame, *id_to_labeled_decoded_frame,
-          metadata_subblock.recon_gain_info_parameter_data(),
-          recon_gain_param_definition, parameter_data));
+          *user_recon_gains, recon_gain_param_definition, parameter_data));
       break;
     }
     default:
@@ -486,42 +587,34 @@ absl::Status GenerateParameterBlockSubblock(
 }
 
 absl::Status PopulateCommonFields(
-    const iamf_tools_cli_proto::ParameterBlockObuMetadata&
-        parameter_block_metadata,
+    const ParameterBlockMetadata& parameter_block_metadata,
     const ParamDefinition& param_definition,
     GlobalTimingModule& global_timing_module,
     ParameterBlockWithData& parameter_block_with_data) {
-  if (parameter_block_metadata.has_num_subblocks()) {
-    ABSL_LOG(WARNING)
-        << "Ignoring deprecated `num_subblocks` field in Parameter "
-           "Block OBU. Please remove it.";
-  }
-
   // Get the duration from the parameter definition or the OBU itself as
   // applicable.
   const DecodedUleb128 duration = param_definition.param_definition_mode_ == 1
-                                      ? parameter_block_metadata.duration()
+                                      ? parameter_block_metadata.duration
                                       : param_definition.duration_;
 
   // Populate the timing information.
   RETURN_IF_NOT_OK(global_timing_module.GetNextParameterBlockTimestamps(
-      parameter_block_metadata.parameter_id(),
-      parameter_block_metadata.start_timestamp(), duration,
+      parameter_block_metadata.parameter_id,
+      parameter_block_metadata.start_timestamp, duration,
       parameter_block_with_data.start_timestamp,
       parameter_block_with_data.end_timestamp));
 
   // Populate the OBU.
   if (param_definition.param_definition_mode_ == 0) {
     parameter_block_with_data.obu = ParameterBlockObu::CreateMode0(
-        GetHeaderFromMetadata(parameter_block_metadata.obu_header()),
-        param_definition);
+        parameter_block_metadata.obu_header, param_definition);
   } else {
     // Several fields are dependent on `param_definition_mode`.
     parameter_block_with_data.obu = ParameterBlockObu::CreateMode1(
-        GetHeaderFromMetadata(parameter_block_metadata.obu_header()),
-        param_definition, parameter_block_metadata.duration(),
-        parameter_block_metadata.constant_subblock_duration(),
-        parameter_block_metadata.subblocks_size());
+        parameter_block_metadata.obu_header, param_definition,
+        parameter_block_metadata.duration,
+        parameter_block_metadata.constant_subblock_duration,
+        parameter_block_metadata.subblocks.size());
   }
   RETURN_IF_NOT_OK(
       ValidateNotNull(parameter_block_with_data.obu, "ParameterBlockObu"));
@@ -530,8 +623,7 @@ absl::Status PopulateCommonFields(
 }
 
 absl::Status PopulateSubblocks(
-    const iamf_tools_cli_proto::ParameterBlockObuMetadata&
-        parameter_block_metadata,
+    const ParameterBlockMetadata& parameter_block_metadata,
     const bool override_computed_recon_gains,
     const bool additional_recon_gains_logging,
     const IdLabeledFrameMap* id_to_labeled_frame,
@@ -546,17 +638,17 @@ absl::Status PopulateSubblocks(
       GetParameterDefinitionMode(param_definition_variant) == 1 &&
       parameter_block_obu.GetConstantSubblockDuration() == 0;
 
-  if (num_subblocks != parameter_block_metadata.subblocks_size()) {
+  if (num_subblocks != parameter_block_metadata.subblocks.size()) {
     return absl::InvalidArgumentError(
         absl::StrCat("Expected ", num_subblocks, " subblocks, got ",
-                     parameter_block_metadata.subblocks_size()));
+                     parameter_block_metadata.subblocks.size()));
   }
   for (int i = 0; i < num_subblocks; ++i) {
     RETURN_IF_NOT_OK(GenerateParameterBlockSubblock(
         override_computed_recon_gains, additional_recon_gains_logging,
         id_to_labeled_frame, id_to_labeled_decoded_frame,
         param_definition_variant, include_subblock_duration, i,
-        parameter_block_metadata.subblocks(i), parameter_block_obu));
+        parameter_block_metadata.subblocks[i], parameter_block_obu));
   }
 
   return absl::OkStatus();
@@ -615,22 +707,59 @@ absl::Status ParameterBlockGenerator::Initialize(
 absl::Status ParameterBlockGenerator::AddMetadata(
     const iamf_tools_cli_proto::ParameterBlockObuMetadata&
         parameter_block_metadata) {
+  const auto param_definition_type =
+      LookupParameterDefinitionType(parameter_block_metadata.parameter_id());
+  if (!param_definition_type.ok()) {
+    return param_definition_type.status();
+  }
+  if (!IsGeneratedType(*param_definition_type)) {
+    return absl::OkStatus();
+  }
+
+  ParameterBlockMetadata converted_metadata;
+  RETURN_IF_NOT_OK(CopyParameterBlockMetadata(
+      parameter_block_metadata, *param_definition_type, converted_metadata));
+  return AddMetadata(std::move(converted_metadata));
+}
+
+absl::Status ParameterBlockGenerator::AddMetadata(
+    ParameterBlockMetadata parameter_block_metadata) {
+  const auto param_definition_type =
+      LookupParameterDefinitionType(parameter_block_metadata.parameter_id);
+  if (!param_definition_type.ok()) {
+    return param_definition_type.status();
+  }
+  if (!IsGeneratedType(*param_definition_type)) {
+    return absl::OkStatus();
+  }
+
+  typed_metadata_[*param_definition_type].push_back(
+      std::move(parameter_block_metadata));
+
+  return absl::OkStatus();
+}
+
+std::list<ParameterBlockMetadata>
+ParameterBlockGenerator::TakeReconGainMetadata() {
+  return std::exchange(
+      typed_metadata_[ParamDefinition::kParameterDefinitionReconGain], {});
+}
+
+absl::StatusOr<ParamDefinition::ParameterDefinitionType>
+ParameterBlockGenerator::LookupParameterDefinitionType(
+    DecodedUleb128 parameter_id) const {
   const auto& param_definition_iter =
-      param_definition_variants_.find(parameter_block_metadata.parameter_id());
+      param_definition_variants_.find(parameter_id);
   if (param_definition_iter == param_definition_variants_.end()) {
-    return absl::InvalidArgumentError(
-        absl::StrCat("No parameter definition found for parameter ID= ",
-                     parameter_block_metadata.parameter_id()));
+    return absl::InvalidArgumentError(absl::StrCat(
+        "No parameter definition found for parameter ID= ", parameter_id));
   }
   const auto& param_definition_type = std::visit(
       [](const auto& param_definition) { return param_definition.GetType(); },
       param_definition_iter->second);
   RETURN_IF_NOT_OK(
       ValidateHasValue(param_definition_type, "`param_definition_type`."));
-  typed_proto_metadata_[*param_definition_type].push_back(
-      parameter_block_metadata);
-
-  return absl::OkStatus();
+  return *param_definition_type;
 }
 
 absl::Status ParameterBlockGenerator::GenerateDemixing(
@@ -639,7 +768,7 @@ absl::Status ParameterBlockGenerator::GenerateDemixing(
   RETURN_IF_NOT_OK(GenerateParameterBlocks(
       /*id_to_labeled_frame=*/nullptr,
       /*id_to_labeled_decoded_frame=*/nullptr,
-      typed_proto_metadata_[ParamDefinition::kParameterDefinitionDemixing],
+      typed_metadata_[ParamDefinition::kParameterDefinitionDemixing],
       global_timing_module, output_parameter_blocks));
 
   return absl::OkStatus();
@@ -651,7 +780,7 @@ absl::Status ParameterBlockGenerator::GenerateMixGain(
   RETURN_IF_NOT_OK(GenerateParameterBlocks(
       /*id_to_labeled_frame=*/nullptr,
       /*id_to_labeled_decoded_frame=*/nullptr,
-      typed_proto_metadata_[ParamDefinition::kParameterDefinitionMixGain],
+      typed_metadata_[ParamDefinition::kParameterDefinitionMixGain],
       global_timing_module, output_parameter_blocks));
 
   return absl::OkStatus();
@@ -664,7 +793,7 @@ absl::Status ParameterBlockGenerator::GenerateReconGain(
     std::list<ParameterBlockWithData>& output_parameter_blocks) {
   RETURN_IF_NOT_OK(GenerateParameterBlocks(
       &id_to_labeled_frame, &id_to_labeled_decoded_frame,
-      typed_proto_metadata_[ParamDefinition::kParameterDefinitionReconGain],
+      typed_metadata_[ParamDefinition::kParameterDefinitionReconGain],
       global_timing_module, output_parameter_blocks));
   return absl::OkStatus();
 }
@@ -672,14 +801,13 @@ absl::Status ParameterBlockGenerator::GenerateReconGain(
 absl::Status ParameterBlockGenerator::GenerateParameterBlocks(
     const IdLabeledFrameMap* id_to_labeled_frame,
     const IdLabeledFrameMap* id_to_labeled_decoded_frame,
-    std::list<iamf_tools_cli_proto::ParameterBlockObuMetadata>&
-        proto_metadata_list,
+    std::list<ParameterBlockMetadata>& metadata_list,
     GlobalTimingModule& global_timing_module,
     std::list<ParameterBlockWithData>& output_parameter_blocks) {
-  for (auto& parameter_block_metadata : proto_metadata_list) {
+  for (const auto& parameter_block_metadata : metadata_list) {
     ParameterBlockWithData output_parameter_block;
     const auto& param_definition_variant =
-        param_definition_variants_.at(parameter_block_metadata.parameter_id());
+        param_definition_variants_.at(parameter_block_metadata.parameter_id);
     const auto* param_definition_base = std::visit(
         [](const auto& param_definition) {
           return static_cast<const ParamDefinition*>(&param_definition);
@@ -710,7 +838,7 @@ absl::Status ParameterBlockGenerator::GenerateParameterBlocks(
   }
 
   // Clear the metadata of this frame.
-  proto_metadata_list.clear();
+  metadata_list.clear();
 
   return absl::OkStatus();
 }
@@ -17,9 +17,11 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "iamf/cli/audio_element_with_data.h"
 #include "iamf/cli/demixing_module.h"
 #include "iamf/cli/global_timing_module.h"
+#include "iamf/cli/parameter_block_metadata.h"
 #include "iamf/cli/parameter_block_with_data.h"
 #include "iamf/cli/proto/parameter_block.pb.h"
 #include "iamf/obu/param_definitions/param_definition_base.h"
@@ -83,6 +85,24 @@ class ParameterBlockGenerator {
       const iamf_tools_cli_proto::ParameterBlockObuMetadata&
           parameter_block_metadata);
 
+  /*!\brief Adds one parameter block metadata, already converted.
+   *
+   * Avoids any protocol buffers, when the metadata is provided frequently.
+   *
+   * \param parameter_block_metadata parameter block metadata to add.
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status AddMetadata(ParameterBlockMetadata parameter_block_metadata);
+
+  /*!\brief Moves out the recon gain metadata added so far.
+   *
+   * Allows the recon gain parameter blocks to be generated by another
+   * generator, for example one used on a different thread.
+   *
+   * \return Recon gain metadata in the order it was added.
+   */
+  std::list<ParameterBlockMetadata> TakeReconGainMetadata();
+
   /*!\brief Generates a list of demixing parameter blocks with data.
    *
    * \param global_timing_module Global timing module to keep track of the
@@ -121,10 +141,19 @@ class ParameterBlockGenerator {
       std::list<ParameterBlockWithData>& output_parameter_blocks);
 
  private:
+  /*!\brief Looks up the type of a parameter definition.
+   *
+   * \param parameter_id Parameter ID to look up.
+   * \return Type of the parameter definition on success. A specific status on
+   *         failure.
+   */
+  absl::StatusOr<ParamDefinition::ParameterDefinitionType>
+  LookupParameterDefinitionType(DecodedUleb128 parameter_id) const;
+
   /*!\brief Generates a list of parameter blocks with data.
    *
-   * \param proto_metadata_list Input list of user-defined metadata about
-   *        parameter blocks.
+   * \param metadata_list Input list of user-defined metadata about parameter
+   *        blocks. Cleared after generating.
    * \param global_timing_module Global Timing Module.
    * \param output_parameter_blocks Output list of parameter blocks with data.
    * \return `absl::OkStatus()` on success. A specific status on failure.
@@ -132,8 +161,7 @@ class ParameterBlockGenerator {
   absl::Status GenerateParameterBlocks(
       const IdLabeledFrameMap* id_to_labeled_frame,
       const IdLabeledFrameMap* id_to_labeled_decoded_frame,
-      std::list<iamf_tools_cli_proto::ParameterBlockObuMetadata>&
-          proto_metadata_list,
+      std::list<ParameterBlockMetadata>& metadata_list,
       GlobalTimingModule& global_timing_module,
       std::list<ParameterBlockWithData>& output_parameter_blocks);
 
@@ -148,10 +176,9 @@ class ParameterBlockGenerator {
 
   // User metadata about Parameter Block OBUs categorized based on
   // the parameter definition type.
-  absl::flat_hash_map<
-      ParamDefinition::ParameterDefinitionType,
-      std::list<iamf_tools_cli_proto::ParameterBlockObuMetadata>>
-      typed_proto_metadata_;
+  absl::flat_hash_map<ParamDefinition::ParameterDefinitionType,
+                      std::list<ParameterBlockMetadata>>
+      typed_metadata_;
 };
 
 }  // namespace iamf_tools
@@ -106,7 +106,8 @@ void InitializeAudioFrameGenerator(
   auto temp_audio_frame_generator = AudioFrameGenerator::Create(
       user_metadata.audio_frame_metadata(),
       user_metadata.codec_config_metadata(), audio_elements, *demixing_module,
-      *parameters_manager, *global_timing_module);
+      *parameters_manager, *global_timing_module,
+      /*num_frames_per_encoding_chunk=*/0);
   ABSL_CHECK_OK(temp_audio_frame_generator);
   audio_frame_generator = std::move(*temp_audio_frame_generator);
 }
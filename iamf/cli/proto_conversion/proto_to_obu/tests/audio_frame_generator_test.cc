@@ -310,7 +310,8 @@ void InitializeAudioFrameGenerator(
     std::unique_ptr<GlobalTimingModule>& global_timing_module,
     std::unique_ptr<ParametersManager>& parameters_manager,
     std::unique_ptr<AudioFrameGenerator>& audio_frame_generator,
-    bool expected_initialize_is_ok = true) {
+    bool expected_initialize_is_ok = true,
+    uint32_t num_frames_per_encoding_chunk = 0) {
   // Initialize pre-requisite OBUs and the global timing module. This is all
   // derived from the `user_metadata`.
   CodecConfigGenerator codec_config_generator(
@@ -338,7 +339,8 @@ void InitializeAudioFrameGenerator(
   auto temp_audio_frame_generator = AudioFrameGenerator::Create(
       user_metadata.audio_frame_metadata(),
       user_metadata.codec_config_metadata(), audio_elements, *demixing_module,
-      *parameters_manager, *global_timing_module);
+      *parameters_manager, *global_timing_module,
+      num_frames_per_encoding_chunk);
 
   // Initialize.
   if (expected_initialize_is_ok) {
@@ -1393,5 +1395,153 @@ TEST(AudioFrameGenerator, ManyFramesThreaded) {
   }
 }
 
+void Configure5_1LpcmLittleEndian(
+    iamf_tools_cli_proto::UserMetadata& user_metadata) {
+  ASSERT_TRUE(google::protobuf::TextFormat::ParseFromString(
+      R"pb(
+        codec_config_id: 99
+        codec_config {
+          codec_id: CODEC_ID_LPCM
+          num_samples_per_frame: 8
+          audio_roll_distance: 0
+          decoder_config_lpcm {
+            sample_format_flags: LPCM_LITTLE_ENDIAN
+            sample_size: 16
+            sample_rate: 48000
+          }
+        }
+      )pb",
+      user_metadata.add_codec_config_metadata()));
+  auto* audio_frame_metadata = user_metadata.add_audio_frame_metadata();
+  ASSERT_TRUE(google::protobuf::TextFormat::ParseFromString(
+      R"pb(
+        wav_filename: ""
+        samples_to_trim_at_end: 0
+        samples_to_trim_at_start: 0
+        channel_metadatas:
+        [ { channel_id: 0 channel_label: CHANNEL_LABEL_L_5 }
+          , { channel_id: 1 channel_label: CHANNEL_LABEL_R_5 }
+          , { channel_id: 2 channel_label: CHANNEL_LABEL_CENTRE }
+          , { channel_id: 3 channel_label: CHANNEL_LABEL_LFE }
+          , { channel_id: 4 channel_label: CHANNEL_LABEL_LS_5 }
+          , { channel_id: 5 channel_label: CHANNEL_LABEL_RS_5 }]
+      )pb",
+      audio_frame_metadata));
+  audio_frame_metadata->set_audio_element_id(kFirstAudioElementId);
+
+  AudioElementMetadataBuilder builder;
+  ASSERT_THAT(builder.PopulateAudioElementMetadata(
+                  kFirstAudioElementId, kCodecConfigId, IamfInputLayout::k5_1,
+                  *user_metadata.add_audio_element_metadata()),
+              IsOk());
+}
+
+void ExpectEncodingIsByteIdenticalToSerialEncoding(
+    uint32_t num_frames_per_encoding_chunk) {
+  constexpr int kNumFrames = 200;
+  constexpr int kFrameSize = 8;
+  iamf_tools_cli_proto::UserMetadata user_metadata = {};
+  Configure5_1LpcmLittleEndian(user_metadata);
+  absl::flat_hash_map<uint32_t, CodecConfigObu> codec_config_obus = {};
+  absl::flat_hash_map<uint32_t, AudioElementWithData> audio_elements = {};
+  const absl::flat_hash_map<uint32_t, ParamDefinitionVariant>
+      param_definitions = {};
+  std::unique_ptr<GlobalTimingModule> global_timing_module;
+  std::unique_ptr<ParametersManager> parameters_manager;
+  std::unique_ptr<AudioFrameGenerator> audio_frame_generator;
+  InitializeAudioFrameGenerator(
+      user_metadata, param_definitions, codec_config_obus, audio_elements,
+      global_timing_module, parameters_manager, audio_frame_generator,
+      /*expected_initialize_is_ok=*/true, num_frames_per_encoding_chunk);
+  const auto& substream_id_to_labels =
+      audio_elements.at(kFirstAudioElementId).substream_id_to_labels;
+  // Several substreams are needed for the encoders to run in parallel.
+  ASSERT_GT(substream_id_to_labels.size(), 1);
+
+  // Give every sample of every channel a distinct 16-bit value.
+  const std::vector<ChannelLabel::Label> kLabels = {
+      ChannelLabel::kL5,  ChannelLabel::kR5,  ChannelLabel::kCentre,
+      ChannelLabel::kLFE, ChannelLabel::kLs5, ChannelLabel::kRs5};
+  absl::flat_hash_map<ChannelLabel::Label, std::vector<int16_t>>
+      label_to_int16_samples;
+  absl::flat_hash_map<ChannelLabel::Label,
+                      std::vector<std::vector<InternalSampleType>>>
+      label_to_samples;
+  for (int c = 0; c < kLabels.size(); ++c) {
+    auto& int16_samples = label_to_int16_samples[kLabels[c]];
+    auto& samples = label_to_samples[kLabels[c]];
+    samples.resize(kNumFrames);
+    for (int i = 0; i < kNumFrames * kFrameSize; ++i) {
+      const int16_t sample = static_cast<int16_t>(c * 4096 + i);
+      int16_samples.push_back(sample);
+      samples[i / kFrameSize].push_back(
+          Int32ToNormalizedFloatingPoint<InternalSampleType>(
+              static_cast<int32_t>(sample) << 16));
+    }
+  }
+  absl::flat_hash_map<ChannelLabel::Label,
+                      std::vector<absl::Span<const InternalSampleType>>>
+      label_to_frames;
+  for (const auto& [label, frames] : label_to_samples) {
+    for (const auto& frame : frames) {
+      label_to_frames[label].push_back(absl::MakeConstSpan(frame));
+    }
+  }
+
+  // Serially encode the reference payloads: little-endian 16-bit samples,
+  // interleaved in the order of the labels of each substream.
+  absl::flat_hash_map<DecodedUleb128, std::vector<std::vector<uint8_t>>>
+      expected_substream_id_to_payloads;
+  for (const auto& [substream_id, labels] : substream_id_to_labels) {
+    auto& payloads = expected_substream_id_to_payloads[substream_id];
+    for (int frame = 0; frame < kNumFrames; ++frame) {
+      std::vector<uint8_t> payload;
+      for (int tick = 0; tick < kFrameSize; ++tick) {
+        for (const auto& label : labels) {
+          const auto sample = static_cast<uint16_t>(
+              label_to_int16_samples.at(label)[frame * kFrameSize + tick]);
+          payload.push_back(static_cast<uint8_t>(sample & 0xff));
+          payload.push_back(static_cast<uint8_t>(sample >> 8));
+        }
+      }
+      payloads.push_back(payload);
+    }
+  }
+
+  AddAllSamplesAndFinalizesExpectOk(kFirstAudioElementId, label_to_frames,
+                                    *audio_frame_generator);
+  std::list<AudioFrameWithData> output_audio_frames;
+  FlushAudioFrameGeneratorExpectOk(*audio_frame_generator,
+                                   output_audio_frames);
+
+  absl::flat_hash_map<DecodedUleb128, std::vector<std::vector<uint8_t>>>
+      substream_id_to_payloads;
+  for (const auto& audio_frame : output_audio_frames) {
+    auto& payloads = substream_id_to_payloads[audio_frame.obu.GetSubstreamId()];
+    // Frames keep their timestamps, in order.
+    EXPECT_EQ(audio_frame.start_timestamp, payloads.size() * kFrameSize);
+    payloads.push_back(audio_frame.obu.audio_frame_);
+  }
+  ASSERT_EQ(substream_id_to_payloads.size(),
+            expected_substream_id_to_payloads.size());
+  for (const auto& [substream_id, expected_payloads] :
+       expected_substream_id_to_payloads) {
+    ASSERT_TRUE(substream_id_to_payloads.contains(substream_id));
+    EXPECT_THAT(substream_id_to_payloads.at(substream_id),
+                ElementsAreArray(expected_payloads));
+  }
+}
+
+TEST(AudioFrameGenerator, ParallelEncodingIsByteIdenticalToSerialEncoding) {
+  ExpectEncodingIsByteIdenticalToSerialEncoding(
+      /*num_frames_per_encoding_chunk=*/0);
+}
+
+TEST(AudioFrameGenerator, ChunkedEncodingIsByteIdenticalToSerialEncoding) {
+  // The last chunk is partial.
+  ExpectEncodingIsByteIdenticalToSerialEncoding(
+      /*num_frames_per_encoding_chunk=*/7);
+}
+
 }  // namespace
 }  // namespace iamf_tools
@@ -29,6 +29,7 @@
 #include "iamf/cli/demixing_module.h"
 #include "iamf/cli/global_timing_module.h"
 #include "iamf/cli/obu_with_data_generator.h"
+#include "iamf/cli/parameter_block_metadata.h"
 #include "iamf/cli/parameter_block_with_data.h"
 #include "iamf/cli/proto/parameter_block.pb.h"
 #include "iamf/cli/proto/user_metadata.pb.h"
@@ -51,6 +52,7 @@ namespace iamf_tools {
 namespace {
 
 using ::absl_testing::IsOk;
+using ::testing::Not;
 using ::testing::NotNull;
 
 constexpr DecodedUleb128 kCodecConfigId = 200;
@@ -332,6 +334,101 @@ TEST(ParameterBlockGeneratorTest, GenerateMixGainParameterBlocks) {
   }
 }
 
+ParameterBlockMetadata MakeMixGainMetadata(
+    InternalTimestamp start_timestamp,
+    const MixGainParameterData& mix_gain_parameter_data) {
+  ParameterBlockMetadata metadata{.parameter_id = kParameterId,
+                                  .start_timestamp = start_timestamp,
+                                  .duration = kDuration,
+                                  .constant_subblock_duration = kDuration};
+  metadata.subblocks.push_back({.param_data = mix_gain_parameter_data});
+  return metadata;
+}
+
+TEST(ParameterBlockGeneratorTest,
+     GenerateMixGainParameterBlocksFromTypedMetadata) {
+  absl::flat_hash_map<DecodedUleb128, CodecConfigObu> codec_config_obus;
+  absl::flat_hash_map<DecodedUleb128, AudioElementWithData> audio_elements;
+  InitializePrerequisiteObus(IamfInputLayout::kStereo, kOneSubstreamId,
+                             codec_config_obus, audio_elements);
+  MixGainParamDefinition param_definition;
+  absl::flat_hash_map<DecodedUleb128, ParamDefinitionVariant>
+      param_definition_variants;
+  AddMixGainParamDefinition(/*default_mix_gain=*/0, param_definition,
+                            param_definition_variants);
+  ParameterBlockGenerator generator(kOverrideComputedReconGains,
+                                    param_definition_variants);
+  EXPECT_THAT(generator.Initialize(audio_elements), IsOk());
+  auto global_timing_module =
+      GlobalTimingModule::Create(audio_elements, param_definition_variants);
+  ASSERT_THAT(global_timing_module, NotNull());
+  const MixGainParameterData kLinearMixGain(
+      MixGainParameterData::kAnimateLinear,
+      AnimationLinearInt16{.start_point_value = 0, .end_point_value = -256});
+
+  EXPECT_THAT(generator.AddMetadata(MakeMixGainMetadata(0, kLinearMixGain)),
+              IsOk());
+  std::list<ParameterBlockWithData> output_parameter_blocks;
+  EXPECT_THAT(
+      generator.GenerateMixGain(*global_timing_module, output_parameter_blocks),
+      IsOk());
+
+  ValidateParameterBlocksCommon(output_parameter_blocks, kParameterId,
+                                /*expected_start_timestamps=*/{0},
+                                /*expected_end_timestamps=*/{8});
+  const auto* mix_gain_parameter_data = static_cast<MixGainParameterData*>(
+      output_parameter_blocks.front().obu->subblocks_[0].param_data.get());
+  EXPECT_EQ(mix_gain_parameter_data->animation_type,
+            MixGainParameterData::kAnimateLinear);
+  EXPECT_EQ(
+      std::get<AnimationLinearInt16>(mix_gain_parameter_data->param_data),
+      (AnimationLinearInt16{.start_point_value = 0, .end_point_value = -256}));
+}
+
+TEST(ParameterBlockGeneratorTest,
+     GenerateMixGainFailsForTypedMetadataOfTheWrongType) {
+  absl::flat_hash_map<DecodedUleb128, CodecConfigObu> codec_config_obus;
+  absl::flat_hash_map<DecodedUleb128, AudioElementWithData> audio_elements;
+  InitializePrerequisiteObus(IamfInputLayout::kStereo, kOneSubstreamId,
+                             codec_config_obus, audio_elements);
+  MixGainParamDefinition param_definition;
+  absl::flat_hash_map<DecodedUleb128, ParamDefinitionVariant>
+      param_definition_variants;
+  AddMixGainParamDefinition(/*default_mix_gain=*/0, param_definition,
+                            param_definition_variants);
+  ParameterBlockGenerator generator(kOverrideComputedReconGains,
+                                    param_definition_variants);
+  EXPECT_THAT(generator.Initialize(audio_elements), IsOk());
+  auto global_timing_module =
+      GlobalTimingModule::Create(audio_elements, param_definition_variants);
+  ASSERT_THAT(global_timing_module, NotNull());
+  ParameterBlockMetadata metadata{.parameter_id = kParameterId,
+                                  .start_timestamp = 0,
+                                  .duration = kDuration,
+                                  .constant_subblock_duration = kDuration};
+  metadata.subblocks.push_back(
+      {.param_data = DemixingInfoParameterData(
+           DemixingInfoParameterData::kDMixPMode1, 0)});
+  EXPECT_THAT(generator.AddMetadata(std::move(metadata)), IsOk());
+
+  std::list<ParameterBlockWithData> output_parameter_blocks;
+  EXPECT_THAT(
+      generator.GenerateMixGain(*global_timing_module, output_parameter_blocks),
+      Not(IsOk()));
+}
+
+TEST(AddMetadata, FailsForUnknownParameterId) {
+  const absl::flat_hash_map<DecodedUleb128, ParamDefinitionVariant>
+      kNoParamDefinitions;
+  ParameterBlockGenerator generator(kOverrideComputedReconGains,
+                                    kNoParamDefinitions);
+
+  EXPECT_THAT(generator.AddMetadata(MakeMixGainMetadata(
+                  0, MixGainParameterData(MixGainParameterData::kAnimateStep,
+                                          AnimationStepInt16{}))),
+              Not(IsOk()));
+}
+
 TEST(ParameterBlockGeneratorTest, IgnoresDeprecatedNumSubblocks) {
   iamf_tools_cli_proto::UserMetadata user_metadata;
   ConfigureMixGainParameterBlocks(user_metadata);
@@ -12,6 +12,7 @@
 #include "iamf/cli/proto_conversion/output_audio_format_utils.h"
 
 #include <cstddef>
+#include <memory>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -19,6 +20,7 @@
 #include "iamf/cli/proto/parameter_data.pb.h"
 #include "iamf/cli/rendering_mix_presentation_finalizer.h"
 #include "iamf/cli/tests/cli_test_utils.h"
+#include "iamf/cli/true_peak_limiter.h"
 #include "iamf/obu/mix_presentation.h"
 #include "iamf/obu/types.h"
 
@@ -26,6 +28,10 @@ namespace iamf_tools {
 namespace {
 
 using ::testing::_;
+using ::testing::ByMove;
+using ::testing::IsNull;
+using ::testing::NotNull;
+using ::testing::Return;
 
 typedef RenderingMixPresentationFinalizer::SampleProcessorFactory
     SampleProcessorFactory;
@@ -104,6 +110,48 @@ TEST(GetWavSampleProcessorFactoryFromOutputAudioFormat,
                            kBitDepth16, kMaxInputSamplesPerFrame);
 }
 
+TEST(ApplyTruePeakLimiterToSampleProcessorFactory,
+     WrapsTheSampleProcessorsInALimiter) {
+  constexpr size_t kNumSamplesPerFrame = 1024;
+  MockSampleProcessorFactory mock_factory;
+  EXPECT_CALL(mock_factory, Call(kMixPresentationId, kSubMixIndex, kLayoutIndex,
+                                 kStereoLayout, kNumChannels, kSampleRate,
+                                 kBitDepth16, kNumSamplesPerFrame))
+      .WillOnce(Return(ByMove(std::make_unique<MockSampleProcessor>(
+          kNumSamplesPerFrame, kNumChannels, kNumSamplesPerFrame))));
+  SampleProcessorFactory sample_processor_factory =
+      mock_factory.AsStdFunction();
+
+  ApplyTruePeakLimiterToSampleProcessorFactory(TruePeakLimiter::Settings(),
+                                               sample_processor_factory);
+
+  const auto sample_processor = sample_processor_factory(
+      kMixPresentationId, kSubMixIndex, kLayoutIndex, kStereoLayout,
+      kNumChannels, kSampleRate, kBitDepth16, kNumSamplesPerFrame);
+  ASSERT_THAT(sample_processor, NotNull());
+  // The limiter reports its latency, unlike the wrapped mock.
+  EXPECT_GT(sample_processor->GetLatency(), 0);
+}
+
+TEST(ApplyTruePeakLimiterToSampleProcessorFactory,
+     ReturnsNullWhenTheOriginalFactoryReturnsNull) {
+  constexpr size_t kNumSamplesPerFrame = 1024;
+  MockSampleProcessorFactory mock_factory;
+  EXPECT_CALL(mock_factory, Call(_, _, _, _, _, _, _, _))
+      .WillOnce(Return(nullptr));
+  SampleProcessorFactory sample_processor_factory =
+      mock_factory.AsStdFunction();
+
+  ApplyTruePeakLimiterToSampleProcessorFactory(TruePeakLimiter::Settings(),
+                                               sample_processor_factory);
+
+  EXPECT_THAT(sample_processor_factory(kMixPresentationId, kSubMixIndex,
+                                       kLayoutIndex, kStereoLayout,
+                                       kNumChannels, kSampleRate, kBitDepth16,
+                                       kNumSamplesPerFrame),
+              IsNull());
+}
+
 struct BitDepthOverrideTestParam {
   int initial_bit_depth;
   iamf_tools_cli_proto::OutputAudioFormat output_audio_format;
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/cli/renderer/audio_element_renderer_async.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_log.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "iamf/cli/demixing_module.h"
+#include "iamf/cli/renderer/audio_element_renderer_base.h"
+#include "iamf/cli/renderer/renderer_utils.h"
+#include "iamf/common/utils/macros.h"
+#include "iamf/common/utils/thread_pool.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+
+std::unique_ptr<AudioElementRendererAsync> AudioElementRendererAsync::Create(
+    std::unique_ptr<AudioElementRendererBase> renderer) {
+  if (renderer == nullptr) {
+    ABSL_LOG(ERROR) << "Cannot render asynchronously without a renderer.";
+    return nullptr;
+  }
+  return absl::WrapUnique(new AudioElementRendererAsync(std::move(renderer)));
+}
+
+AudioElementRendererAsync::AudioElementRendererAsync(
+    std::unique_ptr<AudioElementRendererBase> renderer)
+    : AudioElementRendererBase(renderer->ordered_labels_,
+                               renderer->num_samples_per_frame_,
+                               renderer->num_output_channels_),
+      renderer_(std::move(renderer)) {}
+
+AudioElementRendererAsync::~AudioElementRendererAsync() {
+  absl::MutexLock lock(&mutex_);
+  // Drop a frame which was not started yet; the pool task returns without
+  // touching this renderer once the frame is claimed.
+  if (queued_frame_claimed_ != nullptr &&
+      !queued_frame_claimed_->exchange(true)) {
+    queued_labeled_frame_ = nullptr;
+    num_frames_in_flight_--;
+  }
+  mutex_.Await(
+      absl::Condition(this, &AudioElementRendererAsync::NoFramesInFlight));
+}
+
+absl::Status AudioElementRendererAsync::Finalize() {
+  RenderUnstartedFrames();
+
+  absl::MutexLock lock(&mutex_);
+  mutex_.Await(
+      absl::Condition(this, &AudioElementRendererAsync::NoFramesInFlight));
+  RETURN_IF_NOT_OK(frames_in_flight_status_);
+  RETURN_IF_NOT_OK(renderer_->Finalize());
+
+  is_finalized_ = true;
+  return absl::OkStatus();
+}
+
+bool AudioElementRendererAsync::IsFinalized() const {
+  absl::MutexLock lock(&mutex_);
+  return is_finalized_ && renderer_->IsFinalized();
+}
+
+absl::StatusOr<size_t> AudioElementRendererAsync::RenderLabeledFrame(
+    const LabeledFrame& labeled_frame) {
+  // Only one frame is in flight at a time.
+  RenderUnstartedFrames();
+
+  std::shared_ptr<std::atomic<bool>> claimed;
+  size_t num_valid_ticks = 0;
+  {
+    absl::MutexLock lock(&mutex_);
+    mutex_.Await(
+        absl::Condition(this, &AudioElementRendererAsync::NoFramesInFlight));
+    RETURN_IF_NOT_OK(frames_in_flight_status_);
+
+    // Validate the frame and count its ticks up front, without arranging the
+    // samples; the wrapped renderer arranges them when rendering.
+    const auto num_ticks =
+        GetNumTicksToRender(labeled_frame, ordered_labels_, kEmptyChannel);
+    if (!num_ticks.ok()) {
+      return num_ticks.status();
+    }
+    num_valid_ticks = *num_ticks;
+
+    queued_labeled_frame_ = &labeled_frame;
+    queued_frame_claimed_ = std::make_shared<std::atomic<bool>>(false);
+    claimed = queued_frame_claimed_;
+    num_frames_in_flight_++;
+  }
+
+  ThreadPool::GetShared().Schedule([this, claimed = std::move(claimed)] {
+    if (!claimed->exchange(true)) {
+      RenderClaimedFrame();
+    }
+  });
+  return num_valid_ticks;
+}
+
+absl::Status AudioElementRendererAsync::RenderSamples(
+    absl::Span<const absl::Span<const InternalSampleType>> samples_to_render) {
+  return absl::FailedPreconditionError(
+      "Frames are rendered by the wrapped renderer.");
+}
+
+void AudioElementRendererAsync::RenderUnstartedFrames() {
+  std::shared_ptr<std::atomic<bool>> claimed;
+  {
+    absl::MutexLock lock(&mutex_);
+    claimed = queued_frame_claimed_;
+  }
+  if (claimed != nullptr && !claimed->exchange(true)) {
+    RenderClaimedFrame();
+  }
+}
+
+void AudioElementRendererAsync::RenderClaimedFrame() {
+  const LabeledFrame* labeled_frame = nullptr;
+  {
+    absl::MutexLock lock(&mutex_);
+    labeled_frame = queued_labeled_frame_;
+  }
+
+  // Render without holding the lock, so callers can flush other frames or
+  // query the renderer in the meantime.
+  const auto status = renderer_->RenderLabeledFrame(*labeled_frame).status();
+  if (status.ok()) {
+    renderer_->Flush(claimed_rendered_samples_);
+  }
+
+  absl::MutexLock lock(&mutex_);
+  if (status.ok()) {
+    rendered_samples_.resize(claimed_rendered_samples_.size());
+    for (int c = 0; c < claimed_rendered_samples_.size(); c++) {
+      rendered_samples_[c].insert(rendered_samples_[c].end(),
+                                  claimed_rendered_samples_[c].begin(),
+                                  claimed_rendered_samples_[c].end());
+      claimed_rendered_samples_[c].clear();
+    }
+  } else if (frames_in_flight_status_.ok()) {
+    frames_in_flight_status_ = status;
+  }
+
+  // Wakes up any caller waiting in `FlushWhenReady()` or `Finalize()`.
+  queued_labeled_frame_ = nullptr;
+  queued_frame_claimed_ = nullptr;
+  num_frames_in_flight_--;
+}
+
+}  // namespace iamf_tools
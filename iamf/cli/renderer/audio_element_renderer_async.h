@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#ifndef CLI_RENDERER_AUDIO_ELEMENT_RENDERER_ASYNC_H_
+#define CLI_RENDERER_AUDIO_ELEMENT_RENDERER_ASYNC_H_
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "iamf/cli/demixing_module.h"
+#include "iamf/cli/renderer/audio_element_renderer_base.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+/*!\brief Renders frames of another renderer on the shared thread pool.
+ *
+ * `RenderLabeledFrame()` schedules the frame on `ThreadPool::GetShared()` and
+ * returns immediately, so the caller can do other work, such as submitting
+ * frames to the renderers of other layouts, while the frame is being rendered.
+ * The frame is rendered with `RenderLabeledFrame()` of the wrapped renderer,
+ * without holding the lock of this renderer, and completion is signalled
+ * through the mutex condition used by `FlushWhenReady()`.
+ *
+ * Whichever thread claims the frame first renders it. Callers of
+ * `FlushWhenReady()`, `Finalize()` and `RenderLabeledFrame()` claim a frame
+ * which was not started yet before waiting for it, so they never wait for a
+ * task stuck in the pool queue, even when they run on the pool themselves.
+ *
+ * At most one frame is in flight at a time; `RenderLabeledFrame()` waits for
+ * the previous frame to finish before scheduling the next one. The frame is
+ * not copied, so the labeled frame must outlive the rendering, i.e. until
+ * `FlushWhenReady()` or `Finalize()` returns.
+ */
+class AudioElementRendererAsync : public AudioElementRendererBase {
+ public:
+  /*!\brief Creates an asynchronous renderer.
+   *
+   * \param renderer Renderer to drive from the shared thread pool.
+   * \return Asynchronous renderer or `nullptr` if `renderer` is `nullptr`.
+   */
+  static std::unique_ptr<AudioElementRendererAsync> Create(
+      std::unique_ptr<AudioElementRendererBase> renderer);
+
+  /*!\brief Destructor. Drops any frame which was not started yet and waits
+   *        for the frame being rendered.
+   */
+  ~AudioElementRendererAsync() override;
+
+  /*!\brief Schedules a labeled frame to be rendered on the shared pool.
+   *
+   * \param labeled_frame Labeled frame to render. Must outlive the rendering.
+   * \return Number of ticks that will be rendered. The first error encountered
+   *         while rendering previous frames or a specific status on failure.
+   */
+  absl::StatusOr<size_t> RenderLabeledFrame(
+      const LabeledFrame& labeled_frame) override;
+
+  /*!\brief Checks if the renderer finishes frames after returning.
+   *
+   * \return `true`.
+   */
+  bool IsAsynchronous() const override { return true; }
+
+  /*!\brief Finalizes the renderer. Waits for any frame in flight.
+   *
+   * \return `absl::OkStatus()` on success. The first error encountered while
+   *         rendering or a specific status on failure.
+   */
+  absl::Status Finalize() override;
+
+  /*!\brief Checks if the renderer is finalized.
+   *
+   * \return `true` if both this and the wrapped renderer are finalized.
+   *         `false` otherwise.
+   */
+  bool IsFinalized() const override;
+
+ private:
+  /*!\brief Constructor.
+   *
+   * \param renderer Renderer to drive from the shared thread pool.
+   */
+  explicit AudioElementRendererAsync(
+      std::unique_ptr<AudioElementRendererBase> renderer);
+
+  /*!\brief Unused; frames are rendered by the wrapped renderer.
+   *
+   * \param samples_to_render Unused.
+   * \return `absl::FailedPreconditionError()`.
+   */
+  absl::Status RenderSamples(
+      absl::Span<const absl::Span<const InternalSampleType>> samples_to_render)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) override;
+
+  /*!\brief Renders the queued frame if no other thread claimed it yet. */
+  void RenderUnstartedFrames() override;
+
+  /*!\brief Renders the queued frame, which the caller claimed. */
+  void RenderClaimedFrame();
+
+  // Only used by the thread which claimed the queued frame while no lock is
+  // held, or by the owner thread when there are no frames in flight.
+  const std::unique_ptr<AudioElementRendererBase> renderer_;
+  std::vector<std::vector<InternalSampleType>> claimed_rendered_samples_;
+
+  // Labeled frame in flight.
+  const LabeledFrame* queued_labeled_frame_ ABSL_GUARDED_BY(mutex_) = nullptr;
+
+  // Set by the first thread to claim the queued frame. Shared with the pool
+  // task, which may outlive this renderer if another thread claimed the frame.
+  std::shared_ptr<std::atomic<bool>> queued_frame_claimed_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace iamf_tools
+#endif  // CLI_RENDERER_AUDIO_ELEMENT_RENDERER_ASYNC_H_
@@ -14,6 +14,7 @@
 #include <cstddef>
 #include <vector>
 
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
@@ -25,6 +26,23 @@
 
 namespace iamf_tools {
 
+namespace {
+
+void AppendAndClearRenderedSamples(
+    std::vector<std::vector<InternalSampleType>>& source,
+    std::vector<std::vector<InternalSampleType>>& destination) {
+  // Append samples in each channel of `source` to the corresponding channel of
+  // `destination`.
+  destination.resize(source.size());
+  for (int c = 0; c < source.size(); c++) {
+    destination[c].insert(destination[c].end(), source[c].begin(),
+                          source[c].end());
+    source[c].clear();
+  }
+}
+
+}  // namespace
+
 AudioElementRendererBase::AudioElementRendererBase(
     absl::Span<const ChannelLabel::Label> ordered_labels,
     const size_t num_samples_per_frame, const size_t num_output_channels)
@@ -53,19 +71,39 @@ absl::StatusOr<size_t> AudioElementRendererBase::RenderLabeledFrame(
   return num_valid_samples;
 }
 
+absl::Status AudioElementRendererBase::RenderLabeledFrameAsView(
+    const LabeledFrame& labeled_frame,
+    std::vector<absl::Span<const InternalSampleType>>& rendered_samples)
+    const {
+  if (!IsPassThrough()) {
+    return absl::FailedPreconditionError(
+        "Only pass-through renderers can render a frame as a view.");
+  }
+  // `ordered_labels_` and `kEmptyChannel` are immutable, so there is no need
+  // to lock.
+  rendered_samples.resize(ordered_labels_.size());
+  size_t unused_num_valid_samples = 0;
+  return iamf_tools::ArrangeSamplesToRender(labeled_frame, ordered_labels_,
+                                            kEmptyChannel, rendered_samples,
+                                            unused_num_valid_samples);
+}
+
 void AudioElementRendererBase::Flush(
     std::vector<std::vector<InternalSampleType>>& rendered_samples) {
   absl::MutexLock lock(&mutex_);
+  AppendAndClearRenderedSamples(rendered_samples_, rendered_samples);
+}
 
-  // Append samples in each channel of `rendered_samples_` to the corresponding
-  // channel of the output `rendered_samples`.
-  rendered_samples.resize(rendered_samples_.size());
-  for (int c = 0; c < rendered_samples_.size(); c++) {
-    rendered_samples[c].insert(rendered_samples[c].end(),
-                               rendered_samples_[c].begin(),
-                               rendered_samples_[c].end());
-    rendered_samples_[c].clear();
-  }
+absl::Status AudioElementRendererBase::FlushWhenReady(
+    std::vector<std::vector<InternalSampleType>>& rendered_samples) {
+  RenderUnstartedFrames();
+
+  absl::MutexLock lock(&mutex_);
+  mutex_.Await(
+      absl::Condition(this, &AudioElementRendererBase::NoFramesInFlight));
+  RETURN_IF_NOT_OK(frames_in_flight_status_);
+  AppendAndClearRenderedSamples(rendered_samples_, rendered_samples);
+  return absl::OkStatus();
 }
 
 }  // namespace iamf_tools
@@ -34,6 +34,11 @@ namespace iamf_tools {
  *   happen asynchronously.
  * - Call `Flush()` to retrieve finished frames, in the order they were
  *   received by `RenderLabeledFrame()`.
+ * - Call `FlushWhenReady()` to wait until all frames in flight are finished,
+ *   then retrieve them. Synchronous renderers finish every frame inside
+ *   `RenderLabeledFrame()`, so this never blocks for them.
+ * - Call `RenderLabeledFrameAsView()` instead of the above when
+ *   `IsPassThrough()` is true, to get the samples without copying them.
  * - Call `Finalize()` to close the renderer, telling it to finish rendering
  *   any remaining frames. Afterwards `IsFinalized()` should be called until it
  *   returns true, then audio frames should be  retrieved one last time via
@@ -52,7 +57,45 @@ class AudioElementRendererBase {
    * \return Number of ticks that will be rendered. A specific status on
    *         failure.
    */
-  absl::StatusOr<size_t> RenderLabeledFrame(const LabeledFrame& labeled_frame);
+  virtual absl::StatusOr<size_t> RenderLabeledFrame(
+      const LabeledFrame& labeled_frame);
+
+  /*!\brief Gets views of the samples to render without copying them.
+   *
+   * Only supported by renderers which output their input unchanged, as
+   * reported by `IsPassThrough()`. The samples are not rendered or buffered,
+   * so they are never returned by `Flush()`.
+   *
+   * \param labeled_frame Labeled frame to render.
+   * \param rendered_samples Output views into the trimmed samples of
+   *        `labeled_frame` arranged in (channel, time) axes. They are valid
+   *        until the samples of `labeled_frame` are modified.
+   * \return `absl::OkStatus()` on success. `absl::FailedPreconditionError()`
+   *         if the renderer is not a pass-through renderer. A specific status
+   *         on other failures.
+   */
+  absl::Status RenderLabeledFrameAsView(
+      const LabeledFrame& labeled_frame,
+      std::vector<absl::Span<const InternalSampleType>>& rendered_samples)
+      const;
+
+  /*!\brief Checks if the renderer outputs its input unchanged.
+   *
+   * \return `true` if `RenderLabeledFrameAsView()` is supported. `false`
+   *         otherwise.
+   */
+  virtual bool IsPassThrough() const { return false; }
+
+  /*!\brief Checks if the renderer finishes frames after returning.
+   *
+   * Callers may submit frames to several asynchronous renderers before calling
+   * `FlushWhenReady()` on any of them, so that the frames render concurrently.
+   * The labeled frames must outlive the rendering.
+   *
+   * \return `true` if `RenderLabeledFrame()` may return before the frame is
+   *         finished. `false` otherwise.
+   */
+  virtual bool IsAsynchronous() const { return false; }
 
   /*!\brief Flushes finished audio frames.
    *
@@ -61,6 +104,16 @@ class AudioElementRendererBase {
    */
   void Flush(std::vector<std::vector<InternalSampleType>>& rendered_samples);
 
+  /*!\brief Waits for frames in flight to finish, then flushes them.
+   *
+   * \param rendered_samples Vector to append rendered samples to, arranged in
+   *        (channel, time) axes.
+   * \return `absl::OkStatus()` on success. The first error encountered while
+   *         rendering frames in flight. Nothing is flushed on failure.
+   */
+  absl::Status FlushWhenReady(
+      std::vector<std::vector<InternalSampleType>>& rendered_samples);
+
   /*!\brief Finalizes the renderer. Waits for it to finish any remaining frames.
    *
    * \return `absl::OkStatus()` on success. A specific status on failure.
@@ -104,6 +157,21 @@ class AudioElementRendererBase {
       absl::Span<const absl::Span<const InternalSampleType>> samples_to_render)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) = 0;
 
+  /*!\brief Renders frames in flight which were not started yet.
+   *
+   * Called before waiting for frames in flight, so that a caller which itself
+   * runs on a thread pool never waits for work queued behind it.
+   */
+  virtual void RenderUnstartedFrames() {}
+
+  /*!\brief Checks if there are no frames in flight.
+   *
+   * \return `true` if all received frames are finished. `false` otherwise.
+   */
+  bool NoFramesInFlight() const ABSL_SHARED_LOCKS_REQUIRED(mutex_) {
+    return num_frames_in_flight_ == 0;
+  }
+
   const std::vector<ChannelLabel::Label> ordered_labels_;
   const size_t num_samples_per_frame_ = 0;
   const size_t num_output_channels_;
@@ -124,6 +192,18 @@ class AudioElementRendererBase {
 
   bool is_finalized_ ABSL_GUARDED_BY(mutex_) = false;
   const LabeledFrame* current_labeled_frame_ ABSL_GUARDED_BY(mutex_) = nullptr;
+
+  // Number of frames received by `RenderLabeledFrame()` which are not finished
+  // yet. Asynchronous renderers increment this when a frame is queued and
+  // decrement it when the frame is finished.
+  size_t num_frames_in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+
+  // First error encountered while rendering frames in flight.
+  absl::Status frames_in_flight_status_ ABSL_GUARDED_BY(mutex_);
+
+ private:
+  // Wraps another renderer and drives it from the shared thread pool.
+  friend class AudioElementRendererAsync;
 };
 
 }  // namespace iamf_tools
@@ -15,6 +15,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -28,10 +29,12 @@
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "iamf/cli/audio_element_with_data.h"
 #include "iamf/cli/channel_label.h"
+#include "iamf/cli/demixing_module.h"
 #include "iamf/cli/renderer/audio_element_renderer_base.h"
 #include "iamf/cli/renderer/renderer_utils.h"
 #include "iamf/common/utils/macros.h"
@@ -139,6 +142,76 @@ void CopySamples(size_t num_channels, const SourceBufferType& source_buffer,
   }
 }
 
+// Gets how an audio element is fed to OBR: its audio element type, the
+// ordered labels of its channels, and the demixing matrix to project them with
+// (or `nullptr` when there is none).
+absl::Status GetObrInputForAudioElement(
+    const AudioElementWithData& audio_element,
+    obr::AudioElementType& obr_audio_element_type,
+    std::vector<ChannelLabel::Label>& ordered_labels,
+    const std::vector<int16_t>*& demixing_matrix) {
+  demixing_matrix = nullptr;
+  switch (audio_element.obu.GetAudioElementType()) {
+    case AudioElementObu::kAudioElementChannelBased: {
+      const auto* scalable_channel_layout_config =
+          std::get_if<ScalableChannelLayoutConfig>(&audio_element.obu.config_);
+      RETURN_IF_NOT_OK(ValidateNotNull(scalable_channel_layout_config,
+                                       "scalable_channel_layout_config"));
+      if (scalable_channel_layout_config->channel_audio_layer_configs
+              .empty()) {
+        return absl::InvalidArgumentError(
+            "Expected at least one channel audio layer.");
+      }
+      const auto& highest_channel_audio_layer_config =
+          scalable_channel_layout_config->channel_audio_layer_configs.back();
+      const auto type = LookupObrAudioElementTypeFromLoudspeakerLayout(
+          highest_channel_audio_layer_config.loudspeaker_layout,
+          highest_channel_audio_layer_config.expanded_loudspeaker_layout);
+      if (!type.ok()) {
+        return type.status();
+      }
+      obr_audio_element_type = *type;
+
+      const auto labels =
+          ChannelLabel::LookupEarChannelOrderFromScalableLoudspeakerLayout(
+              highest_channel_audio_layer_config.loudspeaker_layout,
+              highest_channel_audio_layer_config.expanded_loudspeaker_layout);
+      if (!labels.ok()) {
+        return labels.status();
+      }
+      ordered_labels = *labels;
+      return absl::OkStatus();
+    }
+    case AudioElementObu::kAudioElementSceneBased: {
+      const auto* ambisonics_config =
+          std::get_if<AmbisonicsConfig>(&audio_element.obu.config_);
+      RETURN_IF_NOT_OK(
+          ValidateNotNull(ambisonics_config, "ambisonics_config"));
+      const auto type =
+          GetObrAudioElementTypeFromAmbisonicsConfig(*ambisonics_config);
+      if (!type.ok()) {
+        return type.status();
+      }
+      obr_audio_element_type = *type;
+
+      RETURN_IF_NOT_OK(GetChannelLabelsForAmbisonics(
+          *ambisonics_config, audio_element.obu.audio_substream_ids_,
+          audio_element.substream_id_to_labels, ordered_labels));
+      const auto matrix = GetDemixingMatrix(*ambisonics_config);
+      if (!matrix.ok()) {
+        return matrix.status();
+      }
+      demixing_matrix = *matrix;
+      return absl::OkStatus();
+    }
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrCat("Cannot render audio element type ",
+                       audio_element.obu.GetAudioElementType(),
+                       " binaurally."));
+  }
+}
+
 }  // namespace
 
 std::unique_ptr<AudioElementRendererBinaural>
@@ -290,4 +363,136 @@ absl::Status AudioElementRendererBinaural::RenderSamples(
   return absl::OkStatus();
 }
 
+std::unique_ptr<SubMixRendererBinaural> SubMixRendererBinaural::Create(
+    const std::vector<const AudioElementWithData*>& audio_elements,
+    size_t num_samples_per_frame, size_t sample_rate) {
+  if (num_samples_per_frame < kObrMinimalFrameSize) {
+    ABSL_LOG(ERROR) << "OBR does not support `num_samples_per_frame` <= "
+                    << kObrMinimalFrameSize << " (got " << num_samples_per_frame
+                    << ")";
+    return nullptr;
+  }
+
+  auto obr = std::make_unique<obr::ObrImpl>(
+      static_cast<int>(num_samples_per_frame), static_cast<int>(sample_rate));
+
+  // OBR concatenates the input channels of its audio elements in the order
+  // they are added.
+  std::vector<ElementInput> element_inputs(audio_elements.size());
+  for (int i = 0; i < audio_elements.size(); ++i) {
+    if (audio_elements[i] == nullptr) {
+      ABSL_LOG(ERROR) << "Audio element " << i << " is null.";
+      return nullptr;
+    }
+    obr::AudioElementType obr_audio_element_type;
+    const std::vector<int16_t>* demixing_matrix = nullptr;
+    auto& element_input = element_inputs[i];
+    auto status = GetObrInputForAudioElement(
+        *audio_elements[i], obr_audio_element_type,
+        element_input.ordered_labels, demixing_matrix);
+    if (demixing_matrix != nullptr) {
+      element_input.demixing_matrix.emplace(*demixing_matrix);
+    }
+
+    element_input.first_obr_channel = obr->GetNumberOfInputChannels();
+    status.Update(obr->AddAudioElement(obr_audio_element_type));
+    if (!status.ok()) {
+      ABSL_LOG(ERROR) << status;
+      return nullptr;
+    }
+    element_input.num_obr_channels =
+        obr->GetNumberOfInputChannels() - element_input.first_obr_channel;
+  }
+
+  return absl::WrapUnique(new SubMixRendererBinaural(
+      std::move(element_inputs), std::move(obr), num_samples_per_frame));
+}
+
+SubMixRendererBinaural::SubMixRendererBinaural(
+    std::vector<ElementInput> element_inputs,
+    std::unique_ptr<obr::ObrImpl> obr, size_t num_samples_per_frame)
+    : num_samples_per_frame_(num_samples_per_frame),
+      element_inputs_(std::move(element_inputs)),
+      obr_(std::move(obr)),
+      input_buffer_(obr_->GetNumberOfInputChannels(), num_samples_per_frame),
+      output_buffer_(kNumBinauralChannels, num_samples_per_frame),
+      empty_channel_(num_samples_per_frame, 0.0) {}
+
+absl::Status SubMixRendererBinaural::RenderAndMixFrames(
+    absl::Span<const LabeledFrame* const> labeled_frames,
+    absl::Span<const std::vector<float>> element_linear_gains_per_tick,
+    std::vector<std::vector<InternalSampleType>>& rendered_samples) {
+  RETURN_IF_NOT_OK(ValidateContainerSizeEqual("labeled_frames", labeled_frames,
+                                              element_inputs_.size()));
+  RETURN_IF_NOT_OK(ValidateContainerSizeEqual("element_linear_gains_per_tick",
+                                              element_linear_gains_per_tick,
+                                              element_inputs_.size()));
+
+  // Fill OBR's input with the gained samples of each audio element. Frames
+  // must agree on the number of ticks; the rest of OBR's frame is silent.
+  std::optional<size_t> num_ticks;
+  std::vector<absl::Span<const InternalSampleType>> projected_sample_spans;
+  for (int i = 0; i < element_inputs_.size(); ++i) {
+    const auto& element_input = element_inputs_[i];
+    absl::Span<const absl::Span<const InternalSampleType>> element_samples;
+    size_t num_valid_ticks = 0;
+    if (labeled_frames[i] != nullptr) {
+      samples_to_render_.resize(element_input.ordered_labels.size());
+      RETURN_IF_NOT_OK(ArrangeSamplesToRender(
+          *labeled_frames[i], element_input.ordered_labels, empty_channel_,
+          samples_to_render_, num_valid_ticks));
+      RETURN_IF_NOT_OK(Validate(num_valid_ticks, std::less_equal<size_t>(),
+                                num_samples_per_frame_, "num_valid_ticks <="));
+      if (num_ticks.has_value()) {
+        RETURN_IF_NOT_OK(
+            ValidateEqual(num_valid_ticks, *num_ticks, "num_valid_ticks"));
+      }
+      num_ticks = num_valid_ticks;
+      RETURN_IF_NOT_OK(Validate(
+          element_linear_gains_per_tick[i].size(), std::greater_equal<size_t>(),
+          num_valid_ticks, "element_linear_gains_per_tick.size() >="));
+
+      element_samples = absl::MakeConstSpan(samples_to_render_);
+      if (element_input.demixing_matrix.has_value()) {
+        RETURN_IF_NOT_OK(ProjectSamplesToRender(
+            samples_to_render_, *element_input.demixing_matrix,
+            projected_samples_));
+        projected_sample_spans.assign(projected_samples_.begin(),
+                                      projected_samples_.end());
+        element_samples = absl::MakeConstSpan(projected_sample_spans);
+      }
+      RETURN_IF_NOT_OK(ValidateContainerSizeEqual(
+          "element_samples", element_samples, element_input.num_obr_channels));
+    }
+
+    const auto& gains = element_linear_gains_per_tick[i];
+    for (int c = 0; c < element_input.num_obr_channels; ++c) {
+      auto& obr_channel = input_buffer_[element_input.first_obr_channel + c];
+      int t = 0;
+      for (; t < num_valid_ticks; ++t) {
+        obr_channel[t] =
+            static_cast<float>(element_samples[c][t] * gains[t]);
+      }
+      for (; t < num_samples_per_frame_; ++t) {
+        obr_channel[t] = 0.0f;
+      }
+    }
+  }
+
+  // Render all audio elements at once.
+  obr_->Process(input_buffer_, &output_buffer_);
+
+  const size_t num_rendered_ticks = num_ticks.value_or(0);
+  rendered_samples.resize(kNumBinauralChannels);
+  for (int c = 0; c < kNumBinauralChannels; ++c) {
+    rendered_samples[c].resize(num_rendered_ticks);
+    for (int t = 0; t < num_rendered_ticks; ++t) {
+      rendered_samples[c][t] =
+          static_cast<InternalSampleType>(output_buffer_[c][t]);
+    }
+  }
+
+  return absl::OkStatus();
+}
+
 }  // namespace iamf_tools
@@ -23,7 +23,9 @@
 #include "absl/types/span.h"
 #include "iamf/cli/audio_element_with_data.h"
 #include "iamf/cli/channel_label.h"
+#include "iamf/cli/demixing_module.h"
 #include "iamf/cli/renderer/audio_element_renderer_base.h"
+#include "iamf/cli/renderer/sub_mix_renderer_base.h"
 #include "iamf/obu/audio_element.h"
 #include "iamf/obu/types.h"
 #include "obr/audio_buffer/audio_buffer.h"
@@ -128,5 +130,86 @@ class AudioElementRendererBinaural : public AudioElementRendererBase {
   std::vector<std::vector<InternalSampleType>> projected_samples_;
 };
 
+/*!\brief Renders all audio elements of a sub-mix with one binaural engine.
+ *
+ * All audio elements are registered with a single OBR instance, and each
+ * frame is rendered with one call to `Process()`. Compared to one
+ * `AudioElementRendererBinaural` per audio element, this convolves with the
+ * HRIRs of each virtual loudspeaker once rather than once per audio element,
+ * and avoids converting each element's output back to `InternalSampleType`
+ * before mixing. Element mix gains are applied while filling OBR's input.
+ */
+class SubMixRendererBinaural : public SubMixRendererBase {
+ public:
+  /*!\brief Creates a binaural renderer for all audio elements of a sub-mix.
+   *
+   * \param audio_elements Audio elements in the sub-mix. Each must be a
+   *        channel-based or scene-based audio element supported by
+   *        `AudioElementRendererBinaural`.
+   * \param num_samples_per_frame Number of samples per frame.
+   * \param sample_rate Sample rate of the rendered output.
+   * \return Render to use or `nullptr` on failure.
+   */
+  static std::unique_ptr<SubMixRendererBinaural> Create(
+      const std::vector<const AudioElementWithData*>& audio_elements,
+      size_t num_samples_per_frame, size_t sample_rate);
+
+  /*!\brief Destructor. */
+  ~SubMixRendererBinaural() override = default;
+
+  /*!\brief Renders and mixes one frame of each audio element.
+   *
+   * \param labeled_frames Frame for each audio element, in the order of the
+   *        audio elements in the sub-mix. `nullptr` if an audio element has no
+   *        frame at this timestamp; it then contributes silence.
+   * \param element_linear_gains_per_tick Linear element mix gain to apply at
+   *        each tick for each audio element, in the same order. Each must hold
+   *        at least as many gains as there are ticks to render.
+   * \param rendered_samples Output mixed samples arranged in (channel, time).
+   *        Each channel holds the number of ticks in the frames after
+   *        trimming.
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status RenderAndMixFrames(
+      absl::Span<const LabeledFrame* const> labeled_frames,
+      absl::Span<const std::vector<float>> element_linear_gains_per_tick,
+      std::vector<std::vector<InternalSampleType>>& rendered_samples) override;
+
+ private:
+  // Describes how an audio element feeds the shared OBR instance.
+  struct ElementInput {
+    // Ordered list of channel labels to render.
+    std::vector<ChannelLabel::Label> ordered_labels;
+    // Only holds a value for ambisonics projection mode.
+    std::optional<const std::vector<int16_t>> demixing_matrix;
+    // Range of OBR input channels used by this audio element.
+    size_t first_obr_channel;
+    size_t num_obr_channels;
+  };
+
+  /*!\brief Constructor.
+   *
+   * \param element_inputs Description of the input of each audio element.
+   * \param obr Instance of an OBR renderer with all audio elements added.
+   * \param num_samples_per_frame Number of samples per frame.
+   */
+  SubMixRendererBinaural(std::vector<ElementInput> element_inputs,
+                         std::unique_ptr<obr::ObrImpl> obr,
+                         size_t num_samples_per_frame);
+
+  const size_t num_samples_per_frame_;
+  const std::vector<ElementInput> element_inputs_;
+  std::unique_ptr<obr::ObrImpl> obr_;
+  obr::AudioBuffer input_buffer_;
+  obr::AudioBuffer output_buffer_;
+
+  // Buffer storing zeros. All omitted channels' spans point to this.
+  const std::vector<InternalSampleType> empty_channel_;
+
+  // Scratch buffers reused for each audio element.
+  std::vector<absl::Span<const InternalSampleType>> samples_to_render_;
+  std::vector<std::vector<InternalSampleType>> projected_samples_;
+};
+
 }  // namespace iamf_tools
 #endif  // CLI_RENDERER_AUDIO_ELEMENT_RENDERER_BINAURAL_H_
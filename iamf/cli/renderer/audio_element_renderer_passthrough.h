@@ -66,6 +66,12 @@ class AudioElementRendererPassThrough : public AudioElementRendererBase {
   /*!\brief Destructor. */
   ~AudioElementRendererPassThrough() override = default;
 
+  /*!\brief Checks if the renderer outputs its input unchanged.
+   *
+   * \return `true`.
+   */
+  bool IsPassThrough() const override { return true; }
+
  private:
   /*!\brief Constructor.
    *
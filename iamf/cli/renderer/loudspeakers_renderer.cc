@@ -28,6 +28,7 @@
 #include "iamf/cli/renderer/renderer_utils.h"
 #include "iamf/common/utils/macros.h"
 #include "iamf/common/utils/map_utils.h"
+#include "iamf/common/utils/mixing_utils.h"
 #include "iamf/common/utils/validation_utils.h"
 #include "iamf/obu/audio_element.h"
 #include "iamf/obu/demixing_info_parameter_data.h"
@@ -144,21 +145,33 @@ absl::Status RenderSamplesUsingGains(
   }
 
   const auto num_ticks = input_samples.empty() ? 0 : input_samples[0].size();
-  const auto num_in_channels = input_samples.size();
+  const auto num_in_channels = samples_to_render.size();
   const auto num_out_channels = gains[0].size();
+  if (gains.size() < num_in_channels) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Expected gains for at least ", num_in_channels,
+                     " input channels. Got ", gains.size(), "."));
+  }
+
+  // Flatten the gains to the row-major layout used by the mixing kernel.
+  std::vector<double> flattened_gains;
+  flattened_gains.reserve(num_in_channels * num_out_channels);
+  for (int in_channel = 0; in_channel < num_in_channels; in_channel++) {
+    const auto& gains_for_in_channel = gains[in_channel];
+    RETURN_IF_NOT_OK(ValidateContainerSizeEqual(
+        "gains_for_in_channel", gains_for_in_channel, num_out_channels));
+    flattened_gains.insert(flattened_gains.end(), gains_for_in_channel.begin(),
+                           gains_for_in_channel.end());
+  }
+
   rendered_samples.resize(num_out_channels);
+  std::vector<absl::Span<InternalSampleType>> rendered_spans(num_out_channels);
   for (int out_channel = 0; out_channel < num_out_channels; out_channel++) {
-    auto& rendered_samples_for_channel = rendered_samples[out_channel];
-    rendered_samples_for_channel.assign(num_ticks, 0.0);
-    for (int in_channel = 0; in_channel < num_in_channels; in_channel++) {
-      const auto& samples_to_render_for_channel = samples_to_render[in_channel];
-      const auto gain_value = gains[in_channel][out_channel];
-      for (int t = 0; t < num_ticks; t++) {
-        rendered_samples_for_channel[t] +=
-            samples_to_render_for_channel[t] * gain_value;
-      }
-    }
+    rendered_samples[out_channel].resize(num_ticks);
+    rendered_spans[out_channel] = absl::MakeSpan(rendered_samples[out_channel]);
   }
+  RETURN_IF_NOT_OK(MixSamplesWithGainMatrix(samples_to_render, flattened_gains,
+                                            absl::MakeConstSpan(rendered_spans)));
 
   return absl::OkStatus();
 }
@@ -11,6 +11,7 @@
  */
 #include "iamf/cli/renderer/renderer_utils.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -29,6 +30,7 @@
 #include "iamf/cli/demixing_module.h"
 #include "iamf/common/utils/macros.h"
 #include "iamf/common/utils/map_utils.h"
+#include "iamf/common/utils/mixing_utils.h"
 #include "iamf/obu/audio_element.h"
 #include "iamf/obu/mix_presentation.h"
 #include "iamf/obu/types.h"
@@ -197,6 +199,17 @@ double Q15ToSignedDouble(const int16_t input) {
 
 }  // namespace
 
+absl::StatusOr<size_t> GetNumTicksToRender(
+    const LabeledFrame& labeled_frame,
+    const std::vector<ChannelLabel::Label>& ordered_labels,
+    const std::vector<InternalSampleType>& empty_channel) {
+  if (ordered_labels.empty()) {
+    return 0;
+  }
+  return GetCommonNumTrimmedTimeTicks(labeled_frame, ordered_labels,
+                                      empty_channel);
+}
+
 absl::Status ArrangeSamplesToRender(
     const LabeledFrame& labeled_frame,
     const std::vector<ChannelLabel::Label>& ordered_labels,
@@ -207,8 +220,8 @@ absl::Status ArrangeSamplesToRender(
     return absl::OkStatus();
   }
 
-  const auto common_num_trimmed_time_ticks = GetCommonNumTrimmedTimeTicks(
-      labeled_frame, ordered_labels, empty_channel);
+  const auto common_num_trimmed_time_ticks =
+      GetNumTicksToRender(labeled_frame, ordered_labels, empty_channel);
   if (!common_num_trimmed_time_ticks.ok()) {
     return common_num_trimmed_time_ticks.status();
   }
@@ -353,23 +366,24 @@ absl::Status ProjectSamplesToRender(
 
   const int num_output_channels =
       num_elements_in_demixing_matrix / num_input_channels;
+
+  // The demixing matrix is encoded as Q15 and stored in column-major order of
+  // (# output channels) x (# input channels), which matches the row-major
+  // (# input channels) x (# output channels) layout of the mixing kernel.
+  std::vector<double> gains(num_elements_in_demixing_matrix);
+  std::transform(demixing_matrix.begin(), demixing_matrix.end(), gains.begin(),
+                 Q15ToSignedDouble);
+
   projected_samples.resize(num_output_channels);
+  std::vector<absl::Span<InternalSampleType>> projected_spans(
+      num_output_channels);
   for (int out_channel = 0; out_channel < num_output_channels; out_channel++) {
-    auto& projected_samples_for_channel = projected_samples[out_channel];
-    projected_samples_for_channel.assign(num_ticks, 0.0);
-    for (int in_channel = 0; in_channel < num_input_channels; in_channel++) {
-      const auto& input_sample_for_channel = input_samples[in_channel];
-      const auto demixing_value = Q15ToSignedDouble(
-          demixing_matrix[in_channel * num_output_channels + out_channel]);
-
-      for (int t = 0; t < num_ticks; t++) {
-        // Project with `demixing_matrix`, which is encoded as Q15 and stored
-        // in column major.
-        projected_samples_for_channel[t] +=
-            demixing_value * input_sample_for_channel[t];
-      }
-    }
+    projected_samples[out_channel].resize(num_ticks);
+    projected_spans[out_channel] =
+        absl::MakeSpan(projected_samples[out_channel]);
   }
+  RETURN_IF_NOT_OK(MixSamplesWithGainMatrix(
+      input_samples, gains, absl::MakeConstSpan(projected_spans)));
   return absl::OkStatus();
 }
 
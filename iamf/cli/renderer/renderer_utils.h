@@ -29,6 +29,24 @@
 
 namespace iamf_tools {
 
+/*!\brief Gets the number of time ticks to render after trimming.
+ *
+ * Validates the frame the same way as `ArrangeSamplesToRender()`, without
+ * arranging any samples.
+ *
+ * \param labeled_frame Labeled frame determine which original or demixed
+ *        samples to trim and render.
+ * \param ordered_labels Ordered list of original labels.
+ * \param empty_channel Vector of an all-zero channel, which must be at least
+ *        as long as the other channels.
+ * \return Common number of time ticks to render for the requested labels or
+ *         their associated demixed labels. A specific status on failure.
+ */
+absl::StatusOr<size_t> GetNumTicksToRender(
+    const LabeledFrame& labeled_frame,
+    const std::vector<ChannelLabel::Label>& ordered_labels,
+    const std::vector<InternalSampleType>& empty_channel);
+
 /*!\brief Arranges the samples to be rendered in (channel, time) axes.
  *
  * \param labeled_frame Labeled frame determine which original or demixed
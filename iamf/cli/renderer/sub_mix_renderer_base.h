@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#ifndef CLI_RENDERER_SUB_MIX_RENDERER_BASE_H_
+#define CLI_RENDERER_SUB_MIX_RENDERER_BASE_H_
+
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "iamf/cli/demixing_module.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+/*!\brief Abstract class to render all audio elements of a sub-mix at once.
+ *
+ * Unlike `AudioElementRendererBase`, which renders a single audio element,
+ * this renders every audio element in a sub-mix to a single layout and outputs
+ * their mix. This lets implementations share expensive state, such as a
+ * binaural engine, between the audio elements. Element mix gains are applied
+ * to the input of the renderer, before the audio elements are mixed.
+ */
+class SubMixRendererBase {
+ public:
+  /*!\brief Destructor. */
+  virtual ~SubMixRendererBase() = default;
+
+  /*!\brief Renders and mixes one frame of each audio element.
+   *
+   * \param labeled_frames Frame for each audio element, in the order of the
+   *        audio elements in the sub-mix. `nullptr` if an audio element has no
+   *        frame at this timestamp; it then contributes silence.
+   * \param element_linear_gains_per_tick Linear element mix gain to apply at
+   *        each tick for each audio element, in the same order. Each must hold
+   *        at least as many gains as there are ticks to render.
+   * \param rendered_samples Output mixed samples arranged in (channel, time).
+   *        Each channel holds the number of ticks in the frames after
+   *        trimming.
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  virtual absl::Status RenderAndMixFrames(
+      absl::Span<const LabeledFrame* const> labeled_frames,
+      absl::Span<const std::vector<float>> element_linear_gains_per_tick,
+      std::vector<std::vector<InternalSampleType>>& rendered_samples) = 0;
+};
+
+}  // namespace iamf_tools
+#endif  // CLI_RENDERER_SUB_MIX_RENDERER_BASE_H_
@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+
+#include "iamf/cli/renderer/audio_element_renderer_async.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/status_matchers.h"
+#include "absl/types/span.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "iamf/cli/channel_label.h"
+#include "iamf/cli/demixing_module.h"
+#include "iamf/cli/renderer/audio_element_renderer_base.h"
+#include "iamf/cli/renderer/audio_element_renderer_channel_to_channel.h"
+#include "iamf/cli/tests/cli_test_utils.h"
+#include "iamf/common/utils/macros.h"
+#include "iamf/common/utils/thread_pool.h"
+#include "iamf/obu/audio_element.h"
+#include "iamf/obu/demixing_info_parameter_data.h"
+#include "iamf/obu/mix_presentation.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+namespace {
+
+using ::absl_testing::IsOk;
+using ::absl_testing::IsOkAndHolds;
+using ::absl_testing::StatusIs;
+using ::testing::IsEmpty;
+using enum ChannelAudioLayerConfig::LoudspeakerLayout;
+using enum ChannelLabel::Label;
+using enum LoudspeakersSsConventionLayout::SoundSystem;
+
+constexpr size_t kFourSamplesPerFrame = 4;
+constexpr size_t kOneChannel = 1;
+constexpr size_t kTwoSamplesPerFrame = 2;
+
+const ScalableChannelLayoutConfig k5_1_0ScalableChannelLayoutConfig = {
+    .channel_audio_layer_configs = {{.loudspeaker_layout = kLayout5_1_ch}}};
+const Layout kStereoLayout = {
+    .layout_type = Layout::kLayoutTypeLoudspeakersSsConvention,
+    .specific_layout =
+        LoudspeakersSsConventionLayout{.sound_system = kSoundSystemA_0_2_0}};
+
+// Mock renderer which scales the first input channel by two, or fails when
+// configured to.
+class MockAudioElementRenderer : public AudioElementRendererBase {
+ public:
+  explicit MockAudioElementRenderer(bool fail_to_render = false)
+      : AudioElementRendererBase({ChannelLabel::kMono}, kFourSamplesPerFrame,
+                                 kOneChannel),
+        fail_to_render_(fail_to_render) {}
+
+  absl::Status RenderSamples(
+      absl::Span<const absl::Span<const InternalSampleType>> samples_to_render)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) override {
+    if (fail_to_render_) {
+      return absl::InternalError("Failed to render.");
+    }
+    rendered_samples_[0].clear();
+    for (const auto sample : samples_to_render[0]) {
+      rendered_samples_[0].push_back(2.0 * sample);
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  const bool fail_to_render_;
+};
+
+LabeledFrame GetMonoLabeledFrame(
+    const std::vector<InternalSampleType>& samples) {
+  return {.label_to_samples = {{ChannelLabel::kMono, samples}}};
+}
+
+TEST(Create, ReturnsNullptrWithoutRenderer) {
+  EXPECT_EQ(AudioElementRendererAsync::Create(nullptr), nullptr);
+}
+
+TEST(FlushWhenReady, WaitsForFrameToBeRendered) {
+  auto renderer = AudioElementRendererAsync::Create(
+      std::make_unique<MockAudioElementRenderer>());
+  ASSERT_NE(renderer, nullptr);
+  const auto labeled_frame = GetMonoLabeledFrame({0.1, 0.2, 0.3, 0.4});
+  const std::vector<std::vector<InternalSampleType>> kExpectedSamples = {
+      {0.2, 0.4, 0.6, 0.8}};
+
+  EXPECT_THAT(renderer->RenderLabeledFrame(labeled_frame), IsOk());
+  std::vector<std::vector<InternalSampleType>> rendered_samples;
+  EXPECT_THAT(renderer->FlushWhenReady(rendered_samples), IsOk());
+
+  EXPECT_THAT(rendered_samples,
+              InternalSamples2DMatch(kExpectedSamples));
+}
+
+TEST(FlushWhenReady, FlushesFramesInOrder) {
+  auto renderer = AudioElementRendererAsync::Create(
+      std::make_unique<MockAudioElementRenderer>());
+  ASSERT_NE(renderer, nullptr);
+  const auto first_frame = GetMonoLabeledFrame({0.1, 0.1, 0.1, 0.1});
+  const auto second_frame = GetMonoLabeledFrame({0.2, 0.2, 0.2, 0.2});
+
+  const std::vector<std::vector<InternalSampleType>> kExpectedSamples = {
+      {0.2, 0.2, 0.2, 0.2, 0.4, 0.4, 0.4, 0.4}};
+
+  EXPECT_THAT(renderer->RenderLabeledFrame(first_frame), IsOk());
+  EXPECT_THAT(renderer->RenderLabeledFrame(second_frame), IsOk());
+  std::vector<std::vector<InternalSampleType>> rendered_samples;
+  EXPECT_THAT(renderer->FlushWhenReady(rendered_samples), IsOk());
+
+  EXPECT_THAT(rendered_samples,
+              InternalSamples2DMatch(kExpectedSamples));
+}
+
+std::unique_ptr<AudioElementRendererChannelToChannel>
+Create5_1_0ToStereoRenderer() {
+  return AudioElementRendererChannelToChannel::
+      CreateFromScalableChannelLayoutConfig(k5_1_0ScalableChannelLayoutConfig,
+                                            kStereoLayout, kTwoSamplesPerFrame);
+}
+
+LabeledFrame Get5_1_0LabeledFrame(InternalSampleType offset,
+                                  const DownMixingParams& down_mixing_params) {
+  return {.label_to_samples = {{kL5, {0.1 + offset, 0.2 + offset}},
+                               {kR5, {0.3 + offset, 0.4 + offset}},
+                               {kCentre, {0.5 + offset, 0.6 + offset}},
+                               {kLFE, {0.7 + offset, 0.8 + offset}},
+                               {kLs5, {0.9 + offset, 0.1 + offset}},
+                               {kRs5, {0.2 + offset, 0.3 + offset}}},
+          .demixing_params = down_mixing_params};
+}
+
+TEST(RenderLabeledFrame, MatchesSynchronousChannelToChannelRenderer) {
+  auto synchronous_renderer = Create5_1_0ToStereoRenderer();
+  ASSERT_NE(synchronous_renderer, nullptr);
+  auto renderer =
+      AudioElementRendererAsync::Create(Create5_1_0ToStereoRenderer());
+  ASSERT_NE(renderer, nullptr);
+  EXPECT_TRUE(renderer->IsAsynchronous());
+  // The channel-to-channel renderer reads the demixing parameters of the
+  // labeled frame, which differ between frames.
+  const std::vector<LabeledFrame> labeled_frames = {
+      Get5_1_0LabeledFrame(0.0, {.alpha = 1.0,
+                                 .beta = 1.0,
+                                 .gamma = 0.707,
+                                 .delta = 0.707,
+                                 .w = 0.707,
+                                 .in_bitstream = true}),
+      Get5_1_0LabeledFrame(0.01, {.alpha = 0.707,
+                                  .beta = 0.707,
+                                  .gamma = 0.5,
+                                  .delta = 0.5,
+                                  .w = 0.0,
+                                  .in_bitstream = true}),
+      Get5_1_0LabeledFrame(0.02, {})};
+
+  std::vector<std::vector<InternalSampleType>> expected_samples;
+  std::vector<std::vector<InternalSampleType>> rendered_samples;
+  for (const auto& labeled_frame : labeled_frames) {
+    EXPECT_THAT(synchronous_renderer->RenderLabeledFrame(labeled_frame),
+                IsOkAndHolds(kTwoSamplesPerFrame));
+    synchronous_renderer->Flush(expected_samples);
+
+    EXPECT_THAT(renderer->RenderLabeledFrame(labeled_frame),
+                IsOkAndHolds(kTwoSamplesPerFrame));
+    EXPECT_THAT(renderer->FlushWhenReady(rendered_samples), IsOk());
+  }
+
+  ASSERT_EQ(expected_samples.size(), 2);
+  EXPECT_EQ(expected_samples[0].size(), 3 * kTwoSamplesPerFrame);
+  EXPECT_EQ(rendered_samples, expected_samples);
+}
+
+TEST(RenderLabeledFrame, RendersConcurrentlyWithOtherRenderers) {
+  auto first_renderer =
+      AudioElementRendererAsync::Create(Create5_1_0ToStereoRenderer());
+  auto second_renderer =
+      AudioElementRendererAsync::Create(Create5_1_0ToStereoRenderer());
+  ASSERT_NE(first_renderer, nullptr);
+  ASSERT_NE(second_renderer, nullptr);
+  const auto labeled_frame = Get5_1_0LabeledFrame(0.0, {});
+
+  // Submit to both renderers before flushing either of them.
+  EXPECT_THAT(first_renderer->RenderLabeledFrame(labeled_frame), IsOk());
+  EXPECT_THAT(second_renderer->RenderLabeledFrame(labeled_frame), IsOk());
+  std::vector<std::vector<InternalSampleType>> first_rendered_samples;
+  std::vector<std::vector<InternalSampleType>> second_rendered_samples;
+  EXPECT_THAT(first_renderer->FlushWhenReady(first_rendered_samples), IsOk());
+  EXPECT_THAT(second_renderer->FlushWhenReady(second_rendered_samples),
+              IsOk());
+
+  ASSERT_EQ(first_rendered_samples.size(), 2);
+  EXPECT_EQ(first_rendered_samples[0].size(), kTwoSamplesPerFrame);
+  EXPECT_EQ(first_rendered_samples, second_rendered_samples);
+}
+
+TEST(FlushWhenReady, RendersFramesSubmittedFromTasksOnTheSharedPool) {
+  // Submit from more tasks than the pool has threads. Each task blocks until
+  // its frame is rendered, so the frames must not wait in the pool queue
+  // behind the tasks which flush them.
+  auto& pool = ThreadPool::GetShared();
+  const size_t num_renderers = 4 * (pool.NumThreads() + 1);
+  std::vector<std::unique_ptr<AudioElementRendererAsync>> renderers;
+  for (size_t i = 0; i < num_renderers; i++) {
+    renderers.push_back(AudioElementRendererAsync::Create(
+        std::make_unique<MockAudioElementRenderer>()));
+    ASSERT_NE(renderers.back(), nullptr);
+  }
+  const auto labeled_frame = GetMonoLabeledFrame({0.1, 0.2, 0.3, 0.4});
+  std::vector<std::vector<std::vector<InternalSampleType>>> rendered_samples(
+      num_renderers);
+
+  const auto render_and_flush = [&](size_t i) -> absl::Status {
+    RETURN_IF_NOT_OK(renderers[i]->RenderLabeledFrame(labeled_frame).status());
+    return renderers[i]->FlushWhenReady(rendered_samples[i]);
+  };
+
+  EXPECT_THAT(pool.ParallelFor(num_renderers, render_and_flush), IsOk());
+
+  const std::vector<std::vector<InternalSampleType>> kExpectedSamples = {
+      {0.2, 0.4, 0.6, 0.8}};
+  for (const auto& samples : rendered_samples) {
+    EXPECT_THAT(samples, InternalSamples2DMatch(kExpectedSamples));
+  }
+}
+
+TEST(FlushWhenReady, ReturnsErrorFromRendering) {
+  auto renderer = AudioElementRendererAsync::Create(
+      std::make_unique<MockAudioElementRenderer>(/*fail_to_render=*/true));
+  ASSERT_NE(renderer, nullptr);
+  const auto labeled_frame = GetMonoLabeledFrame({0.1, 0.2, 0.3, 0.4});
+  EXPECT_THAT(renderer->RenderLabeledFrame(labeled_frame), IsOk());
+
+  std::vector<std::vector<InternalSampleType>> rendered_samples;
+  EXPECT_THAT(renderer->FlushWhenReady(rendered_samples),
+              StatusIs(absl::StatusCode::kInternal));
+}
+
+TEST(Destructor, IsSafeWhileFramesAreInFlight) {
+  const auto labeled_frame = GetMonoLabeledFrame({0.1, 0.2, 0.3, 0.4});
+  for (int i = 0; i < 100; i++) {
+    auto renderer = AudioElementRendererAsync::Create(
+        std::make_unique<MockAudioElementRenderer>());
+    ASSERT_NE(renderer, nullptr);
+    EXPECT_THAT(renderer->RenderLabeledFrame(labeled_frame), IsOk());
+    // The renderer is destroyed while its frame may be queued or rendering.
+  }
+}
+
+TEST(Finalize, WaitsForFrameAndFinalizesWrappedRenderer) {
+  auto renderer = AudioElementRendererAsync::Create(
+      std::make_unique<MockAudioElementRenderer>());
+  ASSERT_NE(renderer, nullptr);
+  const auto labeled_frame = GetMonoLabeledFrame({0.1, 0.2, 0.3, 0.4});
+  EXPECT_THAT(renderer->RenderLabeledFrame(labeled_frame), IsOk());
+
+  EXPECT_THAT(renderer->Finalize(), IsOk());
+
+  EXPECT_TRUE(renderer->IsFinalized());
+  std::vector<std::vector<InternalSampleType>> rendered_samples;
+  renderer->Flush(rendered_samples);
+  const std::vector<std::vector<InternalSampleType>> kExpectedSamples = {
+      {0.2, 0.4, 0.6, 0.8}};
+  EXPECT_THAT(rendered_samples,
+              InternalSamples2DMatch(kExpectedSamples));
+}
+
+TEST(Finalize, ReturnsErrorFromWorker) {
+  auto renderer = AudioElementRendererAsync::Create(
+      std::make_unique<MockAudioElementRenderer>(/*fail_to_render=*/true));
+  ASSERT_NE(renderer, nullptr);
+  const auto labeled_frame = GetMonoLabeledFrame({0.1, 0.2, 0.3, 0.4});
+  EXPECT_THAT(renderer->RenderLabeledFrame(labeled_frame), IsOk());
+
+  EXPECT_THAT(renderer->Finalize(), StatusIs(absl::StatusCode::kInternal));
+
+  EXPECT_FALSE(renderer->IsFinalized());
+  std::vector<std::vector<InternalSampleType>> rendered_samples;
+  renderer->Flush(rendered_samples);
+  EXPECT_THAT(rendered_samples[0], IsEmpty());
+}
+
+TEST(Destructor, StopsWorkerWithoutRendering) {
+  auto renderer = AudioElementRendererAsync::Create(
+      std::make_unique<MockAudioElementRenderer>());
+  ASSERT_NE(renderer, nullptr);
+
+  renderer.reset();
+}
+
+}  // namespace
+}  // namespace iamf_tools
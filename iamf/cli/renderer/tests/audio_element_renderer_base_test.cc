@@ -28,6 +28,7 @@ namespace iamf_tools {
 namespace {
 
 using ::absl_testing::IsOk;
+using ::absl_testing::StatusIs;
 using ::testing::Each;
 using ::testing::IsEmpty;
 
@@ -121,5 +122,35 @@ TEST(AudioElementRendererBase, AppendsWhenFlushing) {
               InternalSamples2DMatch(expected_samples));
 }
 
+TEST(FlushWhenReady, FlushesSynchronouslyRenderedSamples) {
+  MockAudioElementRenderer renderer;
+  std::vector<std::vector<InternalSampleType>> rendered_samples;
+
+  EXPECT_THAT(renderer.RenderLabeledFrame({}), IsOk());
+  // Synchronous renderers are ready right away.
+  EXPECT_THAT(renderer.FlushWhenReady(rendered_samples), IsOk());
+
+  EXPECT_THAT(rendered_samples, InternalSamples2DMatch(GetSamplesToRender()));
+}
+
+TEST(FlushWhenReady, SucceedsWithoutRendering) {
+  MockAudioElementRenderer renderer;
+  std::vector<std::vector<InternalSampleType>> rendered_samples;
+
+  EXPECT_THAT(renderer.FlushWhenReady(rendered_samples), IsOk());
+
+  EXPECT_EQ(rendered_samples.size(), kOneChannel);
+  EXPECT_THAT(rendered_samples, Each(IsEmpty()));
+}
+
+TEST(RenderLabeledFrameAsView, FailsForRenderersWhichAreNotPassThrough) {
+  MockAudioElementRenderer renderer;
+  std::vector<absl::Span<const InternalSampleType>> rendered_samples;
+
+  EXPECT_FALSE(renderer.IsPassThrough());
+  EXPECT_THAT(renderer.RenderLabeledFrameAsView({}, rendered_samples),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+}
+
 }  // namespace
 }  // namespace iamf_tools
@@ -13,21 +13,28 @@
 #include "iamf/cli/renderer/audio_element_renderer_binaural.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
 #include "absl/status/status_matchers.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "iamf/cli/audio_element_with_data.h"
 #include "iamf/cli/channel_label.h"
+#include "iamf/cli/demixing_module.h"
 #include "iamf/cli/tests/cli_test_utils.h"
+#include "iamf/cli/user_metadata_builder/iamf_input_layout.h"
 #include "iamf/obu/audio_element.h"
+#include "iamf/obu/codec_config.h"
 #include "iamf/obu/types.h"
 
 namespace iamf_tools {
 namespace {
 
 using ::absl_testing::IsOk;
+using ::absl_testing::StatusIs;
 using enum ChannelAudioLayerConfig::LoudspeakerLayout;
 using enum ChannelLabel::Label;
 using testing::Each;
@@ -507,5 +514,134 @@ TEST(RenderLabeledFrame, RendersShorterLastFrameToBinaural) {
 // TODO(b/450471766): Add tests when rendering from expanded layouts is
 //                    supported.
 
+constexpr uint32_t kCodecConfigId = 0;
+constexpr DecodedUleb128 kStereoAudioElementId = 100;
+constexpr DecodedUleb128 kAmbisonicsAudioElementId = 200;
+
+class SubMixRendererBinauralTest : public ::testing::Test {
+ public:
+  SubMixRendererBinauralTest() {
+    AddLpcmCodecConfigWithIdAndSampleRate(kCodecConfigId, kSampleRate,
+                                          codec_configs_);
+    AddScalableAudioElementWithSubstreamIds(
+        IamfInputLayout::kStereo, kStereoAudioElementId, kCodecConfigId, {0},
+        codec_configs_, audio_elements_);
+    AddAmbisonicsMonoAudioElementWithSubstreamIds(
+        kAmbisonicsAudioElementId, kCodecConfigId, {10, 11, 12, 13},
+        codec_configs_, audio_elements_);
+  }
+
+ protected:
+  std::vector<const AudioElementWithData*> GetAudioElementsInSubMix() const {
+    return {&audio_elements_.at(kStereoAudioElementId),
+            &audio_elements_.at(kAmbisonicsAudioElementId)};
+  }
+
+  absl::flat_hash_map<uint32_t, CodecConfigObu> codec_configs_;
+  absl::flat_hash_map<DecodedUleb128, AudioElementWithData> audio_elements_;
+
+  const std::vector<InternalSampleType> kSamples =
+      std::vector<InternalSampleType>(kNumSamplesPerFrame, kArbitrarySample5);
+  const LabeledFrame kStereoFrame = {
+      .label_to_samples = {{kL2, kSamples}, {kR2, kSamples}}};
+  const LabeledFrame kAmbisonicsFrame = {.label_to_samples = {{kA0, kSamples},
+                                                              {kA1, kSamples},
+                                                              {kA2, kSamples},
+                                                              {kA3, kSamples}}};
+  const std::vector<std::vector<float>> kUnityGains =
+      std::vector<std::vector<float>>(2, std::vector<float>(kNumSamplesPerFrame,
+                                                            1.0f));
+};
+
+TEST_F(SubMixRendererBinauralTest, CreateSucceedsForChannelAndAmbisonics) {
+  EXPECT_NE(SubMixRendererBinaural::Create(GetAudioElementsInSubMix(),
+                                           kNumSamplesPerFrame, kSampleRate),
+            nullptr);
+}
+
+TEST_F(SubMixRendererBinauralTest, CreateFailsForTooSmallFrames) {
+  EXPECT_EQ(SubMixRendererBinaural::Create(GetAudioElementsInSubMix(),
+                                           /*num_samples_per_frame=*/8,
+                                           kSampleRate),
+            nullptr);
+}
+
+TEST_F(SubMixRendererBinauralTest, RendersTwoChannelsForAllTicks) {
+  auto renderer = SubMixRendererBinaural::Create(
+      GetAudioElementsInSubMix(), kNumSamplesPerFrame, kSampleRate);
+  ASSERT_NE(renderer, nullptr);
+  const std::vector<const LabeledFrame*> labeled_frames = {&kStereoFrame,
+                                                           &kAmbisonicsFrame};
+
+  std::vector<std::vector<InternalSampleType>> rendered_samples;
+  EXPECT_THAT(renderer->RenderAndMixFrames(labeled_frames, kUnityGains,
+                                           rendered_samples),
+              IsOk());
+
+  EXPECT_THAT(rendered_samples, SizeIs(2));
+  EXPECT_THAT(rendered_samples, Each(SizeIs(kNumSamplesPerFrame)));
+}
+
+TEST_F(SubMixRendererBinauralTest, RendersWhenAnAudioElementHasNoFrame) {
+  auto renderer = SubMixRendererBinaural::Create(
+      GetAudioElementsInSubMix(), kNumSamplesPerFrame, kSampleRate);
+  ASSERT_NE(renderer, nullptr);
+  const std::vector<const LabeledFrame*> labeled_frames = {&kStereoFrame,
+                                                           nullptr};
+
+  std::vector<std::vector<InternalSampleType>> rendered_samples;
+  EXPECT_THAT(renderer->RenderAndMixFrames(labeled_frames, kUnityGains,
+                                           rendered_samples),
+              IsOk());
+
+  EXPECT_THAT(rendered_samples, Each(SizeIs(kNumSamplesPerFrame)));
+}
+
+TEST_F(SubMixRendererBinauralTest, AppliesElementGainsToInput) {
+  auto renderer = SubMixRendererBinaural::Create(
+      GetAudioElementsInSubMix(), kNumSamplesPerFrame, kSampleRate);
+  ASSERT_NE(renderer, nullptr);
+  const std::vector<const LabeledFrame*> labeled_frames = {&kStereoFrame,
+                                                           &kAmbisonicsFrame};
+  const std::vector<std::vector<float>> kZeroGains(
+      2, std::vector<float>(kNumSamplesPerFrame, 0.0f));
+
+  std::vector<std::vector<InternalSampleType>> rendered_samples;
+  EXPECT_THAT(renderer->RenderAndMixFrames(labeled_frames, kZeroGains,
+                                           rendered_samples),
+              IsOk());
+
+  EXPECT_THAT(rendered_samples, Each(Each(0.0)));
+}
+
+TEST_F(SubMixRendererBinauralTest, InvalidWhenFramesHaveDifferentNumTicks) {
+  auto renderer = SubMixRendererBinaural::Create(
+      GetAudioElementsInSubMix(), kNumSamplesPerFrame, kSampleRate);
+  ASSERT_NE(renderer, nullptr);
+  const std::vector<InternalSampleType> kShortSamples(kNumSamplesPerFrame - 1,
+                                                      kArbitrarySample5);
+  const LabeledFrame kShortStereoFrame = {
+      .label_to_samples = {{kL2, kShortSamples}, {kR2, kShortSamples}}};
+  const std::vector<const LabeledFrame*> labeled_frames = {&kShortStereoFrame,
+                                                           &kAmbisonicsFrame};
+
+  std::vector<std::vector<InternalSampleType>> rendered_samples;
+  EXPECT_THAT(renderer->RenderAndMixFrames(labeled_frames, kUnityGains,
+                                           rendered_samples),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(SubMixRendererBinauralTest, InvalidWithTooFewFrames) {
+  auto renderer = SubMixRendererBinaural::Create(
+      GetAudioElementsInSubMix(), kNumSamplesPerFrame, kSampleRate);
+  ASSERT_NE(renderer, nullptr);
+  const std::vector<const LabeledFrame*> labeled_frames = {&kStereoFrame};
+
+  std::vector<std::vector<InternalSampleType>> rendered_samples;
+  EXPECT_THAT(renderer->RenderAndMixFrames(labeled_frames, kUnityGains,
+                                           rendered_samples),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 }  // namespace
 }  // namespace iamf_tools
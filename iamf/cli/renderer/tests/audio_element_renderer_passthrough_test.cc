@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "absl/status/status_matchers.h"
+#include "absl/types/span.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "iamf/cli/channel_label.h"
@@ -33,6 +34,9 @@ namespace iamf_tools {
 namespace {
 
 using ::absl_testing::IsOk;
+using ::testing::Each;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
 using enum ChannelAudioLayerConfig::LoudspeakerLayout;
 using enum ChannelAudioLayerConfig::ExpandedLoudspeakerLayout;
 using enum ChannelLabel::Label;
@@ -592,6 +596,70 @@ TEST(RenderLabeledFrame, EdgeCaseWithAllSamplesTrimmedReturnsZero) {
   EXPECT_EQ(*result, 0);
 }
 
+TEST(RenderLabeledFrameAsView, ReturnsViewsIntoTheLabeledFrame) {
+  const LabeledFrame kLabeledFrameWithL2AndR2 = {
+      .label_to_samples = {{kL2, {0.1, 0.3, 0.5, 0.7}},
+                           {kR2, {0.2, 0.4, 0.6, 0.8}}}};
+  auto stereo_pass_through_renderer =
+      AudioElementRendererPassThrough::CreateFromScalableChannelLayoutConfig(
+          kStereoScalableChannelLayoutConfig, kStereoLayout,
+          kFourSamplesPerFrame);
+  ASSERT_NE(stereo_pass_through_renderer, nullptr);
+  EXPECT_TRUE(stereo_pass_through_renderer->IsPassThrough());
+
+  std::vector<absl::Span<const InternalSampleType>> rendered_samples;
+  EXPECT_THAT(stereo_pass_through_renderer->RenderLabeledFrameAsView(
+                  kLabeledFrameWithL2AndR2, rendered_samples),
+              IsOk());
+
+  ASSERT_EQ(rendered_samples.size(), 2);
+  EXPECT_EQ(rendered_samples[0].data(),
+            kLabeledFrameWithL2AndR2.label_to_samples.at(kL2).data());
+  EXPECT_EQ(rendered_samples[1].data(),
+            kLabeledFrameWithL2AndR2.label_to_samples.at(kR2).data());
+  EXPECT_EQ(rendered_samples[0].size(), 4);
+  EXPECT_EQ(rendered_samples[1].size(), 4);
+}
+
+TEST(RenderLabeledFrameAsView, OmitsTrimmedSamples) {
+  const LabeledFrame kStereoFrameWithTwoRenderedTicks = {
+      .samples_to_trim_at_end = 1,
+      .samples_to_trim_at_start = 1,
+      .label_to_samples = {{kL2, {0.999, 0.001, 0.002, 0.999}},
+                           {kR2, {0.999, 0.003, 0.004, 0.999}}}};
+  auto stereo_pass_through_renderer =
+      AudioElementRendererPassThrough::CreateFromScalableChannelLayoutConfig(
+          kStereoScalableChannelLayoutConfig, kStereoLayout,
+          kFourSamplesPerFrame);
+  ASSERT_NE(stereo_pass_through_renderer, nullptr);
+
+  std::vector<absl::Span<const InternalSampleType>> rendered_samples;
+  EXPECT_THAT(stereo_pass_through_renderer->RenderLabeledFrameAsView(
+                  kStereoFrameWithTwoRenderedTicks, rendered_samples),
+              IsOk());
+
+  ASSERT_EQ(rendered_samples.size(), 2);
+  EXPECT_THAT(rendered_samples[0], ElementsAre(0.001, 0.002));
+  EXPECT_THAT(rendered_samples[1], ElementsAre(0.003, 0.004));
+}
+
+TEST(RenderLabeledFrameAsView, DoesNotBufferSamplesToFlush) {
+  const LabeledFrame kMonoFrame = {.label_to_samples = {{kMono, {0.1, 0.2}}}};
+  auto mono_pass_through_renderer =
+      AudioElementRendererPassThrough::CreateFromScalableChannelLayoutConfig(
+          kMonoScalableChannelLayoutConfig, kMonoLayout, kFourSamplesPerFrame);
+  ASSERT_NE(mono_pass_through_renderer, nullptr);
+  std::vector<absl::Span<const InternalSampleType>> unused_rendered_samples;
+  EXPECT_THAT(mono_pass_through_renderer->RenderLabeledFrameAsView(
+                  kMonoFrame, unused_rendered_samples),
+              IsOk());
+
+  std::vector<std::vector<InternalSampleType>> flushed_samples;
+  mono_pass_through_renderer->Flush(flushed_samples);
+
+  EXPECT_THAT(flushed_samples, Each(IsEmpty()));
+}
+
 // Renders a sequence of `num_frames` frames, each with `samples_per_frame`
 // samples. The sequence increases by one for each value in the sequence.
 void RenderMonoSequence(int num_frames, int samples_per_frame,
@@ -33,12 +33,55 @@ namespace iamf_tools {
 namespace {
 
 using ::absl_testing::IsOk;
+using ::absl_testing::IsOkAndHolds;
 using enum ChannelLabel::Label;
 using testing::DoubleEq;
 using testing::ElementsAre;
 using testing::ElementsAreArray;
 using testing::Pointwise;
 
+TEST(GetNumTicksToRender, ReturnsZeroWithoutLabels) {
+  EXPECT_THAT(GetNumTicksToRender({}, {}, {}), IsOkAndHolds(0));
+}
+
+TEST(GetNumTicksToRender, ExcludesSamplesToBeTrimmed) {
+  const LabeledFrame kMonoLabeledFrame = {
+      .samples_to_trim_at_end = 1,
+      .samples_to_trim_at_start = 2,
+      .label_to_samples = {{kMono, {999, 999, 1, 2, 999}}}};
+  const std::vector<InternalSampleType> kEmptyChannel(5, 0.0);
+
+  EXPECT_THAT(GetNumTicksToRender(kMonoLabeledFrame, {kMono}, kEmptyChannel),
+              IsOkAndHolds(2));
+}
+
+TEST(GetNumTicksToRender, MatchesArrangeSamplesToRender) {
+  const LabeledFrame kStereoLabeledFrame = {
+      .samples_to_trim_at_start = 1,
+      .label_to_samples = {{kL2, {0, 1, 2}}, {kR2, {10, 11, 12}}}};
+  const std::vector<ChannelLabel::Label> kStereoArrangement = {kL2, kR2};
+  const std::vector<InternalSampleType> kEmptyChannel(3, 0.0);
+  std::vector<absl::Span<const InternalSampleType>> samples(
+      kStereoArrangement.size());
+  size_t num_valid_samples = 0;
+  ASSERT_THAT(ArrangeSamplesToRender(kStereoLabeledFrame, kStereoArrangement,
+                                     kEmptyChannel, samples, num_valid_samples),
+              IsOk());
+
+  EXPECT_THAT(GetNumTicksToRender(kStereoLabeledFrame, kStereoArrangement,
+                                  kEmptyChannel),
+              IsOkAndHolds(num_valid_samples));
+}
+
+TEST(GetNumTicksToRender, InvalidMissingLabel) {
+  const LabeledFrame kMonoLabeledFrame = {
+      .label_to_samples = {{kMono, {0, 1, 2}}}};
+  const std::vector<InternalSampleType> kEmptyChannel(3, 0.0);
+
+  EXPECT_FALSE(
+      GetNumTicksToRender(kMonoLabeledFrame, {kL2, kR2}, kEmptyChannel).ok());
+}
+
 TEST(ArrangeSamplesToRender, SucceedsOnEmptyFrame) {
   constexpr size_t kNumChannels = 2;
   std::vector<absl::Span<const InternalSampleType>> samples(kNumChannels);
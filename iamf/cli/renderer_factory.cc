@@ -13,15 +13,18 @@
 
 #include <cstddef>
 #include <memory>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include "absl/log/absl_log.h"
 #include "iamf/cli/audio_element_with_data.h"
 #include "iamf/cli/renderer/audio_element_renderer_ambisonics_to_channel.h"
+#include "iamf/cli/renderer/audio_element_renderer_async.h"
 #include "iamf/cli/renderer/audio_element_renderer_base.h"
 #include "iamf/cli/renderer/audio_element_renderer_channel_to_channel.h"
 #include "iamf/cli/renderer/audio_element_renderer_passthrough.h"
+#include "iamf/cli/renderer/sub_mix_renderer_base.h"
 #include "iamf/obu/audio_element.h"
 #include "iamf/obu/mix_presentation.h"
 #include "iamf/obu/rendering_config.h"
@@ -115,18 +118,44 @@ std::unique_ptr<AudioElementRendererBase> MaybeCreateChannelRenderer(
                                             num_samples_per_frame);
 }
 
-}  // namespace
-
-RendererFactoryBase::~RendererFactoryBase() {}
+#ifndef IAMF_TOOLS_DISABLE_BINAURAL_RENDERING
+// Checks if an audio element would be rendered by OBR, rather than passed
+// through, when rendering to `playback_layout`.
+bool IsAudioElementRenderedByObr(const AudioElementWithData& audio_element,
+                                 const SubMixAudioElement& sub_mix_audio_element,
+                                 const Layout& playback_layout) {
+  if (!IsAudioElementRenderedBinaural(
+          sub_mix_audio_element.rendering_config.headphones_rendering_mode,
+          playback_layout.layout_type)) {
+    return false;
+  }
+  switch (audio_element.obu.GetAudioElementType()) {
+    case AudioElementObu::kAudioElementSceneBased:
+      return true;
+    case AudioElementObu::kAudioElementChannelBased: {
+      const auto* channel_config =
+          std::get_if<ScalableChannelLayoutConfig>(&audio_element.obu.config_);
+      return channel_config != nullptr &&
+             AudioElementRendererPassThrough::
+                     CreateFromScalableChannelLayoutConfig(
+                         *channel_config, playback_layout,
+                         static_cast<size_t>(audio_element.codec_config
+                                                 ->GetNumSamplesPerFrame())) ==
+                 nullptr;
+    }
+    default:
+      return false;
+  }
+}
+#endif
 
-std::unique_ptr<AudioElementRendererBase>
-RendererFactory::CreateRendererForLayout(
+std::unique_ptr<AudioElementRendererBase> CreateSynchronousRenderer(
     const std::vector<DecodedUleb128>& audio_substream_ids,
     const SubstreamIdLabelsMap& substream_id_to_labels,
     AudioElementObu::AudioElementType audio_element_type,
     const AudioElementObu::AudioElementConfig& audio_element_config,
     const RenderingConfig& rendering_config, const Layout& loudness_layout,
-    size_t num_samples_per_frame, size_t sample_rate) const {
+    size_t num_samples_per_frame, size_t sample_rate) {
   Layout playback_layout = loudness_layout;
   const bool use_binaural = IsAudioElementRenderedBinaural(
       rendering_config.headphones_rendering_mode, playback_layout.layout_type);
@@ -166,4 +195,58 @@ RendererFactory::CreateRendererForLayout(
   ABSL_LOG(FATAL) << "Unsupported audio_element_type_= " << audio_element_type;
 }
 
+}  // namespace
+
+RendererFactoryBase::~RendererFactoryBase() {}
+
+RendererFactory::RendererFactory(bool render_asynchronously)
+    : render_asynchronously_(render_asynchronously) {}
+
+std::unique_ptr<AudioElementRendererBase>
+RendererFactory::CreateRendererForLayout(
+    const std::vector<DecodedUleb128>& audio_substream_ids,
+    const SubstreamIdLabelsMap& substream_id_to_labels,
+    AudioElementObu::AudioElementType audio_element_type,
+    const AudioElementObu::AudioElementConfig& audio_element_config,
+    const RenderingConfig& rendering_config, const Layout& loudness_layout,
+    size_t num_samples_per_frame, size_t sample_rate) const {
+  auto renderer = CreateSynchronousRenderer(
+      audio_substream_ids, substream_id_to_labels, audio_element_type,
+      audio_element_config, rendering_config, loudness_layout,
+      num_samples_per_frame, sample_rate);
+  // Pass-through renderers do no work, and are best used without copying.
+  if (!render_asynchronously_ || renderer == nullptr ||
+      renderer->IsPassThrough()) {
+    return renderer;
+  }
+  return AudioElementRendererAsync::Create(std::move(renderer));
+}
+
+std::unique_ptr<SubMixRendererBase>
+RendererFactory::CreateSubMixRendererForLayout(
+    const std::vector<const AudioElementWithData*>& audio_elements,
+    const std::vector<SubMixAudioElement>& sub_mix_audio_elements,
+    const Layout& loudness_layout, size_t num_samples_per_frame,
+    size_t sample_rate) const {
+#ifndef IAMF_TOOLS_DISABLE_BINAURAL_RENDERING
+  // A single audio element gains nothing from sharing the engine.
+  if (audio_elements.size() < 2 ||
+      audio_elements.size() != sub_mix_audio_elements.size()) {
+    return nullptr;
+  }
+  for (int i = 0; i < audio_elements.size(); ++i) {
+    if (audio_elements[i] == nullptr ||
+        !IsAudioElementRenderedByObr(*audio_elements[i],
+                                     sub_mix_audio_elements[i],
+                                     loudness_layout)) {
+      return nullptr;
+    }
+  }
+  return SubMixRendererBinaural::Create(audio_elements, num_samples_per_frame,
+                                        sample_rate);
+#else
+  return nullptr;
+#endif
+}
+
 }  // namespace iamf_tools
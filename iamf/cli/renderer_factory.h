@@ -18,6 +18,7 @@
 
 #include "iamf/cli/audio_element_with_data.h"
 #include "iamf/cli/renderer/audio_element_renderer_base.h"
+#include "iamf/cli/renderer/sub_mix_renderer_base.h"
 #include "iamf/obu/audio_element.h"
 #include "iamf/obu/mix_presentation.h"
 #include "iamf/obu/types.h"
@@ -55,6 +56,29 @@ class RendererFactoryBase {
       const RenderingConfig& rendering_config, const Layout& loudness_layout,
       size_t num_samples_per_frame, size_t sample_rate) const = 0;
 
+  /*!\brief Creates a renderer for all audio elements of a sub-mix at once.
+   *
+   * Factories may return a renderer which shares state between the audio
+   * elements of a sub-mix. Otherwise, each audio element is rendered with a
+   * renderer from `CreateRendererForLayout()`.
+   *
+   * \param audio_elements Audio elements in the sub-mix.
+   * \param sub_mix_audio_elements Sub-mix metadata of each audio element, in
+   *        the same order.
+   * \param loudness_layout Layout to render to.
+   * \param num_samples_per_frame Number of samples per frame.
+   * \param sample_rate Sample rate of the rendered output.
+   * \return Unique pointer to a sub-mix renderer or `nullptr` if the audio
+   *         elements should be rendered individually.
+   */
+  virtual std::unique_ptr<SubMixRendererBase> CreateSubMixRendererForLayout(
+      const std::vector<const AudioElementWithData*>& audio_elements,
+      const std::vector<SubMixAudioElement>& sub_mix_audio_elements,
+      const Layout& loudness_layout, size_t num_samples_per_frame,
+      size_t sample_rate) const {
+    return nullptr;
+  }
+
   /*!\brief Destructor. */
   virtual ~RendererFactoryBase() = 0;
 };
@@ -68,6 +92,15 @@ class RendererFactoryBase {
  */
 class RendererFactory : public RendererFactoryBase {
  public:
+  /*!\brief Constructor.
+   *
+   * \param render_asynchronously `true` to render each audio element on the
+   *        shared thread pool, with `AudioElementRendererAsync`. Callers which
+   *        submit frames to several renderers before flushing any of them can
+   *        then render them concurrently.
+   */
+  explicit RendererFactory(bool render_asynchronously = false);
+
   /*!\brief Creates a renderer based on the audio element and layout.
    *
    * \param audio_substream_ids Audio susbtream IDs.
@@ -89,8 +122,32 @@ class RendererFactory : public RendererFactoryBase {
       const RenderingConfig& rendering_config, const Layout& loudness_layout,
       size_t num_samples_per_frame, size_t sample_rate) const override;
 
+  /*!\brief Creates a renderer for all audio elements of a sub-mix at once.
+   *
+   * When every audio element of a sub-mix would be rendered binaurally with
+   * OBR, returns a renderer which registers all of them with a single OBR
+   * instance.
+   *
+   * \param audio_elements Audio elements in the sub-mix.
+   * \param sub_mix_audio_elements Sub-mix metadata of each audio element, in
+   *        the same order.
+   * \param loudness_layout Layout to render to.
+   * \param num_samples_per_frame Number of samples per frame.
+   * \param sample_rate Sample rate of the rendered output.
+   * \return Unique pointer to a sub-mix renderer or `nullptr` if the audio
+   *         elements should be rendered individually.
+   */
+  std::unique_ptr<SubMixRendererBase> CreateSubMixRendererForLayout(
+      const std::vector<const AudioElementWithData*>& audio_elements,
+      const std::vector<SubMixAudioElement>& sub_mix_audio_elements,
+      const Layout& loudness_layout, size_t num_samples_per_frame,
+      size_t sample_rate) const override;
+
   /*!\brief Destructor. */
   ~RendererFactory() override = default;
+
+ private:
+  const bool render_asynchronously_;
 };
 
 }  // namespace iamf_tools
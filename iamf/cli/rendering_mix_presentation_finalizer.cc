@@ -33,7 +33,6 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
-#include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "iamf/cli/audio_element_with_data.h"
@@ -46,6 +45,8 @@
 #include "iamf/cli/renderer_factory.h"
 #include "iamf/cli/sample_processor_base.h"
 #include "iamf/common/utils/macros.h"
+#include "iamf/common/utils/mixing_utils.h"
+#include "iamf/common/utils/thread_pool.h"
 #include "iamf/common/utils/validation_utils.h"
 #include "iamf/obu/audio_element.h"
 #include "iamf/obu/codec_config.h"
@@ -165,26 +166,11 @@ absl::Status InitializeRenderers(
   return absl::OkStatus();
 }
 
-absl::Status FlushUntilNonEmptyOrTimeout(
-    AudioElementRendererBase& audio_element_renderer,
-    std::vector<std::vector<InternalSampleType>>& rendered_samples) {
-  static const int kMaxNumTries = 500;
-  for (int i = 0; i < kMaxNumTries; i++) {
-    audio_element_renderer.Flush(rendered_samples);
-    if (std::none_of(rendered_samples.begin(), rendered_samples.end(),
-                     [](const auto& channel) { return channel.empty(); })) {
-      // Usually samples will be ready right away. So avoid sleeping.
-      return absl::OkStatus();
-    }
-    absl::SleepFor(absl::Milliseconds(10));
-  }
-  return absl::DeadlineExceededError("Timed out waiting for samples.");
-}
-
-absl::Status RenderLabeledFrameToLayout(
-    const LabeledFrame& labeled_frame, const CodecConfigObu& codec_config,
-    AudioElementRendererBase& renderer,
-    std::vector<std::vector<InternalSampleType>>& rendered_samples) {
+// Submits a labeled frame to the renderer. Asynchronous renderers may still be
+// rendering it on return.
+absl::Status SubmitLabeledFrameToRenderer(const LabeledFrame& labeled_frame,
+                                          const CodecConfigObu& codec_config,
+                                          AudioElementRendererBase& renderer) {
   const auto num_time_ticks = renderer.RenderLabeledFrame(labeled_frame);
 
   if (!num_time_ticks.ok()) {
@@ -192,31 +178,43 @@ absl::Status RenderLabeledFrameToLayout(
   } else if (*num_time_ticks >
              static_cast<size_t>(codec_config.GetNumSamplesPerFrame())) {
     return absl::InvalidArgumentError("Too many samples in this frame");
-  } else if (*num_time_ticks == 0) {
-    // This was an empty frame. Flush to get the number of channels right even
-    // when there is no actual sample.
-    renderer.Flush(rendered_samples);
-    return absl::OkStatus();
   }
+  return absl::OkStatus();
+}
 
-  return FlushUntilNonEmptyOrTimeout(renderer, rendered_samples);
+// Waits for the renderer to finish the submitted frame, then flushes it. Empty
+// frames are flushed too, to get the number of channels right even when there
+// is no actual sample.
+absl::Status FlushRenderedFrame(
+    AudioElementRendererBase& renderer,
+    std::vector<std::vector<InternalSampleType>>& rendered_samples) {
+  // Synchronous renderers are ready right away. Asynchronous renderers signal
+  // when the frame is finished.
+  return renderer.FlushWhenReady(rendered_samples);
 }
 
-// Fills in the output `mix_gains` with the gain in Q7.8 format to apply at each
-// tick.
+absl::Status RenderLabeledFrameToLayout(
+    const LabeledFrame& labeled_frame, const CodecConfigObu& codec_config,
+    AudioElementRendererBase& renderer,
+    std::vector<std::vector<InternalSampleType>>& rendered_samples) {
+  RETURN_IF_NOT_OK(
+      SubmitLabeledFrameToRenderer(labeled_frame, codec_config, renderer));
+  return FlushRenderedFrame(renderer, rendered_samples);
+}
+
+// Fills in the output `linear_mix_gain_per_tick` with the linear gain to apply
+// at each tick. `all_gains_are_unity` is set to true when the gains are known
+// to all be exactly 1, so applying them can be skipped. Parameter blocks at a
+// different `parameter_rate` are evaluated directly at the audio ticks.
 absl::Status GetParameterBlockLinearMixGainsPerTick(
     uint32_t common_sample_rate,
     const absl::flat_hash_map<DecodedUleb128, const ParameterBlockWithData*>&
         id_to_parameter_block,
     const MixGainParamDefinition& mix_gain,
-    std::vector<float>& linear_mix_gain_per_tick) {
-  if (mix_gain.parameter_rate_ != common_sample_rate) {
-    // TODO(b/283281856): Support resampling parameter blocks.
-    return absl::UnimplementedError(
-        "Parameter blocks that require resampling are not supported yet.");
-  }
-
+    std::vector<float>& linear_mix_gain_per_tick, bool& all_gains_are_unity) {
   // Initialize to the default gain value.
+  const bool default_gain_is_unity =
+      mix_gain.default_mix_gain_.GetQ7_8() == 0;
   std::fill(
       linear_mix_gain_per_tick.begin(), linear_mix_gain_per_tick.end(),
       std::pow(10.0f, mix_gain.default_mix_gain_.GetFloatingPoint() / 20.0f));
@@ -225,19 +223,53 @@ absl::Status GetParameterBlockLinearMixGainsPerTick(
   if (parameter_block_iter == id_to_parameter_block.end()) {
     // Default mix gain will be used for this frame. Logic elsewhere validates
     // the rest of the audio frames have consistent coverage.
+    all_gains_are_unity = default_gain_is_unity;
     return absl::OkStatus();
   }
   const auto& parameter_block = *parameter_block_iter->second;
-  InternalTimestamp cur_tick = parameter_block.start_timestamp;
-  // Process as many ticks as possible until all are found or the parameter
-  // block ends.
-  while (cur_tick < parameter_block.end_timestamp &&
-         (cur_tick - parameter_block.start_timestamp) <
-             linear_mix_gain_per_tick.size()) {
-    RETURN_IF_NOT_OK(parameter_block.obu->GetLinearMixGain(
-        cur_tick - parameter_block.start_timestamp,
-        linear_mix_gain_per_tick[cur_tick - parameter_block.start_timestamp]));
-    cur_tick++;
+  // Evaluate the curve for as many ticks as possible until all are found or
+  // the parameter block ends. Any remaining ticks keep the default gain. The
+  // timestamps of parameter blocks are already measured in audio ticks.
+  const size_t num_ticks_in_parameter_block = std::min(
+      linear_mix_gain_per_tick.size(),
+      static_cast<size_t>(std::max<InternalTimestamp>(
+          parameter_block.end_timestamp - parameter_block.start_timestamp, 0)));
+  bool parameter_block_gains_are_unity = false;
+  RETURN_IF_NOT_OK(parameter_block.obu->GetLinearMixGainsAtSampleRate(
+      common_sample_rate, 0,
+      absl::MakeSpan(linear_mix_gain_per_tick)
+          .first(num_ticks_in_parameter_block),
+      parameter_block_gains_are_unity));
+  all_gains_are_unity =
+      parameter_block_gains_are_unity &&
+      (num_ticks_in_parameter_block == linear_mix_gain_per_tick.size() ||
+       default_gain_is_unity);
+  return absl::OkStatus();
+}
+
+// Fills in `linear_mix_gain_per_tick` with the linear gain to apply at each of
+// the `num_ticks` ticks of the frame. It is left empty when the gains are all
+// unity, so the caller can skip applying them.
+absl::Status GetLinearMixGainsForFrame(
+    uint32_t common_sample_rate,
+    const absl::flat_hash_map<DecodedUleb128, const ParameterBlockWithData*>&
+        id_to_parameter_block,
+    const MixGainParamDefinition& mix_gain, size_t num_ticks,
+    std::vector<float>& linear_mix_gain_per_tick) {
+  linear_mix_gain_per_tick.resize(num_ticks);
+  bool all_gains_are_unity = false;
+  RETURN_IF_NOT_OK(GetParameterBlockLinearMixGainsPerTick(
+      common_sample_rate, id_to_parameter_block, mix_gain,
+      linear_mix_gain_per_tick, all_gains_are_unity));
+
+  if (!linear_mix_gain_per_tick.empty()) {
+    ABSL_LOG_FIRST_N(INFO, 6) << " First tick in this frame has gain: "
+                              << linear_mix_gain_per_tick.front();
+  }
+  if (all_gains_are_unity) {
+    // The curve is flat at 0 dB; applying it would not change the samples.
+    // Clearing keeps the capacity for later frames.
+    linear_mix_gain_per_tick.clear();
   }
   return absl::OkStatus();
 }
@@ -256,29 +288,30 @@ absl::Status GetAndApplyMixGain(
       rendered_samples.empty() ? 0 : rendered_samples[0].size();
 
   // Get the mix gain on a per tick basis from the parameter block.
-  linear_mix_gain_per_tick.resize(num_ticks);
-  RETURN_IF_NOT_OK(GetParameterBlockLinearMixGainsPerTick(
-      common_sample_rate, id_to_parameter_block, mix_gain,
+  RETURN_IF_NOT_OK(GetLinearMixGainsForFrame(
+      common_sample_rate, id_to_parameter_block, mix_gain, num_ticks,
       linear_mix_gain_per_tick));
-
-  if (!linear_mix_gain_per_tick.empty()) {
-    ABSL_LOG_FIRST_N(INFO, 6) << " First tick in this frame has gain: "
-                              << linear_mix_gain_per_tick.front();
+  if (linear_mix_gain_per_tick.empty()) {
+    return absl::OkStatus();
   }
 
   for (auto& rendered_samples_for_channel : rendered_samples) {
-    for (int tick = 0; tick < num_ticks; tick++) {
-      // Apply the mix gain per tick to all channels.
-      rendered_samples_for_channel[tick] *= linear_mix_gain_per_tick[tick];
-    }
+    // Apply the mix gain per tick to all channels.
+    RETURN_IF_NOT_OK(ApplyGainsPerTick(
+        linear_mix_gain_per_tick, absl::MakeSpan(rendered_samples_for_channel)));
   }
 
   return absl::OkStatus();
 }
 
-absl::Status MixAudioElements(
-    std::vector<std::vector<std::vector<InternalSampleType>>>&
+// Mixes the rendered audio elements into `rendered_samples`. The gains for each
+// audio element and the output gains are applied in the same pass. Empty gains
+// are skipped.
+absl::Status MixAudioElementsWithGains(
+    const std::vector<std::vector<std::vector<InternalSampleType>>>&
         rendered_audio_elements,
+    const std::vector<std::vector<float>>& element_linear_mix_gains,
+    absl::Span<const float> output_linear_mix_gains,
     std::vector<std::vector<InternalSampleType>>& rendered_samples) {
   const auto num_audio_elements = rendered_audio_elements.size();
   const auto num_channels = rendered_audio_elements.empty()
@@ -293,7 +326,7 @@ absl::Status MixAudioElements(
     // is the number of samples per frame. Rendering a partial (therefore
     // smaller) frame is allowed.
     ABSL_CHECK_GE(rendered_samples_for_channel.capacity(), num_ticks);
-    rendered_samples_for_channel.assign(num_ticks, 0.0);
+    rendered_samples_for_channel.resize(num_ticks);
   }
 
   // Expect all frames have the same number of channels and all channels
@@ -307,73 +340,243 @@ absl::Status MixAudioElements(
     }
   }
 
-  for (int a = 0; a < num_audio_elements; a++) {
-    const auto& rendered_samples_for_audio_element = rendered_audio_elements[a];
-    for (int c = 0; c < num_channels; c++) {
-      auto& rendered_samples_for_channel = rendered_samples[c];
-      const auto& rendered_samples_for_audio_element_for_channel =
-          rendered_samples_for_audio_element[c];
-      for (int t = 0; t < num_ticks; t++) {
-        // Sum all audio elements for this (channel, tick).
-        rendered_samples_for_channel[t] +=
-            rendered_samples_for_audio_element_for_channel[t];
-      }
+  // Mix all audio elements for each channel.
+  const std::vector<absl::Span<const float>> element_gain_spans(
+      element_linear_mix_gains.begin(), element_linear_mix_gains.end());
+  std::vector<absl::Span<const InternalSampleType>> samples_to_mix(
+      num_audio_elements);
+  for (int c = 0; c < num_channels; c++) {
+    for (int a = 0; a < num_audio_elements; a++) {
+      samples_to_mix[a] = absl::MakeConstSpan(rendered_audio_elements[a][c]);
     }
+    RETURN_IF_NOT_OK(MixSamplesWithGainsPerTick(
+        samples_to_mix, element_gain_spans, output_linear_mix_gains,
+        absl::MakeSpan(rendered_samples[c])));
   }
 
   return absl::OkStatus();
 }
 
-// Fills in `valid_rendered_samples` which is a view backed by
-// `rendered_samples` of the ticks actually rendered.
-absl::Status RenderAllFramesForLayout(
-    int32_t num_channels,
-    const std::vector<SubMixAudioElement> sub_mix_audio_elements,
+// Renders each audio element individually with its own renderer, then mixes
+// them while applying the element mix gains and the output mix gain.
+absl::Status RenderAndMixAudioElementsIndividually(
+    const std::vector<SubMixAudioElement>& sub_mix_audio_elements,
     const MixGainParamDefinition& output_mix_gain,
     const IdLabeledFrameMap& id_to_labeled_frame,
     const std::vector<const CodecConfigObu*>& codec_configs_in_sub_mix,
-    const std::vector<std::unique_ptr<AudioElementRendererBase>>& renderers,
     const absl::flat_hash_map<DecodedUleb128, const ParameterBlockWithData*>&
         id_to_parameter_block,
     const uint32_t common_sample_rate,
-    std::vector<std::vector<InternalSampleType>>& rendered_samples,
-    std::vector<absl::Span<const InternalSampleType>>& valid_rendered_samples) {
-  // Each audio element rendered individually with `element_mix_gain` applied.
-  // TODO(b/382197581): Avoid creating `rendered_audio_elements` and
-  //                    `linear_mix_gain_per_tick` for each frame.
-  std::vector<std::vector<std::vector<InternalSampleType>>>
-      rendered_audio_elements(sub_mix_audio_elements.size());
-  std::vector<float> linear_mix_gain_per_tick;
-  for (int i = 0; i < sub_mix_audio_elements.size(); i++) {
+    LayoutRenderingMetadata& layout_rendering_metadata) {
+  // Elements are independent, so they are rendered in parallel on the shared
+  // pool; `MixAudioElementsWithGains` then mixes them in a fixed order.
+  auto& rendered_audio_elements =
+      layout_rendering_metadata.rendered_audio_elements;
+  auto& element_linear_mix_gains =
+      layout_rendering_metadata.element_linear_mix_gains;
+  rendered_audio_elements.resize(sub_mix_audio_elements.size());
+  element_linear_mix_gains.resize(sub_mix_audio_elements.size());
+  const auto render_audio_element = [&](size_t i) -> absl::Status {
     const SubMixAudioElement& sub_mix_audio_element = sub_mix_audio_elements[i];
     const auto audio_element_id = sub_mix_audio_element.audio_element_id;
 
-    if (id_to_labeled_frame.find(audio_element_id) !=
-        id_to_labeled_frame.end()) {
+    // Renderers append to the output; clear the samples from the previous
+    // frame but keep the allocations.
+    auto& rendered_audio_element = rendered_audio_elements[i];
+    for (auto& rendered_samples_for_channel : rendered_audio_element) {
+      rendered_samples_for_channel.clear();
+    }
+    auto& renderer = *layout_rendering_metadata.renderers[i];
+    if (layout_rendering_metadata.frame_submitted_to_renderer[i]) {
+      // The frame was submitted ahead of time; collect it.
+      RETURN_IF_NOT_OK(FlushRenderedFrame(renderer, rendered_audio_element));
+    } else if (id_to_labeled_frame.find(audio_element_id) !=
+               id_to_labeled_frame.end()) {
       const auto& labeled_frame = id_to_labeled_frame.at(audio_element_id);
-      // Render the frame to the specified `loudness_layout` and apply element
-      // mix gain.
+      // Render the frame to the specified `loudness_layout`.
       RETURN_IF_NOT_OK(RenderLabeledFrameToLayout(
-          labeled_frame, *codec_configs_in_sub_mix[i], *renderers[i],
-          rendered_audio_elements[i]));
+          labeled_frame, *codec_configs_in_sub_mix[i], renderer,
+          rendered_audio_element));
     }
+    RETURN_IF_NOT_OK(ValidateContainerSizeEqual(
+        "rendered_audio_element", rendered_audio_element,
+        layout_rendering_metadata.num_channels));
 
-    RETURN_IF_NOT_OK(GetAndApplyMixGain(
+    // Element mix gains are applied while mixing.
+    return GetLinearMixGainsForFrame(
+        common_sample_rate, id_to_parameter_block,
+        sub_mix_audio_element.element_mix_gain,
+        rendered_audio_element.empty() ? 0
+                                       : rendered_audio_element.front().size(),
+        element_linear_mix_gains[i]);
+  };
+  RETURN_IF_NOT_OK(ThreadPool::GetShared().ParallelFor(
+      sub_mix_audio_elements.size(), render_audio_element));
+  std::fill(layout_rendering_metadata.frame_submitted_to_renderer.begin(),
+            layout_rendering_metadata.frame_submitted_to_renderer.end(),
+            false);
+
+  const size_t num_ticks =
+      rendered_audio_elements.empty() || rendered_audio_elements.front().empty()
+          ? 0
+          : rendered_audio_elements.front().front().size();
+  RETURN_IF_NOT_OK(GetLinearMixGainsForFrame(
+      common_sample_rate, id_to_parameter_block, output_mix_gain, num_ticks,
+      layout_rendering_metadata.output_linear_mix_gains));
+
+  return MixAudioElementsWithGains(
+      rendered_audio_elements, element_linear_mix_gains,
+      layout_rendering_metadata.output_linear_mix_gains,
+      layout_rendering_metadata.rendered_samples);
+}
+
+// Renders and mixes all audio elements at once with the sub-mix renderer of
+// `layout_rendering_metadata`, which applies the element mix gains to its
+// input.
+absl::Status RenderAndMixAudioElements(
+    const std::vector<SubMixAudioElement>& sub_mix_audio_elements,
+    const IdLabeledFrameMap& id_to_labeled_frame,
+    const absl::flat_hash_map<DecodedUleb128, const ParameterBlockWithData*>&
+        id_to_parameter_block,
+    uint32_t common_sample_rate, size_t num_samples_per_frame,
+    LayoutRenderingMetadata& layout_rendering_metadata) {
+  // Reuse the buffers of the layout; they only grow on the first frame.
+  auto& labeled_frames = layout_rendering_metadata.labeled_frames;
+  auto& element_linear_mix_gains =
+      layout_rendering_metadata.element_linear_mix_gains;
+  labeled_frames.assign(sub_mix_audio_elements.size(), nullptr);
+  element_linear_mix_gains.resize(sub_mix_audio_elements.size());
+  for (int i = 0; i < sub_mix_audio_elements.size(); i++) {
+    const auto labeled_frame_iter =
+        id_to_labeled_frame.find(sub_mix_audio_elements[i].audio_element_id);
+    if (labeled_frame_iter != id_to_labeled_frame.end()) {
+      labeled_frames[i] = &labeled_frame_iter->second;
+    }
+    // The shared renderer scales its input anyway, so there is nothing to
+    // skip when the gains are all unity.
+    element_linear_mix_gains[i].resize(num_samples_per_frame);
+    bool unused_all_gains_are_unity;
+    RETURN_IF_NOT_OK(GetParameterBlockLinearMixGainsPerTick(
         common_sample_rate, id_to_parameter_block,
-        sub_mix_audio_element.element_mix_gain, num_channels,
-        linear_mix_gain_per_tick, rendered_audio_elements[i]));
+        sub_mix_audio_elements[i].element_mix_gain,
+        element_linear_mix_gains[i], unused_all_gains_are_unity));
   }
 
-  // Mix the audio elements.
-  RETURN_IF_NOT_OK(MixAudioElements(rendered_audio_elements, rendered_samples));
+  return layout_rendering_metadata.sub_mix_renderer->RenderAndMixFrames(
+      labeled_frames, element_linear_mix_gains,
+      layout_rendering_metadata.rendered_samples);
+}
 
+// Passes through the only audio element of the sub-mix without rendering,
+// mixing, or copying its samples, when it would not change them. Sets
+// `passed_through` to true and points
+// `layout_rendering_metadata.valid_rendered_samples` into the labeled frame on
+// success. Sets `passed_through` to false when the sub-mix must be rendered
+// normally, e.g. when the renderer does not output its input unchanged, or when
+// any mix gain is not unity.
+absl::Status MaybePassThroughAudioElement(
+    const std::vector<SubMixAudioElement>& sub_mix_audio_elements,
+    const MixGainParamDefinition& output_mix_gain,
+    const IdLabeledFrameMap& id_to_labeled_frame,
+    const std::vector<const CodecConfigObu*>& codec_configs_in_sub_mix,
+    const absl::flat_hash_map<DecodedUleb128, const ParameterBlockWithData*>&
+        id_to_parameter_block,
+    const uint32_t common_sample_rate,
+    LayoutRenderingMetadata& layout_rendering_metadata, bool& passed_through) {
+  passed_through = false;
+  const auto& renderers = layout_rendering_metadata.renderers;
+  if (layout_rendering_metadata.sub_mix_renderer != nullptr ||
+      sub_mix_audio_elements.size() != 1 || renderers.size() != 1 ||
+      renderers.front() == nullptr || !renderers.front()->IsPassThrough()) {
+    return absl::OkStatus();
+  }
+  const auto labeled_frame_iter =
+      id_to_labeled_frame.find(sub_mix_audio_elements.front().audio_element_id);
+  if (labeled_frame_iter == id_to_labeled_frame.end()) {
+    return absl::OkStatus();
+  }
+
+  // Use the output buffer of views directly; it is overwritten by the regular
+  // path when the audio element cannot be passed through.
+  auto& valid_rendered_samples =
+      layout_rendering_metadata.valid_rendered_samples;
+  RETURN_IF_NOT_OK(renderers.front()->RenderLabeledFrameAsView(
+      labeled_frame_iter->second, valid_rendered_samples));
+  RETURN_IF_NOT_OK(ValidateContainerSizeEqual(
+      "valid_rendered_samples", valid_rendered_samples,
+      layout_rendering_metadata.num_channels));
+  const size_t num_ticks = valid_rendered_samples.empty()
+                               ? 0
+                               : valid_rendered_samples.front().size();
+  const auto num_samples_per_frame = static_cast<size_t>(
+      codec_configs_in_sub_mix.front()->GetNumSamplesPerFrame());
+  if (num_ticks > num_samples_per_frame) {
+    return absl::InvalidArgumentError("Too many samples in this frame");
+  }
+
+  // Gains are left empty when they are all unity.
+  auto& element_linear_mix_gains =
+      layout_rendering_metadata.element_linear_mix_gains;
+  element_linear_mix_gains.resize(1);
+  RETURN_IF_NOT_OK(GetLinearMixGainsForFrame(
+      common_sample_rate, id_to_parameter_block,
+      sub_mix_audio_elements.front().element_mix_gain, num_ticks,
+      element_linear_mix_gains.front()));
+  RETURN_IF_NOT_OK(GetLinearMixGainsForFrame(
+      common_sample_rate, id_to_parameter_block, output_mix_gain, num_ticks,
+      layout_rendering_metadata.output_linear_mix_gains));
+  passed_through = element_linear_mix_gains.front().empty() &&
+                   layout_rendering_metadata.output_linear_mix_gains.empty();
+  return absl::OkStatus();
+}
+
+// Renders and mixes all audio elements of the sub-mix for one layout. Fills in
+// `layout_rendering_metadata.valid_rendered_samples` which is a view backed by
+// `layout_rendering_metadata.rendered_samples` of the ticks actually rendered,
+// or by the labeled frame when the only audio element is passed through.
+absl::Status RenderAllFramesForLayout(
+    const std::vector<SubMixAudioElement>& sub_mix_audio_elements,
+    const MixGainParamDefinition& output_mix_gain,
+    const IdLabeledFrameMap& id_to_labeled_frame,
+    const std::vector<const CodecConfigObu*>& codec_configs_in_sub_mix,
+    const absl::flat_hash_map<DecodedUleb128, const ParameterBlockWithData*>&
+        id_to_parameter_block,
+    const uint32_t common_sample_rate,
+    LayoutRenderingMetadata& layout_rendering_metadata) {
   ABSL_LOG_FIRST_N(INFO, 1) << "    Applying output_mix_gain.default_mix_gain= "
                             << output_mix_gain.default_mix_gain_;
 
-  RETURN_IF_NOT_OK(GetAndApplyMixGain(
-      common_sample_rate, id_to_parameter_block, output_mix_gain, num_channels,
-      linear_mix_gain_per_tick, rendered_samples));
+  bool passed_through = false;
+  RETURN_IF_NOT_OK(MaybePassThroughAudioElement(
+      sub_mix_audio_elements, output_mix_gain, id_to_labeled_frame,
+      codec_configs_in_sub_mix, id_to_parameter_block, common_sample_rate,
+      layout_rendering_metadata, passed_through));
+  if (passed_through) {
+    return absl::OkStatus();
+  }
+
+  auto& rendered_samples = layout_rendering_metadata.rendered_samples;
+  if (layout_rendering_metadata.sub_mix_renderer != nullptr) {
+    RETURN_IF_NOT_OK(RenderAndMixAudioElements(
+        sub_mix_audio_elements, id_to_labeled_frame, id_to_parameter_block,
+        common_sample_rate,
+        codec_configs_in_sub_mix.empty()
+            ? 0
+            : codec_configs_in_sub_mix.front()->GetNumSamplesPerFrame(),
+        layout_rendering_metadata));
+    RETURN_IF_NOT_OK(GetAndApplyMixGain(
+        common_sample_rate, id_to_parameter_block, output_mix_gain,
+        layout_rendering_metadata.num_channels,
+        layout_rendering_metadata.output_linear_mix_gains, rendered_samples));
+  } else {
+    RETURN_IF_NOT_OK(RenderAndMixAudioElementsIndividually(
+        sub_mix_audio_elements, output_mix_gain, id_to_labeled_frame,
+        codec_configs_in_sub_mix, id_to_parameter_block, common_sample_rate,
+        layout_rendering_metadata));
+  }
 
+  auto& valid_rendered_samples =
+      layout_rendering_metadata.valid_rendered_samples;
   valid_rendered_samples.resize(rendered_samples.size());
   for (int c = 0; c < rendered_samples.size(); ++c) {
     valid_rendered_samples[c] = absl::MakeConstSpan(rendered_samples[c]);
@@ -477,10 +680,19 @@ absl::Status GenerateRenderingMetadataForLayouts(
         layout.loudness_layout, num_channels);
     layout_rendering_metadata.num_channels = num_channels;
 
-    can_render_status.Update(InitializeRenderers(
-        renderer_factory, audio_elements_in_sub_mix, sub_mix.audio_elements,
-        layout.loudness_layout, common_sample_rate,
-        layout_rendering_metadata.renderers));
+    // Prefer rendering all audio elements at once when the factory supports
+    // it; otherwise render each audio element individually.
+    layout_rendering_metadata.sub_mix_renderer =
+        renderer_factory.CreateSubMixRendererForLayout(
+            audio_elements_in_sub_mix, sub_mix.audio_elements,
+            layout.loudness_layout, common_num_samples_per_frame,
+            common_sample_rate);
+    if (layout_rendering_metadata.sub_mix_renderer == nullptr) {
+      can_render_status.Update(InitializeRenderers(
+          renderer_factory, audio_elements_in_sub_mix, sub_mix.audio_elements,
+          layout.loudness_layout, common_sample_rate,
+          layout_rendering_metadata.renderers));
+    }
 
     if (!can_render_status.ok()) {
       layout_rendering_metadata.can_render = false;
@@ -624,14 +836,76 @@ absl::Status FillLoudnessForMixPresentation(
   return absl::OkStatus();
 }
 
+// Submits the frames of all audio elements which are rendered individually by
+// asynchronous renderers, so that they render concurrently with each other and
+// with the rest of the temporal unit. They are flushed by
+// `RenderAllFramesForLayout()`.
+absl::Status SubmitFramesToAsynchronousRenderers(
+    const IdLabeledFrameMap& id_to_labeled_frame,
+    std::vector<SubmixRenderingMetadata>& rendering_metadata) {
+  for (auto& submix_rendering_metadata : rendering_metadata) {
+    for (auto& layout_rendering_metadata :
+         submix_rendering_metadata.layout_rendering_metadata) {
+      const auto& renderers = layout_rendering_metadata.renderers;
+      auto& frame_submitted_to_renderer =
+          layout_rendering_metadata.frame_submitted_to_renderer;
+      frame_submitted_to_renderer.assign(renderers.size(), false);
+      if (!layout_rendering_metadata.can_render ||
+          layout_rendering_metadata.sub_mix_renderer != nullptr) {
+        continue;
+      }
+      for (int i = 0; i < renderers.size(); i++) {
+        if (renderers[i] == nullptr || !renderers[i]->IsAsynchronous()) {
+          continue;
+        }
+        const auto labeled_frame_iter = id_to_labeled_frame.find(
+            submix_rendering_metadata.audio_elements_in_sub_mix[i]
+                .audio_element_id);
+        if (labeled_frame_iter == id_to_labeled_frame.end()) {
+          continue;
+        }
+        RETURN_IF_NOT_OK(SubmitLabeledFrameToRenderer(
+            labeled_frame_iter->second,
+            *submix_rendering_metadata.codec_configs_in_sub_mix[i],
+            *renderers[i]));
+        frame_submitted_to_renderer[i] = true;
+      }
+    }
+  }
+  return absl::OkStatus();
+}
+
+// Waits for and discards any frames still being rendered asynchronously, so
+// that no renderer refers to the labeled frames after an error.
+void DiscardSubmittedFrames(
+    std::vector<SubmixRenderingMetadata>& rendering_metadata) {
+  std::vector<std::vector<InternalSampleType>> unused_rendered_samples;
+  for (auto& submix_rendering_metadata : rendering_metadata) {
+    for (auto& layout_rendering_metadata :
+         submix_rendering_metadata.layout_rendering_metadata) {
+      auto& frame_submitted_to_renderer =
+          layout_rendering_metadata.frame_submitted_to_renderer;
+      for (int i = 0; i < frame_submitted_to_renderer.size(); i++) {
+        if (frame_submitted_to_renderer[i]) {
+          FlushRenderedFrame(*layout_rendering_metadata.renderers[i],
+                             unused_rendered_samples)
+              .IgnoreError();
+          frame_submitted_to_renderer[i] = false;
+        }
+      }
+    }
+  }
+}
+
 // Renders all submixes, layouts, and audio elements for a temporal unit. It
-// then optionally writes the rendered samples to a wav file and/or calculates
-// the loudness of the rendered samples.
-absl::Status RenderWriteAndCalculateLoudnessForTemporalUnit(
+// then optionally writes the rendered samples to a wav file. Layouts which
+// have a loudness calculator are appended to `layouts_to_measure`.
+absl::Status RenderAndWriteTemporalUnit(
     const IdLabeledFrameMap& id_to_labeled_frame,
     const absl::flat_hash_map<DecodedUleb128, const ParameterBlockWithData*>&
         id_to_parameter_block,
-    std::vector<SubmixRenderingMetadata>& rendering_metadata) {
+    std::vector<SubmixRenderingMetadata>& rendering_metadata,
+    std::vector<LayoutRenderingMetadata*>& layouts_to_measure) {
   for (auto& submix_rendering_metadata : rendering_metadata) {
     for (auto& layout_rendering_metadata :
          submix_rendering_metadata.layout_rendering_metadata) {
@@ -643,23 +917,18 @@ absl::Status RenderWriteAndCalculateLoudnessForTemporalUnit(
       }
 
       RETURN_IF_NOT_OK(RenderAllFramesForLayout(
-          layout_rendering_metadata.num_channels,
           submix_rendering_metadata.audio_elements_in_sub_mix,
           *submix_rendering_metadata.mix_gain, id_to_labeled_frame,
           submix_rendering_metadata.codec_configs_in_sub_mix,
-          layout_rendering_metadata.renderers, id_to_parameter_block,
-          submix_rendering_metadata.common_sample_rate,
-          layout_rendering_metadata.rendered_samples,
-          layout_rendering_metadata.valid_rendered_samples));
+          id_to_parameter_block, submix_rendering_metadata.common_sample_rate,
+          layout_rendering_metadata));
       auto span_of_valid_rendered_samples =
           absl::MakeSpan(layout_rendering_metadata.valid_rendered_samples);
 
       // Calculate loudness based on the original rendered samples; we do not
       // know what post-processing the end user will have.
       if (layout_rendering_metadata.loudness_calculator != nullptr) {
-        RETURN_IF_NOT_OK(
-            layout_rendering_metadata.loudness_calculator
-                ->AccumulateLoudnessForSamples(span_of_valid_rendered_samples));
+        layouts_to_measure.push_back(&layout_rendering_metadata);
       }
 
       // Perform any post-processing.
@@ -786,13 +1055,44 @@ absl::Status RenderingMixPresentationFinalizer::PushTemporalUnit(
     id_to_parameter_block[parameter_block.obu->parameter_id_] =
         &parameter_block;
   }
+  // Start all asynchronous renderers before waiting for any of them.
+  absl::Status render_status = absl::OkStatus();
   for (auto& [mix_presentation_ids, sub_mix_rendering_metadata] :
        mix_presentation_id_to_sub_mix_rendering_metadata_) {
-    RETURN_IF_NOT_OK(RenderWriteAndCalculateLoudnessForTemporalUnit(
-        id_to_labeled_frame, id_to_parameter_block,
-        sub_mix_rendering_metadata));
+    if (!render_status.ok()) {
+      break;
+    }
+    render_status = SubmitFramesToAsynchronousRenderers(
+        id_to_labeled_frame, sub_mix_rendering_metadata);
   }
-  return absl::OkStatus();
+  std::vector<LayoutRenderingMetadata*> layouts_to_measure;
+  for (auto& [mix_presentation_ids, sub_mix_rendering_metadata] :
+       mix_presentation_id_to_sub_mix_rendering_metadata_) {
+    if (!render_status.ok()) {
+      break;
+    }
+    render_status = RenderAndWriteTemporalUnit(
+        id_to_labeled_frame, id_to_parameter_block, sub_mix_rendering_metadata,
+        layouts_to_measure);
+  }
+  if (!render_status.ok()) {
+    for (auto& [mix_presentation_ids, sub_mix_rendering_metadata] :
+         mix_presentation_id_to_sub_mix_rendering_metadata_) {
+      DiscardSubmittedFrames(sub_mix_rendering_metadata);
+    }
+    return render_status;
+  }
+
+  // Each layout has its own loudness calculator, which sees the same samples
+  // in the same order regardless of which thread runs it. Measure them all in
+  // parallel, and finish before the next temporal unit reuses the buffers.
+  return ThreadPool::GetShared().ParallelFor(
+      layouts_to_measure.size(), [&layouts_to_measure](size_t i) {
+        auto& layout_rendering_metadata = *layouts_to_measure[i];
+        return layout_rendering_metadata.loudness_calculator
+            ->AccumulateLoudnessForSamples(
+                layout_rendering_metadata.valid_rendered_samples);
+      });
 }
 
 absl::StatusOr<absl::Span<const absl::Span<const InternalSampleType>>>
@@ -32,6 +32,7 @@
 #include "iamf/cli/loudness_calculator_factory_base.h"
 #include "iamf/cli/parameter_block_with_data.h"
 #include "iamf/cli/renderer/audio_element_renderer_base.h"
+#include "iamf/cli/renderer/sub_mix_renderer_base.h"
 #include "iamf/cli/renderer_factory.h"
 #include "iamf/cli/sample_processor_base.h"
 #include "iamf/obu/codec_config.h"
@@ -80,6 +81,12 @@ class RenderingMixPresentationFinalizer {
 
     // Renderers for each audio element.
     std::vector<std::unique_ptr<AudioElementRendererBase>> renderers;
+    // Renderer for all audio elements at once; may be `nullptr` if the
+    // audio elements are rendered individually by `renderers`.
+    std::unique_ptr<SubMixRendererBase> sub_mix_renderer;
+    // Whether the current frame of each audio element was submitted to an
+    // asynchronous renderer in `renderers`, and still has to be flushed.
+    std::vector<bool> frame_submitted_to_renderer;
 
     // The number of channels in this layout.
     int32_t num_channels;
@@ -87,11 +94,25 @@ class RenderingMixPresentationFinalizer {
     // layout.
     InternalTimestamp start_timestamp;
 
+    // Reusable buffers for storing the samples of each audio element rendered
+    // by `renderers` and the per-tick linear element mix gains to apply to
+    // them, either while mixing or by `sub_mix_renderer`. Empty gains are
+    // skipped when mixing.
+    std::vector<std::vector<std::vector<InternalSampleType>>>
+        rendered_audio_elements;
+    std::vector<std::vector<float>> element_linear_mix_gains;
+    // Reusable buffer for the labeled frame of each audio element passed to
+    // `sub_mix_renderer`, or `nullptr` when there is no frame.
+    std::vector<const LabeledFrame*> labeled_frames;
+    // Reusable buffer for the per-tick linear output mix gains.
+    std::vector<float> output_linear_mix_gains;
+
     // Reusable buffer for storing rendered samples.
     std::vector<std::vector<InternalSampleType>> rendered_samples;
 
     // Vector of views into the valid portions of the channels in
-    // `rendered_samples`.
+    // `rendered_samples`. Or into the samples of the labeled frame, when the
+    // only audio element is passed through without being copied.
     std::vector<absl::Span<const InternalSampleType>> valid_rendered_samples;
   };
 
@@ -183,8 +204,10 @@ class RenderingMixPresentationFinalizer {
    *
    * Renders a single temporal unit for all mix presentations. It also
    * accumulates the loudness of the rendered samples which will be finalized
-   * once FinalizePushingTemporalUnits() is called. This function must not be
-   * called after FinalizePushingTemporalUnits() has been called.
+   * once FinalizePushingTemporalUnits() is called. The loudness of each layout
+   * is accumulated in parallel on the shared thread pool, and is complete when
+   * this function returns. This function must not be called after
+   * FinalizePushingTemporalUnits() has been called.
    *
    * \param id_to_labeled_frame Data structure of samples for a given timestamp,
    *        keyed by audio element ID and channel label.
@@ -208,7 +231,10 @@ class RenderingMixPresentationFinalizer {
    * data is available after each call to `PushTemporalUnit` or
    * `FinalizePushingTemporalUnits`. The output span is invalidated by any
    * further calls to `PushTemporalUnit` or `FinalizePushingTemporalUnits` and
-   * typically should be consumed or copied immediately.
+   * typically should be consumed or copied immediately. When a single audio
+   * element is passed through to the layout, the rendered samples are views
+   * into the labeled frame which was pushed, so they are also invalidated
+   * when the labeled frame is modified or destroyed.
    *
    * Simple use pattern:
    *   - Call based on the same layout each time. E.g. to always render the
@@ -91,6 +91,16 @@ class SampleProcessorBase {
   absl::Span<const absl::Span<const InternalSampleType>>
   GetOutputSamplesAsSpan();
 
+  /*!\brief Gets the number of ticks the output lags behind the input.
+   *
+   * Processors with latency output fewer samples for the first frames, and
+   * output the delayed samples on `Flush()`. The output stays aligned with the
+   * input, and has the same total number of samples.
+   *
+   * \return Latency of the processor in ticks of the input timescale.
+   */
+  virtual size_t GetLatency() const { return 0; }
+
  protected:
   /*!\brief Pushes a frame of samples to the processor.
    *
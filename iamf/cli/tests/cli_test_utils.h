@@ -715,7 +715,7 @@ class MockObuSequencer : public ObuSequencerBase {
   MOCK_METHOD(absl::Status, PushFinalizedDescriptorObus,
               (absl::Span<const uint8_t> descriptor_obus), (override));
 
-  MOCK_METHOD(void, CloseDerived, (), (override));
+  MOCK_METHOD(absl::Status, CloseDerived, (), (override));
 };
 
 }  // namespace iamf_tools
@@ -521,6 +521,77 @@ TEST(DemixDecodedAudioSamples, OutputHasReconstructedLayers) {
               Pointwise(InternalSampleMatchesIntegralSample(), {500}));
 }
 
+TEST(DemixDecodedAudioSamples, ReusesChannelsOfExistingOutput) {
+  const std::vector<std::vector<int32_t>> kDecodedMonoSamplesInt = {{750}};
+  const std::vector<std::vector<int32_t>> kDecodedL2SamplesInt = {{1000}};
+  auto decoded_mono_samples =
+      Int32ToInternalSampleType2D(kDecodedMonoSamplesInt);
+  auto decoded_l2_samples = Int32ToInternalSampleType2D(kDecodedL2SamplesInt);
+  absl::flat_hash_map<DecodedUleb128, AudioElementWithData> audio_elements;
+  InitAudioElementWithLabelsAndScalableChannelLayout(
+      {{kMonoSubstreamId, {kMono}}, {kL2SubstreamId, {kL2}}},
+      kTwoLayerStereoConfig, audio_elements);
+  std::list<AudioFrameWithData> decoded_audio_frames;
+  for (const auto& [substream_id, decoded_samples] :
+       {std::make_pair(kMonoSubstreamId, &decoded_mono_samples),
+        std::make_pair(kL2SubstreamId, &decoded_l2_samples)}) {
+    decoded_audio_frames.push_back(AudioFrameWithData{
+        .obu = AudioFrameObu(
+            ObuHeader{
+                .num_samples_to_trim_at_end = kZeroSamplesToTrimAtEnd,
+                .num_samples_to_trim_at_start = kZeroSamplesToTrimAtStart,
+            },
+            substream_id, {}),
+        .start_timestamp = kStartTimestamp,
+        .end_timestamp = kEndTimestamp,
+        .decoded_samples = absl::MakeConstSpan(*decoded_samples),
+        .down_mixing_params = DownMixingParams()});
+  }
+  const auto demixing_module = DemixingModule::CreateForReconstruction(
+      DemixingModule::CreateIdToReconstructionConfig(audio_elements));
+  ASSERT_THAT(demixing_module, IsOk());
+  IdLabeledFrameMap id_to_labeled_decoded_frame;
+  EXPECT_THAT(demixing_module->DemixDecodedAudioSamples(
+                  decoded_audio_frames, id_to_labeled_decoded_frame),
+              IsOk());
+  ASSERT_TRUE(id_to_labeled_decoded_frame.contains(kAudioElementId));
+  const auto* first_demixed_r2_data = id_to_labeled_decoded_frame.at(
+      kAudioElementId).label_to_samples.at(kDemixedR2).data();
+
+  // Demix the next temporal unit into the same output.
+  decoded_mono_samples.front() = Int32ToInternalSampleType2D({{500}}).front();
+  EXPECT_THAT(demixing_module->DemixDecodedAudioSamples(
+                  decoded_audio_frames, id_to_labeled_decoded_frame),
+              IsOk());
+
+  // The demixed channel is overwritten in place.
+  const auto& label_to_samples =
+      id_to_labeled_decoded_frame.at(kAudioElementId).label_to_samples;
+  EXPECT_EQ(label_to_samples.size(), 3);
+  EXPECT_EQ(label_to_samples.at(kDemixedR2).data(), first_demixed_r2_data);
+  // D_R2 =  M - (L2 - 6 dB)  + 6 dB.
+  EXPECT_THAT(label_to_samples.at(kDemixedR2),
+              Pointwise(InternalSampleMatchesIntegralSample(), {0}));
+}
+
+TEST(DemixDecodedAudioSamples, RemovesAudioElementsWithoutAudioFrames) {
+  absl::flat_hash_map<DecodedUleb128, AudioElementWithData> audio_elements;
+  InitAudioElementWithLabelsAndScalableChannelLayout(
+      {{kMonoSubstreamId, {kMono}}, {kL2SubstreamId, {kL2}}},
+      kTwoLayerStereoConfig, audio_elements);
+  const auto demixing_module = DemixingModule::CreateForReconstruction(
+      DemixingModule::CreateIdToReconstructionConfig(audio_elements));
+  ASSERT_THAT(demixing_module, IsOk());
+  IdLabeledFrameMap id_to_labeled_decoded_frame;
+  id_to_labeled_decoded_frame[kAudioElementId].label_to_samples[kMono] = {0};
+
+  EXPECT_THAT(demixing_module->DemixDecodedAudioSamples(
+                  {}, id_to_labeled_decoded_frame),
+              IsOk());
+
+  EXPECT_FALSE(id_to_labeled_decoded_frame.contains(kAudioElementId));
+}
+
 TEST(DemixDecodedAudioSamples, OutputContainsReconGainAndLayerInfo) {
   const std::vector<std::vector<int32_t>> kDecodedSamplesInt = {{0}};
   const auto kDecodedSamples = Int32ToInternalSampleType2D(kDecodedSamplesInt);
@@ -586,6 +657,212 @@ TEST(DemixDecodedAudioSamples, OutputContainsReconGainAndLayerInfo) {
                                    ChannelAudioLayerConfig::kLayoutStereo));
 }
 
+// Creates decoded audio frames for a two-layer stereo audio element, with the
+// recon gain of the second layer applied to `D_R2`.
+std::list<AudioFrameWithData> CreateTwoLayerStereoDecodedAudioFrames(
+    const std::vector<std::vector<InternalSampleType>>& decoded_mono_samples,
+    const std::vector<std::vector<InternalSampleType>>& decoded_l2_samples,
+    uint8_t recon_gain_for_r2, const AudioElementWithData& audio_element) {
+  ReconGainInfoParameterData recon_gain_info_parameter_data;
+  recon_gain_info_parameter_data.recon_gain_elements = {
+      std::nullopt,
+      ReconGainElement{.recon_gain_flag = ReconGainElement::kReconGainFlagR,
+                       .recon_gain = {0, 0, recon_gain_for_r2}}};
+  std::list<AudioFrameWithData> decoded_audio_frames;
+  for (const auto& [substream_id, decoded_samples] :
+       {std::make_pair(kMonoSubstreamId, &decoded_mono_samples),
+        std::make_pair(kL2SubstreamId, &decoded_l2_samples)}) {
+    decoded_audio_frames.push_back(AudioFrameWithData{
+        .obu = AudioFrameObu(
+            ObuHeader{
+                .num_samples_to_trim_at_end = kZeroSamplesToTrimAtEnd,
+                .num_samples_to_trim_at_start = kZeroSamplesToTrimAtStart,
+            },
+            substream_id, {}),
+        .start_timestamp = kStartTimestamp,
+        .end_timestamp = kEndTimestamp,
+        .decoded_samples = absl::MakeConstSpan(*decoded_samples),
+        .down_mixing_params = DownMixingParams(),
+        .recon_gain_info_parameter_data = recon_gain_info_parameter_data,
+        .audio_element_with_data = &audio_element});
+  }
+  return decoded_audio_frames;
+}
+
+TEST(DemixDecodedAudioSamples, AppliesReconGainToDemixedChannels) {
+  const auto kDecodedMonoSamples =
+      Int32ToInternalSampleType2D({{750, 750, 750, 750}});
+  const auto kDecodedL2Samples =
+      Int32ToInternalSampleType2D({{1000, 1000, 1000, 1000}});
+  absl::flat_hash_map<DecodedUleb128, AudioElementWithData> audio_elements;
+  InitAudioElementWithLabelsAndScalableChannelLayout(
+      {{kMonoSubstreamId, {kMono}}, {kL2SubstreamId, {kL2}}},
+      kTwoLayerStereoConfig, audio_elements);
+  const auto demixing_module = DemixingModule::CreateForReconstruction(
+      DemixingModule::CreateIdToReconstructionConfig(audio_elements));
+  ASSERT_THAT(demixing_module, IsOk());
+
+  IdLabeledFrameMap id_to_labeled_decoded_frame;
+  EXPECT_THAT(demixing_module->DemixDecodedAudioSamples(
+                  CreateTwoLayerStereoDecodedAudioFrames(
+                      kDecodedMonoSamples, kDecodedL2Samples,
+                      /*recon_gain_for_r2=*/0,
+                      audio_elements.at(kAudioElementId)),
+                  id_to_labeled_decoded_frame),
+              IsOk());
+
+  // The gain ramps from unity to the recon gain over the first frame. The
+  // non-demixed channels are unaffected.
+  const auto& label_to_samples =
+      id_to_labeled_decoded_frame.at(kAudioElementId).label_to_samples;
+  EXPECT_THAT(label_to_samples.at(kL2),
+              Pointwise(InternalSampleMatchesIntegralSample(),
+                        {1000, 1000, 1000, 1000}));
+  // D_R2 =  M - (L2 - 6 dB)  + 6 dB = 500, before the recon gain.
+  EXPECT_THAT(label_to_samples.at(kDemixedR2),
+              Pointwise(InternalSampleMatchesIntegralSample(),
+                        {375, 250, 125, 0}));
+}
+
+TEST(DemixDecodedAudioSamples, SmoothsReconGainAcrossFrames) {
+  const auto kDecodedMonoSamples =
+      Int32ToInternalSampleType2D({{750, 750, 750, 750}});
+  const auto kDecodedL2Samples =
+      Int32ToInternalSampleType2D({{1000, 1000, 1000, 1000}});
+  absl::flat_hash_map<DecodedUleb128, AudioElementWithData> audio_elements;
+  InitAudioElementWithLabelsAndScalableChannelLayout(
+      {{kMonoSubstreamId, {kMono}}, {kL2SubstreamId, {kL2}}},
+      kTwoLayerStereoConfig, audio_elements);
+  const auto demixing_module = DemixingModule::CreateForReconstruction(
+      DemixingModule::CreateIdToReconstructionConfig(audio_elements));
+  ASSERT_THAT(demixing_module, IsOk());
+  IdLabeledFrameMap id_to_labeled_decoded_frame;
+  const auto demix_with_recon_gain = [&](uint8_t recon_gain) {
+    EXPECT_THAT(demixing_module->DemixDecodedAudioSamples(
+                    CreateTwoLayerStereoDecodedAudioFrames(
+                        kDecodedMonoSamples, kDecodedL2Samples, recon_gain,
+                        audio_elements.at(kAudioElementId)),
+                    id_to_labeled_decoded_frame),
+                IsOk());
+    return id_to_labeled_decoded_frame.at(kAudioElementId)
+        .label_to_samples.at(kDemixedR2);
+  };
+
+  EXPECT_THAT(demix_with_recon_gain(0),
+              Pointwise(InternalSampleMatchesIntegralSample(),
+                        {375, 250, 125, 0}));
+  // The recon gain holds steady when it does not change between frames.
+  EXPECT_THAT(demix_with_recon_gain(0),
+              Pointwise(InternalSampleMatchesIntegralSample(), {0, 0, 0, 0}));
+  // Then it ramps from the previous recon gain to the new one.
+  EXPECT_THAT(demix_with_recon_gain(255),
+              Pointwise(InternalSampleMatchesIntegralSample(),
+                        {125, 250, 375, 500}));
+  EXPECT_THAT(demix_with_recon_gain(255),
+              Pointwise(InternalSampleMatchesIntegralSample(),
+                        {500, 500, 500, 500}));
+}
+
+TEST(DemixDecodedAudioSamples, RampsReconGainSmoothlyAcrossLongFrames) {
+  // Long enough for the frame to be demixed in several tiles.
+  constexpr size_t kNumTicks = 1001;
+  const auto kDecodedMonoSamples = Int32ToInternalSampleType2D(
+      {std::vector<int32_t>(kNumTicks, 750)});
+  const auto kDecodedL2Samples = Int32ToInternalSampleType2D(
+      {std::vector<int32_t>(kNumTicks, 1000)});
+  absl::flat_hash_map<DecodedUleb128, AudioElementWithData> audio_elements;
+  InitAudioElementWithLabelsAndScalableChannelLayout(
+      {{kMonoSubstreamId, {kMono}}, {kL2SubstreamId, {kL2}}},
+      kTwoLayerStereoConfig, audio_elements);
+  const auto demixing_module = DemixingModule::CreateForReconstruction(
+      DemixingModule::CreateIdToReconstructionConfig(audio_elements));
+  ASSERT_THAT(demixing_module, IsOk());
+
+  const auto id_to_labeled_decoded_frame =
+      demixing_module->DemixDecodedAudioSamples(
+          CreateTwoLayerStereoDecodedAudioFrames(
+              kDecodedMonoSamples, kDecodedL2Samples,
+              /*recon_gain_for_r2=*/0, audio_elements.at(kAudioElementId)));
+  ASSERT_THAT(id_to_labeled_decoded_frame, IsOk());
+
+  // The gain ramps from unity to zero, reaching zero at the final tick, without
+  // any discontinuity at the boundaries of the tiles.
+  const InternalSampleType kDemixedR2Sample =
+      Int32ToNormalizedFloatingPoint<InternalSampleType>(500);
+  std::vector<InternalSampleType> expected_samples(kNumTicks);
+  for (size_t t = 0; t < kNumTicks; ++t) {
+    expected_samples[t] =
+        kDemixedR2Sample * (1.0 - static_cast<double>(t + 1) / kNumTicks);
+  }
+  constexpr double kErrorTolerance = 1e-15;
+  EXPECT_THAT(id_to_labeled_decoded_frame->at(kAudioElementId)
+                  .label_to_samples.at(kDemixedR2),
+              Pointwise(DoubleNear(kErrorTolerance), expected_samples));
+}
+
+TEST(DemixDecodedAudioSamples, UnityReconGainLeavesSamplesUnchanged) {
+  const auto kDecodedMonoSamples =
+      Int32ToInternalSampleType2D({{750, 750, 750, 750}});
+  const auto kDecodedL2Samples =
+      Int32ToInternalSampleType2D({{1000, 1000, 1000, 1000}});
+  absl::flat_hash_map<DecodedUleb128, AudioElementWithData> audio_elements;
+  InitAudioElementWithLabelsAndScalableChannelLayout(
+      {{kMonoSubstreamId, {kMono}}, {kL2SubstreamId, {kL2}}},
+      kTwoLayerStereoConfig, audio_elements);
+  const auto demixing_module = DemixingModule::CreateForReconstruction(
+      DemixingModule::CreateIdToReconstructionConfig(audio_elements));
+  ASSERT_THAT(demixing_module, IsOk());
+
+  const auto id_to_labeled_decoded_frame =
+      demixing_module->DemixDecodedAudioSamples(
+          CreateTwoLayerStereoDecodedAudioFrames(
+              kDecodedMonoSamples, kDecodedL2Samples,
+              /*recon_gain_for_r2=*/255, audio_elements.at(kAudioElementId)));
+  ASSERT_THAT(id_to_labeled_decoded_frame, IsOk());
+
+  EXPECT_THAT(id_to_labeled_decoded_frame->at(kAudioElementId)
+                  .label_to_samples.at(kDemixedR2),
+              Pointwise(InternalSampleMatchesIntegralSample(),
+                        {500, 500, 500, 500}));
+}
+
+TEST(DemixDecodedAudioSamples,
+     DoesNotApplyReconGainAfterCreateForDownMixingAndReconstruction) {
+  const auto kDecodedMonoSamples =
+      Int32ToInternalSampleType2D({{750, 750, 750, 750}});
+  const auto kDecodedL2Samples =
+      Int32ToInternalSampleType2D({{1000, 1000, 1000, 1000}});
+  absl::flat_hash_map<DecodedUleb128, AudioElementWithData> audio_elements;
+  InitAudioElementWithLabelsAndScalableChannelLayout(
+      {{kMonoSubstreamId, {kMono}}, {kL2SubstreamId, {kL2}}},
+      kTwoLayerStereoConfig, audio_elements);
+  absl::flat_hash_map<DecodedUleb128,
+                      DemixingModule::DownmixingAndReconstructionConfig>
+      id_to_config_map = {
+          {kAudioElementId,
+           {.user_labels = {kL2, kR2},
+            .substream_id_to_labels = {{kMonoSubstreamId, {kMono}},
+                                       {kL2SubstreamId, {kL2}}},
+            .label_to_output_gain = {}}}};
+  const auto demixing_module =
+      DemixingModule::CreateForDownMixingAndReconstruction(
+          std::move(id_to_config_map));
+  ASSERT_THAT(demixing_module, IsOk());
+
+  // The encoder computes the recon gain from the un-gained demixed samples.
+  const auto id_to_labeled_decoded_frame =
+      demixing_module->DemixDecodedAudioSamples(
+          CreateTwoLayerStereoDecodedAudioFrames(
+              kDecodedMonoSamples, kDecodedL2Samples,
+              /*recon_gain_for_r2=*/0, audio_elements.at(kAudioElementId)));
+  ASSERT_THAT(id_to_labeled_decoded_frame, IsOk());
+
+  EXPECT_THAT(id_to_labeled_decoded_frame->at(kAudioElementId)
+                  .label_to_samples.at(kDemixedR2),
+              Pointwise(InternalSampleMatchesIntegralSample(),
+                        {500, 500, 500, 500}));
+}
+
 void ExpectHasNumDownMixers(const DemixingModule& demixing_module,
                             int expected_number_of_down_mixers) {
   absl::StatusOr<const std::list<Demixer>*> down_mixers =
@@ -1385,5 +1662,68 @@ TEST_F(DemixingModuleTest, T2ToT4Demixer) {
   TestLosslessDemixing(1);
 }
 
+TEST_F(DemixingModuleTest, FusedDemixingMatchesDemixersAppliedInSequence) {
+  // The highest layer is 7.1.4, which requires six demixers.
+  input_labels_ = {kL7,  kR7,  kCentre, kLss7, kRss7, kLrs7,
+                   kRrs7, kLtf4, kRtf4,   kLtb4, kRtb4, kLFE};
+
+  // Use enough ticks to span several tiles, including a partial one.
+  constexpr int kNumTicks = 600;
+  int channel_seed = 0;
+  auto create_channel = [&channel_seed]() {
+    std::vector<int32_t> channel(kNumTicks);
+    for (int t = 0; t < kNumTicks; ++t) {
+      channel[t] = ((t * 7919 + channel_seed * 104729) % 20001 - 10000) * 1000;
+    }
+    channel_seed++;
+    return channel;
+  };
+  ConfigureLosslessAudioFrame({kMono}, {create_channel()});
+  ConfigureLosslessAudioFrame({kL2}, {create_channel()});
+  ConfigureLosslessAudioFrame({kCentre}, {create_channel()});
+  ConfigureLosslessAudioFrame({kLtf3, kRtf3},
+                              {create_channel(), create_channel()});
+  ConfigureLosslessAudioFrame({kLFE}, {create_channel()});
+  ConfigureLosslessAudioFrame({kL5, kR5}, {create_channel(), create_channel()});
+  ConfigureLosslessAudioFrame({kLtf4, kRtf4},
+                              {create_channel(), create_channel()});
+  ConfigureLosslessAudioFrame({kLss7, kRss7},
+                              {create_channel(), create_channel()});
+  auto demixing_module = DemixingModule::CreateForDownMixingAndReconstruction(
+      {{kAudioElementId,
+        DemixingModule::DownmixingAndReconstructionConfig{
+            .user_labels = input_labels_,
+            .substream_id_to_labels = substream_id_to_labels_}}});
+  ASSERT_THAT(demixing_module, IsOk());
+  ExpectHasNumDemixers(*demixing_module, 6);
+
+  const auto id_to_labeled_decoded_frame =
+      demixing_module->DemixDecodedAudioSamples(audio_frames_);
+  ASSERT_THAT(id_to_labeled_decoded_frame, IsOk());
+
+  // Apply the individual demixers one after another to the input channels.
+  auto expected_label_to_samples =
+      expected_id_to_labeled_decoded_frame_[kAudioElementId].label_to_samples;
+  const auto demixers = demixing_module->GetDemixers(kAudioElementId);
+  ASSERT_THAT(demixers, IsOk());
+  for (const auto& demixer : **demixers) {
+    EXPECT_THAT(demixer(audio_frames_.front().down_mixing_params,
+                        expected_label_to_samples),
+                IsOk());
+  }
+
+  const auto& actual_label_to_samples =
+      id_to_labeled_decoded_frame->at(kAudioElementId).label_to_samples;
+  EXPECT_EQ(actual_label_to_samples.size(), expected_label_to_samples.size());
+  for (const auto& [label, samples] : expected_label_to_samples) {
+    // The fused demixers multiply by reciprocals instead of dividing, so they
+    // are not bit-exact.
+    constexpr double kErrorTolerance = 1e-14;
+    ASSERT_TRUE(actual_label_to_samples.contains(label));
+    EXPECT_THAT(actual_label_to_samples.at(label),
+                Pointwise(DoubleNear(kErrorTolerance), samples));
+  }
+}
+
 }  // namespace
 }  // namespace iamf_tools
@@ -247,6 +247,70 @@ TEST(GetNextParameterBlockTimestamps, FailsWhenInputTimestampDoesNotAgree) {
   EXPECT_EQ(end_timestamp, kDuration);
 }
 
+TEST_F(GlobalTimingModuleTest,
+       GetNextParameterBlockTimestampsMeasuresTimestampsAtTheSampleRate) {
+  SetupObusForSubstreamIds({kFirstAudioFrameId});
+  constexpr DecodedUleb128 kParameterRate = 1000;
+  absl::flat_hash_map<DecodedUleb128, MixGainParamDefinition> param_definitions;
+  AddParamDefinitionWithMode0AndOneSubblock(kFirstParameterId, kParameterRate,
+                                            20, param_definitions);
+  auto global_timing_module = GlobalTimingModule::Create(
+      audio_elements_, GetParamDefinitionVariantMap(param_definitions));
+  ASSERT_THAT(global_timing_module, NotNull());
+
+  // 20 ticks at 1 kHz last as long as 960 ticks at 48 kHz.
+  constexpr uint32_t kParameterBlockDuration = 20;
+  InternalTimestamp start_timestamp;
+  InternalTimestamp end_timestamp;
+  EXPECT_THAT(global_timing_module->GetNextParameterBlockTimestamps(
+                  kFirstParameterId, 0, kParameterBlockDuration,
+                  start_timestamp, end_timestamp),
+              IsOk());
+  EXPECT_EQ(start_timestamp, 0);
+  EXPECT_EQ(end_timestamp, 960);
+
+  EXPECT_THAT(global_timing_module->GetNextParameterBlockTimestamps(
+                  kFirstParameterId, end_timestamp, kParameterBlockDuration,
+                  start_timestamp, end_timestamp),
+              IsOk());
+  EXPECT_EQ(start_timestamp, 960);
+  EXPECT_EQ(end_timestamp, 1920);
+}
+
+TEST_F(GlobalTimingModuleTest,
+       GetNextParameterBlockTimestampsExpectsInputInTicksOfTheSampleRate) {
+  SetupObusForSubstreamIds({kFirstAudioFrameId});
+  // 10 ticks at 44.1 kHz do not land on a 48 kHz tick, they end at the next
+  // one.
+  constexpr DecodedUleb128 kParameterRate = 44100;
+  constexpr uint32_t kParameterBlockDuration = 10;
+  absl::flat_hash_map<DecodedUleb128, MixGainParamDefinition> param_definitions;
+  AddParamDefinitionWithMode0AndOneSubblock(kFirstParameterId, kParameterRate,
+                                            kParameterBlockDuration,
+                                            param_definitions);
+  auto global_timing_module = GlobalTimingModule::Create(
+      audio_elements_, GetParamDefinitionVariantMap(param_definitions));
+  ASSERT_THAT(global_timing_module, NotNull());
+  InternalTimestamp start_timestamp;
+  InternalTimestamp end_timestamp;
+  EXPECT_THAT(global_timing_module->GetNextParameterBlockTimestamps(
+                  kFirstParameterId, 0, kParameterBlockDuration,
+                  start_timestamp, end_timestamp),
+              IsOk());
+  EXPECT_EQ(end_timestamp, 11);
+
+  // The second block starts at 10 ticks in parameter time, but the input is
+  // expected in ticks of the sample rate.
+  constexpr InternalTimestamp kStartInTicksOfTheParameterRate =
+      kParameterBlockDuration;
+  EXPECT_THAT(global_timing_module->GetNextParameterBlockTimestamps(
+                  kFirstParameterId, kStartInTicksOfTheParameterRate,
+                  kParameterBlockDuration, start_timestamp, end_timestamp),
+              Not(IsOk()));
+  EXPECT_EQ(start_timestamp, 11);
+  EXPECT_EQ(end_timestamp, 22);
+}
+
 TEST(GetNextParameterBlockTimestamps, FailsForUnknownParameterId) {
   constexpr DecodedUleb128 kStrayParameterBlockId = kFirstParameterId + 1;
   const absl::flat_hash_map<DecodedUleb128, AudioElementWithData>
@@ -13,6 +13,7 @@
 #include "iamf/cli/iamf_components.h"
 
 #include "gtest/gtest.h"
+#include "iamf/cli/proto/encoder_control_metadata.pb.h"
 #include "iamf/cli/proto/test_vector_metadata.pb.h"
 #include "iamf/cli/proto/user_metadata.pb.h"
 #include "iamf/cli/tests/cli_test_utils.h"
@@ -29,6 +30,36 @@ TEST(IamfComponentsTest, CreateLoudnessCalculatorFactoryReturnsNonNull) {
   EXPECT_NE(CreateLoudnessCalculatorFactory(), nullptr);
 }
 
+TEST(IamfComponentsTest,
+     CreateLoudnessCalculatorFactoryReturnsNonNullForEachGatingMode) {
+  iamf_tools_cli_proto::EncoderControlMetadata encoder_control_metadata;
+  for (const auto gating_mode :
+       {iamf_tools_cli_proto::LOUDNESS_GATING_MODE_EXACT,
+        iamf_tools_cli_proto::LOUDNESS_GATING_MODE_HISTOGRAM}) {
+    encoder_control_metadata.set_loudness_gating_mode(gating_mode);
+
+    EXPECT_NE(CreateLoudnessCalculatorFactory(encoder_control_metadata),
+              nullptr);
+  }
+}
+
+TEST(IamfComponentsTest,
+     CreateLoudnessCalculatorFactoryDefaultsToAValidGatingMode) {
+  EXPECT_NE(CreateLoudnessCalculatorFactory(
+                iamf_tools_cli_proto::EncoderControlMetadata()),
+            nullptr);
+}
+
+TEST(IamfComponentsTest,
+     CreateLoudnessCalculatorFactoryReturnsNullForInvalidGatingMode) {
+  iamf_tools_cli_proto::EncoderControlMetadata encoder_control_metadata;
+  encoder_control_metadata.set_loudness_gating_mode(
+      iamf_tools_cli_proto::LOUDNESS_GATING_MODE_INVALID);
+
+  EXPECT_EQ(CreateLoudnessCalculatorFactory(encoder_control_metadata),
+            nullptr);
+}
+
 TEST(IamfComponentsTest,
      CreateObuSequencersReturnsNonNullAndNonZeroObuSequencers) {
   auto obu_sequencers = CreateObuSequencers(
@@ -19,6 +19,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <utility>
 #include <vector>
 
@@ -50,6 +51,7 @@
 #include "iamf/cli/user_metadata_builder/iamf_input_layout.h"
 #include "iamf/cli/wav_writer.h"
 #include "iamf/common/read_bit_buffer.h"
+#include "iamf/common/utils/bounded_queue.h"
 #include "iamf/include/iamf_tools/iamf_tools_encoder_api_types.h"
 #include "iamf/obu/arbitrary_obu.h"
 #include "iamf/obu/audio_frame.h"
@@ -356,16 +358,109 @@ TEST_F(IamfEncoderTest, CreateFailsOnEmptyUserMetadata) {
                    .ok());
 }
 
-TEST_F(IamfEncoderTest, GetRedundatantDescriptorObusIsUnimplemented) {
+TEST_F(IamfEncoderTest, GetRedundantDescriptorObusMarksEachObuAsRedundant) {
   SetupDescriptorObus();
   auto iamf_encoder = CreateExpectOk();
-  std::vector<uint8_t> output_obus;
-  bool get_descriptors_obus_are_finalized;
+  std::vector<uint8_t> descriptor_obus;
+  std::vector<uint8_t> redundant_descriptor_obus;
+  bool unused_output_obus_are_finalized;
+  EXPECT_THAT(iamf_encoder.GetDescriptorObus(kNoRedundantCopy, descriptor_obus,
+                                             unused_output_obus_are_finalized),
+              IsOk());
+  EXPECT_THAT(iamf_encoder.GetDescriptorObus(kRedundantCopy,
+                                             redundant_descriptor_obus,
+                                             unused_output_obus_are_finalized),
+              IsOk());
 
-  EXPECT_THAT(
-      iamf_encoder.GetDescriptorObus(kRedundantCopy, output_obus,
-                                     get_descriptors_obus_are_finalized),
-      StatusIs(absl::StatusCode::kUnimplemented));
+  // The copies only differ in the `obu_redundant_copy` flag.
+  EXPECT_EQ(redundant_descriptor_obus.size(), descriptor_obus.size());
+  auto rb = MemoryBasedReadBitBuffer::CreateFromSpan(
+      MakeConstSpan(redundant_descriptor_obus));
+  ASSERT_NE(rb, nullptr);
+  int num_obus = 0;
+  while (rb->IsDataAvailable()) {
+    const auto header_metadata = ObuHeader::PeekObuTypeAndTotalObuSize(*rb);
+    ASSERT_THAT(header_metadata, IsOk());
+    EXPECT_TRUE(header_metadata->obu_redundant_copy);
+    ASSERT_THAT(rb->IgnoreBytes(header_metadata->total_obu_size), IsOk());
+    num_obus++;
+  }
+  // IA Sequence Header, Codec Config, Audio Element and Mix Presentation OBUs.
+  EXPECT_EQ(num_obus, 4);
+}
+
+TEST_F(IamfEncoderTest, DecoderCanJoinMidStreamAtRedundantDescriptorObus) {
+  constexpr uint32_t kRedundantDescriptorObuInterval = 3;
+  constexpr int kNumTemporalUnits = 10;
+  SetupDescriptorObus();
+  AddAudioFrame(user_metadata_);
+  user_metadata_.mutable_encoder_control_metadata()
+      ->set_redundant_descriptor_obu_interval(kRedundantDescriptorObuInterval);
+  auto iamf_encoder = CreateExpectOk();
+  std::vector<std::vector<uint8_t>> temporal_units;
+  const auto temporal_unit_data =
+      MakeStereoTemporalUnitData(MakeConstSpan(kEightZeroSamples));
+  for (int i = 0; i < kNumTemporalUnits; ++i) {
+    EXPECT_THAT(iamf_encoder.Encode(temporal_unit_data), IsOk());
+    if (i == kNumTemporalUnits - 1) {
+      EXPECT_THAT(iamf_encoder.FinalizeEncode(), IsOk());
+    }
+    std::vector<uint8_t> temporal_unit;
+    EXPECT_THAT(iamf_encoder.OutputTemporalUnit(temporal_unit), IsOk());
+    temporal_units.push_back(std::move(temporal_unit));
+  }
+  EXPECT_FALSE(iamf_encoder.GeneratingTemporalUnits());
+
+  // Tune in at an arbitrary temporal unit. The decoder must discard temporal
+  // units until it finds a redundant IA Sequence Header.
+  constexpr int kTuneInIndex = 4;
+  auto is_joinable = [](const std::vector<uint8_t>& temporal_unit) {
+    auto rb =
+        MemoryBasedReadBitBuffer::CreateFromSpan(MakeConstSpan(temporal_unit));
+    const auto header_metadata = ObuHeader::PeekObuTypeAndTotalObuSize(*rb);
+    return header_metadata.ok() &&
+           header_metadata->obu_type == kObuIaSequenceHeader &&
+           header_metadata->obu_redundant_copy;
+  };
+  int join_index = kTuneInIndex;
+  while (join_index < kNumTemporalUnits &&
+         !is_joinable(temporal_units[join_index])) {
+    join_index++;
+  }
+  // The join latency is bounded by the interval.
+  EXPECT_LT(join_index - kTuneInIndex, kRedundantDescriptorObuInterval);
+  ASSERT_LT(join_index, kNumTemporalUnits);
+
+  // Configure the decoder from the redundant copies.
+  auto rb = StreamBasedReadBitBuffer::Create(1024);
+  ASSERT_NE(rb, nullptr);
+  EXPECT_THAT(rb->PushBytes(MakeConstSpan(temporal_units[join_index])),
+              IsOk());
+  bool output_insufficient_data = false;
+  auto obu_processor = ObuProcessor::Create(/*is_exhaustive_and_exact=*/false,
+                                            rb.get(), output_insufficient_data);
+  ASSERT_NE(obu_processor, nullptr);
+  EXPECT_FALSE(output_insufficient_data);
+  EXPECT_THAT(obu_processor->codec_config_obus_, Pointee(SizeIs(1)));
+  EXPECT_THAT(obu_processor->audio_elements_, Pointee(SizeIs(1)));
+  EXPECT_EQ(obu_processor->mix_presentations_.size(), 1);
+
+  // Every temporal unit from then on is decodable. Later redundant copies are
+  // skipped.
+  for (int i = join_index; i < kNumTemporalUnits; ++i) {
+    if (i > join_index) {
+      EXPECT_THAT(rb->PushBytes(MakeConstSpan(temporal_units[i])), IsOk());
+    }
+    std::optional<ObuProcessor::OutputTemporalUnit> output_temporal_unit;
+    bool continue_processing = true;
+    EXPECT_THAT(obu_processor->ProcessTemporalUnit(
+                    /*eos_is_end_of_sequence=*/true, output_temporal_unit,
+                    continue_processing),
+                IsOk());
+
+    ASSERT_TRUE(output_temporal_unit.has_value());
+    EXPECT_EQ(output_temporal_unit->output_audio_frames.size(), 1);
+  }
 }
 
 TEST_F(IamfEncoderTest, CreateGeneratesDescriptorObus) {
@@ -548,6 +643,157 @@ TEST_F(IamfEncoderTest, GenerateDataObusTwoIterationsSucceeds) {
   EXPECT_EQ(iteration, 2);
 }
 
+TEST_F(IamfEncoderTest, GetDescriptorObusViewMatchesCopy) {
+  SetupDescriptorObus();
+  auto iamf_encoder = CreateExpectOk();
+
+  for (const bool redundant_copy : {kNoRedundantCopy, kRedundantCopy}) {
+    std::vector<uint8_t> descriptor_obus;
+    absl::Span<const uint8_t> descriptor_obus_view;
+    bool output_obus_are_finalized;
+    bool view_obus_are_finalized;
+    EXPECT_THAT(iamf_encoder.GetDescriptorObus(
+                    redundant_copy, descriptor_obus, output_obus_are_finalized),
+                IsOk());
+    EXPECT_THAT(
+        iamf_encoder.GetDescriptorObus(redundant_copy, descriptor_obus_view,
+                                       view_obus_are_finalized),
+        IsOk());
+
+    EXPECT_EQ(descriptor_obus_view, MakeConstSpan(descriptor_obus));
+    EXPECT_EQ(view_obus_are_finalized, output_obus_are_finalized);
+  }
+}
+
+TEST_F(IamfEncoderTest, OutputTemporalUnitViewMatchesCopy) {
+  SetupDescriptorObus();
+  AddAudioFrame(user_metadata_);
+  auto copying_iamf_encoder = CreateExpectOk();
+  auto viewing_iamf_encoder = CreateExpectOk();
+  const auto temporal_unit_data =
+      MakeStereoTemporalUnitData(MakeConstSpan(kEightZeroSamples));
+
+  // Feed the same data to both encoders. Reuse the buffer, as typical callers
+  // would.
+  std::vector<uint8_t> temporal_unit_obus;
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_THAT(copying_iamf_encoder.Encode(temporal_unit_data), IsOk());
+    EXPECT_THAT(viewing_iamf_encoder.Encode(temporal_unit_data), IsOk());
+    if (i == 2) {
+      EXPECT_THAT(copying_iamf_encoder.FinalizeEncode(), IsOk());
+      EXPECT_THAT(viewing_iamf_encoder.FinalizeEncode(), IsOk());
+    }
+    absl::Span<const uint8_t> temporal_unit_obus_view;
+    EXPECT_THAT(copying_iamf_encoder.OutputTemporalUnit(temporal_unit_obus),
+                IsOk());
+    EXPECT_THAT(
+        viewing_iamf_encoder.OutputTemporalUnit(temporal_unit_obus_view),
+        IsOk());
+
+    // The final view remains valid, even though the same call finalized the
+    // underlying sequencers.
+    EXPECT_FALSE(temporal_unit_obus_view.empty());
+    EXPECT_EQ(temporal_unit_obus_view, MakeConstSpan(temporal_unit_obus));
+  }
+  EXPECT_FALSE(viewing_iamf_encoder.GeneratingTemporalUnits());
+}
+
+TEST_F(IamfEncoderTest, GenerateAndEmitOnTwoThreadsMatchesOutputTemporalUnit) {
+  constexpr int kNumTemporalUnits = 6;
+  SetupDescriptorObus();
+  AddAudioFrame(user_metadata_);
+  AddArbitraryObuForFirstTick(user_metadata_, kDoesNotInvalidateBitstream);
+  for (int i = 0; i < kNumTemporalUnits; ++i) {
+    AddParameterBlockAtTimestamp(i * kNumSamplesPerFrame, user_metadata_);
+  }
+  auto serial_iamf_encoder = CreateExpectOk();
+  auto pipelined_iamf_encoder = CreateExpectOk();
+
+  // Each temporal unit has distinct samples and its own parameter block.
+  std::vector<std::array<InternalSampleType, kNumSamplesPerFrame>> samples(
+      kNumTemporalUnits);
+  for (int i = 0; i < kNumTemporalUnits; ++i) {
+    for (size_t j = 0; j < kNumSamplesPerFrame; ++j) {
+      samples[i][j] = 0.01 * (i + 1) * (static_cast<int>(j) - 4);
+    }
+  }
+  const auto encode_temporal_unit = [this, &samples](
+                                        int i, IamfEncoder& iamf_encoder) {
+    if (i >= kNumTemporalUnits) {
+      return absl::OkStatus();
+    }
+    auto temporal_unit_data =
+        MakeStereoTemporalUnitData(MakeConstSpan(samples[i]));
+    std::string serialized_metadata;
+    user_metadata_.parameter_block_metadata(i).SerializeToString(
+        &serialized_metadata);
+    temporal_unit_data.parameter_block_id_to_metadata[kParameterBlockId] =
+        serialized_metadata;
+    const absl::Status status = iamf_encoder.Encode(temporal_unit_data);
+    if (!status.ok() || i < kNumTemporalUnits - 1) {
+      return status;
+    }
+    return iamf_encoder.FinalizeEncode();
+  };
+
+  std::vector<std::vector<uint8_t>> expected_temporal_units;
+  for (int i = 0; serial_iamf_encoder.GeneratingTemporalUnits(); ++i) {
+    ASSERT_THAT(encode_temporal_unit(i, serial_iamf_encoder), IsOk());
+    std::vector<uint8_t> temporal_unit_obus;
+    ASSERT_THAT(serial_iamf_encoder.OutputTemporalUnit(temporal_unit_obus),
+                IsOk());
+    expected_temporal_units.push_back(temporal_unit_obus);
+  }
+
+  // Generate temporal units on another thread, while emitting them on this
+  // one.
+  BoundedQueue<IamfEncoder::GeneratedTemporalUnit> generated_temporal_units(
+      2);
+  absl::Status generate_status = absl::OkStatus();
+  std::thread generator([&] {
+    for (int i = 0; generate_status.ok(); ++i) {
+      IamfEncoder::GeneratedTemporalUnit generated_temporal_unit;
+      generate_status.Update(
+          encode_temporal_unit(i, pipelined_iamf_encoder));
+      generate_status.Update(pipelined_iamf_encoder.GenerateTemporalUnit(
+          generated_temporal_unit));
+      const bool generating_frames = generated_temporal_unit.generating_frames;
+      if (!generate_status.ok() ||
+          !generated_temporal_units.Push(std::move(generated_temporal_unit)) ||
+          !generating_frames) {
+        break;
+      }
+    }
+    generated_temporal_units.Close();
+  });
+  std::vector<std::vector<uint8_t>> temporal_units;
+  while (auto generated_temporal_unit = generated_temporal_units.Pop()) {
+    std::vector<uint8_t> temporal_unit_obus;
+    EXPECT_THAT(pipelined_iamf_encoder.EmitTemporalUnit(
+                    *std::move(generated_temporal_unit), temporal_unit_obus),
+                IsOk());
+    temporal_units.push_back(temporal_unit_obus);
+  }
+  generator.join();
+
+  EXPECT_THAT(generate_status, IsOk());
+  EXPECT_FALSE(pipelined_iamf_encoder.GeneratingTemporalUnits());
+  EXPECT_EQ(temporal_units, expected_temporal_units);
+  std::vector<uint8_t> expected_descriptor_obus;
+  std::vector<uint8_t> descriptor_obus;
+  bool expected_obus_are_finalized = false;
+  bool obus_are_finalized = false;
+  EXPECT_THAT(serial_iamf_encoder.GetDescriptorObus(
+                  kNoRedundantCopy, expected_descriptor_obus,
+                  expected_obus_are_finalized),
+              IsOk());
+  EXPECT_THAT(pipelined_iamf_encoder.GetDescriptorObus(
+                  kNoRedundantCopy, descriptor_obus, obus_are_finalized),
+              IsOk());
+  EXPECT_TRUE(obus_are_finalized);
+  EXPECT_EQ(descriptor_obus, expected_descriptor_obus);
+}
+
 TEST_F(IamfEncoderTest, SafeToUseAfterMove) {
   SetupDescriptorObus();
   AddAudioFrame(user_metadata_);
@@ -597,6 +843,154 @@ TEST_F(IamfEncoderTest, SafeToUseAfterMove) {
   EXPECT_EQ(parameter_blocks.size(), 1);
 }
 
+std::string SerializeChannelLabel(
+    ::iamf_tools_cli_proto::ChannelLabel channel_label) {
+  ChannelLabelMessage channel_label_message;
+  channel_label_message.set_channel_label(channel_label);
+  std::string serialized_channel_label;
+  channel_label_message.SerializeToString(&serialized_channel_label);
+  return serialized_channel_label;
+}
+
+TEST_F(IamfEncoderTest, GetChannelHandleReturnsDenseHandles) {
+  using enum ::iamf_tools_cli_proto::ChannelLabel;
+  SetupDescriptorObus();
+  auto iamf_encoder = CreateExpectOk();
+
+  api::IamfChannelHandle left_handle;
+  api::IamfChannelHandle right_handle;
+  EXPECT_THAT(iamf_encoder.GetChannelHandle(
+                  kAudioElementId, SerializeChannelLabel(CHANNEL_LABEL_L_2),
+                  left_handle),
+              IsOk());
+  EXPECT_THAT(iamf_encoder.GetChannelHandle(
+                  kAudioElementId, SerializeChannelLabel(CHANNEL_LABEL_R_2),
+                  right_handle),
+              IsOk());
+
+  EXPECT_EQ(left_handle, 0);
+  EXPECT_EQ(right_handle, 1);
+}
+
+TEST_F(IamfEncoderTest, GetChannelHandleReturnsTheSameHandleForTheSameChannel) {
+  using enum ::iamf_tools_cli_proto::ChannelLabel;
+  SetupDescriptorObus();
+  auto iamf_encoder = CreateExpectOk();
+  const std::string kLeftLabel = SerializeChannelLabel(CHANNEL_LABEL_L_2);
+
+  api::IamfChannelHandle first_handle;
+  api::IamfChannelHandle second_handle;
+  EXPECT_THAT(
+      iamf_encoder.GetChannelHandle(kAudioElementId, kLeftLabel, first_handle),
+      IsOk());
+  EXPECT_THAT(
+      iamf_encoder.GetChannelHandle(kAudioElementId, kLeftLabel, second_handle),
+      IsOk());
+
+  EXPECT_EQ(first_handle, second_handle);
+}
+
+TEST_F(IamfEncoderTest, GetChannelHandleFailsForUnknownAudioElement) {
+  using enum ::iamf_tools_cli_proto::ChannelLabel;
+  SetupDescriptorObus();
+  auto iamf_encoder = CreateExpectOk();
+
+  api::IamfChannelHandle unused_handle;
+  EXPECT_THAT(iamf_encoder.GetChannelHandle(
+                  kAudioElementId + 1, SerializeChannelLabel(CHANNEL_LABEL_L_2),
+                  unused_handle),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(IamfEncoderTest, GetChannelHandleFailsForInvalidLabel) {
+  SetupDescriptorObus();
+  auto iamf_encoder = CreateExpectOk();
+
+  api::IamfChannelHandle unused_handle;
+  EXPECT_FALSE(iamf_encoder
+                   .GetChannelHandle(kAudioElementId, "not a channel label",
+                                     unused_handle)
+                   .ok());
+}
+
+TEST_F(IamfEncoderTest, EncodeWithChannelHandlesFailsForTooManyChannels) {
+  using enum ::iamf_tools_cli_proto::ChannelLabel;
+  SetupDescriptorObus();
+  AddAudioFrame(user_metadata_);
+  auto iamf_encoder = CreateExpectOk();
+  api::IamfChannelHandle unused_handle;
+  ASSERT_THAT(iamf_encoder.GetChannelHandle(
+                  kAudioElementId, SerializeChannelLabel(CHANNEL_LABEL_L_2),
+                  unused_handle),
+              IsOk());
+
+  const std::vector<absl::Span<const double>> channels(
+      2, MakeConstSpan(kEightZeroSamples));
+  EXPECT_THAT(iamf_encoder.Encode(api::IamfTemporalUnitChannelData{
+                  .channels = MakeConstSpan(channels)}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(IamfEncoderTest, EncodeFailsForTypedParameterBlockWithUnknownId) {
+  SetupDescriptorObus();
+  AddAudioFrame(user_metadata_);
+  auto iamf_encoder = CreateExpectOk();
+  const std::vector<api::IamfParameterBlockMetadata> parameter_blocks = {
+      {.parameter_id = 9999,
+       .subblocks = {{.param_data = api::IamfMixGainParameterData{}}}}};
+
+  EXPECT_THAT(iamf_encoder.Encode(api::IamfTemporalUnitChannelData{
+                  .parameter_blocks = MakeConstSpan(parameter_blocks)}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(IamfEncoderTest, EncodeWithChannelHandlesMatchesSerializedLabels) {
+  using enum ::iamf_tools_cli_proto::ChannelLabel;
+  SetupDescriptorObus();
+  AddAudioFrame(user_metadata_);
+  constexpr std::array<InternalSampleType, 8> kLeftSamples = {
+      0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8};
+  constexpr std::array<InternalSampleType, 8> kRightSamples = {
+      -0.1, -0.2, -0.3, -0.4, -0.5, -0.6, -0.7, -0.8};
+  const std::string kLeftLabel = SerializeChannelLabel(CHANNEL_LABEL_L_2);
+  const std::string kRightLabel = SerializeChannelLabel(CHANNEL_LABEL_R_2);
+
+  // Encode with serialized labels.
+  auto label_encoder = CreateExpectOk();
+  EXPECT_THAT(label_encoder.Encode(api::IamfTemporalUnitData{
+                  .audio_element_id_to_data =
+                      {{kAudioElementId,
+                        {{kLeftLabel, MakeConstSpan(kLeftSamples)},
+                         {kRightLabel, MakeConstSpan(kRightSamples)}}}}}),
+              IsOk());
+  EXPECT_THAT(label_encoder.FinalizeEncode(), IsOk());
+  std::vector<uint8_t> expected_obus;
+  EXPECT_THAT(label_encoder.OutputTemporalUnit(expected_obus), IsOk());
+
+  // Encode the same samples with handles, resolved in the opposite order.
+  auto handle_encoder = CreateExpectOk();
+  api::IamfChannelHandle left_handle;
+  api::IamfChannelHandle right_handle;
+  ASSERT_THAT(handle_encoder.GetChannelHandle(kAudioElementId, kRightLabel,
+                                              right_handle),
+              IsOk());
+  ASSERT_THAT(
+      handle_encoder.GetChannelHandle(kAudioElementId, kLeftLabel, left_handle),
+      IsOk());
+  std::vector<absl::Span<const double>> channels(2);
+  channels[left_handle] = MakeConstSpan(kLeftSamples);
+  channels[right_handle] = MakeConstSpan(kRightSamples);
+  EXPECT_THAT(handle_encoder.Encode(api::IamfTemporalUnitChannelData{
+                  .channels = MakeConstSpan(channels)}),
+              IsOk());
+  EXPECT_THAT(handle_encoder.FinalizeEncode(), IsOk());
+  std::vector<uint8_t> output_obus;
+  EXPECT_THAT(handle_encoder.OutputTemporalUnit(output_obus), IsOk());
+
+  EXPECT_FALSE(output_obus.empty());
+  EXPECT_EQ(output_obus, expected_obus);
+}
+
 TEST_F(IamfEncoderTest, CallingFinalizeEncodeTwiceSucceeds) {
   SetupDescriptorObus();
   auto iamf_encoder = CreateExpectOk();
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/cli/label_samples_map.h"
+
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "iamf/cli/channel_label.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Pair;
+using ::testing::SizeIs;
+
+using enum ChannelLabel::Label;
+
+const std::vector<InternalSampleType> kSamples = {0.1, 0.2, 0.3};
+const std::vector<InternalSampleType> kOtherSamples = {0.4, 0.5};
+
+TEST(LabelSamplesMap, DefaultConstructedIsEmpty) {
+  const LabelSamplesMap label_to_samples;
+
+  EXPECT_TRUE(label_to_samples.empty());
+  EXPECT_EQ(label_to_samples.size(), 0);
+  EXPECT_EQ(label_to_samples.begin(), label_to_samples.end());
+  EXPECT_FALSE(label_to_samples.contains(kL2));
+  EXPECT_EQ(label_to_samples.find(kL2), label_to_samples.end());
+}
+
+TEST(LabelSamplesMap, ConstructsFromInitializerList) {
+  const LabelSamplesMap label_to_samples = {{kL2, kSamples},
+                                            {kR2, kOtherSamples}};
+
+  EXPECT_THAT(label_to_samples, SizeIs(2));
+  EXPECT_EQ(label_to_samples.at(kL2), kSamples);
+  EXPECT_EQ(label_to_samples.at(kR2), kOtherSamples);
+}
+
+TEST(LabelSamplesMap, IteratesPresentLabelsInIncreasingOrder) {
+  const LabelSamplesMap label_to_samples = {{kA24, kSamples},
+                                            {kOmitted, kOtherSamples},
+                                            {kCentre, kSamples}};
+
+  EXPECT_THAT(label_to_samples, ElementsAre(Pair(kOmitted, kOtherSamples),
+                                            Pair(kCentre, kSamples),
+                                            Pair(kA24, kSamples)));
+}
+
+TEST(LabelSamplesMap, SubscriptInsertsEmptySamples) {
+  LabelSamplesMap label_to_samples;
+
+  EXPECT_THAT(label_to_samples[kMono], IsEmpty());
+
+  EXPECT_TRUE(label_to_samples.contains(kMono));
+  EXPECT_NE(label_to_samples.find(kMono), label_to_samples.end());
+}
+
+TEST(LabelSamplesMap, EmplaceDoesNotOverwriteExistingLabel) {
+  LabelSamplesMap label_to_samples;
+
+  const auto [first_iter, first_inserted] =
+      label_to_samples.emplace(kL2, kSamples);
+  const auto [second_iter, second_inserted] =
+      label_to_samples.emplace(kL2, kOtherSamples);
+
+  EXPECT_TRUE(first_inserted);
+  EXPECT_FALSE(second_inserted);
+  EXPECT_EQ(first_iter, second_iter);
+  EXPECT_EQ(second_iter->first, kL2);
+  EXPECT_EQ(second_iter->second, kSamples);
+}
+
+TEST(LabelSamplesMap, EraseRemovesLabel) {
+  LabelSamplesMap label_to_samples = {{kL2, kSamples}, {kR2, kSamples}};
+
+  EXPECT_EQ(label_to_samples.erase(kL2), 1);
+  EXPECT_EQ(label_to_samples.erase(kL2), 0);
+
+  EXPECT_FALSE(label_to_samples.contains(kL2));
+  EXPECT_THAT(label_to_samples, ElementsAre(Pair(kR2, kSamples)));
+}
+
+TEST(LabelSamplesMap, ClearRetainsSampleBuffers) {
+  LabelSamplesMap label_to_samples = {{kL2, kSamples}};
+  const auto* original_data = label_to_samples.at(kL2).data();
+
+  label_to_samples.clear();
+  EXPECT_TRUE(label_to_samples.empty());
+
+  // Reinserting the label reuses the buffer, without stale samples.
+  auto& samples = label_to_samples[kL2];
+  EXPECT_THAT(samples, IsEmpty());
+  samples.assign(kOtherSamples.begin(), kOtherSamples.end());
+  EXPECT_EQ(samples.data(), original_data);
+}
+
+TEST(LabelSamplesMap, ReferencesAreStableAcrossInsertions) {
+  LabelSamplesMap label_to_samples;
+  auto& l2_samples = label_to_samples[kL2];
+  l2_samples = kSamples;
+
+  for (const auto label : {kR2, kCentre, kA0, kA24}) {
+    label_to_samples[label] = kOtherSamples;
+  }
+
+  EXPECT_EQ(&l2_samples, &label_to_samples.at(kL2));
+  EXPECT_EQ(l2_samples, kSamples);
+}
+
+TEST(LabelSamplesMap, CopyAssignmentCopiesOnlyPresentLabels) {
+  LabelSamplesMap source = {{kL2, kSamples}, {kR2, kOtherSamples}};
+  source.erase(kR2);
+  LabelSamplesMap destination = {{kMono, kSamples}};
+
+  destination = source;
+
+  EXPECT_EQ(destination, source);
+  EXPECT_THAT(destination, ElementsAre(Pair(kL2, kSamples)));
+}
+
+TEST(LabelSamplesMap, MoveLeavesSourceEmpty) {
+  LabelSamplesMap source = {{kL2, kSamples}};
+
+  const LabelSamplesMap destination = std::move(source);
+
+  EXPECT_THAT(destination, ElementsAre(Pair(kL2, kSamples)));
+  EXPECT_TRUE(source.empty());
+}
+
+TEST(LabelSamplesMap, EqualityComparesLabelsAndSamples) {
+  const LabelSamplesMap label_to_samples = {{kL2, kSamples}};
+
+  EXPECT_EQ(label_to_samples, LabelSamplesMap({{kL2, kSamples}}));
+  EXPECT_NE(label_to_samples, LabelSamplesMap({{kR2, kSamples}}));
+  EXPECT_NE(label_to_samples, LabelSamplesMap({{kL2, kOtherSamples}}));
+  EXPECT_NE(label_to_samples, LabelSamplesMap());
+}
+
+}  // namespace
+}  // namespace iamf_tools
@@ -1228,6 +1228,33 @@ TEST(CollectObusFromIaSequence, ConsumesTrivialIaSequence) {
   EXPECT_EQ(read_bit_buffer->Tell(), two_ia_sequences_size * 8);
 }
 
+TEST(CollectObusFromIaSequence, SkipsRedundantDescriptorObus) {
+  auto bitstream = InitAllDescriptorsForZerothOrderAmbisonics();
+  AudioFrameObu audio_frame_obu(ObuHeader(), kFirstSubstreamId,
+                                kArbitraryAudioFrame);
+  const IASequenceHeaderObu redundant_ia_sequence_header(
+      ObuHeader{.obu_redundant_copy = true}, ProfileVersion::kIamfSimpleProfile,
+      ProfileVersion::kIamfBaseProfile);
+  const auto temporal_unit_obus = SerializeObusExpectOk(
+      {&audio_frame_obu, &redundant_ia_sequence_header, &audio_frame_obu});
+  bitstream.insert(bitstream.end(), temporal_unit_obus.begin(),
+                   temporal_unit_obus.end());
+  const int64_t bitstream_size = bitstream.size();
+
+  DescriptorObuParser::ParsedDescriptorObus descriptor_obus;
+  std::list<AudioFrameWithData> audio_frames;
+  std::list<ParameterBlockWithData> parameter_blocks;
+  auto read_bit_buffer =
+      MemoryBasedReadBitBuffer::CreateFromSpan(absl::MakeConstSpan(bitstream));
+  EXPECT_THAT(CollectObusFromIaSequence(*read_bit_buffer, descriptor_obus,
+                                        audio_frames, parameter_blocks),
+              IsOk());
+
+  // The redundant copy does not begin a new IA sequence.
+  EXPECT_EQ(audio_frames.size(), 2);
+  EXPECT_EQ(read_bit_buffer->Tell(), bitstream_size * 8);
+}
+
 TEST(CollectObusFromIaSequence, ConsumesUpToNextIaSequence) {
   auto bitstream = InitAllDescriptorsForZerothOrderAmbisonics();
   AudioFrameObu audio_frame_obu(ObuHeader(), kFirstSubstreamId,
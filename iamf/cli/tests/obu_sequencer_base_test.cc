@@ -48,6 +48,7 @@ namespace iamf_tools {
 namespace {
 
 using ::absl_testing::IsOk;
+using ::absl_testing::StatusIs;
 using ::testing::_;
 using ::testing::Not;
 using ::testing::NotNull;
@@ -1359,6 +1360,21 @@ TEST(Close, CallsCloseDerived) {
   EXPECT_THAT(mock_obu_sequencer.Close(), IsOk());
 }
 
+TEST(Close, ReturnsErrorFromCloseDerived) {
+  MockObuSequencer mock_obu_sequencer(
+      *LebGenerator::Create(), kDoNotIncludeTemporalDelimiters,
+      kDoNotDelayDescriptorsUntilTrimAtStartIsKnown);
+
+  // For example, the concrete implementation may fail to write buffered data.
+  EXPECT_CALL(mock_obu_sequencer, CloseDerived())
+      .WillOnce(Return(absl::UnknownError("Failed to write.")));
+
+  EXPECT_THAT(mock_obu_sequencer.Close(),
+              StatusIs(absl::StatusCode::kUnknown));
+  // The sequencer is closed regardless.
+  EXPECT_THAT(mock_obu_sequencer.Close(), Not(IsOk()));
+}
+
 TEST(Close, FailsWhenCalledTwice) {
   MockObuSequencer mock_obu_sequencer(
       *LebGenerator::Create(), kDoNotIncludeTemporalDelimiters,
@@ -1620,6 +1636,37 @@ TEST(UpdateDescriptorObusAndClose, CallsCloseDerived) {
               IsOk());
 }
 
+TEST(UpdateDescriptorObusAndClose, CallsAbortDerivedWhenCloseDerivedFails) {
+  const IASequenceHeaderObu kOriginalIaSequenceHeader(
+      ObuHeader(), ProfileVersion::kIamfSimpleProfile,
+      ProfileVersion::kIamfBaseProfile);
+  const IASequenceHeaderObu kUpdatedIaSequenceHeader(
+      ObuHeader(), ProfileVersion::kIamfBaseProfile,
+      ProfileVersion::kIamfBaseProfile);
+  const std::list<MetadataObu> kNoMetadataObus;
+  const absl::flat_hash_map<DecodedUleb128, CodecConfigObu> kNoCodecConfigObus;
+  const absl::flat_hash_map<uint32_t, AudioElementWithData> kNoAudioElements;
+  const std::list<MixPresentationObu> kNoMixPresentationObus;
+  const std::list<ArbitraryObu> kNoArbitraryObus;
+  MockObuSequencer mock_obu_sequencer(
+      *LebGenerator::Create(), kDoNotIncludeTemporalDelimiters,
+      kDoNotDelayDescriptorsUntilTrimAtStartIsKnown);
+  EXPECT_THAT(
+      mock_obu_sequencer.PushDescriptorObus(
+          kOriginalIaSequenceHeader, kNoMetadataObus, kNoCodecConfigObus,
+          kNoAudioElements, kNoMixPresentationObus, kNoArbitraryObus),
+      IsOk());
+  // The finalized descriptors could not be written.
+  EXPECT_CALL(mock_obu_sequencer, CloseDerived())
+      .WillOnce(Return(absl::UnknownError("Failed to write.")));
+  EXPECT_CALL(mock_obu_sequencer, AbortDerived()).Times(1);
+
+  EXPECT_THAT(mock_obu_sequencer.UpdateDescriptorObusAndClose(
+                  kUpdatedIaSequenceHeader, kNoMetadataObus, kNoCodecConfigObus,
+                  kNoAudioElements, kNoMixPresentationObus, kNoArbitraryObus),
+              StatusIs(absl::StatusCode::kUnknown));
+}
+
 TEST(UpdateDescriptorObusAndClose,
      CallsAbortDerivedWhenPushFinalizedDescriptorObusFails) {
   const IASequenceHeaderObu kOriginalIaSequenceHeader(
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/cli/obu_sequencer_fragmented_mp4.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <list>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status_matchers.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "iamf/cli/audio_element_with_data.h"
+#include "iamf/cli/audio_frame_with_data.h"
+#include "iamf/cli/obu_sequencer_streaming_iamf.h"
+#include "iamf/cli/parameter_block_with_data.h"
+#include "iamf/cli/temporal_unit_view.h"
+#include "iamf/cli/tests/cli_test_utils.h"
+#include "iamf/common/leb_generator.h"
+#include "iamf/obu/arbitrary_obu.h"
+#include "iamf/obu/audio_frame.h"
+#include "iamf/obu/codec_config.h"
+#include "iamf/obu/ia_sequence_header.h"
+#include "iamf/obu/mix_presentation.h"
+#include "iamf/obu/obu_header.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+namespace {
+
+using ::absl_testing::IsOk;
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+constexpr DecodedUleb128 kCodecConfigId = 1;
+constexpr uint32_t kSampleRate = 48000;
+// 10 ms per temporal unit.
+constexpr uint32_t kNumSamplesPerFrame = 480;
+constexpr uint8_t kSampleSize = 16;
+constexpr DecodedUleb128 kAudioElementId = 1;
+constexpr DecodedUleb128 kSubstreamId = 1;
+constexpr DecodedUleb128 kMixPresentationId = 100;
+constexpr DecodedUleb128 kCommonMixGainParameterId = 999;
+
+constexpr uint32_t kOneTemporalUnitPerFragment = 0;
+constexpr uint32_t kNoChunks = 0;
+
+constexpr bool kDoNotIncludeTemporalDelimiters = false;
+
+// A parsed ISO/IEC 14496-12 box with a 32-bit size.
+struct Box {
+  std::string type;
+  absl::Span<const uint8_t> payload;
+};
+
+std::vector<Box> ParseBoxes(absl::Span<const uint8_t> data) {
+  std::vector<Box> boxes;
+  while (data.size() >= 8) {
+    const uint32_t size = (data[0] << 24) | (data[1] << 16) | (data[2] << 8) |
+                          data[3];
+    EXPECT_GE(size, 8);
+    EXPECT_LE(size, data.size());
+    if (size < 8 || size > data.size()) {
+      break;
+    }
+    boxes.push_back({.type = std::string(data.begin() + 4, data.begin() + 8),
+                     .payload = data.subspan(8, size - 8)});
+    data.remove_prefix(size);
+  }
+  EXPECT_TRUE(data.empty());
+  return boxes;
+}
+
+std::vector<std::string> GetBoxTypes(absl::Span<const uint8_t> data) {
+  std::vector<std::string> types;
+  for (const auto& box : ParseBoxes(data)) {
+    types.push_back(box.type);
+  }
+  return types;
+}
+
+std::optional<Box> FindBox(absl::Span<const uint8_t> data,
+                           absl::string_view type) {
+  for (const auto& box : ParseBoxes(data)) {
+    if (box.type == type) {
+      return box;
+    }
+  }
+  return std::nullopt;
+}
+
+// Returns the sample count of each `trun` box.
+std::vector<uint32_t> GetSampleCountPerChunk(absl::Span<const uint8_t> data) {
+  std::vector<uint32_t> sample_counts;
+  for (const auto& box : ParseBoxes(data)) {
+    if (box.type != "moof") {
+      continue;
+    }
+    const auto traf = FindBox(box.payload, "traf");
+    EXPECT_TRUE(traf.has_value());
+    const auto trun = FindBox(traf->payload, "trun");
+    EXPECT_TRUE(trun.has_value());
+    // Skip the version and flags.
+    const auto& p = trun->payload;
+    sample_counts.push_back((p[4] << 24) | (p[5] << 16) | (p[6] << 8) | p[7]);
+  }
+  return sample_counts;
+}
+
+std::vector<uint8_t> ReadFile(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {});
+}
+
+class ObuSequencerFragmentedMp4Test : public ::testing::Test {
+ public:
+  ObuSequencerFragmentedMp4Test()
+      : ia_sequence_header_obu_(ObuHeader(), ProfileVersion::kIamfSimpleProfile,
+                                ProfileVersion::kIamfSimpleProfile) {
+    AddLpcmCodecConfig(kCodecConfigId, kNumSamplesPerFrame, kSampleSize,
+                       kSampleRate, codec_config_obus_);
+    AddAmbisonicsMonoAudioElementWithSubstreamIds(
+        kAudioElementId, kCodecConfigId, {kSubstreamId}, codec_config_obus_,
+        audio_elements_);
+    AddMixPresentationObuWithAudioElementIds(
+        kMixPresentationId, {kAudioElementId}, kCommonMixGainParameterId,
+        kSampleRate, mix_presentation_obus_);
+  }
+
+  void PushDescriptorObus(ObuSequencerBase& sequencer) {
+    ASSERT_THAT(sequencer.PushDescriptorObus(
+                    ia_sequence_header_obu_, /*metadata_obus=*/{},
+                    codec_config_obus_, audio_elements_,
+                    mix_presentation_obus_, /*arbitrary_obus=*/{}),
+                IsOk());
+  }
+
+  // Pushes a temporal unit with one audio frame of `index + 1` bytes.
+  void PushTemporalUnit(int index, ObuSequencerBase& sequencer) {
+    std::list<AudioFrameWithData> audio_frames;
+    const InternalTimestamp start_timestamp = index * kNumSamplesPerFrame;
+    audio_frames.emplace_back(AudioFrameWithData{
+        .obu = AudioFrameObu(ObuHeader(), kSubstreamId,
+                             std::vector<uint8_t>(index + 1, index)),
+        .start_timestamp = start_timestamp,
+        .end_timestamp = start_timestamp + kNumSamplesPerFrame,
+        .encoded_samples = std::nullopt,
+        .down_mixing_params = {.in_bitstream = false},
+        .audio_element_with_data = &audio_elements_.at(kAudioElementId)});
+    const std::list<ParameterBlockWithData> kNoParameterBlocks;
+    const std::list<ArbitraryObu> kNoArbitraryObus;
+    const auto temporal_unit = TemporalUnitView::Create(
+        kNoParameterBlocks, audio_frames, kNoArbitraryObus);
+    ASSERT_THAT(temporal_unit, IsOk());
+    ASSERT_THAT(sequencer.PushTemporalUnit(*temporal_unit), IsOk());
+  }
+
+  void PushIaSequenceAndClose(int num_temporal_units,
+                              ObuSequencerBase& sequencer) {
+    PushDescriptorObus(sequencer);
+    for (int i = 0; i < num_temporal_units; ++i) {
+      PushTemporalUnit(i, sequencer);
+    }
+    ASSERT_THAT(sequencer.Close(), IsOk());
+  }
+
+ protected:
+  IASequenceHeaderObu ia_sequence_header_obu_;
+  absl::flat_hash_map<uint32_t, CodecConfigObu> codec_config_obus_;
+  absl::flat_hash_map<uint32_t, AudioElementWithData> audio_elements_;
+  std::list<MixPresentationObu> mix_presentation_obus_;
+};
+
+TEST_F(ObuSequencerFragmentedMp4Test, WritesOnlyHeaderWithoutTemporalUnits) {
+  const std::string kOutputMp4Filename = GetAndCleanupOutputFileName(".mp4");
+  ObuSequencerFragmentedMp4 sequencer(kOutputMp4Filename,
+                                      kOneTemporalUnitPerFragment, kNoChunks,
+                                      *LebGenerator::Create());
+
+  PushIaSequenceAndClose(0, sequencer);
+
+  EXPECT_THAT(GetBoxTypes(ReadFile(kOutputMp4Filename)),
+              ElementsAre("ftyp", "moov"));
+}
+
+TEST_F(ObuSequencerFragmentedMp4Test, StoresDescriptorObusInIacbBox) {
+  const std::string kOutputMp4Filename = GetAndCleanupOutputFileName(".mp4");
+  ObuSequencerFragmentedMp4 sequencer(kOutputMp4Filename,
+                                      kOneTemporalUnitPerFragment, kNoChunks,
+                                      *LebGenerator::Create());
+  ObuSequencerStreamingIamf expected_sequencer(kDoNotIncludeTemporalDelimiters,
+                                               *LebGenerator::Create());
+  PushIaSequenceAndClose(1, expected_sequencer);
+
+  PushIaSequenceAndClose(1, sequencer);
+
+  const auto file = ReadFile(kOutputMp4Filename);
+  std::optional<Box> box = FindBox(file, "moov");
+  for (const auto type : {"trak", "mdia", "minf", "stbl", "stsd"}) {
+    ASSERT_TRUE(box.has_value());
+    box = FindBox(box->payload, type);
+  }
+  ASSERT_TRUE(box.has_value());
+  // Skip the full box header and entry count of `stsd`.
+  const auto iamf = FindBox(box->payload.subspan(8), "iamf");
+  ASSERT_TRUE(iamf.has_value());
+  // Skip the fields of `AudioSampleEntry`.
+  const auto iacb = FindBox(iamf->payload.subspan(28), "iacb");
+  ASSERT_TRUE(iacb.has_value());
+  const auto expected_descriptor_obus =
+      expected_sequencer.GetSerializedDescriptorObus();
+  ASSERT_LT(expected_descriptor_obus.size(), 128);
+  // `configurationVersion`, then the size as a one-byte leb128.
+  EXPECT_EQ(iacb->payload[0], 1);
+  EXPECT_EQ(iacb->payload[1], expected_descriptor_obus.size());
+  EXPECT_THAT(iacb->payload.subspan(2),
+              ElementsAreArray(expected_descriptor_obus));
+}
+
+TEST_F(ObuSequencerFragmentedMp4Test, StoresTemporalUnitsInMdatBoxes) {
+  const std::string kOutputMp4Filename = GetAndCleanupOutputFileName(".mp4");
+  ObuSequencerFragmentedMp4 sequencer(kOutputMp4Filename,
+                                      kOneTemporalUnitPerFragment, kNoChunks,
+                                      *LebGenerator::Create());
+
+  PushIaSequenceAndClose(1, sequencer);
+
+  const auto file = ReadFile(kOutputMp4Filename);
+  const auto mdat = FindBox(file, "mdat");
+  ASSERT_TRUE(mdat.has_value());
+  // A single audio frame OBU, with an implicit substream ID and one byte of
+  // audio data.
+  constexpr uint8_t kExpectedObuHeaderByte = kObuIaAudioFrameId1 << 3;
+  EXPECT_THAT(mdat->payload, ElementsAre(kExpectedObuHeaderByte, 1, 0));
+}
+
+TEST_F(ObuSequencerFragmentedMp4Test, WritesOneChunkPerFragmentByDefault) {
+  const std::string kOutputMp4Filename = GetAndCleanupOutputFileName(".mp4");
+  ObuSequencerFragmentedMp4 sequencer(kOutputMp4Filename,
+                                      kOneTemporalUnitPerFragment, kNoChunks,
+                                      *LebGenerator::Create());
+
+  PushIaSequenceAndClose(3, sequencer);
+
+  const auto file = ReadFile(kOutputMp4Filename);
+  EXPECT_THAT(GetBoxTypes(file), ElementsAre("ftyp", "moov", "moof", "mdat",
+                                             "moof", "mdat", "moof", "mdat"));
+  EXPECT_THAT(GetSampleCountPerChunk(file), ElementsAre(1, 1, 1));
+}
+
+TEST_F(ObuSequencerFragmentedMp4Test,
+       GroupsTemporalUnitsIntoFragmentsOfTheConfiguredDuration) {
+  const std::string kOutputMp4Filename = GetAndCleanupOutputFileName(".mp4");
+  constexpr uint32_t kFragmentDurationMs = 30;
+  ObuSequencerFragmentedMp4 sequencer(kOutputMp4Filename, kFragmentDurationMs,
+                                      kNoChunks, *LebGenerator::Create());
+
+  PushIaSequenceAndClose(7, sequencer);
+
+  EXPECT_THAT(GetSampleCountPerChunk(ReadFile(kOutputMp4Filename)),
+              ElementsAre(3, 3, 1));
+}
+
+TEST_F(ObuSequencerFragmentedMp4Test, SplitsFragmentsIntoChunks) {
+  const std::string kOutputMp4Filename = GetAndCleanupOutputFileName(".mp4");
+  constexpr uint32_t kFragmentDurationMs = 40;
+  constexpr uint32_t kChunkDurationMs = 20;
+  ObuSequencerFragmentedMp4 sequencer(kOutputMp4Filename, kFragmentDurationMs,
+                                      kChunkDurationMs,
+                                      *LebGenerator::Create());
+
+  PushIaSequenceAndClose(6, sequencer);
+
+  EXPECT_THAT(GetSampleCountPerChunk(ReadFile(kOutputMp4Filename)),
+              ElementsAre(2, 2, 2));
+}
+
+TEST_F(ObuSequencerFragmentedMp4Test, AbortRemovesOutputFile) {
+  const std::string kOutputMp4Filename = GetAndCleanupOutputFileName(".mp4");
+  ObuSequencerFragmentedMp4 sequencer(kOutputMp4Filename,
+                                      kOneTemporalUnitPerFragment, kNoChunks,
+                                      *LebGenerator::Create());
+  PushDescriptorObus(sequencer);
+  // The file is created once the first untrimmed sample is known.
+  PushTemporalUnit(0, sequencer);
+  ASSERT_TRUE(std::filesystem::exists(kOutputMp4Filename));
+
+  sequencer.Abort();
+
+  EXPECT_FALSE(std::filesystem::exists(kOutputMp4Filename));
+}
+
+TEST(ObuSequencerFragmentedMp4, WritesHeaderForTrivialIaSequence) {
+  const std::string kOutputMp4Filename = GetAndCleanupOutputFileName(".mp4");
+  const IASequenceHeaderObu ia_sequence_header_obu(
+      ObuHeader(), ProfileVersion::kIamfSimpleProfile,
+      ProfileVersion::kIamfBaseProfile);
+  ObuSequencerFragmentedMp4 sequencer(kOutputMp4Filename,
+                                      kOneTemporalUnitPerFragment, kNoChunks,
+                                      *LebGenerator::Create());
+  EXPECT_THAT(sequencer.PushDescriptorObus(ia_sequence_header_obu,
+                                           /*metadata_obus=*/{},
+                                           /*codec_config_obus=*/{},
+                                           /*audio_elements=*/{},
+                                           /*mix_presentation_obus=*/{},
+                                           /*arbitrary_obus=*/{}),
+              IsOk());
+
+  EXPECT_THAT(sequencer.Close(), IsOk());
+
+  EXPECT_THAT(GetBoxTypes(ReadFile(kOutputMp4Filename)),
+              ElementsAre("ftyp", "moov"));
+}
+
+}  // namespace
+}  // namespace iamf_tools
@@ -13,6 +13,9 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
 #include <list>
 #include <memory>
 #include <optional>
@@ -33,6 +36,7 @@
 #include "iamf/cli/tests/cli_test_utils.h"
 #include "iamf/common/leb_generator.h"
 #include "iamf/common/read_bit_buffer.h"
+#include "iamf/common/utils/async_file_writer.h"
 #include "iamf/obu/arbitrary_obu.h"
 #include "iamf/obu/audio_frame.h"
 #include "iamf/obu/codec_config.h"
@@ -467,5 +471,40 @@ TEST_F(ObuSequencerIamfTest,
             kUpdatedProfile);
 }
 
+TEST_F(ObuSequencerIamfTest, WritesTheSameFileWithEachWritePolicy) {
+  InitObusForOneFrameIaSequence();
+  const auto write_file = [&](AsyncFileWriter::WritePolicy write_policy) {
+    const std::string output_iamf_filename =
+        GetAndCleanupOutputFileName(".iamf");
+    ObuSequencerIamf sequencer(output_iamf_filename,
+                               kDoNotIncludeTemporalDelimiters,
+                               *LebGenerator::Create(), write_policy);
+    EXPECT_THAT(
+        sequencer.PushDescriptorObus(
+            *ia_sequence_header_obu_, /*metadata_obus=*/{}, codec_config_obus_,
+            audio_elements_, mix_presentation_obus_, arbitrary_obus_),
+        IsOk());
+    const auto temporal_unit = TemporalUnitView::Create(
+        parameter_blocks_, audio_frames_, arbitrary_obus_);
+    EXPECT_THAT(temporal_unit, IsOk());
+    EXPECT_THAT(sequencer.PushTemporalUnit(*temporal_unit), IsOk());
+    EXPECT_THAT(
+        sequencer.UpdateDescriptorObusAndClose(
+            *ia_sequence_header_obu_, /*metadata_obus=*/{}, codec_config_obus_,
+            audio_elements_, mix_presentation_obus_, arbitrary_obus_),
+        IsOk());
+
+    std::ifstream file(output_iamf_filename, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), {});
+  };
+
+  const auto expected_file =
+      write_file(AsyncFileWriter::WritePolicy::kBuffered);
+  EXPECT_FALSE(expected_file.empty());
+  EXPECT_EQ(write_file(AsyncFileWriter::WritePolicy::kSynchronized),
+            expected_file);
+  EXPECT_EQ(write_file(AsyncFileWriter::WritePolicy::kDirect), expected_file);
+}
+
 }  // namespace
 }  // namespace iamf_tools
@@ -35,6 +35,7 @@
 #include "iamf/obu/ia_sequence_header.h"
 #include "iamf/obu/obu_base.h"
 #include "iamf/obu/obu_header.h"
+#include "iamf/obu/temporal_delimiter.h"
 #include "iamf/obu/types.h"
 
 namespace iamf_tools {
@@ -56,6 +57,7 @@ constexpr DecodedUleb128 kFirstAudioElementId = 1;
 constexpr DecodedUleb128 kFirstSubstreamId = 1;
 
 constexpr bool kDoNotIncludeTemporalDelimiters = false;
+constexpr bool kIncludeTemporalDelimiters = true;
 
 constexpr std::nullopt_t kOriginalSamplesAreIrrelevant = std::nullopt;
 
@@ -155,6 +157,95 @@ TEST(GetSerializedDescriptorObus, ReturnsSerializedUpdatedDescriptorObus) {
             expected_serialized_descriptor_obus);
 }
 
+TEST(GetSerializedRedundantDescriptorObus, IsEmptyBeforePushDescriptorObus) {
+  ObuSequencerStreamingIamf sequencer(kDoNotIncludeTemporalDelimiters,
+                                      *LebGenerator::Create());
+
+  EXPECT_TRUE(sequencer.GetSerializedRedundantDescriptorObus().empty());
+}
+
+TEST(GetSerializedRedundantDescriptorObus,
+     ReturnsPushedDescriptorObusMarkedAsRedundant) {
+  const IASequenceHeaderObu ia_sequence_header_obu(
+      ObuHeader(), ProfileVersion::kIamfSimpleProfile,
+      ProfileVersion::kIamfBaseProfile);
+  ObuSequencerStreamingIamf sequencer(kDoNotIncludeTemporalDelimiters,
+                                      *LebGenerator::Create());
+  EXPECT_THAT(sequencer.PushDescriptorObus(
+                  ia_sequence_header_obu, /*metadata_obus=*/{},
+                  /*codec_config_obus=*/{},
+                  /*audio_elements=*/{}, /*mix_presentation_obus=*/{},
+                  /*arbitrary_obus=*/{}),
+              IsOk());
+
+  const IASequenceHeaderObu redundant_ia_sequence_header_obu(
+      ObuHeader{.obu_redundant_copy = true}, ProfileVersion::kIamfSimpleProfile,
+      ProfileVersion::kIamfBaseProfile);
+  const std::vector<uint8_t> expected_serialized_redundant_descriptor_obus =
+      SerializeObusExpectOk(
+          std::list<const ObuBase*>({&redundant_ia_sequence_header_obu}));
+  EXPECT_EQ(sequencer.GetSerializedRedundantDescriptorObus(),
+            expected_serialized_redundant_descriptor_obus);
+}
+
+TEST(GetPreviousSerializedTemporalUnit,
+     InsertsRedundantDescriptorObusAtTheConfiguredInterval) {
+  IASequenceHeaderObu ia_sequence_header_obu(ObuHeader(),
+                                             ProfileVersion::kIamfSimpleProfile,
+                                             ProfileVersion::kIamfBaseProfile);
+  absl::flat_hash_map<DecodedUleb128, CodecConfigObu> codec_config_obus;
+  absl::flat_hash_map<DecodedUleb128, AudioElementWithData> audio_elements;
+  AddLpcmCodecConfig(kCodecConfigId, kEightSamplesPerFrame, kBitDepth,
+                     kSampleRate, codec_config_obus);
+  AddAmbisonicsMonoAudioElementWithSubstreamIds(
+      kFirstAudioElementId, kCodecConfigId, {kFirstSubstreamId},
+      codec_config_obus, audio_elements);
+  constexpr uint32_t kRedundantDescriptorObuInterval = 2;
+  ObuSequencerStreamingIamf sequencer(kIncludeTemporalDelimiters,
+                                      *LebGenerator::Create(),
+                                      kRedundantDescriptorObuInterval);
+  EXPECT_THAT(
+      sequencer.PushDescriptorObus(ia_sequence_header_obu, /*metadata_obus=*/{},
+                                   codec_config_obus, audio_elements,
+                                   /*mix_presentation_obus=*/{},
+                                   /*arbitrary_obus=*/{}),
+      IsOk());
+  const auto redundant_descriptor_obus =
+      sequencer.GetSerializedRedundantDescriptorObus();
+  ASSERT_FALSE(redundant_descriptor_obus.empty());
+
+  const TemporalDelimiterObu temporal_delimiter(ObuHeader{});
+  const std::vector<uint8_t> serialized_temporal_delimiter =
+      SerializeObusExpectOk(std::list<const ObuBase*>({&temporal_delimiter}));
+  for (int i = 0; i < 5; ++i) {
+    std::list<AudioFrameWithData> audio_frames;
+    AddOneFrame(kFirstAudioElementId, kFirstSubstreamId,
+                i * kEightSamplesPerFrame, (i + 1) * kEightSamplesPerFrame,
+                audio_elements, audio_frames);
+    const auto temporal_unit = TemporalUnitView::Create(
+        kNoParameterBlocks, audio_frames, kNoArbitraryObus);
+    ASSERT_THAT(temporal_unit, IsOk());
+    EXPECT_THAT(sequencer.PushTemporalUnit(*temporal_unit), IsOk());
+
+    // Expect copies in every other temporal unit, after the temporal
+    // delimiter.
+    std::vector<uint8_t> expected_serialized_temporal_unit =
+        serialized_temporal_delimiter;
+    if (i % kRedundantDescriptorObuInterval == 0 && i > 0) {
+      expected_serialized_temporal_unit.insert(
+          expected_serialized_temporal_unit.end(),
+          redundant_descriptor_obus.begin(), redundant_descriptor_obus.end());
+    }
+    const std::vector<uint8_t> serialized_audio_frame = SerializeObusExpectOk(
+        std::list<const ObuBase*>({&audio_frames.front().obu}));
+    expected_serialized_temporal_unit.insert(
+        expected_serialized_temporal_unit.end(), serialized_audio_frame.begin(),
+        serialized_audio_frame.end());
+    EXPECT_EQ(sequencer.GetPreviousSerializedTemporalUnit(),
+              expected_serialized_temporal_unit);
+  }
+}
+
 TEST(GetPreviousSerializedTemporalUnit, GetsPreviousSerializedTemporalUnit) {
   IASequenceHeaderObu ia_sequence_header_obu(ObuHeader(),
                                              ProfileVersion::kIamfSimpleProfile,
@@ -189,6 +280,45 @@ TEST(GetPreviousSerializedTemporalUnit, GetsPreviousSerializedTemporalUnit) {
             expected_serialized_temporal_unit);
 }
 
+TEST(TakePreviousSerializedTemporalUnit,
+     MovesOutPreviousSerializedTemporalUnit) {
+  IASequenceHeaderObu ia_sequence_header_obu(ObuHeader(),
+                                             ProfileVersion::kIamfSimpleProfile,
+                                             ProfileVersion::kIamfBaseProfile);
+  absl::flat_hash_map<DecodedUleb128, CodecConfigObu> codec_config_obus;
+  absl::flat_hash_map<DecodedUleb128, AudioElementWithData> audio_elements;
+  AddLpcmCodecConfig(kCodecConfigId, kEightSamplesPerFrame, kBitDepth,
+                     kSampleRate, codec_config_obus);
+  AddAmbisonicsMonoAudioElementWithSubstreamIds(
+      kFirstAudioElementId, kCodecConfigId, {kFirstSubstreamId},
+      codec_config_obus, audio_elements);
+  ObuSequencerStreamingIamf sequencer(kDoNotIncludeTemporalDelimiters,
+                                      *LebGenerator::Create());
+  EXPECT_THAT(
+      sequencer.PushDescriptorObus(ia_sequence_header_obu, /*metadata_obus=*/{},
+                                   codec_config_obus, audio_elements,
+                                   /*mix_presentation_obus=*/{},
+                                   /*arbitrary_obus=*/{}),
+      IsOk());
+  std::list<AudioFrameWithData> audio_frames;
+  AddOneFrame(kFirstAudioElementId, kFirstSubstreamId, kStartTimestamp,
+              kEndTimestamp, audio_elements, audio_frames);
+  const auto temporal_unit = TemporalUnitView::Create(
+      kNoParameterBlocks, audio_frames, kNoArbitraryObus);
+  ASSERT_THAT(temporal_unit, IsOk());
+  EXPECT_THAT(sequencer.PushTemporalUnit(*temporal_unit), IsOk());
+  const std::vector<uint8_t> expected_serialized_temporal_unit =
+      SerializeObusExpectOk(
+          std::list<const ObuBase*>({&audio_frames.front().obu}));
+  // Stale data in the output is replaced.
+  std::vector<uint8_t> serialized_temporal_unit = {1, 2, 3};
+
+  sequencer.TakePreviousSerializedTemporalUnit(serialized_temporal_unit);
+
+  EXPECT_EQ(serialized_temporal_unit, expected_serialized_temporal_unit);
+  EXPECT_THAT(sequencer.GetPreviousSerializedTemporalUnit(), IsEmpty());
+}
+
 TEST(Close, ClearsSerializedTemporalUnitObus) {
   IASequenceHeaderObu ia_sequence_header_obu(ObuHeader(),
                                              ProfileVersion::kIamfSimpleProfile,
@@ -250,6 +380,7 @@ TEST(Abort, ClearsSerializedDescriptorAndTemporalUnitObus) {
   sequencer.Abort();
 
   EXPECT_THAT(sequencer.GetSerializedDescriptorObus(), IsEmpty());
+  EXPECT_THAT(sequencer.GetSerializedRedundantDescriptorObus(), IsEmpty());
   EXPECT_THAT(sequencer.GetPreviousSerializedTemporalUnit(), IsEmpty());
 }
 }  // namespace
@@ -12,16 +12,24 @@
 #include "iamf/cli/renderer_factory.h"
 
 #include <cstddef>
+#include <cstdint>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "gtest/gtest.h"
+#include "iamf/cli/audio_element_with_data.h"
 #include "iamf/cli/channel_label.h"
 #include "iamf/cli/proto/obu_header.pb.h"
 #include "iamf/cli/proto/parameter_data.pb.h"
 #include "iamf/cli/proto/temporal_delimiter.pb.h"
 #include "iamf/cli/proto/user_metadata.pb.h"
+#include "iamf/cli/tests/cli_test_utils.h"
+#include "iamf/cli/user_metadata_builder/iamf_input_layout.h"
 #include "iamf/obu/audio_element.h"
+#include "iamf/obu/codec_config.h"
 #include "iamf/obu/mix_presentation.h"
 #include "iamf/obu/rendering_config.h"
+#include "iamf/obu/types.h"
 
 namespace iamf_tools {
 namespace {
@@ -214,5 +222,84 @@ TEST(CreateRendererForLayout,
 }
 #endif
 
+constexpr uint32_t kCodecConfigId = 0;
+constexpr DecodedUleb128 kStereoAudioElementId = 100;
+constexpr DecodedUleb128 kAmbisonicsAudioElementId = 200;
+
+class CreateSubMixRendererForLayoutTest : public ::testing::Test {
+ public:
+  CreateSubMixRendererForLayoutTest() {
+    AddLpcmCodecConfigWithIdAndSampleRate(kCodecConfigId, kSampleRate,
+                                          codec_configs_);
+    AddScalableAudioElementWithSubstreamIds(
+        IamfInputLayout::kStereo, kStereoAudioElementId, kCodecConfigId, {0},
+        codec_configs_, audio_elements_);
+    AddAmbisonicsMonoAudioElementWithSubstreamIds(
+        kAmbisonicsAudioElementId, kCodecConfigId, {10, 11, 12, 13},
+        codec_configs_, audio_elements_);
+  }
+
+ protected:
+  std::vector<SubMixAudioElement> GetSubMixAudioElements(
+      const RenderingConfig& rendering_config) const {
+    return {{.audio_element_id = kStereoAudioElementId,
+             .rendering_config = rendering_config},
+            {.audio_element_id = kAmbisonicsAudioElementId,
+             .rendering_config = rendering_config}};
+  }
+
+  absl::flat_hash_map<uint32_t, CodecConfigObu> codec_configs_;
+  absl::flat_hash_map<DecodedUleb128, AudioElementWithData> audio_elements_;
+};
+
+TEST_F(CreateSubMixRendererForLayoutTest,
+       ReturnsNullPtrForStereoHeadphonesRenderingMode) {
+  const RendererFactory factory;
+
+  EXPECT_EQ(factory.CreateSubMixRendererForLayout(
+                {&audio_elements_.at(kStereoAudioElementId),
+                 &audio_elements_.at(kAmbisonicsAudioElementId)},
+                GetSubMixAudioElements(kHeadphonesAsStereoRenderingConfig),
+                kBinauralLayout, kNumSamplesPerFrame, kSampleRate),
+            nullptr);
+}
+
+TEST_F(CreateSubMixRendererForLayoutTest, ReturnsNullPtrForLoudspeakerLayout) {
+  const RendererFactory factory;
+
+  EXPECT_EQ(factory.CreateSubMixRendererForLayout(
+                {&audio_elements_.at(kStereoAudioElementId),
+                 &audio_elements_.at(kAmbisonicsAudioElementId)},
+                GetSubMixAudioElements(kHeadphonesAsBinauralRenderingConfig),
+                kMonoLayout, kNumSamplesPerFrame, kSampleRate),
+            nullptr);
+}
+
+TEST_F(CreateSubMixRendererForLayoutTest, ReturnsNullPtrForOneAudioElement) {
+  const RendererFactory factory;
+  const auto sub_mix_audio_elements =
+      GetSubMixAudioElements(kHeadphonesAsBinauralRenderingConfig);
+
+  EXPECT_EQ(factory.CreateSubMixRendererForLayout(
+                {&audio_elements_.at(kStereoAudioElementId)},
+                {sub_mix_audio_elements.front()}, kBinauralLayout,
+                kNumSamplesPerFrame, kSampleRate),
+            nullptr);
+}
+
+#ifndef IAMF_TOOLS_DISABLE_BINAURAL_RENDERING
+TEST_F(CreateSubMixRendererForLayoutTest,
+       SupportsSharedBinauralRendererForSeveralAudioElements) {
+  const RendererFactory factory;
+
+  EXPECT_NE(factory.CreateSubMixRendererForLayout(
+                {&audio_elements_.at(kStereoAudioElementId),
+                 &audio_elements_.at(kAmbisonicsAudioElementId)},
+                GetSubMixAudioElements(kHeadphonesAsBinauralRenderingConfig),
+                kBinauralLayout, kNumSamplesPerFrame, kSampleRate),
+            nullptr);
+}
+#endif
+
 }  // namespace
 }  // namespace iamf_tools
@@ -47,9 +47,14 @@
 #include "iamf/cli/user_metadata_builder/iamf_input_layout.h"
 #include "iamf/cli/wav_reader.h"
 #include "iamf/cli/wav_writer.h"
+#include "iamf/common/q_format_or_floating_point.h"
 #include "iamf/obu/audio_element.h"
 #include "iamf/obu/codec_config.h"
+#include "iamf/obu/mix_gain_parameter_data.h"
 #include "iamf/obu/mix_presentation.h"
+#include "iamf/obu/obu_header.h"
+#include "iamf/obu/param_definitions/mix_gain_param_definition.h"
+#include "iamf/obu/parameter_block.h"
 #include "iamf/obu/types.h"
 #include "src/google/protobuf/repeated_ptr_field.h"
 
@@ -60,6 +65,9 @@ using ::absl_testing::IsOk;
 using ::absl_testing::IsOkAndHolds;
 using ::absl_testing::StatusIs;
 using ::testing::_;
+using ::testing::DoubleNear;
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
 using ::testing::Eq;
 using ::testing::IsEmpty;
 using ::testing::Not;
@@ -809,6 +817,45 @@ TEST_F(FinalizerTest, DelegatestoLoudnessCalculator) {
             kArbitraryLoudnessInfo);
 }
 
+TEST_F(FinalizerTest, DelegatesToTheLoudnessCalculatorOfEachLayout) {
+  const std::vector<std::vector<InternalSampleType>>
+      kExpectedPassthroughSamples = {{0.0, 1.0}};
+  InitPrerequisiteObusForMonoInput(kAudioElementId);
+  AddMixPresentationObuForMonoOutput(kMixPresentationId);
+  AddMixPresentationObuForMonoOutput(kMixPresentationId + 1);
+  const LabelSamplesMap kLabelToSamples = {{kMono, {0, 1}}};
+  AddLabeledFrame(kAudioElementId, kLabelToSamples);
+
+  // Every layout has its own calculator, which sees the rendered samples once
+  // per temporal unit, even though they are measured in parallel.
+  auto mock_loudness_calculator_factory =
+      std::make_unique<MockLoudnessCalculatorFactory>();
+  for (int i = 0; i < 2; ++i) {
+    auto mock_loudness_calculator = std::make_unique<MockLoudnessCalculator>();
+    EXPECT_CALL(*mock_loudness_calculator,
+                AccumulateLoudnessForSamples(
+                    MakeSpanOfConstSpans(kExpectedPassthroughSamples)))
+        .WillOnce(Return(absl::OkStatus()));
+    ON_CALL(*mock_loudness_calculator, QueryLoudness())
+        .WillByDefault(Return(kArbitraryLoudnessInfo));
+    EXPECT_CALL(*mock_loudness_calculator_factory,
+                CreateLoudnessCalculator(_, _, _))
+        .WillOnce(Return(std::move(mock_loudness_calculator)))
+        .RetiresOnSaturation();
+  }
+  renderer_factory_ = std::make_unique<RendererFactory>();
+  loudness_calculator_factory_ = std::move(mock_loudness_calculator_factory);
+  auto finalizer = CreateFinalizerExpectOk();
+
+  IterativeRenderingExpectOk(finalizer, parameter_blocks_);
+
+  ASSERT_EQ(finalized_obus_.size(), 2);
+  for (const auto& finalized_obu : finalized_obus_) {
+    EXPECT_EQ(finalized_obu.sub_mixes_[0].layouts[0].loudness,
+              kArbitraryLoudnessInfo);
+  }
+}
+
 TEST_F(FinalizerTest, ValidatesUserLoudnessWhenRequested) {
   const LoudnessInfo kMockCalculatedLoudness = kArbitraryLoudnessInfo;
   const LoudnessInfo kMismatchingUserLoudness = kExpectedMinimumLoudnessInfo;
@@ -1253,6 +1300,166 @@ TEST_F(FinalizerTest,
               IsOkAndHolds(MakeSpanOfConstSpans(kExpectedSamples)));
 }
 
+TEST_F(FinalizerTest, PassThroughRenderedSamplesAreViewsIntoTheLabeledFrame) {
+  InitPrerequisiteObusForStereoInput(kAudioElementId);
+  AddMixPresentationObuForStereoOutput(kMixPresentationId);
+  const LabelSamplesMap kLabelToSamples = {{kL2, {0.0, 0.1}},
+                                           {kR2, {0.2, 0.3}}};
+  AddLabeledFrame(kAudioElementId, kLabelToSamples);
+  renderer_factory_ = std::make_unique<RendererFactory>();
+  sample_processor_factory_ =
+      RenderingMixPresentationFinalizer::ProduceNoSampleProcessors;
+  auto finalizer = CreateFinalizerExpectOk();
+
+  EXPECT_THAT(finalizer.PushTemporalUnit(ordered_labeled_frames_[0], kStartTime,
+                                         kEndTime, parameter_blocks_),
+              IsOk());
+
+  // A single audio element with unity mix gains passes through without being
+  // copied.
+  const auto rendered_samples = finalizer.GetPostProcessedSamplesAsSpan(
+      kMixPresentationId, kFirstSubmixIndex, kFirstLayoutIndex);
+  ASSERT_THAT(rendered_samples, IsOk());
+  ASSERT_EQ(rendered_samples->size(), 2);
+  const auto& label_to_samples =
+      ordered_labeled_frames_[0].at(kAudioElementId).label_to_samples;
+  EXPECT_EQ((*rendered_samples)[0].data(), label_to_samples.at(kL2).data());
+  EXPECT_EQ((*rendered_samples)[1].data(), label_to_samples.at(kR2).data());
+}
+
+TEST_F(FinalizerTest, PassThroughAppliesNonUnityMixGains) {
+  InitPrerequisiteObusForStereoInput(kAudioElementId);
+  AddMixPresentationObuForStereoOutput(kMixPresentationId);
+  // -20 dB.
+  obus_to_finalize_.back().sub_mixes_[0].output_mix_gain.default_mix_gain_ =
+      QFormatOrFloatingPoint::MakeFromQ7_8(-20 * 256);
+  const LabelSamplesMap kLabelToSamples = {{kL2, {0.0, 0.1}},
+                                           {kR2, {0.2, 0.3}}};
+  AddLabeledFrame(kAudioElementId, kLabelToSamples);
+  renderer_factory_ = std::make_unique<RendererFactory>();
+  sample_processor_factory_ =
+      RenderingMixPresentationFinalizer::ProduceNoSampleProcessors;
+  auto finalizer = CreateFinalizerExpectOk();
+
+  EXPECT_THAT(finalizer.PushTemporalUnit(ordered_labeled_frames_[0], kStartTime,
+                                         kEndTime, parameter_blocks_),
+              IsOk());
+
+  const auto rendered_samples = finalizer.GetPostProcessedSamplesAsSpan(
+      kMixPresentationId, kFirstSubmixIndex, kFirstLayoutIndex);
+  ASSERT_THAT(rendered_samples, IsOk());
+  ASSERT_EQ(rendered_samples->size(), 2);
+  EXPECT_THAT((*rendered_samples)[0],
+              ElementsAre(DoubleNear(0.0, 1e-6), DoubleNear(0.01, 1e-6)));
+  EXPECT_THAT((*rendered_samples)[1],
+              ElementsAre(DoubleNear(0.02, 1e-6), DoubleNear(0.03, 1e-6)));
+  // The labeled frame is not modified.
+  EXPECT_THAT(
+      ordered_labeled_frames_[0].at(kAudioElementId).label_to_samples.at(kL2),
+      ElementsAre(0.0, 0.1));
+}
+
+TEST_F(FinalizerTest, EvaluatesMixGainsWithADifferentParameterRate) {
+  InitPrerequisiteObusForStereoInput(kAudioElementId);
+  AddMixPresentationObuForStereoOutput(kMixPresentationId);
+  // One tick of the parameter spans two ticks of the audio.
+  auto& output_mix_gain =
+      obus_to_finalize_.back().sub_mixes_[0].output_mix_gain;
+  output_mix_gain.parameter_rate_ = kSampleRate / 2;
+  output_mix_gain.param_definition_mode_ = 1;
+  const MixGainParamDefinition param_definition = output_mix_gain;
+  const LabelSamplesMap kLabelToSamples = {{kL2, {0.1, 0.2}},
+                                           {kR2, {0.3, 0.4}}};
+  AddLabeledFrame(kAudioElementId, kLabelToSamples);
+  renderer_factory_ = std::make_unique<RendererFactory>();
+  sample_processor_factory_ =
+      RenderingMixPresentationFinalizer::ProduceNoSampleProcessors;
+  auto finalizer = CreateFinalizerExpectOk();
+
+  // Ramp from 0 dB to -20 dB over the parameter block, which lasts as long as
+  // the temporal unit.
+  constexpr DecodedUleb128 kParameterBlockDuration =
+      (kEndTime - kStartTime) / 2;
+  auto parameter_block = ParameterBlockObu::CreateMode1(
+      ObuHeader(), param_definition, kParameterBlockDuration,
+      /*constant_subblock_duration=*/kParameterBlockDuration,
+      /*num_subblocks=*/1);
+  ASSERT_NE(parameter_block, nullptr);
+  parameter_block->subblocks_[0].param_data =
+      std::make_unique<MixGainParameterData>(
+          MixGainParameterData::kAnimateLinear,
+          AnimationLinearInt16{.start_point_value = 0,
+                               .end_point_value = -20 * 256});
+  parameter_blocks_.push_back(ParameterBlockWithData{
+      .obu = std::move(parameter_block),
+      .start_timestamp = kStartTime,
+      .end_timestamp = kEndTime});
+
+  EXPECT_THAT(finalizer.PushTemporalUnit(ordered_labeled_frames_[0], kStartTime,
+                                         kEndTime, parameter_blocks_),
+              IsOk());
+
+  // The second audio tick is halfway through the first parameter tick, at
+  // -2 dB. The element and output mix gains share the parameter block, so it
+  // is applied twice.
+  constexpr double kGainAtSecondTick = 0.79432823 * 0.79432823;
+  const auto rendered_samples = finalizer.GetPostProcessedSamplesAsSpan(
+      kMixPresentationId, kFirstSubmixIndex, kFirstLayoutIndex);
+  ASSERT_THAT(rendered_samples, IsOk());
+  ASSERT_EQ(rendered_samples->size(), 2);
+  EXPECT_THAT((*rendered_samples)[0],
+              ElementsAre(DoubleNear(0.1, 1e-6),
+                          DoubleNear(0.2 * kGainAtSecondTick, 1e-6)));
+  EXPECT_THAT((*rendered_samples)[1],
+              ElementsAre(DoubleNear(0.3, 1e-6),
+                          DoubleNear(0.4 * kGainAtSecondTick, 1e-6)));
+}
+
+TEST_F(FinalizerTest, AsynchronousRenderersMatchSynchronousRenderers) {
+  // Down-mixing stereo to mono needs a renderer which is not pass-through.
+  InitPrerequisiteObusForStereoInput(kAudioElementId);
+  AddMixPresentationObuForMonoOutput(kMixPresentationId);
+  AddMixPresentationObuForMonoOutput(kMixPresentationId + 1);
+  const LabelSamplesMap kLabelToSamples = {{kL2, {0.1, 0.2}},
+                                           {kR2, {0.3, 0.4}}};
+  AddLabeledFrame(kAudioElementId, kLabelToSamples);
+  sample_processor_factory_ =
+      RenderingMixPresentationFinalizer::ProduceNoSampleProcessors;
+  renderer_factory_ = std::make_unique<RendererFactory>();
+  auto synchronous_finalizer = CreateFinalizerExpectOk();
+  renderer_factory_ =
+      std::make_unique<RendererFactory>(/*render_asynchronously=*/true);
+  auto asynchronous_finalizer = CreateFinalizerExpectOk();
+
+  // The frames of both mix presentations are submitted before either is
+  // flushed.
+  EXPECT_THAT(synchronous_finalizer.PushTemporalUnit(
+                  ordered_labeled_frames_[0], kStartTime, kEndTime,
+                  parameter_blocks_),
+              IsOk());
+  EXPECT_THAT(asynchronous_finalizer.PushTemporalUnit(
+                  ordered_labeled_frames_[0], kStartTime, kEndTime,
+                  parameter_blocks_),
+              IsOk());
+
+  for (const auto mix_presentation_id :
+       {kMixPresentationId, kMixPresentationId + 1}) {
+    const auto expected_samples =
+        synchronous_finalizer.GetPostProcessedSamplesAsSpan(
+            mix_presentation_id, kFirstSubmixIndex, kFirstLayoutIndex);
+    ASSERT_THAT(expected_samples, IsOk());
+    ASSERT_EQ(expected_samples->size(), 1);
+    EXPECT_EQ(expected_samples->front().size(), 2);
+    const auto rendered_samples =
+        asynchronous_finalizer.GetPostProcessedSamplesAsSpan(
+            mix_presentation_id, kFirstSubmixIndex, kFirstLayoutIndex);
+    ASSERT_THAT(rendered_samples, IsOk());
+    ASSERT_EQ(rendered_samples->size(), 1);
+    EXPECT_THAT(rendered_samples->front(),
+                ElementsAreArray(expected_samples->front()));
+  }
+}
+
 TEST_F(FinalizerTest,
        DelayedSamplesAreAvailableAfterFinalizePushingTemporalUnits) {
   InitPrerequisiteObusForMonoInput(kAudioElementId);
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/random/random.h"
+#include "absl/types/span.h"
+#include "benchmark/benchmark.h"
+#include "iamf/cli/true_peak_limiter.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+namespace {
+
+constexpr uint32_t kSampleRate = 48000;
+
+static void BM_PushFrame(benchmark::State& state) {
+  const int num_channels = state.range(0);
+  const int num_ticks = state.range(1);
+
+  // Use loud noise, so the limiter is always active.
+  absl::BitGen gen;
+  std::vector<std::vector<InternalSampleType>> frame(
+      num_channels, std::vector<InternalSampleType>(num_ticks));
+  for (auto& channel : frame) {
+    for (auto& sample : channel) {
+      sample = absl::Uniform<double>(gen, -2.0, 2.0);
+    }
+  }
+  const std::vector<absl::Span<const InternalSampleType>> frame_spans(
+      frame.begin(), frame.end());
+  auto limiter = TruePeakLimiter::Create(num_ticks, num_channels, kSampleRate,
+                                         TruePeakLimiter::Settings());
+  ABSL_CHECK_NE(limiter, nullptr);
+
+  for (auto _ : state) {
+    ABSL_CHECK_OK(limiter->PushFrame(frame_spans));
+    benchmark::DoNotOptimize(limiter->GetOutputSamplesAsSpan());
+  }
+  state.SetItemsProcessed(state.iterations() * num_channels * num_ticks);
+}
+
+// Benchmark various combinations of (#channels, #ticks), e.g. stereo, 7.1.4,
+// and 9.1.6 output.
+BENCHMARK(BM_PushFrame)
+    ->Args({2, 960})
+    ->Args({12, 960})
+    ->Args({16, 960})
+    ->Args({16, 4096});
+
+}  // namespace
+}  // namespace iamf_tools
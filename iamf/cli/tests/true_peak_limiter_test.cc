@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/cli/true_peak_limiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/status_matchers.h"
+#include "absl/types/span.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "iamf/cli/sample_processor_base.h"
+#include "iamf/cli/tests/cli_test_utils.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+namespace {
+
+using ::absl_testing::IsOk;
+using ::testing::_;
+using ::testing::DoubleEq;
+using ::testing::DoubleNear;
+using ::testing::IsNull;
+using ::testing::NotNull;
+using ::testing::Pointwise;
+
+constexpr uint32_t kSampleRate = 48000;
+constexpr size_t kNumSamplesPerFrame = 960;
+constexpr size_t kNumFrames = 10;
+constexpr double kThreshold = 0.89125093813374556;  // -1 dBTP.
+
+const TruePeakLimiter::Settings kDefaultSettings;
+
+// Pushes all samples through the limiter in frames, then flushes it.
+std::vector<std::vector<InternalSampleType>> LimitInFrames(
+    TruePeakLimiter& limiter,
+    const std::vector<std::vector<InternalSampleType>>& input,
+    size_t num_samples_per_frame) {
+  std::vector<std::vector<InternalSampleType>> output(input.size());
+  const auto append_output = [&]() {
+    const auto output_samples = limiter.GetOutputSamplesAsSpan();
+    for (size_t c = 0; c < output.size(); ++c) {
+      output[c].insert(output[c].end(), output_samples[c].begin(),
+                       output_samples[c].end());
+    }
+  };
+
+  const size_t num_ticks = input.front().size();
+  for (size_t start = 0; start < num_ticks; start += num_samples_per_frame) {
+    const size_t end = std::min(num_ticks, start + num_samples_per_frame);
+    std::vector<std::vector<InternalSampleType>> frame;
+    for (const auto& channel : input) {
+      frame.emplace_back(channel.begin() + start, channel.begin() + end);
+    }
+    EXPECT_THAT(limiter.PushFrame(MakeSpanOfConstSpans(frame)), IsOk());
+    append_output();
+  }
+  EXPECT_THAT(limiter.Flush(), IsOk());
+  append_output();
+  return output;
+}
+
+double GetMaxAbsoluteValue(absl::Span<const InternalSampleType> samples) {
+  double max_abs = 0.0;
+  for (const auto sample : samples) {
+    max_abs = std::max(max_abs, std::abs(sample));
+  }
+  return max_abs;
+}
+
+TEST(Create, ReturnsNonNullForValidArguments) {
+  EXPECT_THAT(TruePeakLimiter::Create(kNumSamplesPerFrame, 2, kSampleRate,
+                                      kDefaultSettings),
+              NotNull());
+}
+
+TEST(Create, ReturnsNullForZeroChannels) {
+  EXPECT_THAT(TruePeakLimiter::Create(kNumSamplesPerFrame, 0, kSampleRate,
+                                      kDefaultSettings),
+              IsNull());
+}
+
+TEST(Create, ReturnsNullForZeroSampleRate) {
+  EXPECT_THAT(
+      TruePeakLimiter::Create(kNumSamplesPerFrame, 2, 0, kDefaultSettings),
+      IsNull());
+}
+
+TEST(Create, ReturnsNullForNonPositiveReleaseTime) {
+  EXPECT_THAT(TruePeakLimiter::Create(kNumSamplesPerFrame, 2, kSampleRate,
+                                      {.release_ms = 0.0}),
+              IsNull());
+}
+
+TEST(GetLatency, IncludesTheLookaheadAndTheOversamplingFilter) {
+  const auto limiter = TruePeakLimiter::Create(
+      kNumSamplesPerFrame, 2, kSampleRate, {.lookahead_ms = 1.0});
+  ASSERT_THAT(limiter, NotNull());
+
+  // 1 ms is 48 ticks. The filter needs half of its taps after each tick.
+  EXPECT_EQ(limiter->GetLatency(), 47 + TruePeakLimiter::kTapsPerPhase / 2);
+}
+
+TEST(GetLatency, IsReportedThroughTheBaseClass) {
+  const auto limiter = TruePeakLimiter::Create(kNumSamplesPerFrame, 2,
+                                               kSampleRate, kDefaultSettings);
+  ASSERT_THAT(limiter, NotNull());
+  const SampleProcessorBase& sample_processor = *limiter;
+
+  EXPECT_GT(sample_processor.GetLatency(), 0);
+  EXPECT_EQ(sample_processor.GetLatency(), limiter->GetLatency());
+}
+
+TEST(TruePeakLimiter, DelaysQuietSignalsWithoutChangingThem) {
+  const auto limiter = TruePeakLimiter::Create(kNumSamplesPerFrame, 2,
+                                               kSampleRate, kDefaultSettings);
+  ASSERT_THAT(limiter, NotNull());
+  const std::vector<std::vector<InternalSampleType>> input = {
+      GenerateSineWav(0, kNumFrames * kNumSamplesPerFrame, kSampleRate, 440.0,
+                      0.5),
+      GenerateSineWav(0, kNumFrames * kNumSamplesPerFrame, kSampleRate, 880.0,
+                      0.25)};
+
+  const auto output = LimitInFrames(*limiter, input, kNumSamplesPerFrame);
+
+  ASSERT_EQ(output.size(), 2);
+  EXPECT_THAT(output[0], Pointwise(DoubleNear(1e-12), input[0]));
+  EXPECT_THAT(output[1], Pointwise(DoubleNear(1e-12), input[1]));
+}
+
+TEST(TruePeakLimiter, OutputsFewerSamplesUntilTheLookaheadIsFilled) {
+  const auto limiter = TruePeakLimiter::Create(kNumSamplesPerFrame, 1,
+                                               kSampleRate, kDefaultSettings);
+  ASSERT_THAT(limiter, NotNull());
+  const std::vector<std::vector<InternalSampleType>> frame = {
+      std::vector<InternalSampleType>(kNumSamplesPerFrame, 0.1)};
+
+  EXPECT_THAT(limiter->PushFrame(MakeSpanOfConstSpans(frame)), IsOk());
+  EXPECT_EQ(limiter->GetOutputSamplesAsSpan()[0].size(),
+            kNumSamplesPerFrame - limiter->GetLatency());
+  EXPECT_THAT(limiter->PushFrame(MakeSpanOfConstSpans(frame)), IsOk());
+  EXPECT_EQ(limiter->GetOutputSamplesAsSpan()[0].size(), kNumSamplesPerFrame);
+
+  EXPECT_THAT(limiter->Flush(), IsOk());
+  EXPECT_EQ(limiter->GetOutputSamplesAsSpan()[0].size(),
+            limiter->GetLatency());
+}
+
+TEST(TruePeakLimiter, OutputsAllSamplesForFramesShorterThanTheLatency) {
+  const auto limiter = TruePeakLimiter::Create(kNumSamplesPerFrame, 2,
+                                               kSampleRate, kDefaultSettings);
+  ASSERT_THAT(limiter, NotNull());
+  const std::vector<std::vector<InternalSampleType>> input = {
+      GenerateSineWav(0, 1000, kSampleRate, 440.0, 0.5),
+      GenerateSineWav(0, 1000, kSampleRate, 440.0, 0.5)};
+
+  const auto output = LimitInFrames(*limiter, input, 7);
+
+  ASSERT_EQ(output.size(), 2);
+  EXPECT_THAT(output[0], Pointwise(DoubleNear(1e-12), input[0]));
+  EXPECT_THAT(output[1], Pointwise(DoubleNear(1e-12), input[1]));
+}
+
+TEST(TruePeakLimiter, KeepsSamplesBelowTheThreshold) {
+  const auto limiter = TruePeakLimiter::Create(kNumSamplesPerFrame, 1,
+                                               kSampleRate, kDefaultSettings);
+  ASSERT_THAT(limiter, NotNull());
+  const std::vector<std::vector<InternalSampleType>> input = {GenerateSineWav(
+      0, kNumFrames * kNumSamplesPerFrame, kSampleRate, 1000.0, 2.0)};
+
+  const auto output = LimitInFrames(*limiter, input, kNumSamplesPerFrame);
+
+  ASSERT_EQ(output[0].size(), input[0].size());
+  EXPECT_LE(GetMaxAbsoluteValue(output[0]), kThreshold + 1e-9);
+  // The limiter only attenuates as much as needed.
+  EXPECT_GT(GetMaxAbsoluteValue(output[0]), 0.9 * kThreshold);
+}
+
+TEST(TruePeakLimiter, LimitsPeaksBetweenSamples) {
+  const auto limiter = TruePeakLimiter::Create(kNumSamplesPerFrame, 1,
+                                               kSampleRate, kDefaultSettings);
+  ASSERT_THAT(limiter, NotNull());
+  // A sine at a quarter of the sample rate, with a phase so that every sample
+  // is at 1 / sqrt(2) of the true peak.
+  std::vector<std::vector<InternalSampleType>> input(1);
+  for (size_t t = 0; t < kNumFrames * kNumSamplesPerFrame; ++t) {
+    input[0].push_back(std::sin(std::numbers::pi * (0.5 * t + 0.25)));
+  }
+  ASSERT_LT(GetMaxAbsoluteValue(input[0]), kThreshold);
+
+  const auto output = LimitInFrames(*limiter, input, kNumSamplesPerFrame);
+
+  // The true peak of the output is limited, so the samples are at most
+  // `kThreshold / sqrt(2)`, allowing for the ripple of the short filter.
+  EXPECT_LE(GetMaxAbsoluteValue(output[0]),
+            1.01 * kThreshold / std::numbers::sqrt2);
+}
+
+TEST(TruePeakLimiter, AppliesTheSameGainToAllChannels) {
+  const auto limiter = TruePeakLimiter::Create(kNumSamplesPerFrame, 2,
+                                               kSampleRate, kDefaultSettings);
+  ASSERT_THAT(limiter, NotNull());
+  const std::vector<std::vector<InternalSampleType>> input = {
+      GenerateSineWav(0, kNumFrames * kNumSamplesPerFrame, kSampleRate, 1000.0,
+                      2.0),
+      std::vector<InternalSampleType>(kNumFrames * kNumSamplesPerFrame, 0.1)};
+
+  const auto output = LimitInFrames(*limiter, input, kNumSamplesPerFrame);
+
+  // The quiet channel follows the gain of the loud channel.
+  ASSERT_EQ(output[1].size(), input[1].size());
+  EXPECT_LT(GetMaxAbsoluteValue(
+                absl::MakeConstSpan(output[1]).subspan(kNumSamplesPerFrame)),
+            0.1 * kThreshold / 2.0 + 1e-3);
+  for (size_t t = 0; t < output[0].size(); ++t) {
+    if (std::abs(input[0][t]) > 1e-3) {
+      EXPECT_NEAR(output[0][t] / input[0][t], output[1][t] / input[1][t],
+                  1e-9);
+    }
+  }
+}
+
+TEST(TruePeakLimiter, RecoversAfterThePeak) {
+  const auto limiter =
+      TruePeakLimiter::Create(kNumSamplesPerFrame, 1, kSampleRate,
+                              {.lookahead_ms = 1.0, .release_ms = 5.0});
+  ASSERT_THAT(limiter, NotNull());
+  // A single loud click in a quiet signal.
+  std::vector<std::vector<InternalSampleType>> input = {
+      std::vector<InternalSampleType>(kNumFrames * kNumSamplesPerFrame, 0.1)};
+  input[0][kNumSamplesPerFrame] = 2.0;
+
+  const auto output = LimitInFrames(*limiter, input, kNumSamplesPerFrame);
+
+  ASSERT_EQ(output[0].size(), input[0].size());
+  EXPECT_LE(output[0][kNumSamplesPerFrame], kThreshold + 1e-9);
+  // Well before the click, and many release time constants after it, the
+  // signal is untouched.
+  EXPECT_NEAR(output[0][kNumSamplesPerFrame / 2], 0.1, 1e-12);
+  EXPECT_NEAR(output[0].back(), 0.1, 1e-6);
+}
+
+TEST(TruePeakLimiter, PushesTheLimitedSamplesToTheDownstreamProcessor) {
+  // Use frames shorter than the latency, so the delayed samples output by
+  // `Flush()` span several frames of the downstream processor.
+  constexpr size_t kShortFrameSize = 16;
+  auto downstream_processor = std::make_unique<MockSampleProcessor>(
+      kShortFrameSize, 1, kShortFrameSize);
+  std::vector<InternalSampleType> downstream_samples;
+  EXPECT_CALL(*downstream_processor, PushFrameDerived(_))
+      .WillRepeatedly(
+          [&](absl::Span<const absl::Span<const InternalSampleType>> samples) {
+            EXPECT_LE(samples[0].size(), kShortFrameSize);
+            downstream_samples.insert(downstream_samples.end(),
+                                      samples[0].begin(), samples[0].end());
+            return absl::OkStatus();
+          });
+  EXPECT_CALL(*downstream_processor, FlushDerived()).Times(1);
+  const auto limiter =
+      TruePeakLimiter::Create(kShortFrameSize, 1, kSampleRate, kDefaultSettings,
+                              std::move(downstream_processor));
+  ASSERT_THAT(limiter, NotNull());
+  ASSERT_GT(limiter->GetLatency(), kShortFrameSize);
+  const std::vector<std::vector<InternalSampleType>> input = {
+      GenerateSineWav(0, 20 * kShortFrameSize, kSampleRate, 1000.0, 2.0)};
+
+  const auto output = LimitInFrames(*limiter, input, kShortFrameSize);
+
+  ASSERT_EQ(output[0].size(), input[0].size());
+  EXPECT_THAT(downstream_samples, Pointwise(DoubleEq(), output[0]));
+}
+
+}  // namespace
+}  // namespace iamf_tools
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/cli/true_peak_limiter.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_log.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "iamf/cli/sample_processor_base.h"
+#include "iamf/common/utils/filter_design_utils.h"
+#include "iamf/common/utils/macros.h"
+#include "iamf/common/utils/mixing_utils.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+
+namespace {
+
+// Shape of the window applied to the interpolation kernel.
+constexpr double kKaiserBeta = 5.0;
+
+}  // namespace
+
+std::unique_ptr<TruePeakLimiter> TruePeakLimiter::Create(
+    size_t num_samples_per_frame, size_t num_channels, uint32_t sample_rate_hz,
+    const Settings& settings,
+    std::unique_ptr<SampleProcessorBase> downstream_processor) {
+  if (num_samples_per_frame == 0 || num_channels == 0 || sample_rate_hz == 0) {
+    ABSL_LOG(ERROR) << "Invalid shape for the limiter: num_samples_per_frame= "
+                    << num_samples_per_frame
+                    << ", num_channels= " << num_channels
+                    << ", sample_rate_hz= " << sample_rate_hz;
+    return nullptr;
+  }
+  if (!std::isfinite(settings.threshold_db) ||
+      !(settings.lookahead_ms >= 0.0) || !(settings.release_ms > 0.0)) {
+    ABSL_LOG(ERROR) << "Invalid settings for the limiter: threshold_db= "
+                    << settings.threshold_db
+                    << ", lookahead_ms= " << settings.lookahead_ms
+                    << ", release_ms= " << settings.release_ms;
+    return nullptr;
+  }
+
+  const double threshold = std::pow(10.0, settings.threshold_db / 20.0);
+  const size_t num_lookahead_ticks = std::max<size_t>(
+      1, std::lround(settings.lookahead_ms * sample_rate_hz / 1000.0));
+  const double release_coefficient =
+      1.0 - std::exp(-1000.0 / (settings.release_ms * sample_rate_hz));
+  return absl::WrapUnique(new TruePeakLimiter(
+      num_samples_per_frame, num_channels, threshold, num_lookahead_ticks,
+      release_coefficient, std::move(downstream_processor)));
+}
+
+TruePeakLimiter::TruePeakLimiter(size_t num_samples_per_frame,
+                                 size_t num_channels, double threshold,
+                                 size_t num_lookahead_ticks,
+                                 double release_coefficient,
+                                 std::unique_ptr<SampleProcessorBase>
+                                     downstream_processor)
+    : SampleProcessorBase(num_samples_per_frame, num_channels,
+                          num_samples_per_frame),
+      threshold_(threshold),
+      num_lookahead_ticks_(num_lookahead_ticks),
+      release_coefficient_(release_coefficient),
+      buffered_samples_(num_channels),
+      next_tick_to_analyze_(std::max(num_lookahead_ticks - 1, kNumPastTaps)),
+      min_queue_ticks_(num_lookahead_ticks),
+      min_queue_gains_(num_lookahead_ticks),
+      recent_envelopes_(num_lookahead_ticks, 1.0),
+      recent_envelope_sum_(static_cast<double>(num_lookahead_ticks)),
+      downstream_processor_(std::move(downstream_processor)) {
+  // Design a windowed sinc to interpolate at each fractional phase. Tap `k`
+  // of each phase is applied to the tick `k - kNumPastTaps` ticks away.
+  const double half_width = static_cast<double>(kNumFutureTaps);
+  constexpr size_t kNumFractionalPhases = kOversamplingFactor - 1;
+  for (size_t phase = 1; phase < kOversamplingFactor; ++phase) {
+    const double fraction = static_cast<double>(phase) / kOversamplingFactor;
+    std::array<double, kTapsPerPhase> taps;
+    double sum = 0.0;
+    for (size_t k = 0; k < kTapsPerPhase; ++k) {
+      const double offset =
+          static_cast<double>(k) - static_cast<double>(kNumPastTaps) - fraction;
+      const double normalized_offset = offset / half_width;
+      taps[k] = Sinc(offset) * KaiserWindow(normalized_offset, kKaiserBeta);
+      sum += taps[k];
+    }
+    // Normalize so that a constant signal is interpolated exactly.
+    for (size_t k = 0; k < kTapsPerPhase; ++k) {
+      interpolation_gains_[k * kNumFractionalPhases + phase - 1] =
+          taps[k] / sum;
+    }
+  }
+
+  // Start with silence in the history, so the first ticks can be analyzed and
+  // delayed like any other.
+  const size_t max_buffered_ticks =
+      next_tick_to_analyze_ + num_samples_per_frame + GetLatency();
+  for (auto& channel : buffered_samples_) {
+    channel.reserve(max_buffered_ticks);
+    channel.assign(next_tick_to_analyze_, 0.0);
+  }
+  interval_peaks_.reserve(max_buffered_ticks);
+  for (auto& phase : interpolated_) {
+    phase.reserve(max_buffered_ticks);
+  }
+  gains_.reserve(max_buffered_ticks);
+}
+
+absl::Status TruePeakLimiter::PushFrameDerived(
+    absl::Span<const absl::Span<const InternalSampleType>>
+        channel_time_samples) {
+  const size_t num_ticks = channel_time_samples.front().size();
+  for (size_t c = 0; c < num_channels_; ++c) {
+    if (channel_time_samples[c].size() != num_ticks) {
+      return absl::InvalidArgumentError(
+          "All channels must have the same number of ticks.");
+    }
+    buffered_samples_[c].insert(buffered_samples_[c].end(),
+                                channel_time_samples[c].begin(),
+                                channel_time_samples[c].end());
+  }
+  num_pushed_ticks_ += num_ticks;
+
+  ProcessBufferedTicks(buffered_samples_.front().size());
+  return PushOutputToDownstreamProcessor();
+}
+
+absl::Status TruePeakLimiter::FlushDerived() {
+  // Pad with silence so the lookahead reaches past the final tick.
+  for (auto& channel : buffered_samples_) {
+    channel.resize(channel.size() + GetLatency(), 0.0);
+  }
+  ProcessBufferedTicks(buffered_samples_.front().size());
+  RETURN_IF_NOT_OK(PushOutputToDownstreamProcessor());
+  return downstream_processor_ != nullptr ? downstream_processor_->Flush()
+                                          : absl::OkStatus();
+}
+
+absl::Status TruePeakLimiter::PushOutputToDownstreamProcessor() {
+  if (downstream_processor_ == nullptr) {
+    return absl::OkStatus();
+  }
+  // The delayed samples output by `Flush()` may exceed one frame, so push them
+  // in chunks the downstream processor accepts.
+  const size_t num_ticks = output_channel_time_samples_.front().size();
+  std::vector<absl::Span<const InternalSampleType>> chunk(num_channels_);
+  for (size_t start = 0; start < num_ticks;
+       start += max_input_samples_per_frame_) {
+    const size_t chunk_size =
+        std::min(max_input_samples_per_frame_, num_ticks - start);
+    for (size_t c = 0; c < num_channels_; ++c) {
+      chunk[c] = absl::MakeConstSpan(output_channel_time_samples_[c])
+                     .subspan(start, chunk_size);
+    }
+    RETURN_IF_NOT_OK(downstream_processor_->PushFrame(chunk));
+  }
+  return absl::OkStatus();
+}
+
+void TruePeakLimiter::ProcessBufferedTicks(size_t num_available_ticks) {
+  if (num_available_ticks < next_tick_to_analyze_ + kNumFutureTaps + 1) {
+    return;
+  }
+  const size_t num_ticks =
+      num_available_ticks - kNumFutureTaps - next_tick_to_analyze_;
+
+  // Find the peak of all channels between each tick and the next. The
+  // oversampling filter is a gain matrix from the input delayed by each tap to
+  // each fractional phase, so it runs on the vectorized mixing kernels.
+  interval_peaks_.assign(num_ticks, 0.0);
+  for (auto& phase : interpolated_) {
+    phase.resize(num_ticks);
+  }
+  const std::vector<absl::Span<double>> interpolated_spans(
+      interpolated_.begin(), interpolated_.end());
+  std::array<absl::Span<const double>, kTapsPerPhase> delayed_samples;
+  for (const auto& channel : buffered_samples_) {
+    const double* samples = channel.data() + next_tick_to_analyze_;
+    for (size_t k = 0; k < kTapsPerPhase; ++k) {
+      delayed_samples[k] =
+          absl::MakeConstSpan(samples - kNumPastTaps + k, num_ticks);
+    }
+    // The shapes are consistent by construction.
+    MixSamplesWithGainMatrix(delayed_samples, interpolation_gains_,
+                             interpolated_spans)
+        .IgnoreError();
+
+    for (size_t i = 0; i < num_ticks; ++i) {
+      interval_peaks_[i] = std::max(interval_peaks_[i], std::abs(samples[i]));
+    }
+    for (const auto& phase : interpolated_) {
+      for (size_t i = 0; i < num_ticks; ++i) {
+        interval_peaks_[i] = std::max(interval_peaks_[i], std::abs(phase[i]));
+      }
+    }
+  }
+
+  gains_.resize(num_ticks);
+  const int64_t first_analyzed_tick = num_analyzed_ticks_;
+  ComputeGains(interval_peaks_, absl::MakeSpan(gains_));
+
+  // Each gain applies to the tick `num_lookahead_ticks_ - 1` ticks before the
+  // analyzed tick. Skip the silence in the history and in the padding.
+  const int64_t delay = static_cast<int64_t>(num_lookahead_ticks_) - 1;
+  const int64_t first_output_tick =
+      std::max(first_analyzed_tick - delay, num_output_ticks_);
+  const int64_t end_output_tick = std::min(
+      first_analyzed_tick + static_cast<int64_t>(num_ticks) - delay,
+      num_pushed_ticks_);
+  if (end_output_tick > first_output_tick) {
+    const size_t num_output_ticks = end_output_tick - first_output_tick;
+    const size_t first_gain = first_output_tick + delay - first_analyzed_tick;
+    const double* gains = gains_.data() + first_gain;
+    const size_t first_sample = next_tick_to_analyze_ + first_gain - delay;
+    for (size_t c = 0; c < num_channels_; ++c) {
+      const double* samples = buffered_samples_[c].data() + first_sample;
+      auto& output = output_channel_time_samples_[c];
+      output.resize(num_output_ticks);
+      for (size_t i = 0; i < num_output_ticks; ++i) {
+        output[i] = samples[i] * gains[i];
+      }
+    }
+    num_output_ticks_ = end_output_tick;
+  }
+
+  // Drop the samples which are no longer needed by the filter or the output.
+  next_tick_to_analyze_ += num_ticks;
+  const size_t num_history_ticks =
+      std::max(num_lookahead_ticks_ - 1, kNumPastTaps);
+  const size_t num_ticks_to_drop = next_tick_to_analyze_ - num_history_ticks;
+  for (auto& channel : buffered_samples_) {
+    channel.erase(channel.begin(), channel.begin() + num_ticks_to_drop);
+  }
+  next_tick_to_analyze_ = num_history_ticks;
+}
+
+void TruePeakLimiter::ComputeGains(absl::Span<const double> peaks,
+                                   absl::Span<double> gains) {
+  const size_t capacity = num_lookahead_ticks_;
+  const double inverse_num_lookahead_ticks = 1.0 / capacity;
+  for (size_t i = 0; i < peaks.size(); ++i) {
+    // Each tick borders the intervals before and after it.
+    const double peak = std::max(previous_interval_peak_, peaks[i]);
+    previous_interval_peak_ = peaks[i];
+    const double required_gain = peak > threshold_ ? threshold_ / peak : 1.0;
+    const int64_t tick = num_analyzed_ticks_++;
+
+    // Hold the minimum required gain over the lookahead window.
+    const auto wrap = [capacity](size_t index) {
+      return index >= capacity ? index - capacity : index;
+    };
+    while (min_queue_size_ > 0 &&
+           min_queue_gains_[wrap(min_queue_front_ + min_queue_size_ - 1)] >=
+               required_gain) {
+      --min_queue_size_;
+    }
+    if (min_queue_size_ > 0 &&
+        min_queue_ticks_[min_queue_front_] <=
+            tick - static_cast<int64_t>(capacity)) {
+      min_queue_front_ = wrap(min_queue_front_ + 1);
+      --min_queue_size_;
+    }
+    const size_t back = wrap(min_queue_front_ + min_queue_size_);
+    min_queue_ticks_[back] = tick;
+    min_queue_gains_[back] = required_gain;
+    ++min_queue_size_;
+    const double held_gain = min_queue_gains_[min_queue_front_];
+
+    // Attack instantly and release exponentially. The moving average over the
+    // lookahead then smooths the attack, and stays below the held gain of
+    // every tick in the window.
+    if (held_gain < envelope_) {
+      envelope_ = held_gain;
+    } else {
+      envelope_ += (held_gain - envelope_) * release_coefficient_;
+    }
+    double& oldest_envelope = recent_envelopes_[recent_envelope_index_];
+    recent_envelope_sum_ += envelope_ - oldest_envelope;
+    oldest_envelope = envelope_;
+    if (++recent_envelope_index_ == capacity) {
+      // Resum periodically, so rounding errors do not accumulate.
+      recent_envelope_index_ = 0;
+      recent_envelope_sum_ = 0.0;
+      for (const double recent_envelope : recent_envelopes_) {
+        recent_envelope_sum_ += recent_envelope;
+      }
+    }
+    gains[i] = recent_envelope_sum_ * inverse_num_lookahead_ticks;
+  }
+}
+
+}  // namespace iamf_tools
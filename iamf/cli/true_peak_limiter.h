@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#ifndef CLI_TRUE_PEAK_LIMITER_H_
+#define CLI_TRUE_PEAK_LIMITER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "iamf/cli/sample_processor_base.h"
+#include "iamf/obu/types.h"
+
+namespace iamf_tools {
+
+/*!\brief Lookahead limiter which keeps true peaks under a threshold.
+ *
+ * Peaks are detected on a 4x oversampled copy of each channel, so peaks which
+ * fall between samples are also limited. A single gain is computed for all
+ * channels, which preserves the spatial image. The gain reaches its target
+ * before each peak arrives, by delaying the output by the lookahead, then
+ * recovers with an exponential release.
+ *
+ * The limiter delays the samples by `GetLatency()` ticks. Fewer samples are
+ * output for the first frames, and the delayed samples are output by
+ * `Flush()`, so the total number of output samples matches the input.
+ */
+class TruePeakLimiter : public SampleProcessorBase {
+ public:
+  /*!\brief Number of taps of each phase of the oversampling filter. */
+  static constexpr size_t kTapsPerPhase = 12;
+
+  /*!\brief Oversampling factor used to detect peaks. */
+  static constexpr size_t kOversamplingFactor = 4;
+
+  struct Settings {
+    // Maximum true-peak level of the output, in dBTP.
+    double threshold_db = -1.0;
+
+    // Time the gain takes to reach its target before a peak, in milliseconds.
+    double lookahead_ms = 1.5;
+
+    // Time constant of the gain recovery after a peak, in milliseconds.
+    double release_ms = 50.0;
+  };
+
+  /*!\brief Factory function to create a `TruePeakLimiter`.
+   *
+   * \param num_samples_per_frame Maximum number of samples per frame.
+   *        Subsequent pushes must use at most this number of samples.
+   * \param num_channels Number of channels.
+   * \param sample_rate_hz Sample rate of the input in Hz.
+   * \param settings Settings of the limiter.
+   * \param downstream_processor Optional processor which receives the limited
+   *        samples, e.g. to write them to a file. It must accept frames of
+   *        `num_samples_per_frame`, and it is flushed with the limiter.
+   * \return Unique pointer to `TruePeakLimiter` on success. `nullptr` if the
+   *         arguments are invalid.
+   */
+  static std::unique_ptr<TruePeakLimiter> Create(
+      size_t num_samples_per_frame, size_t num_channels,
+      uint32_t sample_rate_hz, const Settings& settings,
+      std::unique_ptr<SampleProcessorBase> downstream_processor = nullptr);
+
+  /*!\brief Destructor. */
+  ~TruePeakLimiter() override = default;
+
+  /*!\brief Gets the number of ticks the output is delayed by.
+   *
+   * \return Latency of the limiter in ticks.
+   */
+  size_t GetLatency() const override {
+    return num_lookahead_ticks_ - 1 + kNumFutureTaps;
+  }
+
+ private:
+  // Number of samples after a tick which are needed to interpolate between it
+  // and the next tick.
+  static constexpr size_t kNumFutureTaps = kTapsPerPhase / 2;
+  static constexpr size_t kNumPastTaps = kTapsPerPhase - kNumFutureTaps - 1;
+
+  /*!\brief Private constructor. Used only by the factory function.
+   *
+   * \param num_samples_per_frame Maximum number of samples per frame.
+   * \param num_channels Number of channels.
+   * \param threshold Linear threshold.
+   * \param num_lookahead_ticks Number of ticks of lookahead.
+   * \param release_coefficient Fraction of the distance to the target gain
+   *        which is recovered each tick.
+   * \param downstream_processor Optional processor to push the output to.
+   */
+  TruePeakLimiter(size_t num_samples_per_frame, size_t num_channels,
+                  double threshold, size_t num_lookahead_ticks,
+                  double release_coefficient,
+                  std::unique_ptr<SampleProcessorBase> downstream_processor);
+
+  /*!\brief Pushes a frame of samples to the limiter.
+   *
+   * \param channel_time_samples Samples to push arranged in (channel, time).
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status PushFrameDerived(
+      absl::Span<const absl::Span<const InternalSampleType>>
+          channel_time_samples) override;
+
+  /*!\brief Signals that no more samples will be pushed.
+   *
+   * Outputs the samples which were held back by the lookahead.
+   *
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status FlushDerived() override;
+
+  /*!\brief Analyzes and outputs as many buffered ticks as possible.
+   *
+   * \param num_available_ticks Number of ticks in the buffers which may be
+   *        analyzed, including any padding.
+   */
+  void ProcessBufferedTicks(size_t num_available_ticks);
+
+  /*!\brief Computes the linked gain for each analyzed tick.
+   *
+   * \param peaks Peak of all channels between each tick and the next.
+   * \param gains Output gain to apply `num_lookahead_ticks_ - 1` ticks
+   *        earlier than each peak.
+   */
+  void ComputeGains(absl::Span<const double> peaks, absl::Span<double> gains);
+
+  /*!\brief Pushes the latest output to the downstream processor, if any.
+   *
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status PushOutputToDownstreamProcessor();
+
+  const double threshold_;
+  const size_t num_lookahead_ticks_;
+  const double release_coefficient_;
+
+  // Taps of the fractional phases of the oversampling filter, as a gain matrix
+  // of shape (# taps, # fractional phases). Phase zero reproduces the input,
+  // so it is not stored.
+  std::array<double, kTapsPerPhase * (kOversamplingFactor - 1)>
+      interpolation_gains_;
+
+  // Input samples arranged in (channel, time) axes, starting from the oldest
+  // sample which is still needed by the filter or the output.
+  std::vector<std::vector<InternalSampleType>> buffered_samples_;
+  // Index of the next tick to analyze in `buffered_samples_`.
+  size_t next_tick_to_analyze_;
+  // Total number of ticks pushed, and the number output so far.
+  int64_t num_pushed_ticks_ = 0;
+  int64_t num_output_ticks_ = 0;
+
+  // Peak of the previous interval, since each tick borders two intervals.
+  double previous_interval_peak_ = 0.0;
+  // Sliding minimum of the required gains, as a monotonic queue stored in a
+  // ring buffer of (tick, gain) pairs.
+  std::vector<int64_t> min_queue_ticks_;
+  std::vector<double> min_queue_gains_;
+  size_t min_queue_front_ = 0;
+  size_t min_queue_size_ = 0;
+  int64_t num_analyzed_ticks_ = 0;
+  // Envelope after the release, and a ring buffer of its recent values which
+  // are averaged to smooth the attack.
+  double envelope_ = 1.0;
+  std::vector<double> recent_envelopes_;
+  size_t recent_envelope_index_ = 0;
+  double recent_envelope_sum_;
+
+  std::unique_ptr<SampleProcessorBase> downstream_processor_;
+
+  // Scratch buffers reused between frames.
+  std::vector<double> interval_peaks_;
+  std::array<std::vector<double>, kOversamplingFactor - 1> interpolated_;
+  std::vector<double> gains_;
+};
+
+}  // namespace iamf_tools
+
+#endif  // CLI_TRUE_PEAK_LIMITER_H_
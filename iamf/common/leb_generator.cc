@@ -12,6 +12,7 @@
 
 #include "iamf/common/leb_generator.h"
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <variant>
@@ -53,19 +54,20 @@ struct Leb128 {
  *        smallest possible representation of a LEB128. When false codes the
  *        LEB128 in `coded_size` bytes.
  * \param buffer Buffer to serialize to.
+ * \param num_bytes Number of bytes written to `buffer`.
  * \return `absl::OkStatus()` if successful. `absl::InvalidArgumentError()`
  *         if the initial `coded_size` was invalid. `absl::UnknownError()` if
  *         the `coded_size` was insufficient to encode the value.
  */
-absl::Status Leb128ToUint8Vector(const Leb128& val, bool min_size_encoding,
-                                 std::vector<uint8_t>& buffer) {
+absl::Status Leb128ToUint8Array(const Leb128& val, bool min_size_encoding,
+                                std::array<uint8_t, kMaxLeb128Size>& buffer,
+                                int& num_bytes) {
   // Reject LEB128s with invalid size.
   if (val.coded_size < 1 || kMaxLeb128Size < val.coded_size) {
     return absl::InvalidArgumentError("Invalid `coded_size`");
   }
 
-  buffer.clear();
-  buffer.reserve(val.coded_size);
+  num_bytes = 0;
 
   const bool decoded_is_negative =
       val.is_signed && std::get<DecodedSleb128>(val.decoded_val) < 0;
@@ -78,7 +80,7 @@ absl::Status Leb128ToUint8Vector(const Leb128& val, bool min_size_encoding,
 
   for (int i = 0; i < val.coded_size; i++) {
     // Encode the next 7 bits.
-    buffer.push_back(0x80 | (temp_val & 0x7f));
+    buffer[num_bytes++] = 0x80 | (temp_val & 0x7f);
     temp_val >>= 7;  // Logical shift clears the upper 7 bits.
 
     if (decoded_is_negative) {
@@ -89,7 +91,7 @@ absl::Status Leb128ToUint8Vector(const Leb128& val, bool min_size_encoding,
     // The encoding could end when it is negative and is all 1s (-1) or positive
     // and all 0s.
     uint32_t end_value = 0;
-    if (val.is_signed && (buffer.back() & 0x40))
+    if (val.is_signed && (buffer[num_bytes - 1] & 0x40))
       end_value = static_cast<uint32_t>(-1);
 
     if (temp_val == end_value) {
@@ -104,13 +106,13 @@ absl::Status Leb128ToUint8Vector(const Leb128& val, bool min_size_encoding,
   }
 
   // Clear the final MSB to 0 to signal the end of the encoding.
-  buffer.back() &= 0x7f;
+  buffer[num_bytes - 1] &= 0x7f;
 
   if (!status.ok() && !min_size_encoding) {
     auto error_message = absl::StrCat(
         (val.is_signed ? std::get<DecodedSleb128>(val.decoded_val)
                        : std::get<DecodedUleb128>(val.decoded_val)),
-        " requires at least ", buffer.size(), " bytes. The caller requested it",
+        " requires at least ", num_bytes, " bytes. The caller requested it",
         " have a fixed size of ", val.coded_size);
     status = absl::InvalidArgumentError(error_message);
   }
@@ -118,6 +120,17 @@ absl::Status Leb128ToUint8Vector(const Leb128& val, bool min_size_encoding,
   return status;
 }
 
+// Serializes the LEB128 to a vector. See `Leb128ToUint8Array()`.
+absl::Status Leb128ToUint8Vector(const Leb128& val, bool min_size_encoding,
+                                 std::vector<uint8_t>& buffer) {
+  std::array<uint8_t, kMaxLeb128Size> array_buffer;
+  int num_bytes = 0;
+  const auto status =
+      Leb128ToUint8Array(val, min_size_encoding, array_buffer, num_bytes);
+  buffer.assign(array_buffer.begin(), array_buffer.begin() + num_bytes);
+  return status;
+}
+
 }  // namespace
 
 // A trusted private constructor. The `Create()` functions ensure it is only
@@ -158,6 +171,22 @@ absl::Status LebGenerator::Uleb128ToUint8Vector(
   }
 }
 
+absl::Status LebGenerator::Uleb128ToUint8Array(
+    DecodedUleb128 input, std::array<uint8_t, kMaxLeb128Size>& buffer,
+    int& num_bytes) const {
+  switch (generation_mode_) {
+    case GenerationMode::kMinimum:
+      return Leb128ToUint8Array({input, kMaxLeb128Size, false},
+                                /*min_size_encoding=*/true, buffer, num_bytes);
+    case GenerationMode::kFixedSize:
+      return Leb128ToUint8Array({input, fixed_size_, false},
+                                /*min_size_encoding=*/false, buffer,
+                                num_bytes);
+    default:
+      return absl::UnknownError("Unknown `generation_mode_`.");
+  }
+}
+
 absl::Status LebGenerator::Sleb128ToUint8Vector(
     DecodedSleb128 input, std::vector<uint8_t>& buffer) const {
   switch (generation_mode_) {
@@ -13,6 +13,7 @@
 #ifndef CLI_LEB_GENERATOR_H_
 #define CLI_LEB_GENERATOR_H_
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -60,6 +61,20 @@ class LebGenerator {
   absl::Status Uleb128ToUint8Vector(DecodedUleb128 input,
                                     std::vector<uint8_t>& buffer) const;
 
+  /*!\brief Encodes a `DecodedUleb128` to an array representing a ULEB128.
+   *
+   * Behaves like `Uleb128ToUint8Vector()`, but avoids allocating a buffer.
+   *
+   * \param input Input value.
+   * \param buffer Buffer to serialize to.
+   * \param num_bytes Number of bytes written to `buffer`.
+   * \return `absl::OkStatus()` on success. `absl::InvalidArgumentError()` if
+   *         the generation fails.
+   */
+  absl::Status Uleb128ToUint8Array(DecodedUleb128 input,
+                                   std::array<uint8_t, kMaxLeb128Size>& buffer,
+                                   int& num_bytes) const;
+
   /*!\brief Encodes a `DecodedSleb128` to a vector representing a SLEB128.
    *
    * The behavior of the generator is controlled by `generation_mode_`. When
@@ -11,6 +11,7 @@
  */
 #include "iamf/common/leb_generator.h"
 
+#include <array>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -18,6 +19,7 @@
 
 #include "absl/status/status.h"
 #include "absl/status/status_matchers.h"
+#include "absl/types/span.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "iamf/obu/types.h"
@@ -26,6 +28,7 @@ namespace iamf_tools {
 namespace {
 
 using ::absl_testing::IsOk;
+using ::testing::ElementsAreArray;
 
 class LebGeneratorTest : public testing::Test {
  public:
@@ -42,6 +45,18 @@ class LebGeneratorTest : public testing::Test {
     if (expected_status_code == absl::StatusCode::kOk) {
       EXPECT_EQ(output_buffer, expected_result);
     }
+
+    // The array version has the same behavior.
+    std::array<uint8_t, kMaxLeb128Size> output_array;
+    int num_bytes = 0;
+    EXPECT_EQ(
+        leb_generator_->Uleb128ToUint8Array(input, output_array, num_bytes)
+            .code(),
+        expected_status_code);
+    if (expected_status_code == absl::StatusCode::kOk) {
+      EXPECT_THAT(absl::MakeConstSpan(output_array).first(num_bytes),
+                  ElementsAreArray(expected_result));
+    }
   }
 
   void TestSleb128ToUint8Vector(
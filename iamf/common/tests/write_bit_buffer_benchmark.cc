@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include <cstdint>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/types/span.h"
+#include "benchmark/benchmark.h"
+#include "iamf/common/write_bit_buffer.h"
+
+namespace iamf_tools {
+namespace {
+
+// Writes literals of `num_bits` bits each, similar to the fields of
+// descriptor OBUs and parameter blocks.
+static void BM_WriteUnsignedLiteral(benchmark::State& state) {
+  const int num_bits = state.range(0);
+  const int num_writes = state.range(1);
+  const uint32_t data = (uint64_t{1} << num_bits) - 1;
+  WriteBitBuffer wb(0);
+
+  for (auto _ : state) {
+    wb.Reset();
+    for (int i = 0; i < num_writes; ++i) {
+      ABSL_CHECK_OK(wb.WriteUnsignedLiteral(data, num_bits));
+    }
+    benchmark::DoNotOptimize(wb.bit_buffer().data());
+  }
+  state.SetItemsProcessed(state.iterations() * num_writes);
+}
+
+// Benchmark various combinations of (#bits per write, #writes).
+BENCHMARK(BM_WriteUnsignedLiteral)
+    ->Args({1, 1024})
+    ->Args({3, 1024})
+    ->Args({8, 1024})
+    ->Args({16, 1024})
+    ->Args({32, 1024});
+
+// Writes a span, similar to the payload of an audio frame, after
+// `num_leading_bits` bits.
+static void BM_WriteUint8Span(benchmark::State& state) {
+  const int num_leading_bits = state.range(0);
+  const std::vector<uint8_t> data(state.range(1), 0xa5);
+  WriteBitBuffer wb(0);
+
+  for (auto _ : state) {
+    wb.Reset();
+    ABSL_CHECK_OK(wb.WriteUnsignedLiteral(0, num_leading_bits));
+    ABSL_CHECK_OK(wb.WriteUint8Span(absl::MakeConstSpan(data)));
+    benchmark::DoNotOptimize(wb.bit_buffer().data());
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// Benchmark various combinations of (#leading bits, #bytes in the span).
+BENCHMARK(BM_WriteUint8Span)
+    ->Args({0, 256})
+    ->Args({0, 4096})
+    ->Args({3, 256})
+    ->Args({3, 4096});
+
+}  // namespace
+}  // namespace iamf_tools
@@ -231,6 +231,17 @@ TEST(WriteUnsignedLiteral64, NotByteAlignedLarge) {
       wb, 63, {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe});
 }
 
+TEST(WriteUnsignedLiteral64, EightBytesWhenBufferIsNotByteAligned) {
+  WriteBitBuffer wb(kInitialCapacity);
+
+  EXPECT_THAT(wb.WriteBoolean(true), IsOk());
+  EXPECT_THAT(wb.WriteUnsignedLiteral64(0xfedcba9876543210l, 64), IsOk());
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0, 7), IsOk());
+
+  ValidateWriteResults(
+      wb, {0xff, 0x6e, 0x5d, 0x4c, 0x3b, 0x2a, 0x19, 0x08, 0x00});
+}
+
 TEST(WriteUnsignedLiteral64, InvalidOverflowOverRequestedNumBits) {
   WriteBitBuffer wb(kInitialCapacity);
 
@@ -515,6 +526,21 @@ TEST(WriteUint8Span, WorksWhenBufferIsNotByteAligned) {
                        });
 }
 
+TEST(WriteUint8Span, WorksForLongSpansWhenBufferIsNotByteAligned) {
+  WriteBitBuffer wb(kInitialCapacity);
+  const std::vector<uint8_t> kElevenBytes = {0x01, 0x02, 0x03, 0x04,
+                                             0x05, 0x06, 0x07, 0x08,
+                                             0x09, 0x0a, 0x0b};
+
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0xa, 4), IsOk());
+  EXPECT_THAT(wb.WriteUint8Span(absl::MakeConstSpan(kElevenBytes)), IsOk());
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0xb, 4), IsOk());
+
+  // Every byte of the span is split across two bytes of the buffer.
+  ValidateWriteResults(wb, {0xa0, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70,
+                            0x80, 0x90, 0xa0, 0xbb});
+}
+
 TEST(WriteUleb128, Min) {
   WriteBitBuffer wb(kInitialCapacity);
 
@@ -558,6 +584,58 @@ TEST(WriteUleb128, CanFailWithFixedSizeGenerator) {
   EXPECT_FALSE(wb.WriteUleb128(128).ok());
 }
 
+TEST(OverwriteUleb128, OverwritesReservedBytesOfTheSameSize) {
+  auto leb_generator =
+      LebGenerator::Create(LebGenerator::GenerationMode::kFixedSize, 2);
+  ASSERT_NE(leb_generator, nullptr);
+  WriteBitBuffer wb(kInitialCapacity, *leb_generator);
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0xaa, 8), IsOk());
+  EXPECT_THAT(wb.WriteUleb128(0), IsOk());
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0xbb, 8), IsOk());
+
+  EXPECT_THAT(wb.OverwriteUleb128(/*byte_offset=*/1, /*reserved_size=*/2, 1),
+              IsOk());
+
+  ValidateWriteResults(wb, {0xaa, 0x81, 0x00, 0xbb});
+}
+
+TEST(OverwriteUleb128, RemovesUnusedReservedBytes) {
+  WriteBitBuffer wb(kInitialCapacity);
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0xaa, 8), IsOk());
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0, 24), IsOk());
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0xbbcc, 16), IsOk());
+
+  EXPECT_THAT(wb.OverwriteUleb128(/*byte_offset=*/1, /*reserved_size=*/3, 128),
+              IsOk());
+
+  ValidateWriteResults(wb, {0xaa, 0x80, 0x01, 0xbb, 0xcc});
+}
+
+TEST(OverwriteUleb128, InvalidWhenEncodedValueDoesNotFit) {
+  WriteBitBuffer wb(kInitialCapacity);
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0, 8), IsOk());
+
+  EXPECT_THAT(wb.OverwriteUleb128(/*byte_offset=*/0, /*reserved_size=*/1, 128),
+              StatusIs(kInvalidArgument));
+}
+
+TEST(OverwriteUleb128, InvalidWhenReservedBytesAreOutsideOfTheBuffer) {
+  WriteBitBuffer wb(kInitialCapacity);
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0, 8), IsOk());
+
+  EXPECT_THAT(wb.OverwriteUleb128(/*byte_offset=*/1, /*reserved_size=*/1, 0),
+              StatusIs(kInvalidArgument));
+}
+
+TEST(OverwriteUleb128, InvalidWhenBufferIsNotByteAligned) {
+  WriteBitBuffer wb(kInitialCapacity);
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0, 8), IsOk());
+  EXPECT_THAT(wb.WriteBoolean(true), IsOk());
+
+  EXPECT_THAT(wb.OverwriteUleb128(/*byte_offset=*/0, /*reserved_size=*/1, 0),
+              StatusIs(kInvalidArgument));
+}
+
 struct WriteIso14496_1ExpandedTestCase {
   uint32_t size_of_instance;
   const std::vector<uint8_t> expected_source_data;
@@ -655,5 +733,27 @@ TEST(Reset, UseAfterReset) {
   ValidateWriteResults(wb, {100});
 }
 
+TEST(Truncate, DiscardsTrailingData) {
+  WriteBitBuffer wb(kInitialCapacity);
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0xabcd, 16), IsOk());
+  EXPECT_THAT(wb.WriteBoolean(true), IsOk());
+
+  wb.Truncate(1);
+  ValidateWriteResults(wb, {0xab});
+
+  // Later writes continue after the kept data.
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0xef, 8), IsOk());
+  ValidateWriteResults(wb, {0xab, 0xef});
+}
+
+TEST(Truncate, HasNoEffectWhenKeepingAllData) {
+  WriteBitBuffer wb(kInitialCapacity);
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0xabcd, 16), IsOk());
+
+  wb.Truncate(2);
+
+  ValidateWriteResults(wb, {0xab, 0xcd});
+}
+
 }  // namespace
 }  // namespace iamf_tools
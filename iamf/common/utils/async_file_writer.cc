@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/common/utils/async_file_writer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_log.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "iamf/common/utils/macros.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#define IAMF_ASYNC_FILE_WRITER_HAVE_POSIX 1
+#endif
+
+namespace iamf_tools {
+
+namespace {
+
+// One buffer is filled by the caller while the other is written.
+constexpr size_t kNumStagingBuffers = 2;
+
+}  // namespace
+
+class AsyncFileWriter::OutputFile {
+ public:
+  virtual ~OutputFile() = default;
+
+  /*!\brief Appends data to the end of the file.
+   *
+   * \param data Data to write.
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  virtual absl::Status Append(absl::Span<const uint8_t> data) = 0;
+
+  /*!\brief Overwrites data which was previously appended.
+   *
+   * \param offset Offset in bytes from the start of the file.
+   * \param data Data to write.
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  virtual absl::Status WriteAt(int64_t offset,
+                               absl::Span<const uint8_t> data) = 0;
+
+  /*!\brief Flushes and closes the file.
+   *
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  virtual absl::Status Close() = 0;
+};
+
+class AsyncFileWriter::FstreamFile : public AsyncFileWriter::OutputFile {
+ public:
+  explicit FstreamFile(std::fstream file) : file_(std::move(file)) {}
+
+  absl::Status Append(absl::Span<const uint8_t> data) override {
+    file_.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return GetStatus();
+  }
+
+  absl::Status WriteAt(int64_t offset,
+                       absl::Span<const uint8_t> data) override {
+    // Overwrite earlier data, then return to the end of the file.
+    const auto end_position = file_.tellp();
+    file_.seekp(offset, std::ios::beg);
+    file_.write(reinterpret_cast<const char*>(data.data()), data.size());
+    file_.seekp(end_position);
+    return GetStatus();
+  }
+
+  absl::Status Close() override {
+    // Closing flushes the stream, which may fail too.
+    file_.close();
+    if (file_.fail()) {
+      return absl::UnknownError("Failed to close the file.");
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  absl::Status GetStatus() const {
+    if (!file_.good()) {
+      return absl::UnknownError("Writing to file failed.");
+    }
+    return absl::OkStatus();
+  }
+
+  std::fstream file_;
+};
+
+#ifdef IAMF_ASYNC_FILE_WRITER_HAVE_POSIX
+class AsyncFileWriter::PosixFile : public AsyncFileWriter::OutputFile {
+ public:
+  /*!\brief Opens a file for writing, truncating any existing file.
+   *
+   * \param filename Name of the file to write.
+   * \param direct Whether to bypass the page cache, if the file system
+   *        supports it.
+   * \param block_buffer_size Size of the buffer which collects whole blocks
+   *        for direct I/O.
+   * \return Unique pointer to the file on success. A specific status on
+   *         failure.
+   */
+  static absl::StatusOr<std::unique_ptr<OutputFile>> Open(
+      const std::string& filename, bool direct, size_t block_buffer_size) {
+    const int fd =
+        open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      return absl::ErrnoToStatus(errno,
+                                 absl::StrCat("Failed to open ", filename));
+    }
+    if (direct && !SetDirectIo(fd, true)) {
+      ABSL_LOG(WARNING).WithPerror()
+          << "Direct I/O is unavailable for " << filename
+          << ". Writing through the page cache instead";
+      direct = false;
+    }
+    return absl::WrapUnique(new PosixFile(fd, direct, block_buffer_size));
+  }
+
+  ~PosixFile() override {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  absl::Status Append(absl::Span<const uint8_t> data) override {
+    if (!direct_) {
+      RETURN_IF_NOT_OK(WriteFully(data, file_size_));
+      file_size_ += data.size();
+      return absl::OkStatus();
+    }
+
+    // Direct I/O needs aligned memory, offsets and sizes. Collect the data in
+    // aligned blocks, and write them when the buffer is full.
+    while (!data.empty()) {
+      const size_t num_bytes =
+          std::min(data.size(), blocks_.size() - num_pending_bytes_);
+      std::copy(data.begin(), data.begin() + num_bytes,
+                blocks_.begin() + num_pending_bytes_);
+      data.remove_prefix(num_bytes);
+      num_pending_bytes_ += num_bytes;
+      if (num_pending_bytes_ == blocks_.size()) {
+        RETURN_IF_NOT_OK(WriteFully(blocks_, file_size_));
+        file_size_ += blocks_.size();
+        num_pending_bytes_ = 0;
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status WriteAt(int64_t offset,
+                       absl::Span<const uint8_t> data) override {
+    // Patch any part which has not reached the file yet.
+    const int64_t num_bytes_in_file =
+        std::clamp<int64_t>(file_size_ - offset, 0, data.size());
+    const auto pending_data = data.subspan(num_bytes_in_file);
+    std::copy(pending_data.begin(), pending_data.end(),
+              blocks_.begin() + (offset + num_bytes_in_file - file_size_));
+    data = data.first(num_bytes_in_file);
+    if (data.empty()) {
+      return absl::OkStatus();
+    }
+
+    if (!direct_) {
+      return WriteFully(data, offset);
+    }
+    // The data is unaligned, so it goes through the page cache. The kernel
+    // keeps the cached pages coherent with later direct writes.
+    RETURN_IF_NOT_OK(SetDirectIoOrError(false));
+    RETURN_IF_NOT_OK(WriteFully(data, offset));
+    return SetDirectIoOrError(true);
+  }
+
+  absl::Status Close() override {
+    absl::Status status = absl::OkStatus();
+    if (num_pending_bytes_ > 0) {
+      // The end of the file is rarely a whole block.
+      status = SetDirectIoOrError(false);
+      if (status.ok()) {
+        status = WriteFully(blocks_.first(num_pending_bytes_), file_size_);
+      }
+    }
+    if (status.ok() && SyncData(fd_) != 0) {
+      status = absl::ErrnoToStatus(errno, "Failed to sync the file.");
+    }
+    if (close(fd_) != 0 && status.ok()) {
+      status = absl::ErrnoToStatus(errno, "Failed to close the file.");
+    }
+    fd_ = -1;
+    return status;
+  }
+
+ private:
+  // Alignment of memory, offsets and sizes for direct I/O. Covers the logical
+  // block size of common storage.
+  static constexpr size_t kDirectIoAlignment = 4096;
+
+  /*!\brief Enables or disables direct I/O.
+   *
+   * \param fd File descriptor to configure.
+   * \param enable Whether to enable direct I/O.
+   * \return `true` on success. `false` if the file system does not support
+   *         direct I/O.
+   */
+  static bool SetDirectIo(int fd, bool enable) {
+#ifdef __APPLE__
+    return fcntl(fd, F_NOCACHE, enable ? 1 : 0) == 0;
+#else
+    const int flags = fcntl(fd, F_GETFL);
+    return flags >= 0 &&
+           fcntl(fd, F_SETFL,
+                 enable ? (flags | O_DIRECT) : (flags & ~O_DIRECT)) == 0;
+#endif
+  }
+
+  static int SyncData(int fd) {
+#ifdef __APPLE__
+    // Apple platforms do not declare `fdatasync()`.
+    return fsync(fd);
+#else
+    return fdatasync(fd);
+#endif
+  }
+
+  PosixFile(int fd, bool direct, size_t block_buffer_size)
+      : fd_(fd), direct_(direct) {
+    if (!direct_) {
+      return;
+    }
+    const size_t num_bytes =
+        (block_buffer_size + kDirectIoAlignment - 1) / kDirectIoAlignment *
+        kDirectIoAlignment;
+    block_storage_.resize(num_bytes + kDirectIoAlignment);
+    const size_t misalignment =
+        reinterpret_cast<uintptr_t>(block_storage_.data()) % kDirectIoAlignment;
+    blocks_ = absl::MakeSpan(block_storage_)
+                  .subspan((kDirectIoAlignment - misalignment) %
+                               kDirectIoAlignment,
+                           num_bytes);
+  }
+
+  absl::Status SetDirectIoOrError(bool enable) const {
+    if (!SetDirectIo(fd_, enable)) {
+      return absl::ErrnoToStatus(errno, "Failed to configure direct I/O.");
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status WriteFully(absl::Span<const uint8_t> data,
+                          int64_t offset) const {
+    while (!data.empty()) {
+      const ssize_t num_bytes = pwrite(fd_, data.data(), data.size(), offset);
+      if (num_bytes < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return absl::ErrnoToStatus(errno, "Writing to file failed.");
+      }
+      data.remove_prefix(num_bytes);
+      offset += num_bytes;
+    }
+    return absl::OkStatus();
+  }
+
+  int fd_;
+  const bool direct_;
+  // Number of bytes which reached the file. A multiple of the alignment with
+  // direct I/O.
+  int64_t file_size_ = 0;
+  // Aligned blocks which collect data for direct I/O, and their storage.
+  std::vector<uint8_t> block_storage_;
+  absl::Span<uint8_t> blocks_;
+  // Number of bytes at the start of `blocks_` waiting to be written.
+  size_t num_pending_bytes_ = 0;
+};
+#endif
+
+absl::StatusOr<std::unique_ptr<AsyncFileWriter>> AsyncFileWriter::Create(
+    const std::string& filename, size_t staging_buffer_size,
+    WritePolicy write_policy) {
+  staging_buffer_size = std::max(staging_buffer_size, size_t{1});
+  std::unique_ptr<OutputFile> file;
+  if (write_policy != WritePolicy::kBuffered) {
+#ifdef IAMF_ASYNC_FILE_WRITER_HAVE_POSIX
+    auto posix_file = PosixFile::Open(
+        filename, write_policy == WritePolicy::kDirect, staging_buffer_size);
+    if (!posix_file.ok()) {
+      return posix_file.status();
+    }
+    file = *std::move(posix_file);
+#else
+    ABSL_LOG(WARNING) << "POSIX I/O is unavailable. Writing " << filename
+                      << " with buffered I/O instead.";
+#endif
+  }
+  if (file == nullptr) {
+    std::fstream fstream(filename, std::fstream::out | std::ios::binary);
+    if (!fstream.is_open()) {
+      return absl::UnknownError(absl::StrCat("Failed to open ", filename));
+    }
+    file = std::make_unique<FstreamFile>(std::move(fstream));
+  }
+  return absl::WrapUnique(
+      new AsyncFileWriter(std::move(file), staging_buffer_size));
+}
+
+AsyncFileWriter::AsyncFileWriter(std::unique_ptr<OutputFile> file,
+                                 size_t staging_buffer_size)
+    : staging_buffer_size_(staging_buffer_size),
+      file_(std::move(file)),
+      // Both staging buffers may be waiting, followed by a `WriteAt()`.
+      requests_(kNumStagingBuffers + 1),
+      free_buffers_(kNumStagingBuffers) {
+  for (size_t i = 0; i < kNumStagingBuffers; ++i) {
+    std::vector<uint8_t> buffer;
+    buffer.reserve(staging_buffer_size_);
+    free_buffers_.Push(std::move(buffer));
+  }
+  writer_ = std::thread([this] { RunWriter(); });
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+  const auto status = Close();
+  if (!status.ok()) {
+    ABSL_LOG(ERROR) << "Failed to write file: " << status;
+  }
+}
+
+absl::Status AsyncFileWriter::Write(absl::Span<const uint8_t> data) {
+  if (closed_) {
+    return absl::FailedPreconditionError("Writing after `Close()`.");
+  }
+  RETURN_IF_NOT_OK(GetWriterStatus());
+  num_bytes_written_ += data.size();
+
+  // Copy the data into the staging buffers, handing off each one as it fills.
+  while (!data.empty()) {
+    auto& staging_buffer = GetStagingBuffer();
+    const size_t num_bytes =
+        std::min(data.size(), staging_buffer_size_ - staging_buffer.size());
+    staging_buffer.insert(staging_buffer.end(), data.begin(),
+                          data.begin() + num_bytes);
+    data.remove_prefix(num_bytes);
+    if (staging_buffer.size() == staging_buffer_size_) {
+      SubmitStagingBuffer();
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status AsyncFileWriter::WriteAt(int64_t offset,
+                                      absl::Span<const uint8_t> data) {
+  if (closed_) {
+    return absl::FailedPreconditionError("Writing after `Close()`.");
+  }
+  RETURN_IF_NOT_OK(GetWriterStatus());
+  if (offset < 0) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Offset must not be negative. offset= ", offset));
+  }
+  if (offset + static_cast<int64_t>(data.size()) > num_bytes_written_) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Cannot write past the data written so far. offset= ", offset,
+        ", data.size()= ", data.size(),
+        ", num_bytes_written_= ", num_bytes_written_));
+  }
+
+  // Preserve the order with any data which is still staged.
+  SubmitStagingBuffer();
+  requests_.Push({.data = std::vector<uint8_t>(data.begin(), data.end()),
+                  .offset = offset});
+  return absl::OkStatus();
+}
+
+absl::Status AsyncFileWriter::Close() {
+  if (!closed_) {
+    closed_ = true;
+    SubmitStagingBuffer();
+    requests_.Close();
+    writer_.join();
+
+    const auto close_status = file_->Close();
+    absl::MutexLock lock(&mutex_);
+    if (writer_status_.ok()) {
+      writer_status_ = close_status;
+    }
+  }
+  return GetWriterStatus();
+}
+
+void AsyncFileWriter::SubmitStagingBuffer() {
+  if (!staging_buffer_.has_value() || staging_buffer_->empty()) {
+    return;
+  }
+  requests_.Push({.data = *std::move(staging_buffer_)});
+  staging_buffer_ = std::nullopt;
+}
+
+std::vector<uint8_t>& AsyncFileWriter::GetStagingBuffer() {
+  if (!staging_buffer_.has_value()) {
+    // The writer thread never closes this queue, so a buffer always returns.
+    staging_buffer_ = free_buffers_.Pop();
+  }
+  return *staging_buffer_;
+}
+
+void AsyncFileWriter::RunWriter() {
+  while (auto request = requests_.Pop()) {
+    if (GetWriterStatus().ok()) {
+      const auto status =
+          request->offset.has_value()
+              ? file_->WriteAt(*request->offset, request->data)
+              : file_->Append(request->data);
+      if (!status.ok()) {
+        absl::MutexLock lock(&mutex_);
+        writer_status_ = status;
+      }
+    }
+
+    // Recycle staging buffers. Keep draining after a failure, so the caller
+    // does not wait forever for a free buffer.
+    if (!request->offset.has_value()) {
+      request->data.clear();
+      free_buffers_.Push(std::move(request->data));
+    }
+  }
+}
+
+absl::Status AsyncFileWriter::GetWriterStatus() const {
+  absl::MutexLock lock(&mutex_);
+  return writer_status_;
+}
+
+}  // namespace iamf_tools
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#ifndef COMMON_UTILS_ASYNC_FILE_WRITER_H_
+#define COMMON_UTILS_ASYNC_FILE_WRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "iamf/common/utils/bounded_queue.h"
+
+namespace iamf_tools {
+
+/*!\brief Writes a file on a dedicated thread.
+ *
+ * Data is collected in large staging buffers. Full buffers are handed to a
+ * writer thread, while the caller continues to fill the other buffer. The
+ * caller only blocks when both buffers are full, i.e. when the storage cannot
+ * keep up.
+ *
+ * Errors from the writer thread are reported by the next call to `Write()`,
+ * `WriteAt()` or `Close()`.
+ */
+class AsyncFileWriter {
+ public:
+  /*!\brief How the writer thread moves data to storage.
+   *
+   * The POSIX policies fall back to `kBuffered` on other platforms.
+   */
+  enum class WritePolicy {
+    // Write with `std::fstream`, leaving the OS to flush its page cache.
+    kBuffered,
+    // Write with `pwrite()`, then `fdatasync()` the file when closing.
+    kSynchronized,
+    // Like `kSynchronized`, but bypass the page cache with `O_DIRECT`, or
+    // `F_NOCACHE` on Apple platforms. Falls back to `kSynchronized` if the
+    // file system does not support it.
+    kDirect,
+  };
+
+  /*!\brief Default size of each staging buffer in bytes. */
+  static constexpr size_t kDefaultStagingBufferSize = 4 * 1024 * 1024;
+
+  /*!\brief Creates an `AsyncFileWriter`, truncating any existing file.
+   *
+   * \param filename Name of the file to write.
+   * \param staging_buffer_size Size of each staging buffer in bytes. Treated
+   *        as one if zero.
+   * \param write_policy How to write the file.
+   * \return Unique pointer to the writer on success. A specific status if the
+   *         file could not be opened.
+   */
+  static absl::StatusOr<std::unique_ptr<AsyncFileWriter>> Create(
+      const std::string& filename,
+      size_t staging_buffer_size = kDefaultStagingBufferSize,
+      WritePolicy write_policy = WritePolicy::kBuffered);
+
+  /*!\brief Destructor. Finishes all writes, then closes the file. */
+  ~AsyncFileWriter();
+
+  AsyncFileWriter(const AsyncFileWriter&) = delete;
+  AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+  /*!\brief Appends data to the end of the file.
+   *
+   * \param data Data to write.
+   * \return `absl::OkStatus()` on success. A specific status if the writer is
+   *         closed or if an earlier write failed.
+   */
+  absl::Status Write(absl::Span<const uint8_t> data);
+
+  /*!\brief Overwrites data which was previously written to the file.
+   *
+   * Takes effect after all earlier writes. Later calls to `Write()` still
+   * append to the end of the file.
+   *
+   * \param offset Offset in bytes from the start of the file.
+   * \param data Data to write.
+   * \return `absl::OkStatus()` on success. A specific status if the writer is
+   *         closed, if an earlier write failed, or if the data would extend
+   *         past the data written so far.
+   */
+  absl::Status WriteAt(int64_t offset, absl::Span<const uint8_t> data);
+
+  /*!\brief Finishes all writes, then closes the file.
+   *
+   * Subsequent calls only return the status again.
+   *
+   * \return `absl::OkStatus()` on success. The first error encountered while
+   *         writing on failure.
+   */
+  absl::Status Close();
+
+ private:
+  // Data to write, along with where to write it.
+  struct WriteRequest {
+    std::vector<uint8_t> data;
+    // Offset to write at, or `std::nullopt` to append to the end of the file.
+    std::optional<int64_t> offset;
+  };
+
+  // Destination of the writer thread, and its implementations.
+  class OutputFile;
+  class FstreamFile;
+  class PosixFile;
+
+  /*!\brief Constructor.
+   *
+   * \param file Opened file to write.
+   * \param staging_buffer_size Size of each staging buffer in bytes.
+   */
+  AsyncFileWriter(std::unique_ptr<OutputFile> file,
+                  size_t staging_buffer_size);
+
+  /*!\brief Hands the staging buffer to the writer thread, if it has data. */
+  void SubmitStagingBuffer();
+
+  /*!\brief Gets a staging buffer, waiting for the writer thread if needed.
+   *
+   * \return Staging buffer to fill.
+   */
+  std::vector<uint8_t>& GetStagingBuffer();
+
+  /*!\brief Writes requests until the queue is closed. */
+  void RunWriter();
+
+  /*!\brief Gets the status of the writer thread.
+   *
+   * \return `absl::OkStatus()` if all writes so far succeeded. The first error
+   *         otherwise.
+   */
+  absl::Status GetWriterStatus() const;
+
+  const size_t staging_buffer_size_;
+  // Only accessed by the writer thread, after construction.
+  std::unique_ptr<OutputFile> file_;
+
+  // Buffer being filled by the caller, if any.
+  std::optional<std::vector<uint8_t>> staging_buffer_;
+  // Requests waiting for the writer thread.
+  BoundedQueue<WriteRequest> requests_;
+  // Staging buffers which the writer thread has finished with.
+  BoundedQueue<std::vector<uint8_t>> free_buffers_;
+  // Number of bytes passed to `Write()`.
+  int64_t num_bytes_written_ = 0;
+  bool closed_ = false;
+
+  mutable absl::Mutex mutex_;
+  absl::Status writer_status_ ABSL_GUARDED_BY(mutex_);
+
+  std::thread writer_;
+};
+
+}  // namespace iamf_tools
+
+#endif  // COMMON_UTILS_ASYNC_FILE_WRITER_H_
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#ifndef COMMON_UTILS_BOUNDED_QUEUE_H_
+#define COMMON_UTILS_BOUNDED_QUEUE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace iamf_tools {
+
+/*!\brief First-in first-out queue with a bounded capacity.
+ *
+ * Connects the stages of a pipeline running on different threads. `Push()`
+ * blocks while the queue is full, so a fast producer cannot run arbitrarily
+ * far ahead of its consumer. Either side may `Close()` the queue; the consumer
+ * drains the remaining items, while further pushes are rejected.
+ *
+ * \tparam T Type of the items.
+ */
+template <typename T>
+class BoundedQueue {
+ public:
+  /*!\brief Constructor.
+   *
+   * \param capacity Maximum number of items in the queue. Treated as one if
+   *        zero.
+   */
+  explicit BoundedQueue(size_t capacity)
+      : capacity_(std::max(capacity, size_t{1})) {}
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  /*!\brief Pushes an item, blocking while the queue is full.
+   *
+   * \param item Item to push.
+   * \return `true` if the item was pushed. `false` if the queue was closed.
+   */
+  bool Push(T item) {
+    absl::MutexLock lock(&mutex_);
+    mutex_.Await(absl::Condition(this, &BoundedQueue::CanPush));
+    if (closed_) {
+      return false;
+    }
+    items_.push_back(std::move(item));
+    return true;
+  }
+
+  /*!\brief Pops the oldest item, blocking while the queue is empty.
+   *
+   * \return Oldest item. Or `std::nullopt` if the queue is closed and empty.
+   */
+  std::optional<T> Pop() {
+    absl::MutexLock lock(&mutex_);
+    mutex_.Await(absl::Condition(this, &BoundedQueue::CanPop));
+    if (items_.empty()) {
+      return std::nullopt;
+    }
+    std::optional<T> item(std::move(items_.front()));
+    items_.pop_front();
+    return item;
+  }
+
+  /*!\brief Closes the queue, waking any blocked callers. */
+  void Close() {
+    absl::MutexLock lock(&mutex_);
+    closed_ = true;
+  }
+
+ private:
+  bool CanPush() const ABSL_SHARED_LOCKS_REQUIRED(mutex_) {
+    return closed_ || items_.size() < capacity_;
+  }
+
+  bool CanPop() const ABSL_SHARED_LOCKS_REQUIRED(mutex_) {
+    return closed_ || !items_.empty();
+  }
+
+  const size_t capacity_;
+
+  absl::Mutex mutex_;
+  std::deque<T> items_ ABSL_GUARDED_BY(mutex_);
+  bool closed_ ABSL_GUARDED_BY(mutex_) = false;
+};
+
+}  // namespace iamf_tools
+
+#endif  // COMMON_UTILS_BOUNDED_QUEUE_H_
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/common/utils/filter_design_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace iamf_tools {
+
+double BesselI0(double x) {
+  double sum = 1.0;
+  double term = 1.0;
+  const double half_x_squared = 0.25 * x * x;
+  for (int k = 1; k < 64 && term > 1e-12 * sum; ++k) {
+    term *= half_x_squared / (static_cast<double>(k) * k);
+    sum += term;
+  }
+  return sum;
+}
+
+double Sinc(double x) {
+  if (x == 0.0) {
+    return 1.0;
+  }
+  const double pi_x = std::numbers::pi * x;
+  return std::sin(pi_x) / pi_x;
+}
+
+double KaiserWindow(double normalized_offset, double beta) {
+  return BesselI0(beta * std::sqrt(std::max(
+                             0.0, 1.0 - normalized_offset * normalized_offset))) *
+         (1.0 / BesselI0(beta));
+}
+
+}  // namespace iamf_tools
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#ifndef COMMON_UTILS_FILTER_DESIGN_UTILS_H_
+#define COMMON_UTILS_FILTER_DESIGN_UTILS_H_
+
+namespace iamf_tools {
+
+/*!\brief Computes the zeroth order modified Bessel function of the first kind.
+ *
+ * \param x Argument of the function.
+ * \return `I0(x)`, accurate to about 12 significant digits.
+ */
+double BesselI0(double x);
+
+/*!\brief Computes the normalized sinc function.
+ *
+ * \param x Argument of the function.
+ * \return `sin(pi * x) / (pi * x)`, or 1 when `x` is zero.
+ */
+double Sinc(double x);
+
+/*!\brief Computes a Kaiser window.
+ *
+ * \param normalized_offset Offset from the center of the window, normalized so
+ *        that the edges of the window are at -1 and 1. Offsets slightly past
+ *        the edges, e.g. due to rounding, are treated as the edges.
+ * \param beta Shape parameter of the window.
+ * \return Value of the window, which is 1 at the center.
+ */
+double KaiserWindow(double normalized_offset, double beta);
+
+}  // namespace iamf_tools
+
+#endif  // COMMON_UTILS_FILTER_DESIGN_UTILS_H_
@@ -0,0 +1,631 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/common/utils/mixing_utils.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+// Every implementation of the kernels must round each multiply and add
+// separately, so the results do not depend on the selected implementation.
+// Keep compilers from fusing them into FMAs, which some targets (e.g. AVX-512,
+// or GCC on aarch64 by default) would otherwise do, including in the scalar
+// tails which are inlined into the vectorized kernels.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define IAMF_MIXING_UTILS_HAVE_SSE2 1
+#endif
+
+// Wider x86 kernels are compiled with function-level target attributes and
+// selected at runtime, so they do not require any global compiler flags.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define IAMF_MIXING_UTILS_HAVE_X86_DISPATCH 1
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define IAMF_MIXING_UTILS_HAVE_NEON 1
+#endif
+
+namespace iamf_tools {
+
+namespace {
+
+// Number of ticks processed per tile. Chosen so that a tile of a typical
+// number of input channels (up to 16) fits in the L1 data cache while the
+// outputs are computed.
+constexpr size_t kTicksPerTile = 256;
+
+// A non-zero entry in a column of the gain matrix.
+struct Tap {
+  const double* samples;
+  double gain;
+};
+
+// Computes `output[t] = sum_i(taps[i].samples[t] * taps[i].gain)` for
+// `t` in `[0, num_ticks)`.
+typedef void (*MixTapsFunction)(const Tap* taps, size_t num_taps,
+                                size_t num_ticks, double* output);
+
+// Computes `samples[t] *= gains[t]` for `t` in `[0, num_ticks)`.
+typedef void (*ApplyGainsFunction)(const float* gains, size_t num_ticks,
+                                   double* samples);
+
+// Computes `output[t] += block[t]` for `t` in `[0, num_ticks)`.
+typedef void (*AccumulateFunction)(const double* block, size_t num_ticks,
+                                   double* output);
+
+// Computes `output[t] += block[t] * gains[t]` for `t` in `[0, num_ticks)`.
+typedef void (*AccumulateWithGainsFunction)(const double* block,
+                                            const float* gains,
+                                            size_t num_ticks, double* output);
+
+struct MixingKernels {
+  absl::string_view name;
+  MixTapsFunction mix_taps;
+  ApplyGainsFunction apply_gains;
+  AccumulateFunction accumulate;
+  AccumulateWithGainsFunction accumulate_with_gains;
+};
+
+// Scalar kernels. These also handle the tails of the vectorized kernels.
+inline double MixTapsForTick(const Tap* taps, size_t num_taps, size_t t) {
+  double acc = 0.0;
+  for (size_t i = 0; i < num_taps; ++i) {
+    acc += taps[i].samples[t] * taps[i].gain;
+  }
+  return acc;
+}
+
+void MixTapsScalar(const Tap* taps, size_t num_taps, size_t num_ticks,
+                   double* output) {
+  for (size_t t = 0; t < num_ticks; ++t) {
+    output[t] = MixTapsForTick(taps, num_taps, t);
+  }
+}
+
+void ApplyGainsScalar(const float* gains, size_t num_ticks, double* samples) {
+  for (size_t t = 0; t < num_ticks; ++t) {
+    samples[t] *= gains[t];
+  }
+}
+
+void AccumulateScalar(const double* block, size_t num_ticks, double* output) {
+  for (size_t t = 0; t < num_ticks; ++t) {
+    output[t] += block[t];
+  }
+}
+
+void AccumulateWithGainsScalar(const double* block, const float* gains,
+                               size_t num_ticks, double* output) {
+  for (size_t t = 0; t < num_ticks; ++t) {
+    output[t] += block[t] * gains[t];
+  }
+}
+
+#ifdef IAMF_MIXING_UTILS_HAVE_SSE2
+void MixTapsSse2(const Tap* taps, size_t num_taps, size_t num_ticks,
+                 double* output) {
+  size_t t = 0;
+  for (; t + 4 <= num_ticks; t += 4) {
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    for (size_t i = 0; i < num_taps; ++i) {
+      const double* samples = taps[i].samples + t;
+      const __m128d gain = _mm_set1_pd(taps[i].gain);
+      acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(samples), gain));
+      acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(samples + 2), gain));
+    }
+    _mm_storeu_pd(output + t, acc0);
+    _mm_storeu_pd(output + t + 2, acc1);
+  }
+  for (; t < num_ticks; ++t) {
+    output[t] = MixTapsForTick(taps, num_taps, t);
+  }
+}
+
+void ApplyGainsSse2(const float* gains, size_t num_ticks, double* samples) {
+  size_t t = 0;
+  for (; t + 4 <= num_ticks; t += 4) {
+    const __m128 gains_ps = _mm_loadu_ps(gains + t);
+    const __m128d gains_lo = _mm_cvtps_pd(gains_ps);
+    const __m128d gains_hi = _mm_cvtps_pd(_mm_movehl_ps(gains_ps, gains_ps));
+    _mm_storeu_pd(samples + t,
+                  _mm_mul_pd(_mm_loadu_pd(samples + t), gains_lo));
+    _mm_storeu_pd(samples + t + 2,
+                  _mm_mul_pd(_mm_loadu_pd(samples + t + 2), gains_hi));
+  }
+  ApplyGainsScalar(gains + t, num_ticks - t, samples + t);
+}
+
+void AccumulateSse2(const double* block, size_t num_ticks, double* output) {
+  size_t t = 0;
+  for (; t + 4 <= num_ticks; t += 4) {
+    _mm_storeu_pd(output + t, _mm_add_pd(_mm_loadu_pd(output + t),
+                                         _mm_loadu_pd(block + t)));
+    _mm_storeu_pd(output + t + 2, _mm_add_pd(_mm_loadu_pd(output + t + 2),
+                                             _mm_loadu_pd(block + t + 2)));
+  }
+  AccumulateScalar(block + t, num_ticks - t, output + t);
+}
+
+void AccumulateWithGainsSse2(const double* block, const float* gains,
+                             size_t num_ticks, double* output) {
+  size_t t = 0;
+  for (; t + 4 <= num_ticks; t += 4) {
+    const __m128 gains_ps = _mm_loadu_ps(gains + t);
+    const __m128d gains_lo = _mm_cvtps_pd(gains_ps);
+    const __m128d gains_hi = _mm_cvtps_pd(_mm_movehl_ps(gains_ps, gains_ps));
+    _mm_storeu_pd(output + t,
+                  _mm_add_pd(_mm_loadu_pd(output + t),
+                             _mm_mul_pd(_mm_loadu_pd(block + t), gains_lo)));
+    _mm_storeu_pd(
+        output + t + 2,
+        _mm_add_pd(_mm_loadu_pd(output + t + 2),
+                   _mm_mul_pd(_mm_loadu_pd(block + t + 2), gains_hi)));
+  }
+  AccumulateWithGainsScalar(block + t, gains + t, num_ticks - t, output + t);
+}
+#endif  // IAMF_MIXING_UTILS_HAVE_SSE2
+
+#ifdef IAMF_MIXING_UTILS_HAVE_X86_DISPATCH
+__attribute__((target("avx2"))) void MixTapsAvx2(const Tap* taps,
+                                                 size_t num_taps,
+                                                 size_t num_ticks,
+                                                 double* output) {
+  size_t t = 0;
+  for (; t + 8 <= num_ticks; t += 8) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    for (size_t i = 0; i < num_taps; ++i) {
+      const double* samples = taps[i].samples + t;
+      const __m256d gain = _mm256_set1_pd(taps[i].gain);
+      acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(samples), gain));
+      acc1 = _mm256_add_pd(acc1,
+                           _mm256_mul_pd(_mm256_loadu_pd(samples + 4), gain));
+    }
+    _mm256_storeu_pd(output + t, acc0);
+    _mm256_storeu_pd(output + t + 4, acc1);
+  }
+  for (; t < num_ticks; ++t) {
+    output[t] = MixTapsForTick(taps, num_taps, t);
+  }
+}
+
+__attribute__((target("avx2"))) void ApplyGainsAvx2(const float* gains,
+                                                    size_t num_ticks,
+                                                    double* samples) {
+  size_t t = 0;
+  for (; t + 4 <= num_ticks; t += 4) {
+    const __m256d gains_pd = _mm256_cvtps_pd(_mm_loadu_ps(gains + t));
+    _mm256_storeu_pd(samples + t,
+                     _mm256_mul_pd(_mm256_loadu_pd(samples + t), gains_pd));
+  }
+  ApplyGainsScalar(gains + t, num_ticks - t, samples + t);
+}
+
+__attribute__((target("avx2"))) void AccumulateAvx2(const double* block,
+                                                    size_t num_ticks,
+                                                    double* output) {
+  size_t t = 0;
+  for (; t + 4 <= num_ticks; t += 4) {
+    _mm256_storeu_pd(output + t, _mm256_add_pd(_mm256_loadu_pd(output + t),
+                                               _mm256_loadu_pd(block + t)));
+  }
+  AccumulateScalar(block + t, num_ticks - t, output + t);
+}
+
+__attribute__((target("avx2"))) void AccumulateWithGainsAvx2(
+    const double* block, const float* gains, size_t num_ticks,
+    double* output) {
+  size_t t = 0;
+  for (; t + 4 <= num_ticks; t += 4) {
+    const __m256d gains_pd = _mm256_cvtps_pd(_mm_loadu_ps(gains + t));
+    _mm256_storeu_pd(
+        output + t,
+        _mm256_add_pd(_mm256_loadu_pd(output + t),
+                      _mm256_mul_pd(_mm256_loadu_pd(block + t), gains_pd)));
+  }
+  AccumulateWithGainsScalar(block + t, gains + t, num_ticks - t, output + t);
+}
+
+__attribute__((target("avx512f"))) void MixTapsAvx512(const Tap* taps,
+                                                      size_t num_taps,
+                                                      size_t num_ticks,
+                                                      double* output) {
+  size_t t = 0;
+  for (; t + 16 <= num_ticks; t += 16) {
+    __m512d acc0 = _mm512_setzero_pd();
+    __m512d acc1 = _mm512_setzero_pd();
+    for (size_t i = 0; i < num_taps; ++i) {
+      const double* samples = taps[i].samples + t;
+      const __m512d gain = _mm512_set1_pd(taps[i].gain);
+      acc0 = _mm512_add_pd(acc0, _mm512_mul_pd(_mm512_loadu_pd(samples), gain));
+      acc1 = _mm512_add_pd(acc1,
+                           _mm512_mul_pd(_mm512_loadu_pd(samples + 8), gain));
+    }
+    _mm512_storeu_pd(output + t, acc0);
+    _mm512_storeu_pd(output + t + 8, acc1);
+  }
+  for (; t < num_ticks; ++t) {
+    output[t] = MixTapsForTick(taps, num_taps, t);
+  }
+}
+
+__attribute__((target("avx512f"))) void ApplyGainsAvx512(const float* gains,
+                                                         size_t num_ticks,
+                                                         double* samples) {
+  size_t t = 0;
+  for (; t + 8 <= num_ticks; t += 8) {
+    const __m512d gains_pd = _mm512_cvtps_pd(_mm256_loadu_ps(gains + t));
+    _mm512_storeu_pd(samples + t,
+                     _mm512_mul_pd(_mm512_loadu_pd(samples + t), gains_pd));
+  }
+  ApplyGainsScalar(gains + t, num_ticks - t, samples + t);
+}
+
+__attribute__((target("avx512f"))) void AccumulateAvx512(const double* block,
+                                                         size_t num_ticks,
+                                                         double* output) {
+  size_t t = 0;
+  for (; t + 8 <= num_ticks; t += 8) {
+    _mm512_storeu_pd(output + t, _mm512_add_pd(_mm512_loadu_pd(output + t),
+                                               _mm512_loadu_pd(block + t)));
+  }
+  AccumulateScalar(block + t, num_ticks - t, output + t);
+}
+
+__attribute__((target("avx512f"))) void AccumulateWithGainsAvx512(
+    const double* block, const float* gains, size_t num_ticks,
+    double* output) {
+  size_t t = 0;
+  for (; t + 8 <= num_ticks; t += 8) {
+    const __m512d gains_pd = _mm512_cvtps_pd(_mm256_loadu_ps(gains + t));
+    _mm512_storeu_pd(
+        output + t,
+        _mm512_add_pd(_mm512_loadu_pd(output + t),
+                      _mm512_mul_pd(_mm512_loadu_pd(block + t), gains_pd)));
+  }
+  AccumulateWithGainsScalar(block + t, gains + t, num_ticks - t, output + t);
+}
+#endif  // IAMF_MIXING_UTILS_HAVE_X86_DISPATCH
+
+#ifdef IAMF_MIXING_UTILS_HAVE_NEON
+void MixTapsNeon(const Tap* taps, size_t num_taps, size_t num_ticks,
+                 double* output) {
+  size_t t = 0;
+  for (; t + 4 <= num_ticks; t += 4) {
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+    for (size_t i = 0; i < num_taps; ++i) {
+      const double* samples = taps[i].samples + t;
+      const float64x2_t gain = vdupq_n_f64(taps[i].gain);
+      acc0 = vaddq_f64(acc0, vmulq_f64(vld1q_f64(samples), gain));
+      acc1 = vaddq_f64(acc1, vmulq_f64(vld1q_f64(samples + 2), gain));
+    }
+    vst1q_f64(output + t, acc0);
+    vst1q_f64(output + t + 2, acc1);
+  }
+  for (; t < num_ticks; ++t) {
+    output[t] = MixTapsForTick(taps, num_taps, t);
+  }
+}
+
+void ApplyGainsNeon(const float* gains, size_t num_ticks, double* samples) {
+  size_t t = 0;
+  for (; t + 4 <= num_ticks; t += 4) {
+    const float32x4_t gains_ps = vld1q_f32(gains + t);
+    vst1q_f64(samples + t, vmulq_f64(vld1q_f64(samples + t),
+                                     vcvt_f64_f32(vget_low_f32(gains_ps))));
+    vst1q_f64(samples + t + 2, vmulq_f64(vld1q_f64(samples + t + 2),
+                                         vcvt_high_f64_f32(gains_ps)));
+  }
+  ApplyGainsScalar(gains + t, num_ticks - t, samples + t);
+}
+
+void AccumulateNeon(const double* block, size_t num_ticks, double* output) {
+  size_t t = 0;
+  for (; t + 4 <= num_ticks; t += 4) {
+    vst1q_f64(output + t,
+              vaddq_f64(vld1q_f64(output + t), vld1q_f64(block + t)));
+    vst1q_f64(output + t + 2,
+              vaddq_f64(vld1q_f64(output + t + 2), vld1q_f64(block + t + 2)));
+  }
+  AccumulateScalar(block + t, num_ticks - t, output + t);
+}
+
+void AccumulateWithGainsNeon(const double* block, const float* gains,
+                             size_t num_ticks, double* output) {
+  size_t t = 0;
+  for (; t + 4 <= num_ticks; t += 4) {
+    const float32x4_t gains_ps = vld1q_f32(gains + t);
+    vst1q_f64(output + t,
+              vaddq_f64(vld1q_f64(output + t),
+                        vmulq_f64(vld1q_f64(block + t),
+                                  vcvt_f64_f32(vget_low_f32(gains_ps)))));
+    vst1q_f64(output + t + 2,
+              vaddq_f64(vld1q_f64(output + t + 2),
+                        vmulq_f64(vld1q_f64(block + t + 2),
+                                  vcvt_high_f64_f32(gains_ps))));
+  }
+  AccumulateWithGainsScalar(block + t, gains + t, num_ticks - t, output + t);
+}
+#endif  // IAMF_MIXING_UTILS_HAVE_NEON
+
+// Gets the kernels supported by this CPU, ordered from the fastest to the
+// scalar fallback.
+absl::InlinedVector<MixingKernels, 5> GetSupportedMixingKernels() {
+  absl::InlinedVector<MixingKernels, 5> supported_kernels;
+#ifdef IAMF_MIXING_UTILS_HAVE_X86_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    supported_kernels.push_back({"avx512", MixTapsAvx512, ApplyGainsAvx512,
+                                 AccumulateAvx512, AccumulateWithGainsAvx512});
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    supported_kernels.push_back({"avx2", MixTapsAvx2, ApplyGainsAvx2,
+                                 AccumulateAvx2, AccumulateWithGainsAvx2});
+  }
+#endif
+#ifdef IAMF_MIXING_UTILS_HAVE_SSE2
+  supported_kernels.push_back({"sse2", MixTapsSse2, ApplyGainsSse2,
+                               AccumulateSse2, AccumulateWithGainsSse2});
+#endif
+#ifdef IAMF_MIXING_UTILS_HAVE_NEON
+  supported_kernels.push_back({"neon", MixTapsNeon, ApplyGainsNeon,
+                               AccumulateNeon, AccumulateWithGainsNeon});
+#endif
+  supported_kernels.push_back({"scalar", MixTapsScalar, ApplyGainsScalar,
+                               AccumulateScalar, AccumulateWithGainsScalar});
+  return supported_kernels;
+}
+
+MixingKernels& GetMutableMixingKernels() {
+  static MixingKernels mixing_kernels = GetSupportedMixingKernels().front();
+  return mixing_kernels;
+}
+
+const MixingKernels& GetMixingKernels() { return GetMutableMixingKernels(); }
+
+}  // namespace
+
+absl::string_view GetMixingKernelInstructionSet() {
+  return GetMixingKernels().name;
+}
+
+std::vector<absl::string_view> GetSupportedMixingKernelInstructionSets() {
+  std::vector<absl::string_view> instruction_sets;
+  for (const auto& kernels : GetSupportedMixingKernels()) {
+    instruction_sets.push_back(kernels.name);
+  }
+  return instruction_sets;
+}
+
+absl::Status SetMixingKernelInstructionSetForTesting(
+    absl::string_view instruction_set) {
+  for (const auto& kernels : GetSupportedMixingKernels()) {
+    if (kernels.name == instruction_set) {
+      GetMutableMixingKernels() = kernels;
+      return absl::OkStatus();
+    }
+  }
+  return absl::InvalidArgumentError(absl::StrCat(
+      "Unsupported mixing kernel instruction set: ", instruction_set));
+}
+
+absl::Status MixSamplesWithGainMatrix(
+    absl::Span<const absl::Span<const double>> input,
+    absl::Span<const double> gains,
+    absl::Span<const absl::Span<double>> output) {
+  const size_t num_input_channels = input.size();
+  const size_t num_output_channels = output.size();
+  if (gains.size() != num_input_channels * num_output_channels) [[unlikely]] {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Expected a gain matrix with ", num_input_channels, "x",
+        num_output_channels, " elements. Got ", gains.size(), " elements."));
+  }
+  const size_t num_ticks = output.empty() ? 0 : output[0].size();
+  const auto has_wrong_num_ticks = [num_ticks](const auto& channel) {
+    return channel.size() != num_ticks;
+  };
+  if (std::any_of(input.begin(), input.end(), has_wrong_num_ticks) ||
+      std::any_of(output.begin(), output.end(), has_wrong_num_ticks))
+      [[unlikely]] {
+    return absl::InvalidArgumentError(
+        "All input and output channels must have the same number of ticks.");
+  }
+
+  // Gather the non-zero gains for each output channel. Downmixing matrices are
+  // typically sparse, so this avoids most of the multiplications.
+  absl::InlinedVector<Tap, 64> taps;
+  absl::InlinedVector<size_t, 32> first_tap_for_output(num_output_channels + 1);
+  for (size_t o = 0; o < num_output_channels; ++o) {
+    first_tap_for_output[o] = taps.size();
+    for (size_t i = 0; i < num_input_channels; ++i) {
+      const double gain = gains[i * num_output_channels + o];
+      if (gain != 0.0) {
+        taps.push_back({input[i].data(), gain});
+      }
+    }
+  }
+  first_tap_for_output[num_output_channels] = taps.size();
+
+  // Process the block tile by tile, so the input tile stays resident in the
+  // cache while every output channel is computed from it.
+  const auto& kernels = GetMixingKernels();
+  absl::InlinedVector<Tap, 64> tile_taps(taps.size());
+  for (size_t tile_start = 0; tile_start < num_ticks;
+       tile_start += kTicksPerTile) {
+    const size_t tile_size = std::min(kTicksPerTile, num_ticks - tile_start);
+    for (size_t i = 0; i < taps.size(); ++i) {
+      tile_taps[i] = {taps[i].samples + tile_start, taps[i].gain};
+    }
+    for (size_t o = 0; o < num_output_channels; ++o) {
+      const size_t first_tap = first_tap_for_output[o];
+      kernels.mix_taps(tile_taps.data() + first_tap,
+                       first_tap_for_output[o + 1] - first_tap, tile_size,
+                       output[o].data() + tile_start);
+    }
+  }
+
+  return absl::OkStatus();
+}
+
+absl::Status ApplyGainsPerTick(absl::Span<const float> gains,
+                               absl::Span<double> samples) {
+  if (gains.size() < samples.size()) [[unlikely]] {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Expected at least ", samples.size(), " gains. Got ",
+                     gains.size(), " gains."));
+  }
+  GetMixingKernels().apply_gains(gains.data(), samples.size(), samples.data());
+  return absl::OkStatus();
+}
+
+absl::Status SumSamples(absl::Span<const absl::Span<const double>> blocks,
+                        absl::Span<double> output) {
+  const size_t num_ticks = output.size();
+  if (std::any_of(blocks.begin(), blocks.end(), [num_ticks](const auto& block) {
+        return block.size() != num_ticks;
+      })) [[unlikely]] {
+    return absl::InvalidArgumentError(
+        "All blocks must have the same number of ticks as the output.");
+  }
+
+  std::fill(output.begin(), output.end(), 0.0);
+  // Accumulate tile by tile, so the output tile stays resident in the cache
+  // while every block is added to it.
+  const auto& kernels = GetMixingKernels();
+  for (size_t tile_start = 0; tile_start < num_ticks;
+       tile_start += kTicksPerTile) {
+    const size_t tile_size = std::min(kTicksPerTile, num_ticks - tile_start);
+    for (const auto& block : blocks) {
+      kernels.accumulate(block.data() + tile_start, tile_size,
+                         output.data() + tile_start);
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status MixSamplesWithGainsPerTick(
+    absl::Span<const absl::Span<const double>> blocks,
+    absl::Span<const absl::Span<const float>> block_gains,
+    absl::Span<const float> output_gains, absl::Span<double> output) {
+  const size_t num_ticks = output.size();
+  if (block_gains.size() != blocks.size()) [[unlikely]] {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Expected gains for ", blocks.size(), " blocks. Got ",
+                     block_gains.size(), "."));
+  }
+  if (std::any_of(blocks.begin(), blocks.end(), [num_ticks](const auto& block) {
+        return block.size() != num_ticks;
+      })) [[unlikely]] {
+    return absl::InvalidArgumentError(
+        "All blocks must have the same number of ticks as the output.");
+  }
+  const auto has_too_few_gains = [num_ticks](absl::Span<const float> gains) {
+    return !gains.empty() && gains.size() < num_ticks;
+  };
+  if (std::any_of(block_gains.begin(), block_gains.end(),
+                  has_too_few_gains) ||
+      has_too_few_gains(output_gains)) [[unlikely]] {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Expected no gains or at least ", num_ticks, " gains per tick."));
+  }
+
+  // Produce the output tile by tile. Each tile is zeroed, accumulated from
+  // every block, and scaled by the output gain while it is still resident in
+  // the cache, so the output is only streamed to memory once.
+  const auto& kernels = GetMixingKernels();
+  for (size_t tile_start = 0; tile_start < num_ticks;
+       tile_start += kTicksPerTile) {
+    const size_t tile_size = std::min(kTicksPerTile, num_ticks - tile_start);
+    double* output_tile = output.data() + tile_start;
+    std::fill(output_tile, output_tile + tile_size, 0.0);
+    for (size_t n = 0; n < blocks.size(); ++n) {
+      const double* block_tile = blocks[n].data() + tile_start;
+      if (block_gains[n].empty()) {
+        kernels.accumulate(block_tile, tile_size, output_tile);
+      } else {
+        kernels.accumulate_with_gains(
+            block_tile, block_gains[n].data() + tile_start, tile_size,
+            output_tile);
+      }
+    }
+    if (!output_gains.empty()) {
+      kernels.apply_gains(output_gains.data() + tile_start, tile_size,
+                          output_tile);
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ConvertDbToLinearGains(absl::Span<const float> gains_db,
+                                    absl::Span<float> linear_gains) {
+  if (gains_db.size() != linear_gains.size()) [[unlikely]] {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Expected ", gains_db.size(), " linear gains. Got ",
+                     linear_gains.size(), " linear gains."));
+  }
+
+  // 10^(dB / 20) = 2^(dB * log2(10) / 20). Split the exponent into the nearest
+  // integer `k` and a remainder `r` in [-0.5, 0.5]. 2^k is built directly from
+  // its bit pattern and 2^r is evaluated as a polynomial of `r * ln(2)`.
+  constexpr double kLog2Of10Over20 = 0.16609640474436813;
+  constexpr double kLn2 = 0.69314718055994531;
+  // Adding and subtracting this constant rounds to the nearest integer without
+  // calling `std::nearbyint()`, which would block vectorization.
+  constexpr double kRoundingConstant = 0x1.8p52;
+  // Keeps the exponent of 2^k representable. The result underflows or
+  // overflows as a `float` well within these limits.
+  constexpr double kMaxExponent = 1000.0;
+  for (size_t t = 0; t < gains_db.size(); ++t) {
+    const double exponent =
+        std::clamp(static_cast<double>(gains_db[t]) * kLog2Of10Over20,
+                   -kMaxExponent, kMaxExponent);
+    const double k = (exponent + kRoundingConstant) - kRoundingConstant;
+    const double r = (exponent - k) * kLn2;
+    // Taylor series of e^r truncated after the r^9 term. |r| <= ln(2) / 2, so
+    // the truncation error is far below the precision of a `float`.
+    double exp_r = 1.0 / 362880.0;
+    exp_r = exp_r * r + 1.0 / 40320.0;
+    exp_r = exp_r * r + 1.0 / 5040.0;
+    exp_r = exp_r * r + 1.0 / 720.0;
+    exp_r = exp_r * r + 1.0 / 120.0;
+    exp_r = exp_r * r + 1.0 / 24.0;
+    exp_r = exp_r * r + 1.0 / 6.0;
+    exp_r = exp_r * r + 0.5;
+    exp_r = exp_r * r + 1.0;
+    exp_r = exp_r * r + 1.0;
+    const double two_to_the_k = std::bit_cast<double>(
+        static_cast<uint64_t>(static_cast<int64_t>(k) + 1023) << 52);
+    linear_gains[t] = static_cast<float>(exp_r * two_to_the_k);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace iamf_tools
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#ifndef COMMON_UTILS_MIXING_UTILS_H_
+#define COMMON_UTILS_MIXING_UTILS_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace iamf_tools {
+
+/*!\brief Kernels for mixing planar blocks of samples.
+ *
+ * All kernels operate on planar (channel, time) blocks of `double` samples.
+ * The implementation is selected once at runtime based on the CPU features
+ * (AVX-512, AVX2, SSE2, or NEON), with a portable scalar fallback. Every
+ * implementation vectorizes along the time axis and accumulates channels in
+ * the same order as the scalar fallback, so the results do not depend on which
+ * implementation is selected.
+ */
+
+/*!\brief Gets the name of the instruction set used by the mixing kernels.
+ *
+ * \return Name of the instruction set, e.g. "avx2" or "scalar".
+ */
+absl::string_view GetMixingKernelInstructionSet();
+
+/*!\brief Gets the instruction sets of the mixing kernels supported by the CPU.
+ *
+ * \return Names of the supported instruction sets, ordered from the one
+ *         selected by default to "scalar".
+ */
+std::vector<absl::string_view> GetSupportedMixingKernelInstructionSets();
+
+/*!\brief Overrides the instruction set used by the mixing kernels.
+ *
+ * Intended for tests and benchmarks which compare the implementations. Not
+ * safe to call while other threads are mixing.
+ *
+ * \param instruction_set Name of a supported instruction set.
+ * \return `absl::OkStatus()` on success. `absl::InvalidArgumentError()` if the
+ *         instruction set is not supported by the CPU.
+ */
+absl::Status SetMixingKernelInstructionSetForTesting(
+    absl::string_view instruction_set);
+
+/*!\brief Multiplies a gain matrix by a planar block of samples.
+ *
+ * Computes `output[o][t] = sum_i(gains[i * num_output_channels + o] *
+ * input[i][t])`, with the sum accumulated in increasing order of `i`. Gains
+ * which are exactly zero are skipped.
+ *
+ * \param input Input samples arranged in (channel, time) axes. All channels
+ *        must have the same number of ticks.
+ * \param gains Gain matrix of shape (# input channels, # output channels)
+ *        stored in row-major order.
+ * \param output Output samples arranged in (channel, time) axes. Each channel
+ *        must have the same number of ticks as the input. Must not alias the
+ *        input.
+ * \return `absl::OkStatus()` on success. `absl::InvalidArgumentError()` if the
+ *         shapes of the arguments are inconsistent.
+ */
+absl::Status MixSamplesWithGainMatrix(
+    absl::Span<const absl::Span<const double>> input,
+    absl::Span<const double> gains, absl::Span<const absl::Span<double>> output);
+
+/*!\brief Applies a gain per tick to a channel of samples in place.
+ *
+ * Computes `samples[t] *= gains[t]`.
+ *
+ * \param gains Linear gains to apply at each tick.
+ * \param samples Samples to apply the gains to.
+ * \return `absl::OkStatus()` on success. `absl::InvalidArgumentError()` if
+ *         there are fewer gains than samples.
+ */
+absl::Status ApplyGainsPerTick(absl::Span<const float> gains,
+                               absl::Span<double> samples);
+
+/*!\brief Sums several channels of samples.
+ *
+ * Computes `output[t] = sum_n(blocks[n][t])`, with the sum accumulated in
+ * increasing order of `n`. The output is all zeros when there are no blocks.
+ *
+ * \param blocks Channels to sum. All must have the same size as `output`.
+ * \param output Output summed samples.
+ * \return `absl::OkStatus()` on success. `absl::InvalidArgumentError()` if the
+ *         shapes of the arguments are inconsistent.
+ */
+absl::Status SumSamples(absl::Span<const absl::Span<const double>> blocks,
+                        absl::Span<double> output);
+
+/*!\brief Mixes channels with per-tick gains and applies an output gain.
+ *
+ * Computes `output[t] = output_gains[t] * sum_n(block_gains[n][t] *
+ * blocks[n][t])`, with the sum accumulated in increasing order of `n`. The
+ * output is produced in a single cache-blocked pass, and the result is
+ * identical to applying `ApplyGainsPerTick()` to each block, summing them with
+ * `SumSamples()`, then applying `ApplyGainsPerTick()` to the output.
+ *
+ * \param blocks Channels to mix. All must have the same size as `output`.
+ * \param block_gains Linear gains to apply at each tick of the corresponding
+ *        block. An empty span applies no gain to that block.
+ * \param output_gains Linear gains to apply at each tick of the output. An
+ *        empty span applies no gain to the output.
+ * \param output Output mixed samples. Must not alias any of the blocks.
+ * \return `absl::OkStatus()` on success. `absl::InvalidArgumentError()` if the
+ *         shapes of the arguments are inconsistent.
+ */
+absl::Status MixSamplesWithGainsPerTick(
+    absl::Span<const absl::Span<const double>> blocks,
+    absl::Span<const absl::Span<const float>> block_gains,
+    absl::Span<const float> output_gains, absl::Span<double> output);
+
+/*!\brief Converts gains in dB to linear gains.
+ *
+ * Computes `linear_gains[t] = 10^(gains_db[t] / 20)`. The conversion is
+ * branch-free so it vectorizes, and it is accurate to within one unit in the
+ * last place of the result.
+ *
+ * \param gains_db Gains in dB.
+ * \param linear_gains Output linear gains. May alias `gains_db`.
+ * \return `absl::OkStatus()` on success. `absl::InvalidArgumentError()` if the
+ *         arguments have different sizes.
+ */
+absl::Status ConvertDbToLinearGains(absl::Span<const float> gains_db,
+                                    absl::Span<float> linear_gains);
+
+}  // namespace iamf_tools
+
+#endif  // COMMON_UTILS_MIXING_UTILS_H_
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/common/utils/polyphase_resampler.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "absl/base/no_destructor.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "iamf/common/utils/filter_design_utils.h"
+#include "iamf/common/utils/macros.h"
+
+namespace iamf_tools {
+
+namespace {
+
+constexpr size_t kTapsPerPhase = PolyphaseResampler::kTapsPerPhase;
+constexpr size_t kNumHistoryTicks = kTapsPerPhase - 1;
+constexpr size_t kNumLookaheadTicks = kTapsPerPhase / 2;
+
+// Number of interleaved partial sums in the dot product.
+constexpr size_t kNumPartialSums = 4;
+static_assert(kTapsPerPhase % kNumPartialSums == 0);
+static_assert(kNumPartialSums == 4, "`DotProduct()` combines four sums.");
+
+// The passband ends at this fraction of the lower of the two Nyquist
+// frequencies. Together with `kKaiserBeta` (~80 dB of stopband attenuation),
+// this keeps the transition band below the lower Nyquist frequency.
+constexpr double kPassbandFraction = 0.9;
+constexpr double kKaiserBeta = 8.0;
+
+inline double DotProduct(const double* taps, const double* samples) {
+  double partial_sums[kNumPartialSums] = {};
+  for (size_t k = 0; k < kTapsPerPhase; k += kNumPartialSums) {
+    for (size_t j = 0; j < kNumPartialSums; ++j) {
+      partial_sums[j] += taps[k + j] * samples[k + j];
+    }
+  }
+  return (partial_sums[0] + partial_sums[2]) +
+         (partial_sums[1] + partial_sums[3]);
+}
+
+}  // namespace
+
+struct PolyphaseResampler::FilterBank {
+  // Interpolation factor, `L`. Also the number of phases.
+  uint32_t num_phases;
+
+  // Decimation factor, `M`.
+  uint32_t decimation;
+
+  // Taps of each phase, stored contiguously and in reverse order so that each
+  // phase is applied as a dot product with input samples in increasing time.
+  std::vector<double> taps;
+};
+
+namespace {
+
+std::shared_ptr<const PolyphaseResampler::FilterBank> CreateFilterBank(
+    uint32_t num_phases, uint32_t decimation) {
+  // Design the prototype filter at the upsampled rate `L * input_rate`.
+  const size_t num_taps = static_cast<size_t>(num_phases) * kTapsPerPhase;
+  const double center = static_cast<double>(num_taps) / 2.0;
+  const double cutoff = kPassbandFraction * 0.5 *
+                        static_cast<double>(std::min(num_phases, decimation)) /
+                        (static_cast<double>(num_phases) * decimation);
+
+  auto filter_bank = std::make_shared<PolyphaseResampler::FilterBank>();
+  filter_bank->num_phases = num_phases;
+  filter_bank->decimation = decimation;
+  filter_bank->taps.resize(num_taps);
+  for (uint32_t phase = 0; phase < num_phases; ++phase) {
+    double* phase_taps = &filter_bank->taps[phase * kTapsPerPhase];
+    double phase_sum = 0.0;
+    for (size_t k = 0; k < kTapsPerPhase; ++k) {
+      const double offset =
+          static_cast<double>(phase + k * num_phases) - center;
+      const double normalized_offset = offset / center;
+      const double window = KaiserWindow(normalized_offset, kKaiserBeta);
+      const double tap = 2.0 * cutoff * Sinc(2.0 * cutoff * offset) * window;
+      phase_taps[kTapsPerPhase - 1 - k] = tap;
+      phase_sum += tap;
+    }
+    // Normalize each phase to unity gain at DC. This also compensates for the
+    // zeros implicitly inserted when upsampling.
+    for (size_t k = 0; k < kTapsPerPhase; ++k) {
+      phase_taps[k] /= phase_sum;
+    }
+  }
+  return filter_bank;
+}
+
+std::shared_ptr<const PolyphaseResampler::FilterBank> GetFilterBank(
+    uint32_t num_phases, uint32_t decimation) {
+  static absl::NoDestructor<absl::Mutex> mutex;
+  static absl::NoDestructor<absl::flat_hash_map<
+      std::pair<uint32_t, uint32_t>,
+      std::shared_ptr<const PolyphaseResampler::FilterBank>>>
+      cache;
+
+  absl::MutexLock lock(mutex.get());
+  auto& filter_bank = (*cache)[{num_phases, decimation}];
+  if (filter_bank == nullptr) {
+    filter_bank = CreateFilterBank(num_phases, decimation);
+  }
+  return filter_bank;
+}
+
+}  // namespace
+
+absl::StatusOr<std::unique_ptr<PolyphaseResampler>> PolyphaseResampler::Create(
+    uint32_t input_sample_rate, uint32_t output_sample_rate,
+    size_t num_channels) {
+  if (input_sample_rate == 0 || output_sample_rate == 0) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Sample rates must be non-zero. input_sample_rate= ",
+                     input_sample_rate,
+                     " output_sample_rate= ", output_sample_rate));
+  }
+  if (num_channels == 0) {
+    return absl::InvalidArgumentError("Expected at least one channel.");
+  }
+  const uint32_t divisor = std::gcd(input_sample_rate, output_sample_rate);
+  const uint32_t num_phases = output_sample_rate / divisor;
+  const uint32_t decimation = input_sample_rate / divisor;
+  if (num_phases > kMaxNumPhases) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Unsupported ratio of sample rates ", output_sample_rate, " / ",
+        input_sample_rate, ". Expected at most ", kMaxNumPhases,
+        " phases, got ", num_phases, "."));
+  }
+
+  return absl::WrapUnique(new PolyphaseResampler(
+      GetFilterBank(num_phases, decimation), num_channels));
+}
+
+PolyphaseResampler::PolyphaseResampler(
+    std::shared_ptr<const FilterBank> filter_bank, size_t num_channels)
+    : filter_bank_(std::move(filter_bank)),
+      history_(num_channels, std::vector<double>(kNumHistoryTicks, 0.0)) {}
+
+PolyphaseResampler::~PolyphaseResampler() = default;
+
+size_t PolyphaseResampler::GetMaxOutputTicks(size_t num_input_ticks) const {
+  const size_t num_upsampled_ticks = num_input_ticks * filter_bank_->num_phases;
+  return (num_upsampled_ticks + filter_bank_->decimation - 1) /
+         filter_bank_->decimation;
+}
+
+absl::Status PolyphaseResampler::Process(
+    absl::Span<const absl::Span<const double>> input,
+    std::vector<std::vector<double>>& output) {
+  if (input.size() != history_.size()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Expected ", history_.size(), " channels, got ",
+                     input.size(), "."));
+  }
+  const size_t num_input_ticks = input.empty() ? 0 : input.front().size();
+  for (const auto& channel : input) {
+    if (channel.size() != num_input_ticks) {
+      return absl::InvalidArgumentError(
+          "Expected all channels to have the same number of ticks.");
+    }
+  }
+
+  // Find how many outputs are ready and where the next block will start.
+  const uint32_t num_phases = filter_bank_->num_phases;
+  const uint32_t decimation = filter_bank_->decimation;
+  size_t num_output_ticks = 0;
+  uint32_t end_phase = next_phase_;
+  size_t end_input_index = next_input_index_;
+  while (end_input_index < num_input_ticks) {
+    ++num_output_ticks;
+    end_phase += decimation;
+    end_input_index += end_phase / num_phases;
+    end_phase %= num_phases;
+  }
+
+  output.resize(input.size());
+  for (size_t c = 0; c < input.size(); ++c) {
+    // Append the block to the history, so every output reads its taps from
+    // contiguous samples.
+    auto& samples = history_[c];
+    samples.insert(samples.end(), input[c].begin(), input[c].end());
+
+    auto& output_channel = output[c];
+    output_channel.resize(num_output_ticks);
+    uint32_t phase = next_phase_;
+    size_t input_index = next_input_index_;
+    for (size_t t = 0; t < num_output_ticks; ++t) {
+      // The newest sample, `input[c][input_index]`, is at
+      // `samples[input_index + kNumHistoryTicks]`.
+      output_channel[t] =
+          DotProduct(&filter_bank_->taps[phase * kTapsPerPhase],
+                     &samples[input_index]);
+      phase += decimation;
+      input_index += phase / num_phases;
+      phase %= num_phases;
+    }
+
+    // Keep only the history needed by the next block.
+    std::copy(samples.end() - kNumHistoryTicks, samples.end(),
+              samples.begin());
+    samples.resize(kNumHistoryTicks);
+  }
+
+  next_phase_ = end_phase;
+  next_input_index_ = end_input_index - num_input_ticks;
+  num_input_ticks_ += num_input_ticks;
+  num_output_ticks_ += num_output_ticks;
+  return absl::OkStatus();
+}
+
+absl::Status PolyphaseResampler::Flush(
+    std::vector<std::vector<double>>& output) {
+  const uint64_t num_phases = filter_bank_->num_phases;
+  const uint64_t decimation = filter_bank_->decimation;
+  const uint64_t num_expected_output_ticks =
+      (num_input_ticks_ * num_phases + decimation - 1) / decimation;
+  const uint64_t num_remaining_output_ticks =
+      num_expected_output_ticks - num_output_ticks_;
+
+  // Feed silence through the look-ahead of the filter, then drop the outputs
+  // which lie entirely past the end of the stream.
+  const std::vector<double> silence(kNumLookaheadTicks, 0.0);
+  const std::vector<absl::Span<const double>> silent_block(
+      history_.size(), absl::MakeConstSpan(silence));
+  RETURN_IF_NOT_OK(Process(silent_block, output));
+  for (auto& output_channel : output) {
+    output_channel.resize(num_remaining_output_ticks);
+  }
+
+  // Reset the state for the next stream.
+  for (auto& samples : history_) {
+    std::fill(samples.begin(), samples.end(), 0.0);
+  }
+  next_phase_ = 0;
+  next_input_index_ = kNumLookaheadTicks;
+  num_input_ticks_ = 0;
+  num_output_ticks_ = 0;
+  return absl::OkStatus();
+}
+
+}  // namespace iamf_tools
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#ifndef COMMON_UTILS_POLYPHASE_RESAMPLER_H_
+#define COMMON_UTILS_POLYPHASE_RESAMPLER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+
+namespace iamf_tools {
+
+/*!\brief Streaming polyphase sample rate converter.
+ *
+ * Converts planar (channel, time) blocks of samples by the rational factor
+ * `L / M`, where `L / M` is `output_sample_rate / input_sample_rate` reduced to
+ * lowest terms. The anti-aliasing filter is a Kaiser-windowed sinc, decomposed
+ * into `L` phases of `kTapsPerPhase` taps each. Filter banks are computed once
+ * per pair of sample rates and shared by all resamplers of that pair.
+ *
+ * Each output sample is a dot product of one phase against contiguous input
+ * samples. The dot product accumulates in a fixed interleaved order, which
+ * lets it vectorize without changing the result between builds.
+ *
+ * State is carried across calls to `Process()`, so a stream may be converted
+ * in blocks of any size. The output is time-aligned with the input: output
+ * tick `t` corresponds to input time `t * M / L`. Because the filter looks
+ * ahead by `kTapsPerPhase / 2` input ticks, the outputs near the end of each
+ * block are held back until the next block arrives. Call `Flush()` at the end
+ * of the stream to output them; a stream of `N` input ticks then yields
+ * exactly `ceil(N * L / M)` output ticks.
+ */
+class PolyphaseResampler {
+ public:
+  /*!\brief Number of taps in each phase of the filter bank. */
+  static constexpr size_t kTapsPerPhase = 64;
+
+  /*!\brief Maximum number of phases, i.e. `L` in lowest terms. */
+  static constexpr uint32_t kMaxNumPhases = 1024;
+
+  /*!\brief Filter bank shared by all resamplers of a pair of sample rates. */
+  struct FilterBank;
+
+  /*!\brief Factory function.
+   *
+   * \param input_sample_rate Sample rate of the input.
+   * \param output_sample_rate Sample rate of the output.
+   * \param num_channels Number of channels to convert.
+   * \return Resampler on success. `absl::InvalidArgumentError()` if either rate
+   *         is zero, there are no channels, or the reduced ratio has more than
+   *         `kMaxNumPhases` phases.
+   */
+  static absl::StatusOr<std::unique_ptr<PolyphaseResampler>> Create(
+      uint32_t input_sample_rate, uint32_t output_sample_rate,
+      size_t num_channels);
+
+  ~PolyphaseResampler();
+
+  /*!\brief Gets the maximum number of output ticks for a block of input.
+   *
+   * \param num_input_ticks Number of input ticks in a call to `Process()`.
+   * \return Maximum number of ticks the call may output.
+   */
+  size_t GetMaxOutputTicks(size_t num_input_ticks) const;
+
+  /*!\brief Converts a block of samples.
+   *
+   * \param input Input samples arranged in (channel, time) axes. All channels
+   *        must have the same number of ticks.
+   * \param output Output samples arranged in (channel, time) axes. Resized to
+   *        hold the samples which are available after this block.
+   * \return `absl::OkStatus()` on success. `absl::InvalidArgumentError()` if
+   *         the shape of the input is inconsistent.
+   */
+  absl::Status Process(absl::Span<const absl::Span<const double>> input,
+                       std::vector<std::vector<double>>& output);
+
+  /*!\brief Outputs the remaining samples at the end of the stream.
+   *
+   * The resampler is reset afterwards, so it may convert a new stream.
+   *
+   * \param output Output samples arranged in (channel, time) axes. Resized to
+   *        hold the samples which were held back by the filter's look-ahead.
+   * \return `absl::OkStatus()` on success. A specific status on failure.
+   */
+  absl::Status Flush(std::vector<std::vector<double>>& output);
+
+ private:
+  /*!\brief Private constructor.
+   *
+   * Used only by the factory function.
+   *
+   * \param filter_bank Filter bank for the pair of sample rates.
+   * \param num_channels Number of channels to convert.
+   */
+  PolyphaseResampler(std::shared_ptr<const FilterBank> filter_bank,
+                     size_t num_channels);
+
+  std::shared_ptr<const FilterBank> filter_bank_;
+
+  // The last `kTapsPerPhase - 1` input samples of each channel, followed by
+  // room for the next block of input.
+  std::vector<std::vector<double>> history_;
+
+  // Phase of the next output sample.
+  uint32_t next_phase_ = 0;
+
+  // Index of the newest input sample used by the next output sample, relative
+  // to the start of the next block. The first output sample is centered on the
+  // first input sample, so it needs the look-ahead of the filter.
+  size_t next_input_index_ = kTapsPerPhase / 2;
+
+  // Total number of ticks consumed and output since the start of the stream.
+  uint64_t num_input_ticks_ = 0;
+  uint64_t num_output_ticks_ = 0;
+};
+
+}  // namespace iamf_tools
+
+#endif  // COMMON_UTILS_POLYPHASE_RESAMPLER_H_
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/common/utils/async_file_writer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/status_matchers.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace iamf_tools {
+namespace {
+
+using ::absl_testing::IsOk;
+using ::absl_testing::StatusIs;
+using ::testing::ElementsAreArray;
+using ::testing::IsEmpty;
+
+std::string GetCleanOutputFilename(const std::string& suffix) {
+  const auto filename =
+      (std::filesystem::path(::testing::TempDir()) / suffix).string();
+  std::filesystem::remove(filename);
+  return filename;
+}
+
+std::vector<uint8_t> ReadFile(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {});
+}
+
+TEST(Create, FailsWhenFileCannotBeOpened) {
+  const auto filename =
+      (std::filesystem::path(::testing::TempDir()) / "missing_dir" / "out.bin")
+          .string();
+
+  EXPECT_FALSE(AsyncFileWriter::Create(filename).ok());
+}
+
+TEST(Close, CreatesEmptyFileWhenNothingIsWritten) {
+  const auto filename = GetCleanOutputFilename("empty.bin");
+  auto writer = AsyncFileWriter::Create(filename);
+  ASSERT_THAT(writer, IsOk());
+
+  EXPECT_THAT((*writer)->Close(), IsOk());
+
+  EXPECT_TRUE(std::filesystem::exists(filename));
+  EXPECT_THAT(ReadFile(filename), IsEmpty());
+}
+
+TEST(Write, WritesDataInOrder) {
+  const auto filename = GetCleanOutputFilename("in_order.bin");
+  auto writer = AsyncFileWriter::Create(filename);
+  ASSERT_THAT(writer, IsOk());
+
+  EXPECT_THAT((*writer)->Write({1, 2, 3}), IsOk());
+  EXPECT_THAT((*writer)->Write({4, 5}), IsOk());
+  EXPECT_THAT((*writer)->Close(), IsOk());
+
+  EXPECT_THAT(ReadFile(filename), ElementsAreArray({1, 2, 3, 4, 5}));
+}
+
+TEST(Write, WritesDataAcrossManySmallStagingBuffers) {
+  const auto filename = GetCleanOutputFilename("small_buffers.bin");
+  // A tiny staging buffer forces most writes to span several buffers.
+  constexpr size_t kStagingBufferSize = 3;
+  auto writer = AsyncFileWriter::Create(filename, kStagingBufferSize);
+  ASSERT_THAT(writer, IsOk());
+  std::vector<uint8_t> expected_data;
+  for (int i = 0; i < 1000; ++i) {
+    const std::vector<uint8_t> data(i % 8, static_cast<uint8_t>(i));
+    EXPECT_THAT((*writer)->Write(data), IsOk());
+    expected_data.insert(expected_data.end(), data.begin(), data.end());
+  }
+  EXPECT_THAT((*writer)->Close(), IsOk());
+
+  EXPECT_THAT(ReadFile(filename), ElementsAreArray(expected_data));
+}
+
+TEST(Write, FailsAfterClose) {
+  const auto filename = GetCleanOutputFilename("after_close.bin");
+  auto writer = AsyncFileWriter::Create(filename);
+  ASSERT_THAT(writer, IsOk());
+  EXPECT_THAT((*writer)->Close(), IsOk());
+
+  EXPECT_THAT((*writer)->Write({1}),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+  EXPECT_THAT((*writer)->WriteAt(0, {1}),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+}
+
+TEST(Destructor, FinishesPendingWrites) {
+  const auto filename = GetCleanOutputFilename("destructor.bin");
+  {
+    auto writer = AsyncFileWriter::Create(filename);
+    ASSERT_THAT(writer, IsOk());
+    EXPECT_THAT((*writer)->Write({1, 2, 3}), IsOk());
+  }
+
+  EXPECT_THAT(ReadFile(filename), ElementsAreArray({1, 2, 3}));
+}
+
+TEST(WriteAt, OverwritesEarlierData) {
+  const auto filename = GetCleanOutputFilename("overwrite.bin");
+  auto writer = AsyncFileWriter::Create(filename);
+  ASSERT_THAT(writer, IsOk());
+  EXPECT_THAT((*writer)->Write({1, 2, 3, 4}), IsOk());
+
+  EXPECT_THAT((*writer)->WriteAt(1, {9, 9}), IsOk());
+  EXPECT_THAT((*writer)->Close(), IsOk());
+
+  EXPECT_THAT(ReadFile(filename), ElementsAreArray({1, 9, 9, 4}));
+}
+
+TEST(WriteAt, SubsequentWritesAppendToTheEnd) {
+  const auto filename = GetCleanOutputFilename("append_after.bin");
+  constexpr size_t kStagingBufferSize = 2;
+  auto writer = AsyncFileWriter::Create(filename, kStagingBufferSize);
+  ASSERT_THAT(writer, IsOk());
+  EXPECT_THAT((*writer)->Write({1, 2, 3}), IsOk());
+
+  EXPECT_THAT((*writer)->WriteAt(0, {7}), IsOk());
+  EXPECT_THAT((*writer)->Write({4, 5}), IsOk());
+  EXPECT_THAT((*writer)->Close(), IsOk());
+
+  EXPECT_THAT(ReadFile(filename), ElementsAreArray({7, 2, 3, 4, 5}));
+}
+
+TEST(WriteAt, InvalidPastTheDataWrittenSoFar) {
+  const auto filename = GetCleanOutputFilename("past_the_end.bin");
+  auto writer = AsyncFileWriter::Create(filename);
+  ASSERT_THAT(writer, IsOk());
+  EXPECT_THAT((*writer)->Write({1, 2, 3}), IsOk());
+
+  EXPECT_THAT((*writer)->WriteAt(2, {9, 9}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(WriteAt, InvalidForNegativeOffset) {
+  const auto filename = GetCleanOutputFilename("negative_offset.bin");
+  auto writer = AsyncFileWriter::Create(filename);
+  ASSERT_THAT(writer, IsOk());
+
+  EXPECT_THAT((*writer)->WriteAt(-1, {1}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+class WritePolicyTest
+    : public ::testing::TestWithParam<AsyncFileWriter::WritePolicy> {};
+
+TEST_P(WritePolicyTest, CreatesEmptyFileWhenNothingIsWritten) {
+  const auto filename = GetCleanOutputFilename("policy_empty.bin");
+  auto writer = AsyncFileWriter::Create(
+      filename, AsyncFileWriter::kDefaultStagingBufferSize, GetParam());
+  ASSERT_THAT(writer, IsOk());
+
+  EXPECT_THAT((*writer)->Close(), IsOk());
+
+  EXPECT_TRUE(std::filesystem::exists(filename));
+  EXPECT_THAT(ReadFile(filename), IsEmpty());
+}
+
+TEST_P(WritePolicyTest, WritesDataInOrderAndOverwritesTheStart) {
+  const auto filename = GetCleanOutputFilename("policy_in_order.bin");
+  // Lengths which are rarely a multiple of the staging buffer size, or of the
+  // block size of the storage.
+  constexpr size_t kStagingBufferSize = 5000;
+  auto writer =
+      AsyncFileWriter::Create(filename, kStagingBufferSize, GetParam());
+  ASSERT_THAT(writer, IsOk());
+  std::vector<uint8_t> expected_data;
+  for (int i = 0; i < 100; ++i) {
+    const std::vector<uint8_t> data(i * 37 % 1001, static_cast<uint8_t>(i));
+    EXPECT_THAT((*writer)->Write(data), IsOk());
+    expected_data.insert(expected_data.end(), data.begin(), data.end());
+  }
+
+  const std::vector<uint8_t> header(10, 255);
+  EXPECT_THAT((*writer)->WriteAt(0, header), IsOk());
+  std::copy(header.begin(), header.end(), expected_data.begin());
+  EXPECT_THAT((*writer)->Write({1, 2, 3}), IsOk());
+  expected_data.insert(expected_data.end(), {1, 2, 3});
+  EXPECT_THAT((*writer)->Close(), IsOk());
+
+  EXPECT_THAT(ReadFile(filename), ElementsAreArray(expected_data));
+}
+
+TEST_P(WritePolicyTest, OverwritesDataWhichIsStillBeingWritten) {
+  const auto filename = GetCleanOutputFilename("policy_overwrite.bin");
+  auto writer = AsyncFileWriter::Create(filename, /*staging_buffer_size=*/4096,
+                                        GetParam());
+  ASSERT_THAT(writer, IsOk());
+  std::vector<uint8_t> expected_data(10000, 1);
+  EXPECT_THAT((*writer)->Write(expected_data), IsOk());
+
+  // Overwrite a range which spans whole blocks and the incomplete last block.
+  const std::vector<uint8_t> data(3000, 2);
+  EXPECT_THAT((*writer)->WriteAt(7000, data), IsOk());
+  std::copy(data.begin(), data.end(), expected_data.begin() + 7000);
+  EXPECT_THAT((*writer)->Close(), IsOk());
+
+  EXPECT_THAT(ReadFile(filename), ElementsAreArray(expected_data));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AllWritePolicies, WritePolicyTest,
+    ::testing::Values(AsyncFileWriter::WritePolicy::kBuffered,
+                      AsyncFileWriter::WritePolicy::kSynchronized,
+                      AsyncFileWriter::WritePolicy::kDirect));
+
+}  // namespace
+}  // namespace iamf_tools
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/common/utils/bounded_queue.h"
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace iamf_tools {
+namespace {
+
+using ::testing::ElementsAreArray;
+using ::testing::Optional;
+
+TEST(BoundedQueue, PopsItemsInOrder) {
+  BoundedQueue<int> queue(3);
+
+  EXPECT_TRUE(queue.Push(1));
+  EXPECT_TRUE(queue.Push(2));
+  EXPECT_TRUE(queue.Push(3));
+
+  EXPECT_THAT(queue.Pop(), Optional(1));
+  EXPECT_THAT(queue.Pop(), Optional(2));
+  EXPECT_THAT(queue.Pop(), Optional(3));
+}
+
+TEST(BoundedQueue, SupportsMoveOnlyItems) {
+  BoundedQueue<std::unique_ptr<int>> queue(1);
+
+  EXPECT_TRUE(queue.Push(std::make_unique<int>(7)));
+
+  const auto item = queue.Pop();
+  ASSERT_TRUE(item.has_value());
+  EXPECT_EQ(**item, 7);
+}
+
+TEST(Close, DrainsRemainingItemsThenReturnsNullopt) {
+  BoundedQueue<int> queue(2);
+  EXPECT_TRUE(queue.Push(1));
+
+  queue.Close();
+
+  EXPECT_THAT(queue.Pop(), Optional(1));
+  EXPECT_EQ(queue.Pop(), std::nullopt);
+}
+
+TEST(Close, RejectsFurtherPushes) {
+  BoundedQueue<int> queue(2);
+
+  queue.Close();
+
+  EXPECT_FALSE(queue.Push(1));
+  EXPECT_EQ(queue.Pop(), std::nullopt);
+}
+
+TEST(Close, WakesABlockedProducer) {
+  BoundedQueue<int> queue(1);
+  EXPECT_TRUE(queue.Push(1));
+  std::atomic<bool> pushed = true;
+
+  std::thread producer([&] { pushed = queue.Push(2); });
+  queue.Close();
+  producer.join();
+
+  EXPECT_FALSE(pushed);
+}
+
+TEST(BoundedQueue, TransfersAllItemsBetweenThreads) {
+  // A small capacity forces the producer to wait for the consumer.
+  BoundedQueue<int> queue(2);
+  constexpr int kNumItems = 1000;
+  std::vector<int> expected_items;
+  for (int i = 0; i < kNumItems; ++i) {
+    expected_items.push_back(i);
+  }
+
+  std::thread producer([&] {
+    for (const int item : expected_items) {
+      ASSERT_TRUE(queue.Push(item));
+    }
+    queue.Close();
+  });
+  std::vector<int> popped_items;
+  while (const auto item = queue.Pop()) {
+    popped_items.push_back(*item);
+  }
+  producer.join();
+
+  EXPECT_THAT(popped_items, ElementsAreArray(expected_items));
+}
+
+}  // namespace
+}  // namespace iamf_tools
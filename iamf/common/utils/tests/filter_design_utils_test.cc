@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/common/utils/filter_design_utils.h"
+
+#include <numbers>
+
+#include "gtest/gtest.h"
+
+namespace iamf_tools {
+namespace {
+
+TEST(BesselI0, IsOneAtZero) { EXPECT_DOUBLE_EQ(BesselI0(0.0), 1.0); }
+
+TEST(BesselI0, MatchesReferenceValues) {
+  EXPECT_NEAR(BesselI0(1.0), 1.2660658777520082, 1e-12);
+  EXPECT_NEAR(BesselI0(5.0), 27.239871823604442, 1e-10);
+  EXPECT_NEAR(BesselI0(8.0), 427.56411572180474, 1e-9);
+}
+
+TEST(BesselI0, IsEven) { EXPECT_DOUBLE_EQ(BesselI0(-3.0), BesselI0(3.0)); }
+
+TEST(Sinc, IsOneAtZero) { EXPECT_DOUBLE_EQ(Sinc(0.0), 1.0); }
+
+TEST(Sinc, IsZeroAtNonZeroIntegers) {
+  for (const double x : {-3.0, -2.0, -1.0, 1.0, 2.0, 3.0}) {
+    EXPECT_NEAR(Sinc(x), 0.0, 1e-15);
+  }
+}
+
+TEST(Sinc, MatchesTheDefinition) {
+  EXPECT_DOUBLE_EQ(Sinc(0.5), 2.0 / std::numbers::pi);
+}
+
+TEST(KaiserWindow, IsOneAtTheCenter) {
+  EXPECT_DOUBLE_EQ(KaiserWindow(0.0, 8.0), 1.0);
+}
+
+TEST(KaiserWindow, IsSymmetric) {
+  EXPECT_DOUBLE_EQ(KaiserWindow(-0.3, 5.0), KaiserWindow(0.3, 5.0));
+}
+
+TEST(KaiserWindow, IsTheInverseOfBesselI0OfBetaAtTheEdges) {
+  EXPECT_DOUBLE_EQ(KaiserWindow(1.0, 8.0), 1.0 / BesselI0(8.0));
+  EXPECT_DOUBLE_EQ(KaiserWindow(-1.0, 8.0), 1.0 / BesselI0(8.0));
+}
+
+TEST(KaiserWindow, TreatsOffsetsPastTheEdgesAsTheEdges) {
+  EXPECT_DOUBLE_EQ(KaiserWindow(1.0 + 1e-12, 8.0), KaiserWindow(1.0, 8.0));
+}
+
+TEST(KaiserWindow, IsRectangularWhenBetaIsZero) {
+  EXPECT_DOUBLE_EQ(KaiserWindow(0.7, 0.0), 1.0);
+}
+
+}  // namespace
+}  // namespace iamf_tools
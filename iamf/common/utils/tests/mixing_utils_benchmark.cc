@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/random/random.h"
+#include "absl/types/span.h"
+#include "benchmark/benchmark.h"
+#include "iamf/common/utils/mixing_utils.h"
+
+namespace iamf_tools {
+namespace {
+
+std::vector<std::vector<double>> CreateRandomChannels(int num_channels,
+                                                      int num_ticks) {
+  absl::BitGen gen;
+  std::vector<std::vector<double>> channels(num_channels,
+                                            std::vector<double>(num_ticks));
+  for (auto& channel : channels) {
+    for (auto& sample : channel) {
+      sample = absl::Uniform<double>(gen, -1.0, 1.0);
+    }
+  }
+  return channels;
+}
+
+// Reports the rate of floating-point operations, counting a multiply and an
+// add as two operations.
+void SetFlopsCounter(benchmark::State& state, double flops_per_iteration) {
+  state.counters["FLOPS"] = benchmark::Counter(
+      flops_per_iteration, benchmark::Counter::kIsIterationInvariantRate,
+      benchmark::Counter::kIs1000);
+  state.SetLabel(std::string(GetMixingKernelInstructionSet()));
+}
+
+static void BM_MixSamplesWithGainMatrix(benchmark::State& state) {
+  const int num_input_channels = state.range(0);
+  const int num_output_channels = state.range(1);
+  const int num_ticks = state.range(2);
+
+  const auto input = CreateRandomChannels(num_input_channels, num_ticks);
+  const std::vector<absl::Span<const double>> input_spans(input.begin(),
+                                                          input.end());
+  // Use a dense gain matrix to measure the worst case.
+  absl::BitGen gen;
+  std::vector<double> gains(num_input_channels * num_output_channels);
+  for (auto& gain : gains) {
+    gain = absl::Uniform<double>(gen, 0.1, 1.0);
+  }
+  auto output = CreateRandomChannels(num_output_channels, num_ticks);
+  const std::vector<absl::Span<double>> output_spans(output.begin(),
+                                                     output.end());
+
+  for (auto _ : state) {
+    ABSL_CHECK_OK(MixSamplesWithGainMatrix(input_spans, gains, output_spans));
+    benchmark::DoNotOptimize(output.front().data());
+  }
+  SetFlopsCounter(state, 2.0 * num_input_channels * num_output_channels *
+                             num_ticks);
+}
+
+// Benchmark various combinations of (#input channels, #output channels,
+// #ticks), e.g. 7.1.4 to stereo, 3OA projection, and 9.1.6 to 7.1.4.
+BENCHMARK(BM_MixSamplesWithGainMatrix)
+    ->Args({12, 2, 960})
+    ->Args({16, 16, 960})
+    ->Args({16, 12, 960})
+    ->Args({16, 16, 4096});
+
+static void BM_ApplyGainsPerTick(benchmark::State& state) {
+  const int num_ticks = state.range(0);
+
+  auto samples = CreateRandomChannels(1, num_ticks);
+  const std::vector<float> gains(num_ticks, 1.0f);
+
+  for (auto _ : state) {
+    ABSL_CHECK_OK(ApplyGainsPerTick(gains, absl::MakeSpan(samples.front())));
+    benchmark::DoNotOptimize(samples.front().data());
+  }
+  SetFlopsCounter(state, num_ticks);
+}
+
+BENCHMARK(BM_ApplyGainsPerTick)->Arg(960)->Arg(4096);
+
+static void BM_SumSamples(benchmark::State& state) {
+  const int num_blocks = state.range(0);
+  const int num_ticks = state.range(1);
+
+  const auto blocks = CreateRandomChannels(num_blocks, num_ticks);
+  const std::vector<absl::Span<const double>> block_spans(blocks.begin(),
+                                                          blocks.end());
+  std::vector<double> output(num_ticks);
+
+  for (auto _ : state) {
+    ABSL_CHECK_OK(SumSamples(block_spans, absl::MakeSpan(output)));
+    benchmark::DoNotOptimize(output.data());
+  }
+  SetFlopsCounter(state, static_cast<double>(num_blocks) * num_ticks);
+}
+
+BENCHMARK(BM_SumSamples)->Args({2, 960})->Args({4, 960})->Args({8, 4096});
+
+static void BM_MixSamplesWithGainsPerTick(benchmark::State& state) {
+  const int num_blocks = state.range(0);
+  const int num_ticks = state.range(1);
+
+  const auto blocks = CreateRandomChannels(num_blocks, num_ticks);
+  const std::vector<absl::Span<const double>> block_spans(blocks.begin(),
+                                                          blocks.end());
+  const std::vector<float> gains(num_ticks, 0.5f);
+  const std::vector<absl::Span<const float>> block_gains(num_blocks, gains);
+  std::vector<double> output(num_ticks);
+
+  for (auto _ : state) {
+    ABSL_CHECK_OK(MixSamplesWithGainsPerTick(block_spans, block_gains, gains,
+                                             absl::MakeSpan(output)));
+    benchmark::DoNotOptimize(output.data());
+  }
+  SetFlopsCounter(state, (2.0 * num_blocks + 1) * num_ticks);
+}
+
+BENCHMARK(BM_MixSamplesWithGainsPerTick)
+    ->Args({2, 960})
+    ->Args({4, 960})
+    ->Args({8, 4096});
+
+static void BM_ConvertDbToLinearGains(benchmark::State& state) {
+  const int num_ticks = state.range(0);
+
+  absl::BitGen gen;
+  std::vector<float> gains_db(num_ticks);
+  for (auto& gain_db : gains_db) {
+    gain_db = absl::Uniform<float>(gen, -60.0f, 12.0f);
+  }
+  std::vector<float> linear_gains(num_ticks);
+
+  for (auto _ : state) {
+    ABSL_CHECK_OK(
+        ConvertDbToLinearGains(gains_db, absl::MakeSpan(linear_gains)));
+    benchmark::DoNotOptimize(linear_gains.data());
+  }
+}
+
+BENCHMARK(BM_ConvertDbToLinearGains)->Arg(960)->Arg(4096);
+
+}  // namespace
+}  // namespace iamf_tools
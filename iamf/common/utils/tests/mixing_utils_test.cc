@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/common/utils/mixing_utils.h"
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/status_matchers.h"
+#include "absl/types/span.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace iamf_tools {
+namespace {
+
+using ::absl_testing::IsOk;
+using ::absl_testing::StatusIs;
+using ::testing::DoubleEq;
+using ::testing::Each;
+using ::testing::ElementsAre;
+using ::testing::Pointwise;
+
+// Lengths which exercise full tiles, full vectors, and scalar tails.
+constexpr size_t kNumTicksToTest[] = {0, 1, 3, 4, 7, 8, 17, 255, 256, 1001};
+
+std::vector<double> MakeRamp(size_t num_ticks, double start, double step) {
+  std::vector<double> ramp(num_ticks);
+  for (size_t t = 0; t < num_ticks; ++t) {
+    ramp[t] = start + step * static_cast<double>(t);
+  }
+  return ramp;
+}
+
+std::vector<absl::Span<const double>> MakeConstSpans(
+    const std::vector<std::vector<double>>& channels) {
+  return std::vector<absl::Span<const double>>(channels.begin(),
+                                               channels.end());
+}
+
+std::vector<absl::Span<double>> MakeSpans(
+    std::vector<std::vector<double>>& channels) {
+  return std::vector<absl::Span<double>>(channels.begin(), channels.end());
+}
+
+std::vector<float> MakeGainRamp(size_t num_ticks, float start, float step) {
+  std::vector<float> gains(num_ticks);
+  for (size_t t = 0; t < num_ticks; ++t) {
+    gains[t] = start + step * static_cast<float>(t);
+  }
+  return gains;
+}
+
+TEST(GetMixingKernelInstructionSet, IsNotEmpty) {
+  EXPECT_FALSE(GetMixingKernelInstructionSet().empty());
+}
+
+TEST(GetSupportedMixingKernelInstructionSets, StartsWithTheSelectedOne) {
+  const auto instruction_sets = GetSupportedMixingKernelInstructionSets();
+
+  ASSERT_FALSE(instruction_sets.empty());
+  EXPECT_EQ(instruction_sets.front(), GetMixingKernelInstructionSet());
+  EXPECT_EQ(instruction_sets.back(), "scalar");
+}
+
+TEST(SetMixingKernelInstructionSetForTesting, InvalidForUnknownName) {
+  EXPECT_THAT(SetMixingKernelInstructionSetForTesting("mmx"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+// Runs every mixing function with the selected kernels, and returns all of
+// their outputs concatenated.
+std::vector<double> MixWithAllFunctions(size_t num_ticks) {
+  // Values with many significant bits, where fused multiply-adds would round
+  // differently.
+  std::vector<std::vector<double>> blocks;
+  std::vector<std::vector<float>> gains;
+  for (int n = 0; n < 5; ++n) {
+    blocks.push_back(MakeRamp(num_ticks, 0.1 * (n + 1), 1.0 / (3.0 + n)));
+    gains.push_back(MakeGainRamp(num_ticks, 0.7f / (n + 1), 1.0f / 7.0f));
+  }
+  std::vector<double> all_outputs;
+
+  // A dense 5x3 gain matrix, so each output sums several taps.
+  std::vector<double> gain_matrix;
+  for (int i = 0; i < 5 * 3; ++i) {
+    gain_matrix.push_back(1.0 / (i + 1.3));
+  }
+  std::vector<std::vector<double>> matrix_output(
+      3, std::vector<double>(num_ticks));
+  EXPECT_THAT(MixSamplesWithGainMatrix(MakeConstSpans(blocks), gain_matrix,
+                                       MakeSpans(matrix_output)),
+              IsOk());
+  for (const auto& channel : matrix_output) {
+    all_outputs.insert(all_outputs.end(), channel.begin(), channel.end());
+  }
+
+  std::vector<double> gained = blocks[0];
+  EXPECT_THAT(ApplyGainsPerTick(gains[0], absl::MakeSpan(gained)), IsOk());
+  all_outputs.insert(all_outputs.end(), gained.begin(), gained.end());
+
+  std::vector<double> sum(num_ticks);
+  EXPECT_THAT(SumSamples(MakeConstSpans(blocks), absl::MakeSpan(sum)), IsOk());
+  all_outputs.insert(all_outputs.end(), sum.begin(), sum.end());
+
+  const std::vector<absl::Span<const float>> block_gains(gains.begin(),
+                                                         gains.end());
+  std::vector<double> mix(num_ticks);
+  EXPECT_THAT(MixSamplesWithGainsPerTick(MakeConstSpans(blocks), block_gains,
+                                         gains[1], absl::MakeSpan(mix)),
+              IsOk());
+  all_outputs.insert(all_outputs.end(), mix.begin(), mix.end());
+  return all_outputs;
+}
+
+TEST(MixingKernels, AllInstructionSetsGiveIdenticalResults) {
+  const auto default_instruction_set = GetMixingKernelInstructionSet();
+  for (const size_t num_ticks : kNumTicksToTest) {
+    ASSERT_THAT(SetMixingKernelInstructionSetForTesting("scalar"), IsOk());
+    const auto expected = MixWithAllFunctions(num_ticks);
+
+    for (const auto instruction_set :
+         GetSupportedMixingKernelInstructionSets()) {
+      ASSERT_THAT(SetMixingKernelInstructionSetForTesting(instruction_set),
+                  IsOk());
+
+      // Compare exactly, not within a tolerance.
+      EXPECT_EQ(MixWithAllFunctions(num_ticks), expected)
+          << "instruction_set= " << instruction_set
+          << " num_ticks= " << num_ticks;
+    }
+  }
+  EXPECT_THAT(SetMixingKernelInstructionSetForTesting(default_instruction_set),
+              IsOk());
+}
+
+TEST(MixSamplesWithGainMatrix, MatchesReferenceTripleLoop) {
+  constexpr size_t kNumInputChannels = 3;
+  constexpr size_t kNumOutputChannels = 2;
+  // Includes zero gains, which are skipped by the implementation.
+  const std::vector<double> kGains = {0.5, 0.0,   // Input channel 0.
+                                      0.0, -1.0,  // Input channel 1.
+                                      0.25, 2.0};  // Input channel 2.
+  for (const size_t num_ticks : kNumTicksToTest) {
+    std::vector<std::vector<double>> input;
+    for (size_t i = 0; i < kNumInputChannels; ++i) {
+      input.push_back(MakeRamp(num_ticks, 0.1 * i, 0.001 * (i + 1)));
+    }
+    std::vector<std::vector<double>> output(kNumOutputChannels,
+                                            std::vector<double>(num_ticks));
+
+    EXPECT_THAT(MixSamplesWithGainMatrix(MakeConstSpans(input), kGains,
+                                         MakeSpans(output)),
+                IsOk());
+
+    for (size_t o = 0; o < kNumOutputChannels; ++o) {
+      std::vector<double> expected(num_ticks, 0.0);
+      for (size_t i = 0; i < kNumInputChannels; ++i) {
+        for (size_t t = 0; t < num_ticks; ++t) {
+          expected[t] += input[i][t] * kGains[i * kNumOutputChannels + o];
+        }
+      }
+      EXPECT_THAT(output[o], Pointwise(DoubleEq(), expected));
+    }
+  }
+}
+
+TEST(MixSamplesWithGainMatrix, OutputsZerosForAllZeroColumn) {
+  const std::vector<std::vector<double>> input = {MakeRamp(9, 1.0, 1.0)};
+  std::vector<std::vector<double>> output(1, std::vector<double>(9, 123.0));
+
+  EXPECT_THAT(
+      MixSamplesWithGainMatrix(MakeConstSpans(input), {0.0}, MakeSpans(output)),
+      IsOk());
+
+  EXPECT_THAT(output[0], Each(0.0));
+}
+
+TEST(MixSamplesWithGainMatrix, InvalidWhenGainMatrixHasWrongShape) {
+  const std::vector<std::vector<double>> input(2, std::vector<double>(4));
+  std::vector<std::vector<double>> output(2, std::vector<double>(4));
+
+  EXPECT_THAT(MixSamplesWithGainMatrix(MakeConstSpans(input), {1.0, 0.0, 1.0},
+                                       MakeSpans(output)),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(MixSamplesWithGainMatrix, InvalidWhenChannelsHaveDifferentNumTicks) {
+  const std::vector<std::vector<double>> input = {std::vector<double>(4),
+                                                  std::vector<double>(3)};
+  std::vector<std::vector<double>> output(1, std::vector<double>(4));
+
+  EXPECT_THAT(MixSamplesWithGainMatrix(MakeConstSpans(input), {1.0, 1.0},
+                                       MakeSpans(output)),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(ApplyGainsPerTick, MultipliesEachTick) {
+  for (const size_t num_ticks : kNumTicksToTest) {
+    std::vector<double> samples = MakeRamp(num_ticks, -1.0, 0.01);
+    std::vector<float> gains(num_ticks);
+    for (size_t t = 0; t < num_ticks; ++t) {
+      gains[t] = 0.5f + 0.001f * static_cast<float>(t);
+    }
+    std::vector<double> expected = samples;
+    for (size_t t = 0; t < num_ticks; ++t) {
+      expected[t] *= gains[t];
+    }
+
+    EXPECT_THAT(ApplyGainsPerTick(gains, absl::MakeSpan(samples)), IsOk());
+
+    EXPECT_THAT(samples, Pointwise(DoubleEq(), expected));
+  }
+}
+
+TEST(ApplyGainsPerTick, IgnoresExtraGains) {
+  std::vector<double> samples = {1.0, 2.0};
+
+  EXPECT_THAT(ApplyGainsPerTick({2.0f, 3.0f, 4.0f}, absl::MakeSpan(samples)),
+              IsOk());
+
+  EXPECT_THAT(samples, ElementsAre(2.0, 6.0));
+}
+
+TEST(ApplyGainsPerTick, InvalidWithTooFewGains) {
+  std::vector<double> samples = {1.0, 2.0};
+
+  EXPECT_THAT(ApplyGainsPerTick({2.0f}, absl::MakeSpan(samples)),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(SumSamples, SumsAllBlocks) {
+  for (const size_t num_ticks : kNumTicksToTest) {
+    const std::vector<std::vector<double>> blocks = {
+        MakeRamp(num_ticks, 0.0, 1.0), MakeRamp(num_ticks, 0.5, -0.25),
+        MakeRamp(num_ticks, -3.0, 0.125)};
+    std::vector<double> output(num_ticks, 99.0);
+    std::vector<double> expected(num_ticks, 0.0);
+    for (const auto& block : blocks) {
+      for (size_t t = 0; t < num_ticks; ++t) {
+        expected[t] += block[t];
+      }
+    }
+
+    EXPECT_THAT(SumSamples(MakeConstSpans(blocks), absl::MakeSpan(output)),
+                IsOk());
+
+    EXPECT_THAT(output, Pointwise(DoubleEq(), expected));
+  }
+}
+
+TEST(SumSamples, OutputsZerosWithNoBlocks) {
+  std::vector<double> output(5, 99.0);
+
+  EXPECT_THAT(SumSamples({}, absl::MakeSpan(output)), IsOk());
+
+  EXPECT_THAT(output, Each(0.0));
+}
+
+TEST(SumSamples, InvalidWhenBlockHasWrongNumTicks) {
+  const std::vector<std::vector<double>> blocks = {std::vector<double>(3)};
+  std::vector<double> output(4);
+
+  EXPECT_THAT(SumSamples(MakeConstSpans(blocks), absl::MakeSpan(output)),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(MixSamplesWithGainsPerTick, MatchesSeparateGainAndSumPasses) {
+  for (const size_t num_ticks : kNumTicksToTest) {
+    const std::vector<std::vector<double>> blocks = {
+        MakeRamp(num_ticks, 0.0, 0.5), MakeRamp(num_ticks, 0.5, -0.25),
+        MakeRamp(num_ticks, -3.0, 0.125)};
+    // The second block has no gains.
+    const std::vector<std::vector<float>> block_gains = {
+        MakeGainRamp(num_ticks, 0.5f, 0.001f), {},
+        MakeGainRamp(num_ticks, 2.0f, -0.002f)};
+    const auto output_gains = MakeGainRamp(num_ticks, 0.25f, 0.003f);
+
+    // Compute the expected output with separate passes.
+    std::vector<std::vector<double>> gained_blocks = blocks;
+    for (size_t n = 0; n < blocks.size(); ++n) {
+      if (!block_gains[n].empty()) {
+        EXPECT_THAT(
+            ApplyGainsPerTick(block_gains[n], absl::MakeSpan(gained_blocks[n])),
+            IsOk());
+      }
+    }
+    std::vector<double> expected(num_ticks);
+    EXPECT_THAT(
+        SumSamples(MakeConstSpans(gained_blocks), absl::MakeSpan(expected)),
+        IsOk());
+    EXPECT_THAT(ApplyGainsPerTick(output_gains, absl::MakeSpan(expected)),
+                IsOk());
+
+    const std::vector<absl::Span<const float>> block_gain_spans(
+        block_gains.begin(), block_gains.end());
+    std::vector<double> output(num_ticks, 99.0);
+    EXPECT_THAT(MixSamplesWithGainsPerTick(MakeConstSpans(blocks),
+                                           block_gain_spans, output_gains,
+                                           absl::MakeSpan(output)),
+                IsOk());
+
+    EXPECT_THAT(output, Pointwise(DoubleEq(), expected));
+  }
+}
+
+TEST(MixSamplesWithGainsPerTick, SumsBlocksWithoutAnyGains) {
+  const std::vector<std::vector<double>> blocks = {{1.0, 2.0}, {10.0, 20.0}};
+  const std::vector<absl::Span<const float>> no_block_gains(2);
+  std::vector<double> output(2);
+
+  EXPECT_THAT(MixSamplesWithGainsPerTick(MakeConstSpans(blocks),
+                                         no_block_gains, {},
+                                         absl::MakeSpan(output)),
+              IsOk());
+
+  EXPECT_THAT(output, ElementsAre(11.0, 22.0));
+}
+
+TEST(MixSamplesWithGainsPerTick, InvalidWhenNumBlockGainsDiffers) {
+  const std::vector<std::vector<double>> blocks = {{1.0, 2.0}, {10.0, 20.0}};
+  const std::vector<absl::Span<const float>> block_gains(1);
+  std::vector<double> output(2);
+
+  EXPECT_THAT(
+      MixSamplesWithGainsPerTick(MakeConstSpans(blocks), block_gains, {},
+                                 absl::MakeSpan(output)),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(MixSamplesWithGainsPerTick, InvalidWithTooFewGains) {
+  const std::vector<std::vector<double>> blocks = {{1.0, 2.0}};
+  const std::vector<float> too_few_gains = {1.0f};
+  const std::vector<absl::Span<const float>> block_gains = {too_few_gains};
+  const std::vector<absl::Span<const float>> no_block_gains(1);
+  std::vector<double> output(2);
+
+  EXPECT_THAT(
+      MixSamplesWithGainsPerTick(MakeConstSpans(blocks), block_gains, {},
+                                 absl::MakeSpan(output)),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(
+      MixSamplesWithGainsPerTick(MakeConstSpans(blocks), no_block_gains,
+                                 too_few_gains, absl::MakeSpan(output)),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(MixSamplesWithGainsPerTick, InvalidWhenBlockHasWrongNumTicks) {
+  const std::vector<std::vector<double>> blocks = {std::vector<double>(3)};
+  const std::vector<absl::Span<const float>> no_block_gains(1);
+  std::vector<double> output(4);
+
+  EXPECT_THAT(
+      MixSamplesWithGainsPerTick(MakeConstSpans(blocks), no_block_gains, {},
+                                 absl::MakeSpan(output)),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(ConvertDbToLinearGains, IsWithinOneUlpOfPowForAllQ7_8Values) {
+  // Every Q7.8 value, covering the full range of mix gains.
+  std::vector<float> gains_db;
+  for (int q7_8 = -32768; q7_8 <= 32767; ++q7_8) {
+    gains_db.push_back(static_cast<float>(q7_8) / 256.0f);
+  }
+  std::vector<float> linear_gains(gains_db.size());
+
+  EXPECT_THAT(ConvertDbToLinearGains(gains_db, absl::MakeSpan(linear_gains)),
+              IsOk());
+
+  for (size_t t = 0; t < gains_db.size(); ++t) {
+    const float expected = static_cast<float>(
+        std::pow(10.0, static_cast<double>(gains_db[t]) / 20.0));
+    // All gains are positive and normal, so adjacent floats have adjacent bit
+    // patterns.
+    const int32_t ulp_distance = std::bit_cast<int32_t>(linear_gains[t]) -
+                                 std::bit_cast<int32_t>(expected);
+    EXPECT_LE(std::abs(ulp_distance), 1)
+        << "gains_db[t]= " << gains_db[t] << " expected= " << expected
+        << " actual= " << linear_gains[t];
+  }
+}
+
+TEST(ConvertDbToLinearGains, ZeroDbIsExactlyUnity) {
+  std::vector<float> gains = {0.0f, 0.0f, 0.0f};
+
+  EXPECT_THAT(ConvertDbToLinearGains(gains, absl::MakeSpan(gains)), IsOk());
+
+  EXPECT_THAT(gains, Each(1.0f));
+}
+
+TEST(ConvertDbToLinearGains, InvalidWhenSizesDiffer) {
+  std::vector<float> linear_gains(2);
+
+  EXPECT_THAT(ConvertDbToLinearGains({0.0f}, absl::MakeSpan(linear_gains)),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace iamf_tools
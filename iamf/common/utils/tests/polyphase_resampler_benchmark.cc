@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/random/random.h"
+#include "absl/types/span.h"
+#include "benchmark/benchmark.h"
+#include "iamf/common/utils/polyphase_resampler.h"
+
+namespace iamf_tools {
+namespace {
+
+static void BM_PolyphaseResampler(benchmark::State& state) {
+  const int input_sample_rate = state.range(0);
+  const int output_sample_rate = state.range(1);
+  const int num_channels = state.range(2);
+  const int num_ticks = state.range(3);
+
+  absl::BitGen gen;
+  std::vector<std::vector<double>> input(num_channels,
+                                         std::vector<double>(num_ticks));
+  for (auto& channel : input) {
+    for (auto& sample : channel) {
+      sample = absl::Uniform<double>(gen, -1.0, 1.0);
+    }
+  }
+  const std::vector<absl::Span<const double>> input_spans(input.begin(),
+                                                          input.end());
+  auto resampler = PolyphaseResampler::Create(
+      input_sample_rate, output_sample_rate, num_channels);
+  ABSL_CHECK_OK(resampler);
+  std::vector<std::vector<double>> output;
+
+  for (auto _ : state) {
+    ABSL_CHECK_OK((*resampler)->Process(input_spans, output));
+    benchmark::DoNotOptimize(output.front().data());
+  }
+  // Report throughput in input samples, summed over all channels.
+  state.SetItemsProcessed(state.iterations() * num_channels * num_ticks);
+}
+
+// Benchmark various combinations of (input sample rate, output sample rate,
+// #channels, #ticks), e.g. device output at 44.1 kHz and wideband speech
+// upsampled to 48 kHz.
+BENCHMARK(BM_PolyphaseResampler)
+    ->Args({48000, 44100, 2, 960})
+    ->Args({48000, 44100, 12, 960})
+    ->Args({16000, 48000, 2, 320})
+    ->Args({16000, 48000, 12, 320});
+
+}  // namespace
+}  // namespace iamf_tools
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/common/utils/polyphase_resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <iterator>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/status_matchers.h"
+#include "absl/types/span.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace iamf_tools {
+namespace {
+
+using ::absl_testing::IsOk;
+using ::absl_testing::StatusIs;
+using ::testing::DoubleEq;
+using ::testing::Each;
+using ::testing::Not;
+using ::testing::Pointwise;
+
+constexpr size_t kOneChannel = 1;
+constexpr size_t kTwoChannels = 2;
+constexpr size_t kLookahead = PolyphaseResampler::kTapsPerPhase / 2;
+
+std::vector<double> MakeSine(size_t num_ticks, double frequency,
+                             double sample_rate) {
+  std::vector<double> sine(num_ticks);
+  for (size_t t = 0; t < num_ticks; ++t) {
+    sine[t] = 0.5 * std::sin(2.0 * std::numbers::pi * frequency *
+                             static_cast<double>(t) / sample_rate);
+  }
+  return sine;
+}
+
+std::unique_ptr<PolyphaseResampler> CreateResampler(uint32_t input_sample_rate,
+                                                    uint32_t output_sample_rate,
+                                                    size_t num_channels) {
+  auto resampler = PolyphaseResampler::Create(
+      input_sample_rate, output_sample_rate, num_channels);
+  EXPECT_THAT(resampler, IsOk());
+  return resampler.ok() ? *std::move(resampler) : nullptr;
+}
+
+// Resamples a single channel in blocks of `block_size`, then flushes.
+std::vector<double> ResampleInBlocks(PolyphaseResampler& resampler,
+                                     const std::vector<double>& input,
+                                     size_t block_size) {
+  std::vector<double> resampled;
+  std::vector<std::vector<double>> output;
+  for (size_t start = 0; start < input.size(); start += block_size) {
+    const auto block = absl::MakeConstSpan(input).subspan(start, block_size);
+    EXPECT_THAT(resampler.Process({block}, output), IsOk());
+    resampled.insert(resampled.end(), output[0].begin(), output[0].end());
+  }
+  EXPECT_THAT(resampler.Flush(output), IsOk());
+  resampled.insert(resampled.end(), output[0].begin(), output[0].end());
+  return resampled;
+}
+
+TEST(Create, FailsForZeroSampleRates) {
+  EXPECT_THAT(PolyphaseResampler::Create(0, 48000, kOneChannel),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(PolyphaseResampler::Create(48000, 0, kOneChannel),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(Create, FailsForZeroChannels) {
+  EXPECT_THAT(PolyphaseResampler::Create(48000, 44100, 0),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(Create, FailsWhenReducedRatioHasTooManyPhases) {
+  EXPECT_THAT(PolyphaseResampler::Create(48000, 44101, kOneChannel),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(GetMaxOutputTicks, IsScaledByTheRatioOfSampleRates) {
+  EXPECT_EQ(CreateResampler(48000, 44100, kOneChannel)->GetMaxOutputTicks(960),
+            882);
+  EXPECT_EQ(CreateResampler(16000, 48000, kOneChannel)->GetMaxOutputTicks(960),
+            2880);
+  EXPECT_EQ(CreateResampler(48000, 44100, kOneChannel)->GetMaxOutputTicks(1024),
+            941);
+}
+
+TEST(Process, FailsForMismatchingNumberOfChannels) {
+  auto resampler = CreateResampler(48000, 44100, kTwoChannels);
+  const std::vector<double> channel(960, 0.0);
+  std::vector<std::vector<double>> output;
+
+  EXPECT_THAT(resampler->Process({channel}, output),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(Process, FailsForChannelsWithDifferentNumberOfTicks) {
+  auto resampler = CreateResampler(48000, 44100, kTwoChannels);
+  const std::vector<double> channel(960, 0.0);
+  const std::vector<double> short_channel(959, 0.0);
+  std::vector<std::vector<double>> output;
+
+  EXPECT_THAT(resampler->Process({channel, short_channel}, output),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(Process, OutputsTheExactRatioOfTicksOverManyBlocks) {
+  auto resampler = CreateResampler(48000, 44100, kOneChannel);
+  const std::vector<double> input(1024 * 75, 0.0);
+
+  const auto output = ResampleInBlocks(*resampler, input, 1024);
+
+  EXPECT_EQ(output.size(), 1024 * 75 * 147 / 160);
+}
+
+TEST(Process, PreservesConstantSignals) {
+  auto resampler = CreateResampler(48000, 44100, kOneChannel);
+  const std::vector<double> input(4800, 0.25);
+
+  const auto output = ResampleInBlocks(*resampler, input, 960);
+
+  // Skip the samples which depend on the silence around the stream.
+  for (size_t t = kLookahead; t < output.size() - kLookahead; ++t) {
+    EXPECT_NEAR(output[t], 0.25, 1e-12);
+  }
+}
+
+TEST(Process, InterpolatesSineWavesBelowNyquist) {
+  constexpr double kInputSampleRate = 16000;
+  constexpr double kOutputSampleRate = 48000;
+  constexpr double kFrequency = 1000;
+  auto resampler =
+      CreateResampler(kInputSampleRate, kOutputSampleRate, kOneChannel);
+  const auto input = MakeSine(1600, kFrequency, kInputSampleRate);
+
+  const auto output = ResampleInBlocks(*resampler, input, 160);
+
+  ASSERT_EQ(output.size(), 4800);
+  // The output is aligned with the input, away from the edges of the stream.
+  const auto expected = MakeSine(output.size(), kFrequency, kOutputSampleRate);
+  for (size_t t = 3 * kLookahead; t < output.size() - 3 * kLookahead; ++t) {
+    EXPECT_NEAR(output[t], expected[t], 1e-3);
+  }
+}
+
+TEST(Process, AttenuatesFrequenciesAboveTheOutputNyquist) {
+  constexpr double kInputSampleRate = 48000;
+  auto resampler = CreateResampler(kInputSampleRate, 16000, kOneChannel);
+  const auto input = MakeSine(4800, 12000, kInputSampleRate);
+
+  const auto output = ResampleInBlocks(*resampler, input, 480);
+
+  for (size_t t = kLookahead; t < output.size() - kLookahead; ++t) {
+    EXPECT_NEAR(output[t], 0.0, 1e-3);
+  }
+}
+
+TEST(Process, OutputDoesNotDependOnTheBlockSize) {
+  const auto input = MakeSine(4410, 440, 44100);
+  auto one_block_resampler = CreateResampler(44100, 48000, kOneChannel);
+  auto small_block_resampler = CreateResampler(44100, 48000, kOneChannel);
+
+  const auto one_block_output =
+      ResampleInBlocks(*one_block_resampler, input, input.size());
+  const auto small_block_output =
+      ResampleInBlocks(*small_block_resampler, input, 7);
+
+  EXPECT_THAT(small_block_output,
+              Pointwise(DoubleEq(), one_block_output));
+}
+
+TEST(Process, ResamplesChannelsIndependently) {
+  auto resampler = CreateResampler(48000, 44100, kTwoChannels);
+  const auto left = MakeSine(960, 440, 48000);
+  const std::vector<double> right(960, 0.0);
+  std::vector<std::vector<double>> output;
+
+  EXPECT_THAT(resampler->Process({left, right}, output), IsOk());
+
+  ASSERT_EQ(output.size(), 2);
+  EXPECT_EQ(output[0].size(), output[1].size());
+  EXPECT_THAT(output[0], Not(Each(0.0)));
+  EXPECT_THAT(output[1], Each(0.0));
+}
+
+TEST(Process, HoldsBackTheLookaheadOfTheFilter) {
+  auto resampler = CreateResampler(48000, 96000, kOneChannel);
+  const std::vector<double> input(kLookahead, 1.0);
+  std::vector<std::vector<double>> output;
+
+  EXPECT_THAT(resampler->Process({input}, output), IsOk());
+
+  ASSERT_EQ(output.size(), 1);
+  EXPECT_TRUE(output[0].empty());
+}
+
+TEST(Flush, OutputsTheRemainingTicksOfTheStream) {
+  for (const auto& [input_sample_rate, output_sample_rate] :
+       {std::pair<uint32_t, uint32_t>{48000, 44100},
+        {44100, 48000},
+        {16000, 48000},
+        {48000, 16000}}) {
+    for (const size_t num_input_ticks : {1, 7, 960, 1001}) {
+      auto resampler =
+          CreateResampler(input_sample_rate, output_sample_rate, kOneChannel);
+      const std::vector<double> input(num_input_ticks, 0.5);
+
+      const auto output = ResampleInBlocks(*resampler, input, 160);
+
+      const uint64_t expected_num_output_ticks =
+          (static_cast<uint64_t>(num_input_ticks) * output_sample_rate +
+           input_sample_rate - 1) /
+          input_sample_rate;
+      EXPECT_EQ(output.size(), expected_num_output_ticks)
+          << input_sample_rate << " -> " << output_sample_rate << " with "
+          << num_input_ticks << " ticks";
+    }
+  }
+}
+
+TEST(Flush, AlignsAnImpulseWithTheInput) {
+  constexpr size_t kImpulseIndex = 300;
+  auto resampler = CreateResampler(16000, 48000, kOneChannel);
+  std::vector<double> input(1000, 0.0);
+  input[kImpulseIndex] = 1.0;
+
+  const auto output = ResampleInBlocks(*resampler, input, 64);
+
+  ASSERT_EQ(output.size(), 3000);
+  const auto peak = std::max_element(output.begin(), output.end());
+  EXPECT_EQ(std::distance(output.begin(), peak), 3 * kImpulseIndex);
+}
+
+TEST(Flush, ResetsTheResamplerForANewStream) {
+  const auto input = MakeSine(1000, 440, 48000);
+  auto resampler = CreateResampler(48000, 44100, kOneChannel);
+
+  const auto first_output = ResampleInBlocks(*resampler, input, 100);
+  const auto second_output = ResampleInBlocks(*resampler, input, 100);
+
+  EXPECT_THAT(second_output, Pointwise(DoubleEq(), first_output));
+}
+
+}  // namespace
+}  // namespace iamf_tools
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/common/utils/thread_pool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/status_matchers.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace iamf_tools {
+namespace {
+
+using ::absl_testing::IsOk;
+using ::absl_testing::StatusIs;
+using ::testing::Each;
+
+constexpr size_t kNumThreadsToTest[] = {0, 1, 4};
+
+TEST(GetShared, ReturnsTheSamePool) {
+  EXPECT_EQ(&ThreadPool::GetShared(), &ThreadPool::GetShared());
+}
+
+TEST(NumThreads, ReturnsNumThreadsFromConstructor) {
+  for (const size_t num_threads : kNumThreadsToTest) {
+    ThreadPool pool(num_threads);
+
+    EXPECT_EQ(pool.NumThreads(), num_threads);
+  }
+}
+
+TEST(Schedule, RunsAllTasks) {
+  for (const size_t num_threads : kNumThreadsToTest) {
+    ThreadPool pool(num_threads);
+    constexpr int kNumTasks = 100;
+    absl::BlockingCounter counter(kNumTasks);
+
+    for (int i = 0; i < kNumTasks; ++i) {
+      pool.Schedule([&counter] { counter.DecrementCount(); });
+    }
+
+    counter.Wait();
+  }
+}
+
+TEST(ParallelFor, RunsEachIterationOnce) {
+  for (const size_t num_threads : kNumThreadsToTest) {
+    ThreadPool pool(num_threads);
+    std::vector<std::atomic<int>> num_runs(1000);
+
+    EXPECT_THAT(pool.ParallelFor(num_runs.size(),
+                                 [&num_runs](size_t i) {
+                                   num_runs[i]++;
+                                   return absl::OkStatus();
+                                 }),
+                IsOk());
+
+    EXPECT_THAT(std::vector<int>(num_runs.begin(), num_runs.end()), Each(1));
+  }
+}
+
+TEST(ParallelFor, SucceedsWithNoIterations) {
+  ThreadPool pool(2);
+
+  EXPECT_THAT(pool.ParallelFor(0, [](size_t) {
+    return absl::InternalError("Should not run.");
+  }),
+              IsOk());
+}
+
+TEST(ParallelFor, ReturnsErrorOfLowestFailingIteration) {
+  for (const size_t num_threads : kNumThreadsToTest) {
+    ThreadPool pool(num_threads);
+
+    EXPECT_THAT(
+        pool.ParallelFor(
+            10,
+            [](size_t i) {
+              if (i < 3) {
+                return absl::OkStatus();
+              }
+              return i == 3 ? absl::InvalidArgumentError("")
+                            : absl::InternalError("");
+            }),
+        StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+}
+
+TEST(ParallelFor, SupportsNestedCalls) {
+  ThreadPool pool(2);
+  std::atomic<int> num_inner_runs = 0;
+
+  EXPECT_THAT(pool.ParallelFor(4,
+                               [&](size_t) {
+                                 return pool.ParallelFor(4, [&](size_t) {
+                                   num_inner_runs++;
+                                   return absl::OkStatus();
+                                 });
+                               }),
+              IsOk());
+
+  EXPECT_EQ(num_inner_runs, 16);
+}
+
+}  // namespace
+}  // namespace iamf_tools
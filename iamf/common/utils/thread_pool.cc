@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#include "iamf/common/utils/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/base/no_destructor.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/functional/function_ref.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+
+namespace iamf_tools {
+
+namespace {
+
+// State of one call to `ParallelFor()`. Helpers which start late may outlive
+// the call, so the state is shared; such helpers find no iterations left and
+// never touch `fn`.
+struct ParallelForState {
+  ParallelForState(size_t num_iterations,
+                   absl::FunctionRef<absl::Status(size_t)> fn)
+      : num_iterations(num_iterations), fn(fn), statuses(num_iterations) {}
+
+  // Claims and runs iterations until none are left.
+  void RunIterations() {
+    while (true) {
+      const size_t i = next_iteration.fetch_add(1, std::memory_order_relaxed);
+      if (i >= num_iterations) {
+        return;
+      }
+      statuses[i] = fn(i);
+
+      absl::MutexLock lock(&mutex);
+      num_finished++;
+    }
+  }
+
+  bool AllFinished() const ABSL_SHARED_LOCKS_REQUIRED(mutex) {
+    return num_finished == num_iterations;
+  }
+
+  const size_t num_iterations;
+  const absl::FunctionRef<absl::Status(size_t)> fn;
+  std::atomic<size_t> next_iteration = 0;
+  // Each iteration writes only its own status.
+  std::vector<absl::Status> statuses;
+
+  absl::Mutex mutex;
+  size_t num_finished ABSL_GUARDED_BY(mutex) = 0;
+};
+
+}  // namespace
+
+ThreadPool& ThreadPool::GetShared() {
+  static absl::NoDestructor<ThreadPool> shared_pool(
+      std::max(std::thread::hardware_concurrency(), 1u) - 1);
+  return *shared_pool;
+}
+
+ThreadPool::ThreadPool(size_t num_threads) {
+  workers_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers_.emplace_back(&ThreadPool::RunWorker, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    shutting_down_ = true;
+  }
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Schedule(absl::AnyInvocable<void() &&> task) {
+  if (workers_.empty()) {
+    std::move(task)();
+    return;
+  }
+  absl::MutexLock lock(&mutex_);
+  tasks_.push_back(std::move(task));
+}
+
+absl::Status ThreadPool::ParallelFor(
+    size_t num_iterations, absl::FunctionRef<absl::Status(size_t)> fn) {
+  if (num_iterations == 0) {
+    return absl::OkStatus();
+  }
+
+  auto state = std::make_shared<ParallelForState>(num_iterations, fn);
+  // The calling thread runs iterations too, so it needs one fewer helper.
+  const size_t num_helpers = std::min(NumThreads(), num_iterations - 1);
+  for (size_t i = 0; i < num_helpers; ++i) {
+    Schedule([state] { state->RunIterations(); });
+  }
+  state->RunIterations();
+
+  {
+    absl::MutexLock lock(&state->mutex);
+    state->mutex.Await(
+        absl::Condition(state.get(), &ParallelForState::AllFinished));
+  }
+
+  for (auto& status : state->statuses) {
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  return absl::OkStatus();
+}
+
+void ThreadPool::RunWorker() {
+  while (true) {
+    absl::AnyInvocable<void() &&> task;
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(
+          +[](ThreadPool* pool) ABSL_EXCLUSIVE_LOCKS_REQUIRED(pool->mutex_) {
+            return pool->shutting_down_ || !pool->tasks_.empty();
+          },
+          this));
+      if (tasks_.empty()) {
+        // Only reached when shutting down with no work left.
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    std::move(task)();
+  }
+}
+
+}  // namespace iamf_tools
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+#ifndef COMMON_UTILS_THREAD_POOL_H_
+#define COMMON_UTILS_THREAD_POOL_H_
+
+#include <cstddef>
+#include <deque>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/functional/function_ref.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+
+namespace iamf_tools {
+
+/*!\brief Fixed-size pool of worker threads.
+ *
+ * A single pool is shared by all components of the encoder and decoder via
+ * `GetShared()`, so that nested or concurrent users do not oversubscribe the
+ * machine. Work is typically submitted via `ParallelFor()`, where the calling
+ * thread also participates. This makes it safe to call `ParallelFor()` from a
+ * task which itself runs on the pool, and a pool without any workers simply
+ * runs everything on the calling thread.
+ */
+class ThreadPool {
+ public:
+  /*!\brief Gets the pool shared by the encoder and decoder.
+   *
+   * The pool is created on first use with one worker fewer than the number of
+   * hardware threads, since the calling thread participates in the work.
+   *
+   * \return Shared thread pool.
+   */
+  static ThreadPool& GetShared();
+
+  /*!\brief Constructor.
+   *
+   * \param num_threads Number of worker threads to start.
+   */
+  explicit ThreadPool(size_t num_threads);
+
+  /*!\brief Destructor. Finishes all scheduled tasks then joins the workers. */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /*!\brief Gets the number of worker threads.
+   *
+   * \return Number of worker threads.
+   */
+  size_t NumThreads() const { return workers_.size(); }
+
+  /*!\brief Schedules a task to run on a worker thread.
+   *
+   * \param task Task to run. Runs on the calling thread if the pool has no
+   *        workers.
+   */
+  void Schedule(absl::AnyInvocable<void() &&> task);
+
+  /*!\brief Runs `fn(i)` for each `i` in [0, `num_iterations`) in parallel.
+   *
+   * Blocks until all iterations are finished. Iterations may run in any order
+   * and on any thread, including the calling thread.
+   *
+   * \param num_iterations Number of iterations.
+   * \param fn Function to run for each iteration.
+   * \return `absl::OkStatus()` if all iterations succeeded. Otherwise the
+   *         status of the lowest-indexed failing iteration, so the result does
+   *         not depend on scheduling.
+   */
+  absl::Status ParallelFor(size_t num_iterations,
+                           absl::FunctionRef<absl::Status(size_t)> fn);
+
+ private:
+  /*!\brief Runs tasks until the pool is shut down. */
+  void RunWorker();
+
+  absl::Mutex mutex_;
+  std::deque<absl::AnyInvocable<void() &&>> tasks_ ABSL_GUARDED_BY(mutex_);
+  bool shutting_down_ ABSL_GUARDED_BY(mutex_) = false;
+
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace iamf_tools
+
+#endif  // COMMON_UTILS_THREAD_POOL_H_
@@ -12,9 +12,10 @@
 #include "iamf/common/write_bit_buffer.h"
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <fstream>
-#include <iterator>
 #include <optional>
 #include <string>
 #include <vector>
@@ -31,42 +32,45 @@ namespace iamf_tools {
 
 namespace {
 
-void MaybeResizeBufferToFitNumBits(int num_bits, int64_t bit_offset,
-                                   std::vector<uint8_t>& bit_buffer) {
-  const int64_t size = static_cast<int64_t>(bit_buffer.size());
-  if (bit_offset + num_bits <= size * 8) {
-    return;
-  }
+// Maximum number of bits which can be appended at once. Together with the up
+// to seven bits of a partially written byte they fit in one 64-bit word.
+constexpr int kMaxBitsToAppend = 56;
 
-  const int64_t required_bytes = ((bit_offset + num_bits) / 8) +
-                                 ((bit_offset + num_bits) % 8 == 0 ? 0 : 1);
-
-  // Adjust the size of the buffer.
-  bit_buffer.resize(required_bytes, 0);
+uint64_t LoadBigEndian64(const uint8_t* src) {
+  uint64_t word = 0;
+  for (int i = 0; i < 8; ++i) {
+    word = (word << 8) | src[i];
+  }
+  return word;
 }
 
-// Write one bit to the buffer using an AND or OR mask. All unwritten bits are
-// unchanged. This function is designed to work even if the buffer has
-// uninitialized data.
-absl::Status WriteBit(int bit, int64_t& bit_offset,
-                      std::vector<uint8_t>& bit_buffer) {
-  if (bit_offset < 0) {
-    return absl::InvalidArgumentError("The bit offset should not be negative.");
+void StoreBigEndian64(uint64_t word, uint8_t* dst) {
+  for (int i = 0; i < 8; ++i) {
+    dst[i] = static_cast<uint8_t>(word >> (56 - 8 * i));
   }
-  const int64_t off = bit_offset;
-  const int64_t p = off >> 3;
-  const int q = 7 - static_cast<int>(off & 0x7);
+}
 
-  if (bit == 0) {
-    // AND mask to set the target bit to 0 and leave others unchanged.
-    bit_buffer[p] &= ~(1 << q);
-  } else {
-    // OR mask to set the target bit to 1 and leave others unchanged.
-    bit_buffer[p] |= (1 << q);
+// Appends the lower n = `num_bits` bits of `data` to the buffer, where n is in
+// the range [1, `kMaxBitsToAppend`]. The bits are merged with any partially
+// written byte in a 64-bit accumulator, which is then flushed a byte at a
+// time. Unwritten bits of the last byte are always zero.
+void AppendBits(uint64_t data, int num_bits, int64_t& bit_offset,
+                std::vector<uint8_t>& bit_buffer) {
+  const int num_partial_bits = static_cast<int>(bit_offset % 8);
+  uint64_t accumulator = 0;
+  if (num_partial_bits != 0) {
+    accumulator = bit_buffer.back() >> (8 - num_partial_bits);
+    bit_buffer.pop_back();
   }
-  bit_offset = off + 1;
+  const int num_accumulated_bits = num_partial_bits + num_bits;
+  accumulator = ((accumulator << num_bits) | data)
+                << (64 - num_accumulated_bits);
 
-  return absl::OkStatus();
+  const int num_bytes = (num_accumulated_bits + 7) / 8;
+  for (int i = 0; i < num_bytes; ++i) {
+    bit_buffer.push_back(static_cast<uint8_t>(accumulator >> (56 - 8 * i)));
+  }
+  bit_offset += num_bits;
 }
 
 // A helper function to write out n = `num_bits` bits to the buffer. These
@@ -103,22 +107,12 @@ absl::Status InternalWriteUnsigned(int max_bits, uint64_t data, int num_bits,
                      num_bits, " data= ", data));
   }
 
-  // Expand the buffer and pad the input data with zeroes.
-  MaybeResizeBufferToFitNumBits(num_bits, bit_offset, bit_buffer);
-
-  if (bit_offset % 8 == 0 && num_bits % 8 == 0) {
-    // Short-circuit the common case of writing a byte-aligned input to a
-    // byte-aligned output. Copy one byte at a time.
-    for (int byte = (num_bits / 8) - 1; byte >= 0; byte--) {
-      bit_buffer[bit_offset / 8] = (data >> (byte * 8)) & 0xff;
-      bit_offset += 8;
-    }
+  if (num_bits > kMaxBitsToAppend) {
+    // Split large writes so each part fits in the accumulator.
+    AppendBits(data >> 32, num_bits - 32, bit_offset, bit_buffer);
+    AppendBits(data & 0xffffffff, 32, bit_offset, bit_buffer);
   } else {
-    // The input and/or output are not byte-aligned. Write one bit at
-    // a time.
-    for (int bit = num_bits - 1; bit >= 0; bit--) {
-      RETURN_IF_NOT_OK(WriteBit((data >> bit) & 1, bit_offset, bit_buffer));
-    }
+    AppendBits(data, num_bits, bit_offset, bit_buffer);
   }
 
   return absl::OkStatus();
@@ -206,21 +200,55 @@ absl::Status WriteBitBuffer::WriteString(const std::string& data) {
           "String contains an internal null terminator");
     }
   }
-  for (int i = 0; i < data.size(); ++i) {
-    // Note that some systems have `char` as signed and others unsigned. Write
-    // the same raw byte value regardless.
-    const uint8_t byte = static_cast<uint8_t>(data[i]);
-    RETURN_IF_NOT_OK(WriteUnsignedLiteral(byte, 8));
-  }
+  // Note that some systems have `char` as signed and others unsigned. Write
+  // the same raw byte values regardless.
+  RETURN_IF_NOT_OK(WriteUint8Span(absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(data.data()), data.size())));
   RETURN_IF_NOT_OK(WriteUnsignedLiteral(static_cast<uint8_t>('\0'), 8));
   return absl::OkStatus();
 }
 
 absl::Status WriteBitBuffer::WriteUleb128(const DecodedUleb128 data) {
   // Transform data to a temporary buffer. Then write it.
-  std::vector<uint8_t> buffer;
-  RETURN_IF_NOT_OK(leb_generator_.Uleb128ToUint8Vector(data, buffer));
-  RETURN_IF_NOT_OK(WriteUint8Span(absl::MakeConstSpan(buffer)));
+  std::array<uint8_t, kMaxLeb128Size> buffer;
+  int num_bytes = 0;
+  RETURN_IF_NOT_OK(
+      leb_generator_.Uleb128ToUint8Array(data, buffer, num_bytes));
+  RETURN_IF_NOT_OK(
+      WriteUint8Span(absl::MakeConstSpan(buffer).first(num_bytes)));
+  return absl::OkStatus();
+}
+
+absl::Status WriteBitBuffer::OverwriteUleb128(int64_t byte_offset,
+                                              int64_t reserved_size,
+                                              const DecodedUleb128 data) {
+  if (!IsByteAligned()) {
+    return absl::InvalidArgumentError("Write buffer not byte-aligned");
+  }
+  const int64_t num_bytes = bit_offset_ / 8;
+  if (byte_offset < 0 || reserved_size < 0 ||
+      byte_offset + reserved_size > num_bytes) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Reserved bytes [", byte_offset, ", ", byte_offset + reserved_size,
+        ") are outside of the buffer of size ", num_bytes));
+  }
+
+  std::array<uint8_t, kMaxLeb128Size> buffer;
+  int encoded_size = 0;
+  RETURN_IF_NOT_OK(
+      leb_generator_.Uleb128ToUint8Array(data, buffer, encoded_size));
+  if (encoded_size > reserved_size) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("ULEB128 of size ", encoded_size,
+                     " does not fit in the reserved size ", reserved_size));
+  }
+
+  auto reserved_begin = bit_buffer_.begin() + byte_offset;
+  std::copy(buffer.begin(), buffer.begin() + encoded_size, reserved_begin);
+  // Close the gap with a single shift of the trailing data.
+  bit_buffer_.erase(reserved_begin + encoded_size,
+                    reserved_begin + reserved_size);
+  bit_offset_ -= 8 * (reserved_size - encoded_size);
   return absl::OkStatus();
 }
 
@@ -246,24 +274,40 @@ absl::Status WriteBitBuffer::WriteIso14496_1Expanded(
 }
 
 absl::Status WriteBitBuffer::WriteUint8Span(absl::Span<const uint8_t> data) {
+  if (data.empty()) {
+    return absl::OkStatus();
+  }
   if (IsByteAligned()) {
     // In the common case we can just copy all of the data over and update
-    // `bit_offset_`.
-    bit_buffer_.reserve(bit_buffer_.size() + data.size());
-    std::copy(data.begin(), data.end(), std::back_inserter(bit_buffer_));
+    // `bit_offset_`. Let the buffer grow geometrically, so that many small
+    // writes do not each reallocate.
+    bit_buffer_.insert(bit_buffer_.end(), data.begin(), data.end());
     bit_offset_ += 8 * data.size();
     return absl::OkStatus();
   }
 
-  // Expand the buffer to fit the data for efficiency when processing large
-  // input.
-  const int64_t data_size_bits = data.size() * 8;
-  MaybeResizeBufferToFitNumBits(data_size_bits, bit_offset_, bit_buffer_);
-
-  // The buffer is mis-aligned. Copy it over one byte at a time.
-  for (const uint8_t& value : data) {
-    RETURN_IF_NOT_OK(WriteUnsignedLiteral(value, 8));
+  // The buffer is mis-aligned. Shift each input byte into place, merging it
+  // with the trailing bits of the previous output byte.
+  const int shift = static_cast<int>(bit_offset_ % 8);
+  const size_t partial_byte_index = bit_buffer_.size() - 1;
+  bit_buffer_.resize(bit_buffer_.size() + data.size());
+  uint8_t* dst = bit_buffer_.data() + partial_byte_index;
+  uint8_t carry = *dst;
+  size_t i = 0;
+  // Merge a word at a time.
+  for (; i + 8 <= data.size(); i += 8) {
+    const uint64_t word = LoadBigEndian64(&data[i]);
+    StoreBigEndian64((static_cast<uint64_t>(carry) << 56) | (word >> shift),
+                     dst);
+    carry = static_cast<uint8_t>(word << (8 - shift));
+    dst += 8;
+  }
+  for (; i < data.size(); ++i) {
+    *dst++ = carry | (data[i] >> shift);
+    carry = static_cast<uint8_t>(data[i] << (8 - shift));
   }
+  *dst = carry;
+  bit_offset_ += 8 * data.size();
   return absl::OkStatus();
 }
 
@@ -285,6 +329,14 @@ absl::Status WriteBitBuffer::FlushAndWriteToFile(
   return absl::OkStatus();
 }
 
+void WriteBitBuffer::Truncate(int64_t num_bytes) {
+  if (num_bytes < 0 || num_bytes * 8 >= bit_offset_) {
+    return;
+  }
+  bit_buffer_.resize(num_bytes);
+  bit_offset_ = num_bytes * 8;
+}
+
 void WriteBitBuffer::Reset() {
   bit_offset_ = 0;
   bit_buffer_.clear();
@@ -119,6 +119,23 @@ class WriteBitBuffer {
    */
   absl::Status WriteUleb128(DecodedUleb128 data);
 
+  /*!\brief Overwrites a ULEB128 which was reserved earlier in the buffer.
+   *
+   * Allows a size to be written before the data it describes. If `data` is
+   * encoded in fewer bytes than were reserved, the data after the reserved
+   * bytes is shifted down to close the gap.
+   *
+   * \param byte_offset Offset of the reserved bytes.
+   * \param reserved_size Number of reserved bytes.
+   * \param data Data to write using the member `leb_generator_`.
+   * \return `absl::OkStatus()` on success. `absl::InvalidArgumentError()` if
+   *         the buffer is not byte-aligned, if the reserved bytes are not in
+   *         the buffer, or if the encoded `data` does not fit in them. Other
+   *         specific statuses on failure.
+   */
+  absl::Status OverwriteUleb128(int64_t byte_offset, int64_t reserved_size,
+                                DecodedUleb128 data);
+
   /*!\brief Writes the expandable size according to ISO 14496-1.
    *
    * \param size_of_instance Size of the instance.
@@ -155,6 +172,13 @@ class WriteBitBuffer {
    */
   bool IsByteAligned() const { return bit_offset_ % 8 == 0; }
 
+  /*!\brief Discards all data after the first `num_bytes` bytes.
+   *
+   * \param num_bytes Number of bytes to keep. No effect if it is not less than
+   *        the number of written bytes.
+   */
+  void Truncate(int64_t num_bytes);
+
   /*!\brief Resets the underlying buffer. */
   void Reset();
 
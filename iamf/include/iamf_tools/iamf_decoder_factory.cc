@@ -31,6 +31,7 @@ IamfDecoder::Settings ApiToInternalSettings(
       .channel_ordering = settings.channel_ordering,
       .requested_profile_versions = settings.requested_profile_versions,
       .requested_output_sample_type = settings.requested_output_sample_type,
+      .requested_output_sample_rate = settings.requested_output_sample_rate,
   };
   return internal_settings;
 }
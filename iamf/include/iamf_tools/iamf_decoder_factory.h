@@ -16,6 +16,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 
 #include "iamf_decoder_interface.h"
@@ -54,6 +55,12 @@ class IamfDecoderFactory {
     // Specifies the desired bit depth for the output samples.
     OutputSampleType requested_output_sample_type =
         OutputSampleType::kInt32LittleEndian;
+
+    // Specifies the desired sample rate of the output. When unset, or when it
+    // matches the sample rate of the bitstream, samples are output at the
+    // sample rate of the bitstream. Otherwise the rendered samples are
+    // converted to the requested sample rate before being output.
+    std::optional<uint32_t> requested_output_sample_rate;
   };
 
   /*!\brief Creates an IamfDecoderInterface.
@@ -58,9 +58,15 @@ IamfEncoderFactory::CreateFileGeneratingIamfEncoder(
         *leb_generator));
     return obu_sequencers;
   };
+  const auto loudness_calculator_factory = CreateLoudnessCalculatorFactory(
+      user_metadata.encoder_control_metadata());
+  if (loudness_calculator_factory == nullptr) {
+    return absl::InvalidArgumentError(
+        "Invalid loudness settings in the encoder control metadata.");
+  }
   return IamfEncoder::Create(
       user_metadata, CreateRendererFactory().get(),
-      CreateLoudnessCalculatorFactory().get(),
+      loudness_calculator_factory.get(),
       RenderingMixPresentationFinalizer::ProduceNoSampleProcessors,
       obu_sequencer_factory);
 }
@@ -76,9 +82,15 @@ IamfEncoderFactory::CreateIamfEncoder(
 
   // Create an encoder, which is pre-configured with enough functionality to
   // measure loudness.
+  const auto loudness_calculator_factory = CreateLoudnessCalculatorFactory(
+      user_metadata.encoder_control_metadata());
+  if (loudness_calculator_factory == nullptr) {
+    return absl::InvalidArgumentError(
+        "Invalid loudness settings in the encoder control metadata.");
+  }
   return IamfEncoder::Create(
       user_metadata, CreateRendererFactory().get(),
-      CreateLoudnessCalculatorFactory().get(),
+      loudness_calculator_factory.get(),
       RenderingMixPresentationFinalizer::ProduceNoSampleProcessors,
       IamfEncoder::CreateNoObuSequencers);
 }
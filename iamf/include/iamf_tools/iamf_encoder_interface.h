@@ -13,9 +13,11 @@
 #define API_ENCODER_INTERFACE_H_
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include "absl/status/status.h"
+#include "absl/types/span.h"
 #include "iamf_tools_encoder_api_types.h"
 
 namespace iamf_tools {
@@ -87,7 +89,8 @@ namespace api {
  *      encoder->FinalizeEncode();
  *    }
  *
- *    // Flush OBUs for the next temporal unit.
+ *    // Flush OBUs for the next temporal unit. Alternatively, pass an
+ *    // `absl::Span<const uint8_t>` to get a view without copying.
  *    encoder->OutputTemporalUnit(temporal_unit_obus);
  *    if (streaming) {
  *      // Broadcast the temporal unit descriptor OBUs.
@@ -102,6 +105,10 @@ namespace api {
  *    // If any consumers require accurate descriptors (loudness), notify them.
  *  }
  *  // Otherwise, they were already flushed to file.
+ *
+ * Functions which were added after the first release have default
+ * implementations which return `absl::UnimplementedError()`, so existing
+ * implementations of this interface keep compiling.
  */
 class IamfEncoderInterface {
  public:
@@ -134,6 +141,27 @@ class IamfEncoderInterface {
       bool redundant_copy, std::vector<uint8_t>& descriptor_obus,
       bool& output_obus_are_finalized) const = 0;
 
+  /*!\brief Gets a view of the latest descriptor OBUs.
+   *
+   * Equivalent to the other overload, but the OBUs are not copied. This is
+   * useful to write them straight to some output, such as a network buffer.
+   *
+   * \param redundant_copy True to request a "redundant" copy.
+   * \param descriptor_obus View of the OBUs. Valid until the next call to a
+   *        non-const function of this encoder.
+   * \param output_obus_are_finalized `true` when the output OBUs are
+   *        finalized. `false` otherwise.
+   * \return `absl::OkStatus()` if successful. `absl::UnimplementedError()` if
+   *         the implementation does not support views. A specific status on
+   *         other failures.
+   */
+  virtual absl::Status GetDescriptorObus(
+      bool redundant_copy, absl::Span<const uint8_t>& descriptor_obus,
+      bool& output_obus_are_finalized) const {
+    return absl::UnimplementedError(
+        "GetDescriptorObus() is not implemented for views.");
+  }
+
   /*!\brief Returns whether this encoder is generating temporal units.
    *
    * \return True until the last temporal unit is output, then false.
@@ -151,6 +179,41 @@ class IamfEncoderInterface {
   virtual absl::Status Encode(
       const IamfTemporalUnitData& temporal_unit_data) = 0;
 
+  /*!\brief Gets a handle to one channel of an audio element.
+   *
+   * Resolving the channels once avoids looking up the serialized labels for
+   * every temporal unit. Requesting the same channel again returns the same
+   * handle. Handles are assigned densely from zero.
+   *
+   * \param audio_element_id ID of the audio element.
+   * \param channel_label Serialized `ChannelLabelMessage` protocol buffer.
+   * \param channel_handle Handle to the channel.
+   * \return `absl::OkStatus()` if successful. `absl::UnimplementedError()` if
+   *         the implementation does not support channel handles. A specific
+   *         status on other failures.
+   */
+  virtual absl::Status GetChannelHandle(uint32_t audio_element_id,
+                                        const std::string& channel_label,
+                                        IamfChannelHandle& channel_handle) {
+    return absl::UnimplementedError("GetChannelHandle() is not implemented.");
+  }
+
+  /*!\brief Adds audio data and parameter block metadata for one temporal unit.
+   *
+   * Equivalent to the other overload, but the channels are indexed by the
+   * handles from `GetChannelHandle()`.
+   *
+   * \param temporal_unit_data Temporal unit to add.
+   * \return `absl::OkStatus()` if successful. `absl::UnimplementedError()` if
+   *         the implementation does not support channel handles. A specific
+   *         status on other failures.
+   */
+  virtual absl::Status Encode(
+      const IamfTemporalUnitChannelData& temporal_unit_data) {
+    return absl::UnimplementedError(
+        "Encode() is not implemented for channel handles.");
+  }
+
   /*!\brief Outputs data OBUs corresponding to one temporal unit.
    *
    * \param temporal_unit_obus Output OBUs corresponding to this temporal unit.
@@ -159,6 +222,24 @@ class IamfEncoderInterface {
   virtual absl::Status OutputTemporalUnit(
       std::vector<uint8_t>& temporal_unit_obus) = 0;
 
+  /*!\brief Outputs a view of the data OBUs of one temporal unit.
+   *
+   * Equivalent to the other overload, but the OBUs are not copied. This is
+   * useful to write them straight to some output, such as a network buffer.
+   *
+   * \param temporal_unit_obus View of the OBUs corresponding to this temporal
+   *        unit, or empty if no temporal unit was ready. Valid until the next
+   *        call to a non-const function of this encoder.
+   * \return `absl::OkStatus()` if successful. `absl::UnimplementedError()` if
+   *         the implementation does not support views. A specific status on
+   *         other failures.
+   */
+  virtual absl::Status OutputTemporalUnit(
+      absl::Span<const uint8_t>& temporal_unit_obus) {
+    return absl::UnimplementedError(
+        "OutputTemporalUnit() is not implemented for views.");
+  }
+
   /*!\brief Finalizes the process of adding samples.
    *
    * This will signal the underlying codecs to flush all remaining samples,
@@ -12,8 +12,11 @@
 #ifndef API_ENCODER_TYPES_H_
 #define API_ENCODER_TYPES_H_
 
+#include <array>
 #include <cstdint>
 #include <string>
+#include <variant>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/types/span.h"
@@ -35,6 +38,90 @@ struct IamfTemporalUnitData {
   absl::flat_hash_map<uint32_t, IamfAudioElementData> audio_element_id_to_data;
 };
 
+enum class IamfAnimationType {
+  kStep = 0,
+  kLinear = 1,
+  kBezier = 2,
+};
+
+// Mix gain animation for one subblock. Gains are in Q7.8 dB format.
+struct IamfMixGainParameterData {
+  IamfAnimationType animation_type = IamfAnimationType::kStep;
+  int16_t start_point_value = 0;
+  // Ignored for `kStep` animations.
+  int16_t end_point_value = 0;
+  // Ignored unless the animation is `kBezier`.
+  int16_t control_point_value = 0;
+  uint8_t control_point_relative_time = 0;  // Q0.8 format.
+};
+
+enum class IamfDMixPMode {
+  kDMixPMode1 = 0,
+  kDMixPMode2 = 1,
+  kDMixPMode3 = 2,
+  kDMixPMode1_n = 4,
+  kDMixPMode2_n = 5,
+  kDMixPMode3_n = 6,
+};
+
+struct IamfDemixingInfoParameterData {
+  IamfDMixPMode dmixp_mode = IamfDMixPMode::kDMixPMode1;
+};
+
+// Recon gains for one layer. Bit `j` of `recon_gain_flag` indicates
+// `recon_gain[j]` is present, in the order of the `recon_gain_flags` in the
+// IAMF spec.
+struct IamfReconGains {
+  uint32_t recon_gain_flag = 0;
+  std::array<uint8_t, 12> recon_gain = {};
+};
+
+struct IamfReconGainInfoParameterData {
+  // Length = `num_layers` of the associated audio element.
+  std::vector<IamfReconGains> recon_gains_for_layer;
+};
+
+struct IamfParameterSubblock {
+  // Ignored unless the parameter block has a `constant_subblock_duration` of
+  // zero.
+  uint32_t subblock_duration = 0;
+
+  // The active field must match the type of the parameter definition.
+  std::variant<IamfMixGainParameterData, IamfDemixingInfoParameterData,
+               IamfReconGainInfoParameterData>
+      param_data;
+};
+
+// Typed equivalent of a `ParameterBlockObuMetadata` protocol buffer.
+struct IamfParameterBlockMetadata {
+  uint32_t parameter_id = 0;
+  int64_t start_timestamp = 0;
+  // Ignored unless `param_definition_mode` is one in the parameter definition.
+  uint32_t duration = 0;
+  uint32_t constant_subblock_duration = 0;
+  std::vector<IamfParameterSubblock> subblocks;
+};
+
+// Handle to one channel of one audio element. Handles are resolved once, after
+// creating the encoder, and index the channels of
+// `IamfTemporalUnitChannelData`.
+using IamfChannelHandle = uint32_t;
+
+struct IamfTemporalUnitChannelData {
+  // Mapping of parameter block IDs to serialized `ParameterBlockObuMetadata`
+  // protocol buffer starting in this temporal unit.
+  absl::flat_hash_map<uint32_t, std::string> parameter_block_id_to_metadata;
+
+  // Parameter blocks starting in this temporal unit. Prefer these to
+  // `parameter_block_id_to_metadata` when they are updated often, since they
+  // are not serialized.
+  absl::Span<const IamfParameterBlockMetadata> parameter_blocks;
+
+  // Planar audio channels for this temporal unit, indexed by
+  // `IamfChannelHandle`. Empty channels are skipped.
+  absl::Span<const absl::Span<const double>> channels;
+};
+
 }  // namespace api
 }  // namespace iamf_tools
 
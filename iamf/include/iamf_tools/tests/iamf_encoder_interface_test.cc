@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License
+ * and the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear
+ * License was not distributed with this source code in the LICENSE file, you
+ * can obtain it at www.aomedia.org/license/software-license/bsd-3-c-c. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * www.aomedia.org/license/patent.
+ */
+
+#include "iamf/include/iamf_tools/iamf_encoder_interface.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/status_matchers.h"
+#include "absl/types/span.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "iamf/include/iamf_tools/iamf_tools_encoder_api_types.h"
+
+namespace iamf_tools {
+namespace api {
+namespace {
+
+using ::absl_testing::StatusIs;
+
+// Implements only the functions of the first release of the interface.
+class FirstReleaseEncoder : public IamfEncoderInterface {
+ public:
+  absl::Status GetDescriptorObus(
+      bool /*redundant_copy*/, std::vector<uint8_t>& /*descriptor_obus*/,
+      bool& output_obus_are_finalized) const override {
+    output_obus_are_finalized = true;
+    return absl::OkStatus();
+  }
+
+  bool GeneratingTemporalUnits() const override { return false; }
+
+  absl::Status Encode(
+      const IamfTemporalUnitData& /*temporal_unit_data*/) override {
+    return absl::OkStatus();
+  }
+
+  absl::Status OutputTemporalUnit(
+      std::vector<uint8_t>& /*temporal_unit_obus*/) override {
+    return absl::OkStatus();
+  }
+
+  absl::Status FinalizeEncode() override { return absl::OkStatus(); }
+};
+
+TEST(IamfEncoderInterface, GetChannelHandleIsUnimplementedByDefault) {
+  FirstReleaseEncoder encoder;
+  IamfEncoderInterface& encoder_interface = encoder;
+
+  IamfChannelHandle channel_handle;
+  EXPECT_THAT(encoder_interface.GetChannelHandle(0, "", channel_handle),
+              StatusIs(absl::StatusCode::kUnimplemented));
+}
+
+TEST(IamfEncoderInterface, EncodeWithChannelHandlesIsUnimplementedByDefault) {
+  FirstReleaseEncoder encoder;
+  IamfEncoderInterface& encoder_interface = encoder;
+
+  EXPECT_THAT(encoder_interface.Encode(IamfTemporalUnitChannelData{}),
+              StatusIs(absl::StatusCode::kUnimplemented));
+}
+
+TEST(IamfEncoderInterface, OutputTemporalUnitAsViewIsUnimplementedByDefault) {
+  FirstReleaseEncoder encoder;
+  IamfEncoderInterface& encoder_interface = encoder;
+
+  absl::Span<const uint8_t> temporal_unit_obus;
+  EXPECT_THAT(encoder_interface.OutputTemporalUnit(temporal_unit_obus),
+              StatusIs(absl::StatusCode::kUnimplemented));
+}
+
+TEST(IamfEncoderInterface, GetDescriptorObusAsViewIsUnimplementedByDefault) {
+  const FirstReleaseEncoder encoder;
+  const IamfEncoderInterface& encoder_interface = encoder;
+
+  absl::Span<const uint8_t> descriptor_obus;
+  bool output_obus_are_finalized;
+  EXPECT_THAT(encoder_interface.GetDescriptorObus(
+                  /*redundant_copy=*/false, descriptor_obus,
+                  output_obus_are_finalized),
+              StatusIs(absl::StatusCode::kUnimplemented));
+}
+
+}  // namespace
+}  // namespace api
+}  // namespace iamf_tools
@@ -29,6 +29,44 @@ namespace iamf_tools {
 ObuBase::~ObuBase() {}
 
 absl::Status ObuBase::ValidateAndWriteObu(WriteBitBuffer& final_wb) const {
+  if (!final_wb.IsByteAligned()) {
+    return ValidateAndWriteObuViaTemporaryBuffer(final_wb);
+  }
+
+  const int64_t start_byte_offset = final_wb.bit_offset() / 8;
+  const absl::Status status = ValidateAndWriteObuInPlace(final_wb);
+  if (!status.ok()) {
+    // Do not leave a partial OBU in the buffer.
+    final_wb.Truncate(start_byte_offset);
+  }
+  return status;
+}
+
+absl::Status ObuBase::ValidateAndWriteObuInPlace(
+    WriteBitBuffer& final_wb) const {
+  // Write the payload directly after the header, then fill in `obu_size` now
+  // that the payload size is known. This avoids copying the payload.
+  ObuHeader::ObuSizePlaceholder obu_size_placeholder;
+  RETURN_IF_NOT_OK(header_.ValidateAndWriteWithPlaceholderObuSize(
+      final_wb, obu_size_placeholder));
+  const int64_t start_payload = final_wb.bit_offset();
+
+  // Write the payload using the virtual function.
+  RETURN_IF_NOT_OK(ValidateAndWritePayload(final_wb));
+  // Write the footer.
+  RETURN_IF_NOT_OK(final_wb.WriteUint8Span(absl::MakeConstSpan(footer_)));
+  if (!final_wb.IsByteAligned()) {
+    // The header stores the size of the OBU in bytes.
+    return absl::InvalidArgumentError(
+        absl::StrCat("Expected the OBU payload to be byte-aligned: ",
+                     final_wb.bit_offset() - start_payload));
+  }
+
+  return ObuHeader::PatchObuSize(obu_size_placeholder, final_wb);
+}
+
+absl::Status ObuBase::ValidateAndWriteObuViaTemporaryBuffer(
+    WriteBitBuffer& final_wb) const {
   // Allocate a temporary buffer big enough for most OBUs to assist writing, but
   // make it resizable so it can be expanded for large OBUs.
   static const int64_t kBufferSize = 1024;
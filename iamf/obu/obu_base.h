@@ -101,6 +101,26 @@ class ObuBase {
   void PrintHeader(int64_t payload_size) const;
 
  private:
+  /*!\brief Writes an entire OBU, filling in `obu_size` after the payload.
+   *
+   * \param final_wb Byte-aligned buffer to write to.
+   * \return `absl::OkStatus()` if the OBU is valid. A specific status on
+   *         failure.
+   */
+  absl::Status ValidateAndWriteObuInPlace(WriteBitBuffer& final_wb) const;
+
+  /*!\brief Writes an entire OBU by first writing the payload separately.
+   *
+   * Used when `final_wb` is not byte-aligned, so `obu_size` cannot be filled in
+   * after writing the payload in place.
+   *
+   * \param final_wb Buffer to write to.
+   * \return `absl::OkStatus()` if the OBU is valid. A specific status on
+   *         failure.
+   */
+  absl::Status ValidateAndWriteObuViaTemporaryBuffer(
+      WriteBitBuffer& final_wb) const;
+
   /*!\brief Reads the known OBU payload from the buffer.
    *
    * Implementations of this function MAY omit reading any bytes not known -
@@ -11,6 +11,7 @@
  */
 #include "iamf/obu/obu_header.h"
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
@@ -202,11 +203,11 @@ absl::Status FillHeaderMetadata(ReadBitBuffer& rb,
   uint64_t obu_type_uint64_t = 0;
   RETURN_IF_NOT_OK(rb.ReadUnsignedLiteral(5, obu_type_uint64_t));
   output_header_metadata.obu_type = static_cast<ObuType>(obu_type_uint64_t);
-  // We don't care about the next three bits.
+  RETURN_IF_NOT_OK(rb.ReadBoolean(output_header_metadata.obu_redundant_copy));
+  // We don't care about the next two bits.
   bool dummy_bool;
   RETURN_IF_NOT_OK(rb.ReadBoolean(dummy_bool));
   RETURN_IF_NOT_OK(rb.ReadBoolean(dummy_bool));
-  RETURN_IF_NOT_OK(rb.ReadBoolean(dummy_bool));
   DecodedUleb128 obu_size;
   int8_t size_of_obu_size = 0;
   RETURN_IF_NOT_OK(rb.ReadULeb128(obu_size, size_of_obu_size));
@@ -264,6 +265,71 @@ absl::Status ObuHeader::ValidateAndWrite(int64_t payload_serialized_size,
   return absl::OkStatus();
 }
 
+absl::Status ObuHeader::ValidateAndWriteWithPlaceholderObuSize(
+    WriteBitBuffer& wb, ObuSizePlaceholder& obu_size_placeholder) const {
+  if (!wb.IsByteAligned()) {
+    return absl::InvalidArgumentError(
+        "Expected the OBU header to start byte-aligned.");
+  }
+  RETURN_IF_NOT_OK(Validate(*this));
+
+  // Reserve the widest `obu_size` the generator will write. Fixed-size
+  // generators encode all values in the same number of bytes, so the size is
+  // patched in place. Minimal generators reserve enough bytes for any valid
+  // `obu_size`; the payload only moves when the final size encodes in fewer
+  // bytes, as the minimal encoding must be kept.
+  std::array<uint8_t, kMaxLeb128Size> placeholder;
+  int placeholder_size = 0;
+  if (!wb.leb_generator_
+           .Uleb128ToUint8Array(kEntireObuSizeMaxTwoMegabytes - 1, placeholder,
+                                placeholder_size)
+           .ok()) {
+    // The fixed size is too small to represent every valid `obu_size`.
+    RETURN_IF_NOT_OK(wb.leb_generator_.Uleb128ToUint8Array(0, placeholder,
+                                                           placeholder_size));
+  }
+
+  RETURN_IF_NOT_OK(wb.WriteUnsignedLiteral(obu_type, 5));
+  RETURN_IF_NOT_OK(wb.WriteBoolean(obu_redundant_copy));
+  RETURN_IF_NOT_OK(wb.WriteBoolean(type_specific_flag));
+  RETURN_IF_NOT_OK(wb.WriteBoolean(GetExtensionHeaderFlag()));
+  obu_size_placeholder = {
+      .byte_offset = wb.bit_offset() / 8,
+      .reserved_size = placeholder_size};
+  RETURN_IF_NOT_OK(wb.WriteUint8Span(
+      absl::MakeConstSpan(placeholder).first(placeholder_size)));
+
+  RETURN_IF_NOT_OK(WriteFieldsAfterObuSize(*this, wb));
+
+  return absl::OkStatus();
+}
+
+absl::Status ObuHeader::PatchObuSize(
+    const ObuSizePlaceholder& obu_size_placeholder, WriteBitBuffer& wb) {
+  if (!wb.IsByteAligned()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Expected the OBU to be byte-aligned: ", wb.bit_offset()));
+  }
+  const int64_t obu_size = wb.bit_offset() / 8 -
+                           obu_size_placeholder.byte_offset -
+                           obu_size_placeholder.reserved_size;
+  if (obu_size < 0 || obu_size > std::numeric_limits<uint32_t>::max()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("obu_size must fit into a `uint32_t`. obu_size= ",
+                     obu_size));
+  }
+
+  // Any unused reserved bytes are removed from the buffer.
+  const int64_t end_bit_offset = wb.bit_offset();
+  RETURN_IF_NOT_OK(wb.OverwriteUleb128(obu_size_placeholder.byte_offset,
+                                       obu_size_placeholder.reserved_size,
+                                       static_cast<DecodedUleb128>(obu_size)));
+  const size_t size_of_obu_size =
+      obu_size_placeholder.reserved_size -
+      (end_bit_offset - wb.bit_offset()) / 8;
+  return ValidateObuIsUnderTwoMegabytes(obu_size, size_of_obu_size);
+}
+
 // Reads all the fields of the OBU Header as defined in the IAMF spec
 // (https://aomediacodec.github.io/iamf/#obu-header-syntax). Most of these
 // fields are stored directly in the ObuHeader struct; however, for reasons
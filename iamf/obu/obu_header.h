@@ -117,9 +117,16 @@ void AbslStringify(Sink& sink, ObuType obu_type) {
 struct HeaderMetadata {
   ObuType obu_type;
   int64_t total_obu_size;
+  bool obu_redundant_copy = false;
 };
 
 struct ObuHeader {
+  /*!\brief Location of an `obu_size` which is written after the payload. */
+  struct ObuSizePlaceholder {
+    int64_t byte_offset;
+    int64_t reserved_size;
+  };
+
   friend bool operator==(const ObuHeader& lhs, const ObuHeader& rhs) = default;
 
   /*!\brief Validates and writes an `ObuHeader`.
@@ -137,6 +144,35 @@ struct ObuHeader {
   absl::Status ValidateAndWrite(int64_t payload_serialized_size,
                                 WriteBitBuffer& wb) const;
 
+  /*!\brief Validates and writes an `ObuHeader` before its payload is known.
+   *
+   * Reserves room for `obu_size`, so the payload can be written directly after
+   * the header. `PatchObuSize()` MUST be called after the payload is written.
+   *
+   * \param wb Byte-aligned buffer to write to.
+   * \param obu_size_placeholder Output location of the reserved `obu_size`.
+   * \return `absl::OkStatus()` if successful. `absl::InvalidArgumentError()`
+   *         if the buffer is not byte-aligned, or if fields are set
+   *         inconsistent with the IAMF specification. Or a specific status if
+   *         the write fails.
+   */
+  absl::Status ValidateAndWriteWithPlaceholderObuSize(
+      WriteBitBuffer& wb, ObuSizePlaceholder& obu_size_placeholder) const;
+
+  /*!\brief Fills in an `obu_size` reserved by the function above.
+   *
+   * `obu_size` covers everything written after the placeholder.
+   *
+   * \param obu_size_placeholder Location of the reserved `obu_size`.
+   * \param wb Buffer holding the entire OBU.
+   * \return `absl::OkStatus()` if successful. `absl::InvalidArgumentError()`
+   *         if the OBU is not byte-aligned, or if the calculated `obu_size` is
+   *         larger than IAMF limitations. Or a specific status if the write
+   *         fails.
+   */
+  static absl::Status PatchObuSize(
+      const ObuSizePlaceholder& obu_size_placeholder, WriteBitBuffer& wb);
+
   /*!\brief Validates and reads an `ObuHeader`.
    *
    * \param rb Buffer to read from.
@@ -201,10 +237,11 @@ struct ObuHeader {
    * This function does not consume any data from the bitstream.
    *
    * \param rb Buffer to read from.
-   * \return `HeaderMetadata` containing the OBU type and total OBU size if
-   *         successful. Returns an absl::ResourceExhaustedError if there is not
-   *         enough data to read the obu_type and obu_size. Returns other errors
-   *         if the bitstream is invalid.
+   * \return `HeaderMetadata` containing the OBU type, total OBU size and
+   *         `obu_redundant_copy` flag if successful. Returns an
+   *         absl::ResourceExhaustedError if there is not enough data to read
+   *         the obu_type and obu_size. Returns other errors if the bitstream
+   *         is invalid.
    */
   static absl::StatusOr<HeaderMetadata> PeekObuTypeAndTotalObuSize(
       ReadBitBuffer& rb);
@@ -11,10 +11,12 @@
  */
 #include "iamf/obu/parameter_block.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <variant>
 #include <vector>
 
 #include "absl/log/absl_check.h"
@@ -23,8 +25,11 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "iamf/common/read_bit_buffer.h"
 #include "iamf/common/utils/macros.h"
+#include "iamf/common/utils/mixing_utils.h"
+#include "iamf/common/utils/numeric_utils.h"
 #include "iamf/common/utils/obu_util.h"
 #include "iamf/common/write_bit_buffer.h"
 #include "iamf/obu/mix_gain_parameter_data.h"
@@ -36,6 +41,91 @@
 
 namespace iamf_tools {
 
+namespace {
+
+// Fills in `linear_mix_gains` for ticks of one subblock, the first at
+// `first_time` and the rest spaced `time_step` apart. All times are relative to
+// the start of the subblock and measured in ticks of the parameter rate. The dB
+// values are computed with the same formulas as
+// `ParameterBlockObu::InterpolateMixGainParameterData()`, then converted to
+// linear gains in one pass.
+absl::Status FillLinearMixGainsForSubblock(
+    const MixGainParameterData& mix_gain_parameter_data,
+    InternalTimestamp subblock_duration, double first_time, double time_step,
+    absl::Span<float> linear_mix_gains, bool& all_gains_are_unity) {
+  switch (mix_gain_parameter_data.animation_type) {
+    case MixGainParameterData::kAnimateStep: {
+      const auto& step =
+          std::get<AnimationStepInt16>(mix_gain_parameter_data.param_data);
+      all_gains_are_unity = step.start_point_value == 0;
+      // The gain is constant, so only convert it once.
+      std::fill(linear_mix_gains.begin(), linear_mix_gains.end(),
+                std::pow(10.0f, Q7_8ToFloat(step.start_point_value) / 20.0f));
+      return absl::OkStatus();
+    }
+    case MixGainParameterData::kAnimateLinear: {
+      const auto& linear =
+          std::get<AnimationLinearInt16>(mix_gain_parameter_data.param_data);
+      all_gains_are_unity =
+          linear.start_point_value == 0 && linear.end_point_value == 0;
+      const float p_0 = Q7_8ToFloat(linear.start_point_value);
+      const float p_2 = Q7_8ToFloat(linear.end_point_value);
+      const float n_2 = static_cast<float>(subblock_duration);
+      for (size_t t = 0; t < linear_mix_gains.size(); ++t) {
+        const float a = static_cast<float>(first_time + t * time_step) / n_2;
+        linear_mix_gains[t] = (1 - a) * p_0 + a * p_2;
+      }
+      break;
+    }
+    case MixGainParameterData::kAnimateBezier: {
+      const auto& bezier =
+          std::get<AnimationBezierInt16>(mix_gain_parameter_data.param_data);
+      all_gains_are_unity = bezier.start_point_value == 0 &&
+                            bezier.control_point_value == 0 &&
+                            bezier.end_point_value == 0;
+      const float p_0 = Q7_8ToFloat(bezier.start_point_value);
+      const float p_1 = Q7_8ToFloat(bezier.control_point_value);
+      const float p_2 = Q7_8ToFloat(bezier.end_point_value);
+      // Using the definition of `round` in the IAMF spec.
+      const int n_1 = std::floor(
+          (subblock_duration *
+           Q0_8ToFloat(bezier.control_point_relative_time)) +
+          0.5);
+      const int n_2 = subblock_duration;
+      // `alpha` and `beta` are the same for all ticks of the subblock.
+      const float alpha = -2 * n_1 + n_2;
+      const float beta = 2 * n_1;
+      if (alpha == 0) {
+        for (size_t t = 0; t < linear_mix_gains.size(); ++t) {
+          const float a = static_cast<float>(first_time + t * time_step) / beta;
+          linear_mix_gains[t] =
+              (1 - a) * (1 - a) * p_0 + 2 * (1 - a) * a * p_1 + a * a * p_2;
+        }
+      } else {
+        for (size_t t = 0; t < linear_mix_gains.size(); ++t) {
+          const float gamma = -static_cast<float>(first_time + t * time_step);
+          const float a =
+              (-beta + std::sqrt(beta * beta - 4 * alpha * gamma)) /
+              (2 * alpha);
+          linear_mix_gains[t] =
+              (1 - a) * (1 - a) * p_0 + 2 * (1 - a) * a * p_1 + a * a * p_2;
+        }
+      }
+      break;
+    }
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrCat("Unknown animation_type = ",
+                       static_cast<DecodedUleb128>(
+                           mix_gain_parameter_data.animation_type)));
+  }
+
+  // Mix gain data is in dB. Convert to the linear values.
+  return ConvertDbToLinearGains(linear_mix_gains, linear_mix_gains);
+}
+
+}  // namespace
+
 absl::Status ParameterSubblock::ReadAndValidate(
     const ParamDefinition& param_definition, ReadBitBuffer& rb) {
   if (subblock_duration.has_value()) {
@@ -305,6 +395,95 @@ absl::Status ParameterBlockObu::GetLinearMixGain(
   return absl::OkStatus();
 }
 
+absl::Status ParameterBlockObu::GetLinearMixGainsPerTick(
+    InternalTimestamp obu_relative_start_time,
+    absl::Span<float> linear_mix_gains, bool& all_gains_are_unity) const {
+  return GetLinearMixGainsAtSampleRate(param_definition_.parameter_rate_,
+                                       obu_relative_start_time,
+                                       linear_mix_gains, all_gains_are_unity);
+}
+
+absl::Status ParameterBlockObu::GetLinearMixGainsAtSampleRate(
+    uint32_t sample_rate, InternalTimestamp obu_relative_start_tick,
+    absl::Span<float> linear_mix_gains, bool& all_gains_are_unity) const {
+  if (param_definition_.GetType() !=
+      ParamDefinition::kParameterDefinitionMixGain) {
+    return absl::InvalidArgumentError("Expected Mix Gain Parameter Definition");
+  }
+  if (obu_relative_start_tick < 0) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Invalid obu_relative_start_tick= ", obu_relative_start_tick));
+  }
+  // When the rates match, ticks map one-to-one even if the rates are unset.
+  const bool rates_match = sample_rate == param_definition_.parameter_rate_;
+  const InternalTimestamp parameter_rate =
+      rates_match ? 1 : param_definition_.parameter_rate_;
+  const InternalTimestamp audio_rate = rates_match ? 1 : sample_rate;
+  if (parameter_rate == 0 || audio_rate == 0) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Invalid parameter_rate= ", param_definition_.parameter_rate_,
+        " or sample_rate= ", sample_rate));
+  }
+
+  // Audio tick `n` is at time `n * parameter_rate / audio_rate` of the OBU. A
+  // subblock spanning `[start, end)` in parameter time covers the audio ticks
+  // in `[ceil(start * audio_rate / parameter_rate), ceil(end * ...))`.
+  const auto to_first_covered_tick = [&](InternalTimestamp parameter_time) {
+    return (parameter_time * audio_rate + parameter_rate - 1) / parameter_rate;
+  };
+  const double time_step = static_cast<double>(parameter_rate) / audio_rate;
+
+  all_gains_are_unity = true;
+  const DecodedUleb128 num_subblocks = GetNumSubblocks();
+  InternalTimestamp subblock_relative_start_time = 0;
+  InternalTimestamp target_tick = obu_relative_start_tick;
+  size_t num_filled_ticks = 0;
+  for (int i = 0;
+       i < num_subblocks && num_filled_ticks < linear_mix_gains.size(); i++) {
+    const auto subblock_duration = GetSubblockDuration(i);
+    if (!subblock_duration.ok()) {
+      return subblock_duration.status();
+    }
+    const InternalTimestamp subblock_relative_end_time =
+        subblock_relative_start_time + subblock_duration.value();
+    const InternalTimestamp subblock_end_tick =
+        to_first_covered_tick(subblock_relative_end_time);
+
+    if (target_tick < subblock_end_tick) {
+      // Fill all remaining ticks which fall in this subblock. The numerator is
+      // exact, so the ticks land exactly on the parameter grid when the rates
+      // are the same.
+      const size_t num_ticks_in_subblock =
+          std::min(static_cast<size_t>(subblock_end_tick - target_tick),
+                   linear_mix_gains.size() - num_filled_ticks);
+      const double first_time =
+          static_cast<double>(target_tick * parameter_rate -
+                              subblock_relative_start_time * audio_rate) /
+          audio_rate;
+      bool subblock_gains_are_unity = false;
+      RETURN_IF_NOT_OK(FillLinearMixGainsForSubblock(
+          *static_cast<const MixGainParameterData*>(
+              subblocks_[i].param_data.get()),
+          subblock_duration.value(), first_time, time_step,
+          linear_mix_gains.subspan(num_filled_ticks, num_ticks_in_subblock),
+          subblock_gains_are_unity));
+      all_gains_are_unity &= subblock_gains_are_unity;
+      num_filled_ticks += num_ticks_in_subblock;
+      target_tick += num_ticks_in_subblock;
+    }
+    subblock_relative_start_time = subblock_relative_end_time;
+  }
+
+  if (num_filled_ticks != linear_mix_gains.size()) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Trying to get ", linear_mix_gains.size(),
+        " mix gains starting at obu_relative_start_tick= ",
+        obu_relative_start_tick, ", but only ", num_filled_ticks,
+        " ticks are within the parameter block."));
+  }
+  return absl::OkStatus();
+}
+
 void ParameterBlockObu::PrintObu() const {
   ABSL_LOG(INFO) << "Parameter Block OBU:";
   ABSL_LOG(INFO) << "  // param_definition:";
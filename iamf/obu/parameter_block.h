@@ -19,6 +19,7 @@
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "iamf/common/read_bit_buffer.h"
 #include "iamf/common/write_bit_buffer.h"
 #include "iamf/obu/mix_gain_parameter_data.h"
@@ -197,6 +198,46 @@ class ParameterBlockObu : public ObuBase {
   absl::Status GetLinearMixGain(InternalTimestamp obu_relative_time,
                                 float& linear_mix_gain) const;
 
+  /*!\brief Outputs the linear mix gains for a range of consecutive ticks.
+   *
+   * Equivalent to calling `GetLinearMixGain()` for each tick, but walks the
+   * subblocks once and evaluates each subblock over all of its ticks at once.
+   *
+   * \param obu_relative_start_time Time relative to the start of the OBU of
+   *        the first tick to get the mix gain of.
+   * \param linear_mix_gains Output linear mix gains, one per tick. All ticks
+   *        must be within the OBU.
+   * \param all_gains_are_unity Output `true` if every subblock in the range is
+   *        flat at 0 dB. The caller may skip applying the gains in that case.
+   * \return `absl::OkStatus()` on success. `absl::InvalidArgumentError()` on
+   *         failure.
+   */
+  absl::Status GetLinearMixGainsPerTick(
+      InternalTimestamp obu_relative_start_time,
+      absl::Span<float> linear_mix_gains, bool& all_gains_are_unity) const;
+
+  /*!\brief Outputs the linear mix gains for consecutive ticks of audio.
+   *
+   * Like `GetLinearMixGainsPerTick()`, but the ticks are at `sample_rate`
+   * rather than at the parameter rate. Audio tick `n` is evaluated at time
+   * `n * parameter_rate / sample_rate` of the OBU, so the curves are sampled
+   * directly on the audio tick grid. Each subblock is still evaluated over all
+   * of its ticks at once.
+   *
+   * \param sample_rate Sample rate of the audio ticks.
+   * \param obu_relative_start_tick Audio tick relative to the start of the OBU
+   *        of the first tick to get the mix gain of.
+   * \param linear_mix_gains Output linear mix gains, one per audio tick. All
+   *        ticks must be within the OBU.
+   * \param all_gains_are_unity Output `true` if every subblock in the range is
+   *        flat at 0 dB. The caller may skip applying the gains in that case.
+   * \return `absl::OkStatus()` on success. `absl::InvalidArgumentError()` on
+   *         failure.
+   */
+  absl::Status GetLinearMixGainsAtSampleRate(
+      uint32_t sample_rate, InternalTimestamp obu_relative_start_tick,
+      absl::Span<float> linear_mix_gains, bool& all_gains_are_unity) const;
+
   /*!\brief Prints logging information about the OBU.*/
   void PrintObu() const override;
 
@@ -21,6 +21,7 @@
 #include "absl/types/span.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "iamf/common/leb_generator.h"
 #include "iamf/common/read_bit_buffer.h"
 #include "iamf/common/utils/macros.h"
 #include "iamf/common/utils/tests/test_utils.h"
@@ -135,6 +136,54 @@ TEST(ObuBaseTest, OneByteObuExtensionHeader) {
                           {255});
 }
 
+TEST(ObuBaseTest, WritesObuSizeWithFixedSizeLebGenerator) {
+  const OneByteObu obu;
+  auto leb_generator =
+      LebGenerator::Create(LebGenerator::GenerationMode::kFixedSize, 2);
+  ASSERT_NE(leb_generator, nullptr);
+
+  WriteBitBuffer wb(1024, *leb_generator);
+  EXPECT_THAT(obu.ValidateAndWriteObu(wb), IsOk());
+
+  ValidateObuWriteResults(wb,
+                          {kObuIaReserved25 << 3,
+                           // `obu_size`.
+                           0x81, 0x00},
+                          {255});
+}
+
+TEST(ObuBaseTest, AppendsToExistingData) {
+  const OneByteObu obu;
+  WriteBitBuffer wb(1024);
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0xaa, 8), IsOk());
+
+  EXPECT_THAT(obu.ValidateAndWriteObu(wb), IsOk());
+
+  ValidateWriteResults(wb, {0xaa, kObuIaReserved25 << 3, 1, 255});
+}
+
+TEST(ObuBaseTest, WritesWhenBufferIsNotByteAligned) {
+  const OneByteObu obu;
+  WriteBitBuffer wb(1024);
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0, 4), IsOk());
+
+  EXPECT_THAT(obu.ValidateAndWriteObu(wb), IsOk());
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0, 4), IsOk());
+
+  // The OBU (0xc8, 0x01, 0xff) is shifted by four bits.
+  ValidateWriteResults(wb, {0x0c, 0x80, 0x1f, 0xf0});
+}
+
+TEST(ObuBaseTest, DoesNotWritePartialObuOnFailure) {
+  const ImaginaryObuNonIntegerBytes obu;
+  WriteBitBuffer wb(1024);
+  EXPECT_THAT(wb.WriteUnsignedLiteral(0xaa, 8), IsOk());
+
+  EXPECT_FALSE(obu.ValidateAndWriteObu(wb).ok());
+
+  ValidateWriteResults(wb, {0xaa});
+}
+
 TEST(ObuBaseTest, WritesObuFooterAndConsistentObuSize) {
   constexpr uint8_t kExpectedObuSizeWithFooter = 7;
   OneByteObu obu;
@@ -1019,11 +1019,29 @@ TEST(PeekObuTypeAndTotalObuSize, Success) {
 
   EXPECT_THAT(header_metadata, IsOk());
   EXPECT_EQ(header_metadata->obu_type, kObuIaAudioFrameId0);
+  EXPECT_FALSE(header_metadata->obu_redundant_copy);
   // obu_size + size_of(obu_size) + 1, 2 + 1 + 1 = 4.
   EXPECT_EQ(header_metadata->total_obu_size, 4);
   EXPECT_EQ(read_bit_buffer->Tell(), start_position);
 }
 
+TEST(PeekObuTypeAndTotalObuSize, GetsObuRedundantCopy) {
+  std::vector<uint8_t> source_data = {
+      kObuIaSequenceHeader << kObuTypeBitShift | kObuRedundantCopyBitMask,
+      // `obu_size`
+      6, 'i', 'a', 'm', 'f', 0, 0};
+  auto read_bit_buffer = MemoryBasedReadBitBuffer::CreateFromSpan(
+      absl::MakeConstSpan(source_data));
+
+  auto header_metadata =
+      ObuHeader::PeekObuTypeAndTotalObuSize(*read_bit_buffer);
+
+  EXPECT_THAT(header_metadata, IsOk());
+  EXPECT_EQ(header_metadata->obu_type, kObuIaSequenceHeader);
+  EXPECT_TRUE(header_metadata->obu_redundant_copy);
+  EXPECT_EQ(header_metadata->total_obu_size, 8);
+}
+
 TEST(PeekObuTypeAndTotalObuSize, SuccessWithMaxSizedObuSize) {
   std::vector<uint8_t> source_data = {kAudioFrameId0WithTrim,
                                       // `obu_size == 2 megabytes - 9`
@@ -1086,5 +1104,57 @@ TEST(PeekObuTypeAndTotalObuSize, ReturnsResourceExhaustedForPartialObuSize) {
   EXPECT_EQ(read_bit_buffer->Tell(), start_position);
 }
 
+TEST(ValidateAndWriteWithPlaceholderObuSize,
+     ReservesTheFixedSizeAndPatchesInPlace) {
+  const auto leb_generator =
+      LebGenerator::Create(LebGenerator::GenerationMode::kFixedSize, 2);
+  ASSERT_NE(leb_generator, nullptr);
+  WriteBitBuffer wb(1024, *leb_generator);
+  const ObuHeader obu_header({.obu_type = kObuIaSequenceHeader});
+  ObuHeader::ObuSizePlaceholder obu_size_placeholder;
+  EXPECT_THAT(obu_header.ValidateAndWriteWithPlaceholderObuSize(
+                  wb, obu_size_placeholder),
+              IsOk());
+  EXPECT_EQ(obu_size_placeholder.reserved_size, 2);
+  const std::vector<uint8_t> kPayload = {1, 2, 3};
+  EXPECT_THAT(wb.WriteUint8Span(absl::MakeConstSpan(kPayload)), IsOk());
+  const int64_t bit_offset_before_patch = wb.bit_offset();
+
+  EXPECT_THAT(ObuHeader::PatchObuSize(obu_size_placeholder, wb), IsOk());
+
+  // Nothing moves when the `obu_size` is patched.
+  EXPECT_EQ(wb.bit_offset(), bit_offset_before_patch);
+  ValidateWriteResults(wb, {kObuIaSequenceHeader << kObuTypeBitShift,
+                            // `obu_size`.
+                            0x83, 0x00,
+                            // Payload.
+                            1, 2, 3});
+}
+
+TEST(ValidateAndWriteWithPlaceholderObuSize,
+     RemovesUnusedReservedBytesWithMinimalGenerator) {
+  const auto leb_generator =
+      LebGenerator::Create(LebGenerator::GenerationMode::kMinimum);
+  ASSERT_NE(leb_generator, nullptr);
+  WriteBitBuffer wb(1024, *leb_generator);
+  const ObuHeader obu_header({.obu_type = kObuIaSequenceHeader});
+  ObuHeader::ObuSizePlaceholder obu_size_placeholder;
+  EXPECT_THAT(obu_header.ValidateAndWriteWithPlaceholderObuSize(
+                  wb, obu_size_placeholder),
+              IsOk());
+  // Enough bytes to represent any valid `obu_size`.
+  EXPECT_EQ(obu_size_placeholder.reserved_size, 3);
+  const std::vector<uint8_t> kPayload = {1, 2, 3};
+  EXPECT_THAT(wb.WriteUint8Span(absl::MakeConstSpan(kPayload)), IsOk());
+
+  EXPECT_THAT(ObuHeader::PatchObuSize(obu_size_placeholder, wb), IsOk());
+
+  ValidateWriteResults(wb, {kObuIaSequenceHeader << kObuTypeBitShift,
+                            // `obu_size`.
+                            3,
+                            // Payload.
+                            1, 2, 3});
+}
+
 }  // namespace
 }  // namespace iamf_tools
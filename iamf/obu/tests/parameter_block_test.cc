@@ -12,6 +12,8 @@
 #include "iamf/obu/parameter_block.h"
 
 #include <array>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <utility>
@@ -44,8 +46,11 @@ namespace {
 
 using absl_testing::IsOk;
 using absl_testing::IsOkAndHolds;
+using ::testing::Each;
+using ::testing::FloatEq;
 using ::testing::Not;
 using ::testing::NotNull;
+using ::testing::Pointwise;
 
 using absl::MakeConstSpan;
 using enum MixGainParameterData::AnimationType;
@@ -1250,6 +1255,309 @@ TEST_F(ExtensionParameterBlockTest, TwoSubblocksParamDefinitionMode1) {
   InitAndTestWrite();
 }
 
+// Creates a mix gain parameter block with `param_definition_mode == 1` and
+// one subblock per entry of `subblock_durations`.
+std::unique_ptr<ParameterBlockObu> CreateMixGainParameterBlock(
+    const MixGainParamDefinition& param_definition,
+    const std::vector<DecodedUleb128>& subblock_durations,
+    const std::vector<MixGainParameterData>& mix_gain_parameter_data) {
+  DecodedUleb128 duration = 0;
+  for (const auto subblock_duration : subblock_durations) {
+    duration += subblock_duration;
+  }
+  auto parameter_block = ParameterBlockObu::CreateMode1(
+      ObuHeader{.obu_type = kObuIaParameterBlock}, param_definition, duration,
+      /*constant_subblock_duration=*/0, subblock_durations.size());
+  for (int i = 0; i < subblock_durations.size(); i++) {
+    EXPECT_THAT(parameter_block->SetSubblockDuration(i, subblock_durations[i]),
+                IsOk());
+    parameter_block->subblocks_[i].param_data =
+        std::make_unique<MixGainParameterData>(mix_gain_parameter_data[i]);
+  }
+  return parameter_block;
+}
+
+MixGainParamDefinition CreateMixGainParamDefinitionMode1() {
+  MixGainParamDefinition param_definition;
+  param_definition.parameter_id_ = kParameterId;
+  param_definition.parameter_rate_ = kParameterRate;
+  param_definition.param_definition_mode_ = 1;
+  return param_definition;
+}
+
+std::vector<float> GetLinearMixGainsOneTickAtATime(
+    const ParameterBlockObu& parameter_block,
+    InternalTimestamp obu_relative_start_time, size_t num_ticks) {
+  std::vector<float> linear_mix_gains(num_ticks);
+  for (size_t t = 0; t < num_ticks; ++t) {
+    EXPECT_THAT(parameter_block.GetLinearMixGain(obu_relative_start_time + t,
+                                                 linear_mix_gains[t]),
+                IsOk());
+  }
+  return linear_mix_gains;
+}
+
+TEST(GetLinearMixGainsPerTick, MatchesGetLinearMixGainForAllAnimationTypes) {
+  const auto param_definition = CreateMixGainParamDefinitionMode1();
+  const auto parameter_block = CreateMixGainParameterBlock(
+      param_definition, {5, 100, 37},
+      {{kAnimateStep, AnimationStepInt16{.start_point_value = -1536}},
+       {kAnimateLinear, AnimationLinearInt16{.start_point_value = -1536,
+                                             .end_point_value = 768}},
+       {kAnimateBezier,
+        AnimationBezierInt16{.start_point_value = 768,
+                             .end_point_value = -2000,
+                             .control_point_value = 384,
+                             .control_point_relative_time = 192}}});
+  constexpr size_t kNumTicks = 142;
+  const auto expected_linear_mix_gains =
+      GetLinearMixGainsOneTickAtATime(*parameter_block, 0, kNumTicks);
+
+  std::vector<float> linear_mix_gains(kNumTicks);
+  bool all_gains_are_unity = true;
+  EXPECT_THAT(parameter_block->GetLinearMixGainsPerTick(
+                  0, absl::MakeSpan(linear_mix_gains), all_gains_are_unity),
+              IsOk());
+
+  EXPECT_THAT(linear_mix_gains,
+              Pointwise(FloatEq(), expected_linear_mix_gains));
+  EXPECT_FALSE(all_gains_are_unity);
+}
+
+TEST(GetLinearMixGainsPerTick, MatchesGetLinearMixGainForBezierAsLinear) {
+  const auto param_definition = CreateMixGainParamDefinitionMode1();
+  // A control point in the middle of the subblock results in `alpha == 0`.
+  const auto parameter_block = CreateMixGainParameterBlock(
+      param_definition, {64},
+      {{kAnimateBezier,
+        AnimationBezierInt16{.start_point_value = 200,
+                             .end_point_value = 768,
+                             .control_point_value = 484,
+                             .control_point_relative_time = 128}}});
+  const auto expected_linear_mix_gains =
+      GetLinearMixGainsOneTickAtATime(*parameter_block, 0, 64);
+
+  std::vector<float> linear_mix_gains(64);
+  bool all_gains_are_unity;
+  EXPECT_THAT(parameter_block->GetLinearMixGainsPerTick(
+                  0, absl::MakeSpan(linear_mix_gains), all_gains_are_unity),
+              IsOk());
+
+  EXPECT_THAT(linear_mix_gains,
+              Pointwise(FloatEq(), expected_linear_mix_gains));
+}
+
+TEST(GetLinearMixGainsPerTick, StartsInTheMiddleOfASubblock) {
+  const auto param_definition = CreateMixGainParamDefinitionMode1();
+  const auto parameter_block = CreateMixGainParameterBlock(
+      param_definition, {10, 10},
+      {{kAnimateLinear, AnimationLinearInt16{.start_point_value = 0,
+                                             .end_point_value = 256}},
+       {kAnimateStep, AnimationStepInt16{.start_point_value = 512}}});
+  const auto expected_linear_mix_gains =
+      GetLinearMixGainsOneTickAtATime(*parameter_block, 7, 6);
+
+  std::vector<float> linear_mix_gains(6);
+  bool all_gains_are_unity;
+  EXPECT_THAT(parameter_block->GetLinearMixGainsPerTick(
+                  7, absl::MakeSpan(linear_mix_gains), all_gains_are_unity),
+              IsOk());
+
+  EXPECT_THAT(linear_mix_gains,
+              Pointwise(FloatEq(), expected_linear_mix_gains));
+}
+
+TEST(GetLinearMixGainsPerTick, SetsAllGainsAreUnityWhenFlatAtZeroDb) {
+  const auto param_definition = CreateMixGainParamDefinitionMode1();
+  const auto parameter_block = CreateMixGainParameterBlock(
+      param_definition, {3, 4, 5},
+      {{kAnimateStep, AnimationStepInt16{.start_point_value = 0}},
+       {kAnimateLinear, AnimationLinearInt16{.start_point_value = 0,
+                                             .end_point_value = 0}},
+       {kAnimateBezier,
+        AnimationBezierInt16{.start_point_value = 0,
+                             .end_point_value = 0,
+                             .control_point_value = 0,
+                             .control_point_relative_time = 100}}});
+
+  std::vector<float> linear_mix_gains(12);
+  bool all_gains_are_unity = false;
+  EXPECT_THAT(parameter_block->GetLinearMixGainsPerTick(
+                  0, absl::MakeSpan(linear_mix_gains), all_gains_are_unity),
+              IsOk());
+
+  EXPECT_TRUE(all_gains_are_unity);
+  EXPECT_THAT(linear_mix_gains, Each(1.0f));
+}
+
+TEST(GetLinearMixGainsPerTick, OnlyConsidersSubblocksInTheRequestedRange) {
+  const auto param_definition = CreateMixGainParamDefinitionMode1();
+  const auto parameter_block = CreateMixGainParameterBlock(
+      param_definition, {4, 4},
+      {{kAnimateStep, AnimationStepInt16{.start_point_value = 0}},
+       {kAnimateStep, AnimationStepInt16{.start_point_value = -256}}});
+
+  std::vector<float> linear_mix_gains(4);
+  bool all_gains_are_unity = false;
+  EXPECT_THAT(parameter_block->GetLinearMixGainsPerTick(
+                  0, absl::MakeSpan(linear_mix_gains), all_gains_are_unity),
+              IsOk());
+  EXPECT_TRUE(all_gains_are_unity);
+
+  EXPECT_THAT(parameter_block->GetLinearMixGainsPerTick(
+                  2, absl::MakeSpan(linear_mix_gains), all_gains_are_unity),
+              IsOk());
+  EXPECT_FALSE(all_gains_are_unity);
+}
+
+TEST(GetLinearMixGainsPerTick, InvalidWhenTicksExtendPastTheEnd) {
+  const auto param_definition = CreateMixGainParamDefinitionMode1();
+  const auto parameter_block = CreateMixGainParameterBlock(
+      param_definition, {10},
+      {{kAnimateStep, AnimationStepInt16{.start_point_value = 0}}});
+
+  std::vector<float> linear_mix_gains(4);
+  bool all_gains_are_unity;
+  EXPECT_FALSE(parameter_block
+                   ->GetLinearMixGainsPerTick(
+                       7, absl::MakeSpan(linear_mix_gains), all_gains_are_unity)
+                   .ok());
+}
+
+TEST(GetLinearMixGainsPerTick, InvalidForNonMixGainParameterBlocks) {
+  DemixingParamDefinition param_definition;
+  param_definition.parameter_id_ = kParameterId;
+  param_definition.parameter_rate_ = kParameterRate;
+  param_definition.param_definition_mode_ = 0;
+  param_definition.duration_ = kDuration;
+  param_definition.constant_subblock_duration_ = kConstantSubblockDuration;
+  const auto parameter_block = ParameterBlockObu::CreateMode0(
+      ObuHeader{.obu_type = kObuIaParameterBlock}, param_definition);
+  ASSERT_THAT(parameter_block, NotNull());
+
+  std::vector<float> linear_mix_gains(1);
+  bool all_gains_are_unity;
+  EXPECT_FALSE(parameter_block
+                   ->GetLinearMixGainsPerTick(
+                       0, absl::MakeSpan(linear_mix_gains), all_gains_are_unity)
+                   .ok());
+}
+
+TEST(GetLinearMixGainsAtSampleRate,
+     MatchesGetLinearMixGainsPerTickAtTheParameterRate) {
+  const auto param_definition = CreateMixGainParamDefinitionMode1();
+  const auto parameter_block = CreateMixGainParameterBlock(
+      param_definition, {5, 100},
+      {{kAnimateStep, AnimationStepInt16{.start_point_value = -1536}},
+       {kAnimateBezier,
+        AnimationBezierInt16{.start_point_value = 768,
+                             .end_point_value = -2000,
+                             .control_point_value = 384,
+                             .control_point_relative_time = 192}}});
+  std::vector<float> expected_linear_mix_gains(100);
+  bool all_gains_are_unity;
+  EXPECT_THAT(parameter_block->GetLinearMixGainsPerTick(
+                  3, absl::MakeSpan(expected_linear_mix_gains),
+                  all_gains_are_unity),
+              IsOk());
+
+  std::vector<float> linear_mix_gains(100);
+  EXPECT_THAT(parameter_block->GetLinearMixGainsAtSampleRate(
+                  kParameterRate, 3, absl::MakeSpan(linear_mix_gains),
+                  all_gains_are_unity),
+              IsOk());
+
+  EXPECT_THAT(linear_mix_gains,
+              Pointwise(FloatEq(), expected_linear_mix_gains));
+}
+
+TEST(GetLinearMixGainsAtSampleRate, EvaluatesCurvesAtFractionalTimes) {
+  constexpr uint32_t kSampleRate = 48000;
+  auto param_definition = CreateMixGainParamDefinitionMode1();
+  param_definition.parameter_rate_ = 1000;
+  // A linear ramp from 0 dB to 1 dB over 10 ms, then a step at 2 dB.
+  const auto parameter_block = CreateMixGainParameterBlock(
+      param_definition, {10, 10},
+      {{kAnimateLinear, AnimationLinearInt16{.start_point_value = 0,
+                                             .end_point_value = 256}},
+       {kAnimateStep, AnimationStepInt16{.start_point_value = 512}}});
+
+  // 20 ms at 48 kHz.
+  std::vector<float> linear_mix_gains(960);
+  bool all_gains_are_unity = true;
+  EXPECT_THAT(parameter_block->GetLinearMixGainsAtSampleRate(
+                  kSampleRate, 0, absl::MakeSpan(linear_mix_gains),
+                  all_gains_are_unity),
+              IsOk());
+
+  EXPECT_FALSE(all_gains_are_unity);
+  for (size_t t = 0; t < 480; ++t) {
+    const float expected_db = static_cast<float>(t) / 480.0f;
+    EXPECT_NEAR(linear_mix_gains[t], std::pow(10.0f, expected_db / 20.0f),
+                1e-5);
+  }
+  for (size_t t = 480; t < 960; ++t) {
+    EXPECT_NEAR(linear_mix_gains[t], std::pow(10.0f, 2.0f / 20.0f), 1e-5);
+  }
+}
+
+TEST(GetLinearMixGainsAtSampleRate, StartsInTheMiddleOfTheParameterBlock) {
+  constexpr uint32_t kSampleRate = 48000;
+  auto param_definition = CreateMixGainParamDefinitionMode1();
+  param_definition.parameter_rate_ = 100;
+  const auto parameter_block = CreateMixGainParameterBlock(
+      param_definition, {4},
+      {{kAnimateLinear, AnimationLinearInt16{.start_point_value = -256,
+                                             .end_point_value = 256}}});
+  std::vector<float> all_linear_mix_gains(1920);
+  bool all_gains_are_unity;
+  EXPECT_THAT(parameter_block->GetLinearMixGainsAtSampleRate(
+                  kSampleRate, 0, absl::MakeSpan(all_linear_mix_gains),
+                  all_gains_are_unity),
+              IsOk());
+
+  std::vector<float> linear_mix_gains(960);
+  EXPECT_THAT(parameter_block->GetLinearMixGainsAtSampleRate(
+                  kSampleRate, 960, absl::MakeSpan(linear_mix_gains),
+                  all_gains_are_unity),
+              IsOk());
+
+  EXPECT_THAT(linear_mix_gains,
+              Pointwise(FloatEq(), absl::MakeConstSpan(all_linear_mix_gains)
+                                       .subspan(960)));
+}
+
+TEST(GetLinearMixGainsAtSampleRate, InvalidWhenTicksExtendPastTheEnd) {
+  auto param_definition = CreateMixGainParamDefinitionMode1();
+  param_definition.parameter_rate_ = 1000;
+  const auto parameter_block = CreateMixGainParameterBlock(
+      param_definition, {20},
+      {{kAnimateStep, AnimationStepInt16{.start_point_value = 0}}});
+
+  std::vector<float> linear_mix_gains(961);
+  bool all_gains_are_unity;
+  EXPECT_FALSE(parameter_block
+                   ->GetLinearMixGainsAtSampleRate(
+                       48000, 0, absl::MakeSpan(linear_mix_gains),
+                       all_gains_are_unity)
+                   .ok());
+}
+
+TEST(GetLinearMixGainsAtSampleRate, InvalidForZeroSampleRate) {
+  const auto param_definition = CreateMixGainParamDefinitionMode1();
+  const auto parameter_block = CreateMixGainParameterBlock(
+      param_definition, {20},
+      {{kAnimateStep, AnimationStepInt16{.start_point_value = 0}}});
+
+  std::vector<float> linear_mix_gains(1);
+  bool all_gains_are_unity;
+  EXPECT_FALSE(parameter_block
+                   ->GetLinearMixGainsAtSampleRate(
+                       0, 0, absl::MakeSpan(linear_mix_gains),
+                       all_gains_are_unity)
+                   .ok());
+}
+
 struct InterpolateMixGainParameterDataTestCase {
   MixGainParameterData mix_gain_parameter_data;
   InternalTimestamp start_time;